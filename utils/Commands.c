@@ -75,6 +75,7 @@
   In_Unmarshal - shared by TPM and TSS
 */
 
+#if CC_Startup
 TPM_RC
 Startup_In_Unmarshal(Startup_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -89,6 +90,8 @@ Startup_In_Unmarshal(Startup_In *target, BYTE **buffer, uint32_t *size, TPM_HAND
     }
     return rc;
 }
+#endif
+#if CC_Shutdown
 TPM_RC
 Shutdown_In_Unmarshal(Shutdown_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -103,6 +106,8 @@ Shutdown_In_Unmarshal(Shutdown_In *target, BYTE **buffer, uint32_t *size, TPM_HA
     }
     return rc;
 }
+#endif
+#if CC_SelfTest
 TPM_RC
 SelfTest_In_Unmarshal(SelfTest_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -117,6 +122,8 @@ SelfTest_In_Unmarshal(SelfTest_In *target, BYTE **buffer, uint32_t *size, TPM_HA
     }
     return rc;
 }
+#endif
+#if CC_IncrementalSelfTest
 TPM_RC
 IncrementalSelfTest_In_Unmarshal(IncrementalSelfTest_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -131,6 +138,8 @@ IncrementalSelfTest_In_Unmarshal(IncrementalSelfTest_In *target, BYTE **buffer,
     }
     return rc;
 }
+#endif
+#if CC_StartAuthSession
 TPM_RC
 StartAuthSession_In_Unmarshal(StartAuthSession_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -172,6 +181,8 @@ StartAuthSession_In_Unmarshal(StartAuthSession_In *target, BYTE **buffer, uint32
     }
     return rc;
 }
+#endif
+#if CC_PolicyRestart
 TPM_RC
 PolicyRestart_In_Unmarshal(PolicyRestart_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -184,6 +195,8 @@ PolicyRestart_In_Unmarshal(PolicyRestart_In *target, BYTE **buffer, uint32_t *si
     }
     return rc;
 }
+#endif
+#if CC_Create
 TPM_RC
 Create_In_Unmarshal(Create_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -218,6 +231,8 @@ Create_In_Unmarshal(Create_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE
     }
     return rc;
 }
+#endif
+#if CC_Load
 TPM_RC
 Load_In_Unmarshal(Load_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -240,6 +255,8 @@ Load_In_Unmarshal(Load_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE han
     }
     return rc;
 }
+#endif
+#if CC_LoadExternal
 TPM_RC
 LoadExternal_In_Unmarshal(LoadExternal_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -266,7 +283,9 @@ LoadExternal_In_Unmarshal(LoadExternal_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
 
+#if CC_ReadPublic
 TPM_RC
 ReadPublic_In_Unmarshal(ReadPublic_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -279,6 +298,8 @@ ReadPublic_In_Unmarshal(ReadPublic_In *target, BYTE **buffer, uint32_t *size, TP
     }
     return rc;
 }
+#endif
+#if CC_ActivateCredential
 TPM_RC
 ActivateCredential_In_Unmarshal(ActivateCredential_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -302,6 +323,8 @@ ActivateCredential_In_Unmarshal(ActivateCredential_In *target, BYTE **buffer, ui
     }
     return rc;
 }
+#endif
+#if CC_MakeCredential
 TPM_RC
 MakeCredential_In_Unmarshal(MakeCredential_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -324,6 +347,8 @@ MakeCredential_In_Unmarshal(MakeCredential_In *target, BYTE **buffer, uint32_t *
     }
     return rc;
 }
+#endif
+#if CC_Unseal
 TPM_RC
 Unseal_In_Unmarshal(Unseal_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -336,6 +361,8 @@ Unseal_In_Unmarshal(Unseal_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE
     }
     return rc;
 }
+#endif
+#if CC_ObjectChangeAuth
 TPM_RC
 ObjectChangeAuth_In_Unmarshal(ObjectChangeAuth_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -350,6 +377,8 @@ ObjectChangeAuth_In_Unmarshal(ObjectChangeAuth_In *target, BYTE **buffer, uint32
     }
     return rc;
 }
+#endif
+#if CC_CreateLoaded
 TPM_RC
 CreateLoaded_In_Unmarshal(CreateLoaded_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -372,6 +401,8 @@ CreateLoaded_In_Unmarshal(CreateLoaded_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_Duplicate
 TPM_RC
 Duplicate_In_Unmarshal(Duplicate_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -395,6 +426,8 @@ Duplicate_In_Unmarshal(Duplicate_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_Rewrap
 TPM_RC
 Rewrap_In_Unmarshal(Rewrap_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -424,6 +457,8 @@ Rewrap_In_Unmarshal(Rewrap_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE
     }
     return rc;
 }
+#endif
+#if CC_Import
 TPM_RC
 Import_In_Unmarshal(Import_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -461,6 +496,8 @@ Import_In_Unmarshal(Import_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE
     }
     return rc;
 }
+#endif
+#if CC_RSA_Encrypt
 TPM_RC
 RSA_Encrypt_In_Unmarshal(RSA_Encrypt_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -489,6 +526,8 @@ RSA_Encrypt_In_Unmarshal(RSA_Encrypt_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_RSA_Decrypt
 TPM_RC
 RSA_Decrypt_In_Unmarshal(RSA_Decrypt_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -517,6 +556,8 @@ RSA_Decrypt_In_Unmarshal(RSA_Decrypt_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_ECDH_KeyGen
 TPM_RC
 ECDH_KeyGen_In_Unmarshal(ECDH_KeyGen_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -529,6 +570,8 @@ ECDH_KeyGen_In_Unmarshal(ECDH_KeyGen_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_ECDH_ZGen
 TPM_RC
 ECDH_ZGen_In_Unmarshal(ECDH_ZGen_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -545,6 +588,8 @@ ECDH_ZGen_In_Unmarshal(ECDH_ZGen_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_ECC_Encrypt
 TPM_RC
 ECC_Encrypt_In_Unmarshal(ECC_Encrypt_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -566,6 +611,8 @@ ECC_Encrypt_In_Unmarshal(ECC_Encrypt_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_ECC_Decrypt
 TPM_RC
 ECC_Decrypt_In_Unmarshal(ECC_Decrypt_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -599,6 +646,8 @@ ECC_Decrypt_In_Unmarshal(ECC_Decrypt_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_ECC_Parameters
 TPM_RC
 ECC_Parameters_In_Unmarshal(ECC_Parameters_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -613,6 +662,8 @@ ECC_Parameters_In_Unmarshal(ECC_Parameters_In *target, BYTE **buffer, uint32_t *
     }
     return rc;
 }
+#endif
+#if CC_ZGen_2Phase
 TPM_RC
 ZGen_2Phase_In_Unmarshal(ZGen_2Phase_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -647,6 +698,8 @@ ZGen_2Phase_In_Unmarshal(ZGen_2Phase_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_EncryptDecrypt
 TPM_RC
 EncryptDecrypt_In_Unmarshal(EncryptDecrypt_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -681,6 +734,8 @@ EncryptDecrypt_In_Unmarshal(EncryptDecrypt_In *target, BYTE **buffer, uint32_t *
     }
     return rc;
 }
+#endif
+#if CC_EncryptDecrypt2
 TPM_RC
 EncryptDecrypt2_In_Unmarshal(EncryptDecrypt2_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -715,6 +770,8 @@ EncryptDecrypt2_In_Unmarshal(EncryptDecrypt2_In *target, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_Hash
 TPM_RC
 Hash_In_Unmarshal(Hash_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -741,6 +798,8 @@ Hash_In_Unmarshal(Hash_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE han
     }
     return rc;
 }
+#endif
+#if CC_HMAC
 TPM_RC
 HMAC_In_Unmarshal(HMAC_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -763,6 +822,8 @@ HMAC_In_Unmarshal(HMAC_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE han
     }
     return rc;
 }
+#endif
+#if CC_GetRandom
 TPM_RC
 GetRandom_In_Unmarshal(GetRandom_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -777,6 +838,8 @@ GetRandom_In_Unmarshal(GetRandom_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_StirRandom
 TPM_RC
 StirRandom_In_Unmarshal(StirRandom_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -791,6 +854,8 @@ StirRandom_In_Unmarshal(StirRandom_In *target, BYTE **buffer, uint32_t *size, TP
     }
     return rc;
 }
+#endif
+#if CC_HMAC_Start
 TPM_RC
 HMAC_Start_In_Unmarshal(HMAC_Start_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -813,6 +878,8 @@ HMAC_Start_In_Unmarshal(HMAC_Start_In *target, BYTE **buffer, uint32_t *size, TP
     }
     return rc;
 }
+#endif
+#if CC_HashSequenceStart
 TPM_RC
 HashSequenceStart_In_Unmarshal(HashSequenceStart_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -833,6 +900,8 @@ HashSequenceStart_In_Unmarshal(HashSequenceStart_In *target, BYTE **buffer, uint
     }
     return rc;
 }
+#endif
+#if CC_SequenceUpdate
 TPM_RC
 SequenceUpdate_In_Unmarshal(SequenceUpdate_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -851,6 +920,8 @@ SequenceUpdate_In_Unmarshal(SequenceUpdate_In *target, BYTE **buffer, uint32_t *
     }
     return rc;
 }
+#endif
+#if CC_SequenceComplete
 TPM_RC
 SequenceComplete_In_Unmarshal(SequenceComplete_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -873,6 +944,8 @@ SequenceComplete_In_Unmarshal(SequenceComplete_In *target, BYTE **buffer, uint32
     }
     return rc;
 }
+#endif
+#if CC_EventSequenceComplete
 TPM_RC
 EventSequenceComplete_In_Unmarshal(EventSequenceComplete_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -890,6 +963,8 @@ EventSequenceComplete_In_Unmarshal(EventSequenceComplete_In *target, BYTE **buff
     }
     return rc;
 }
+#endif
+#if CC_Certify
 TPM_RC
 Certify_In_Unmarshal(Certify_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -913,6 +988,8 @@ Certify_In_Unmarshal(Certify_In *target, BYTE **buffer, uint32_t *size, TPM_HAND
     }
     return rc;
 }
+#endif
+#if CC_CertifyX509
 TPM_RC
 CertifyX509_In_Unmarshal(CertifyX509_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -942,6 +1019,8 @@ CertifyX509_In_Unmarshal(CertifyX509_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_CertifyCreation
 TPM_RC
 CertifyCreation_In_Unmarshal(CertifyCreation_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -977,6 +1056,8 @@ CertifyCreation_In_Unmarshal(CertifyCreation_In *target, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_Quote
 TPM_RC
 Quote_In_Unmarshal(Quote_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1005,6 +1086,8 @@ Quote_In_Unmarshal(Quote_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE h
     }
     return rc;
 }
+#endif
+#if CC_GetSessionAuditDigest
 TPM_RC
 GetSessionAuditDigest_In_Unmarshal(GetSessionAuditDigest_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1029,6 +1112,8 @@ GetSessionAuditDigest_In_Unmarshal(GetSessionAuditDigest_In *target, BYTE **buff
     }
     return rc;
 }
+#endif
+#if CC_GetCommandAuditDigest
 TPM_RC
 GetCommandAuditDigest_In_Unmarshal(GetCommandAuditDigest_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1052,6 +1137,8 @@ GetCommandAuditDigest_In_Unmarshal(GetCommandAuditDigest_In *target, BYTE **buff
     }
     return rc;
 }
+#endif
+#if CC_GetTime
 TPM_RC
 GetTime_In_Unmarshal(GetTime_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1075,6 +1162,8 @@ GetTime_In_Unmarshal(GetTime_In *target, BYTE **buffer, uint32_t *size, TPM_HAND
     }
     return rc;
 }
+#endif
+#if CC_Commit
 TPM_RC
 Commit_In_Unmarshal(Commit_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1103,6 +1192,8 @@ Commit_In_Unmarshal(Commit_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE
     }
     return rc;
 }
+#endif
+#if CC_EC_Ephemeral
 TPM_RC
 EC_Ephemeral_In_Unmarshal(EC_Ephemeral_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1117,6 +1208,8 @@ EC_Ephemeral_In_Unmarshal(EC_Ephemeral_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_VerifySignature
 TPM_RC
 VerifySignature_In_Unmarshal(VerifySignature_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1139,6 +1232,8 @@ VerifySignature_In_Unmarshal(VerifySignature_In *target, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_Sign
 TPM_RC
 Sign_In_Unmarshal(Sign_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1167,6 +1262,8 @@ Sign_In_Unmarshal(Sign_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE han
     }
     return rc;
 }
+#endif
+#if CC_SetCommandCodeAuditStatus
 TPM_RC
 SetCommandCodeAuditStatus_In_Unmarshal(SetCommandCodeAuditStatus_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1195,6 +1292,8 @@ SetCommandCodeAuditStatus_In_Unmarshal(SetCommandCodeAuditStatus_In *target, BYT
     }
     return rc;
 }
+#endif
+#if CC_PCR_Extend
 TPM_RC
 PCR_Extend_In_Unmarshal(PCR_Extend_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1211,6 +1310,8 @@ PCR_Extend_In_Unmarshal(PCR_Extend_In *target, BYTE **buffer, uint32_t *size, TP
     }
     return rc;
 }
+#endif
+#if CC_PCR_Event
 TPM_RC
 PCR_Event_In_Unmarshal(PCR_Event_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1227,6 +1328,8 @@ PCR_Event_In_Unmarshal(PCR_Event_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_PCR_Read
 TPM_RC
 PCR_Read_In_Unmarshal(PCR_Read_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1241,6 +1344,8 @@ PCR_Read_In_Unmarshal(PCR_Read_In *target, BYTE **buffer, uint32_t *size, TPM_HA
     }
     return rc;
 }
+#endif
+#if CC_PCR_Allocate
 TPM_RC
 PCR_Allocate_In_Unmarshal(PCR_Allocate_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1257,6 +1362,8 @@ PCR_Allocate_In_Unmarshal(PCR_Allocate_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_PCR_SetAuthPolicy
 TPM_RC
 PCR_SetAuthPolicy_In_Unmarshal(PCR_SetAuthPolicy_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1285,6 +1392,8 @@ PCR_SetAuthPolicy_In_Unmarshal(PCR_SetAuthPolicy_In *target, BYTE **buffer, uint
     }
     return rc;
 }
+#endif
+#if CC_PCR_SetAuthValue
 TPM_RC
 PCR_SetAuthValue_In_Unmarshal(PCR_SetAuthValue_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1301,6 +1410,8 @@ PCR_SetAuthValue_In_Unmarshal(PCR_SetAuthValue_In *target, BYTE **buffer, uint32
     }
     return rc;
 }
+#endif
+#if CC_PCR_Reset
 TPM_RC
 PCR_Reset_In_Unmarshal(PCR_Reset_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1313,6 +1424,8 @@ PCR_Reset_In_Unmarshal(PCR_Reset_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_PolicySigned
 TPM_RC
 PolicySigned_In_Unmarshal(PolicySigned_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1354,6 +1467,8 @@ PolicySigned_In_Unmarshal(PolicySigned_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_PolicySecret
 TPM_RC
 PolicySecret_In_Unmarshal(PolicySecret_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1389,6 +1504,8 @@ PolicySecret_In_Unmarshal(PolicySecret_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_PolicyTicket
 TPM_RC
 PolicyTicket_In_Unmarshal(PolicyTicket_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1429,6 +1546,8 @@ PolicyTicket_In_Unmarshal(PolicyTicket_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_PolicyOR
 TPM_RC
 PolicyOR_In_Unmarshal(PolicyOR_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1446,6 +1565,8 @@ PolicyOR_In_Unmarshal(PolicyOR_In *target, BYTE **buffer, uint32_t *size, TPM_HA
     }
     return rc;
 }
+#endif
+#if CC_PolicyPCR
 TPM_RC
 PolicyPCR_In_Unmarshal(PolicyPCR_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1468,6 +1589,8 @@ PolicyPCR_In_Unmarshal(PolicyPCR_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_PolicyLocality
 TPM_RC
 PolicyLocality_In_Unmarshal(PolicyLocality_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1484,6 +1607,8 @@ PolicyLocality_In_Unmarshal(PolicyLocality_In *target, BYTE **buffer, uint32_t *
     }
     return rc;
 }
+#endif
+#if CC_PolicyNV
 TPM_RC
 PolicyNV_In_Unmarshal(PolicyNV_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1514,6 +1639,8 @@ PolicyNV_In_Unmarshal(PolicyNV_In *target, BYTE **buffer, uint32_t *size, TPM_HA
     }
     return rc;
 }
+#endif
+#if CC_PolicyAuthorizeNV
 TPM_RC
 PolicyAuthorizeNV_In_Unmarshal(PolicyAuthorizeNV_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1528,6 +1655,8 @@ PolicyAuthorizeNV_In_Unmarshal(PolicyAuthorizeNV_In *target, BYTE **buffer, uint
     }
     return rc;
 }
+#endif
+#if CC_PolicyCounterTimer
 TPM_RC
 PolicyCounterTimer_In_Unmarshal(PolicyCounterTimer_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1556,6 +1685,8 @@ PolicyCounterTimer_In_Unmarshal(PolicyCounterTimer_In *target, BYTE **buffer, ui
     }
     return rc;
 }
+#endif
+#if CC_PolicyCommandCode
 TPM_RC
 PolicyCommandCode_In_Unmarshal(PolicyCommandCode_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1572,6 +1703,8 @@ PolicyCommandCode_In_Unmarshal(PolicyCommandCode_In *target, BYTE **buffer, uint
     }
     return rc;
 }
+#endif
+#if CC_PolicyPhysicalPresence
 TPM_RC
 PolicyPhysicalPresence_In_Unmarshal(PolicyPhysicalPresence_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1584,6 +1717,8 @@ PolicyPhysicalPresence_In_Unmarshal(PolicyPhysicalPresence_In *target, BYTE **bu
     }
     return rc;
 }
+#endif
+#if CC_PolicyCpHash
 TPM_RC
 PolicyCpHash_In_Unmarshal(PolicyCpHash_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1600,6 +1735,8 @@ PolicyCpHash_In_Unmarshal(PolicyCpHash_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_PolicyNameHash
 TPM_RC
 PolicyNameHash_In_Unmarshal(PolicyNameHash_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1616,6 +1753,8 @@ PolicyNameHash_In_Unmarshal(PolicyNameHash_In *target, BYTE **buffer, uint32_t *
     }
     return rc;
 }
+#endif
+#if CC_PolicyDuplicationSelect
 TPM_RC
 PolicyDuplicationSelect_In_Unmarshal(PolicyDuplicationSelect_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1644,6 +1783,8 @@ PolicyDuplicationSelect_In_Unmarshal(PolicyDuplicationSelect_In *target, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_PolicyAuthorize
 TPM_RC
 PolicyAuthorize_In_Unmarshal(PolicyAuthorize_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1678,6 +1819,8 @@ PolicyAuthorize_In_Unmarshal(PolicyAuthorize_In *target, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_PolicyAuthValue
 TPM_RC
 PolicyAuthValue_In_Unmarshal(PolicyAuthValue_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1690,6 +1833,8 @@ PolicyAuthValue_In_Unmarshal(PolicyAuthValue_In *target, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_PolicyPassword
 TPM_RC
 PolicyPassword_In_Unmarshal(PolicyPassword_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1702,6 +1847,8 @@ PolicyPassword_In_Unmarshal(PolicyPassword_In *target, BYTE **buffer, uint32_t *
     }
     return rc;
 }
+#endif
+#if CC_PolicyGetDigest
 TPM_RC
 PolicyGetDigest_In_Unmarshal(PolicyGetDigest_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1714,6 +1861,8 @@ PolicyGetDigest_In_Unmarshal(PolicyGetDigest_In *target, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_PolicyNvWritten
 TPM_RC
 PolicyNvWritten_In_Unmarshal(PolicyNvWritten_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1730,6 +1879,8 @@ PolicyNvWritten_In_Unmarshal(PolicyNvWritten_In *target, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_PolicyTemplate
 TPM_RC
 PolicyTemplate_In_Unmarshal(PolicyTemplate_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1748,6 +1899,8 @@ PolicyTemplate_In_Unmarshal(PolicyTemplate_In *target, BYTE **buffer, uint32_t *
     }
     return rc;
 }
+#endif
+#if CC_PolicyCapability
 TPM_RC
 PolicyCapability_In_Unmarshal(PolicyCapability_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1790,6 +1943,8 @@ PolicyCapability_In_Unmarshal(PolicyCapability_In *target, BYTE **buffer, uint32
     }
     return rc;
 }
+#endif
+#if CC_PolicyParameters
 TPM_RC
 PolicyParameters_In_Unmarshal(PolicyParameters_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1808,6 +1963,8 @@ PolicyParameters_In_Unmarshal(PolicyParameters_In *target, BYTE **buffer, uint32
     }
     return rc;
 }
+#endif
+#if CC_CreatePrimary
 TPM_RC
 CreatePrimary_In_Unmarshal(CreatePrimary_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1842,6 +1999,8 @@ CreatePrimary_In_Unmarshal(CreatePrimary_In *target, BYTE **buffer, uint32_t *si
     }
     return rc;
 }
+#endif
+#if CC_HierarchyControl
 TPM_RC
 HierarchyControl_In_Unmarshal(HierarchyControl_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1864,6 +2023,8 @@ HierarchyControl_In_Unmarshal(HierarchyControl_In *target, BYTE **buffer, uint32
     }
     return rc;
 }
+#endif
+#if CC_SetPrimaryPolicy
 TPM_RC
 SetPrimaryPolicy_In_Unmarshal(SetPrimaryPolicy_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1886,6 +2047,8 @@ SetPrimaryPolicy_In_Unmarshal(SetPrimaryPolicy_In *target, BYTE **buffer, uint32
     }
     return rc;
 }
+#endif
+#if CC_ChangePPS
 TPM_RC
 ChangePPS_In_Unmarshal(ChangePPS_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1898,6 +2061,8 @@ ChangePPS_In_Unmarshal(ChangePPS_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_ChangeEPS
 TPM_RC
 ChangeEPS_In_Unmarshal(ChangeEPS_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1910,6 +2075,8 @@ ChangeEPS_In_Unmarshal(ChangeEPS_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_Clear
 TPM_RC
 Clear_In_Unmarshal(Clear_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1922,6 +2089,8 @@ Clear_In_Unmarshal(Clear_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE h
     }
     return rc;
 }
+#endif
+#if CC_ClearControl
 TPM_RC
 ClearControl_In_Unmarshal(ClearControl_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1938,6 +2107,8 @@ ClearControl_In_Unmarshal(ClearControl_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_HierarchyChangeAuth
 TPM_RC
 HierarchyChangeAuth_In_Unmarshal(HierarchyChangeAuth_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1954,6 +2125,8 @@ HierarchyChangeAuth_In_Unmarshal(HierarchyChangeAuth_In *target, BYTE **buffer,
     }
     return rc;
 }
+#endif
+#if CC_DictionaryAttackLockReset
 TPM_RC
 DictionaryAttackLockReset_In_Unmarshal(DictionaryAttackLockReset_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1966,6 +2139,8 @@ DictionaryAttackLockReset_In_Unmarshal(DictionaryAttackLockReset_In *target, BYT
     }
     return rc;
 }
+#endif
+#if CC_DictionaryAttackParameters
 TPM_RC
 DictionaryAttackParameters_In_Unmarshal(DictionaryAttackParameters_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -1994,6 +2169,8 @@ DictionaryAttackParameters_In_Unmarshal(DictionaryAttackParameters_In *target, B
     }
     return rc;
 }
+#endif
+#if CC_PP_Commands
 TPM_RC
 PP_Commands_In_Unmarshal(PP_Commands_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2016,6 +2193,8 @@ PP_Commands_In_Unmarshal(PP_Commands_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_SetAlgorithmSet
 TPM_RC
 SetAlgorithmSet_In_Unmarshal(SetAlgorithmSet_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2032,6 +2211,8 @@ SetAlgorithmSet_In_Unmarshal(SetAlgorithmSet_In *target, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_ContextSave
 TPM_RC
 ContextSave_In_Unmarshal(ContextSave_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2044,6 +2225,8 @@ ContextSave_In_Unmarshal(ContextSave_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_ContextLoad
 TPM_RC
 ContextLoad_In_Unmarshal(ContextLoad_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2058,6 +2241,8 @@ ContextLoad_In_Unmarshal(ContextLoad_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_FlushContext
 TPM_RC
 FlushContext_In_Unmarshal(FlushContext_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2072,6 +2257,8 @@ FlushContext_In_Unmarshal(FlushContext_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_EvictControl
 TPM_RC
 EvictControl_In_Unmarshal(EvictControl_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2089,6 +2276,8 @@ EvictControl_In_Unmarshal(EvictControl_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_ClockSet
 TPM_RC
 ClockSet_In_Unmarshal(ClockSet_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2105,6 +2294,8 @@ ClockSet_In_Unmarshal(ClockSet_In *target, BYTE **buffer, uint32_t *size, TPM_HA
     }
     return rc;
 }
+#endif
+#if CC_ClockRateAdjust
 TPM_RC
 ClockRateAdjust_In_Unmarshal(ClockRateAdjust_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2121,6 +2312,8 @@ ClockRateAdjust_In_Unmarshal(ClockRateAdjust_In *target, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_GetCapability
 TPM_RC
 GetCapability_In_Unmarshal(GetCapability_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2147,6 +2340,8 @@ GetCapability_In_Unmarshal(GetCapability_In *target, BYTE **buffer, uint32_t *si
     }
     return rc;
 }
+#endif
+#if CC_TestParms
 TPM_RC
 TestParms_In_Unmarshal(TestParms_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2161,6 +2356,8 @@ TestParms_In_Unmarshal(TestParms_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_NV_DefineSpace
 TPM_RC
 NV_DefineSpace_In_Unmarshal(NV_DefineSpace_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2183,6 +2380,8 @@ NV_DefineSpace_In_Unmarshal(NV_DefineSpace_In *target, BYTE **buffer, uint32_t *
     }
     return rc;
 }
+#endif
+#if CC_NV_UndefineSpace
 TPM_RC
 NV_UndefineSpace_In_Unmarshal(NV_UndefineSpace_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2196,6 +2395,8 @@ NV_UndefineSpace_In_Unmarshal(NV_UndefineSpace_In *target, BYTE **buffer, uint32
     }
     return rc;
 }
+#endif
+#if CC_NV_UndefineSpaceSpecial
 TPM_RC
 NV_UndefineSpaceSpecial_In_Unmarshal(NV_UndefineSpaceSpecial_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2209,6 +2410,8 @@ NV_UndefineSpaceSpecial_In_Unmarshal(NV_UndefineSpaceSpecial_In *target, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_NV_ReadPublic
 TPM_RC
 NV_ReadPublic_In_Unmarshal(NV_ReadPublic_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2221,6 +2424,8 @@ NV_ReadPublic_In_Unmarshal(NV_ReadPublic_In *target, BYTE **buffer, uint32_t *si
     }
     return rc;
 }
+#endif
+#if CC_NV_Write
 TPM_RC
 NV_Write_In_Unmarshal(NV_Write_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2244,6 +2449,8 @@ NV_Write_In_Unmarshal(NV_Write_In *target, BYTE **buffer, uint32_t *size, TPM_HA
     }
     return rc;
 }
+#endif
+#if CC_NV_Increment
 TPM_RC
 NV_Increment_In_Unmarshal(NV_Increment_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2257,6 +2464,8 @@ NV_Increment_In_Unmarshal(NV_Increment_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_NV_Extend
 TPM_RC
 NV_Extend_In_Unmarshal(NV_Extend_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2274,6 +2483,8 @@ NV_Extend_In_Unmarshal(NV_Extend_In *target, BYTE **buffer, uint32_t *size, TPM_
     }
     return rc;
 }
+#endif
+#if CC_NV_SetBits
 TPM_RC
 NV_SetBits_In_Unmarshal(NV_SetBits_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2291,6 +2502,8 @@ NV_SetBits_In_Unmarshal(NV_SetBits_In *target, BYTE **buffer, uint32_t *size, TP
     }
     return rc;
 }
+#endif
+#if CC_NV_WriteLock
 TPM_RC
 NV_WriteLock_In_Unmarshal(NV_WriteLock_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2304,6 +2517,8 @@ NV_WriteLock_In_Unmarshal(NV_WriteLock_In *target, BYTE **buffer, uint32_t *size
     }
     return rc;
 }
+#endif
+#if CC_NV_GlobalWriteLock
 TPM_RC
 NV_GlobalWriteLock_In_Unmarshal(NV_GlobalWriteLock_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2316,6 +2531,8 @@ NV_GlobalWriteLock_In_Unmarshal(NV_GlobalWriteLock_In *target, BYTE **buffer, ui
     }
     return rc;
 }
+#endif
+#if CC_NV_Read
 TPM_RC
 NV_Read_In_Unmarshal(NV_Read_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2339,6 +2556,8 @@ NV_Read_In_Unmarshal(NV_Read_In *target, BYTE **buffer, uint32_t *size, TPM_HAND
     }
     return rc;
 }
+#endif
+#if CC_NV_ReadLock
 TPM_RC
 NV_ReadLock_In_Unmarshal(NV_ReadLock_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2352,6 +2571,8 @@ NV_ReadLock_In_Unmarshal(NV_ReadLock_In *target, BYTE **buffer, uint32_t *size,
     }
     return rc;
 }
+#endif
+#if CC_NV_ChangeAuth
 TPM_RC
 NV_ChangeAuth_In_Unmarshal(NV_ChangeAuth_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2368,6 +2589,8 @@ NV_ChangeAuth_In_Unmarshal(NV_ChangeAuth_In *target, BYTE **buffer, uint32_t *si
     }
     return rc;
 }
+#endif
+#if CC_NV_Certify
 TPM_RC
 NV_Certify_In_Unmarshal(NV_Certify_In *target, BYTE **buffer, uint32_t *size, TPM_HANDLE handles[])
 {
@@ -2404,5 +2627,6 @@ NV_Certify_In_Unmarshal(NV_Certify_In *target, BYTE **buffer, uint32_t *size, TP
     }
     return rc;
 }
+#endif
 
 #endif /* TPM_TSS_NOCMDCHECK */
@@ -40,6 +40,8 @@
 
 #include <ibmtss/Unmarshal_fp.h>
 
+#include "tssmarshaldesc.h"
+
 /* The functions with the TSS_ prefix are preferred.  They use an unsigned size.  The functions
    without the prefix are deprecated.  */
 
@@ -184,22 +186,211 @@ TPM_RC Array_Unmarshal(BYTE *targetBuffer, UINT16 targetSize, BYTE **buffer, INT
 #endif /* TPM_TSS_NODEPRECATED */
 #ifdef TPM_TPM20
 
+/* TSS_TPM2B_Unmarshalu() is called for every TPM2B, so the size and the array are unmarshaled
+   inline rather than through TSS_UINT16_Unmarshalu() and TSS_Array_Unmarshalu(). */
+
 TPM_RC
 TSS_TPM2B_Unmarshalu(TPM2B *target, uint16_t targetSize, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
+    if (*size < sizeof(uint16_t)) {
+	return TPM_RC_INSUFFICIENT;
+    }
+    target->size = ((uint16_t)((*buffer)[0]) << 8) |
+		   ((uint16_t)((*buffer)[1]) << 0);
+    if (target->size > targetSize) {
+	return TPM_RC_SIZE;
+    }
+    if ((*size - sizeof(uint16_t)) < target->size) {
+	return TPM_RC_INSUFFICIENT;
+    }
+    memcpy(target->buffer, *buffer + sizeof(uint16_t), target->size);
+    *buffer += sizeof(uint16_t) + target->size;
+    *size -= sizeof(uint16_t) + target->size;
+    return TPM_RC_SUCCESS;
+}
 
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->size, buffer, size);
+/* TSS_Desc_Unmarshalu() unmarshals the structure 'target' as described by 'desc'.  The parameters
+   and the result are those of the TSS_structure_Unmarshalu() functions.  The scalars are
+   unmarshaled inline.  See tssmarshaldesc.h.
+
+   After a TSS_DESC_SIZE field, the following fields must consume exactly the unmarshaled size. */
+
+TPM_RC
+TSS_Desc_Unmarshalu(void *target, const TSS_DESC_STRUCT *desc, BYTE **buffer, uint32_t *size)
+{
+    TPM_RC rc = TPM_RC_SUCCESS;
+    uint16_t i;
+    uint32_t j;
+    const TSS_DESC_FIELD *field;
+    BYTE *member;
+    BYTE *element;
+    uint8_t elementType;
+    BYTE *b;
+    uint32_t selector;
+    BYTE *sizeMember = NULL;	/* the TSS_DESC_SIZE member */
+    uint32_t startSize = 0;
+    BOOL empty = FALSE;		/* a zero TSS_DESC_SIZE, nothing follows */
+
+    for (i = 0 ; (rc == TPM_RC_SUCCESS) && !empty && (i < desc->fieldCount) ; i++) {
+	field = &desc->fields[i];
+	member = (BYTE *)target + field->offset;
+	b = *buffer;
+	switch (field->type) {
+	  case TSS_DESC_UINT8:
+	    if (*size < sizeof(UINT8)) {
+		rc = TPM_RC_INSUFFICIENT;
+		break;
+	    }
+	    *(UINT8 *)member = b[0];
+	    *buffer += sizeof(UINT8);
+	    *size -= sizeof(UINT8);
+	    break;
+	  case TSS_DESC_UINT16:
+	    if (*size < sizeof(UINT16)) {
+		rc = TPM_RC_INSUFFICIENT;
+		break;
+	    }
+	    *(UINT16 *)member = ((UINT16)b[0] << 8) | ((UINT16)b[1] << 0);
+	    *buffer += sizeof(UINT16);
+	    *size -= sizeof(UINT16);
+	    break;
+	  case TSS_DESC_UINT32:
+	  case TSS_DESC_GENERATED:
+	    if (*size < sizeof(UINT32)) {
+		rc = TPM_RC_INSUFFICIENT;
+		break;
+	    }
+	    *(UINT32 *)member = ((UINT32)b[0] << 24) | ((UINT32)b[1] << 16) |
+				((UINT32)b[2] <<  8) | ((UINT32)b[3] <<  0);
+	    *buffer += sizeof(UINT32);
+	    *size -= sizeof(UINT32);
+	    if ((field->type == TSS_DESC_GENERATED) &&
+		(*(UINT32 *)member != TPM_GENERATED_VALUE)) {
+		rc = TPM_RC_VALUE;
+	    }
+	    break;
+	  case TSS_DESC_UINT64:
+	    if (*size < sizeof(UINT64)) {
+		rc = TPM_RC_INSUFFICIENT;
+		break;
+	    }
+	    *(UINT64 *)member = ((UINT64)b[0] << 56) | ((UINT64)b[1] << 48) |
+				((UINT64)b[2] << 40) | ((UINT64)b[3] << 32) |
+				((UINT64)b[4] << 24) | ((UINT64)b[5] << 16) |
+				((UINT64)b[6] <<  8) | ((UINT64)b[7] <<  0);
+	    *buffer += sizeof(UINT64);
+	    *size -= sizeof(UINT64);
+	    break;
+	  case TSS_DESC_CHECK:
+	    if (field->flag == TSS_DESC_CHECK_PLAIN) {
+		rc = ((UnmarshalFunction_t)field->unmarshal)(member, buffer, size);
+	    }
+	    else {
+		rc = ((UnmarshalFunctionFlag_t)field->unmarshal)
+		     (member, buffer, size, (field->flag == TSS_DESC_CHECK_YES) ? YES : NO);
+	    }
+	    break;
+	  case TSS_DESC_TPM2B:
+	    rc = TSS_TPM2B_Unmarshalu((TPM2B *)member, field->param, buffer, size);
+	    break;
+	  case TSS_DESC_SELECT:
+	    if (*size < sizeof(UINT8)) {
+		rc = TPM_RC_INSUFFICIENT;
+		break;
+	    }
+	    *(UINT8 *)member = b[0];
+	    *buffer += sizeof(UINT8);
+	    *size -= sizeof(UINT8);
+	    if (*(UINT8 *)member > field->param) {
+		rc = TPM_RC_VALUE;
+		break;
+	    }
+	    rc = TSS_Array_Unmarshalu((BYTE *)target + field->array, *(UINT8 *)member,
+				      buffer, size);
+	    break;
+	  case TSS_DESC_LIST:
+	    if (*size < sizeof(UINT32)) {
+		rc = TPM_RC_INSUFFICIENT;
+		break;
+	    }
+	    *(UINT32 *)member = ((UINT32)b[0] << 24) | ((UINT32)b[1] << 16) |
+				((UINT32)b[2] <<  8) | ((UINT32)b[3] <<  0);
+	    *buffer += sizeof(UINT32);
+	    *size -= sizeof(UINT32);
+	    if (*(UINT32 *)member > field->param) {
+		rc = TPM_RC_SIZE;
+		break;
+	    }
+	    /* TPML_HANDLE, TPML_CC, TPML_ALG, etc. elements are scalars, unmarshaled inline */
+	    elementType = (field->desc->fieldCount == 1) ? field->desc->fields[0].type : 0;
+	    for (j = 0 ; (rc == TPM_RC_SUCCESS) && (j < *(UINT32 *)member) ; j++) {
+		element = (BYTE *)target + field->array + (j * field->desc->size);
+		b = *buffer;
+		if ((elementType == TSS_DESC_UINT32) && (*size >= sizeof(UINT32))) {
+		    *(UINT32 *)element = ((UINT32)b[0] << 24) | ((UINT32)b[1] << 16) |
+					 ((UINT32)b[2] <<  8) | ((UINT32)b[3] <<  0);
+		    *buffer += sizeof(UINT32);
+		    *size -= sizeof(UINT32);
+		}
+		else if ((elementType == TSS_DESC_UINT16) && (*size >= sizeof(UINT16))) {
+		    *(UINT16 *)element = ((UINT16)b[0] << 8) | ((UINT16)b[1] << 0);
+		    *buffer += sizeof(UINT16);
+		    *size -= sizeof(UINT16);
+		}
+		else {
+		    rc = TSS_Desc_Unmarshalu(element, field->desc, buffer, size);
+		}
+	    }
+	    break;
+	  case TSS_DESC_UNION:
+	    if (field->flag == sizeof(UINT8)) {
+		selector = *((BYTE *)target + field->param);
+	    }
+	    else if (field->flag == sizeof(UINT16)) {
+		selector = *(UINT16 *)((BYTE *)target + field->param);
+	    }
+	    else {
+		selector = *(UINT32 *)((BYTE *)target + field->param);
+	    }
+	    rc = ((TSS_DescUnmarshalUnion_t)field->unmarshal)(member, buffer, size, selector);
+	    break;
+	  case TSS_DESC_SIZE:
+	    if (*size < sizeof(UINT16)) {
+		rc = TPM_RC_INSUFFICIENT;
+		break;
+	    }
+	    *(UINT16 *)member = ((UINT16)b[0] << 8) | ((UINT16)b[1] << 0);
+	    *buffer += sizeof(UINT16);
+	    *size -= sizeof(UINT16);
+	    if (*(UINT16 *)member != 0) {
+		sizeMember = member;
+		startSize = *size;
+	    }
+	    else if (field->flag) {
+		empty = TRUE;
+	    }
+	    else {
+		rc = TPM_RC_SIZE;
+	    }
+	    break;
+	  case TSS_DESC_STRUCTURE:
+	    rc = TSS_Desc_Unmarshalu(member, field->desc, buffer, size);
+	    break;
+	  case TSS_DESC_PCR_SELECTION:
+	    rc = TSS_TPML_PCR_SELECTION_Unmarshalu((TPML_PCR_SELECTION *)member, buffer, size);
+	    break;
+	  case TSS_DESC_PUBLIC:
+	    rc = TSS_TPMT_PUBLIC_Unmarshalu((TPMT_PUBLIC *)member, buffer, size, YES);
+	    break;
+	  default:
+	    rc = TPM_RC_FAILURE;
+	}
     }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size > targetSize) {
+    if ((rc == TPM_RC_SUCCESS) && (sizeMember != NULL)) {
+	if (*(UINT16 *)sizeMember != startSize - *size) {
 	    rc = TPM_RC_SIZE;
 	}
     }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_Array_Unmarshalu(target->buffer, target->size, buffer, size);
-    }
     return rc;
 }
 
@@ -1257,15 +1448,8 @@ TSS_TPMU_HA_Unmarshalu(TPMU_HA *target, BYTE **buffer, uint32_t *size, uint32_t
 TPM_RC
 TSS_TPMT_HA_Unmarshalu(TPMT_HA *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&target->hashAlg, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_HA_Unmarshalu(&target->digest, buffer, size, target->hashAlg);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_HA, buffer, size);
 }
 
 /* Table 72 - Definition of TPM2B_DIGEST Structure */
@@ -1420,23 +1604,7 @@ TSS_TPM2B_NAME_Unmarshalu(TPM2B_NAME *target, BYTE **buffer, uint32_t *size)
 TPM_RC
 TSS_TPMS_PCR_SELECTION_Unmarshalu(TPMS_PCR_SELECTION *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&target->hash, buffer, size, NO);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT8_Unmarshalu(&target->sizeofSelect, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->sizeofSelect > PCR_SELECT_MAX) {
-	    rc = TPM_RC_VALUE;
-	}
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_Array_Unmarshalu(target->pcrSelect, target->sizeofSelect, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_PCR_SELECTION, buffer, size);
 }
 
 /* Table 88 - Definition of TPMT_TK_CREATION Structure */
@@ -1541,15 +1709,7 @@ TSS_TPMT_TK_HASHCHECK_Unmarshalu(TPMT_TK_HASHCHECK *target, BYTE **buffer, uint3
 TPM_RC
 TSS_TPMS_ALG_PROPERTY_Unmarshalu(TPMS_ALG_PROPERTY *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_ALG_ID_Unmarshalu(&target->alg, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMA_ALGORITHM_Unmarshalu(&target->algProperties, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_ALG_PROPERTY, buffer, size);
 }
 
 /* Table 93 - Definition of TPMS_TAGGED_PROPERTY Structure <OUT> */
@@ -1557,15 +1717,7 @@ TSS_TPMS_ALG_PROPERTY_Unmarshalu(TPMS_ALG_PROPERTY *target, BYTE **buffer, uint3
 TPM_RC
 TSS_TPMS_TAGGED_PROPERTY_Unmarshalu(TPMS_TAGGED_PROPERTY *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_PT_Unmarshalu(&target->property, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->value, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_TAGGED_PROPERTY, buffer, size);
 }
 
 /* Table 94 - Definition of TPMS_TAGGED_PCR_SELECT Structure <OUT> */
@@ -1573,51 +1725,21 @@ TSS_TPMS_TAGGED_PROPERTY_Unmarshalu(TPMS_TAGGED_PROPERTY *target, BYTE **buffer,
 TPM_RC
 TSS_TPMS_TAGGED_PCR_SELECT_Unmarshalu(TPMS_TAGGED_PCR_SELECT *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_PT_PCR_Unmarshalu(&target->tag, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT8_Unmarshalu(&target->sizeofSelect, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_Array_Unmarshalu(target->pcrSelect, target->sizeofSelect, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_TAGGED_PCR_SELECT, buffer, size);
 }
 
 /* Table 100 - Definition of TPMS_TAGGED_POLICY Structure <OUT> */
 
 TPM_RC
-TSS_TPMS_TAGGED_POLICY_Unmarshalu(TPMS_TAGGED_POLICY *target, BYTE **buffer, uint32_t *size) 
+TSS_TPMS_TAGGED_POLICY_Unmarshalu(TPMS_TAGGED_POLICY *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_HANDLE_Unmarshalu(&target->handle, buffer, size);  
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_HA_Unmarshalu(&target->policyHash, buffer, size, YES);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_TAGGED_POLICY, buffer, size);
 }
 
 TPM_RC
 TSS_TPMS_ACT_DATA_Unmarshalu(TPMS_ACT_DATA *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_HANDLE_Unmarshalu(&target->handle, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->timeout, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMA_ACT_Unmarshalu(&target->attributes, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_ACT_DATA, buffer, size);
 }
 
 /* Table 95 - Definition of TPML_CC Structure */
@@ -1625,21 +1747,7 @@ TSS_TPMS_ACT_DATA_Unmarshalu(TPMS_ACT_DATA *target, BYTE **buffer, uint32_t *siz
 TPM_RC
 TSS_TPML_CC_Unmarshalu(TPML_CC *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    uint32_t i;
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_CAP_CC) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPM_CC_Unmarshalu(&target->commandCodes[i], buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_CC, buffer, size);
 }
 
 /* Table 96 - Definition of TPML_CCA Structure <OUT> */
@@ -1647,21 +1755,7 @@ TSS_TPML_CC_Unmarshalu(TPML_CC *target, BYTE **buffer, uint32_t *size)
 TPM_RC
 TSS_TPML_CCA_Unmarshalu(TPML_CCA *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    uint32_t i;
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_CAP_CC) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPMA_CC_Unmarshalu(&target->commandAttributes[i], buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_CCA, buffer, size);
 }
 
 /* Table 97 - Definition of TPML_ALG Structure */
@@ -1669,21 +1763,7 @@ TSS_TPML_CCA_Unmarshalu(TPML_CCA *target, BYTE **buffer, uint32_t *size)
 TPM_RC
 TSS_TPML_ALG_Unmarshalu(TPML_ALG *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    uint32_t i;
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_ALG_LIST_SIZE) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPM_ALG_ID_Unmarshalu(&target->algorithms[i], buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_ALG, buffer, size);
 }
 
 /* Table 98 - Definition of TPML_HANDLE Structure <OUT> */
@@ -1691,21 +1771,7 @@ TSS_TPML_ALG_Unmarshalu(TPML_ALG *target, BYTE **buffer, uint32_t *size)
 TPM_RC
 TSS_TPML_HANDLE_Unmarshalu(TPML_HANDLE *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    uint32_t i;
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_CAP_HANDLES) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPM_HANDLE_Unmarshalu(&target->handle[i], buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_HANDLE, buffer, size);
 }
 
 /* Table 99 - Definition of TPML_DIGEST Structure */
@@ -1744,31 +1810,22 @@ TSS_TPML_DIGEST_Unmarshalu(TPML_DIGEST *target, BYTE **buffer, uint32_t *size, u
 TPM_RC
 TSS_TPML_DIGEST_VALUES_Unmarshalu(TPML_DIGEST_VALUES *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    uint32_t i;
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > HASH_COUNT) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPMT_HA_Unmarshalu(&target->digests[i], buffer, size, NO);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_DIGEST_VALUES, buffer, size);
 }
 
 /* Table 102 - Definition of TPML_PCR_SELECTION Structure */
 
+/* The TPMS_PCR_SELECTION elements are unmarshaled inline.  This is equivalent to
+   TSS_TPMS_PCR_SELECTION_Unmarshalu(), where TSS_TPMI_ALG_HASH_Unmarshalu() does not check the
+   algorithm. */
+
 TPM_RC
 TSS_TPML_PCR_SELECTION_Unmarshalu(TPML_PCR_SELECTION *target, BYTE **buffer, uint32_t *size)
 {
     TPM_RC rc = TPM_RC_SUCCESS;
-    
+    TPMS_PCR_SELECTION *selection;
     uint32_t i;
+
     if (rc == TPM_RC_SUCCESS) {
 	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
     }
@@ -1778,7 +1835,22 @@ TSS_TPML_PCR_SELECTION_Unmarshalu(TPML_PCR_SELECTION *target, BYTE **buffer, uin
 	}
     }
     for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPMS_PCR_SELECTION_Unmarshalu(&target->pcrSelections[i], buffer, size);
+	selection = &target->pcrSelections[i];
+	/* hash and sizeofSelect */
+	if (*size < (sizeof(TPMI_ALG_HASH) + sizeof(UINT8))) {
+	    rc = TPM_RC_INSUFFICIENT;
+	    break;
+	}
+	selection->hash = ((uint16_t)((*buffer)[0]) << 8) |
+			  ((uint16_t)((*buffer)[1]) << 0);
+	selection->sizeofSelect = (*buffer)[2];
+	*buffer += sizeof(TPMI_ALG_HASH) + sizeof(UINT8);
+	*size -= sizeof(TPMI_ALG_HASH) + sizeof(UINT8);
+	if (selection->sizeofSelect > PCR_SELECT_MAX) {
+	    rc = TPM_RC_VALUE;
+	    break;
+	}
+	rc = TSS_Array_Unmarshalu(selection->pcrSelect, selection->sizeofSelect, buffer, size);
     }
     return rc;
 }
@@ -1788,21 +1860,7 @@ TSS_TPML_PCR_SELECTION_Unmarshalu(TPML_PCR_SELECTION *target, BYTE **buffer, uin
 TPM_RC
 TSS_TPML_ALG_PROPERTY_Unmarshalu(TPML_ALG_PROPERTY *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    uint32_t i;
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_CAP_ALGS) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPMS_ALG_PROPERTY_Unmarshalu(&target->algProperties[i], buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_ALG_PROPERTY, buffer, size);
 }
 
 /* Table 104 - Definition of TPML_TAGGED_TPM_PROPERTY Structure <OUT> */
@@ -1810,21 +1868,7 @@ TSS_TPML_ALG_PROPERTY_Unmarshalu(TPML_ALG_PROPERTY *target, BYTE **buffer, uint3
 TPM_RC
 TSS_TPML_TAGGED_TPM_PROPERTY_Unmarshalu(TPML_TAGGED_TPM_PROPERTY  *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    uint32_t i;
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_TPM_PROPERTIES) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPMS_TAGGED_PROPERTY_Unmarshalu(&target->tpmProperty[i], buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_TAGGED_TPM_PROPERTY, buffer, size);
 }
 
 /* Table 105 - Definition of TPML_TAGGED_PCR_PROPERTY Structure <OUT> */
@@ -1832,21 +1876,7 @@ TSS_TPML_TAGGED_TPM_PROPERTY_Unmarshalu(TPML_TAGGED_TPM_PROPERTY  *target, BYTE
 TPM_RC
 TSS_TPML_TAGGED_PCR_PROPERTY_Unmarshalu(TPML_TAGGED_PCR_PROPERTY *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    uint32_t i;
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_PCR_PROPERTIES) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPMS_TAGGED_PCR_SELECT_Unmarshalu(&target->pcrProperty[i], buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_TAGGED_PCR_PROPERTY, buffer, size);
 }
 
 /* Table 106 - Definition of {ECC} TPML_ECC_CURVE Structure <OUT> */
@@ -1854,21 +1884,7 @@ TSS_TPML_TAGGED_PCR_PROPERTY_Unmarshalu(TPML_TAGGED_PCR_PROPERTY *target, BYTE *
 TPM_RC
 TSS_TPML_ECC_CURVE_Unmarshalu(TPML_ECC_CURVE *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    uint32_t i;
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_ECC_CURVES) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPM_ECC_CURVE_Unmarshalu(&target->eccCurves[i], buffer, size);
-    }
-    return rc;	
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_ECC_CURVE, buffer, size);
 }
 
 /* Table 112 - Definition of TPML_TAGGED_POLICY Structure <OUT> */
@@ -1876,21 +1892,7 @@ TSS_TPML_ECC_CURVE_Unmarshalu(TPML_ECC_CURVE *target, BYTE **buffer, uint32_t *s
 TPM_RC
 TSS_TPML_TAGGED_POLICY_Unmarshalu(TPML_TAGGED_POLICY *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    uint32_t i;  
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_TAGGED_POLICIES) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPMS_TAGGED_POLICY_Unmarshalu(&target->policies[i], buffer, size);
-    }
-    return rc;	
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_TAGGED_POLICY, buffer, size);
 }
 
 /* Table 112 - Definition of TPML_ACT_DATA Structure <OUT> */
@@ -1898,21 +1900,7 @@ TSS_TPML_TAGGED_POLICY_Unmarshalu(TPML_TAGGED_POLICY *target, BYTE **buffer, uin
 TPM_RC
 TSS_TPML_ACT_DATA_Unmarshalu(TPML_ACT_DATA *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    uint32_t i;  
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->count, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->count > MAX_ACT_DATA) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    for (i = 0 ; (rc == TPM_RC_SUCCESS) && (i < target->count) ; i++) {
-	rc = TSS_TPMS_ACT_DATA_Unmarshalu(&target->actData[i], buffer, size);
-    }
-    return rc;	
+    return TSS_Desc_Unmarshalu(target, &tssDescTPML_ACT_DATA, buffer, size);
 }
 
 /* Table 107 - Definition of TPMU_CAPABILITIES Union <OUT> */
@@ -1967,15 +1955,7 @@ TSS_TPMU_CAPABILITIES_Unmarshalu(TPMU_CAPABILITIES *target, BYTE **buffer, uint3
 TPM_RC
 TSS_TPMS_CAPABILITY_DATA_Unmarshalu(TPMS_CAPABILITY_DATA *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-  
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_CAP_Unmarshalu(&target->capability, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_CAPABILITIES_Unmarshalu(&target->data, buffer, size, target->capability);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_CAPABILITY_DATA, buffer, size);
 }
 
 /* Table 109 - Definition of TPMS_CLOCK_INFO Structure */
@@ -1983,21 +1963,7 @@ TSS_TPMS_CAPABILITY_DATA_Unmarshalu(TPMS_CAPABILITY_DATA *target, BYTE **buffer,
 TPM_RC
 TSS_TPMS_CLOCK_INFO_Unmarshalu(TPMS_CLOCK_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT64_Unmarshalu(&target->clock, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->resetCount, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->restartCount, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_YES_NO_Unmarshalu(&target->safe, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_CLOCK_INFO, buffer, size);
 }
 
 /* Table 110 - Definition of TPMS_TIME_INFO Structure */
@@ -2005,15 +1971,7 @@ TSS_TPMS_CLOCK_INFO_Unmarshalu(TPMS_CLOCK_INFO *target, BYTE **buffer, uint32_t
 TPM_RC
 TSS_TPMS_TIME_INFO_Unmarshalu(TPMS_TIME_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT64_Unmarshalu(&target->time, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMS_CLOCK_INFO_Unmarshalu(&target->clockInfo, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_TIME_INFO, buffer, size);
 }
 
 /* #ifndef TPM_TSS_NOCMDCHECK */
@@ -2023,15 +1981,7 @@ TSS_TPMS_TIME_INFO_Unmarshalu(TPMS_TIME_INFO *target, BYTE **buffer, uint32_t *s
 TPM_RC
 TSS_TPMS_TIME_ATTEST_INFO_Unmarshalu(TPMS_TIME_ATTEST_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMS_TIME_INFO_Unmarshalu(&target->time, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT64_Unmarshalu(&target->firmwareVersion, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_TIME_ATTEST_INFO, buffer, size);
 }
 
 /* Table 112 - Definition of TPMS_CERTIFY_INFO Structure <OUT> */
@@ -2039,15 +1989,7 @@ TSS_TPMS_TIME_ATTEST_INFO_Unmarshalu(TPMS_TIME_ATTEST_INFO *target, BYTE **buffe
 TPM_RC
 TSS_TPMS_CERTIFY_INFO_Unmarshalu(TPMS_CERTIFY_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_NAME_Unmarshalu(&target->name, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_NAME_Unmarshalu(&target->qualifiedName, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_CERTIFY_INFO, buffer, size);
 }
 
 /* Table 113 - Definition of TPMS_QUOTE_INFO Structure <OUT> */
@@ -2055,15 +1997,7 @@ TSS_TPMS_CERTIFY_INFO_Unmarshalu(TPMS_CERTIFY_INFO *target, BYTE **buffer, uint3
 TPM_RC
 TSS_TPMS_QUOTE_INFO_Unmarshalu(TPMS_QUOTE_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPML_PCR_SELECTION_Unmarshalu(&target->pcrSelect, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->pcrDigest, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_QUOTE_INFO, buffer, size);
 }
 
 /* Table 114 - Definition of TPMS_COMMAND_AUDIT_INFO Structure <OUT> */
@@ -2071,21 +2005,7 @@ TSS_TPMS_QUOTE_INFO_Unmarshalu(TPMS_QUOTE_INFO *target, BYTE **buffer, uint32_t
 TPM_RC
 TSS_TPMS_COMMAND_AUDIT_INFO_Unmarshalu(TPMS_COMMAND_AUDIT_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT64_Unmarshalu(&target->auditCounter, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_ALG_ID_Unmarshalu(&target->digestAlg, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->auditDigest, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->commandDigest, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_COMMAND_AUDIT_INFO, buffer, size);
 }
 
 /* Table 115 - Definition of TPMS_SESSION_AUDIT_INFO Structure <OUT> */
@@ -2093,15 +2013,7 @@ TSS_TPMS_COMMAND_AUDIT_INFO_Unmarshalu(TPMS_COMMAND_AUDIT_INFO *target, BYTE **b
 TPM_RC
 TSS_TPMS_SESSION_AUDIT_INFO_Unmarshalu(TPMS_SESSION_AUDIT_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_YES_NO_Unmarshalu(&target->exclusiveSession, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->sessionDigest, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_SESSION_AUDIT_INFO, buffer, size);
 }
 
 /* Table 116 - Definition of TPMS_CREATION_INFO Structure <OUT> */
@@ -2109,15 +2021,7 @@ TSS_TPMS_SESSION_AUDIT_INFO_Unmarshalu(TPMS_SESSION_AUDIT_INFO *target, BYTE **b
 TPM_RC
 TSS_TPMS_CREATION_INFO_Unmarshalu(TPMS_CREATION_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_NAME_Unmarshalu(&target->objectName, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->creationHash, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_CREATION_INFO, buffer, size);
 }
 
 /* Table 117 - Definition of TPMS_NV_CERTIFY_INFO Structure <OUT> */
@@ -2125,33 +2029,14 @@ TSS_TPMS_CREATION_INFO_Unmarshalu(TPMS_CREATION_INFO *target, BYTE **buffer, uin
 TPM_RC
 TSS_TPMS_NV_CERTIFY_INFO_Unmarshalu(TPMS_NV_CERTIFY_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_NAME_Unmarshalu(&target->indexName, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->offset, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_MAX_NV_BUFFER_Unmarshalu(&target->nvContents, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_NV_CERTIFY_INFO, buffer, size);
 }
 
 /* Table 125 - Definition of TPMS_NV_DIGEST_CERTIFY_INFO Structure <OUT> */
 TPM_RC
 TSS_TPMS_NV_DIGEST_CERTIFY_INFO_Unmarshalu(TPMS_NV_DIGEST_CERTIFY_INFO *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_NAME_Unmarshalu(&target->indexName, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->nvDigest, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_NV_DIGEST_CERTIFY_INFO, buffer, size);
 }
 
 /* Table 118 - Definition of (TPM_ST) TPMI_ST_ATTEST Type <OUT> */
@@ -2211,30 +2096,7 @@ TSS_TPMU_ATTEST_Unmarshalu(TPMU_ATTEST *target, BYTE **buffer, uint32_t *size, u
 TPM_RC
 TSS_TPMS_ATTEST_Unmarshalu(TPMS_ATTEST *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_GENERATED_Unmarshalu(&target->magic, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ST_ATTEST_Unmarshalu(&target->type, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_NAME_Unmarshalu(&target->qualifiedSigner, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DATA_Unmarshalu(&target->extraData, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMS_CLOCK_INFO_Unmarshalu(&target->clockInfo, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT64_Unmarshalu(&target->firmwareVersion, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_ATTEST_Unmarshalu(&target->attested, buffer, size, target->type);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_ATTEST, buffer, size);
 }
 
 /* #endif	TPM_TSS_NOCMDCHECK */
@@ -2257,18 +2119,7 @@ TSS_TPM2B_ATTEST_Unmarshalu(TPM2B_ATTEST *target, BYTE **buffer, uint32_t *size)
 TPM_RC
 TSS_TPMS_AUTH_RESPONSE_Unmarshalu(TPMS_AUTH_RESPONSE *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_NONCE_Unmarshalu(&target->nonce, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMA_SESSION_Unmarshalu(&target->sessionAttributes, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_AUTH_Unmarshalu(&target->hmac, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_AUTH_RESPONSE, buffer, size);
 }
 
 /* Table 124 - Definition of {!ALG.S} (TPM_KEY_BITS) TPMI_!ALG.S_KEY_BITS Type */
@@ -2389,18 +2240,8 @@ TSS_TPMU_SYM_MODE_Unmarshalu(TPMU_SYM_MODE *target, BYTE **buffer, uint32_t *siz
 TPM_RC
 TSS_TPMT_SYM_DEF_Unmarshalu(TPMT_SYM_DEF *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_SYM_Unmarshalu(&target->algorithm, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_SYM_KEY_BITS_Unmarshalu(&target->keyBits, buffer, size, target->algorithm);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_SYM_MODE_Unmarshalu(&target->mode, buffer, size, target->algorithm);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_SYM_DEF, buffer, size);
 }
 
 /* Table 129 - Definition of TPMT_SYM_DEF_OBJECT Structure */
@@ -2408,18 +2249,8 @@ TSS_TPMT_SYM_DEF_Unmarshalu(TPMT_SYM_DEF *target, BYTE **buffer, uint32_t *size,
 TPM_RC
 TSS_TPMT_SYM_DEF_OBJECT_Unmarshalu(TPMT_SYM_DEF_OBJECT *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_SYM_OBJECT_Unmarshalu(&target->algorithm, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_SYM_KEY_BITS_Unmarshalu(&target->keyBits, buffer, size, target->algorithm);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_SYM_MODE_Unmarshalu(&target->mode, buffer, size, target->algorithm);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_SYM_DEF_OBJECT, buffer, size);
 }
 
 /* #ifndef TPM_TSS_NOCMDCHECK */
@@ -2444,12 +2275,7 @@ TSS_TPM2B_SYM_KEY_Unmarshalu(TPM2B_SYM_KEY *target, BYTE **buffer, uint32_t *siz
 TPM_RC
 TSS_TPMS_SYMCIPHER_PARMS_Unmarshalu(TPMS_SYMCIPHER_PARMS *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_SYM_DEF_OBJECT_Unmarshalu(&target->sym, buffer, size, NO);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_SYMCIPHER_PARMS, buffer, size);
 }
 
 /* Table 132 - Definition of TPM2B_SENSITIVE_DATA Structure */
@@ -2472,15 +2298,7 @@ TSS_TPM2B_SENSITIVE_DATA_Unmarshalu(TPM2B_SENSITIVE_DATA *target, BYTE **buffer,
 TPM_RC
 TSS_TPMS_SENSITIVE_CREATE_Unmarshalu(TPMS_SENSITIVE_CREATE *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_AUTH_Unmarshalu(&target->userAuth, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_SENSITIVE_DATA_Unmarshalu(&target->data, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_SENSITIVE_CREATE, buffer, size);
 }
 
 /* Table 134 - Definition of TPM2B_SENSITIVE_CREATE Structure <IN, S> */
@@ -2488,29 +2306,7 @@ TSS_TPMS_SENSITIVE_CREATE_Unmarshalu(TPMS_SENSITIVE_CREATE *target, BYTE **buffe
 TPM_RC
 TSS_TPM2B_SENSITIVE_CREATE_Unmarshalu(TPM2B_SENSITIVE_CREATE *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    uint32_t startSize = 0;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->size, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size == 0) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	startSize = *size;
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMS_SENSITIVE_CREATE_Unmarshalu(&target->sensitive, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size != startSize - *size) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPM2B_SENSITIVE_CREATE, buffer, size);
 }
 
 /* #endif	TPM_TSS_NOCMDCHECK */
@@ -2520,28 +2316,15 @@ TSS_TPM2B_SENSITIVE_CREATE_Unmarshalu(TPM2B_SENSITIVE_CREATE *target, BYTE **buf
 TPM_RC
 TSS_TPMS_SCHEME_HASH_Unmarshalu(TPMS_SCHEME_HASH *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&target->hashAlg, buffer, size, NO);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_SCHEME_HASH, buffer, size);
 }
 
 /* Table 136 - Definition of {ECC} TPMS_SCHEME_ECDAA Structure */
 
 TPM_RC
-TSS_TPMS_SCHEME_ECDAA_Unmarshalu(TPMS_SCHEME_ECDAA *target, BYTE **buffer, uint32_t *size) 
+TSS_TPMS_SCHEME_ECDAA_Unmarshalu(TPMS_SCHEME_ECDAA *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&target->hashAlg, buffer, size, NO);	
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->count, buffer, size);	
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_SCHEME_ECDAA, buffer, size);
 }
 
 /* Table 137 - Definition of (TPM_ALG_ID) TPMI_ALG_KEYEDHASH_SCHEME Type */
@@ -2576,15 +2359,7 @@ TSS_TPMS_SCHEME_HMAC_Unmarshalu(TPMS_SCHEME_HMAC *target, BYTE **buffer, uint32_
 TPM_RC
 TSS_TPMS_SCHEME_XOR_Unmarshalu(TPMS_SCHEME_XOR *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&target->hashAlg, buffer, size, NO);	/* as of rev 147 */
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_KDF_Unmarshalu(&target->kdf, buffer, size, YES);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_SCHEME_XOR, buffer, size);
 }
 
 /* Table 140 - Definition of TPMU_SCHEME_KEYEDHASH Union <IN/OUT, S> */
@@ -2618,15 +2393,8 @@ TSS_TPMU_SCHEME_KEYEDHASH_Unmarshalu(TPMU_SCHEME_KEYEDHASH *target, BYTE **buffe
 TPM_RC
 TSS_TPMT_KEYEDHASH_SCHEME_Unmarshalu(TPMT_KEYEDHASH_SCHEME *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_KEYEDHASH_SCHEME_Unmarshalu(&target->scheme, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_SCHEME_KEYEDHASH_Unmarshalu(&target->details, buffer, size, target->scheme);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_KEYEDHASH_SCHEME, buffer, size);
 }
 
 /* Table 142 - Definition of {RSA} Types for RSA Signature Schemes */
@@ -2765,15 +2533,8 @@ TSS_TPMU_SIG_SCHEME_Unmarshalu(TPMU_SIG_SCHEME *target, BYTE **buffer, uint32_t
 TPM_RC
 TSS_TPMT_SIG_SCHEME_Unmarshalu(TPMT_SIG_SCHEME *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_SIG_SCHEME_Unmarshalu(&target->scheme, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_SIG_SCHEME_Unmarshalu(&target->details, buffer, size, target->scheme);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_SIG_SCHEME, buffer, size);
 }
 
 /* #endif	TPM_TSS_NOCMDCHECK */
@@ -2929,15 +2690,8 @@ TSS_TPMU_KDF_SCHEME_Unmarshalu(TPMU_KDF_SCHEME *target, BYTE **buffer, uint32_t
 TPM_RC
 TSS_TPMT_KDF_SCHEME_Unmarshalu(TPMT_KDF_SCHEME *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_KDF_Unmarshalu(&target->scheme, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_KDF_SCHEME_Unmarshalu(&target->details, buffer, size, target->scheme);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_KDF_SCHEME, buffer, size);
 }
 
 /* Table 151 - Definition of (TPM_ALG_ID) TPMI_ALG_ASYM_SCHEME Type <> */
@@ -3027,15 +2781,8 @@ TSS_TPMU_ASYM_SCHEME_Unmarshalu(TPMU_ASYM_SCHEME *target, BYTE **buffer, uint32_
 TPM_RC
 TSS_TPMT_ASYM_SCHEME_Unmarshalu(TPMT_ASYM_SCHEME *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_ASYM_SCHEME_Unmarshalu(&target->scheme, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_ASYM_SCHEME_Unmarshalu(&target->details, buffer, size, target->scheme);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_ASYM_SCHEME, buffer, size);
 }
 #endif	/* 0 */
 
@@ -3058,15 +2805,8 @@ TSS_TPMI_ALG_RSA_SCHEME_Unmarshalu(TPMI_ALG_RSA_SCHEME *target, BYTE **buffer, u
 TPM_RC
 TSS_TPMT_RSA_SCHEME_Unmarshalu(TPMT_RSA_SCHEME *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_RSA_SCHEME_Unmarshalu(&target->scheme, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_ASYM_SCHEME_Unmarshalu(&target->details, buffer, size, target->scheme);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_RSA_SCHEME, buffer, size);
 }
 
 /* #ifndef TPM_TSS_NOCMDCHECK */
@@ -3090,15 +2830,8 @@ TSS_TPMI_ALG_RSA_DECRYPT_Unmarshalu(TPMI_ALG_RSA_DECRYPT *target, BYTE **buffer,
 TPM_RC
 TSS_TPMT_RSA_DECRYPT_Unmarshalu(TPMT_RSA_DECRYPT *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_RSA_DECRYPT_Unmarshalu(&target->scheme, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_ASYM_SCHEME_Unmarshalu(&target->details, buffer, size, target->scheme);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_RSA_DECRYPT, buffer, size);
 }
 
 /* #endif TPM_TSS_NOCMDCHECK */
@@ -3163,15 +2896,7 @@ TSS_TPM2B_ECC_PARAMETER_Unmarshalu(TPM2B_ECC_PARAMETER *target, BYTE **buffer, u
 TPM_RC
 TSS_TPMS_ECC_POINT_Unmarshalu(TPMS_ECC_POINT *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->x, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->y, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_ECC_POINT, buffer, size);
 }
 
 /* Table 163 - Definition of {ECC} TPM2B_ECC_POINT Structure */
@@ -3179,29 +2904,7 @@ TSS_TPMS_ECC_POINT_Unmarshalu(TPMS_ECC_POINT *target, BYTE **buffer, uint32_t *s
 TPM_RC
 TSS_TPM2B_ECC_POINT_Unmarshalu(TPM2B_ECC_POINT *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    uint32_t startSize = 0;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->size, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size == 0) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	startSize = *size;
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMS_ECC_POINT_Unmarshalu(&target->point, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size != startSize - *size) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPM2B_ECC_POINT, buffer, size);
 }
 
 /* Table 164 - Definition of (TPM_ALG_ID) {ECC} TPMI_ALG_ECC_SCHEME Type */
@@ -3236,15 +2939,8 @@ TSS_TPMI_ECC_CURVE_Unmarshalu(TPMI_ECC_CURVE *target, BYTE **buffer, uint32_t *s
 TPM_RC
 TSS_TPMT_ECC_SCHEME_Unmarshalu(TPMT_ECC_SCHEME *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_ECC_SCHEME_Unmarshalu(&target->scheme, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_ASYM_SCHEME_Unmarshalu(&target->details, buffer, size, target->scheme);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_ECC_SCHEME, buffer, size);
 }
 
 /* Table 167 - Definition of {ECC} TPMS_ALGORITHM_DETAIL_ECC Structure <OUT> */
@@ -3252,42 +2948,7 @@ TSS_TPMT_ECC_SCHEME_Unmarshalu(TPMT_ECC_SCHEME *target, BYTE **buffer, uint32_t
 TPM_RC
 TSS_TPMS_ALGORITHM_DETAIL_ECC_Unmarshalu(TPMS_ALGORITHM_DETAIL_ECC *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_ECC_CURVE_Unmarshalu(&target->curveID, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->keySize, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_KDF_SCHEME_Unmarshalu(&target->kdf, buffer, size, YES);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_ECC_SCHEME_Unmarshalu(&target->sign, buffer, size, YES);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->p, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->a, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->b, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->gX, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->gY, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->n, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->h, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_ALGORITHM_DETAIL_ECC, buffer, size);
 }
 
 /* Table 168 - Definition of {RSA} TPMS_SIGNATURE_RSA Structure */
@@ -3295,15 +2956,7 @@ TSS_TPMS_ALGORITHM_DETAIL_ECC_Unmarshalu(TPMS_ALGORITHM_DETAIL_ECC *target, BYTE
 TPM_RC
 TSS_TPMS_SIGNATURE_RSA_Unmarshalu(TPMS_SIGNATURE_RSA *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&target->hash, buffer, size, NO);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_PUBLIC_KEY_RSA_Unmarshalu(&target->sig, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_SIGNATURE_RSA, buffer, size);
 }
 
 /* Table 169 - Definition of Types for {RSA} Signature */
@@ -3337,18 +2990,7 @@ TSS_TPMS_SIGNATURE_RSAPSS_Unmarshalu(TPMS_SIGNATURE_RSAPSS *target, BYTE **buffe
 TPM_RC
 TSS_TPMS_SIGNATURE_ECC_Unmarshalu(TPMS_SIGNATURE_ECC *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&target->hash, buffer, size, NO);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->signatureR, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Unmarshalu(&target->signatureS, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_SIGNATURE_ECC, buffer, size);
 }
 
 /* Table 171 - Definition of Types for {ECC} TPMS_SIGNATURE_ECC */
@@ -3453,15 +3095,8 @@ TSS_TPMU_SIGNATURE_Unmarshalu(TPMU_SIGNATURE *target, BYTE **buffer, uint32_t *s
 TPM_RC
 TSS_TPMT_SIGNATURE_Unmarshalu(TPMT_SIGNATURE *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_SIG_SCHEME_Unmarshalu(&target->sigAlg, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_SIGNATURE_Unmarshalu(&target->signature, buffer, size, target->sigAlg);
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_SIGNATURE, buffer, size);
 }
 
 /* Table 175 - Definition of TPM2B_ENCRYPTED_SECRET Structure */
@@ -3529,12 +3164,7 @@ TSS_TPMU_PUBLIC_ID_Unmarshalu(TPMU_PUBLIC_ID *target, BYTE **buffer, uint32_t *s
 TPM_RC
 TSS_TPMS_KEYEDHASH_PARMS_Unmarshalu(TPMS_KEYEDHASH_PARMS *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_KEYEDHASH_SCHEME_Unmarshalu(&target->scheme, buffer, size, YES);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_KEYEDHASH_PARMS, buffer, size);
 }
 
 /* Table 179 - Definition of TPMS_ASYM_PARMS Structure <> */
@@ -3543,15 +3173,7 @@ TSS_TPMS_KEYEDHASH_PARMS_Unmarshalu(TPMS_KEYEDHASH_PARMS *target, BYTE **buffer,
 TPM_RC
 TSS_TPMS_ASYM_PARMS_Unmarshalu(TPMS_ASYM_PARMS *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_SYM_DEF_OBJECT_Unmarshalu(&target->symmetric, buffer, size, YES);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_ASYM_SCHEME_Unmarshalu(&target->scheme, buffer, size, YES);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_ASYM_PARMS, buffer, size);
 }
 #endif
 
@@ -3560,21 +3182,7 @@ TSS_TPMS_ASYM_PARMS_Unmarshalu(TPMS_ASYM_PARMS *target, BYTE **buffer, uint32_t
 TPM_RC
 TSS_TPMS_RSA_PARMS_Unmarshalu(TPMS_RSA_PARMS *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_SYM_DEF_OBJECT_Unmarshalu(&target->symmetric, buffer, size, YES);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_RSA_SCHEME_Unmarshalu(&target->scheme, buffer, size, YES);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_RSA_KEY_BITS_Unmarshalu(&target->keyBits, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT32_Unmarshalu(&target->exponent, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_RSA_PARMS, buffer, size);
 }
 
 /* Table 181 - Definition of {ECC} TPMS_ECC_PARMS Structure */
@@ -3582,21 +3190,7 @@ TSS_TPMS_RSA_PARMS_Unmarshalu(TPMS_RSA_PARMS *target, BYTE **buffer, uint32_t *s
 TPM_RC
 TSS_TPMS_ECC_PARMS_Unmarshalu(TPMS_ECC_PARMS *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_SYM_DEF_OBJECT_Unmarshalu(&target->symmetric, buffer, size, YES);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_ECC_SCHEME_Unmarshalu(&target->scheme, buffer, size, YES);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ECC_CURVE_Unmarshalu(&target->curveID, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_KDF_SCHEME_Unmarshalu(&target->kdf, buffer, size, YES);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_ECC_PARMS, buffer, size);
 }
 
 /* Table 182 - Definition of TPMU_PUBLIC_PARMS Union <IN/OUT, S> */
@@ -3640,15 +3234,7 @@ TSS_TPMU_PUBLIC_PARMS_Unmarshalu(TPMU_PUBLIC_PARMS *target, BYTE **buffer, uint3
 TPM_RC
 TSS_TPMT_PUBLIC_PARMS_Unmarshalu(TPMT_PUBLIC_PARMS *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_PUBLIC_Unmarshalu(&target->type, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_PUBLIC_PARMS_Unmarshalu(&target->parameters, buffer, size, target->type);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_PUBLIC_PARMS, buffer, size);
 }
 
 /* #endif	TPM_TSS_NOCMDCHECK */
@@ -3659,18 +3245,27 @@ TPM_RC
 TSS_TPMT_PUBLIC_Unmarshalu(TPMT_PUBLIC *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
     TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_PUBLIC_Unmarshalu(&target->type, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&target->nameAlg, buffer, size, allowNull);
+    BYTE *b = *buffer;
+
+    allowNull = allowNull;
+    if (*size < sizeof(UINT16) + sizeof(UINT16) + sizeof(UINT32)) {
+	/* a short buffer takes the descriptor path, for the same response code and partial
+	   result */
+	return TSS_Desc_Unmarshalu(target, &tssDescTPMT_PUBLIC, buffer, size);
     }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMA_OBJECT_Unmarshalu(&target->objectAttributes, buffer, size);
+    /* type, nameAlg, and objectAttributes inline */
+    target->type = ((UINT16)b[0] << 8) | ((UINT16)b[1] << 0);
+    target->nameAlg = ((UINT16)b[2] << 8) | ((UINT16)b[3] << 0);
+    target->objectAttributes.val = ((UINT32)b[4] << 24) | ((UINT32)b[5] << 16) |
+				   ((UINT32)b[6] <<  8) | ((UINT32)b[7] <<  0);
+    *buffer += sizeof(UINT16) + sizeof(UINT16) + sizeof(UINT32);
+    *size -= sizeof(UINT16) + sizeof(UINT16) + sizeof(UINT32);
+    if (target->objectAttributes.val & TPMA_OBJECT_RESERVED) {
+	rc = TPM_RC_RESERVED_BITS;
     }
     if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->authPolicy, buffer, size);
+	rc = TSS_TPM2B_Unmarshalu(&target->authPolicy.b, sizeof(target->authPolicy.t.buffer),
+				  buffer, size);
     }
     if (rc == TPM_RC_SUCCESS) {
 	rc = TSS_TPMU_PUBLIC_PARMS_Unmarshalu(&target->parameters, buffer, size, target->type);
@@ -3686,29 +3281,8 @@ TSS_TPMT_PUBLIC_Unmarshalu(TPMT_PUBLIC *target, BYTE **buffer, uint32_t *size, B
 TPM_RC
 TSS_TPM2B_PUBLIC_Unmarshalu(TPM2B_PUBLIC *target, BYTE **buffer, uint32_t *size, BOOL allowNull)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    uint32_t startSize = 0;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->size, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size == 0) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	startSize = *size;
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMT_PUBLIC_Unmarshalu(&target->publicArea, buffer, size, allowNull);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size != startSize - *size) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    return rc;
+    allowNull = allowNull;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPM2B_PUBLIC, buffer, size);
 }
 /* #ifndef TPM_TSS_NOCMDCHECK */
 
@@ -3764,21 +3338,7 @@ TSS_TPMU_SENSITIVE_COMPOSITE_Unmarshalu(TPMU_SENSITIVE_COMPOSITE *target, BYTE *
 TPM_RC
 TSS_TPMT_SENSITIVE_Unmarshalu(TPMT_SENSITIVE *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_PUBLIC_Unmarshalu(&target->sensitiveType, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_AUTH_Unmarshalu(&target->authValue, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->seedValue, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMU_SENSITIVE_COMPOSITE_Unmarshalu(&target->sensitive, buffer, size, target->sensitiveType);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMT_SENSITIVE, buffer, size);
 }
 
 /* Table 189 - Definition of TPM2B_SENSITIVE Structure <IN/OUT> */
@@ -3786,26 +3346,7 @@ TSS_TPMT_SENSITIVE_Unmarshalu(TPMT_SENSITIVE *target, BYTE **buffer, uint32_t *s
 TPM_RC
 TSS_TPM2B_SENSITIVE_Unmarshalu(TPM2B_SENSITIVE *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    uint32_t startSize = 0;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->t.size, buffer, size);
-    }
-    if (target->t.size != 0) {
-	if (rc == TPM_RC_SUCCESS) {
-	    startSize = *size;
-	}
-	if (rc == TPM_RC_SUCCESS) {
-	    rc = TSS_TPMT_SENSITIVE_Unmarshalu(&target->t.sensitiveArea, buffer, size);
-	}
-	if (rc == TPM_RC_SUCCESS) {
-	    if (target->t.size != startSize - *size) {
-		rc = TPM_RC_SIZE;
-	    }
-	}
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPM2B_SENSITIVE, buffer, size);
 }
 
 /* #endif	TPM_TSS_NOCMDCHECK */
@@ -3859,24 +3400,7 @@ TSS_TPMA_NV_Unmarshalu(TPMA_NV *target, BYTE **buffer, uint32_t *size)
 TPM_RC
 TSS_TPMS_NV_PUBLIC_Unmarshalu(TPMS_NV_PUBLIC *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_RH_NV_INDEX_Unmarshalu(&target->nvIndex, buffer, size, NO);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&target->nameAlg, buffer, size, NO);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMA_NV_Unmarshalu(&target->attributes, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->authPolicy, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->dataSize, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_NV_PUBLIC, buffer, size);
 }
 
 /* Table 198 - Definition of TPM2B_NV_PUBLIC Structure */
@@ -3884,29 +3408,7 @@ TSS_TPMS_NV_PUBLIC_Unmarshalu(TPMS_NV_PUBLIC *target, BYTE **buffer, uint32_t *s
 TPM_RC
 TSS_TPM2B_NV_PUBLIC_Unmarshalu(TPM2B_NV_PUBLIC *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    uint32_t startSize = 0;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->size, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size == 0) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	startSize = *size;
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMS_NV_PUBLIC_Unmarshalu(&target->nvPublic, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size != startSize - *size) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPM2B_NV_PUBLIC, buffer, size);
 }
 
 /* #ifndef TPM_TSS_NOCMDCHECK */
@@ -3929,15 +3431,7 @@ TSS_TPM2B_CONTEXT_SENSITIVE_Unmarshalu(TPM2B_CONTEXT_SENSITIVE *target, BYTE **b
 TPM_RC
 TSS_TPMS_CONTEXT_DATA_Unmarshalu(TPMS_CONTEXT_DATA *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->integrity, buffer, size);	
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_CONTEXT_SENSITIVE_Unmarshalu(&target->encrypted, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_CONTEXT_DATA, buffer, size);
 }
 
 /* #endif	TPM_TSS_NOCMDCHECK */
@@ -3960,21 +3454,7 @@ TSS_TPM2B_CONTEXT_DATA_Unmarshalu(TPM2B_CONTEXT_DATA *target, BYTE **buffer, uin
 TPM_RC
 TSS_TPMS_CONTEXT_Unmarshalu(TPMS_CONTEXT *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT64_Unmarshalu(&target->sequence, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_DH_SAVED_Unmarshalu(&target->savedHandle, buffer, size, NO);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMI_RH_HIERARCHY_Unmarshalu(&target->hierarchy, buffer, size, YES);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_CONTEXT_DATA_Unmarshalu(&target->contextBlob, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_CONTEXT, buffer, size);
 }
 
 /* Table 204 - Definition of TPMS_CREATION_DATA Structure <OUT> */
@@ -3982,30 +3462,7 @@ TSS_TPMS_CONTEXT_Unmarshalu(TPMS_CONTEXT *target, BYTE **buffer, uint32_t *size)
 TPM_RC
 TSS_TPMS_CREATION_DATA_Unmarshalu(TPMS_CREATION_DATA *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPML_PCR_SELECTION_Unmarshalu(&target->pcrSelect, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->pcrDigest, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMA_LOCALITY_Unmarshalu(&target->locality, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM_ALG_ID_Unmarshalu(&target->parentNameAlg, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_NAME_Unmarshalu(&target->parentName, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_NAME_Unmarshalu(&target->parentQualifiedName, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPM2B_DATA_Unmarshalu(&target->outsideInfo, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPMS_CREATION_DATA, buffer, size);
 }
 
 /* Table 205 - Definition of TPM2B_CREATION_DATA Structure <OUT> */
@@ -4013,29 +3470,7 @@ TSS_TPMS_CREATION_DATA_Unmarshalu(TPMS_CREATION_DATA *target, BYTE **buffer, uin
 TPM_RC
 TSS_TPM2B_CREATION_DATA_Unmarshalu(TPM2B_CREATION_DATA *target, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = TPM_RC_SUCCESS;
-    uint32_t startSize = 0;
-    
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_UINT16_Unmarshalu(&target->size, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size == 0) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	startSize = *size;
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	rc = TSS_TPMS_CREATION_DATA_Unmarshalu(&target->creationData, buffer, size);
-    }
-    if (rc == TPM_RC_SUCCESS) {
-	if (target->size != startSize - *size) {
-	    rc = TPM_RC_SIZE;
-	}
-    }
-    return rc;
+    return TSS_Desc_Unmarshalu(target, &tssDescTPM2B_CREATION_DATA, buffer, size);
 }
 #ifndef TPM_TSS_NODEPRECATED
 
@@ -0,0 +1,502 @@
+/********************************************************************************/
+/*										*/
+/*			   Batch Attestation Verifier				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Batch attestation verifier.  See attestlib.h. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tsscryptoh.h>
+#include <ibmtss/tssmarshal.h>
+#include <ibmtss/Unmarshal_fp.h>
+
+#include "cryptoutils.h"
+#include "attestlib.h"
+
+extern int tssUtilsVerbose;
+
+static TPM_RC attestKeyConvert(ATTEST_KEY *attestKey);
+static void attestKeyFree(ATTEST_KEY *attestKey);
+static TPM_RC attestCheck(ATTEST_ITEM *item);
+static TPM_RC attestSignature(ATTEST_ITEM *item);
+
+/* attestKeyCacheCreate() allocates a key cache with room for keyMax keys.  keyMax must not be 0. */
+
+TPM_RC attestKeyCacheCreate(ATTEST_KEY_CACHE **keyCache,
+			    size_t keyMax)
+{
+    TPM_RC	rc = 0;
+
+    *keyCache = NULL;
+    if (rc == 0) {
+	if (keyMax == 0) {
+	    if (tssUtilsVerbose) printf("attestKeyCacheCreate: Error, keyMax is 0\n");
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	rc = TSS_Malloc((uint8_t **)keyCache, sizeof(ATTEST_KEY_CACHE));	/* freed by
+										   attestKeyCacheDelete */
+    }
+    if (rc == 0) {
+	(*keyCache)->keyCount = 0;
+	(*keyCache)->keyMax = keyMax;
+	/* not TSS_Malloc(), the cache can exceed its size limit */
+	(*keyCache)->keys = calloc(keyMax, sizeof(ATTEST_KEY));
+	if ((*keyCache)->keys == NULL) {
+	    if (tssUtilsVerbose) printf("attestKeyCacheCreate: Error allocating %lu keys\n",
+					(unsigned long)keyMax);
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if (rc != 0) {
+	attestKeyCacheDelete(*keyCache);
+	*keyCache = NULL;
+    }
+    return rc;
+}
+
+/* attestKeyCacheDelete() frees the cache and the crypto library keys */
+
+void attestKeyCacheDelete(ATTEST_KEY_CACHE *keyCache)
+{
+    size_t i;
+    if (keyCache != NULL) {
+	for (i = 0 ; i < keyCache->keyCount ; i++) {
+	    attestKeyFree(&keyCache->keys[i]);
+	}
+	free(keyCache->keys);
+	free(keyCache);
+    }
+    return;
+}
+
+/* attestKeyCacheAdd() returns the cache entry for publicArea, adding it if it is not already
+   present.  The Name is the index, so a key is converted to a crypto library key only once.
+
+   The key must be a restricted signing key.  An unrestricted key can sign a digest that the
+   caller supplies, so its signature does not prove that the TPM generated the TPMS_ATTEST.
+
+   The returned attestKey remains valid until attestKeyCacheDelete().
+*/
+
+TPM_RC attestKeyCacheAdd(ATTEST_KEY_CACHE *keyCache,
+			 const ATTEST_KEY **attestKey,
+			 const TPMT_PUBLIC *publicArea)
+{
+    TPM_RC		rc = 0;
+    TPM2B_NAME		name;
+    TPMT_HA		digest;
+    uint16_t		written = 0;
+    uint8_t		*buffer = NULL;		/* marshaled TPMT_PUBLIC, freed @1 */
+    ATTEST_KEY		*newKey = NULL;
+    size_t		i;
+
+    *attestKey = NULL;
+    if (rc == 0) {
+	if ((publicArea->objectAttributes.val & (TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_SIGN)) !=
+	    (TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_SIGN)) {
+	    if (tssUtilsVerbose) printf("attestKeyCacheAdd: Error, "
+					"key is not a restricted signing key\n");
+	    rc = TSS_RC_BAD_SIGNATURE_ALGORITHM;
+	}
+    }
+    /* the Name is nameAlg || H(TPMT_PUBLIC) */
+    if (rc == 0) {
+	rc = TSS_Structure_Marshal(&buffer,		/* freed @1 */
+				   &written,
+				   (void *)publicArea,
+				   (MarshalFunction_t)TSS_TPMT_PUBLIC_Marshalu);
+    }
+    if (rc == 0) {
+	digest.hashAlg = publicArea->nameAlg;
+	rc = TSS_Hash_Generate(&digest,
+			       written, buffer,
+			       0, NULL);
+    }
+    if (rc == 0) {
+	uint16_t digestSize = TSS_GetDigestSize(publicArea->nameAlg);
+	name.t.name[0] = (uint8_t)(publicArea->nameAlg >> 8);
+	name.t.name[1] = (uint8_t)(publicArea->nameAlg >> 0);
+	memcpy(name.t.name + 2, (uint8_t *)&digest.digest, digestSize);
+	name.t.size = sizeof(TPMI_ALG_HASH) + digestSize;
+    }
+    /* already cached */
+    for (i = 0 ; (rc == 0) && (*attestKey == NULL) && (i < keyCache->keyCount) ; i++) {
+	if (TSS_TPM2B_Compare(&keyCache->keys[i].name.b, &name.b)) {
+	    *attestKey = &keyCache->keys[i];
+	}
+    }
+    if ((rc == 0) && (*attestKey == NULL)) {
+	if (keyCache->keyCount >= keyCache->keyMax) {
+	    if (tssUtilsVerbose) printf("attestKeyCacheAdd: Error, cache full at %lu keys\n",
+					(unsigned long)keyCache->keyMax);
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+	if (rc == 0) {
+	    newKey = &keyCache->keys[keyCache->keyCount];
+	    newKey->publicArea = *publicArea;
+	    newKey->name = name;
+	    newKey->pkey = NULL;
+	    rc = attestKeyConvert(newKey);
+	}
+	if (rc == 0) {
+	    keyCache->keyCount++;
+	    *attestKey = newKey;
+	}
+    }
+    free(buffer);		/* @1 */
+    return rc;
+}
+
+/* attestKeyConvert() converts the TPM public key to a crypto library key */
+
+static TPM_RC attestKeyConvert(ATTEST_KEY *attestKey)
+{
+    TPM_RC		rc = 0;
+#ifndef TPM_TSS_NO_OPENSSL
+    EVP_PKEY		*evpPkey = NULL;
+
+    switch (attestKey->publicArea.type) {
+#ifndef TPM_TSS_NORSA
+      case TPM_ALG_RSA:
+	rc = convertRsaPublicToEvpPubKey(&evpPkey,	/* freed by attestKeyFree */
+					 &attestKey->publicArea.unique.rsa);
+	break;
+#endif	/* TPM_TSS_NORSA */
+#ifndef TPM_TSS_NOECC
+      case TPM_ALG_ECC:
+	rc = convertEcTPMTPublicToEvpPubKey(&evpPkey,	/* freed by attestKeyFree */
+					    &attestKey->publicArea);
+	break;
+#endif	/* TPM_TSS_NOECC */
+      default:
+	if (tssUtilsVerbose) printf("attestKeyConvert: Error, key type %04x not supported\n",
+				    attestKey->publicArea.type);
+	rc = TSS_RC_BAD_SIGNATURE_ALGORITHM;
+    }
+    if (rc == 0) {
+	attestKey->pkey = evpPkey;
+    }
+#else
+    attestKey = attestKey;
+    rc = TSS_RC_NOT_IMPLEMENTED;
+#endif	/* TPM_TSS_NO_OPENSSL */
+    return rc;
+}
+
+static void attestKeyFree(ATTEST_KEY *attestKey)
+{
+#ifndef TPM_TSS_NO_OPENSSL
+    if (attestKey->pkey != NULL) {
+	EVP_PKEY_free((EVP_PKEY *)attestKey->pkey);
+	attestKey->pkey = NULL;
+    }
+#else
+    attestKey = attestKey;
+#endif	/* TPM_TSS_NO_OPENSSL */
+    return;
+}
+
+/* attestVerifyBatch() verifies count items.  Each item's rc holds its result.
+
+   Returns the number of items that verified.
+*/
+
+size_t attestVerifyBatch(ATTEST_ITEM *items,
+			 size_t count)
+{
+    size_t	verified = 0;
+    size_t	i;
+
+    for (i = 0 ; i < count ; i++) {
+	if (attestVerify(&items[i]) == 0) {
+	    verified++;
+	}
+    }
+    return verified;
+}
+
+/* attestVerify() verifies one item, the TPMS_ATTEST contents and then the signature.
+
+   The contents are checked first since that is cheap, so a mismatched item is rejected without a
+   signature verification.  The result is returned and also stored in item->rc.
+*/
+
+TPM_RC attestVerify(ATTEST_ITEM *item)
+{
+    TPM_RC	rc = 0;
+
+    if (rc == 0) {
+	if (item->key == NULL) {
+	    rc = TSS_RC_NULL_PARAMETER;
+	}
+    }
+    /* unmarshal the signed data */
+    if (rc == 0) {
+	uint8_t *tmpBuffer = item->attest.t.attestationData;
+	uint32_t tmpSize = item->attest.t.size;
+	rc = TSS_TPMS_ATTEST_Unmarshalu(&item->attestData, &tmpBuffer, &tmpSize);
+	/* the signature covers the whole blob, so bytes after the TPMS_ATTEST are not ignored */
+	if ((rc == 0) && (tmpSize != 0)) {
+	    if (tssUtilsVerbose) printf("attestVerify: Error, %u bytes after TPMS_ATTEST\n",
+					tmpSize);
+	    rc = TSS_RC_MALFORMED_RESPONSE;
+	}
+    }
+    if (rc == 0) {
+	rc = attestCheck(item);
+    }
+    if (rc == 0) {
+	rc = attestSignature(item);
+    }
+    item->rc = rc;
+    return rc;
+}
+
+/* attestCheck() validates the TPMS_ATTEST against the item's expected values */
+
+static TPM_RC attestCheck(ATTEST_ITEM *item)
+{
+    TPM_RC		rc = 0;
+    TPMS_ATTEST		*attestData = &item->attestData;
+    TPM2B		*digest = NULL;		/* type specific digest, if any */
+    TPM2B		*name = NULL;		/* type specific Name, if any */
+
+    if (rc == 0) {
+	if (attestData->magic != TPM_GENERATED_VALUE) {
+	    if (tssUtilsVerbose) printf("attestCheck: Error, magic %08x\n", attestData->magic);
+	    rc = TSS_RC_MALFORMED_RESPONSE;
+	}
+    }
+    if (rc == 0) {
+	if ((item->expectType != 0) && (item->expectType != attestData->type)) {
+	    if (tssUtilsVerbose) printf("attestCheck: Error, type %04x expected %04x\n",
+					attestData->type, item->expectType);
+	    rc = TSS_RC_MALFORMED_RESPONSE;
+	}
+    }
+    if ((rc == 0) && (item->proof == NULL)) {
+	if (!TSS_TPM2B_Compare(&item->expectExtraData.b, &attestData->extraData.b)) {
+	    if (tssUtilsVerbose) printf("attestCheck: Error, extraData mismatch\n");
+	    rc = TSS_RC_BAD_READ_VALUE;
+	}
+    }
+    /* batched quote, extraData is the Merkle root over the nonces */
+    if ((rc == 0) && (item->proof != NULL)) {
+	TPM2B_DIGEST nonce;
+	rc = TSS_TPM2B_Copy(&nonce.b, &item->expectExtraData.b, sizeof(nonce.t.buffer));
+	if (rc == 0) {
+	    rc = merkleProofVerify(&attestData->extraData.b, &nonce, item->proof);
+	}
+    }
+    if (rc == 0) {
+	switch (attestData->type) {
+	  case TPM_ST_ATTEST_QUOTE:
+	    digest = &attestData->attested.quote.pcrDigest.b;
+	    break;
+	  case TPM_ST_ATTEST_CERTIFY:
+	    name = &attestData->attested.certify.name.b;
+	    break;
+	  case TPM_ST_ATTEST_NV:
+	    name = &attestData->attested.nv.indexName.b;
+	    break;
+	  case TPM_ST_ATTEST_NV_DIGEST:
+	    name = &attestData->attested.nvDigest.indexName.b;
+	    digest = &attestData->attested.nvDigest.nvDigest.b;
+	    break;
+	  default:
+	    break;
+	}
+	if ((item->expectDigest.t.size != 0) &&
+	    ((digest == NULL) || !TSS_TPM2B_Compare(&item->expectDigest.b, digest))) {
+	    if (tssUtilsVerbose) printf("attestCheck: Error, digest mismatch\n");
+	    rc = TSS_RC_BAD_READ_VALUE;
+	}
+	if ((item->expectName.t.size != 0) &&
+	    ((name == NULL) || !TSS_TPM2B_Compare(&item->expectName.b, name))) {
+	    if (tssUtilsVerbose) printf("attestCheck: Error, Name mismatch\n");
+	    rc = TSS_RC_BAD_READ_VALUE;
+	}
+    }
+    return rc;
+}
+
+/* attestSignature() hashes the TPMS_ATTEST with the signature hash algorithm and verifies the
+   signature with the cached key.
+
+   When the key has a scheme, the TPM signs only with that scheme and hash algorithm, so a
+   signature with any other algorithm is rejected.
+*/
+
+static TPM_RC attestSignature(ATTEST_ITEM *item)
+{
+    TPM_RC		rc = 0;
+    TPMT_HA		digest;
+    uint16_t		digestSize = 0;
+    TPMI_ALG_SIG_SCHEME	keyScheme = TPM_ALG_NULL;
+    TPMI_ALG_HASH	keyHashAlg = TPM_ALG_NULL;
+
+    if (rc == 0) {
+	switch (item->key->publicArea.type) {
+	  case TPM_ALG_RSA:
+	    keyScheme = item->key->publicArea.parameters.rsaDetail.scheme.scheme;
+	    keyHashAlg = item->key->publicArea.parameters.rsaDetail.scheme.details.anySig.hashAlg;
+	    break;
+	  case TPM_ALG_ECC:
+	    keyScheme = item->key->publicArea.parameters.eccDetail.scheme.scheme;
+	    keyHashAlg = item->key->publicArea.parameters.eccDetail.scheme.details.anySig.hashAlg;
+	    break;
+	  default:
+	    break;
+	}
+	if ((keyScheme != TPM_ALG_NULL) &&
+	    ((item->signature.sigAlg != keyScheme) ||
+	     (item->signature.signature.any.hashAlg != keyHashAlg))) {
+	    if (tssUtilsVerbose) printf("attestSignature: Error, signature %04x %04x "
+					"key scheme %04x %04x\n",
+					item->signature.sigAlg,
+					item->signature.signature.any.hashAlg,
+					keyScheme, keyHashAlg);
+	    rc = TSS_RC_BAD_SIGNATURE_ALGORITHM;
+	}
+    }
+    if (rc == 0) {
+	digest.hashAlg = item->signature.signature.any.hashAlg;
+	digestSize = TSS_GetDigestSize(digest.hashAlg);
+	rc = TSS_Hash_Generate(&digest,
+			       item->attest.t.size, item->attest.t.attestationData,
+			       0, NULL);
+    }
+#ifndef TPM_TSS_NO_OPENSSL
+    if (rc == 0) {
+	switch (item->signature.sigAlg) {
+#ifndef TPM_TSS_NORSA
+	  case TPM_ALG_RSASSA:
+	  case TPM_ALG_RSAPSS:
+	    if (item->key->publicArea.type != TPM_ALG_RSA) {
+		rc = TSS_RC_BAD_SIGNATURE_ALGORITHM;
+		break;
+	    }
+	    rc = verifyRSASignatureFromEvpPubKey((uint8_t *)&digest.digest,
+						 digestSize,
+						 &item->signature,
+						 digest.hashAlg,
+						 (EVP_PKEY *)item->key->pkey);
+	    break;
+#endif	/* TPM_TSS_NORSA */
+#ifndef TPM_TSS_NOECC
+	  case TPM_ALG_ECDSA:
+	    if (item->key->publicArea.type != TPM_ALG_ECC) {
+		rc = TSS_RC_BAD_SIGNATURE_ALGORITHM;
+		break;
+	    }
+	    rc = verifyEcSignatureFromEvpPubKey((uint8_t *)&digest.digest,
+						digestSize,
+						&item->signature,
+						(EVP_PKEY *)item->key->pkey);
+	    break;
+#endif	/* TPM_TSS_NOECC */
+	  default:
+	    if (tssUtilsVerbose) printf("attestSignature: Error, signature algorithm %04x\n",
+					item->signature.sigAlg);
+	    rc = TSS_RC_BAD_SIGNATURE_ALGORITHM;
+	}
+    }
+#else
+    if (rc == 0) {
+	digestSize = digestSize;
+	rc = TSS_RC_NOT_IMPLEMENTED;
+    }
+#endif	/* TPM_TSS_NO_OPENSSL */
+    return rc;
+}
+
+/* attestQuoteBatch() runs one TPM2_Quote that answers nonceCount verifier nonces.
+
+   The nonces are hashed into a Merkle tree with halg, and the root is the qualifying data.  in
+   supplies the signing key handle, signing scheme, and PCR selection.  in->qualifyingData is set
+   here.
+
+   Each verifier receives out->quoted, out->signature, and merkleProofGet() for its index.  The
+   caller frees the tree with merkleTreeDelete().
+*/
+
+TPM_RC attestQuoteBatch(TSS_CONTEXT *tssContext,
+			Quote_Out *out,
+			MERKLE_TREE **tree,		/* freed by caller */
+			Quote_In *in,
+			TPMI_ALG_HASH halg,		/* Merkle tree hash algorithm */
+			uint32_t nonceCount,
+			const TPM2B_DIGEST *nonces,
+			TPMI_SH_AUTH_SESSION sessionHandle,
+			const char *keyPassword,
+			unsigned int sessionAttributes)
+{
+    TPM_RC		rc = 0;
+    TPM2B_DIGEST	root;
+
+    if (rc == 0) {
+	rc = merkleTreeCreate(tree, halg, nonceCount, nonces);
+    }
+    if (rc == 0) {
+	rc = merkleTreeRoot(&root, *tree);
+    }
+    if (rc == 0) {
+	rc = TSS_TPM2B_Copy(&in->qualifyingData.b, &root.b, sizeof(in->qualifyingData.t.buffer));
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("attestQuoteBatch: quoting %u nonces\n", nonceCount);
+	rc = TSS_Execute(tssContext,
+			 (RESPONSE_PARAMETERS *)out,
+			 (COMMAND_PARAMETERS *)in,
+			 NULL,
+			 TPM_CC_Quote,
+			 sessionHandle, keyPassword, sessionAttributes,
+			 TPM_RH_NULL, NULL, 0);
+    }
+    if ((rc != 0) && (*tree != NULL)) {
+	merkleTreeDelete(*tree);
+	*tree = NULL;
+    }
+    return rc;
+}
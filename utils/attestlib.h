@@ -0,0 +1,124 @@
+/********************************************************************************/
+/*										*/
+/*			   Batch Attestation Verifier				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Batch verification of TPM attestation structures (quote, certify, NV certify, time, etc.)
+   without a TPM.
+
+   An ATTEST_KEY_CACHE holds attestation key public areas, each a restricted signing key converted
+   once to a crypto library key.  attestKeyCacheAdd() returns the existing entry when the key is
+   already present, so a verifier that sees the same AK repeatedly parses it once.
+
+   An ATTEST_ITEM is one attestation to verify: the signed TPMS_ATTEST blob, its signature, the
+   key, and the expected values.  attestVerifyBatch() verifies an array of items and records a
+   result in each one, so one failed item does not stop the batch.
+
+   attestQuoteBatch() answers many verifier challenges with one TPM2_Quote.  The nonces are
+   hashed into a Merkle tree and the root is the quote qualifying data.  Each verifier receives the
+   shared quote and signature plus its MERKLE_PROOF.  An ATTEST_ITEM with a proof treats
+   expectExtraData as the verifier's own nonce and checks that it is included in extraData.
+
+   The library has no threads or global state.  Add all keys first.  After that, the cache is only
+   read, so a caller may split a batch across its own threads, each calling attestVerifyBatch()
+   on a slice of the items.
+*/
+
+#ifndef ATTESTLIB_H
+#define ATTESTLIB_H
+
+#include <stddef.h>
+
+#include <ibmtss/tss.h>
+
+#include "merklelib.h"
+
+typedef struct {
+    TPMT_PUBLIC	publicArea;
+    TPM2B_NAME	name;		/* Name of publicArea, the cache index */
+    void	*pkey;		/* crypto library public key */
+} ATTEST_KEY;
+
+typedef struct {
+    size_t	keyCount;
+    size_t	keyMax;
+    ATTEST_KEY	*keys;
+} ATTEST_KEY_CACHE;
+
+typedef struct {
+    /* in */
+    TPM2B_ATTEST	attest;		/* marshaled TPMS_ATTEST, the signed data */
+    TPMT_SIGNATURE	signature;
+    const ATTEST_KEY	*key;		/* from attestKeyCacheAdd() */
+    TPMI_ST_ATTEST	expectType;	/* 0 accepts any type */
+    TPM2B_DATA		expectExtraData;/* compared to extraData, e.g. the quote nonce */
+    TPM2B_DIGEST	expectDigest;	/* quote pcrDigest or NV nvDigest, size 0 not checked */
+    TPM2B_NAME		expectName;	/* certify or NV index Name, size 0 not checked */
+    const MERKLE_PROOF	*proof;		/* if not NULL, expectExtraData is a batched nonce */
+    /* out */
+    TPM_RC		rc;		/* 0 if the item verified */
+    TPMS_ATTEST		attestData;	/* the unmarshaled attest */
+} ATTEST_ITEM;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    TPM_RC attestKeyCacheCreate(ATTEST_KEY_CACHE **keyCache,
+				size_t keyMax);
+    void attestKeyCacheDelete(ATTEST_KEY_CACHE *keyCache);
+    TPM_RC attestKeyCacheAdd(ATTEST_KEY_CACHE *keyCache,
+			     const ATTEST_KEY **attestKey,
+			     const TPMT_PUBLIC *publicArea);
+    TPM_RC attestVerify(ATTEST_ITEM *item);
+    size_t attestVerifyBatch(ATTEST_ITEM *items,
+			     size_t count);
+    TPM_RC attestQuoteBatch(TSS_CONTEXT *tssContext,
+			    Quote_Out *out,
+			    MERKLE_TREE **tree,
+			    Quote_In *in,
+			    TPMI_ALG_HASH halg,
+			    uint32_t nonceCount,
+			    const TPM2B_DIGEST *nonces,
+			    TPMI_SH_AUTH_SESSION sessionHandle,
+			    const char *keyPassword,
+			    unsigned int sessionAttributes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
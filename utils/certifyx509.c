@@ -170,7 +170,7 @@ TPM_RC addSignatureEcc(X509 		*x509Certificate,
 		       TPMT_SIGNATURE 	*signature);
 #endif	/* TPM_TSS_NOECC */
 
-int verbose = FALSE;
+static int verbose = FALSE;
 
 int main(int argc, char *argv[])
 {
@@ -1290,7 +1290,7 @@ static void printUsage(void)
 
 #ifdef TPM_TSS_MBEDTLS
 
-int verbose;
+static int verbose;
 
 int main(int argc, char *argv[])
 {
@@ -133,6 +133,9 @@ int main(int argc, char *argv[])
     int				modulusBytes;
     unsigned int 		noFlush = 0;		/* default flush after validation */
     unsigned int 		noPub = 0;		/* default validate public key */
+    int				rootCache = FALSE;	/* default verify without a CaStore */
+    CaStore			*caStore = NULL;	/* freed @5 */
+    int				reloaded;
     TPM_HANDLE 			keyHandle;		/* primary key handle */
 
     setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
@@ -268,6 +271,9 @@ int main(int argc, char *argv[])
 	else if (strcmp(argv[i],"-nopub") == 0) {
 	    noPub = 1;
 	}
+	else if (strcmp(argv[i],"-cache") == 0) {
+	    rootCache = TRUE;
+	}
 	else if (strcmp(argv[i],"-h") == 0) {
 	    printUsage();
 	}
@@ -296,6 +302,10 @@ int main(int argc, char *argv[])
 	printf("Nothing to do\n");
 	printUsage();
     }
+    if (rootCache && (listFilename == NULL)) {
+	printf("-cache requires -root\n");
+	printUsage();
+    }
     /* Start a TSS context */
     if (rc == 0) {
 	rc = TSS_Create(&tssContext);
@@ -344,7 +354,32 @@ int main(int argc, char *argv[])
 	    break;
 	}
     }
-    if (listFilename != NULL) {
+    /* validate the EK certificate at ekCertIndex as a long running verifier would: against a
+       CaStore, again from the verified certificate cache, and again after a reload */
+    if ((listFilename != NULL) && rootCache) {
+	if (rc == 0) {
+	    rc = caStoreCreate(&caStore,			/* freed @5 */
+			       listFilename,
+			       tssUtilsVerbose);
+	}
+	if (rc == 0) {
+	    rc = processRootCached(tssContext, ekCertIndex, caStore, TRUE);
+	}
+	if (rc == 0) {
+	    rc = processRootCached(tssContext, ekCertIndex, caStore, TRUE);
+	}
+	if (rc == 0) {
+	    rc = caStoreReload(caStore, &reloaded, TRUE, TRUE);
+	}
+	if (rc == 0) {
+	    rc = processRootCached(tssContext, ekCertIndex, caStore, TRUE);
+	}
+	if (rc == 0) {
+	    printf("CA store generation %u cache hits %u misses %u\n",
+		   caStore->generation, caStore->cacheHits, caStore->cacheMisses);
+	}
+    }
+    else if (listFilename != NULL) {
 	/* get the list of of root EK CA certificate file names */
 	if (rc == 0) {
 	    rc = getRootCertificateFilenames(rootFilename,	/* freed @4 */
@@ -385,6 +420,7 @@ int main(int argc, char *argv[])
     for (ui = 0 ; ui < rootFileCount ; ui++) {
 	free(rootFilename[ui]);		/* @4 */
     }
+    caStoreDelete(caStore);		/* @5 */
     return rc;
 }
 
@@ -401,6 +437,8 @@ static void printUsage(void)
 	   "but -nopub will skip the check.\n");
     printf("\n");
     printf("-root reads the EK certificate and validates it agains the EK CA certificates\n");
+    printf("-cache with -root validates through a cached CA store, then from the cache,\n"
+	   "then after reloading the store, and prints the cache statistics\n");
     printf("\n");
     printf("-ce prints provisioned EK certificates\n");
     printf("\n");
@@ -428,5 +466,6 @@ static void printUsage(void)
     printf("\t\tfilename contains a list of PEM format CA root certificate\n"
 	   "\t\tfilenames, one per line.\n");
     printf("\t\tThe list may contain up to %u certificates.\n", MAX_ROOTS);
+    printf("\t[-cache\tvalidate against the root using a cached CA store]\n");
     exit(1);
 }
@@ -84,26 +84,50 @@ static TPM_RC storeEkCertificate(TSS_CONTEXT *tssContext,
 				 unsigned char *certificate,
 				 TPMI_RH_NV_INDEX nvIndex,
 				 const char *platformPassword);
+static TPM_RC provisionDevice(char *deviceSettings,
+			      const CertIssuer *certIssuer,
+			      TPMI_RH_NV_INDEX ekCertIndex,
+			      const char *platformPassword,
+			      const char *endorsementPassword,
+			      const char *keyPassword,
+			      int noFlush,
+			      const char *certificateFilename);
+static TPM_RC provisionDeviceList(const char *deviceListFilename,
+				  const char *resumeFilename,
+				  const CertIssuer *certIssuer,
+				  TPMI_RH_NV_INDEX ekCertIndex,
+				  const char *platformPassword,
+				  const char *endorsementPassword,
+				  const char *keyPassword,
+				  int noFlush,
+				  const char *certificatePrefix);
+static TPM_RC setDeviceProperties(TSS_CONTEXT *tssContext,
+				  char *deviceSettings);
+
+/* maximum length of a device list or resume file line */
+
+#define DEVICE_LINE_MAX		4096
 
 /* EK on low or high range, EK spec 2.3 */
 
 #define LowRange	1
 #define HighRange	2
 
-int vverbose = 0;
+static int vverbose = 0;
 extern int tssUtilsVerbose;
 
 int main(int argc, char *argv[])
 {
     int 		rc = 0;
     int			i;    /* argc iterator */
-    TSS_CONTEXT 	*tssContext = NULL;
     int			noFlush = FALSE;
     unsigned int	algCount = 0;
     int			range = LowRange;	/* default low range */
     TPMI_ALG_PUBLIC 	algPublic = 0;
     TPMI_RSA_KEY_BITS 	keyBits = 0;
     const char		*certificateFilename = NULL;
+    const char		*deviceListFilename = NULL;
+    const char		*resumeFilename = NULL;
     TPMI_RH_NV_INDEX	ekCertIndex = EK_CERT_RSA_INDEX;
     /* the CA for endorsement key certificates */
     const char 		*caKeyFileName = NULL;
@@ -111,11 +135,7 @@ int main(int argc, char *argv[])
     const char		*platformPassword = NULL;
     const char		*endorsementPassword = NULL;
     const char		*keyPassword = NULL; 
-    TPMT_PUBLIC 	tpmtPublicOut;		/* primary key public part */
-    char 		*x509CertString = NULL;
-    char 		*pemCertString = NULL;
-    uint32_t 		certLength;
-    unsigned char 	*certificate = NULL;
+    CertIssuer		*certIssuer = NULL;
 
     /* FIXME may be better from command line or config file */
     char *subjectEntries[] = {
@@ -169,6 +189,26 @@ int main(int argc, char *argv[])
 		printUsage();
 	    }
 	}
+	else if (strcmp(argv[i],"-il") == 0) {
+	    i++;
+	    if (i < argc) {
+		deviceListFilename = argv[i];
+	    }
+	    else {
+		printf("-il option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-rf") == 0) {
+	    i++;
+	    if (i < argc) {
+		resumeFilename = argv[i];
+	    }
+	    else {
+		printf("-rf option needs a value\n");
+		printUsage();
+	    }
+	}
 	else if (strcmp(argv[i],"-high") == 0) {
 	    range = HighRange;
 	    if (algPublic != 0) {
@@ -335,10 +375,75 @@ int main(int argc, char *argv[])
 	printf("ERROR: Missing -cakey\n");
 	printUsage();
     }
+    if ((resumeFilename != NULL) && (deviceListFilename == NULL)) {
+	printf("ERROR: -rf requires -il\n");
+	printUsage();
+    }
+    /* read the CA signing key and build the issuer and subject once */
+    if (rc == 0) {
+	rc = certIssuerCreate(&certIssuer,		/* freed @1 */
+			      caKeyFileName, caKeyPassword,
+			      issuerEntriesSize, issuerEntries,
+			      sizeof(subjectEntries)/sizeof(char *), subjectEntries);
+    }
+    if (rc == 0) {
+	if (deviceListFilename == NULL) {
+	    rc = provisionDevice(NULL,			/* TPM from environment variables */
+				 certIssuer,
+				 ekCertIndex,
+				 platformPassword,
+				 endorsementPassword,
+				 keyPassword,
+				 noFlush,
+				 certificateFilename);
+	}
+	else {
+	    rc = provisionDeviceList(deviceListFilename,
+				     resumeFilename,
+				     certIssuer,
+				     ekCertIndex,
+				     platformPassword,
+				     endorsementPassword,
+				     keyPassword,
+				     noFlush,
+				     certificateFilename);	/* prefix in list mode */
+	}
+    }
+    certIssuerDelete(certIssuer);		/* @1 */
+    return rc;
+}
+
+/* provisionDevice() creates the EK, issues its certificate, and stores the certificate in NV for
+   one TPM.
+
+   deviceSettings is NULL for the TPM selected by the environment variables, or a string of
+   white space separated PROPERTY=value settings, see setDeviceProperties().  The string is
+   modified.
+*/
+
+static TPM_RC provisionDevice(char *deviceSettings,
+			      const CertIssuer *certIssuer,
+			      TPMI_RH_NV_INDEX ekCertIndex,
+			      const char *platformPassword,
+			      const char *endorsementPassword,
+			      const char *keyPassword,
+			      int noFlush,
+			      const char *certificateFilename)
+{
+    TPM_RC		rc = 0;
+    TSS_CONTEXT 	*tssContext = NULL;
+    TPMT_PUBLIC 	tpmtPublicOut;		/* primary key public part */
+    uint32_t 		certLength;
+    unsigned char 	*certificate = NULL;
+
     /* Start a TSS context */
     if (rc == 0) {
 	rc = TSS_Create(&tssContext);
     }
+    /* point the context at this device */
+    if ((rc == 0) && (deviceSettings != NULL)) {
+	rc = setDeviceProperties(tssContext, deviceSettings);
+    }
     /* create a primary EK using the default IWG template */
     if (rc == 0) {
 	TPM_HANDLE keyHandle;
@@ -353,19 +458,14 @@ int main(int argc, char *argv[])
 				   noFlush,
 				   tssUtilsVerbose);	/* print errors */
     }
-    /* create the EK certificate from the EK public key, using the above issuer and subject */
+    /* create the EK certificate from the EK public key, using the prepared issuer and subject */
     if (rc == 0) {
-	rc = createCertificate(&x509CertString,			/* freed @3 */
-			       &pemCertString,			/* freed @2 */
-			       &certLength,
-			       &certificate,			/* output, freed @1 */
-			       &tpmtPublicOut,			/* public key to be certified */
-			       caKeyFileName,			/* CA signing key */
-			       issuerEntriesSize,
-			       issuerEntries,			/* certificate issuer */
-			       sizeof(subjectEntries)/sizeof(char *),
-			       subjectEntries,			/* certificate subject */
-			       caKeyPassword);			/* CA signing key password */
+	rc = createCertificateIssuer(NULL,			/* no formatted string */
+				     NULL,			/* no PEM */
+				     &certLength,
+				     &certificate,		/* output, freed @1 */
+				     &tpmtPublicOut,		/* public key to be certified */
+				     certIssuer);		/* CA key, issuer, subject */
     }
     /* If the NV index is not defined, define it */
     if (rc == 0) {
@@ -392,8 +492,213 @@ int main(int argc, char *argv[])
 	}
     }
     free(certificate);			/* @1 */
-    free(pemCertString);		/* @2 */
-    free(x509CertString);		/* @3 */
+    return rc;
+}
+
+/* provisionDeviceList() provisions each TPM listed in deviceListFilename, one per line:
+
+   name [PROPERTY=value ...]
+
+   The CA key, issuer, and subject in certIssuer are shared by all devices.  Each device gets its
+   own TSS context, so devices may be on different interfaces, ports, or data directories.  Blank
+   lines and lines starting with # are ignored.
+
+   A result line 'name rc' is printed for each device.  If resumeFilename is not NULL, the result
+   is also appended to it, and devices already recorded there with rc 0 are skipped, so an
+   interrupted run can be restarted with the same arguments.
+
+   If certificatePrefix is not NULL, each DER certificate is written to certificatePrefix
+   followed by the device name and .der.
+
+   Returns non-zero if any device failed.
+*/
+
+static TPM_RC provisionDeviceList(const char *deviceListFilename,
+				  const char *resumeFilename,
+				  const CertIssuer *certIssuer,
+				  TPMI_RH_NV_INDEX ekCertIndex,
+				  const char *platformPassword,
+				  const char *endorsementPassword,
+				  const char *keyPassword,
+				  int noFlush,
+				  const char *certificatePrefix)
+{
+    TPM_RC		rc = 0;
+    FILE		*listFile = NULL;
+    FILE		*resumeFile = NULL;
+    char		line[DEVICE_LINE_MAX];
+    char		**doneNames = NULL;	/* devices already provisioned */
+    size_t		doneCount = 0;
+    size_t		doneMax = 0;
+    size_t		i;
+    unsigned int	issued = 0;
+    unsigned int	skipped = 0;
+    unsigned int	failed = 0;
+
+    /* read the names of devices already provisioned */
+    if ((rc == 0) && (resumeFilename != NULL)) {
+	resumeFile = fopen(resumeFilename, "r");
+	/* a missing resume file is a fresh start */
+	while ((rc == 0) && (resumeFile != NULL) && (fgets(line, sizeof(line), resumeFile) != NULL)) {
+	    char 		name[DEVICE_LINE_MAX];
+	    unsigned int 	deviceRc;
+	    if ((sscanf(line, "%s %x", name, &deviceRc) != 2) || (deviceRc != 0)) {
+		continue;
+	    }
+	    if (doneCount == doneMax) {
+		char **tmp;
+		doneMax = (doneMax == 0) ? 64 : (doneMax * 2);
+		/* not TSS_Realloc, which is limited to TSS_ALLOC_MAX */
+		tmp = realloc(doneNames, doneMax * sizeof(char *));
+		if (tmp == NULL) {
+		    printf("provisionDeviceList: Error allocating resume list\n");
+		    rc = TSS_RC_OUT_OF_MEMORY;
+		    break;
+		}
+		doneNames = tmp;
+	    }
+	    doneNames[doneCount] = strdup(name);
+	    if (doneNames[doneCount] == NULL) {
+		printf("provisionDeviceList: Error allocating resume list\n");
+		rc = TSS_RC_OUT_OF_MEMORY;
+	    }
+	    else {
+		doneCount++;
+	    }
+	}
+	if (resumeFile != NULL) {
+	    fclose(resumeFile);
+	    resumeFile = NULL;
+	}
+    }
+    if ((rc == 0) && (resumeFilename != NULL)) {
+	resumeFile = fopen(resumeFilename, "a");
+	if (resumeFile == NULL) {
+	    printf("provisionDeviceList: Error opening %s\n", resumeFilename);
+	    rc = TSS_RC_FILE_OPEN;
+	}
+    }
+    if (rc == 0) {
+	listFile = fopen(deviceListFilename, "r");
+	if (listFile == NULL) {
+	    printf("provisionDeviceList: Error opening %s\n", deviceListFilename);
+	    rc = TSS_RC_FILE_OPEN;
+	}
+    }
+    while ((rc == 0) && (fgets(line, sizeof(line), listFile) != NULL)) {
+	char		*name;
+	char		*settings;
+	char		certificateFilename[DEVICE_LINE_MAX];
+	TPM_RC		deviceRc;
+	int		done = FALSE;
+
+	name = strtok(line, " \t\r\n");
+	if ((name == NULL) || (name[0] == '#')) {
+	    continue;
+	}
+	settings = strtok(NULL, "\r\n");	/* remainder of the line, may be NULL */
+	for (i = 0 ; (i < doneCount) && !done ; i++) {
+	    done = (strcmp(name, doneNames[i]) == 0);
+	}
+	if (done) {
+	    if (tssUtilsVerbose) printf("provisionDeviceList: %s already provisioned\n", name);
+	    skipped++;
+	    continue;
+	}
+	if (certificatePrefix != NULL) {
+	    snprintf(certificateFilename, sizeof(certificateFilename), "%s%s.der",
+		     certificatePrefix, name);
+	}
+	deviceRc = provisionDevice(settings,			/* NULL uses the environment */
+				   certIssuer,
+				   ekCertIndex,
+				   platformPassword,
+				   endorsementPassword,
+				   keyPassword,
+				   noFlush,
+				   (certificatePrefix != NULL) ? certificateFilename : NULL);
+	printf("%s %08x\n", name, deviceRc);
+	if (resumeFile != NULL) {
+	    fprintf(resumeFile, "%s %08x\n", name, deviceRc);
+	    fflush(resumeFile);		/* progress survives an interrupted run */
+	}
+	if (deviceRc == 0) {
+	    issued++;
+	}
+	else {
+	    failed++;
+	}
+    }
+    if (rc == 0) {
+	printf("createekcert: %u issued, %u skipped, %u failed\n", issued, skipped, failed);
+	if (failed != 0) {
+	    rc = EXIT_FAILURE;
+	}
+    }
+    if (listFile != NULL) {
+	fclose(listFile);
+    }
+    if (resumeFile != NULL) {
+	fclose(resumeFile);
+    }
+    for (i = 0 ; i < doneCount ; i++) {
+	free(doneNames[i]);
+    }
+    free(doneNames);
+    return rc;
+}
+
+/* setDeviceProperties() applies the white space separated PROPERTY=value settings to the TSS
+   context.  PROPERTY is one of the TPM_* environment variable names that select a TPM.  The
+   string is modified.
+*/
+
+static TPM_RC setDeviceProperties(TSS_CONTEXT *tssContext,
+				  char *deviceSettings)
+{
+    TPM_RC		rc = 0;
+    char		*setting;
+    char		*value;
+    size_t		i;
+    static const struct {
+	const char	*name;
+	int		property;
+    } deviceProperties[] = {
+	{"TPM_DATA_DIR",	TPM_DATA_DIR},
+	{"TPM_COMMAND_PORT",	TPM_COMMAND_PORT},
+	{"TPM_PLATFORM_PORT",	TPM_PLATFORM_PORT},
+	{"TPM_SERVER_NAME",	TPM_SERVER_NAME},
+	{"TPM_SERVER_TYPE",	TPM_SERVER_TYPE},
+	{"TPM_INTERFACE_TYPE",	TPM_INTERFACE_TYPE},
+	{"TPM_DEVICE",		TPM_DEVICE},
+	{"TPM_ENCRYPT_SESSIONS",TPM_ENCRYPT_SESSIONS}
+    };
+
+    for (setting = strtok(deviceSettings, " \t") ;
+	 (rc == 0) && (setting != NULL) ;
+	 setting = strtok(NULL, " \t")) {
+
+	value = strchr(setting, '=');
+	if (value == NULL) {
+	    printf("setDeviceProperties: Error, %s is not PROPERTY=value\n", setting);
+	    rc = TSS_RC_BAD_PROPERTY;
+	    break;
+	}
+	*value = '\0';
+	value++;
+	for (i = 0 ; i < sizeof(deviceProperties)/sizeof(deviceProperties[0]) ; i++) {
+	    if (strcmp(setting, deviceProperties[i].name) == 0) {
+		break;
+	    }
+	}
+	if (i == sizeof(deviceProperties)/sizeof(deviceProperties[0])) {
+	    printf("setDeviceProperties: Error, unknown property %s\n", setting);
+	    rc = TSS_RC_BAD_PROPERTY;
+	}
+	else {
+	    rc = TSS_SetProperty(tssContext, deviceProperties[i].property, value);
+	}
+    }
     return rc;
 }
 
@@ -579,7 +884,12 @@ static void printUsage(void)
     printf("\t\tnistp521\n");
     printf("\n");
     printf("\t[-noflush\tdo not flush the primary key]\n");
-    printf("\t[-of\t\tDER certificate output file name]\n");
+    printf("\t[-of\t\tDER certificate output file name, file name prefix with -il]\n");
+    printf("\n");
+    printf("\t[-il\t\tdevice list file, provision each TPM listed]\n");
+    printf("\t\tname [PROPERTY=value ...] per line, e.g.\n");
+    printf("\t\ttpm1 TPM_COMMAND_PORT=2331 TPM_PLATFORM_PORT=2332 TPM_DATA_DIR=tpm1\n");
+    printf("\t[-rf\t\tresume file, records results and skips devices already done]\n");
     printf("\n");
     printf("Currently:\n");
     printf("\n");
@@ -0,0 +1,308 @@
+/********************************************************************************/
+/*										*/
+/*			    Software MakeCredential				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Software TPM2_MakeCredential.  See credentiallib.h.
+
+   The algorithm is TPM 2.0 Part 1 24.4 Protection of Credential and Part 3 TPM2_MakeCredential.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tsscrypto.h>
+#include <ibmtss/tsscryptoh.h>
+#include <ibmtss/tssmarshal.h>
+#include <ibmtss/tssprint.h>
+
+#include "credentiallib.h"
+
+extern int tssUtilsVerbose;
+
+static TPM_RC credentialSeed(TPM2B_DIGEST *seed,
+			     TPM2B_ENCRYPTED_SECRET *secret,
+			     const CREDENTIAL_KEY *credentialKey);
+
+/* credentialKeyLoad() validates that publicArea is a key that TPM2_MakeCredential accepts, a
+   restricted decryption RSA or ECC key with an AES CFB symmetric algorithm, and calculates its
+   Name.
+
+   This is the per-key work.  Call it once per key, not once per credential.
+*/
+
+TPM_RC credentialKeyLoad(CREDENTIAL_KEY *credentialKey,
+			 const TPMT_PUBLIC *publicArea)
+{
+    TPM_RC		rc = 0;
+    uint16_t		digestSize = 0;
+    TPMT_HA		digest;
+    uint16_t		written = 0;
+    uint8_t		*buffer = NULL;		/* marshaled TPMT_PUBLIC, freed @1 */
+
+    if (rc == 0) {
+	if ((publicArea->type != TPM_ALG_RSA) && (publicArea->type != TPM_ALG_ECC)) {
+	    if (tssUtilsVerbose) printf("credentialKeyLoad: Error, key type %04x not supported\n",
+					publicArea->type);
+	    rc = TSS_RC_BAD_CREDENTIAL_KEY;
+	}
+    }
+    if (rc == 0) {
+	if (((publicArea->objectAttributes.val & TPMA_OBJECT_RESTRICTED) == 0) ||
+	    ((publicArea->objectAttributes.val & TPMA_OBJECT_DECRYPT) == 0)) {
+	    if (tssUtilsVerbose) printf("credentialKeyLoad: Error, "
+					"key is not a restricted decryption key\n");
+	    rc = TSS_RC_BAD_CREDENTIAL_KEY;
+	}
+    }
+    if (rc == 0) {
+	if ((publicArea->parameters.asymDetail.symmetric.algorithm != TPM_ALG_AES) ||
+	    (publicArea->parameters.asymDetail.symmetric.mode.aes != TPM_ALG_CFB)) {
+	    if (tssUtilsVerbose) printf("credentialKeyLoad: Error, "
+					"symmetric algorithm is not AES CFB\n");
+	    rc = TSS_RC_BAD_CREDENTIAL_KEY;
+	}
+    }
+    if (rc == 0) {
+	digestSize = TSS_GetDigestSize(publicArea->nameAlg);
+	if (digestSize == 0) {
+	    if (tssUtilsVerbose) printf("credentialKeyLoad: Error, nameAlg %04x not supported\n",
+					publicArea->nameAlg);
+	    rc = TSS_RC_BAD_HASH_ALGORITHM;
+	}
+    }
+    /* Name is nameAlg || H(TPMT_PUBLIC) */
+    if (rc == 0) {
+	rc = TSS_Structure_Marshal(&buffer,		/* freed @1 */
+				   &written,
+				   (void *)publicArea,
+				   (MarshalFunction_t)TSS_TPMT_PUBLIC_Marshalu);
+    }
+    if (rc == 0) {
+	digest.hashAlg = publicArea->nameAlg;
+	rc = TSS_Hash_Generate(&digest,
+			       written, buffer,
+			       0, NULL);
+    }
+    if (rc == 0) {
+	credentialKey->publicArea = *publicArea;
+	credentialKey->name.t.name[0] = (uint8_t)(publicArea->nameAlg >> 8);
+	credentialKey->name.t.name[1] = (uint8_t)(publicArea->nameAlg >> 0);
+	memcpy(credentialKey->name.t.name + 2, (uint8_t *)&digest.digest, digestSize);
+	credentialKey->name.t.size = sizeof(TPMI_ALG_HASH) + digestSize;
+    }
+    free(buffer);		/* @1 */
+    return rc;
+}
+
+/* credentialMake() is the software equivalent of TPM2_MakeCredential.
+
+   credential is the value that TPM2_ActivateCredential returns.  objectName is the Name of the
+   object (typically an attestation key) that the TPM must hold for activation.
+*/
+
+TPM_RC credentialMake(TPM2B_ID_OBJECT *credentialBlob,
+		      TPM2B_ENCRYPTED_SECRET *secret,
+		      const CREDENTIAL_KEY *credentialKey,
+		      const TPM2B_DIGEST *credential,
+		      const TPM2B_NAME *objectName)
+{
+    TPM_RC		rc = 0;
+    TPMI_ALG_HASH	nameAlg = credentialKey->publicArea.nameAlg;
+    uint16_t		digestSize = TSS_GetDigestSize(nameAlg);
+    uint16_t		keyBits =
+	credentialKey->publicArea.parameters.asymDetail.symmetric.keyBits.aes;
+    TPM2B_DIGEST	seed;
+    uint8_t		symKey[MAX_SYM_KEY_BYTES];
+    uint8_t		iv[MAX_SYM_BLOCK_SIZE];
+    TPM2B_KEY		hmacKey;
+    TPM2B_DIGEST	empty;			/* TSS_KDFA() context is never NULL */
+    TPMT_HA		outerHmac;
+    uint16_t		encIdentitySize = 0;
+    uint8_t		*encIdentity = NULL;	/* encrypted credential within credentialBlob */
+    uint8_t		*buffer;
+    uint32_t		size;
+
+    if (rc == 0) {
+	if (credential->t.size > digestSize) {
+	    if (tssUtilsVerbose) printf("credentialMake: Error, credential size %u > %u\n",
+					credential->t.size, digestSize);
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+    }
+    if (rc == 0) {
+	if ((keyBits / 8) > sizeof(symKey)) {
+	    if (tssUtilsVerbose) printf("credentialMake: Error, symmetric key bits %u\n", keyBits);
+	    rc = TSS_RC_BAD_CREDENTIAL_KEY;
+	}
+    }
+    /* seed and its encryption under the key */
+    if (rc == 0) {
+	rc = credentialSeed(&seed, secret, credentialKey);
+    }
+    /* the blob is TPM2B integrityHMAC || encIdentity.  The HMAC is filled in last, so reserve its
+       space now and marshal the plaintext credential where the encIdentity goes. */
+    if (rc == 0) {
+	credentialBlob->t.size = 0;
+	buffer = credentialBlob->t.credential + sizeof(uint16_t) + digestSize;
+	size = sizeof(credentialBlob->t.credential) - (sizeof(uint16_t) + digestSize);
+	encIdentity = buffer;
+	rc = TSS_TPM2B_DIGEST_Marshalu(credential, &encIdentitySize, &buffer, &size);
+    }
+    /* symKey = KDFa(nameAlg, seed, "STORAGE", Name, NULL, symKeyBits) */
+    if (rc == 0) {
+	empty.t.size = 0;
+	rc = TSS_KDFA(symKey,
+		      nameAlg,
+		      &seed.b,
+		      "STORAGE",
+		      &objectName->b,
+		      &empty.b,
+		      keyBits);
+    }
+    /* encIdentity = CFBEncrypt(symKey, 0, credential), IV is zero */
+    if (rc == 0) {
+	memset(iv, 0, sizeof(iv));
+	rc = TSS_AES_EncryptCFB(encIdentity,
+				keyBits,
+				symKey,
+				iv,
+				encIdentitySize,
+				encIdentity);
+    }
+    /* HMACkey = KDFa(nameAlg, seed, "INTEGRITY", NULL, NULL, digestBits) */
+    if (rc == 0) {
+	hmacKey.t.size = digestSize;
+	rc = TSS_KDFA(hmacKey.t.buffer,
+		      nameAlg,
+		      &seed.b,
+		      "INTEGRITY",
+		      &empty.b,
+		      &empty.b,
+		      digestSize * 8);
+    }
+    /* outerHMAC = HMAC(HMACkey, encIdentity || Name) */
+    if (rc == 0) {
+	outerHmac.hashAlg = nameAlg;
+	rc = TSS_HMAC_Generate(&outerHmac,
+			       &hmacKey,
+			       encIdentitySize, encIdentity,
+			       objectName->t.size, objectName->t.name,
+			       0, NULL);
+    }
+    if (rc == 0) {
+	credentialBlob->t.credential[0] = (uint8_t)(digestSize >> 8);
+	credentialBlob->t.credential[1] = (uint8_t)(digestSize >> 0);
+	memcpy(credentialBlob->t.credential + sizeof(uint16_t),
+	       (uint8_t *)&outerHmac.digest, digestSize);
+	credentialBlob->t.size = sizeof(uint16_t) + digestSize + encIdentitySize;
+	if (tssUtilsVerbose) TSS_PrintAll("credentialMake: credentialBlob",
+					  credentialBlob->t.credential,
+					  credentialBlob->t.size);
+    }
+    /* the seed, symKey and HMAC key protect the credential */
+    memset(&seed, 0, sizeof(seed));
+    memset(symKey, 0, sizeof(symKey));
+    memset(&hmacKey, 0, sizeof(hmacKey));
+    return rc;
+}
+
+/* credentialSeed() generates the seed and encrypts it to the key, using the label "IDENTITY".
+
+   For RSA, the seed is random and OAEP encrypted.  For ECC, the seed is derived with KDFe from an
+   ephemeral ECDH exchange and the secret is the ephemeral public point.
+*/
+
+static TPM_RC credentialSeed(TPM2B_DIGEST *seed,
+			     TPM2B_ENCRYPTED_SECRET *secret,
+			     const CREDENTIAL_KEY *credentialKey)
+{
+    TPM_RC		rc = 0;
+    const TPMT_PUBLIC	*publicArea = &credentialKey->publicArea;
+
+    switch (publicArea->type) {
+#ifndef TPM_TSS_NORSA
+      case TPM_ALG_RSA:
+	if (rc == 0) {
+	    seed->t.size = TSS_GetDigestSize(publicArea->nameAlg);
+	    rc = TSS_RandBytes(seed->t.buffer, seed->t.size);
+	}
+	if (rc == 0) {
+	    /* public exponent, 0 is the default 2^16 + 1 */
+	    uint32_t exponent = publicArea->parameters.rsaDetail.exponent;
+	    unsigned char earr[4];
+	    if (exponent == 0) {
+		exponent = 0x10001;
+	    }
+	    earr[0] = (unsigned char)(exponent >> 24);
+	    earr[1] = (unsigned char)(exponent >> 16);
+	    earr[2] = (unsigned char)(exponent >> 8);
+	    earr[3] = (unsigned char)(exponent >> 0);
+	    rc = TSS_RSAPublicEncrypt(secret->t.secret,
+				      publicArea->unique.rsa.t.size,
+				      seed->t.buffer,
+				      seed->t.size,
+				      (unsigned char *)publicArea->unique.rsa.t.buffer,
+				      publicArea->unique.rsa.t.size,
+				      earr,
+				      sizeof(earr),
+				      (unsigned char *)"IDENTITY",	/* encoding parameter */
+				      sizeof("IDENTITY"),
+				      publicArea->nameAlg);
+	}
+	if (rc == 0) {
+	    secret->t.size = publicArea->unique.rsa.t.size;
+	}
+	break;
+#endif	/* TPM_TSS_NORSA */
+#ifndef TPM_TSS_NOECC
+      case TPM_ALG_ECC:
+	rc = TSS_ECC_Seed(seed, secret,
+			  (TPMT_PUBLIC *)publicArea,	/* not modified */
+			  "IDENTITY");
+	break;
+#endif	/* TPM_TSS_NOECC */
+      default:
+	if (tssUtilsVerbose) printf("credentialSeed: Error, key type %04x not supported\n",
+				    publicArea->type);
+	rc = TSS_RC_BAD_CREDENTIAL_KEY;
+    }
+    return rc;
+}
@@ -0,0 +1,78 @@
+/********************************************************************************/
+/*										*/
+/*			    Software MakeCredential				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Software TPM2_MakeCredential for an attestation server.
+
+   credentialMake() produces the same TPM2B_ID_OBJECT and TPM2B_ENCRYPTED_SECRET as
+   TPM2_MakeCredential, using only the public part of the key (typically an EK), so the server needs
+   no TPM.  The output is not bit-identical to a TPM's, because the seed is random, but
+   TPM2_ActivateCredential recovers the same credential.
+
+   A CREDENTIAL_KEY holds a public key that has already been validated by credentialKeyLoad().  A
+   server issuing many credentials to the same TPM loads the key once and keeps it, for example in a
+   table indexed by the key Name.  credentialMake() does not modify the CREDENTIAL_KEY and the
+   library has no global state, so several threads may share a loaded key.
+*/
+
+#ifndef CREDENTIALLIB_H
+#define CREDENTIALLIB_H
+
+#include <ibmtss/tss.h>
+
+typedef struct {
+    TPMT_PUBLIC	publicArea;	/* restricted decryption key */
+    TPM2B_NAME	name;		/* Name of publicArea */
+} CREDENTIAL_KEY;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    TPM_RC credentialKeyLoad(CREDENTIAL_KEY *credentialKey,
+			     const TPMT_PUBLIC *publicArea);
+    TPM_RC credentialMake(TPM2B_ID_OBJECT *credentialBlob,
+			  TPM2B_ENCRYPTED_SECRET *secret,
+			  const CREDENTIAL_KEY *credentialKey,
+			  const TPM2B_DIGEST *credential,
+			  const TPM2B_NAME *objectName);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -51,12 +51,19 @@
 #include <string.h>
 #include <stdint.h>
 #include <limits.h>
+#include <time.h>
+#include <sys/stat.h>
 
 /* Windows 10 crypto API clashes with openssl */
 #ifdef TPM_WINDOWS
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif
+#include <windows.h>
+#endif
+
+#ifdef TPM_POSIX
+#include <pthread.h>
 #endif
 
 #include <openssl/pem.h>
@@ -66,6 +73,7 @@
 #include <ibmtss/tssresponsecode.h>
 #include <ibmtss/tssutils.h>
 #include <ibmtss/tsscrypto.h>
+#include <ibmtss/tsscryptoh.h>
 #include <ibmtss/tssprint.h>
 #include <ibmtss/Unmarshal_fp.h>
 
@@ -105,6 +113,9 @@ extern int tssUtilsVerbose;
 /* readNvBufferMax() determines the maximum NV read/write block size.  The limit is typically set by
    the TPM property TPM_PT_NV_BUFFER_MAX.  However, it's possible that a value could be larger than
    the TSS side structure MAX_NV_BUFFER_SIZE.
+
+   The TSS normally reads TPM_PT_NV_BUFFER_MAX with the TPM buffer sizes, see TSS_GetBufferSize().
+   The TPM is only read here if the TSS did not.
 */
 
 TPM_RC readNvBufferMax(TSS_CONTEXT *tssContext,
@@ -113,33 +124,40 @@ TPM_RC readNvBufferMax(TSS_CONTEXT *tssContext,
     TPM_RC			rc = 0;
     GetCapability_In 		in;
     GetCapability_Out		out;
+    uint32_t			commandBufferSize;
+    uint32_t			responseBufferSize;
 
-    in.capability = TPM_CAP_TPM_PROPERTIES;
-    in.property = TPM_PT_NV_BUFFER_MAX;
-    in.propertyCount = 1;	/* ask for one property */
     if (rc == 0) {
+	rc = TSS_GetBufferSize(tssContext, &commandBufferSize, &responseBufferSize, nvBufferMax);
+    }
+    if ((rc == 0) && (*nvBufferMax == 0)) {
+	in.capability = TPM_CAP_TPM_PROPERTIES;
+	in.property = TPM_PT_NV_BUFFER_MAX;
+	in.propertyCount = 1;	/* ask for one property */
 	rc = TSS_Execute(tssContext,
 			 (RESPONSE_PARAMETERS *)&out, 
 			 (COMMAND_PARAMETERS *)&in,
 			 NULL,
 			 TPM_CC_GetCapability,
 			 TPM_RH_NULL, NULL, 0);
+	/* sanity check that the property name is correct (demo of how to parse the structure) */
+	if (rc == 0) {
+	    if ((out.capabilityData.data.tpmProperties.count > 0) &&
+		(out.capabilityData.data.tpmProperties.tpmProperty[0].property ==
+		 TPM_PT_NV_BUFFER_MAX)) {
+		*nvBufferMax = out.capabilityData.data.tpmProperties.tpmProperty[0].value;
+	    }
+	    else {
+		if (tssUtilsVerbose) printf("readNvBufferMax: wrong property returned: %08x\n",
+		       out.capabilityData.data.tpmProperties.tpmProperty[0].property);
+		/* hard code a value for a back level HW TPM that does not implement
+		   TPM_PT_NV_BUFFER_MAX yet */
+		*nvBufferMax = 512;
+	    }
+	    if (tssUtilsVerbose) printf("readNvBufferMax: TPM max read/write: %u\n", *nvBufferMax);
+	}
     }
-    /* sanity check that the property name is correct (demo of how to parse the structure) */
     if (rc == 0) {
-	if ((out.capabilityData.data.tpmProperties.count > 0) &&
-	    (out.capabilityData.data.tpmProperties.tpmProperty[0].property ==
-	     TPM_PT_NV_BUFFER_MAX)) {
-	    *nvBufferMax = out.capabilityData.data.tpmProperties.tpmProperty[0].value;
-	}
-	else {
-	    if (tssUtilsVerbose) printf("readNvBufferMax: wrong property returned: %08x\n",
-		   out.capabilityData.data.tpmProperties.tpmProperty[0].property);
-	    /* hard code a value for a back level HW TPM that does not implement
-	       TPM_PT_NV_BUFFER_MAX yet */
-	    *nvBufferMax = 512;
-	}
-	if (tssUtilsVerbose) printf("readNvBufferMax: TPM max read/write: %u\n", *nvBufferMax);
 	/* in addition, the maximum TSS side structure MAX_NV_BUFFER_SIZE is accounted for.  The TSS
 	   value is typically larger than the TPM value. */
 	if (*nvBufferMax > MAX_NV_BUFFER_SIZE) {
@@ -963,6 +981,532 @@ TPM_RC verifyCertificateI(void *x509Certificate,
     return rc;
 }
 
+/* A CaStore is a long lived CA certificate store for a verifier that validates many EK
+   certificates.  The root certificate list is read and the X509_STORE built once, rather than per
+   certificate as in verifyCertificateI().
+
+   caStoreReload() rebuilds the store if the list file or any root certificate file has changed,
+   and increments the generation.  Certificates that verified are remembered in a direct mapped
+   cache indexed by their hash, and an entry is valid only for the generation that verified it and
+   until the earliest notAfter time in its chain.  A repeated certificate is accepted without a
+   chain build.
+
+   A CaStore is shared by the threads of a verifier.  Each thread that keeps a pointer takes a
+   reference with caStoreRef() and releases it with caStoreDelete().  The cache, statistics, and
+   store swap are protected by a mutex, but the chain build runs outside it, on a reference to the
+   X509_STORE of the current generation, so certificates verify concurrently.  A reload builds the
+   new X509_STORE before taking the mutex, so it does not stall the verifiers.
+*/
+
+static TPM_RC caStoreLoad(CaStore *caStore,
+			  int print);
+static void caStoreFree(CaStore *caStore);
+static TPM_RC caStoreLockNew(void **lock);
+static void caStoreLockDelete(void *lock);
+static void caStoreLock(CaStore *caStore);
+static void caStoreUnlock(CaStore *caStore);
+static TPM_RC caStoreNotAfter(time_t *notAfter,
+			      X509_STORE_CTX *verifyCtx);
+static TPM_RC caStoreMtime(time_t *mtime,
+			   const char *filename);
+static TPM_RC caStoreHash(uint8_t *hash,
+			  X509 *x509Certificate,
+			  void *intermediateCert[],
+			  unsigned int intermediateCertCount);
+
+/* caStoreCreate() reads the root certificate list file listFilename and builds the store */
+
+TPM_RC caStoreCreate(CaStore **caStore,		/* freed by caStoreDelete() */
+		     const char *listFilename,
+		     int print)
+{
+    TPM_RC		rc = 0;
+
+    if (rc == 0) {
+	*caStore = calloc(1, sizeof(CaStore));
+	if (*caStore == NULL) {
+	    printf("caStoreCreate: Error allocating memory\n");
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if (rc == 0) {
+	(*caStore)->listFilename = malloc(strlen(listFilename) + 1);
+	if ((*caStore)->listFilename == NULL) {
+	    printf("caStoreCreate: Error allocating memory\n");
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if (rc == 0) {
+	strcpy((*caStore)->listFilename, listFilename);
+	(*caStore)->refCount = 1;
+	rc = caStoreLockNew(&(*caStore)->lock);
+    }
+    if (rc == 0) {
+	rc = caStoreLoad(*caStore, print);
+    }
+    if ((rc != 0) && (*caStore != NULL)) {
+	caStoreDelete(*caStore);
+	*caStore = NULL;
+    }
+    return rc;
+}
+
+/* caStoreRef() takes another reference to the store, typically for another thread.  Each
+   reference is released with caStoreDelete(). */
+
+CaStore *caStoreRef(CaStore *caStore)
+{
+    caStoreLock(caStore);
+    caStore->refCount++;
+    caStoreUnlock(caStore);
+    return caStore;
+}
+
+/* caStoreDelete() releases a reference, and frees the store when the last reference is released */
+
+void caStoreDelete(CaStore *caStore)
+{
+    int		last;
+
+    if (caStore != NULL) {
+	caStoreLock(caStore);
+	caStore->refCount--;
+	last = (caStore->refCount == 0);
+	caStoreUnlock(caStore);
+	if (last) {
+	    caStoreFree(caStore);
+	    caStoreLockDelete(caStore->lock);
+	    free(caStore->listFilename);
+	    free(caStore);
+	}
+    }
+    return;
+}
+
+/* caStoreReload() rebuilds the store if the list file or a root certificate file modification time
+   has changed, or unconditionally if force is TRUE.  reloaded is set TRUE if it did.
+
+   This is a few stat() calls, so a long running verifier can call it periodically.  force handles
+   a root certificate that was replaced within the file system time stamp granularity.
+*/
+
+TPM_RC caStoreReload(CaStore *caStore,
+		     int *reloaded,
+		     int force,
+		     int print)
+{
+    TPM_RC		rc = 0;
+    time_t		mtime;
+    unsigned int	i;
+    int			changed = force;
+
+    /* the file names and times are replaced by a concurrent reload */
+    caStoreLock(caStore);
+    if (!changed) {
+	if (caStoreMtime(&mtime, caStore->listFilename) != 0) {
+	    changed = TRUE;
+	}
+	else if (mtime != caStore->listMtime) {
+	    changed = TRUE;
+	}
+    }
+    for (i = 0 ; !changed && (i < caStore->rootFileCount) ; i++) {
+	if (caStoreMtime(&mtime, caStore->rootFilename[i]) != 0) {
+	    changed = TRUE;
+	}
+	else if (mtime != caStore->rootMtime[i]) {
+	    changed = TRUE;
+	}
+    }
+    caStoreUnlock(caStore);
+    if (changed) {
+	if (print) printf("caStoreReload: Reloading %s\n", caStore->listFilename);
+	rc = caStoreLoad(caStore, print);
+    }
+    *reloaded = changed;
+    return rc;
+}
+
+/* verifyCertificateCached() is verifyCertificateI() using a CaStore.
+
+   If the certificate and intermediate certificates already verified against this generation of
+   the store, and no certificate in the chain has since expired, it returns success without
+   building the chain.
+
+   It may be called concurrently on the same CaStore.
+*/
+
+TPM_RC verifyCertificateCached(CaStore *caStore,
+			       void *x509Certificate,
+			       void *intermediateCert[],
+			       unsigned int intermediateCertCount,
+			       int print)
+{
+    TPM_RC			rc = 0;
+    int				irc;
+    unsigned int		i;
+    uint8_t			hash[SHA256_DIGEST_SIZE];
+    CaStoreCacheEntry		*entry = NULL;
+    X509_STORE			*x509Store = NULL;	/* freed @1 */
+    uint32_t			generation = 0;
+    time_t			notAfter = 0;
+    STACK_OF(X509) 		*untrusted = NULL;	/* freed @2 */
+    X509_STORE_CTX 		*verifyCtx = NULL;	/* freed @3 */
+    int				hit = FALSE;
+
+    /* look up the certificate in the cache.  On a miss, take a reference to the current store, so
+       that a concurrent reload does not free it during the chain build */
+    if (rc == 0) {
+	rc = caStoreHash(hash, x509Certificate, intermediateCert, intermediateCertCount);
+    }
+    if (rc == 0) {
+	caStoreLock(caStore);
+	entry = &caStore->cache[((hash[0] << 8) | hash[1]) % CA_STORE_CACHE_SIZE];
+	if ((entry->generation == caStore->generation) &&
+	    (memcmp(entry->hash, hash, SHA256_DIGEST_SIZE) == 0) &&
+	    (time(NULL) <= entry->notAfter)) {
+	    caStore->cacheHits++;
+	    hit = TRUE;
+	}
+	else {
+	    irc = X509_STORE_up_ref(caStore->x509Store);	/* freed @1 */
+	    if (irc == 1) {
+		x509Store = caStore->x509Store;
+		generation = caStore->generation;
+	    }
+	    else {
+		printf("verifyCertificateCached: X509_STORE_up_ref failed\n");
+		rc = TSS_RC_X509_ERROR;
+	    }
+	}
+	caStoreUnlock(caStore);
+	if (hit) {
+	    if (print) printf("EK certificate verified against the root, cached\n");
+	}
+    }
+    if ((rc == 0) && !hit && (intermediateCertCount > 0)) {
+	untrusted = sk_X509_new_null();			/* freed @2 */
+	if (untrusted == NULL) {
+	    printf("verifyCertificateCached: sk_X509_new_null failed\n");
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    for (i = 0 ; (rc == 0) && !hit && (i < intermediateCertCount) ; i++) {
+	irc = sk_X509_push(untrusted, intermediateCert[i]);
+	if (irc < 1) {
+	    printf("verifyCertificateCached: sk_X509_push failed\n");
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if ((rc == 0) && !hit) {
+	verifyCtx = X509_STORE_CTX_new();		/* freed @3 */
+	if (verifyCtx == NULL) {
+	    printf("verifyCertificateCached: X509_STORE_CTX_new failed\n");
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if ((rc == 0) && !hit) {
+	irc = X509_STORE_CTX_init(verifyCtx,
+				  x509Store,		/* trusted certificates */
+				  x509Certificate,	/* end entity certificate */
+				  untrusted);		/* untrusted (intermediate) certificates */
+	if (irc != 1) {
+	    printf("verifyCertificateCached: "
+		   "Error in X509_STORE_CTX_init initializing verify context\n");
+	    rc = TSS_RC_X509_ERROR;
+	}
+    }
+    /* walk the certificate chain, outside the lock */
+    if ((rc == 0) && !hit) {
+	irc = X509_verify_cert(verifyCtx);
+	if (irc != 1) {
+	    printf("verifyCertificateCached: Error in X509_verify_cert verifying certificate\n");
+	    rc = TSS_RC_X509_ERROR;
+	}
+	else {
+	    if (print) printf("EK certificate verified against the root\n");
+	}
+    }
+    if ((rc == 0) && !hit) {
+	rc = caStoreNotAfter(&notAfter, verifyCtx);
+    }
+    /* remember the certificate, unless the store was reloaded during the chain build */
+    if ((rc == 0) && !hit) {
+	caStoreLock(caStore);
+	if (generation == caStore->generation) {
+	    memcpy(entry->hash, hash, SHA256_DIGEST_SIZE);
+	    entry->generation = generation;
+	    entry->notAfter = notAfter;
+	}
+	caStore->cacheMisses++;
+	caStoreUnlock(caStore);
+    }
+    if (x509Store != NULL) {
+	X509_STORE_free(x509Store);	/* @1 */
+    }
+    if (untrusted != NULL) {
+	sk_X509_free(untrusted);	/* @2 */
+    }
+    if (verifyCtx != NULL) {
+	X509_STORE_CTX_free(verifyCtx);	/* @3 */
+    }
+    return rc;
+}
+
+/* caStoreLoad() (re)reads the list file and root certificates and builds a new X509_STORE.
+
+   On success the generation is incremented, which invalidates the verified certificate cache.  On
+   failure the previous store is kept.
+
+   The new store is built without the lock, and only the swap is locked.  A verifier that is
+   building a chain holds its own reference to the old X509_STORE.
+*/
+
+static TPM_RC caStoreLoad(CaStore *caStore,
+			  int print)
+{
+    TPM_RC		rc = 0;
+    CaStore		newStore;
+    unsigned int	i;
+
+    memset(&newStore, 0, sizeof(CaStore));
+    /* the list mtime is read first, so a change during the load causes another reload */
+    if (rc == 0) {
+	rc = caStoreMtime(&newStore.listMtime, caStore->listFilename);
+    }
+    if (rc == 0) {
+	rc = getRootCertificateFilenames(newStore.rootFilename,
+					 &newStore.rootFileCount,
+					 caStore->listFilename,
+					 print);
+    }
+    for (i = 0 ; (rc == 0) && (i < newStore.rootFileCount) ; i++) {
+	rc = caStoreMtime(&newStore.rootMtime[i], newStore.rootFilename[i]);
+    }
+    if (rc == 0) {
+	rc = getCaStore(&newStore.x509Store,
+			newStore.caCert,
+			(const char **)newStore.rootFilename,
+			newStore.rootFileCount);
+    }
+    if (rc == 0) {
+	caStoreLock(caStore);
+	caStoreFree(caStore);
+	caStore->x509Store = newStore.x509Store;
+	caStore->rootFileCount = newStore.rootFileCount;
+	caStore->listMtime = newStore.listMtime;
+	for (i = 0 ; i < newStore.rootFileCount ; i++) {
+	    caStore->rootFilename[i] = newStore.rootFilename[i];
+	    caStore->caCert[i] = newStore.caCert[i];
+	    caStore->rootMtime[i] = newStore.rootMtime[i];
+	}
+	caStore->generation++;
+	caStoreUnlock(caStore);
+    }
+    else {
+	caStoreFree(&newStore);
+    }
+    return rc;
+}
+
+/* caStoreFree() frees the X509_STORE, certificates, and file names, but not the CaStore */
+
+static void caStoreFree(CaStore *caStore)
+{
+    unsigned int	i;
+
+    if (caStore->x509Store != NULL) {
+	X509_STORE_free(caStore->x509Store);
+	caStore->x509Store = NULL;
+    }
+    for (i = 0 ; i < caStore->rootFileCount ; i++) {
+	X509_free(caStore->caCert[i]);
+	caStore->caCert[i] = NULL;
+	free(caStore->rootFilename[i]);
+	caStore->rootFilename[i] = NULL;
+    }
+    caStore->rootFileCount = 0;
+    return;
+}
+
+/* caStoreLockNew() allocates and initializes the platform mutex */
+
+static TPM_RC caStoreLockNew(void **lock)
+{
+    TPM_RC		rc = 0;
+    int			irc;
+
+#ifdef TPM_POSIX
+    *lock = malloc(sizeof(pthread_mutex_t));
+#endif
+#ifdef TPM_WINDOWS
+    *lock = malloc(sizeof(CRITICAL_SECTION));
+#endif
+    if (*lock == NULL) {
+	printf("caStoreLockNew: Error allocating memory\n");
+	rc = TSS_RC_OUT_OF_MEMORY;
+    }
+    if (rc == 0) {
+#ifdef TPM_POSIX
+	irc = pthread_mutex_init(*lock, NULL);
+#endif
+#ifdef TPM_WINDOWS
+	InitializeCriticalSection(*lock);
+	irc = 0;
+#endif
+	if (irc != 0) {
+	    printf("caStoreLockNew: Error initializing mutex\n");
+	    free(*lock);
+	    *lock = NULL;
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    return rc;
+}
+
+static void caStoreLockDelete(void *lock)
+{
+    if (lock != NULL) {
+#ifdef TPM_POSIX
+	pthread_mutex_destroy(lock);
+#endif
+#ifdef TPM_WINDOWS
+	DeleteCriticalSection(lock);
+#endif
+	free(lock);
+    }
+    return;
+}
+
+/* caStoreLock() and caStoreUnlock() are no-ops if caStoreCreate() failed to create the mutex */
+
+static void caStoreLock(CaStore *caStore)
+{
+    if (caStore->lock != NULL) {
+#ifdef TPM_POSIX
+	pthread_mutex_lock(caStore->lock);
+#endif
+#ifdef TPM_WINDOWS
+	EnterCriticalSection(caStore->lock);
+#endif
+    }
+    return;
+}
+
+static void caStoreUnlock(CaStore *caStore)
+{
+    if (caStore->lock != NULL) {
+#ifdef TPM_POSIX
+	pthread_mutex_unlock(caStore->lock);
+#endif
+#ifdef TPM_WINDOWS
+	LeaveCriticalSection(caStore->lock);
+#endif
+    }
+    return;
+}
+
+/* caStoreNotAfter() returns the earliest notAfter time of the verified chain, the time after which
+   a cache entry must be verified again */
+
+static TPM_RC caStoreNotAfter(time_t *notAfter,
+			      X509_STORE_CTX *verifyCtx)
+{
+    TPM_RC		rc = 0;
+    int			irc;
+    int			i;
+    STACK_OF(X509)	*chain = NULL;
+    time_t		now = time(NULL);
+    int			days;
+    int			seconds;
+    time_t		certNotAfter;
+
+    if (rc == 0) {
+	chain = X509_STORE_CTX_get0_chain(verifyCtx);
+	if (chain == NULL) {
+	    printf("caStoreNotAfter: Error getting the verified chain\n");
+	    rc = TSS_RC_X509_ERROR;
+	}
+    }
+    for (i = 0 ; (rc == 0) && (i < sk_X509_num(chain)) ; i++) {
+	/* difference from now, avoiding the platform dependent timegm() */
+	irc = ASN1_TIME_diff(&days, &seconds,
+			     NULL, X509_get0_notAfter(sk_X509_value(chain, i)));
+	if (irc != 1) {
+	    printf("caStoreNotAfter: Error converting notAfter time\n");
+	    rc = TSS_RC_X509_ERROR;
+	}
+	else {
+	    certNotAfter = now + ((time_t)days * 24 * 60 * 60) + seconds;
+	    if ((i == 0) || (certNotAfter < *notAfter)) {
+		*notAfter = certNotAfter;
+	    }
+	}
+    }
+    return rc;
+}
+
+static TPM_RC caStoreMtime(time_t *mtime,
+			   const char *filename)
+{
+    TPM_RC		rc = 0;
+    struct stat		statBuf;
+
+    if (stat(filename, &statBuf) != 0) {
+	printf("caStoreMtime: Error, cannot stat %s\n", filename);
+	rc = TSS_RC_FILE_OPEN;
+    }
+    else {
+	*mtime = statBuf.st_mtime;
+    }
+    return rc;
+}
+
+/* caStoreHash() is the cache index, a SHA-256 hash over the DER of the certificate and the
+   intermediate certificates */
+
+static TPM_RC caStoreHash(uint8_t *hash,
+			  X509 *x509Certificate,
+			  void *intermediateCert[],
+			  unsigned int intermediateCertCount)
+{
+    TPM_RC		rc = 0;
+    TPMT_HA		digest;
+    unsigned int	i;
+    uint32_t		certLength;
+    unsigned char	*certificate = NULL;
+
+    digest.hashAlg = TPM_ALG_SHA256;
+    if (rc == 0) {
+	rc = convertX509ToDer(&certLength, &certificate,	/* freed @1 */
+			      x509Certificate);
+    }
+    if (rc == 0) {
+	rc = TSS_Hash_Generate(&digest,
+			       certLength, certificate,
+			       0, NULL);
+    }
+    free(certificate);		/* @1 */
+    /* chain each intermediate into the hash, H(previous || intermediate) */
+    for (i = 0 ; (rc == 0) && (i < intermediateCertCount) ; i++) {
+	certificate = NULL;
+	rc = convertX509ToDer(&certLength, &certificate,	/* freed @2 */
+			      intermediateCert[i]);
+	if (rc == 0) {
+	    memcpy(hash, (uint8_t *)&digest.digest, SHA256_DIGEST_SIZE);
+	    rc = TSS_Hash_Generate(&digest,
+				   SHA256_DIGEST_SIZE, hash,
+				   certLength, certificate,
+				   0, NULL);
+	}
+	free(certificate);	/* @2 */
+    }
+    if (rc == 0) {
+	memcpy(hash, (uint8_t *)&digest.digest, SHA256_DIGEST_SIZE);
+    }
+    return rc;
+}
+
 /* verifyKeyUsage() validates the key usage for an EK.
 
    If the EK has the decrypt attribute set, the keyEncipherment bit MUST be set for an RSA EK
@@ -1851,6 +2395,8 @@ static TPM_RC processAlgorithmSize(uint16_t *algorithmSize,
    The certificate is returned as a DER encoded array 'certificate', a PEM string, and a formatted
    string.
 
+   To issue many certificates with the same CA key, issuer, and subject, use certIssuerCreate() and
+   createCertificateIssuer() instead.
 */
 
 TPM_RC createCertificate(char **x509CertString,		/* freed by caller */
@@ -1864,6 +2410,98 @@ TPM_RC createCertificate(char **x509CertString,		/* freed by caller */
 			 size_t subjectEntriesSize,
 			 char **subjectEntries,
 			 const char *caKeyPassword)
+{
+    TPM_RC 		rc = 0;
+    CertIssuer		*certIssuer = NULL;
+
+    if (rc == 0) {
+	rc = certIssuerCreate(&certIssuer,		/* freed @1 */
+			      caKeyFileName, caKeyPassword,
+			      issuerEntriesSize, issuerEntries,
+			      subjectEntriesSize, subjectEntries);
+    }
+    if (rc == 0) {
+	rc = createCertificateIssuer(x509CertString,
+				     pemCertString,
+				     certLength,
+				     certificate,
+				     tpmtPublic,
+				     certIssuer);
+    }
+    certIssuerDelete(certIssuer);		/* @1 */
+    return rc;
+}
+
+/* certIssuerCreate() prepares the parts of an EK certificate that are the same for every device:
+   the CA signing key, read once from caKeyFileName, and the issuer and subject names.
+
+   The CertIssuer is only read by createCertificateIssuer(), so it can be reused for any number of
+   certificates.  The caller frees it with certIssuerDelete().
+*/
+
+TPM_RC certIssuerCreate(CertIssuer **certIssuer,		/* freed by caller */
+			const char *caKeyFileName,
+			const char *caKeyPassword,
+			size_t issuerEntriesSize,
+			char **issuerEntries,
+			size_t subjectEntriesSize,
+			char **subjectEntries)
+{
+    TPM_RC 		rc = 0;
+
+    if (rc == 0) {
+	*certIssuer = calloc(1, sizeof(CertIssuer));
+	if (*certIssuer == NULL) {
+	    printf("certIssuerCreate: Error allocating %lu bytes\n",
+		   (unsigned long)sizeof(CertIssuer));
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if (rc == 0) {
+	rc = readCaSigningKey(&(*certIssuer)->caKey, caKeyFileName, caKeyPassword);
+    }
+    if (rc == 0) {
+	rc = createX509Name(&(*certIssuer)->issuerName,
+			    issuerEntriesSize,
+			    issuerEntries);
+    }
+    if (rc == 0) {
+	rc = createX509Name(&(*certIssuer)->subjectName,
+			    subjectEntriesSize,
+			    subjectEntries);
+    }
+    if ((rc != 0) && (*certIssuer != NULL)) {
+	certIssuerDelete(*certIssuer);
+	*certIssuer = NULL;
+    }
+    return rc;
+}
+
+/* certIssuerDelete() frees a CertIssuer created by certIssuerCreate().  NULL is ignored. */
+
+void certIssuerDelete(CertIssuer *certIssuer)
+{
+    if (certIssuer != NULL) {
+	EVP_PKEY_free(certIssuer->caKey);
+	X509_NAME_free(certIssuer->issuerName);
+	X509_NAME_free(certIssuer->subjectName);
+	free(certIssuer);
+    }
+    return;
+}
+
+/* createCertificateIssuer() is createCertificate() using a prepared CertIssuer.
+
+   x509CertString and pemCertString may be NULL if the formatted and PEM forms are not needed,
+   which saves their conversion on a provisioning line.
+*/
+
+TPM_RC createCertificateIssuer(char **x509CertString,		/* freed by caller */
+			       char **pemCertString,		/* freed by caller */
+			       uint32_t *certLength,		/* output, certificate length */
+			       unsigned char **certificate,	/* output, freed by caller */
+			       TPMT_PUBLIC *tpmtPublic,		/* key to be certified */	
+			       const CertIssuer *certIssuer)
 {
     TPM_RC 		rc = 0;
     X509 		*x509Certificate = NULL;
@@ -1874,7 +2512,7 @@ TPM_RC createCertificate(char **x509CertString,		/* freed by caller */
     if (rc == 0) {
 	x509Certificate = X509_new();		/* freed @2 */
 	if (x509Certificate == NULL) {
-	    printf("createCertificate: Error in X509_new\n");
+	    printf("createCertificateIssuer: Error in X509_new\n");
 	    rc = TSS_RC_OUT_OF_MEMORY;
 	}
     }
@@ -1889,17 +2527,16 @@ TPM_RC createCertificate(char **x509CertString,		/* freed by caller */
 	    publicKey = tpmtPublic->unique.ecc.x.t.buffer;
 	}
 	else {
-	    printf("createCertificate: public key algorithm %04x not supported\n",
+	    printf("createCertificateIssuer: public key algorithm %04x not supported\n",
 		   tpmtPublic->type);
 	    rc = TSS_RC_BAD_SIGNATURE_ALGORITHM;
 	}
     }    
     /* fill in basic X509 information - version, serial, validity, issuer, subject */
     if (rc == 0) {
-	rc = startCertificate(x509Certificate,
-			      publicKeyLength, publicKey,
-			      issuerEntriesSize, issuerEntries,
-			      subjectEntriesSize, subjectEntries);
+	rc = startCertificateNames(x509Certificate,
+				   publicKeyLength, publicKey,
+				   certIssuer->issuerName, certIssuer->subjectName);
     }
     /* If the EK has the decrypt attribute set, the keyEncipherment bit MUST be set for an RSA EK
        certificate; the keyAgreement bit MUST be set for an ECC EK certificate. */
@@ -1927,24 +2564,24 @@ TPM_RC createCertificate(char **x509CertString,		/* freed by caller */
 #endif	/* TPM_TSS_NOECC */
 #endif  /* TPM_TPM20 */
 	  default:
-	    printf("createCertificate: public key algorithm %04x not supported\n",
+	    printf("createCertificateIssuer: public key algorithm %04x not supported\n",
 		   tpmtPublic->type);
 	    rc = TSS_RC_BAD_SIGNATURE_ALGORITHM;
 	}
     }
     /* sign the certificate with the root CA key */
     if (rc == 0) {
-	rc = addCertSignatureRoot(x509Certificate, caKeyFileName, caKeyPassword);
+	rc = addCertSignatureKey(x509Certificate, certIssuer->caKey);
     }
     if (rc == 0) {
 	rc = convertX509ToDer(certLength, certificate,	/* freed by caller */
 			      x509Certificate);		/* in */
     }
-    if (rc == 0) {
+    if ((rc == 0) && (pemCertString != NULL)) {
 	rc = convertX509ToPemMem(pemCertString,		/* freed by caller */
 				 x509Certificate);
     }
-    if (rc == 0) {
+    if ((rc == 0) && (x509CertString != NULL)) {
 	rc = convertX509ToString(x509CertString,	/* freed by caller */
 				 x509Certificate);
     }
@@ -1971,6 +2608,46 @@ TPM_RC startCertificate(X509 *x509Certificate,	/* X509 certificate to be generat
 			char **issuerEntries,		/* certificate issuer */
 			size_t subjectEntriesSize,
 			char **subjectEntries)		/* certificate subject */
+{
+    TPM_RC 		rc = 0;			/* general return code */
+    X509_NAME 		*x509IssuerName;	/* composite issuer name, key/value pairs */
+    X509_NAME 		*x509SubjectName;	/* composite subject name, key/value pairs */
+
+    x509IssuerName = NULL;	/* freed @1 */
+    x509SubjectName = NULL;	/* freed @2 */
+
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("startCertificate: Adding certificate issuer\n");
+	rc = createX509Name(&x509IssuerName,
+			    issuerEntriesSize,
+			    issuerEntries);
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("startCertificate: Adding certificate subject\n");
+	rc = createX509Name(&x509SubjectName,
+			    subjectEntriesSize,
+			    subjectEntries);
+    }
+    if (rc == 0) {
+	rc = startCertificateNames(x509Certificate,
+				   keyLength, keyBuffer,
+				   x509IssuerName, x509SubjectName);
+    }
+    X509_NAME_free(x509IssuerName);		/* @1 */
+    X509_NAME_free(x509SubjectName);		/* @2 */
+    return rc;
+}
+
+/* startCertificateNames() is startCertificate() with the issuer and subject names already
+   constructed.  The names are copied into the certificate, so a batch issuer can build them once
+   and reuse them for every certificate.
+*/
+
+TPM_RC startCertificateNames(X509 *x509Certificate,	/* X509 certificate to be generated */
+			     uint16_t keyLength,
+			     const unsigned char *keyBuffer,	/* key to be certified */
+			     X509_NAME *x509IssuerName,		/* certificate issuer */
+			     X509_NAME *x509SubjectName)	/* certificate subject */
 {
     TPM_RC 		rc = 0;			/* general return code */
     int			irc;			/* integer return code */
@@ -1978,18 +2655,14 @@ TPM_RC startCertificate(X509 *x509Certificate,	/* X509 certificate to be generat
     ASN1_INTEGER 	*x509Serial;		/* certificate serial number in ASN1 */
     BIGNUM 		*x509SerialBN;		/* certificate serial number as a BIGNUM */
     unsigned char 	x509Serialbin[EVP_MAX_MD_SIZE]; /* certificate serial number in binary */
-    X509_NAME 		*x509IssuerName;	/* composite issuer name, key/value pairs */
-    X509_NAME 		*x509SubjectName;	/* composite subject name, key/value pairs */
 
-    x509IssuerName = NULL;	/* freed @1 */
-    x509SubjectName = NULL;	/* freed @2 */
-    x509SerialBN = NULL;	/* freed @3 */ 
+    x509SerialBN = NULL;	/* freed @1 */ 
 
     /* add certificate version X509 v3 */
     if (rc == 0) {
 	irc = X509_set_version(x509Certificate, 2L);	/* value 2 == v3 */
 	if (irc != 1) {
-	    printf("startCertificate: Error in X509_set_version\n");
+	    printf("startCertificateNames: Error in X509_set_version\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
@@ -1999,12 +2672,12 @@ TPM_RC startCertificate(X509 *x509Certificate,	/* X509 certificate to be generat
     if (rc == 0) {
 	const EVP_MD *type;
 
-	if (tssUtilsVerbose) printf("startCertificate: Adding certificate serial number\n");
+	if (tssUtilsVerbose) printf("startCertificateNames: Adding certificate serial number\n");
 	/* to create a unique serial number, hash the key to be certified */
 	type = EVP_sha256();
 	irc = EVP_Digest(keyBuffer, keyLength, x509Serialbin, NULL, type, NULL);
 	if (irc == 0) {
-	    printf("startCertificate: Error in serial number EVP_Digest\n");
+	    printf("startCertificateNames: Error in serial number EVP_Digest\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
@@ -2012,7 +2685,7 @@ TPM_RC startCertificate(X509 *x509Certificate,	/* X509 certificate to be generat
 	/* convert the digest to a BIGNUM, use 20 octets */
 	x509SerialBN = BN_bin2bn(x509Serialbin, 20, x509SerialBN);
 	if (x509SerialBN == NULL) {
-	    printf("startCertificate: Error in serial number BN_bin2bn\n");
+	    printf("startCertificateNames: Error in serial number BN_bin2bn\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
@@ -2022,34 +2695,28 @@ TPM_RC startCertificate(X509 *x509Certificate,	/* X509 certificate to be generat
 	/* convert the BIGNUM to ASN1 and add to X509 certificate */
 	x509Serial = BN_to_ASN1_INTEGER(x509SerialBN, x509Serial);
 	if (x509Serial == NULL) {
-	    printf("startCertificate: Error setting certificate serial number\n");
+	    printf("startCertificateNames: Error setting certificate serial number\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
     /* add issuer */
-    if (rc == 0) {
-	if (tssUtilsVerbose) printf("startCertificate: Adding certificate issuer\n");
-	rc = createX509Name(&x509IssuerName,
-			    issuerEntriesSize,
-			    issuerEntries);
-    }
     if (rc == 0) {
 	irc = X509_set_issuer_name(x509Certificate, x509IssuerName);
 	if (irc != 1) {
-	    printf("startCertificate: Error setting certificate issuer\n");
+	    printf("startCertificateNames: Error setting certificate issuer\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
     /* add validity */
     if (rc == 0) {
-	if (tssUtilsVerbose) printf("startCertificate: Adding certificate validity\n");
+	if (tssUtilsVerbose) printf("startCertificateNames: Adding certificate validity\n");
     }
     if (rc == 0) {
 	/* can't fail, just returns a structure member */
 	ASN1_TIME *notBefore = X509_getm_notBefore((const X509 *)x509Certificate);
 	arc = X509_gmtime_adj(notBefore ,0L);			/* set to today */
 	if (arc == NULL) {
-	    printf("startCertificate: Error setting notBefore time\n");
+	    printf("startCertificateNames: Error setting notBefore time\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
@@ -2058,28 +2725,20 @@ TPM_RC startCertificate(X509 *x509Certificate,	/* X509 certificate to be generat
 	ASN1_TIME *notAfter = X509_getm_notAfter((const X509 *)x509Certificate);
 	arc = X509_gmtime_adj(notAfter, CERT_DURATION);		/* set to duration */
 	if (arc == NULL) {
-	    printf("startCertificate: Error setting notAfter time\n");
+	    printf("startCertificateNames: Error setting notAfter time\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
     /* add subject */
-    if (rc == 0) {
-	if (tssUtilsVerbose) printf("startCertificate: Adding certificate subject\n");
-	rc = createX509Name(&x509SubjectName,
-			    subjectEntriesSize,
-			    subjectEntries);
-    }
     if (rc == 0) {
 	irc = X509_set_subject_name(x509Certificate, x509SubjectName);
 	if (irc != 1) {
-	    printf("startCertificate: Error setting certificate subject\n");
+	    printf("startCertificateNames: Error setting certificate subject\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
     /* cleanup */
-    X509_NAME_free(x509IssuerName);		/* @1 */
-    X509_NAME_free(x509SubjectName);		/* @2 */
-    BN_free(x509SerialBN);			/* @3 */
+    BN_free(x509SerialBN);			/* @1 */
     return rc;
 }
 
@@ -2294,35 +2953,58 @@ TPM_RC addCertKeyEcc(X509 *x509Certificate,
 
 /* addCertSignatureRoot() uses the openSSL root key to sign the X509 certificate.
 
-   As a sanity check, it verifies the certificate.
-*/
+ */
 
 TPM_RC addCertSignatureRoot(X509 *x509Certificate,	/* certificate to be signed */
 			    const char *caKeyFileName,	/* openSSL root CA key password */
 			    const char *caKeyPassword)
 {
     TPM_RC 		rc = 0;		/* general return code */
-    int			irc;		/* integer return code */
-    FILE 		*fp = NULL;
-    /* signing key */
-    const EVP_MD	*digest = NULL;		/* signature digest algorithm */
-    EVP_PKEY 		*evpSignkey;		/* EVP format */
+    EVP_PKEY 		*evpSignkey;	/* EVP format */
 
     evpSignkey = NULL;		/* freed @1 */
 
+    /* convert the CA signing key from PEM to EVP_PKEY format */
+    if (rc == 0) {
+	rc = readCaSigningKey(&evpSignkey, caKeyFileName, caKeyPassword);
+    }
+    /* sign the certificate with the root CA signing key */
+    if (rc == 0) {
+	rc = addCertSignatureKey(x509Certificate, evpSignkey);
+    }
+    /* cleanup */
+    if (evpSignkey != NULL) {
+	EVP_PKEY_free(evpSignkey);	/* @1 */
+    }
+    return rc;
+}
+
+/* readCaSigningKey() reads the PEM CA signing key caKeyFileName, protected by caKeyPassword, into
+   an EVP_PKEY.
+
+   The caller frees the key with EVP_PKEY_free().
+*/
+
+TPM_RC readCaSigningKey(EVP_PKEY **evpSignkey,		/* freed by caller */
+			const char *caKeyFileName,
+			const char *caKeyPassword)
+{
+    TPM_RC 		rc = 0;		/* general return code */
+    FILE 		*fp = NULL;
+
     /* open the CA signing key file */
     if (rc == 0) {
 	fp = fopen(caKeyFileName,"r");
 	if (fp == NULL) {
-	    printf("addCertSignatureRoot: Error, Cannot open %s\n", caKeyFileName);
+	    printf("readCaSigningKey: Error, Cannot open %s\n", caKeyFileName);
 	    rc = TSS_RC_FILE_OPEN;
 	}
     }
     /* convert the CA signing key from PEM to EVP_PKEY format */
     if (rc == 0) {
-	evpSignkey = PEM_read_PrivateKey(fp, NULL, NULL, (void *)caKeyPassword);	
-	if (evpSignkey == NULL) {
-	    printf("addCertSignatureRoot: Error calling PEM_read_PrivateKey() from %s\n",
+	*evpSignkey = PEM_read_PrivateKey(fp, NULL, NULL, (void *)caKeyPassword);	
+	if (*evpSignkey == NULL) {
+	    printf("readCaSigningKey: Error calling PEM_read_PrivateKey() from %s\n",
 		   caKeyFileName);
 	    rc = TSS_RC_FILE_READ;
 	}
@@ -2331,32 +3013,43 @@ TPM_RC addCertSignatureRoot(X509 *x509Certificate,	/* certificate to be signed *
     if (fp != NULL) { 
 	fclose(fp);
     }
+    return rc;
+}
+
+/* addCertSignatureKey() signs the X509 certificate with the already loaded CA signing key and
+   verifies the signature.
+
+ */
+
+TPM_RC addCertSignatureKey(X509 *x509Certificate,	/* certificate to be signed */
+			   EVP_PKEY *evpSignkey)	/* CA signing key */
+{
+    TPM_RC 		rc = 0;		/* general return code */
+    int			irc;		/* integer return code */
+    const EVP_MD	*digest = NULL;		/* signature digest algorithm */
+
     /* set the certificate signature digest algorithm */
     if (rc == 0) {
 	digest = EVP_sha256();	/* no error return */
     }
     /* sign the certificate with the root CA signing key */
     if (rc == 0) {
-	if (tssUtilsVerbose) printf("addCertSignatureRoot: Signing the certificate\n");
+	if (tssUtilsVerbose) printf("addCertSignatureKey: Signing the certificate\n");
 	irc = X509_sign(x509Certificate, evpSignkey, digest);
 	if (irc == 0) {	/* returns signature size, 0 on error */
-	    printf("addCertSignature: Error signing certificate\n");
+	    printf("addCertSignatureKey: Error signing certificate\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
     /* verify the signature */
     if (rc == 0) {
-	if (tssUtilsVerbose) printf("addCertSignatureRoot: Verifying the certificate\n");
+	if (tssUtilsVerbose) printf("addCertSignatureKey: Verifying the certificate\n");
 	irc = X509_verify(x509Certificate, evpSignkey);
 	if (irc != 1) {
-	    printf("addCertSignatureRoot: Error verifying certificate\n");
+	    printf("addCertSignatureKey: Error verifying certificate\n");
 	    rc = TSS_RC_X509_ERROR;
 	}
     }
-    /* cleanup */
-    if (evpSignkey != NULL) {
-	EVP_PKEY_free(evpSignkey);	/* @1 */
-    }
     return rc;
 }
 
@@ -2401,6 +3094,41 @@ TPM_RC processRoot(TSS_CONTEXT *tssContext,
     return rc;
 }
 
+/* processRootCached() is processRoot() using a CaStore, for a verifier that validates many EK
+   certificates */
+
+TPM_RC processRootCached(TSS_CONTEXT *tssContext,
+			 TPMI_RH_NV_INDEX ekCertIndex,
+			 CaStore *caStore,
+			 int print)
+{
+    TPM_RC	rc = 0;
+    void	*ekCertificate = NULL;		/* freed @1 */
+
+    /* read the EK X509 certificate from NV */
+    if (rc == 0) {
+	rc = getIndexX509Certificate(tssContext,
+				     &ekCertificate,	/* freed @1 */
+				     ekCertIndex);
+	if (rc != 0) {
+	    printf("processRootCached: No EK certificate\n");
+	}
+    }
+    if (rc == 0) {
+	rc = verifyCertificateCached(caStore,
+				     ekCertificate,
+				     NULL, 0,		/* no intermediate certificates */
+				     print);
+	if (rc != 0) {
+	    printf("processRootCached: EK certificate did not verify\n");
+	}
+    }
+    if (ekCertificate != NULL) {
+	X509_free(ekCertificate);   	/* @1 */
+    }
+    return rc;
+}
+
 #endif
 
 /* processCreatePrimary() is deprecated.  It is missing the endorsement auth */
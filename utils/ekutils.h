@@ -52,6 +52,8 @@
 #include <openssl/bn.h>
 #endif	/* TPM_TSS_NO_OPENSSL */
 
+#include <time.h>
+
 #include <ibmtss/tss.h>
 
 /* legacy TCG IWG NV indexes (low range) */
@@ -85,6 +87,11 @@
 
 #define MAX_ROOTS		100	/* 100 should be more than enough */
 
+/* CA signing key, issuer, and subject prepared once for issuing many certificates, see
+   certIssuerCreate() */
+
+typedef struct tdCertIssuer CertIssuer;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -162,6 +169,20 @@ extern "C" {
 			     size_t subjectEntriesSize,
 			     char **subjectEntries,
 			     const char *caKeyPassword);
+    TPM_RC certIssuerCreate(CertIssuer **certIssuer,
+			    const char *caKeyFileName,
+			    const char *caKeyPassword,
+			    size_t issuerEntriesSize,
+			    char **issuerEntries,
+			    size_t subjectEntriesSize,
+			    char **subjectEntries);
+    void certIssuerDelete(CertIssuer *certIssuer);
+    TPM_RC createCertificateIssuer(char **x509CertString,
+				   char **pemCertString,
+				   uint32_t *certLength,
+				   unsigned char **certificate,
+				   TPMT_PUBLIC *tpmtPublic,
+				   const CertIssuer *certIssuer);
     TPM_RC processRoot(TSS_CONTEXT *tssContext,
 		       TPMI_RH_NV_INDEX ekCertIndex,
 		       const char *rootFilename[],
@@ -279,6 +300,11 @@ extern "C" {
 
     /* certificate key to nid mapping array */
 
+    TPM_RC startCertificateNames(X509 *x509Certificate,
+				 uint16_t keyLength,
+				 const unsigned char *keyBuffer,
+				 X509_NAME *x509IssuerName,
+				 X509_NAME *x509SubjectName);
     TPM_RC startCertificate(X509 *x509Certificate,
 			    uint16_t keyLength,
 			    const unsigned char *keyBuffer,
@@ -309,8 +335,66 @@ extern "C" {
     TPM_RC addCertSignatureRoot(X509 *x509Certificate,
 				const char *caKeyFileName,
 				const char *caKeyPassword);
+    TPM_RC readCaSigningKey(EVP_PKEY **evpSignkey,
+			    const char *caKeyFileName,
+			    const char *caKeyPassword);
+    TPM_RC addCertSignatureKey(X509 *x509Certificate,
+			       EVP_PKEY *evpSignkey);
     int TSS_Pubkey_GetAlgorithm(EVP_PKEY *pkey);
 
+    struct tdCertIssuer {
+	EVP_PKEY	*caKey;		/* CA signing key */
+	X509_NAME	*issuerName;	/* certificate issuer */
+	X509_NAME	*subjectName;	/* certificate subject */
+    };
+
+    /* long lived CA store with a verified certificate cache, see caStoreCreate() */
+
+#define CA_STORE_CACHE_SIZE	4096	/* verified certificate cache entries */
+
+    typedef struct tdCaStoreCacheEntry
+    {
+	uint8_t		hash[SHA256_DIGEST_SIZE];	/* certificate and intermediates */
+	uint32_t	generation;			/* 0 is empty */
+	time_t		notAfter;			/* earliest notAfter in the chain */
+    } CaStoreCacheEntry;
+
+    typedef struct tdCaStore
+    {
+	void		*lock;			/* platform mutex, see caStoreLockNew() */
+	unsigned int	refCount;		/* freed when the last reference is deleted */
+	char		*listFilename;
+	time_t		listMtime;
+	char		*rootFilename[MAX_ROOTS];
+	time_t		rootMtime[MAX_ROOTS];
+	unsigned int	rootFileCount;
+	X509		*caCert[MAX_ROOTS];
+	X509_STORE	*x509Store;
+	uint32_t	generation;		/* incremented at each load */
+	uint32_t	cacheHits;
+	uint32_t	cacheMisses;
+	CaStoreCacheEntry cache[CA_STORE_CACHE_SIZE];
+    } CaStore;
+
+    TPM_RC caStoreCreate(CaStore **caStore,
+			 const char *listFilename,
+			 int print);
+    CaStore *caStoreRef(CaStore *caStore);
+    void caStoreDelete(CaStore *caStore);
+    TPM_RC caStoreReload(CaStore *caStore,
+			 int *reloaded,
+			 int force,
+			 int print);
+    TPM_RC verifyCertificateCached(CaStore *caStore,
+				   void *x509Certificate,
+				   void *intermediateCert[],
+				   unsigned int intermediateCertCount,
+				   int print);
+    TPM_RC processRootCached(TSS_CONTEXT *tssContext,
+			     TPMI_RH_NV_INDEX ekCertIndex,
+			     CaStore *caStore,
+			     int print);
+
 
 #endif /* TPM_TSS_NO_OPENSSL */
 
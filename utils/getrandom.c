@@ -50,6 +50,8 @@
 #include <ibmtss/tssresponsecode.h>
 #include <ibmtss/Unmarshal_fp.h>
 
+#include "randomlib.h"
+
 static void printUsage(void);
 
 extern int tssUtilsVerbose;
@@ -67,6 +69,9 @@ int main(int argc, char *argv[])
     unsigned char 		*randomBuffer = NULL;
     int				noZeros = FALSE;
     int				noSpace = FALSE;
+    uint32_t			poolSize = 0;		/* default no pool */
+    int				mix = FALSE;
+    RANDOM_POOL			*randomPool = NULL;
     TPMI_SH_AUTH_SESSION    	sessionHandle0 = TPM_RH_NULL;
     unsigned int		sessionAttributes0 = 0;
     TPMI_SH_AUTH_SESSION    	sessionHandle1 = TPM_RH_NULL;
@@ -106,6 +111,19 @@ int main(int argc, char *argv[])
  	else if (strcmp(argv[i],"-ns") == 0) {
 	    noSpace = TRUE;
 	}
+	else if (strcmp(argv[i],"-pool") == 0) {
+	    i++;
+	    if (i < argc) {
+		sscanf(argv[i],"%u", &poolSize);
+	    }
+	    else {
+		printf("Missing parameter for -pool\n");
+		printUsage();
+	    }
+	}
+ 	else if (strcmp(argv[i],"-mix") == 0) {
+	    mix = TRUE;
+	}
 	else if (strcmp(argv[i],"-se0") == 0) {
 	    i++;
 	    if (i < argc) {
@@ -189,6 +207,18 @@ int main(int argc, char *argv[])
 	printf("Missing or bad parameter -by\n");
 	printUsage();
     }
+    /* the pool sends TPM2_GetRandom without sessions */
+    if ((poolSize != 0) &&
+	((sessionHandle0 != TPM_RH_NULL) ||
+	 (sessionHandle1 != TPM_RH_NULL) ||
+	 (sessionHandle2 != TPM_RH_NULL))) {
+	printf("-pool cannot be used with -se0, -se1, or -se2\n");
+	printUsage();
+    }
+    if (mix && (poolSize == 0)) {
+	printf("-mix requires -pool\n");
+	printUsage();
+    }
     /* allocate a buffer for the bytes requested, add 1 for optional nul terminator */
     if (rc == 0) {
 	rc = TSS_Malloc(&randomBuffer, bytesRequested + 1);	/* freed @1 */
@@ -197,12 +227,36 @@ int main(int argc, char *argv[])
     if (rc == 0) {
 	rc = TSS_Create(&tssContext);
     }
+    /* fill a pool with maximum size TPM2_GetRandom responses and serve the bytes from it */
+    if ((rc == 0) && (poolSize != 0)) {
+	rc = randomPoolCreate(&randomPool, tssContext, poolSize, 0, mix);	/* freed @2 */
+    }
+    for (bytesCopied = 0 ; (rc == 0) && (randomPool != NULL) && (bytesCopied < bytesRequested) ; ) {
+	uint32_t bp;
+	uint32_t bytesGot = bytesRequested - bytesCopied;
+	rc = randomPoolGet(randomPool, randomBuffer + bytesCopied, bytesGot);
+	/* with -nz, drop zero bytes and get more */
+	for (bp = 0 ; (rc == 0) && (bp < bytesGot) ; bp++) {
+	    if (!noZeros || (randomBuffer[bytesCopied + bp] != 0)) {
+		randomBuffer[bytesCopied] = randomBuffer[bytesCopied + bp];
+		bytesCopied++;
+	    }
+	}
+	if ((rc == 0) && noZeros) {
+	    randomBuffer[bytesCopied] = 0x00;
+	}
+    }
+    if ((rc == 0) && (randomPool != NULL)) {
+	if (tssUtilsVerbose) printf("getrandom: pool used %u TPM2_GetRandom commands\n",
+				    randomPool->tpmCommands);
+    }
+    randomPoolDelete(randomPool);		/* @2 */
     /* This is somewhat optimized, but if a zero byte is obtained in the last pass, an extra pass is
        needed.  The trade-off is that, in general, asking for more random numbers than needed may slow
        down the TPM.  In any case, needing non-zero values for random auth should not happen very
        often.
      */
-    for (bytesCopied = 0 ; (rc == 0) && (bytesCopied < bytesRequested) ; ) {
+    for ( ; (rc == 0) && (poolSize == 0) && (bytesCopied < bytesRequested) ; ) {
 	/* Request whatever is left */
 	if (rc == 0) {
 	    in.bytesRequested = bytesRequested - bytesCopied;
@@ -287,6 +341,9 @@ static void printUsage(void)
     printf("\t[-nz\tget random number with no zero bytes (for authorization value)]\n");
     printf("\t[-ns\tno space, no text, no newlines]\n");
     printf("\t\tjust a string of hexascii suitable for a symmetric key\n");
+    printf("\t[-pool\tbytes, fill a pool of this size with maximum size\n");
+    printf("\t\tTPM2_GetRandom commands and serve the bytes from it]\n");
+    printf("\t[-mix\twith -pool, XOR the TPM bytes with the crypto library DRBG]\n");
     printf("\n");
     printf("\t-se[0-2] session handle / attributes (default NULL)\n");
     printf("\t01\tcontinue\n");
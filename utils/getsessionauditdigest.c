@@ -72,6 +72,7 @@ int main(int argc, char *argv[])
     const char			*qualifyingDataFilename = NULL;
     TPMS_ATTEST 		tpmsAttest;
     const char			*sessionDigestFilename = NULL;
+    int				compareAudit = FALSE;
     TPMI_SH_AUTH_SESSION    	sessionHandle0 = TPM_RS_PW;
     unsigned int		sessionAttributes0 = 0;
     TPMI_SH_AUTH_SESSION    	sessionHandle1 = TPM_RS_PW;
@@ -256,6 +257,9 @@ int main(int argc, char *argv[])
 		printUsage();
 	    }
 	}
+	else if (strcmp(argv[i],"-ca") == 0) {
+	    compareAudit = TRUE;
+	}
  	else if (strcmp(argv[i],"-h") == 0) {
 	    printUsage();
 	}
@@ -311,6 +315,10 @@ int main(int argc, char *argv[])
 			 sessionHandle2, NULL, sessionAttributes2,
 			 TPM_RH_NULL, NULL, 0);
     }
+    /* compare the signed audit digest with the digest the TSS calculated */
+    if ((rc == 0) && compareAudit) {
+	rc = TSS_VerifyAuditDigest(tssContext, sessionHandle, &out.auditInfo);
+    }
     {
 	TPM_RC rc1 = TSS_Delete(tssContext);
 	if (rc == 0) {
@@ -382,6 +390,7 @@ static void printUsage(void)
     printf("\t[-os\tsignature file name (default do not save)]\n");
     printf("\t[-oa\tattestation output file name (default do not save)]\n");
     printf("\t[-od\tsession digest file name (default do not save)]\n");
+    printf("\t[-ca\tcompare the audit digest with the TSS running audit digest]\n");
     printf("\n");
     printf("\t-se[0-2] session handle / attributes (default PWAP)\n");
     printf("\t01\tcontinue\n");
@@ -50,6 +50,8 @@
 #include <ibmtss/tssresponsecode.h>
 #include <ibmtss/tssmarshal.h>
 
+#include "sequencelib.h"
+
 static void printUsage(void);
 static void printHash(Hash_Out *out);
 
@@ -70,6 +72,8 @@ int main(int argc, char *argv[])
     const char			*hashFilename = NULL;
     const char			*ticketFilename = NULL;
     int				noSpace = FALSE;
+    int				sequence = FALSE;
+    SEQUENCE_STREAM		stream;
  
     size_t 			length = 0;
     uint8_t			*buffer = NULL;	/* for the free */
@@ -158,6 +162,9 @@ int main(int argc, char *argv[])
 	else if (strcmp(argv[i],"-ns") == 0) {
 	    noSpace = TRUE;
 	}
+	else if (strcmp(argv[i],"-seq") == 0) {
+	    sequence = TRUE;
+	}
  	else if (strcmp(argv[i],"-h") == 0) {
 	    printUsage();
 	}
@@ -198,7 +205,7 @@ int main(int argc, char *argv[])
 	}
  	in.hierarchy = hierarchy;
     }
-    if (inFilename != NULL) {
+    if ((inFilename != NULL) && !sequence) {
 	if (rc == 0) {
 	    rc = TSS_File_ReadBinaryFile(&buffer,     /* freed @1 */
 					 &length,
@@ -206,7 +213,7 @@ int main(int argc, char *argv[])
 	}
 	if (rc == 0) {
 	    if (length > sizeof(in.data.t.buffer)) {
-		printf("Input data too long %lu\n", (unsigned long)length);
+		printf("Input data too long %lu, use -seq\n", (unsigned long)length);
 		rc = TSS_RC_INSUFFICIENT_BUFFER;
 	    }
 	}
@@ -216,7 +223,7 @@ int main(int argc, char *argv[])
 	    memcpy(in.data.t.buffer, buffer, length);
 	}
     }
-    if (inString != NULL) {
+    if ((inString != NULL) && !sequence) {
 	if (rc == 0) {
 	    length = strlen(inString);
 	    if (length > sizeof(in.data.t.buffer)) {
@@ -238,7 +245,7 @@ int main(int argc, char *argv[])
 	rc = TSS_Create(&tssContext);
     }
     /* call TSS to execute the command */
-    if (rc == 0) {
+    if ((rc == 0) && !sequence) {
 	rc = TSS_Execute(tssContext,
 			 (RESPONSE_PARAMETERS *)&out, 
 			 (COMMAND_PARAMETERS *)&in,
@@ -246,6 +253,24 @@ int main(int argc, char *argv[])
 			 TPM_CC_Hash,
 			 TPM_RH_NULL, NULL, 0);
     }
+    /* for input of any length, stream through a hash sequence */
+    if ((rc == 0) && sequence) {
+	rc = sequenceHashStart(&stream, tssContext, halg, 0);
+	if (rc == 0) {
+	    if (inFilename != NULL) {
+		rc = sequenceUpdateFile(&stream, inFilename);
+	    }
+	    else {
+		rc = sequenceUpdate(&stream, (const uint8_t *)inString, strlen(inString));
+	    }
+	}
+	if (rc == 0) {
+	    rc = sequenceComplete(&stream, hierarchy, &out.outHash, &out.validation);
+	}
+	if (rc != 0) {
+	    sequenceAbort(&stream);
+	}
+    }
     {
 	TPM_RC rc1 = TSS_Delete(tssContext);
 	if (rc == 0) {
@@ -304,6 +329,7 @@ static void printUsage(void)
     printf("\t-if\tinput file to be hashed\n");
     printf("\t-ic\tdata string to be hashed\n");
     printf("\t[-ns\tno space, no text, no newlines]\n");
+    printf("\t[-seq\tuse a hash sequence, for input of any length]\n");
     printf("\t[-oh\thash file name (default do not save)]\n");
     printf("\t[-tk\tticket file name (default do not save)]\n");
     printf("\n");
@@ -49,6 +49,8 @@
 #include <ibmtss/tssutils.h>
 #include <ibmtss/tssresponsecode.h>
 
+#include "sequencelib.h"
+
 static void printUsage(void);
 static void printHmac(HMAC_Out *out);
 
@@ -74,6 +76,9 @@ int main(int argc, char *argv[])
     TPMI_SH_AUTH_SESSION    	sessionHandle2 = TPM_RH_NULL;
     unsigned int		sessionAttributes2 = 0;
 
+    int				sequence = FALSE;
+    SEQUENCE_STREAM		stream;
+
     size_t 			length = 0;
     uint8_t			*buffer = NULL;	/* for the free */
 
@@ -157,6 +162,9 @@ int main(int argc, char *argv[])
 		printUsage();
 	    }
 	}
+	else if (strcmp(argv[i],"-seq") == 0) {
+	    sequence = TRUE;
+	}
 	else if (strcmp(argv[i],"-se0") == 0) {
 	    i++;
 	    if (i < argc) {
@@ -247,7 +255,12 @@ int main(int argc, char *argv[])
 	printf("Input file -if and input string -ic cannot both be specified\n");
 	printUsage();
     }
-    if (inFilename != NULL) {
+    /* the sequence commands are not sent with the -se1 and -se2 sessions */
+    if (sequence && ((sessionHandle1 != TPM_RH_NULL) || (sessionHandle2 != TPM_RH_NULL))) {
+	printf("-seq cannot be used with -se1 or -se2\n");
+	printUsage();
+    }
+    if ((inFilename != NULL) && !sequence) {
 	if (rc == 0) {
 	    rc = TSS_File_ReadBinaryFile(&buffer,     /* freed @1 */
 					 &length,
@@ -255,7 +268,7 @@ int main(int argc, char *argv[])
 	}
 	if (rc == 0) {
 	    if (length > sizeof(in.buffer.t.buffer)) {
-		printf("Input data too long %lu\n", (unsigned long)length);
+		printf("Input data too long %lu, use -seq\n", (unsigned long)length);
 		rc = TSS_RC_INSUFFICIENT_BUFFER;
 	    }
 	}
@@ -265,7 +278,7 @@ int main(int argc, char *argv[])
 	    memcpy(in.buffer.t.buffer, buffer, length);
 	}
     }
-    if (inString != NULL) {
+    if ((inString != NULL) && !sequence) {
 	if (rc == 0) {
 	    length = strlen(inString);
 	    if (length > sizeof(in.buffer.t.buffer)) {
@@ -290,7 +303,7 @@ int main(int argc, char *argv[])
 	rc = TSS_Create(&tssContext);
     }
     /* call TSS to execute the command */
-    if (rc == 0) {
+    if ((rc == 0) && !sequence) {
 	rc = TSS_Execute(tssContext,
 			 (RESPONSE_PARAMETERS *)&out,
 			 (COMMAND_PARAMETERS *)&in,
@@ -301,6 +314,26 @@ int main(int argc, char *argv[])
 			 sessionHandle2, NULL, sessionAttributes2,
 			 TPM_RH_NULL, NULL, 0);
     }
+    /* for input of any length, stream through an HMAC sequence, the key is authorized with the
+       -se0 session */
+    if ((rc == 0) && sequence) {
+	rc = sequenceHmacStart(&stream, tssContext, keyHandle, keyPassword,
+			       sessionHandle0, sessionAttributes0, halg, 0);
+	if (rc == 0) {
+	    if (inFilename != NULL) {
+		rc = sequenceUpdateFile(&stream, inFilename);
+	    }
+	    else {
+		rc = sequenceUpdate(&stream, (const uint8_t *)inString, strlen(inString));
+	    }
+	}
+	if (rc == 0) {
+	    rc = sequenceComplete(&stream, TPM_RH_NULL, &out.outHMAC, NULL);
+	}
+	if (rc != 0) {
+	    sequenceAbort(&stream);
+	}
+    }
     {
 	TPM_RC rc1 = TSS_Delete(tssContext);
 	if (rc == 0) {
@@ -347,6 +380,8 @@ static void printUsage(void)
     printf("\t-if\tinput file to be HMACed\n");
     printf("\t-ic\tdata string to be HMACed\n");
     printf("\t[-os\thmac file name (default do not save)]\n");
+    printf("\t[-seq\tuse an HMAC sequence, for input of any length]\n");
+    printf("\t\t-se0 authorizes the key, -se1 and -se2 are not supported\n");
     printf("\n");
     printf("\t-se[0-2] session handle / attributes (default PWAP)\n");
     printf("\t01\tcontinue\n");
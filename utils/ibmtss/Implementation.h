@@ -1333,6 +1333,14 @@ typedef  UINT32             TPM_CC;
 #define  NTC2_CC_GetConfig                    (TPM_CC)(0x20000213)
 #endif
 
+// TPM_TSS_CC_SUBSET builds the TSS for a subset of the commands.  tssccsubset.h, generated by
+// tssccsubset.sh, redefines the CC_ of each omitted command as CC_NO.  This follows the TPM_CC_
+// definitions so that all command codes remain defined.
+
+#ifdef TPM_TSS_CC_SUBSET
+#include "tssccsubset.h"
+#endif
+
 #ifndef  COMPRESSED_LISTS
 #define ADD_FILL    1
 #else
@@ -48,6 +48,7 @@
 #include <ibmtss/tssprint.h>
 
 typedef struct TSS_CONTEXT TSS_CONTEXT; 
+typedef struct TSS_PREPARED TSS_PREPARED;
    
 #define TPM_TRACE_LEVEL		1
 #define TPM_DATA_DIR		2
@@ -59,6 +60,13 @@ typedef struct TSS_CONTEXT TSS_CONTEXT;
 #define TPM_ENCRYPT_SESSIONS	8
 #define TPM_SERVER_TYPE		9
 #define TPM_TRANSMIT_LOCALITY	10
+#define TPM_RECORD_FILE		11
+#define TPM_REPLAY_FILE		12
+#define TPM_REPLAY_TIMING	13
+#define TPM_NONCE_SEED		14
+#define TPM_SESSION_DIR		15
+#define TPM_MAX_COMMAND_SIZE	16
+#define TPM_MAX_RESPONSE_SIZE	17
 
 #ifdef __cplusplus
 extern "C" {
@@ -106,6 +114,50 @@ extern "C" {
 			   int property,
 			   const char *value);
 
+    LIB_EXPORT
+    TPM_RC TSS_GetBufferSize(TSS_CONTEXT *tssContext,
+			     uint32_t *commandBufferSize,
+			     uint32_t *responseBufferSize,
+			     uint32_t *nvBufferMax);
+
+    /* prepared commands, TPM 2.0 only */
+
+    LIB_EXPORT
+    TPM_RC TSS_Prepare(TSS_CONTEXT *tssContext,
+		       TSS_PREPARED **prepared,
+		       COMMAND_PARAMETERS *in,
+		       TPM_CC commandCode);
+
+    LIB_EXPORT
+    TPM_RC TSS_PreparedSetHandle(TSS_PREPARED *prepared,
+				 size_t index,
+				 TPM_HANDLE handle);
+
+    LIB_EXPORT
+    TPM_RC TSS_PreparedSetParameter(TSS_PREPARED *prepared,
+				    uint32_t offset,
+				    const uint8_t *data,
+				    uint32_t length);
+
+    LIB_EXPORT
+    TPM_RC TSS_ExecutePrepared(TSS_CONTEXT *tssContext,
+			       RESPONSE_PARAMETERS *out,
+			       TSS_PREPARED *prepared,
+			       ...);
+
+    LIB_EXPORT
+    TPM_RC TSS_PreparedDelete(TSS_PREPARED *prepared);
+
+    LIB_EXPORT
+    TPM_RC TSS_GetAuditDigest(TSS_CONTEXT *tssContext,
+			      TPM2B_DIGEST *auditDigest,
+			      TPMI_SH_AUTH_SESSION sessionHandle);
+
+    LIB_EXPORT
+    TPM_RC TSS_VerifyAuditDigest(TSS_CONTEXT *tssContext,
+				 TPMI_SH_AUTH_SESSION sessionHandle,
+				 const TPM2B_ATTEST *auditInfo);
+
 #ifdef __cplusplus
 }
 #endif
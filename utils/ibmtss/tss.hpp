@@ -0,0 +1,550 @@
+/********************************************************************************/
+/*										*/
+/*			       TSS C++ Interface				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* ibmtss/tss.hpp is a header only C++11 layer over TSS_Execute().
+
+   CommandTraits<TPM_CC> maps each TPM 2.0 command to its exact _In and _Out structures, so that a
+   command uses stack storage sized to that command rather than the COMMAND_PARAMETERS and
+   RESPONSE_PARAMETERS unions.  The number of authorization sessions supplied is checked at
+   compile time against the command's authorization handle count and MAX_SESSION_NUM.
+
+   Context, Handle, and Session are move only owners that call TSS_Delete() or
+   TPM2_FlushContext in their destructor.
+
+   The layer adds no heap use.  Errors are returned as TPM_RC, as with the C API.
+
+   Example:
+
+	ibmtss::Context ctx;
+	ibmtss::Command<TPM_CC_GetRandom> getRandom;
+	rc = ctx.Create();
+	getRandom.in.bytesRequested = 16;
+	rc = getRandom.Execute(ctx);
+*/
+
+#ifndef TSS_HPP
+#define TSS_HPP
+
+#ifndef __cplusplus
+#error "ibmtss/tss.hpp requires a C++ compiler"
+#endif
+
+#include <cstddef>
+#include <type_traits>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+
+namespace ibmtss {
+
+    /* NoParameters stands in for a command with no _In or no _Out structure */
+
+    struct NoParameters {};
+
+    /* TSS_COMMAND_TRAITS_LIST is X(commandCode, In, Out, authHandles, maxSessions)
+
+       authHandles is the number of handles that require an authorization session.  maxSessions is
+       0 for commands that do not accept sessions. */
+
+#define TSS_COMMAND_TRAITS_LIST(X)							\
+    X(TPM_CC_Startup,				Startup_In,			NoParameters,			0, 0)			\
+    X(TPM_CC_Shutdown,				Shutdown_In,			NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_SelfTest,				SelfTest_In,			NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_IncrementalSelfTest,		IncrementalSelfTest_In,		IncrementalSelfTest_Out,	0, MAX_SESSION_NUM)	\
+    X(TPM_CC_GetTestResult,			NoParameters,			GetTestResult_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_StartAuthSession,			StartAuthSession_In,		StartAuthSession_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyRestart,			PolicyRestart_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_Create,				Create_In,			Create_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_Load,				Load_In,			Load_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_LoadExternal,			LoadExternal_In,		LoadExternal_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_ReadPublic,			ReadPublic_In,			ReadPublic_Out,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_ActivateCredential,		ActivateCredential_In,		ActivateCredential_Out,		2, MAX_SESSION_NUM)	\
+    X(TPM_CC_MakeCredential,			MakeCredential_In,		MakeCredential_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_Unseal,				Unseal_In,			Unseal_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ObjectChangeAuth,			ObjectChangeAuth_In,		ObjectChangeAuth_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_CreateLoaded,			CreateLoaded_In,		CreateLoaded_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_Duplicate,				Duplicate_In,			Duplicate_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_Rewrap,				Rewrap_In,			Rewrap_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_Import,				Import_In,			Import_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_RSA_Encrypt,			RSA_Encrypt_In,			RSA_Encrypt_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_RSA_Decrypt,			RSA_Decrypt_In,			RSA_Decrypt_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ECDH_KeyGen,			ECDH_KeyGen_In,			ECDH_KeyGen_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_ECDH_ZGen,				ECDH_ZGen_In,			ECDH_ZGen_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ECC_Encrypt,			ECC_Encrypt_In,			ECC_Encrypt_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_ECC_Decrypt,			ECC_Decrypt_In,			ECC_Decrypt_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ECC_Parameters,			ECC_Parameters_In,		ECC_Parameters_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_ZGen_2Phase,			ZGen_2Phase_In,			ZGen_2Phase_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_EncryptDecrypt,			EncryptDecrypt_In,		EncryptDecrypt_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_EncryptDecrypt2,			EncryptDecrypt2_In,		EncryptDecrypt2_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_Hash,				Hash_In,			Hash_Out,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_HMAC,				HMAC_In,			HMAC_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_GetRandom,				GetRandom_In,			GetRandom_Out,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_StirRandom,			StirRandom_In,			NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_HMAC_Start,			HMAC_Start_In,			HMAC_Start_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_HashSequenceStart,			HashSequenceStart_In,		HashSequenceStart_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_SequenceUpdate,			SequenceUpdate_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_SequenceComplete,			SequenceComplete_In,		SequenceComplete_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_EventSequenceComplete,		EventSequenceComplete_In,	EventSequenceComplete_Out,	2, MAX_SESSION_NUM)	\
+    X(TPM_CC_Certify,				Certify_In,			Certify_Out,			2, MAX_SESSION_NUM)	\
+    X(TPM_CC_CertifyX509,			CertifyX509_In,			CertifyX509_Out,		2, MAX_SESSION_NUM)	\
+    X(TPM_CC_CertifyCreation,			CertifyCreation_In,		CertifyCreation_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_Quote,				Quote_In,			Quote_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_GetSessionAuditDigest,		GetSessionAuditDigest_In,	GetSessionAuditDigest_Out,	2, MAX_SESSION_NUM)	\
+    X(TPM_CC_GetCommandAuditDigest,		GetCommandAuditDigest_In,	GetCommandAuditDigest_Out,	2, MAX_SESSION_NUM)	\
+    X(TPM_CC_GetTime,				GetTime_In,			GetTime_Out,			2, MAX_SESSION_NUM)	\
+    X(TPM_CC_Commit,				Commit_In,			Commit_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_EC_Ephemeral,			EC_Ephemeral_In,		EC_Ephemeral_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_VerifySignature,			VerifySignature_In,		VerifySignature_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_Sign,				Sign_In,			Sign_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_SetCommandCodeAuditStatus,		SetCommandCodeAuditStatus_In,	NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PCR_Extend,			PCR_Extend_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PCR_Event,				PCR_Event_In,			PCR_Event_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PCR_Read,				PCR_Read_In,			PCR_Read_Out,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PCR_Allocate,			PCR_Allocate_In,		PCR_Allocate_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PCR_SetAuthPolicy,			PCR_SetAuthPolicy_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PCR_SetAuthValue,			PCR_SetAuthValue_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PCR_Reset,				PCR_Reset_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicySigned,			PolicySigned_In,		PolicySigned_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicySecret,			PolicySecret_In,		PolicySecret_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyTicket,			PolicyTicket_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyOR,				PolicyOR_In,			NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyPCR,				PolicyPCR_In,			NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyLocality,			PolicyLocality_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyNV,				PolicyNV_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyAuthorizeNV,			PolicyAuthorizeNV_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyCounterTimer,		PolicyCounterTimer_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyCommandCode,			PolicyCommandCode_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyPhysicalPresence,		PolicyPhysicalPresence_In,	NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyCpHash,			PolicyCpHash_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyNameHash,			PolicyNameHash_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyDuplicationSelect,		PolicyDuplicationSelect_In,	NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyAuthorize,			PolicyAuthorize_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyAuthValue,			PolicyAuthValue_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyPassword,			PolicyPassword_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyGetDigest,			PolicyGetDigest_In,		PolicyGetDigest_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyNvWritten,			PolicyNvWritten_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyTemplate,			PolicyTemplate_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyCapability,			PolicyCapability_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_PolicyParameters,			PolicyParameters_In,		NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_CreatePrimary,			CreatePrimary_In,		CreatePrimary_Out,		1, MAX_SESSION_NUM)	\
+    X(TPM_CC_HierarchyControl,			HierarchyControl_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_SetPrimaryPolicy,			SetPrimaryPolicy_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ChangePPS,				ChangePPS_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ChangeEPS,				ChangeEPS_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_Clear,				Clear_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ClearControl,			ClearControl_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_HierarchyChangeAuth,		HierarchyChangeAuth_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_DictionaryAttackLockReset,		DictionaryAttackLockReset_In,	NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_DictionaryAttackParameters,	DictionaryAttackParameters_In,	NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_PP_Commands,			PP_Commands_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_SetAlgorithmSet,			SetAlgorithmSet_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ContextSave,			ContextSave_In,			ContextSave_Out,		0, 0)			\
+    X(TPM_CC_ContextLoad,			ContextLoad_In,			ContextLoad_Out,		0, 0)			\
+    X(TPM_CC_FlushContext,			FlushContext_In,		NoParameters,			0, 0)			\
+    X(TPM_CC_EvictControl,			EvictControl_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ReadClock,				NoParameters,			ReadClock_Out,			0, 0)			\
+    X(TPM_CC_ClockSet,				ClockSet_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_ClockRateAdjust,			ClockRateAdjust_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_GetCapability,			GetCapability_In,		GetCapability_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_TestParms,				TestParms_In,			NoParameters,			0, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_DefineSpace,			NV_DefineSpace_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_UndefineSpace,			NV_UndefineSpace_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_UndefineSpaceSpecial,		NV_UndefineSpaceSpecial_In,	NoParameters,			2, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_ReadPublic,			NV_ReadPublic_In,		NV_ReadPublic_Out,		0, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_Write,				NV_Write_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_Increment,			NV_Increment_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_Extend,				NV_Extend_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_SetBits,			NV_SetBits_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_WriteLock,			NV_WriteLock_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_GlobalWriteLock,		NV_GlobalWriteLock_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_Read,				NV_Read_In,			NV_Read_Out,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_ReadLock,			NV_ReadLock_In,			NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_ChangeAuth,			NV_ChangeAuth_In,		NoParameters,			1, MAX_SESSION_NUM)	\
+    X(TPM_CC_NV_Certify,			NV_Certify_In,			NV_Certify_Out,			2, MAX_SESSION_NUM)
+
+    /* CommandTraits<commandCode> is undefined for an unsupported command code, so using one is a
+       compile time error.
+
+       The structures are passed to TSS_Execute() as the COMMAND_PARAMETERS and
+       RESPONSE_PARAMETERS unions, so each must fit in its union. */
+
+    template <TPM_CC commandCode> struct CommandTraits;
+
+#define TSS_COMMAND_TRAITS(commandCode, in, out, auths, sessions)		\
+    template <> struct CommandTraits<commandCode> {				\
+	typedef in In;								\
+	typedef out Out;							\
+	static const unsigned int authHandles = auths;				\
+	static const unsigned int maxSessions = sessions;			\
+	static_assert(sizeof(in) <= sizeof(COMMAND_PARAMETERS),			\
+		      #in " is larger than COMMAND_PARAMETERS");		\
+	static_assert(sizeof(out) <= sizeof(RESPONSE_PARAMETERS),		\
+		      #out " is larger than RESPONSE_PARAMETERS");		\
+	static_assert(auths <= sessions,					\
+		      #commandCode " requires more sessions than it accepts");	\
+    };
+
+    TSS_COMMAND_TRAITS_LIST(TSS_COMMAND_TRAITS)
+
+#undef TSS_COMMAND_TRAITS
+
+    class Session;
+
+    /* Auth is one authorization session entry of the TSS_Execute() variable argument list.
+
+       owner, if not NULL, is the Session that is released when a successful command ends the
+       session, because continueSession was clear. */
+
+    struct Auth {
+	TPMI_SH_AUTH_SESSION	sessionHandle;
+	const char		*password;
+	unsigned int		sessionAttributes;
+	Session			*owner;
+    };
+
+    /* Password() returns a password session entry */
+
+    inline Auth Password(const char *password)
+    {
+	Auth auth = {TPM_RS_PW, password, 0, NULL};
+	return auth;
+    }
+
+    /* Context owns a TSS_CONTEXT */
+
+    class Context {
+      public:
+	Context() : tssContext(NULL) {}
+	~Context()
+	{
+	    Delete();
+	}
+	Context(Context &&other) : tssContext(other.tssContext)
+	{
+	    other.tssContext = NULL;
+	}
+	Context &operator=(Context &&other)
+	{
+	    if (this != &other) {
+		Delete();
+		tssContext = other.tssContext;
+		other.tssContext = NULL;
+	    }
+	    return *this;
+	}
+	Context(const Context &) = delete;
+	Context &operator=(const Context &) = delete;
+
+	TPM_RC Create()
+	{
+	    Delete();
+	    return TSS_Create(&tssContext);
+	}
+	TPM_RC Delete()
+	{
+	    TPM_RC rc = 0;
+	    if (tssContext != NULL) {
+		rc = TSS_Delete(tssContext);
+		tssContext = NULL;
+	    }
+	    return rc;
+	}
+	TPM_RC SetProperty(int property, const char *value)
+	{
+	    return TSS_SetProperty(tssContext, property, value);
+	}
+	TSS_CONTEXT *Get() const
+	{
+	    return tssContext;
+	}
+	operator TSS_CONTEXT *() const
+	{
+	    return tssContext;
+	}
+      private:
+	TSS_CONTEXT *tssContext;
+    };
+
+    namespace detail {
+
+	/* Parameter() returns NULL for NoParameters, so that TSS_Execute() sees no structure */
+
+	template <typename T> inline T *Parameter(T *p)
+	{
+	    return p;
+	}
+	inline NoParameters *Parameter(NoParameters *)
+	{
+	    return NULL;
+	}
+
+	template <typename... A> struct AllAuth;
+	template <> struct AllAuth<> : std::true_type {};
+	template <typename A, typename... R> struct AllAuth<A, R...> :
+	    std::integral_constant<bool, std::is_same<A, Auth>::value && AllAuth<R...>::value> {};
+
+	/* Execute() expands the session list into the TSS_Execute() variable arguments.  A
+	   session whose continueSession attribute is clear is released from its owner after the
+	   command succeeds, since the TPM has flushed it. */
+
+	inline TPM_RC Execute(TSS_CONTEXT *tssContext,
+			      RESPONSE_PARAMETERS *out,
+			      COMMAND_PARAMETERS *in,
+			      EXTRA_PARAMETERS *extra,
+			      TPM_CC commandCode,
+			      const Auth *auths,
+			      size_t authCount);
+    }
+
+    /* Execute() runs commandCode with the exact size in and out structures.  auths are 0 to
+       MAX_SESSION_NUM Auth entries, in handle order. */
+
+    template <TPM_CC commandCode, typename... A>
+    TPM_RC Execute(TSS_CONTEXT *tssContext,
+		   typename CommandTraits<commandCode>::Out *out,
+		   typename CommandTraits<commandCode>::In *in,
+		   const A &... auths)
+    {
+	typedef CommandTraits<commandCode> Traits;
+	static_assert(detail::AllAuth<A...>::value,
+		      "sessions must be ibmtss::Auth");
+	static_assert(sizeof...(A) <= Traits::maxSessions,
+		      "too many sessions for this command");
+	static_assert(sizeof...(A) >= Traits::authHandles,
+		      "too few sessions for the command's authorization handles");
+	static_assert(sizeof...(A) <= MAX_SESSION_NUM,
+		      "more than MAX_SESSION_NUM sessions");
+	const Auth list[sizeof...(A) + 1] = {auths..., Password(NULL)};
+	return detail::Execute(tssContext,
+			       reinterpret_cast<RESPONSE_PARAMETERS *>(detail::Parameter(out)),
+			       reinterpret_cast<COMMAND_PARAMETERS *>(detail::Parameter(in)),
+			       NULL,
+			       commandCode,
+			       list, sizeof...(A));
+    }
+
+    /* Command holds the exact size in and out structures for one command */
+
+    template <TPM_CC commandCode>
+    struct Command {
+	typedef CommandTraits<commandCode> Traits;
+	typename Traits::In in;
+	typename Traits::Out out;
+
+	template <typename... A>
+	TPM_RC Execute(TSS_CONTEXT *tssContext, const A &... auths)
+	{
+	    return ibmtss::Execute<commandCode>(tssContext, &out, &in, auths...);
+	}
+    };
+
+    /* Handle owns a transient object or sequence handle and flushes it on destruction */
+
+    class Handle {
+      public:
+	Handle() : tssContext(NULL), handle(TPM_RH_NULL) {}
+	Handle(TSS_CONTEXT *tssContext, TPM_HANDLE handle) :
+	    tssContext(tssContext), handle(handle) {}
+	~Handle()
+	{
+	    Flush();
+	}
+	Handle(Handle &&other) : tssContext(other.tssContext), handle(other.Release()) {}
+	Handle &operator=(Handle &&other)
+	{
+	    if (this != &other) {
+		Flush();
+		tssContext = other.tssContext;
+		handle = other.Release();
+	    }
+	    return *this;
+	}
+	Handle(const Handle &) = delete;
+	Handle &operator=(const Handle &) = delete;
+
+	/* Reset() flushes the current handle and takes ownership of handle */
+
+	void Reset(TSS_CONTEXT *tssContext, TPM_HANDLE handle)
+	{
+	    Flush();
+	    this->tssContext = tssContext;
+	    this->handle = handle;
+	}
+	/* Release() gives up ownership without flushing */
+
+	TPM_HANDLE Release()
+	{
+	    TPM_HANDLE released = handle;
+	    handle = TPM_RH_NULL;
+	    return released;
+	}
+	TPM_RC Flush()
+	{
+	    TPM_RC rc = 0;
+	    if (handle != TPM_RH_NULL) {
+		FlushContext_In in;
+		in.flushHandle = handle;
+		rc = ibmtss::Execute<TPM_CC_FlushContext>(tssContext, NULL, &in);
+		handle = TPM_RH_NULL;
+	    }
+	    return rc;
+	}
+	TPM_HANDLE Get() const
+	{
+	    return handle;
+	}
+	operator TPM_HANDLE() const
+	{
+	    return handle;
+	}
+      protected:
+	TSS_CONTEXT *tssContext;
+	TPM_HANDLE handle;
+    };
+
+    /* Session owns an HMAC, policy, or trial policy session */
+
+    class Session : public Handle {
+      public:
+	Session() {}
+	Session(Session &&other) : Handle(static_cast<Handle &&>(other)) {}
+	Session &operator=(Session &&other)
+	{
+	    Handle::operator=(static_cast<Handle &&>(other));
+	    return *this;
+	}
+
+	/* Start() runs TPM2_StartAuthSession.  tpmKey salts and bind binds the session, either
+	   may be TPM_RH_NULL.  bindPassword is the authorization value of bind. */
+
+	TPM_RC Start(TSS_CONTEXT *tssContext,
+		     TPM_SE sessionType,
+		     TPMI_ALG_HASH authHash,
+		     TPMI_ALG_SYM symmetricAlgorithm = TPM_ALG_NULL,
+		     TPMI_DH_OBJECT tpmKey = TPM_RH_NULL,
+		     TPMI_DH_ENTITY bind = TPM_RH_NULL,
+		     const char *bindPassword = NULL)
+	{
+	    TPM_RC rc;
+	    Command<TPM_CC_StartAuthSession> startAuthSession;
+	    EXTRA_PARAMETERS extra;
+
+	    Flush();
+	    startAuthSession.in.sessionType = sessionType;
+	    startAuthSession.in.tpmKey = tpmKey;
+	    startAuthSession.in.bind = bind;
+	    startAuthSession.in.authHash = authHash;
+	    startAuthSession.in.symmetric.algorithm = symmetricAlgorithm;
+	    if (symmetricAlgorithm != TPM_ALG_NULL) {
+		startAuthSession.in.symmetric.keyBits.aes = 128;
+		startAuthSession.in.symmetric.mode.aes = TPM_ALG_CFB;
+	    }
+	    startAuthSession.in.encryptedSalt.t.size = 0;	/* set by the TSS */
+	    extra.StartAuthSession.bindPassword = bindPassword;
+	    rc = detail::Execute(tssContext,
+				 reinterpret_cast<RESPONSE_PARAMETERS *>(&startAuthSession.out),
+				 reinterpret_cast<COMMAND_PARAMETERS *>(&startAuthSession.in),
+				 &extra,
+				 TPM_CC_StartAuthSession,
+				 NULL, 0);
+	    if (rc == 0) {
+		Reset(tssContext, startAuthSession.out.sessionHandle);
+	    }
+	    return rc;
+	}
+	/* Use() returns the Auth entry for this session.  If continueSession is clear in
+	   sessionAttributes, the session is released after the command succeeds. */
+
+	Auth Use(const char *password = NULL,
+		 unsigned int sessionAttributes = TPMA_SESSION_CONTINUESESSION)
+	{
+	    Auth auth = {handle, password, sessionAttributes, this};
+	    return auth;
+	}
+    };
+
+    inline TPM_RC detail::Execute(TSS_CONTEXT *tssContext,
+				  RESPONSE_PARAMETERS *out,
+				  COMMAND_PARAMETERS *in,
+				  EXTRA_PARAMETERS *extra,
+				  TPM_CC commandCode,
+				  const Auth *auths,
+				  size_t authCount)
+    {
+	TPM_RC rc;
+	size_t i;
+
+	switch (authCount) {
+	  case 0:
+	    rc = TSS_Execute(tssContext, out, in, extra, commandCode,
+			     TPM_RH_NULL, NULL, 0);
+	    break;
+	  case 1:
+	    rc = TSS_Execute(tssContext, out, in, extra, commandCode,
+			     auths[0].sessionHandle, auths[0].password, auths[0].sessionAttributes,
+			     TPM_RH_NULL, NULL, 0);
+	    break;
+	  case 2:
+	    rc = TSS_Execute(tssContext, out, in, extra, commandCode,
+			     auths[0].sessionHandle, auths[0].password, auths[0].sessionAttributes,
+			     auths[1].sessionHandle, auths[1].password, auths[1].sessionAttributes,
+			     TPM_RH_NULL, NULL, 0);
+	    break;
+	  case 3:
+	    rc = TSS_Execute(tssContext, out, in, extra, commandCode,
+			     auths[0].sessionHandle, auths[0].password, auths[0].sessionAttributes,
+			     auths[1].sessionHandle, auths[1].password, auths[1].sessionAttributes,
+			     auths[2].sessionHandle, auths[2].password, auths[2].sessionAttributes,
+			     TPM_RH_NULL, NULL, 0);
+	    break;
+	  default:
+	    rc = TSS_RC_SESSION_NUMBER;
+	}
+	for (i = 0 ; (rc == 0) && (i < authCount) ; i++) {
+	    if ((auths[i].owner != NULL) &&
+		!(auths[i].sessionAttributes & TPMA_SESSION_CONTINUESESSION)) {
+		auths[i].owner->Release();
+	    }
+	}
+	return rc;
+    }
+}
+
+#undef TSS_COMMAND_TRAITS_LIST
+
+#endif
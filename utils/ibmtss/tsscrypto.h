@@ -125,6 +125,11 @@ extern "C" {
     TPM_RC TSS_ECC_Salt(TPM2B_DIGEST 		*salt,
 			TPM2B_ENCRYPTED_SECRET	*encryptedSalt,
 			TPMT_PUBLIC		*publicArea);
+    LIB_EXPORT
+    TPM_RC TSS_ECC_Seed(TPM2B_DIGEST 		*seed,
+			TPM2B_ENCRYPTED_SECRET	*encryptedSeed,
+			TPMT_PUBLIC		*publicArea,
+			const char		*label);
 
 #endif	/* TPM_TSS_NOECC */
 
@@ -165,6 +170,7 @@ extern "C" {
 			   uint32_t *decrypt_length,
 			   const unsigned char *encrypt_data,
 			   uint32_t encrypt_length);
+    LIB_EXPORT
     TPM_RC TSS_AES_EncryptCFB(uint8_t	*dOut,
 			      uint32_t	keySizeInBits,
 			      uint8_t 	*key,
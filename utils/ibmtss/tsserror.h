@@ -109,6 +109,12 @@
 #define TSS_RC_KDFE_FAILED              0x000b0084      /* KDFe function failed */
 #define TSS_RC_EC_EPHEMERAL_FAILURE     0x000b0085      /* Failed while making or using EC ephemeral key */
 #define TSS_RC_FAIL			0x000b0086	/* TSS internal failure */
+#define TSS_RC_PREPARE_UNSUPPORTED	0x000b0087	/* Command cannot be prepared */
+#define TSS_RC_BAD_CREDENTIAL_KEY	0x000b0088	/* Key is unsuitable for a credential */
+#define TSS_RC_BAD_MERKLE_PROOF		0x000b0089	/* Merkle inclusion proof does not verify */
+#define TSS_RC_AUDIT_DIGEST		0x000b008a	/* Session audit digest does not match */
+#define TSS_RC_REPLAY			0x000b008b	/* Replay trace malformed, exhausted, or does not match */
+#define TSS_RC_PREPARE_SIZE		0x000b008c	/* Prepared parameter size does not match the command */
 #define TSS_RC_NO_SESSION_SLOT		0x000b0090	/* TSS context has no session slot for handle */
 #define TSS_RC_NO_OBJECTPUBLIC_SLOT	0x000b0091	/* TSS context has no object public slot for handle */
 #define TSS_RC_NO_NVPUBLIC_SLOT		0x000b0092	/* TSS context has no NV public slot for handle */
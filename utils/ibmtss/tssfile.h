@@ -67,6 +67,10 @@ extern "C" {
     TPM_RC TSS_File_WriteBinaryFile(const unsigned char *data,
 				    size_t length,
 				    const char *filename); 
+    LIB_EXPORT 
+    TPM_RC TSS_File_ReplaceBinaryFile(const unsigned char *data,
+				      size_t length,
+				      const char *filename); 
     
     LIB_EXPORT 
     TPM_RC TSS_File_ReadStructure(void 			*structure,
@@ -82,11 +86,19 @@ extern "C" {
 				   MarshalFunction_t 	marshalFunction,
 				   const char 		*filename);
     LIB_EXPORT 
+    TPM_RC TSS_File_ReplaceStructure(void 			*structure,
+				     MarshalFunction_t 	marshalFunction,
+				     const char 		*filename);
+    LIB_EXPORT 
     TPM_RC TSS_File_Read2B(TPM2B 		*tpm2b,
 			   uint16_t 	targetSize,
 			   const char 	*filename);
     LIB_EXPORT 
     TPM_RC TSS_File_DeleteFile(const char *filename); 
+    LIB_EXPORT 
+    TPM_RC TSS_File_CreateDirectory(const char *dirname); 
+    LIB_EXPORT 
+    TPM_RC TSS_File_RemoveDirectory(const char *dirname); 
     
 #ifdef __cplusplus
 }
@@ -58,6 +58,37 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+
+    /* Transport callbacks.  The signatures match TSS_Transmit(), TSS_TransmitPlatform(),
+       TSS_TransmitCommand(), and TSS_Close().  A callback can get its private data using
+       TSS_GetTransportContext().  A transmit callback may always write MAX_RESPONSE_SIZE
+       response bytes, and for TSS_Execute() up to the TSS_GetBufferSize() response size. */
+
+    typedef TPM_RC (*TSS_TransmitFunction_t)(TSS_CONTEXT *tssContext,
+					     uint8_t *responseBuffer, uint32_t *read,
+					     const uint8_t *commandBuffer, uint32_t written,
+					     const char *message);
+    typedef TPM_RC (*TSS_TransmitAdminFunction_t)(TSS_CONTEXT *tssContext,
+						  uint32_t command, const char *message);
+    typedef TPM_RC (*TSS_CloseFunction_t)(TSS_CONTEXT *tssContext);
+
+    typedef struct TSS_TRANSPORT {
+	TSS_TransmitFunction_t		transmit;		/* required */
+	TSS_TransmitAdminFunction_t	transmitPlatform;	/* optional, platform port */
+	TSS_TransmitAdminFunction_t	transmitCommand;	/* optional, command port */
+	TSS_CloseFunction_t		close;			/* optional */
+    } TSS_TRANSPORT;
+
+    LIB_EXPORT TPM_RC
+    TSS_SetTransport(TSS_CONTEXT *tssContext,
+		     const TSS_TRANSPORT *transport,
+		     void *transportContext);
+    LIB_EXPORT void *
+    TSS_GetTransportContext(TSS_CONTEXT *tssContext);
+    LIB_EXPORT TPM_RC
+    TSS_GetTransmitTime(TSS_CONTEXT *tssContext,
+			uint64_t *transmitNsec);
+
     LIB_EXPORT TPM_RC
     TSS_TransmitPlatform(TSS_CONTEXT *tssContext,
 			 uint32_t command, const char *message);
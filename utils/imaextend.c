@@ -78,6 +78,7 @@
 #include <ibmtss/tssresponsecode.h>
 #include <ibmtss/tsscryptoh.h>
 #include <ibmtss/tssutils.h>
+#include <ibmtss/tssmarshal.h>
 
 #include "imalib.h"
 
@@ -94,16 +95,20 @@ static TPM_RC pcrread(TSS_CONTEXT *tssContext,
 		      PCR_Read_Out *pcrReadOut,
 		      PCR_Read_In *pcrReadIn,
 		      TPMI_DH_PCR pcrHandle);
+static TPM_RC pcrExtend(TSS_CONTEXT *tssContext,
+			TSS_PREPARED **pcrExtendPrepared,
+			PCR_Extend_In *pcrExtendIn);
 static void printUsage(void);
 
 extern int tssUtilsVerbose;
-int vverbose = FALSE;
+static int vverbose = FALSE;
 
 int main(int argc, char * argv[])
 {
     TPM_RC 		rc = 0;
     int 		i = 0;
     TSS_CONTEXT		*tssContext = NULL;
+    TSS_PREPARED	*pcrExtendPrepared = NULL;	/* PCR_Extend, marshaled once */
     PCR_Extend_In 	pcrExtendIn;
     PCR_Read_In 	pcrReadIn;
     PCR_Read_Out 	pcrReadOut;
@@ -389,13 +394,7 @@ int main(int argc, char * argv[])
 		}
 		if (!sim) {	/* extend into TPM PCRs */
 		    if (rc == 0) {
-			rc = TSS_Execute(tssContext,
-					 NULL, 
-					 (COMMAND_PARAMETERS *)&pcrExtendIn,
-					 NULL,
-					 TPM_CC_PCR_Extend,
-					 TPM_RS_PW, NULL, 0,
-					 TPM_RH_NULL, NULL, 0);
+			rc = pcrExtend(tssContext, &pcrExtendPrepared, &pcrExtendIn);
 		    }
 		    if (rc == 0 && tssUtilsVerbose) {	/* debug reace PCR result */
 			rc = pcrread(tssContext, &pcrReadOut, &pcrReadIn, imaEvent.pcrIndex);
@@ -435,6 +434,7 @@ int main(int argc, char * argv[])
 				 pcrReadOut.pcrValues.digests[count].t.buffer,
 				 pcrReadOut.pcrValues.digests[count].t.size);
 	}
+	TSS_PreparedDelete(pcrExtendPrepared);
 	{
 	    TPM_RC rc1 = TSS_Delete(tssContext);		/* close the TPM connection */
 	    if (rc == 0) {
@@ -609,6 +609,48 @@ static TPM_RC extendDigest(TPMT_HA 		simPcrs[][IMPLEMENTATION_PCR],
     return rc;
 }
 
+/* pcrExtend() extends the TPM PCR.
+
+   The bank algorithms are the same for every event, so the PCR_Extend command is marshaled once
+   at the first event.  Later events only patch the PCR handle and the digests.
+*/
+
+static TPM_RC pcrExtend(TSS_CONTEXT *tssContext,
+			TSS_PREPARED **pcrExtendPrepared,
+			PCR_Extend_In *pcrExtendIn)
+{
+    TPM_RC 		rc = 0;
+    uint8_t 		digestsBuffer[sizeof(TPML_DIGEST_VALUES)];
+    uint8_t 		*buffer = digestsBuffer;
+    uint32_t 		size = sizeof(digestsBuffer);
+    uint16_t 		written = 0;
+
+    if (*pcrExtendPrepared == NULL) {
+	rc = TSS_Prepare(tssContext, pcrExtendPrepared,
+			 (COMMAND_PARAMETERS *)pcrExtendIn,
+			 TPM_CC_PCR_Extend);
+    }
+    else {
+	if (rc == 0) {
+	    rc = TSS_PreparedSetHandle(*pcrExtendPrepared, 0, pcrExtendIn->pcrHandle);
+	}
+	if (rc == 0) {
+	    rc = TSS_TPML_DIGEST_VALUES_Marshalu(&pcrExtendIn->digests, &written, &buffer, &size);
+	}
+	if (rc == 0) {
+	    rc = TSS_PreparedSetParameter(*pcrExtendPrepared, 0, digestsBuffer, written);
+	}
+    }
+    if (rc == 0) {
+	rc = TSS_ExecutePrepared(tssContext,
+				 NULL,
+				 *pcrExtendPrepared,
+				 TPM_RS_PW, NULL, 0,
+				 TPM_RH_NULL, NULL, 0);
+    }
+    return rc;
+}
+
 /* for debug, read back and trace the PCR value before and after the extend */
 
 static TPM_RC pcrread(TSS_CONTEXT *tssContext,
@@ -0,0 +1,281 @@
+/********************************************************************************/
+/*										*/
+/*			      IncrementalSelfTest				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* 
+   incrementalselftest runs TPM2_IncrementalSelfTest for the algorithms an application will use,
+   so that the first command after TPM2_Startup does not stall or return TPM_RC_TESTING.
+
+   With no -alg, it returns the TPM toDoList.
+
+   Otherwise, it tests the algorithms in batches of -bs, sleeping -idle msec between steps, until
+   all are tested.  Algorithms that the TPM does not implement are reported as unsupported, not
+   tested.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tssresponsecode.h>
+
+#include "selftestlib.h"
+
+static void printUsage(void);
+static TPM_RC getAlgorithm(TPM_ALG_ID *algorithm, const char *string);
+
+extern int tssUtilsVerbose;
+
+/* algorithm names accepted by -alg */
+
+typedef struct {
+    const char	*name;
+    TPM_ALG_ID	algorithm;
+} ALG_NAME;
+
+static const ALG_NAME algNames[] = {
+    {"rsa",		TPM_ALG_RSA},
+    {"sha1",		TPM_ALG_SHA1},
+    {"hmac",		TPM_ALG_HMAC},
+    {"aes",		TPM_ALG_AES},
+    {"mgf1",		TPM_ALG_MGF1},
+    {"keyedhash",	TPM_ALG_KEYEDHASH},
+    {"xor",		TPM_ALG_XOR},
+    {"sha256",		TPM_ALG_SHA256},
+    {"sha384",		TPM_ALG_SHA384},
+    {"sha512",		TPM_ALG_SHA512},
+    {"sm3",		TPM_ALG_SM3_256},
+    {"rsassa",		TPM_ALG_RSASSA},
+    {"rsaes",		TPM_ALG_RSAES},
+    {"rsapss",		TPM_ALG_RSAPSS},
+    {"oaep",		TPM_ALG_OAEP},
+    {"ecdsa",		TPM_ALG_ECDSA},
+    {"ecdh",		TPM_ALG_ECDH},
+    {"ecdaa",		TPM_ALG_ECDAA},
+    {"sm2",		TPM_ALG_SM2},
+    {"ecschnorr",	TPM_ALG_ECSCHNORR},
+    {"kdf1_56a",	TPM_ALG_KDF1_SP800_56A},
+    {"kdf1_108",	TPM_ALG_KDF1_SP800_108},
+    {"ecc",		TPM_ALG_ECC},
+    {"symcipher",	TPM_ALG_SYMCIPHER},
+    {"ctr",		TPM_ALG_CTR},
+    {"ofb",		TPM_ALG_OFB},
+    {"cbc",		TPM_ALG_CBC},
+    {"cfb",		TPM_ALG_CFB},
+    {"ecb",		TPM_ALG_ECB}
+};
+
+int main(int argc, char *argv[])
+{
+    TPM_RC			rc = 0;
+    int				i;    /* argc iterator */
+    TSS_CONTEXT			*tssContext = NULL;
+    SELFTEST_SCHEDULE		schedule;
+    TPM_ALG_ID			algorithm;
+    int				algCount = 0;
+    uint32_t			batchSize = 0;		/* default all at once */
+    uint32_t			idleMsec = 100;
+    uint32_t			maxSteps = 0;		/* default until done */
+
+    setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
+    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "1");
+    tssUtilsVerbose = FALSE;
+
+    selfTestScheduleInit(&schedule);
+    /* command line argument defaults */
+    for (i=1 ; (i<argc) && (rc == 0) ; i++) {
+	if (strcmp(argv[i],"-alg") == 0) {
+	    i++;
+	    if (i < argc) {
+		rc = getAlgorithm(&algorithm, argv[i]);
+		if (rc == 0) {
+		    rc = selfTestScheduleAddAlg(&schedule, algorithm);
+		    algCount++;
+		}
+		else {
+		    printf("Bad parameter %s for -alg\n", argv[i]);
+		    printUsage();
+		}
+	    }
+	    else {
+		printf("Missing parameter for -alg\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-bs") == 0) {
+	    i++;
+	    if (i < argc) {
+		sscanf(argv[i],"%u", &batchSize);
+	    }
+	    else {
+		printf("Missing parameter for -bs\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-idle") == 0) {
+	    i++;
+	    if (i < argc) {
+		sscanf(argv[i],"%u", &idleMsec);
+	    }
+	    else {
+		printf("Missing parameter for -idle\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-steps") == 0) {
+	    i++;
+	    if (i < argc) {
+		sscanf(argv[i],"%u", &maxSteps);
+	    }
+	    else {
+		printf("Missing parameter for -steps\n");
+		printUsage();
+	    }
+	}
+ 	else if (strcmp(argv[i],"-h") == 0) {
+	    printUsage();
+	}
+	else if (strcmp(argv[i],"-v") == 0) {
+	    tssUtilsVerbose = TRUE;
+	    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "2");
+	}
+	else {
+	    printf("\n%s is not a valid option\n", argv[i]);
+	    printUsage();
+	}
+    }
+    /* Start a TSS context */
+    if (rc == 0) {
+	rc = TSS_Create(&tssContext);
+    }
+    if (rc == 0) {
+	/* no algorithms, just report the toDoList */
+	if (algCount == 0) {
+	    rc = selfTestGetToDoList(tssContext, &schedule);
+	}
+	else {
+	    rc = selfTestScheduleRun(tssContext, &schedule, batchSize, idleMsec, maxSteps);
+	}
+    }
+    {
+	TPM_RC rc1 = TSS_Delete(tssContext);
+	if (rc == 0) {
+	    rc = rc1;
+	}
+    }
+    if (rc == 0) {
+	printf("toDoList\n");
+	TSS_TPML_ALG_Print(&schedule.toDoList, 2);
+	if (algCount != 0) {
+	    printf("tested\n");
+	    TSS_TPML_ALG_Print(&schedule.tested, 2);
+	    if (schedule.unsupported.count != 0) {
+		printf("unsupported\n");
+		TSS_TPML_ALG_Print(&schedule.unsupported, 2);
+	    }
+	    printf("incrementalselftest: %u commands, %s\n",
+		   schedule.commandCount, schedule.complete ? "complete" : "incomplete");
+	}
+	if (tssUtilsVerbose) printf("incrementalselftest: success\n");
+    }
+    else {
+	const char *msg;
+	const char *submsg;
+	const char *num;
+	printf("incrementalselftest: failed, rc %08x\n", rc);
+	TSS_ResponseCode_toString(&msg, &submsg, &num, rc);
+	printf("%s%s%s\n", msg, submsg, num);
+	rc = EXIT_FAILURE;
+    }
+    return rc;
+}
+
+/* getAlgorithm() converts an algorithm name or a hex algorithm ID to a TPM_ALG_ID */
+
+static TPM_RC getAlgorithm(TPM_ALG_ID *algorithm, const char *string)
+{
+    TPM_RC		rc = 0;
+    size_t		i;
+    unsigned int	tmp;
+    int			irc;
+
+    for (i = 0 ; i < (sizeof(algNames) / sizeof(ALG_NAME)) ; i++) {
+	if (strcmp(string, algNames[i].name) == 0) {
+	    *algorithm = algNames[i].algorithm;
+	    return rc;
+	}
+    }
+    irc = sscanf(string, "%x", &tmp);
+    if ((irc != 1) || (tmp > 0xffff)) {
+	rc = TSS_RC_BAD_PROPERTY_VALUE;
+    }
+    else {
+	*algorithm = (TPM_ALG_ID)tmp;
+    }
+    return rc;
+}
+
+static void printUsage(void)
+{
+    size_t i;
+    printf("\n");
+    printf("incrementalselftest\n");
+    printf("\n");
+    printf("Runs TPM2_IncrementalSelfTest\n");
+    printf("\n");
+    printf("With no -alg, returns the TPM toDoList.\n");
+    printf("Otherwise tests the algorithms in batches until all are tested.\n");
+    printf("Algorithms that the TPM does not implement are listed as unsupported.\n");
+    printf("\n");
+    printf("\t[-alg\talgorithm to test, name or hex ID, may be repeated]\n");
+    printf("\t[-bs\talgorithms per TPM2_IncrementalSelfTest (default all)]\n");
+    printf("\t[-idle\tmsec to wait between steps (default 100)]\n");
+    printf("\t[-steps\tmaximum number of steps (default until done)]\n");
+    printf("\n");
+    printf("\talgorithm names:");
+    for (i = 0 ; i < (sizeof(algNames) / sizeof(ALG_NAME)) ; i++) {
+	if ((i % 8) == 0) {
+	    printf("\n\t");
+	}
+	printf(" %s", algNames[i].name);
+    }
+    printf("\n");
+    exit(1);	
+}
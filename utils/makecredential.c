@@ -49,6 +49,9 @@
 #include <ibmtss/tssutils.h>
 #include <ibmtss/tssresponsecode.h>
 #include <ibmtss/tssmarshal.h>
+#include <ibmtss/Unmarshal_fp.h>
+
+#include "credentiallib.h"
 
 static void printUsage(void);
 
@@ -63,6 +66,9 @@ int main(int argc, char *argv[])
     MakeCredential_Out 		out;
     TPMI_DH_OBJECT		pubHandle = 0;
     const char			*inputCredentialFilename = NULL;
+    const char			*publicKeyFilename = NULL;
+    TPM2B_PUBLIC 		inPublic;
+    CREDENTIAL_KEY		credentialKey;
     const char			*nameFilename = NULL;			
     const char			*outputCredentialFilename = NULL;
     const char			*secretFilename = NULL;
@@ -118,6 +124,16 @@ int main(int argc, char *argv[])
 		printUsage();
 	    }
 	}
+	else if (strcmp(argv[i],"-ipu") == 0) {
+	    i++;
+	    if (i < argc) {
+		publicKeyFilename = argv[i];
+	    }
+	    else {
+		printf("-ipu option needs a value\n");
+		printUsage();
+	    }
+	}
 	else if (strcmp(argv[i],"-ha") == 0) {
 	    i++;
 	    if (i < argc) {
@@ -206,8 +222,12 @@ int main(int argc, char *argv[])
 	    printUsage();
 	}
     }
-    if (pubHandle == 0) {
-	printf("Missing handle parameter -ha\n");
+    if ((pubHandle == 0) && (publicKeyFilename == NULL)) {
+	printf("Missing handle parameter -ha or public key parameter -ipu\n");
+	printUsage();
+    }
+    if ((pubHandle != 0) && (publicKeyFilename != NULL)) {
+	printf("-ha and -ipu are mutually exclusive\n");
 	printUsage();
     }
     if (inputCredentialFilename == NULL) {
@@ -233,12 +253,29 @@ int main(int argc, char *argv[])
 			     sizeof(in.objectName.t.name),
 			     nameFilename);
     }
+    /* software MakeCredential, no TPM */
+    if ((rc == 0) && (publicKeyFilename != NULL)) {
+	rc = TSS_File_ReadStructureFlag(&inPublic,
+					(UnmarshalFunctionFlag_t)TSS_TPM2B_PUBLIC_Unmarshalu,
+					FALSE,			/* NULL not permitted */
+					publicKeyFilename);
+	if (rc == 0) {
+	    rc = credentialKeyLoad(&credentialKey, &inPublic.publicArea);
+	}
+	if (rc == 0) {
+	    rc = credentialMake(&out.credentialBlob,
+				&out.secret,
+				&credentialKey,
+				&in.credential,
+				&in.objectName);
+	}
+    }
     /* Start a TSS context */
-    if (rc == 0) {
+    if ((rc == 0) && (publicKeyFilename == NULL)) {
 	rc = TSS_Create(&tssContext);
     }
     /* call TSS to execute the command */
-    if (rc == 0) {
+    if ((rc == 0) && (publicKeyFilename == NULL)) {
 	rc = TSS_Execute(tssContext,
 			 (RESPONSE_PARAMETERS *)&out,
 			 (COMMAND_PARAMETERS *)&in,
@@ -290,6 +327,9 @@ static void printUsage(void)
     printf("Runs TPM2_MakeCredential\n");
     printf("\n");
     printf("\t-ha\thandle of encryption key public area\n");
+    printf("\t\tor\n");
+    printf("\t-ipu\tencryption key public area file name\n");
+    printf("\t\tcalculates the credential in software, without a TPM\n");
     printf("\t-icred\tinput credential file name\n");
     printf("\t-in\tobject name file name\n");
     printf("\t[-ocred\t output credential file name (default do not save)]\n");
@@ -242,6 +242,42 @@ signapp.exe:	signapp.o ekutils.o cryptoutils.o $(LIBTSS)
 writeapp.exe:	writeapp.o ekutils.o cryptoutils.o $(LIBTSS)
 		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o ekutils.o cryptoutils.o $(LNLIBS) $(LIBTSS)
 
+getrandom.exe:	getrandom.o randomlib.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o randomlib.o $(LNLIBS) $(LIBTSS)
+
+hash.exe:	hash.o sequencelib.o cryptoutils.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o sequencelib.o cryptoutils.o $(LNLIBS) $(LIBTSS)
+
+hmac.exe:	hmac.o sequencelib.o cryptoutils.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o sequencelib.o cryptoutils.o $(LNLIBS) $(LIBTSS)
+
+makecredential.exe:	makecredential.o credentiallib.o cryptoutils.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o credentiallib.o cryptoutils.o $(LNLIBS) $(LIBTSS)
+
+incrementalselftest.exe:	incrementalselftest.o selftestlib.o cryptoutils.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o selftestlib.o cryptoutils.o $(LNLIBS) $(LIBTSS)
+
+verifyattest.exe:	verifyattest.o attestlib.o merklelib.o cryptoutils.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o attestlib.o merklelib.o cryptoutils.o $(LNLIBS) $(LIBTSS)
+
+quote.exe:	quote.o attestlib.o merklelib.o cryptoutils.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o attestlib.o merklelib.o cryptoutils.o $(LNLIBS) $(LIBTSS)
+
+policycalc.exe:	policycalc.o policylib.o cryptoutils.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o policylib.o cryptoutils.o $(LNLIBS) $(LIBTSS)
+
+tpmbench.exe:	tpmbench.o objecttemplates.o cryptoutils.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o objecttemplates.o cryptoutils.o $(LNLIBS) $(LIBTSS)
+
+tssbench.exe:	tssbench.o eventlib.o efilib.o imalib.o cryptoutils.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o eventlib.o efilib.o imalib.o cryptoutils.o $(LNLIBS) $(LIBTSS)
+
+sign.exe:	sign.o cryptoutils.o merklelib.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o cryptoutils.o merklelib.o $(LNLIBS) $(LIBTSS)
+
+verifysignature.exe:	verifysignature.o cryptoutils.o merklelib.o $(LIBTSS)
+		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o cryptoutils.o merklelib.o $(LNLIBS) $(LIBTSS)
+
 %.exe:		%.o applink.o cryptoutils.o $(LIBTSS)
 		$(CC) $(LNFLAGS) -L. -libmtss $< -o $@ applink.o cryptoutils.o $(LNLIBS) $(LIBTSS)
 
@@ -0,0 +1,491 @@
+/********************************************************************************/
+/*										*/
+/*			      Merkle Tree Batching				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Merkle tree batching.  See merklelib.h. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tsscryptoh.h>
+#include <ibmtss/tssmarshal.h>
+#include <ibmtss/Unmarshal_fp.h>
+
+#include "merklelib.h"
+
+extern int tssUtilsVerbose;
+
+static TPM_RC merkleHashLeaf(uint8_t *digest,
+			     TPMI_ALG_HASH halg,
+			     const TPM2B_DIGEST *leaf);
+static TPM_RC merkleHashNode(uint8_t *digest,
+			     TPMI_ALG_HASH halg,
+			     const uint8_t *left,
+			     const uint8_t *right);
+
+/* merkleTreeCreate() hashes leafCount leaves with halg into a tree.
+
+   The caller frees the tree with merkleTreeDelete().
+*/
+
+TPM_RC merkleTreeCreate(MERKLE_TREE **tree,		/* freed by caller */
+			TPMI_ALG_HASH halg,
+			uint32_t leafCount,
+			const TPM2B_DIGEST *leaves)
+{
+    TPM_RC	rc = 0;
+    uint32_t	count;		/* nodes in the current level */
+    uint32_t	level;
+    uint32_t	i;
+
+    if (rc == 0) {
+	*tree = NULL;
+	if (leafCount == 0) {
+	    if (tssUtilsVerbose) printf("merkleTreeCreate: Error, no leaves\n");
+	    rc = TSS_RC_BAD_MERKLE_PROOF;
+	}
+    }
+    if (rc == 0) {
+	*tree = calloc(1, sizeof(MERKLE_TREE));
+	if (*tree == NULL) {
+	    if (tssUtilsVerbose) printf("merkleTreeCreate: Error allocating tree\n");
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if (rc == 0) {
+	(*tree)->halg = halg;
+	(*tree)->digestSize = TSS_GetDigestSize(halg);
+	(*tree)->leafCount = leafCount;
+	if ((*tree)->digestSize == 0) {
+	    if (tssUtilsVerbose) printf("merkleTreeCreate: Error, bad hash algorithm %04x\n",
+					halg);
+	    rc = TSS_RC_BAD_HASH_ALGORITHM;
+	}
+    }
+    /* lay out the levels, each (count + 1) / 2 nodes above the one below */
+    if (rc == 0) {
+	count = leafCount;
+	for (level = 0 ; ; level++) {
+	    (*tree)->levelStart[level] = (*tree)->nodeCount;
+	    (*tree)->nodeCount += count;
+	    if (count == 1) {
+		break;
+	    }
+	    count = (count / 2) + (count % 2);
+	}
+	(*tree)->levelCount = level + 1;
+    }
+    if (rc == 0) {
+	/* not TSS_Malloc(), a large batch can exceed its size limit */
+	(*tree)->nodes = malloc((size_t)(*tree)->nodeCount * (*tree)->digestSize);
+	if ((*tree)->nodes == NULL) {
+	    if (tssUtilsVerbose) printf("merkleTreeCreate: Error allocating %u nodes\n",
+					(*tree)->nodeCount);
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    /* hash the leaves */
+    for (i = 0 ; (rc == 0) && (i < leafCount) ; i++) {
+	rc = merkleHashLeaf((*tree)->nodes + ((size_t)i * (*tree)->digestSize),
+			    halg, &leaves[i]);
+    }
+    /* hash each level into the one above */
+    for (level = 1 ; (rc == 0) && (level < (*tree)->levelCount) ; level++) {
+	uint16_t digestSize = (*tree)->digestSize;
+	uint8_t *below = (*tree)->nodes + ((size_t)(*tree)->levelStart[level-1] * digestSize);
+	uint8_t *above = (*tree)->nodes + ((size_t)(*tree)->levelStart[level] * digestSize);
+	count = (*tree)->levelStart[level] - (*tree)->levelStart[level-1];
+	for (i = 0 ; (rc == 0) && (i < count) ; i += 2) {
+	    if ((i + 1) < count) {
+		rc = merkleHashNode(above + ((size_t)(i/2) * digestSize), halg,
+				    below + ((size_t)i * digestSize),
+				    below + ((size_t)(i+1) * digestSize));
+	    }
+	    else {	/* no sibling, move up unchanged */
+		memcpy(above + ((size_t)(i/2) * digestSize),
+		       below + ((size_t)i * digestSize), digestSize);
+	    }
+	}
+    }
+    if ((rc != 0) && (*tree != NULL)) {
+	merkleTreeDelete(*tree);
+	*tree = NULL;
+    }
+    return rc;
+}
+
+/* merkleTreeDelete() frees a tree created by merkleTreeCreate().  NULL is ignored. */
+
+void merkleTreeDelete(MERKLE_TREE *tree)
+{
+    if (tree != NULL) {
+	free(tree->nodes);
+	free(tree);
+    }
+    return;
+}
+
+/* merkleTreeRoot() returns the root digest, the value for the TPM to sign */
+
+TPM_RC merkleTreeRoot(TPM2B_DIGEST *root,
+		      const MERKLE_TREE *tree)
+{
+    TPM_RC	rc = 0;
+
+    if (rc == 0) {
+	rc = TSS_TPM2B_Create(&root->b,
+			      tree->nodes + ((size_t)(tree->nodeCount - 1) * tree->digestSize),
+			      tree->digestSize, sizeof(root->t.buffer));
+    }
+    return rc;
+}
+
+/* merkleProofGet() returns the inclusion proof for the leaf at leafIndex */
+
+TPM_RC merkleProofGet(MERKLE_PROOF *proof,
+		      const MERKLE_TREE *tree,
+		      uint32_t leafIndex)
+{
+    TPM_RC	rc = 0;
+    uint32_t	index = leafIndex;	/* node index within the level */
+    uint32_t	count;			/* nodes in the level */
+    uint32_t	level;
+
+    if (rc == 0) {
+	if (leafIndex >= tree->leafCount) {
+	    if (tssUtilsVerbose) printf("merkleProofGet: Error, leaf %u of %u\n",
+					leafIndex, tree->leafCount);
+	    rc = TSS_RC_BAD_MERKLE_PROOF;
+	}
+    }
+    if (rc == 0) {
+	proof->halg = tree->halg;
+	proof->leafIndex = leafIndex;
+	proof->leafCount = tree->leafCount;
+	proof->pathCount = 0;
+	count = tree->leafCount;
+	for (level = 0 ; count > 1 ; level++) {
+	    uint32_t sibling = index ^ 1;
+	    if (sibling < count) {
+		memcpy((uint8_t *)&proof->path[proof->pathCount],
+		       tree->nodes + ((size_t)(tree->levelStart[level] + sibling) * tree->digestSize),
+		       tree->digestSize);
+		proof->pathCount++;
+	    }
+	    index /= 2;
+	    count = (count / 2) + (count % 2);
+	}
+    }
+    return rc;
+}
+
+/* merkleProofRoot() recomputes the root from a leaf value and its inclusion proof */
+
+TPM_RC merkleProofRoot(TPM2B_DIGEST *root,
+		       const TPM2B_DIGEST *leaf,
+		       const MERKLE_PROOF *proof)
+{
+    TPM_RC	rc = 0;
+    uint16_t	digestSize = TSS_GetDigestSize(proof->halg);
+    uint8_t	digest[sizeof(TPMU_HA)];
+    uint32_t	index = proof->leafIndex;
+    uint32_t	count = proof->leafCount;
+    uint32_t	pathIndex = 0;
+
+    if (rc == 0) {
+	if ((digestSize == 0) ||
+	    (proof->leafIndex >= proof->leafCount) ||
+	    (proof->pathCount > MERKLE_DEPTH_MAX)) {
+	    if (tssUtilsVerbose) printf("merkleProofRoot: Error, malformed proof\n");
+	    rc = TSS_RC_BAD_MERKLE_PROOF;
+	}
+    }
+    if (rc == 0) {
+	rc = merkleHashLeaf(digest, proof->halg, leaf);
+    }
+    while ((rc == 0) && (count > 1)) {
+	if ((index % 2) == 1) {		/* sibling on the left */
+	    if (pathIndex < proof->pathCount) {
+		rc = merkleHashNode(digest, proof->halg,
+				    (const uint8_t *)&proof->path[pathIndex], digest);
+	    }
+	    pathIndex++;
+	}
+	else if ((index + 1) < count) {	/* sibling on the right */
+	    if (pathIndex < proof->pathCount) {
+		rc = merkleHashNode(digest, proof->halg,
+				    digest, (const uint8_t *)&proof->path[pathIndex]);
+	    }
+	    pathIndex++;
+	}
+	/* else no sibling, move up unchanged */
+	index /= 2;
+	count = (count / 2) + (count % 2);
+    }
+    /* the proof must have exactly one digest per level with a sibling */
+    if (rc == 0) {
+	if (pathIndex != proof->pathCount) {
+	    if (tssUtilsVerbose) printf("merkleProofRoot: Error, path length %u expected %u\n",
+					proof->pathCount, pathIndex);
+	    rc = TSS_RC_BAD_MERKLE_PROOF;
+	}
+    }
+    if (rc == 0) {
+	rc = TSS_TPM2B_Create(&root->b, digest, digestSize, sizeof(root->t.buffer));
+    }
+    return rc;
+}
+
+/* merkleProofVerify() checks that leaf is included in the tree with root.
+
+   root is typically the extraData of a TPMS_ATTEST or the digest that the TPM signed.
+*/
+
+TPM_RC merkleProofVerify(const TPM2B *root,
+			 const TPM2B_DIGEST *leaf,
+			 const MERKLE_PROOF *proof)
+{
+    TPM_RC		rc = 0;
+    TPM2B_DIGEST	computedRoot;
+
+    if (rc == 0) {
+	rc = merkleProofRoot(&computedRoot, leaf, proof);
+    }
+    if (rc == 0) {
+	if (!TSS_TPM2B_Compare(&computedRoot.b, (TPM2B *)root)) {
+	    if (tssUtilsVerbose) printf("merkleProofVerify: Error, root mismatch\n");
+	    rc = TSS_RC_BAD_MERKLE_PROOF;
+	}
+    }
+    return rc;
+}
+
+/* merkleProofMarshal() marshals a MERKLE_PROOF.  It is a MarshalFunction_t for
+   TSS_File_WriteStructure().
+
+   halg, leafIndex, leafCount, pathCount, then pathCount digests of the halg size
+*/
+
+TPM_RC merkleProofMarshal(void *source,
+			  uint16_t *written,
+			  uint8_t **buffer,
+			  uint32_t *size)
+{
+    TPM_RC		rc = 0;
+    MERKLE_PROOF	*proof = (MERKLE_PROOF *)source;
+    uint16_t		digestSize = TSS_GetDigestSize(proof->halg);
+    uint32_t		i;
+
+    if (rc == 0) {
+	rc = TSS_UINT16_Marshalu(&proof->halg, written, buffer, size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(&proof->leafIndex, written, buffer, size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(&proof->leafCount, written, buffer, size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(&proof->pathCount, written, buffer, size);
+    }
+    for (i = 0 ; (rc == 0) && (i < proof->pathCount) ; i++) {
+	rc = TSS_Array_Marshalu((uint8_t *)&proof->path[i], digestSize, written, buffer, size);
+    }
+    return rc;
+}
+
+/* merkleProofUnmarshal() unmarshals a MERKLE_PROOF.  It is an UnmarshalFunction_t for
+   TSS_File_ReadStructure(). */
+
+TPM_RC merkleProofUnmarshal(void *target,
+			    uint8_t **buffer,
+			    uint32_t *size)
+{
+    TPM_RC		rc = 0;
+    MERKLE_PROOF	*proof = (MERKLE_PROOF *)target;
+    uint16_t		digestSize = 0;
+    uint32_t		i;
+
+    if (rc == 0) {
+	rc = TSS_TPMI_ALG_HASH_Unmarshalu(&proof->halg, buffer, size, NO);
+    }
+    if (rc == 0) {
+	digestSize = TSS_GetDigestSize(proof->halg);
+	rc = TSS_UINT32_Unmarshalu(&proof->leafIndex, buffer, size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Unmarshalu(&proof->leafCount, buffer, size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Unmarshalu(&proof->pathCount, buffer, size);
+    }
+    if (rc == 0) {
+	if (proof->pathCount > MERKLE_DEPTH_MAX) {
+	    rc = TSS_RC_BAD_MERKLE_PROOF;
+	}
+    }
+    for (i = 0 ; (rc == 0) && (i < proof->pathCount) ; i++) {
+	rc = TSS_Array_Unmarshalu((uint8_t *)&proof->path[i], digestSize, buffer, size);
+    }
+    return rc;
+}
+
+#ifndef TPM_TSS_NOFILE
+
+/* merkleProofWriteFiles() writes the inclusion proof for leaf n to proofFilenamePrefix followed by
+   n and .bin */
+
+TPM_RC merkleProofWriteFiles(const MERKLE_TREE *tree,
+			     const char *proofFilenamePrefix)
+{
+    TPM_RC		rc = 0;
+    uint32_t		n;
+    MERKLE_PROOF	proof;
+    char		proofFilename[4096];
+
+    for (n = 0 ; (rc == 0) && (n < tree->leafCount) ; n++) {
+	rc = merkleProofGet(&proof, tree, n);
+	if (rc == 0) {
+	    snprintf(proofFilename, sizeof(proofFilename), "%s%u.bin", proofFilenamePrefix, n);
+	    rc = TSS_File_WriteStructure(&proof,
+					 (MarshalFunction_t)merkleProofMarshal,
+					 proofFilename);
+	}
+    }
+    return rc;
+}
+
+#endif	/* TPM_TSS_NOFILE */
+
+/* merkleSignBatch() signs digestCount digests with one TPM2_Sign.
+
+   The digests are hashed into a Merkle tree with the hash algorithm of in->inScheme, and the TPM
+   signs the root.  in supplies the key handle, scheme, and validation ticket.  in->digest is set
+   here.
+
+   The signature over digest n is out->signature plus merkleProofGet() for index n.  The caller
+   frees the tree with merkleTreeDelete().
+*/
+
+TPM_RC merkleSignBatch(TSS_CONTEXT *tssContext,
+		       Sign_Out *out,
+		       MERKLE_TREE **tree,		/* freed by caller */
+		       Sign_In *in,
+		       uint32_t digestCount,
+		       const TPM2B_DIGEST *digests,
+		       TPMI_SH_AUTH_SESSION sessionHandle,
+		       const char *keyPassword,
+		       unsigned int sessionAttributes)
+{
+    TPM_RC		rc = 0;
+
+    if (rc == 0) {
+	/* all TPMU_SIG_SCHEME members start with the hash algorithm */
+	rc = merkleTreeCreate(tree, in->inScheme.details.any.hashAlg, digestCount, digests);
+    }
+    if (rc == 0) {
+	rc = merkleTreeRoot(&in->digest, *tree);
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("merkleSignBatch: signing %u digests\n", digestCount);
+	rc = TSS_Execute(tssContext,
+			 (RESPONSE_PARAMETERS *)out,
+			 (COMMAND_PARAMETERS *)in,
+			 NULL,
+			 TPM_CC_Sign,
+			 sessionHandle, keyPassword, sessionAttributes,
+			 TPM_RH_NULL, NULL, 0);
+    }
+    if ((rc != 0) && (*tree != NULL)) {
+	merkleTreeDelete(*tree);
+	*tree = NULL;
+    }
+    return rc;
+}
+
+/* merkleHashLeaf() is H(0x00 || leaf) */
+
+static TPM_RC merkleHashLeaf(uint8_t *digest,
+			     TPMI_ALG_HASH halg,
+			     const TPM2B_DIGEST *leaf)
+{
+    TPM_RC	rc = 0;
+    TPMT_HA	ha;
+    uint8_t	prefix = 0x00;
+
+    if (rc == 0) {
+	ha.hashAlg = halg;
+	rc = TSS_Hash_Generate(&ha,
+			       sizeof(prefix), &prefix,
+			       leaf->t.size, leaf->t.buffer,
+			       0, NULL);
+    }
+    if (rc == 0) {
+	memcpy(digest, (uint8_t *)&ha.digest, TSS_GetDigestSize(halg));
+    }
+    return rc;
+}
+
+/* merkleHashNode() is H(0x01 || left || right).  digest may be the same as left or right. */
+
+static TPM_RC merkleHashNode(uint8_t *digest,
+			     TPMI_ALG_HASH halg,
+			     const uint8_t *left,
+			     const uint8_t *right)
+{
+    TPM_RC	rc = 0;
+    TPMT_HA	ha;
+    uint8_t	prefix = 0x01;
+    uint16_t	digestSize = TSS_GetDigestSize(halg);
+
+    if (rc == 0) {
+	ha.hashAlg = halg;
+	rc = TSS_Hash_Generate(&ha,
+			       sizeof(prefix), &prefix,
+			       digestSize, left,
+			       digestSize, right,
+			       0, NULL);
+    }
+    if (rc == 0) {
+	memcpy(digest, (uint8_t *)&ha.digest, digestSize);
+    }
+    return rc;
+}
@@ -0,0 +1,129 @@
+/********************************************************************************/
+/*										*/
+/*			      Merkle Tree Batching				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Merkle trees for amortizing one TPM signature over many values.
+
+   A batch of leaves, e.g. verifier nonces or digests to be signed, is hashed into a tree, and the
+   TPM signs only the root.  Each leaf's owner receives the signature and a MERKLE_PROOF, the
+   sibling digests on the path from the leaf to the root.  merkleProofVerify() recomputes the root
+   from the leaf and the proof, without a TPM.
+
+   merkleSignBatch() signs the root of a batch of digests with one TPM2_Sign, so a signing
+   service is no longer limited to one TPM signature per digest.
+
+   The hashes are domain separated as in RFC 6962, so a leaf cannot be passed off as a node:
+
+   leaf = H(0x00 || leaf value)
+   node = H(0x01 || left || right)
+
+   A node without a sibling moves up a level unchanged, so nothing is duplicated.
+*/
+
+#ifndef MERKLELIB_H
+#define MERKLELIB_H
+
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+
+#define MERKLE_DEPTH_MAX	32	/* proof length, up to 2^32 leaves */
+
+typedef struct {
+    TPMI_ALG_HASH	halg;
+    uint16_t		digestSize;
+    uint32_t		leafCount;
+    uint32_t		levelCount;			/* including the leaves and the root */
+    uint32_t		levelStart[MERKLE_DEPTH_MAX + 1];	/* first node of each level */
+    uint32_t		nodeCount;
+    uint8_t		*nodes;				/* nodeCount digests, leaves first */
+} MERKLE_TREE;
+
+typedef struct {
+    TPMI_ALG_HASH	halg;
+    uint32_t		leafIndex;
+    uint32_t		leafCount;
+    uint32_t		pathCount;
+    TPMU_HA		path[MERKLE_DEPTH_MAX];		/* sibling digests, leaf level first */
+} MERKLE_PROOF;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    TPM_RC merkleTreeCreate(MERKLE_TREE **tree,
+			    TPMI_ALG_HASH halg,
+			    uint32_t leafCount,
+			    const TPM2B_DIGEST *leaves);
+    void merkleTreeDelete(MERKLE_TREE *tree);
+    TPM_RC merkleTreeRoot(TPM2B_DIGEST *root,
+			  const MERKLE_TREE *tree);
+    TPM_RC merkleProofGet(MERKLE_PROOF *proof,
+			  const MERKLE_TREE *tree,
+			  uint32_t leafIndex);
+    TPM_RC merkleProofRoot(TPM2B_DIGEST *root,
+			   const TPM2B_DIGEST *leaf,
+			   const MERKLE_PROOF *proof);
+    TPM_RC merkleProofVerify(const TPM2B *root,
+			     const TPM2B_DIGEST *leaf,
+			     const MERKLE_PROOF *proof);
+    TPM_RC merkleProofMarshal(void *source,
+			      uint16_t *written,
+			      uint8_t **buffer,
+			      uint32_t *size);
+    TPM_RC merkleProofUnmarshal(void *target,
+				uint8_t **buffer,
+				uint32_t *size);
+#ifndef TPM_TSS_NOFILE
+    TPM_RC merkleProofWriteFiles(const MERKLE_TREE *tree,
+				 const char *proofFilenamePrefix);
+#endif
+    TPM_RC merkleSignBatch(TSS_CONTEXT *tssContext,
+			   Sign_Out *out,
+			   MERKLE_TREE **tree,
+			   Sign_In *in,
+			   uint32_t digestCount,
+			   const TPM2B_DIGEST *digests,
+			   TPMI_SH_AUTH_SESSION sessionHandle,
+			   const char *keyPassword,
+			   unsigned int sessionAttributes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
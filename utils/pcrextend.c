@@ -48,6 +48,7 @@
 #include <ibmtss/tss.h>
 #include <ibmtss/tssutils.h>
 #include <ibmtss/tssresponsecode.h>
+#include <ibmtss/tssmarshal.h>
 #include <ibmtss/Unmarshal_fp.h>
 
 static void printUsage(void);
@@ -64,6 +65,8 @@ int main(int argc, char *argv[])
     TPMI_DH_PCR 		pcrHandle = IMPLEMENTATION_PCR;
     const char 			*dataString = NULL;
     const char 			*datafilename = NULL;
+    int				prepare = FALSE;
+    TSS_PREPARED		*prepared = NULL;
    
     setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
     TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "1");
@@ -142,6 +145,9 @@ int main(int argc, char *argv[])
 		printUsage();
 	    }
 	}
+	else if (strcmp(argv[i],"-prep") == 0) {
+	    prepare = TRUE;
+	}
  	else if (strcmp(argv[i],"-h") == 0) {
 	    printUsage();
 	}
@@ -221,8 +227,35 @@ int main(int argc, char *argv[])
     if (rc == 0) {
 	rc = TSS_Create(&tssContext);
     }
+    /* marshal the command once with zero digests, then patch in the digests */
+    if ((rc == 0) && prepare) {
+	PCR_Extend_In 	prepareIn = in;
+	for (algs = 0 ; algs < prepareIn.digests.count ; algs++) {
+	    memset((uint8_t *)&prepareIn.digests.digests[algs].digest, 0, sizeof(TPMU_HA));
+	}
+	rc = TSS_Prepare(tssContext, &prepared,
+			 (COMMAND_PARAMETERS *)&prepareIn,
+			 TPM_CC_PCR_Extend);
+    }
+    if ((rc == 0) && prepare) {
+	uint8_t 	digestsBuffer[sizeof(TPML_DIGEST_VALUES)];
+	uint8_t 	*buffer = digestsBuffer;
+	uint32_t 	size = sizeof(digestsBuffer);
+	uint16_t 	written = 0;
+	rc = TSS_TPML_DIGEST_VALUES_Marshalu(&in.digests, &written, &buffer, &size);
+	if (rc == 0) {
+	    rc = TSS_PreparedSetParameter(prepared, 0, digestsBuffer, written);
+	}
+    }
+    if ((rc == 0) && prepare) {
+	rc = TSS_ExecutePrepared(tssContext,
+				 NULL,
+				 prepared,
+				 TPM_RS_PW, NULL, 0,
+				 TPM_RH_NULL, NULL, 0);
+    }
     /* call TSS to execute the command */
-    if (rc == 0) {
+    if ((rc == 0) && !prepare) {
 	rc = TSS_Execute(tssContext,
 			 NULL, 
 			 (COMMAND_PARAMETERS *)&in,
@@ -231,6 +264,7 @@ int main(int argc, char *argv[])
 			 TPM_RS_PW, NULL, 0,
 			 TPM_RH_NULL, NULL, 0);
     }
+    TSS_PreparedDelete(prepared);
     {
 	TPM_RC rc1 = TSS_Delete(tssContext);
 	if (rc == 0) {
@@ -265,5 +299,8 @@ static void printUsage(void)
     printf("\n");
     printf("\t-ic\tdata string, 0 pad appended to halg length\n");
     printf("\t-if\tdata file, 0 pad appended to halg length\n");
+    printf("\n");
+    printf("\t[-prep\tmarshal the command once with TSS_Prepare() and zero digests,\n");
+    printf("\t\tthen patch the digests with TSS_PreparedSetParameter()]\n");
     exit(1);	
 }
@@ -0,0 +1,1200 @@
+/********************************************************************************/
+/*										*/
+/*			       Policy Calculator				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* 
+   policycalc calculates a TPM2 policy digest in software from a policy description file.
+
+   Unlike policymaker, whose input is the hexascii of each extend, each line of the description
+   is a policy command and its arguments.  There is no TPM.
+
+   Blank lines and text after # are ignored.  Arguments are separated by white space.  HEX is hex
+   ascii, "-" for empty, or @filename for the binary contents of a file, e.g., a policy digest
+   calculated by an earlier run.  Numbers are hex, as in the policy command utilities.
+
+   signed NAME [POLICYREF]
+   secret NAME [POLICYREF]
+   authorize NAME [POLICYREF]
+   authorizenv NAME
+   or DIGEST DIGEST [DIGEST ...]		(2 to 8 digests)
+   pcr BANK PCRLIST PCRDIGEST		(e.g. pcr sha256 0,1,16 HEX)
+   pcrvalues BANK PCRLIST VALUE ...	(PCR values, in PCRLIST order)
+   locality LOCALITY
+   nv NAME OPERANDB OFFSET OPERATION
+   countertimer OPERANDB OFFSET OPERATION
+   commandcode CC
+   physicalpresence
+   cphash DIGEST
+   namehash DIGEST
+   duplicationselect OBJECTNAME NEWPARENTNAME INCLUDEOBJECT
+   authvalue
+   password
+   nvwritten YESNO
+   template DIGEST
+   capability OPERANDB OFFSET OPERATION CAPABILITY PROPERTY
+   parameters DIGEST
+
+   Example: the policy for TPM2_Sign with a password
+
+   commandcode 15d
+   password
+
+   With -pcrdb, the input is a reference database of acceptable PCR states, one per line:
+
+   BANK PCRLIST VALUE ...
+
+   Each line becomes a branch, the -if policy (if any) followed by PolicyPCR.  The branches are
+   combined with PolicyOR, up to 8 per level, and the output is the root of the PolicyOR tree,
+   e.g., to approve with PolicyAuthorize.  -op writes, for each branch, the PolicyOR statements
+   that a policy session runs after its PolicyPCR.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <errno.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tssresponsecode.h>
+#include <ibmtss/tsscryptoh.h>
+
+#include "policylib.h"
+
+/* pcrvalues with every PCR, the keyword, the bank, and the PCR list */
+#define POLICYCALC_ARGS_MAX	(IMPLEMENTATION_PCR + 3)
+
+typedef TPM_RC (*PolicyStatement_t)(TPMT_HA *policyDigest,
+				    int argc,
+				    char **argv);
+
+typedef struct {
+    const char		*keyword;
+    int			argcMin;	/* arguments after the keyword */
+    int			argcMax;
+    PolicyStatement_t	statement;
+} POLICY_STATEMENT;
+
+static void printUsage(void);
+static TPM_RC policyCalcFile(TPMT_HA *policyDigest,
+			     const char *inFilename);
+static TPM_RC policyCalcLine(TPMT_HA *policyDigest,
+			     char *line,
+			     unsigned int lineNumber);
+static TPM_RC splitLine(int *argc,
+			char **argv,
+			char *line,
+			unsigned int lineNumber);
+static TPM_RC policyCalcPcrDb(TPMT_HA *policyDigest,
+			      const TPMT_HA *startDigest,
+			      const char *pcrDbFilename,
+			      const char *pathFilenamePrefix);
+static TPM_RC readPcrDb(TPML_PCR_SELECTION **pcrs,
+			TPM2B_DIGEST **pcrDigests,
+			uint32_t *count,
+			TPMI_ALG_HASH halg,
+			const char *pcrDbFilename);
+static TPM_RC scanPcrValues(TPML_PCR_SELECTION *pcrs,
+			    TPM2B_DIGEST *pcrDigest,
+			    TPMI_ALG_HASH halg,
+			    int argc,
+			    char **argv);
+static TPM_RC writePathFiles(const POLICY_OR_TREE *tree,
+			     const char *pathFilenamePrefix);
+static TPM_RC scanHex(uint8_t *buffer,
+		      uint16_t *length,
+		      size_t bufferSize,
+		      const char *string);
+static TPM_RC scanName(TPM2B_NAME *name,
+		       const char *string);
+static TPM_RC scanDigest(TPM2B_DIGEST *digest,
+			 const char *string);
+static TPM_RC scanNumber(uint32_t *number,
+			 uint32_t max,
+			 const char *string);
+static TPM_RC scanPcrSelection(TPML_PCR_SELECTION *pcrs,
+			       uint32_t *pcrCount,
+			       const char *bank,
+			       const char *pcrList);
+
+static TPM_RC statementSigned(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementSecret(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementAuthorize(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementAuthorizeNV(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementOR(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementPCR(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementPcrValues(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementLocality(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementNV(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementCounterTimer(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementCommandCode(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementPhysicalPresence(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementCpHash(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementNameHash(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementDuplicationSelect(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementAuthValue(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementPassword(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementNvWritten(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementTemplate(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementCapability(TPMT_HA *policyDigest, int argc, char **argv);
+static TPM_RC statementParameters(TPMT_HA *policyDigest, int argc, char **argv);
+
+static const POLICY_STATEMENT policyStatementTable [] = {
+    {"signed",			1, 2, statementSigned},
+    {"secret",			1, 2, statementSecret},
+    {"authorize",		1, 2, statementAuthorize},
+    {"authorizenv",		1, 1, statementAuthorizeNV},
+    {"or",			2, 8, statementOR},
+    {"pcr",			3, 3, statementPCR},
+    {"pcrvalues",		3, POLICYCALC_ARGS_MAX - 1, statementPcrValues},
+    {"locality",		1, 1, statementLocality},
+    {"nv",			4, 4, statementNV},
+    {"countertimer",		3, 3, statementCounterTimer},
+    {"commandcode",		1, 1, statementCommandCode},
+    {"physicalpresence",	0, 0, statementPhysicalPresence},
+    {"cphash",			1, 1, statementCpHash},
+    {"namehash",		1, 1, statementNameHash},
+    {"duplicationselect",	3, 3, statementDuplicationSelect},
+    {"authvalue",		0, 0, statementAuthValue},
+    {"password",		0, 0, statementPassword},
+    {"nvwritten",		1, 1, statementNvWritten},
+    {"template",		1, 1, statementTemplate},
+    {"capability",		5, 5, statementCapability},
+    {"parameters",		1, 1, statementParameters},
+};
+
+extern int tssUtilsVerbose;
+
+int main(int argc, char *argv[])
+{
+    TPM_RC		rc = 0;
+    int			i;    			/* argc iterator */
+    const char 		*inFilename = NULL;
+    const char 		*outFilename = NULL;
+    const char 		*pcrDbFilename = NULL;
+    const char 		*pathFilenamePrefix = NULL;
+    int			pr = FALSE;
+    int			noSpace = FALSE;
+    TPMI_ALG_HASH	halg = TPM_ALG_SHA256;
+    TPMT_HA 		policyDigest;
+    uint32_t           	sizeInBytes = 0;	/* hash algorithm mapped to size */
+
+    setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
+    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "1");
+    tssUtilsVerbose = FALSE;
+    
+    for (i=1 ; (i<argc) && (rc == 0) ; i++) {
+	if (strcmp(argv[i],"-halg") == 0) {
+	    i++;
+	    if (i < argc) {
+		if (strcmp(argv[i],"sha1") == 0) {
+		    halg = TPM_ALG_SHA1;
+		}
+		else if (strcmp(argv[i],"sha256") == 0) {
+		    halg = TPM_ALG_SHA256;
+		}
+		else if (strcmp(argv[i],"sha384") == 0) {
+		    halg = TPM_ALG_SHA384;
+		}
+		else if (strcmp(argv[i],"sha512") == 0) {
+		    halg = TPM_ALG_SHA512;
+		}
+		else {
+		    printf("Bad parameter %s for -halg\n", argv[i]);
+		    printUsage();
+		}
+	    }
+	    else {
+		printf("-halg option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-if") == 0) {
+	    i++;
+	    if (i < argc) {
+		inFilename = argv[i];
+	    }
+	    else {
+		printf("-if option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-of") == 0) {
+	    i++;
+	    if (i < argc) {
+		outFilename = argv[i];
+	    }
+	    else {
+		printf("-of option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-pcrdb") == 0) {
+	    i++;
+	    if (i < argc) {
+		pcrDbFilename = argv[i];
+	    }
+	    else {
+		printf("-pcrdb option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-op") == 0) {
+	    i++;
+	    if (i < argc) {
+		pathFilenamePrefix = argv[i];
+	    }
+	    else {
+		printf("-op option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-pr") == 0) {
+	    pr = TRUE;
+	}
+	else if (strcmp(argv[i],"-ns") == 0) {
+	    noSpace = TRUE;
+	}
+	else if (strcmp(argv[i],"-h") == 0) {
+	    printUsage();
+	}
+	else if (strcmp(argv[i],"-v") == 0) {
+	    tssUtilsVerbose = TRUE;
+	    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "2");
+	}
+	else {
+	    printf("\n%s is not a valid option\n", argv[i]);
+	    printUsage();
+	}
+    }
+    if ((inFilename == NULL) && (pcrDbFilename == NULL)) {
+	printf("Missing input file parameter -if or -pcrdb\n");
+	printUsage();
+    }
+    if ((pathFilenamePrefix != NULL) && (pcrDbFilename == NULL)) {
+	printf("-op requires -pcrdb\n");
+	printUsage();
+    }
+    if (rc == 0) {
+	sizeInBytes = TSS_GetDigestSize(halg);
+	rc = policyCalcInit(&policyDigest, halg);
+    }
+    if ((rc == 0) && (inFilename != NULL)) {
+	rc = policyCalcFile(&policyDigest, inFilename);
+    }
+    /* the -if policy, if any, starts each branch */
+    if ((rc == 0) && (pcrDbFilename != NULL)) {
+	TPMT_HA startDigest = policyDigest;
+	rc = policyCalcPcrDb(&policyDigest,
+			     (inFilename != NULL) ? &startDigest : NULL,
+			     pcrDbFilename, pathFilenamePrefix);
+    }
+    if ((rc == 0) && pr) {
+	TSS_PrintAll("policy digest", (uint8_t *)&policyDigest.digest, sizeInBytes);
+    }
+    if ((rc == 0) && noSpace) {
+	unsigned int b;
+	printf("policy digest:\n");
+	for (b = 0 ; b < sizeInBytes ; b++) {
+	    printf("%02x", *(((uint8_t *)&policyDigest.digest) + b));
+	}
+	printf("\n");
+    }
+    if ((rc == 0) && (outFilename != NULL)) {
+	rc = TSS_File_WriteBinaryFile((uint8_t *)&policyDigest.digest, sizeInBytes,
+				      outFilename);
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("policycalc: success\n");
+    }
+    else {
+	const char *msg;
+	const char *submsg;
+	const char *num;
+	printf("policycalc: failed, rc %08x\n", rc);
+	TSS_ResponseCode_toString(&msg, &submsg, &num, rc);
+	printf("%s%s%s\n", msg, submsg, num);
+	rc = EXIT_FAILURE;
+    }
+    return rc;
+}
+
+/* policyCalcFile() extends policyDigest with each statement in the description file */
+
+static TPM_RC policyCalcFile(TPMT_HA *policyDigest,
+			     const char *inFilename)
+{
+    TPM_RC		rc = 0;
+    FILE 		*inFile = NULL;
+    char		line[4096];
+    unsigned int	lineNumber = 0;
+
+    if (rc == 0) {
+	rc = TSS_File_Open(&inFile, inFilename, "r");	/* closed @1 */
+    }
+    while ((rc == 0) && (fgets(line, sizeof(line), inFile) != NULL)) {
+	lineNumber++;
+	if (strchr(line, '\n') == NULL && !feof(inFile)) {
+	    printf("policyCalcFile: line %u is too long\n", lineNumber);
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+	if (rc == 0) {
+	    rc = policyCalcLine(policyDigest, line, lineNumber);
+	}
+    }
+    if (inFile != NULL) {
+	fclose(inFile);		/* @1 */
+    }
+    return rc;
+}
+
+/* policyCalcLine() splits one line into the keyword and its arguments and runs the statement */
+
+static TPM_RC policyCalcLine(TPMT_HA *policyDigest,
+			     char *line,
+			     unsigned int lineNumber)
+{
+    TPM_RC	rc = 0;
+    char	*argv[POLICYCALC_ARGS_MAX];
+    int		argc = 0;
+    size_t	i;
+    const POLICY_STATEMENT *entry = NULL;
+
+    rc = splitLine(&argc, argv, line, lineNumber);
+    if ((rc == 0) && (argc == 0)) {
+	return 0;		/* blank or comment line */
+    }
+    if (rc == 0) {
+	for (i = 0 ; i < sizeof(policyStatementTable) / sizeof(POLICY_STATEMENT) ; i++) {
+	    if (strcmp(argv[0], policyStatementTable[i].keyword) == 0) {
+		entry = &policyStatementTable[i];
+		break;
+	    }
+	}
+	if (entry == NULL) {
+	    printf("policyCalcLine: line %u, unknown statement %s\n", lineNumber, argv[0]);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	if (((argc - 1) < entry->argcMin) || ((argc - 1) > entry->argcMax)) {
+	    printf("policyCalcLine: line %u, %s needs %d to %d arguments\n",
+		   lineNumber, entry->keyword, entry->argcMin, entry->argcMax);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	rc = entry->statement(policyDigest, argc - 1, argv + 1);
+	if (rc != 0) {
+	    printf("policyCalcLine: line %u, %s failed\n", lineNumber, entry->keyword);
+	}
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) {
+	    printf("%s\n", entry->keyword);
+	    TSS_PrintAll("intermediate policy digest",
+			 (uint8_t *)&policyDigest->digest,
+			 TSS_GetDigestSize(policyDigest->hashAlg));
+	}
+    }
+    return rc;
+}
+
+/* splitLine() removes a # comment and splits the line at white space into at most
+   POLICYCALC_ARGS_MAX arguments.  argv points into line. */
+
+static TPM_RC splitLine(int *argc,
+			char **argv,
+			char *line,
+			unsigned int lineNumber)
+{
+    TPM_RC	rc = 0;
+    char	*comment;
+    char	*token;
+
+    *argc = 0;
+    comment = strchr(line, '#');
+    if (comment != NULL) {
+	*comment = '\0';
+    }
+    for (token = strtok(line, " \t\r\n") ;
+	 (rc == 0) && (token != NULL) ;
+	 token = strtok(NULL, " \t\r\n")) {
+	if (*argc < POLICYCALC_ARGS_MAX) {
+	    argv[*argc] = token;
+	    (*argc)++;
+	}
+	else {
+	    printf("splitLine: line %u has too many arguments\n", lineNumber);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    return rc;
+}
+
+/* policyCalcPcrDb() calculates a PolicyPCR branch for each PCR database entry, starting from
+   startDigest or zero, and returns the root of the PolicyOR tree over the branches */
+
+static TPM_RC policyCalcPcrDb(TPMT_HA *policyDigest,
+			      const TPMT_HA *startDigest,
+			      const char *pcrDbFilename,
+			      const char *pathFilenamePrefix)
+{
+    TPM_RC		rc = 0;
+    TPML_PCR_SELECTION	*pcrs = NULL;
+    TPM2B_DIGEST	*pcrDigests = NULL;
+    uint32_t		count = 0;
+    TPMT_HA		*branches = NULL;
+    POLICY_OR_TREE	*tree = NULL;
+
+    if (rc == 0) {
+	rc = readPcrDb(&pcrs, &pcrDigests, &count,	/* freed @1 @2 */
+		       policyDigest->hashAlg, pcrDbFilename);
+    }
+    if (rc == 0) {
+	/* not TSS_Malloc(), a large database can exceed its size limit */
+	branches = calloc(count, sizeof(TPMT_HA));	/* freed @3 */
+	if (branches == NULL) {
+	    printf("policyCalcPcrDb: Error allocating %u branches\n", count);
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if (rc == 0) {
+	rc = policyCalcPCRBatch(branches, policyDigest->hashAlg, startDigest,
+				count, pcrs, pcrDigests);
+    }
+    if (rc == 0) {
+	rc = policyCalcORTreeCreate(&tree,		/* freed @4 */
+				    policyDigest->hashAlg, count, branches);
+    }
+    if (rc == 0) {
+	rc = policyCalcORTreeRoot(policyDigest, tree);
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("policyCalcPcrDb: %u branches, %u levels\n",
+				    count, tree->levelCount);
+    }
+    if ((rc == 0) && (pathFilenamePrefix != NULL)) {
+	rc = writePathFiles(tree, pathFilenamePrefix);
+    }
+    free(pcrs);				/* @1 */
+    free(pcrDigests);			/* @2 */
+    free(branches);			/* @3 */
+    policyCalcORTreeDelete(tree);	/* @4 */
+    return rc;
+}
+
+/* readPcrDb() reads the PCR database, one BANK PCRLIST VALUE ... entry per line, into arrays of
+   PCR selections and PCR digests.  The PCR digests use the policy hash algorithm halg. */
+
+static TPM_RC readPcrDb(TPML_PCR_SELECTION **pcrs,	/* freed by caller */
+			TPM2B_DIGEST **pcrDigests,	/* freed by caller */
+			uint32_t *count,
+			TPMI_ALG_HASH halg,
+			const char *pcrDbFilename)
+{
+    TPM_RC		rc = 0;
+    FILE 		*inFile = NULL;
+    char		line[4096];
+    unsigned int	lineNumber = 0;
+    uint32_t		allocated = 0;
+    char		*argv[POLICYCALC_ARGS_MAX];
+    int			argc;
+
+    *pcrs = NULL;
+    *pcrDigests = NULL;
+    *count = 0;
+    if (rc == 0) {
+	rc = TSS_File_Open(&inFile, pcrDbFilename, "r");	/* closed @1 */
+    }
+    while ((rc == 0) && (fgets(line, sizeof(line), inFile) != NULL)) {
+	lineNumber++;
+	if (strchr(line, '\n') == NULL && !feof(inFile)) {
+	    printf("readPcrDb: line %u is too long\n", lineNumber);
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+	if (rc == 0) {
+	    rc = splitLine(&argc, argv, line, lineNumber);
+	}
+	if ((rc == 0) && (argc == 0)) {
+	    continue;		/* blank or comment line */
+	}
+	/* grow the arrays, not TSS_Realloc(), a large database can exceed its size limit */
+	if ((rc == 0) && (*count == allocated)) {
+	    void *tmpPcrs;
+	    void *tmpPcrDigests;
+	    allocated = (allocated == 0) ? 64 : allocated * 2;
+	    tmpPcrs = realloc(*pcrs, (size_t)allocated * sizeof(TPML_PCR_SELECTION));
+	    if (tmpPcrs != NULL) {
+		*pcrs = tmpPcrs;
+	    }
+	    tmpPcrDigests = realloc(*pcrDigests, (size_t)allocated * sizeof(TPM2B_DIGEST));
+	    if (tmpPcrDigests != NULL) {
+		*pcrDigests = tmpPcrDigests;
+	    }
+	    if ((tmpPcrs == NULL) || (tmpPcrDigests == NULL)) {
+		printf("readPcrDb: Error allocating %u entries\n", allocated);
+		rc = TSS_RC_OUT_OF_MEMORY;
+	    }
+	}
+	if (rc == 0) {
+	    rc = scanPcrValues(&(*pcrs)[*count], &(*pcrDigests)[*count], halg, argc, argv);
+	    if (rc != 0) {
+		printf("readPcrDb: line %u, bad entry\n", lineNumber);
+	    }
+	}
+	if (rc == 0) {
+	    (*count)++;
+	}
+    }
+    if ((rc == 0) && (*count == 0)) {
+	printf("readPcrDb: %s has no entries\n", pcrDbFilename);
+	rc = TSS_RC_BAD_PROPERTY_VALUE;
+    }
+    if (inFile != NULL) {
+	fclose(inFile);		/* @1 */
+    }
+    return rc;
+}
+
+/* scanPcrValues() converts BANK PCRLIST VALUE ... to the PCR selection and the PCR digest */
+
+static TPM_RC scanPcrValues(TPML_PCR_SELECTION *pcrs,
+			    TPM2B_DIGEST *pcrDigest,
+			    TPMI_ALG_HASH halg,
+			    int argc,
+			    char **argv)
+{
+    TPM_RC		rc = 0;
+    uint32_t		pcrCount = 0;
+    TPM2B_DIGEST	pcrValues[IMPLEMENTATION_PCR];
+    uint32_t		i;
+
+    if (argc < 3) {
+	printf("scanPcrValues: needs a bank, a PCR list, and PCR values\n");
+	rc = TSS_RC_BAD_PROPERTY_VALUE;
+    }
+    if (rc == 0) {
+	rc = scanPcrSelection(pcrs, &pcrCount, argv[0], argv[1]);
+    }
+    if (rc == 0) {
+	if (pcrCount != (uint32_t)(argc - 2)) {
+	    printf("scanPcrValues: %u PCRs selected, %d values\n", pcrCount, argc - 2);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    for (i = 0 ; (rc == 0) && (i < pcrCount) ; i++) {
+	rc = scanDigest(&pcrValues[i], argv[i + 2]);
+    }
+    if (rc == 0) {
+	rc = policyCalcPcrDigest(pcrDigest, halg, pcrCount, pcrValues);
+    }
+    return rc;
+}
+
+/* writePathFiles() writes, for each branch, prefixN.txt with the policycalc or statements that
+   take the branch to the root.  At run time, these are the policyor commands that follow the
+   branch's policypcr. */
+
+static TPM_RC writePathFiles(const POLICY_OR_TREE *tree,
+			     const char *pathFilenamePrefix)
+{
+    TPM_RC		rc = 0;
+    uint32_t		leafIndex;
+    TPML_DIGEST		pHashLists[POLICY_OR_DEPTH_MAX];
+    uint32_t		pathCount;
+    uint32_t		l;
+    uint32_t		d;
+    uint16_t		b;
+
+    for (leafIndex = 0 ; (rc == 0) && (leafIndex < tree->leafCount) ; leafIndex++) {
+	char	filename[4096];
+	FILE	*outFile = NULL;
+	int	n;
+
+	n = snprintf(filename, sizeof(filename), "%s%u.txt", pathFilenamePrefix, leafIndex);
+	if ((n < 0) || ((size_t)n >= sizeof(filename))) {
+	    printf("writePathFiles: prefix %s is too long\n", pathFilenamePrefix);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+	if (rc == 0) {
+	    rc = policyCalcORTreePath(pHashLists, &pathCount, tree, leafIndex);
+	}
+	if (rc == 0) {
+	    rc = TSS_File_Open(&outFile, filename, "w");	/* closed @1 */
+	}
+	for (l = 0 ; (rc == 0) && (l < pathCount) ; l++) {
+	    fprintf(outFile, "or");
+	    for (d = 0 ; d < pHashLists[l].count ; d++) {
+		fprintf(outFile, " ");
+		for (b = 0 ; b < pHashLists[l].digests[d].t.size ; b++) {
+		    fprintf(outFile, "%02x", pHashLists[l].digests[d].t.buffer[b]);
+		}
+	    }
+	    fprintf(outFile, "\n");
+	}
+	if (outFile != NULL) {
+	    fclose(outFile);	/* @1 */
+	}
+    }
+    return rc;
+}
+
+/* scanHex() converts hex ascii, "-" for empty, or @filename to binary */
+
+static TPM_RC scanHex(uint8_t *buffer,
+		      uint16_t *length,
+		      size_t bufferSize,
+		      const char *string)
+{
+    TPM_RC	rc = 0;
+    size_t	stringLength = strlen(string);
+    size_t	i;
+
+    if (strcmp(string, "-") == 0) {
+	*length = 0;
+    }
+    else if (string[0] == '@') {
+	uint8_t	*data = NULL;
+	size_t	dataLength;
+	rc = TSS_File_ReadBinaryFile(&data,	/* freed @1 */
+				     &dataLength,
+				     string + 1);
+	if ((rc == 0) && (dataLength > bufferSize)) {
+	    printf("scanHex: file %s is too large\n", string + 1);
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+	if (rc == 0) {
+	    memcpy(buffer, data, dataLength);
+	    *length = (uint16_t)dataLength;
+	}
+	free(data);				/* @1 */
+    }
+    else {
+	if ((stringLength % 2) != 0) {
+	    printf("scanHex: %s has an odd number of characters\n", string);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+	else if ((stringLength / 2) > bufferSize) {
+	    printf("scanHex: %s is too long\n", string);
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+	for (i = 0 ; (rc == 0) && (i < stringLength / 2) ; i++) {
+	    unsigned int byte;
+	    if (!isxdigit((unsigned char)string[2*i]) ||
+		!isxdigit((unsigned char)string[(2*i)+1]) ||
+		(sscanf(string + (2*i), "%2x", &byte) != 1)) {
+		printf("scanHex: %s is not hex ascii\n", string);
+		rc = TSS_RC_BAD_PROPERTY_VALUE;
+	    }
+	    else {
+		buffer[i] = (uint8_t)byte;
+	    }
+	}
+	if (rc == 0) {
+	    *length = (uint16_t)(stringLength / 2);
+	}
+    }
+    return rc;
+}
+
+static TPM_RC scanName(TPM2B_NAME *name,
+		       const char *string)
+{
+    return scanHex(name->t.name, &name->t.size, sizeof(name->t.name), string);
+}
+
+static TPM_RC scanDigest(TPM2B_DIGEST *digest,
+			 const char *string)
+{
+    return scanHex(digest->t.buffer, &digest->t.size, sizeof(digest->t.buffer), string);
+}
+
+/* scanNumber() scans a hex number that must not exceed max */
+
+static TPM_RC scanNumber(uint32_t *number,
+			 uint32_t max,
+			 const char *string)
+{
+    TPM_RC	rc = 0;
+    char	*end;
+    unsigned long value;
+
+    errno = 0;
+    value = strtoul(string, &end, 16);
+    if ((errno != 0) || (*end != '\0') || (end == string) || (value > max)) {
+	printf("scanNumber: bad number %s\n", string);
+	rc = TSS_RC_BAD_PROPERTY_VALUE;
+    }
+    else {
+	*number = (uint32_t)value;
+    }
+    return rc;
+}
+
+/* scanPcrSelection() converts a bank and a comma separated list of decimal PCR numbers to a
+   TPML_PCR_SELECTION with one bank */
+
+static TPM_RC scanPcrSelection(TPML_PCR_SELECTION *pcrs,
+			       uint32_t *pcrCount,
+			       const char *bank,
+			       const char *pcrList)
+{
+    TPM_RC	rc = 0;
+    const char	*p;
+    char	*end;
+    unsigned long pcr;
+
+    memset(pcrs, 0, sizeof(TPML_PCR_SELECTION));
+    *pcrCount = 0;
+    pcrs->count = 1;
+    pcrs->pcrSelections[0].sizeofSelect = IMPLEMENTATION_PCR / 8;
+    if (strcmp(bank, "sha1") == 0) {
+	pcrs->pcrSelections[0].hash = TPM_ALG_SHA1;
+    }
+    else if (strcmp(bank, "sha256") == 0) {
+	pcrs->pcrSelections[0].hash = TPM_ALG_SHA256;
+    }
+    else if (strcmp(bank, "sha384") == 0) {
+	pcrs->pcrSelections[0].hash = TPM_ALG_SHA384;
+    }
+    else if (strcmp(bank, "sha512") == 0) {
+	pcrs->pcrSelections[0].hash = TPM_ALG_SHA512;
+    }
+    else {
+	printf("scanPcrSelection: bad bank %s\n", bank);
+	rc = TSS_RC_BAD_HASH_ALGORITHM;
+    }
+    for (p = pcrList ; (rc == 0) && (*p != '\0') ; p = end) {
+	if (*p == ',') {
+	    p++;
+	}
+	pcr = strtoul(p, &end, 10);
+	if ((end == p) || (pcr >= IMPLEMENTATION_PCR)) {
+	    printf("scanPcrSelection: bad PCR list %s\n", pcrList);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+	else if ((pcrs->pcrSelections[0].pcrSelect[pcr / 8] & (1 << (pcr % 8))) != 0) {
+	    printf("scanPcrSelection: PCR %lu repeated\n", pcr);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+	else {
+	    pcrs->pcrSelections[0].pcrSelect[pcr / 8] |= 1 << (pcr % 8);
+	    (*pcrCount)++;
+	}
+    }
+    return rc;
+}
+
+static TPM_RC statementSigned(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_NAME		name;
+    TPM2B_NONCE		policyRef;
+
+    policyRef.t.size = 0;
+    if (rc == 0) {
+	rc = scanName(&name, argv[0]);
+    }
+    if ((rc == 0) && (argc > 1)) {
+	rc = scanDigest(&policyRef, argv[1]);
+    }
+    if (rc == 0) {
+	rc = policyCalcSigned(policyDigest, &name, &policyRef);
+    }
+    return rc;
+}
+
+static TPM_RC statementSecret(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_NAME		name;
+    TPM2B_NONCE		policyRef;
+
+    policyRef.t.size = 0;
+    if (rc == 0) {
+	rc = scanName(&name, argv[0]);
+    }
+    if ((rc == 0) && (argc > 1)) {
+	rc = scanDigest(&policyRef, argv[1]);
+    }
+    if (rc == 0) {
+	rc = policyCalcSecret(policyDigest, &name, &policyRef);
+    }
+    return rc;
+}
+
+static TPM_RC statementAuthorize(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_NAME		name;
+    TPM2B_NONCE		policyRef;
+
+    policyRef.t.size = 0;
+    if (rc == 0) {
+	rc = scanName(&name, argv[0]);
+    }
+    if ((rc == 0) && (argc > 1)) {
+	rc = scanDigest(&policyRef, argv[1]);
+    }
+    if (rc == 0) {
+	rc = policyCalcAuthorize(policyDigest, &name, &policyRef);
+    }
+    return rc;
+}
+
+static TPM_RC statementAuthorizeNV(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_NAME		name;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanName(&name, argv[0]);
+    }
+    if (rc == 0) {
+	rc = policyCalcAuthorizeNV(policyDigest, &name);
+    }
+    return rc;
+}
+
+static TPM_RC statementOR(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPML_DIGEST		pHashList;
+    int			i;
+
+    pHashList.count = argc;
+    for (i = 0 ; (rc == 0) && (i < argc) ; i++) {
+	rc = scanDigest(&pHashList.digests[i], argv[i]);
+    }
+    if (rc == 0) {
+	rc = policyCalcOR(policyDigest, &pHashList);
+    }
+    return rc;
+}
+
+static TPM_RC statementPCR(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPML_PCR_SELECTION	pcrs;
+    uint32_t		pcrCount;
+    TPM2B_DIGEST	pcrDigest;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanPcrSelection(&pcrs, &pcrCount, argv[0], argv[1]);
+    }
+    if (rc == 0) {
+	rc = scanDigest(&pcrDigest, argv[2]);
+    }
+    if (rc == 0) {
+	rc = policyCalcPCR(policyDigest, &pcrs, &pcrDigest);
+    }
+    return rc;
+}
+
+static TPM_RC statementPcrValues(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPML_PCR_SELECTION	pcrs;
+    TPM2B_DIGEST	pcrDigest;
+
+    if (rc == 0) {
+	rc = scanPcrValues(&pcrs, &pcrDigest, policyDigest->hashAlg, argc, argv);
+    }
+    if (rc == 0) {
+	rc = policyCalcPCR(policyDigest, &pcrs, &pcrDigest);
+    }
+    return rc;
+}
+
+static TPM_RC statementLocality(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    uint32_t		number;
+    TPMA_LOCALITY	locality;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanNumber(&number, 0xff, argv[0]);
+    }
+    if (rc == 0) {
+	locality.val = (uint8_t)number;
+	rc = policyCalcLocality(policyDigest, locality);
+    }
+    return rc;
+}
+
+static TPM_RC statementNV(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_NAME		name;
+    TPM2B_OPERAND	operandB;
+    uint32_t		offset;
+    uint32_t		operation;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanName(&name, argv[0]);
+    }
+    if (rc == 0) {
+	rc = scanDigest(&operandB, argv[1]);
+    }
+    if (rc == 0) {
+	rc = scanNumber(&offset, 0xffff, argv[2]);
+    }
+    if (rc == 0) {
+	rc = scanNumber(&operation, TPM_EO_BITCLEAR, argv[3]);
+    }
+    if (rc == 0) {
+	rc = policyCalcNV(policyDigest, &name, &operandB, (UINT16)offset, (TPM_EO)operation);
+    }
+    return rc;
+}
+
+static TPM_RC statementCounterTimer(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_OPERAND	operandB;
+    uint32_t		offset;
+    uint32_t		operation;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanDigest(&operandB, argv[0]);
+    }
+    if (rc == 0) {
+	rc = scanNumber(&offset, 0xffff, argv[1]);
+    }
+    if (rc == 0) {
+	rc = scanNumber(&operation, TPM_EO_BITCLEAR, argv[2]);
+    }
+    if (rc == 0) {
+	rc = policyCalcCounterTimer(policyDigest, &operandB, (UINT16)offset, (TPM_EO)operation);
+    }
+    return rc;
+}
+
+static TPM_RC statementCommandCode(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    uint32_t		code;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanNumber(&code, 0xffffffff, argv[0]);
+    }
+    if (rc == 0) {
+	rc = policyCalcCommandCode(policyDigest, code);
+    }
+    return rc;
+}
+
+static TPM_RC statementPhysicalPresence(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    argc = argc;
+    argv = argv;
+    return policyCalcPhysicalPresence(policyDigest);
+}
+
+static TPM_RC statementCpHash(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_DIGEST	cpHashA;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanDigest(&cpHashA, argv[0]);
+    }
+    if (rc == 0) {
+	rc = policyCalcCpHash(policyDigest, &cpHashA);
+    }
+    return rc;
+}
+
+static TPM_RC statementNameHash(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_DIGEST	nameHash;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanDigest(&nameHash, argv[0]);
+    }
+    if (rc == 0) {
+	rc = policyCalcNameHash(policyDigest, &nameHash);
+    }
+    return rc;
+}
+
+static TPM_RC statementDuplicationSelect(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_NAME		objectName;
+    TPM2B_NAME		newParentName;
+    uint32_t		includeObject;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanName(&objectName, argv[0]);
+    }
+    if (rc == 0) {
+	rc = scanName(&newParentName, argv[1]);
+    }
+    if (rc == 0) {
+	rc = scanNumber(&includeObject, YES, argv[2]);
+    }
+    if (rc == 0) {
+	rc = policyCalcDuplicationSelect(policyDigest, &objectName, &newParentName,
+					 (TPMI_YES_NO)includeObject);
+    }
+    return rc;
+}
+
+static TPM_RC statementAuthValue(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    argc = argc;
+    argv = argv;
+    return policyCalcAuthValue(policyDigest);
+}
+
+static TPM_RC statementPassword(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    argc = argc;
+    argv = argv;
+    return policyCalcPassword(policyDigest);
+}
+
+static TPM_RC statementNvWritten(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    uint32_t		writtenSet;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanNumber(&writtenSet, YES, argv[0]);
+    }
+    if (rc == 0) {
+	rc = policyCalcNvWritten(policyDigest, (TPMI_YES_NO)writtenSet);
+    }
+    return rc;
+}
+
+static TPM_RC statementTemplate(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_DIGEST	templateHash;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanDigest(&templateHash, argv[0]);
+    }
+    if (rc == 0) {
+	rc = policyCalcTemplate(policyDigest, &templateHash);
+    }
+    return rc;
+}
+
+static TPM_RC statementCapability(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_OPERAND	operandB;
+    uint32_t		offset;
+    uint32_t		operation;
+    uint32_t		capability;
+    uint32_t		property;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanDigest(&operandB, argv[0]);
+    }
+    if (rc == 0) {
+	rc = scanNumber(&offset, 0xffff, argv[1]);
+    }
+    if (rc == 0) {
+	rc = scanNumber(&operation, TPM_EO_BITCLEAR, argv[2]);
+    }
+    if (rc == 0) {
+	rc = scanNumber(&capability, 0xffffffff, argv[3]);
+    }
+    if (rc == 0) {
+	rc = scanNumber(&property, 0xffffffff, argv[4]);
+    }
+    if (rc == 0) {
+	rc = policyCalcCapability(policyDigest, &operandB, (UINT16)offset, (TPM_EO)operation,
+				  capability, property);
+    }
+    return rc;
+}
+
+static TPM_RC statementParameters(TPMT_HA *policyDigest, int argc, char **argv)
+{
+    TPM_RC		rc = 0;
+    TPM2B_DIGEST	pHash;
+
+    argc = argc;
+    if (rc == 0) {
+	rc = scanDigest(&pHash, argv[0]);
+    }
+    if (rc == 0) {
+	rc = policyCalcParameters(policyDigest, &pHash);
+    }
+    return rc;
+}
+
+static void printUsage(void)
+{
+    printf("\n");
+    printf("policycalc\n");
+    printf("\n");
+    printf("Calculates a policy digest in software from a policy description file.\n");
+    printf("See the policycalc.c header for the statements.\n");
+    printf("\n");
+    printf("\t[-halg\t(sha1, sha256, sha384, sha512) (default sha256)]\n");
+    printf("\t-if\tpolicy description file name, with -pcrdb the start of each branch\n");
+    printf("\t[-pcrdb\tPCR reference database, PolicyOR over a PolicyPCR branch per entry]\n");
+    printf("\t[-op\tprefix for the PolicyOR statements of each -pcrdb branch, prefixN.txt]\n");
+    printf("\t[-of\tbinary policy digest file name]\n");
+    printf("\t[-pr\tstdout policy digest]\n");
+    printf("\t[-ns\tadditionally print policy digest hash without spaces]\n");
+    printf("\t[-v\tverbose, print each intermediate policy digest]\n");
+    printf("\n");
+    exit(1);	
+}
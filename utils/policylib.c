@@ -0,0 +1,919 @@
+/********************************************************************************/
+/*										*/
+/*			   Software Policy Calculator				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Software policy digest calculator.  See policylib.h.
+
+   The formulas are from TPM 2.0 Part 3, the policyDigest update of each TPM2_Policy command.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tsscryptoh.h>
+#include <ibmtss/tssmarshal.h>
+
+#include "policylib.h"
+
+extern int tssUtilsVerbose;
+
+static TPM_RC policyCalcExtend(TPMT_HA *policyDigest,
+			       TPM_CC commandCode,
+			       int length1, const uint8_t *buffer1,
+			       int length2, const uint8_t *buffer2,
+			       int length3, const uint8_t *buffer3);
+static TPM_RC policyCalcUpdate(TPMT_HA *policyDigest,
+			       TPM_CC commandCode,
+			       const TPM2B_NAME *name,
+			       const TPM2B_NONCE *policyRef);
+static TPM_RC policyCalcReset(TPMT_HA *policyDigest);
+static TPM_RC policyCalcArgs(TPMT_HA *args,
+			     TPMI_ALG_HASH halg,
+			     const TPM2B_OPERAND *operandB,
+			     UINT16 offset,
+			     TPM_EO operation,
+			     int length, const uint8_t *buffer);
+
+/* policyCalcInit() sets policyDigest to the all zero starting value for halg */
+
+TPM_RC policyCalcInit(TPMT_HA *policyDigest,
+		      TPMI_ALG_HASH halg)
+{
+    TPM_RC	rc = 0;
+    
+    if (TSS_GetDigestSize(halg) == 0) {
+	if (tssUtilsVerbose) printf("policyCalcInit: Error, bad hash algorithm %04x\n", halg);
+	rc = TSS_RC_BAD_HASH_ALGORITHM;
+    }
+    if (rc == 0) {
+	policyDigest->hashAlg = halg;
+	memset((uint8_t *)&policyDigest->digest, 0, sizeof(TPMU_HA));
+    }
+    return rc;
+}
+
+/* policyCalcExtend() is the common update
+
+   policyDigest = H(policyDigest || commandCode || buffer1 || buffer2 || buffer3)
+
+   Unused buffers have length 0.
+*/
+
+static TPM_RC policyCalcExtend(TPMT_HA *policyDigest,
+			       TPM_CC commandCode,
+			       int length1, const uint8_t *buffer1,
+			       int length2, const uint8_t *buffer2,
+			       int length3, const uint8_t *buffer3)
+{
+    TPM_RC	rc = 0;
+    TPMT_HA	old;
+    uint16_t	sizeInBytes = 0;
+    uint8_t	commandCodeBytes[sizeof(TPM_CC)];
+    uint8_t	*buffer = commandCodeBytes;
+    uint32_t	size = sizeof(commandCodeBytes);
+    uint16_t	written = 0;
+    /* buffers must be non-NULL, a NULL terminates the hash varargs */
+    static const uint8_t empty[1] = {0};
+
+    if (rc == 0) {
+	sizeInBytes = TSS_GetDigestSize(policyDigest->hashAlg);
+	if (sizeInBytes == 0) {
+	    if (tssUtilsVerbose) printf("policyCalcExtend: Error, bad hash algorithm %04x\n",
+					policyDigest->hashAlg);
+	    rc = TSS_RC_BAD_HASH_ALGORITHM;
+	}
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(&commandCode, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	old = *policyDigest;
+	rc = TSS_Hash_Generate(policyDigest,
+			       (int)sizeInBytes, (uint8_t *)&old.digest,
+			       (int)sizeof(commandCodeBytes), commandCodeBytes,
+			       length1, (buffer1 != NULL) ? buffer1 : empty,
+			       length2, (buffer2 != NULL) ? buffer2 : empty,
+			       length3, (buffer3 != NULL) ? buffer3 : empty,
+			       0, NULL);
+    }
+    return rc;
+}
+
+/* policyCalcUpdate() is the Part 3 PolicyUpdate()
+
+   policyDigest = H(policyDigest || commandCode || name)
+   policyDigest = H(policyDigest || policyRef)
+
+   A NULL policyRef is empty.
+*/
+
+static TPM_RC policyCalcUpdate(TPMT_HA *policyDigest,
+			       TPM_CC commandCode,
+			       const TPM2B_NAME *name,
+			       const TPM2B_NONCE *policyRef)
+{
+    TPM_RC	rc = 0;
+    TPMT_HA	old;
+    uint16_t	sizeInBytes;
+    static const uint8_t empty[1] = {0};
+
+    if (rc == 0) {
+	rc = policyCalcExtend(policyDigest, commandCode,
+			      name->t.size, name->t.name,
+			      0, NULL,
+			      0, NULL);
+    }
+    if (rc == 0) {
+	old = *policyDigest;
+	sizeInBytes = TSS_GetDigestSize(policyDigest->hashAlg);
+	rc = TSS_Hash_Generate(policyDigest,
+			       (int)sizeInBytes, (uint8_t *)&old.digest,
+			       (policyRef != NULL) ? (int)policyRef->t.size : 0,
+			       (policyRef != NULL) ? policyRef->t.buffer : empty,
+			       0, NULL);
+    }
+    return rc;
+}
+
+/* policyCalcReset() sets policyDigest to zero, as PolicyOR and the authorize commands do */
+
+static TPM_RC policyCalcReset(TPMT_HA *policyDigest)
+{
+    return policyCalcInit(policyDigest, policyDigest->hashAlg);
+}
+
+/* policyCalcArgs() is the args digest of PolicyNV, PolicyCounterTimer, and PolicyCapability
+
+   args = H(operandB.buffer || offset || operation || buffer)
+*/
+
+static TPM_RC policyCalcArgs(TPMT_HA *args,
+			     TPMI_ALG_HASH halg,
+			     const TPM2B_OPERAND *operandB,
+			     UINT16 offset,
+			     TPM_EO operation,
+			     int length, const uint8_t *buffer)
+{
+    TPM_RC	rc = 0;
+    uint8_t	offsetOperation[sizeof(UINT16) + sizeof(TPM_EO)];
+    uint8_t	*tmpBuffer = offsetOperation;
+    uint32_t	size = sizeof(offsetOperation);
+    uint16_t	written = 0;
+    static const uint8_t empty[1] = {0};
+
+    if (rc == 0) {
+	rc = TSS_UINT16_Marshalu(&offset, &written, &tmpBuffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT16_Marshalu(&operation, &written, &tmpBuffer, &size);
+    }
+    if (rc == 0) {
+	args->hashAlg = halg;
+	rc = TSS_Hash_Generate(args,
+			       (int)operandB->t.size, operandB->t.buffer,
+			       (int)sizeof(offsetOperation), offsetOperation,
+			       length, (buffer != NULL) ? buffer : empty,
+			       0, NULL);
+    }
+    return rc;
+}
+
+/* TPM2_PolicySigned
+
+   policyDigest = PolicyUpdate(TPM_CC_PolicySigned, authObject->Name, policyRef)
+*/
+
+TPM_RC policyCalcSigned(TPMT_HA *policyDigest,
+			const TPM2B_NAME *authObjectName,
+			const TPM2B_NONCE *policyRef)
+{
+    return policyCalcUpdate(policyDigest, TPM_CC_PolicySigned, authObjectName, policyRef);
+}
+
+/* TPM2_PolicySecret
+
+   policyDigest = PolicyUpdate(TPM_CC_PolicySecret, authHandle->Name, policyRef)
+*/
+
+TPM_RC policyCalcSecret(TPMT_HA *policyDigest,
+			const TPM2B_NAME *authName,
+			const TPM2B_NONCE *policyRef)
+{
+    return policyCalcUpdate(policyDigest, TPM_CC_PolicySecret, authName, policyRef);
+}
+
+/* TPM2_PolicyTicket
+
+   The update is that of the command that produced the ticket, PolicySigned for
+   TPM_ST_AUTH_SIGNED, PolicySecret for TPM_ST_AUTH_SECRET.
+*/
+
+TPM_RC policyCalcTicket(TPMT_HA *policyDigest,
+			TPM_ST ticketTag,
+			const TPM2B_NAME *authName,
+			const TPM2B_NONCE *policyRef)
+{
+    TPM_RC	rc = 0;
+
+    if (ticketTag == TPM_ST_AUTH_SIGNED) {
+	rc = policyCalcSigned(policyDigest, authName, policyRef);
+    }
+    else if (ticketTag == TPM_ST_AUTH_SECRET) {
+	rc = policyCalcSecret(policyDigest, authName, policyRef);
+    }
+    else {
+	if (tssUtilsVerbose) printf("policyCalcTicket: Error, bad ticket tag %04x\n", ticketTag);
+	rc = TSS_RC_BAD_PROPERTY_VALUE;
+    }
+    return rc;
+}
+
+/* TPM2_PolicyOR
+
+   policyDigest = H(0...0 || TPM_CC_PolicyOR || digests)
+
+   policyDigest must equal one of the pHashList digests.  That is a run time check, and is not
+   done here.
+*/
+
+TPM_RC policyCalcOR(TPMT_HA *policyDigest,
+		    const TPML_DIGEST *pHashList)
+{
+    TPM_RC	rc = 0;
+    uint8_t	digests[sizeof(pHashList->digests)];
+    uint32_t	length = 0;
+    uint32_t	i;
+
+    if ((pHashList->count < 2) || (pHashList->count > 8)) {
+	if (tssUtilsVerbose) printf("policyCalcOR: Error, %u digests, must be 2 to 8\n",
+				    pHashList->count);
+	rc = TSS_RC_BAD_PROPERTY_VALUE;
+    }
+    for (i = 0 ; (rc == 0) && (i < pHashList->count) ; i++) {
+	memcpy(digests + length, pHashList->digests[i].t.buffer, pHashList->digests[i].t.size);
+	length += pHashList->digests[i].t.size;
+    }
+    if (rc == 0) {
+	rc = policyCalcReset(policyDigest);
+    }
+    if (rc == 0) {
+	rc = policyCalcExtend(policyDigest, TPM_CC_PolicyOR,
+			      (int)length, digests,
+			      0, NULL,
+			      0, NULL);
+    }
+    return rc;
+}
+
+/* TPM2_PolicyPCR
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyPCR || pcrs || pcrDigest)
+
+   pcrDigest is the hash of the selected PCR values, see policyCalcPcrDigest().
+*/
+
+TPM_RC policyCalcPCR(TPMT_HA *policyDigest,
+		     const TPML_PCR_SELECTION *pcrs,
+		     const TPM2B_DIGEST *pcrDigest)
+{
+    TPM_RC	rc = 0;
+    uint8_t	pcrsBytes[sizeof(TPML_PCR_SELECTION)];
+    uint8_t	*buffer = pcrsBytes;
+    uint32_t	size = sizeof(pcrsBytes);
+    uint16_t	written = 0;
+
+    if (rc == 0) {
+	rc = TSS_TPML_PCR_SELECTION_Marshalu(pcrs, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = policyCalcExtend(policyDigest, TPM_CC_PolicyPCR,
+			      (int)written, pcrsBytes,
+			      (int)pcrDigest->t.size, pcrDigest->t.buffer,
+			      0, NULL);
+    }
+    return rc;
+}
+
+/* policyCalcPcrDigest() hashes pcrCount PCR values, in selection order, to the pcrDigest of
+   TPM2_PolicyPCR.  halg is the policy session hash algorithm. */
+
+TPM_RC policyCalcPcrDigest(TPM2B_DIGEST *pcrDigest,
+			   TPMI_ALG_HASH halg,
+			   uint32_t pcrCount,
+			   const TPM2B_DIGEST *pcrValues)
+{
+    TPM_RC	rc = 0;
+    TPMT_HA	digest;
+    uint8_t	pcrBytes[IMPLEMENTATION_PCR * sizeof(TPMU_HA)];
+    uint32_t	length = 0;
+    uint32_t	i;
+
+    if (pcrCount > IMPLEMENTATION_PCR) {
+	if (tssUtilsVerbose) printf("policyCalcPcrDigest: Error, %u PCRs\n", pcrCount);
+	rc = TSS_RC_BAD_PROPERTY_VALUE;
+    }
+    for (i = 0 ; (rc == 0) && (i < pcrCount) ; i++) {
+	if (pcrValues[i].t.size > sizeof(TPMU_HA)) {
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+	else {
+	    memcpy(pcrBytes + length, pcrValues[i].t.buffer, pcrValues[i].t.size);
+	    length += pcrValues[i].t.size;
+	}
+    }
+    if (rc == 0) {
+	digest.hashAlg = halg;
+	rc = TSS_Hash_Generate(&digest,
+			       (int)length, pcrBytes,
+			       0, NULL);
+    }
+    if (rc == 0) {
+	pcrDigest->t.size = TSS_GetDigestSize(halg);
+	memcpy(pcrDigest->t.buffer, (uint8_t *)&digest.digest, pcrDigest->t.size);
+    }
+    return rc;
+}
+
+/* TPM2_PolicyLocality
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyLocality || locality)
+*/
+
+TPM_RC policyCalcLocality(TPMT_HA *policyDigest,
+			  TPMA_LOCALITY locality)
+{
+    uint8_t localityByte = locality.val;
+    return policyCalcExtend(policyDigest, TPM_CC_PolicyLocality,
+			    (int)sizeof(localityByte), &localityByte,
+			    0, NULL,
+			    0, NULL);
+}
+
+/* TPM2_PolicyNV
+
+   args = H(operandB.buffer || offset || operation)
+   policyDigest = H(policyDigest || TPM_CC_PolicyNV || args || nvIndex->Name)
+*/
+
+TPM_RC policyCalcNV(TPMT_HA *policyDigest,
+		    const TPM2B_NAME *nvIndexName,
+		    const TPM2B_OPERAND *operandB,
+		    UINT16 offset,
+		    TPM_EO operation)
+{
+    TPM_RC	rc = 0;
+    TPMT_HA	args;
+
+    if (rc == 0) {
+	rc = policyCalcArgs(&args, policyDigest->hashAlg, operandB, offset, operation, 0, NULL);
+    }
+    if (rc == 0) {
+	rc = policyCalcExtend(policyDigest, TPM_CC_PolicyNV,
+			      (int)TSS_GetDigestSize(args.hashAlg), (uint8_t *)&args.digest,
+			      (int)nvIndexName->t.size, nvIndexName->t.name,
+			      0, NULL);
+    }
+    return rc;
+}
+
+/* TPM2_PolicyCounterTimer
+
+   args = H(operandB.buffer || offset || operation)
+   policyDigest = H(policyDigest || TPM_CC_PolicyCounterTimer || args)
+*/
+
+TPM_RC policyCalcCounterTimer(TPMT_HA *policyDigest,
+			      const TPM2B_OPERAND *operandB,
+			      UINT16 offset,
+			      TPM_EO operation)
+{
+    TPM_RC	rc = 0;
+    TPMT_HA	args;
+
+    if (rc == 0) {
+	rc = policyCalcArgs(&args, policyDigest->hashAlg, operandB, offset, operation, 0, NULL);
+    }
+    if (rc == 0) {
+	rc = policyCalcExtend(policyDigest, TPM_CC_PolicyCounterTimer,
+			      (int)TSS_GetDigestSize(args.hashAlg), (uint8_t *)&args.digest,
+			      0, NULL,
+			      0, NULL);
+    }
+    return rc;
+}
+
+/* TPM2_PolicyCommandCode
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyCommandCode || code)
+*/
+
+TPM_RC policyCalcCommandCode(TPMT_HA *policyDigest,
+			     TPM_CC code)
+{
+    TPM_RC	rc = 0;
+    uint8_t	codeBytes[sizeof(TPM_CC)];
+    uint8_t	*buffer = codeBytes;
+    uint32_t	size = sizeof(codeBytes);
+    uint16_t	written = 0;
+
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(&code, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = policyCalcExtend(policyDigest, TPM_CC_PolicyCommandCode,
+			      (int)sizeof(codeBytes), codeBytes,
+			      0, NULL,
+			      0, NULL);
+    }
+    return rc;
+}
+
+/* TPM2_PolicyPhysicalPresence
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyPhysicalPresence)
+*/
+
+TPM_RC policyCalcPhysicalPresence(TPMT_HA *policyDigest)
+{
+    return policyCalcExtend(policyDigest, TPM_CC_PolicyPhysicalPresence,
+			    0, NULL,
+			    0, NULL,
+			    0, NULL);
+}
+
+/* TPM2_PolicyCpHash
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyCpHash || cpHashA)
+*/
+
+TPM_RC policyCalcCpHash(TPMT_HA *policyDigest,
+			const TPM2B_DIGEST *cpHashA)
+{
+    return policyCalcExtend(policyDigest, TPM_CC_PolicyCpHash,
+			    (int)cpHashA->t.size, cpHashA->t.buffer,
+			    0, NULL,
+			    0, NULL);
+}
+
+/* TPM2_PolicyNameHash
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyNameHash || nameHash)
+*/
+
+TPM_RC policyCalcNameHash(TPMT_HA *policyDigest,
+			  const TPM2B_DIGEST *nameHash)
+{
+    return policyCalcExtend(policyDigest, TPM_CC_PolicyNameHash,
+			    (int)nameHash->t.size, nameHash->t.buffer,
+			    0, NULL,
+			    0, NULL);
+}
+
+/* TPM2_PolicyDuplicationSelect
+
+   includeObject SET:
+   policyDigest = H(policyDigest || TPM_CC_PolicyDuplicationSelect || objectName ||
+   newParentName || includeObject)
+
+   includeObject CLEAR:
+   policyDigest = H(policyDigest || TPM_CC_PolicyDuplicationSelect || newParentName ||
+   includeObject)
+*/
+
+TPM_RC policyCalcDuplicationSelect(TPMT_HA *policyDigest,
+				   const TPM2B_NAME *objectName,
+				   const TPM2B_NAME *newParentName,
+				   TPMI_YES_NO includeObject)
+{
+    TPM_RC	rc = 0;
+    
+    if (includeObject == YES) {
+	rc = policyCalcExtend(policyDigest, TPM_CC_PolicyDuplicationSelect,
+			      (int)objectName->t.size, objectName->t.name,
+			      (int)newParentName->t.size, newParentName->t.name,
+			      (int)sizeof(includeObject), &includeObject);
+    }
+    else {
+	rc = policyCalcExtend(policyDigest, TPM_CC_PolicyDuplicationSelect,
+			      (int)newParentName->t.size, newParentName->t.name,
+			      (int)sizeof(includeObject), &includeObject,
+			      0, NULL);
+    }
+    return rc;
+}
+
+/* TPM2_PolicyAuthorize
+
+   policyDigest = PolicyUpdate(TPM_CC_PolicyAuthorize, keySign->Name, policyRef), starting from
+   zero
+
+   approvedPolicy must equal the policyDigest at run time.  That is not checked here.
+*/
+
+TPM_RC policyCalcAuthorize(TPMT_HA *policyDigest,
+			   const TPM2B_NAME *keySignName,
+			   const TPM2B_NONCE *policyRef)
+{
+    TPM_RC	rc = 0;
+
+    if (rc == 0) {
+	rc = policyCalcReset(policyDigest);
+    }
+    if (rc == 0) {
+	rc = policyCalcUpdate(policyDigest, TPM_CC_PolicyAuthorize, keySignName, policyRef);
+    }
+    return rc;
+}
+
+/* TPM2_PolicyAuthValue
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyAuthValue)
+*/
+
+TPM_RC policyCalcAuthValue(TPMT_HA *policyDigest)
+{
+    return policyCalcExtend(policyDigest, TPM_CC_PolicyAuthValue,
+			    0, NULL,
+			    0, NULL,
+			    0, NULL);
+}
+
+/* TPM2_PolicyPassword
+
+   The update is the same as TPM2_PolicyAuthValue, so an object policy does not depend on which
+   of the two the user runs.
+*/
+
+TPM_RC policyCalcPassword(TPMT_HA *policyDigest)
+{
+    return policyCalcAuthValue(policyDigest);
+}
+
+/* TPM2_PolicyNvWritten
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyNvWritten || writtenSet)
+*/
+
+TPM_RC policyCalcNvWritten(TPMT_HA *policyDigest,
+			   TPMI_YES_NO writtenSet)
+{
+    return policyCalcExtend(policyDigest, TPM_CC_PolicyNvWritten,
+			    (int)sizeof(writtenSet), &writtenSet,
+			    0, NULL,
+			    0, NULL);
+}
+
+/* TPM2_PolicyTemplate
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyTemplate || templateHash)
+*/
+
+TPM_RC policyCalcTemplate(TPMT_HA *policyDigest,
+			  const TPM2B_DIGEST *templateHash)
+{
+    return policyCalcExtend(policyDigest, TPM_CC_PolicyTemplate,
+			    (int)templateHash->t.size, templateHash->t.buffer,
+			    0, NULL,
+			    0, NULL);
+}
+
+/* TPM2_PolicyAuthorizeNV
+
+   policyDigest = H(0...0 || TPM_CC_PolicyAuthorizeNV || nvIndex->Name)
+*/
+
+TPM_RC policyCalcAuthorizeNV(TPMT_HA *policyDigest,
+			     const TPM2B_NAME *nvIndexName)
+{
+    TPM_RC	rc = 0;
+
+    if (rc == 0) {
+	rc = policyCalcReset(policyDigest);
+    }
+    if (rc == 0) {
+	rc = policyCalcExtend(policyDigest, TPM_CC_PolicyAuthorizeNV,
+			      (int)nvIndexName->t.size, nvIndexName->t.name,
+			      0, NULL,
+			      0, NULL);
+    }
+    return rc;
+}
+
+/* TPM2_PolicyCapability
+
+   args = H(operandB.buffer || offset || operation || capability || property)
+   policyDigest = H(policyDigest || TPM_CC_PolicyCapability || args)
+*/
+
+TPM_RC policyCalcCapability(TPMT_HA *policyDigest,
+			    const TPM2B_OPERAND *operandB,
+			    UINT16 offset,
+			    TPM_EO operation,
+			    TPM_CAP capability,
+			    UINT32 property)
+{
+    TPM_RC	rc = 0;
+    TPMT_HA	args;
+    uint8_t	capabilityProperty[sizeof(TPM_CAP) + sizeof(UINT32)];
+    uint8_t	*buffer = capabilityProperty;
+    uint32_t	size = sizeof(capabilityProperty);
+    uint16_t	written = 0;
+
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(&capability, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(&property, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = policyCalcArgs(&args, policyDigest->hashAlg, operandB, offset, operation,
+			    (int)sizeof(capabilityProperty), capabilityProperty);
+    }
+    if (rc == 0) {
+	rc = policyCalcExtend(policyDigest, TPM_CC_PolicyCapability,
+			      (int)TSS_GetDigestSize(args.hashAlg), (uint8_t *)&args.digest,
+			      0, NULL,
+			      0, NULL);
+    }
+    return rc;
+}
+
+/* TPM2_PolicyParameters
+
+   policyDigest = H(policyDigest || TPM_CC_PolicyParameters || pHash)
+*/
+
+TPM_RC policyCalcParameters(TPMT_HA *policyDigest,
+			    const TPM2B_DIGEST *pHash)
+{
+    return policyCalcExtend(policyDigest, TPM_CC_PolicyParameters,
+			    (int)pHash->t.size, pHash->t.buffer,
+			    0, NULL,
+			    0, NULL);
+}
+
+/* policyCalcPCRBatch() calculates count PolicyPCR branches.
+
+   Branch i is startDigest extended with PolicyPCR(pcrs[i], pcrDigests[i]).  startDigest is the
+   policy before the PolicyPCR, or NULL to start from zero.
+*/
+
+TPM_RC policyCalcPCRBatch(TPMT_HA *policyDigests,
+			  TPMI_ALG_HASH halg,
+			  const TPMT_HA *startDigest,
+			  uint32_t count,
+			  const TPML_PCR_SELECTION *pcrs,
+			  const TPM2B_DIGEST *pcrDigests)
+{
+    TPM_RC	rc = 0;
+    uint32_t	i;
+
+    if ((startDigest != NULL) && (startDigest->hashAlg != halg)) {
+	if (tssUtilsVerbose) printf("policyCalcPCRBatch: Error, start hash algorithm %04x\n",
+				    startDigest->hashAlg);
+	rc = TSS_RC_BAD_HASH_ALGORITHM;
+    }
+    for (i = 0 ; (rc == 0) && (i < count) ; i++) {
+	if (startDigest != NULL) {
+	    policyDigests[i] = *startDigest;
+	}
+	else {
+	    rc = policyCalcInit(&policyDigests[i], halg);
+	}
+	if (rc == 0) {
+	    rc = policyCalcPCR(&policyDigests[i], &pcrs[i], &pcrDigests[i]);
+	}
+    }
+    return rc;
+}
+
+/* policyCalcORTreeCreate() combines leafCount branch policy digests into a tree of PolicyOR
+   digests, up to POLICY_OR_WIDTH per PolicyOR.
+
+   A last group with one digest moves up a level unchanged, since PolicyOR requires at least two.
+
+   The caller frees the tree with policyCalcORTreeDelete().
+*/
+
+TPM_RC policyCalcORTreeCreate(POLICY_OR_TREE **tree,		/* freed by caller */
+			      TPMI_ALG_HASH halg,
+			      uint32_t leafCount,
+			      const TPMT_HA *leaves)
+{
+    TPM_RC	rc = 0;
+    uint32_t	count;		/* nodes in the current level */
+    uint32_t	level;
+    uint32_t	i;
+
+    if (rc == 0) {
+	*tree = NULL;
+	if (leafCount == 0) {
+	    if (tssUtilsVerbose) printf("policyCalcORTreeCreate: Error, no branches\n");
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	*tree = calloc(1, sizeof(POLICY_OR_TREE));
+	if (*tree == NULL) {
+	    if (tssUtilsVerbose) printf("policyCalcORTreeCreate: Error allocating tree\n");
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if (rc == 0) {
+	(*tree)->halg = halg;
+	(*tree)->digestSize = TSS_GetDigestSize(halg);
+	(*tree)->leafCount = leafCount;
+	if ((*tree)->digestSize == 0) {
+	    if (tssUtilsVerbose) printf("policyCalcORTreeCreate: Error, bad hash algorithm %04x\n",
+					halg);
+	    rc = TSS_RC_BAD_HASH_ALGORITHM;
+	}
+    }
+    /* lay out the levels, each with one node per group of POLICY_OR_WIDTH below */
+    if (rc == 0) {
+	count = leafCount;
+	for (level = 0 ; ; level++) {
+	    (*tree)->levelStart[level] = (*tree)->nodeCount;
+	    (*tree)->nodeCount += count;
+	    if (count == 1) {
+		break;
+	    }
+	    count = (count + POLICY_OR_WIDTH - 1) / POLICY_OR_WIDTH;
+	}
+	(*tree)->levelCount = level + 1;
+    }
+    if (rc == 0) {
+	/* not TSS_Malloc(), a large batch can exceed its size limit */
+	(*tree)->nodes = malloc((size_t)(*tree)->nodeCount * (*tree)->digestSize);
+	if ((*tree)->nodes == NULL) {
+	    if (tssUtilsVerbose) printf("policyCalcORTreeCreate: Error allocating %u nodes\n",
+					(*tree)->nodeCount);
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    for (i = 0 ; (rc == 0) && (i < leafCount) ; i++) {
+	if (leaves[i].hashAlg != halg) {
+	    if (tssUtilsVerbose) printf("policyCalcORTreeCreate: Error, branch %u hash algorithm "
+					"%04x\n", i, leaves[i].hashAlg);
+	    rc = TSS_RC_BAD_HASH_ALGORITHM;
+	}
+	else {
+	    memcpy((*tree)->nodes + ((size_t)i * (*tree)->digestSize),
+		   (const uint8_t *)&leaves[i].digest, (*tree)->digestSize);
+	}
+    }
+    /* OR each group of a level into one node of the level above */
+    for (level = 1 ; (rc == 0) && (level < (*tree)->levelCount) ; level++) {
+	uint16_t digestSize = (*tree)->digestSize;
+	uint8_t *below = (*tree)->nodes + ((size_t)(*tree)->levelStart[level-1] * digestSize);
+	uint8_t *above = (*tree)->nodes + ((size_t)(*tree)->levelStart[level] * digestSize);
+	count = (*tree)->levelStart[level] - (*tree)->levelStart[level-1];
+	for (i = 0 ; (rc == 0) && (i < count) ; i += POLICY_OR_WIDTH) {
+	    uint32_t	groupCount = count - i;
+	    uint32_t	g;
+	    if (groupCount > POLICY_OR_WIDTH) {
+		groupCount = POLICY_OR_WIDTH;
+	    }
+	    if (groupCount > 1) {
+		TPML_DIGEST	pHashList;
+		TPMT_HA		orDigest;
+		pHashList.count = groupCount;
+		for (g = 0 ; g < groupCount ; g++) {
+		    pHashList.digests[g].t.size = digestSize;
+		    memcpy(pHashList.digests[g].t.buffer,
+			   below + ((size_t)(i + g) * digestSize), digestSize);
+		}
+		orDigest.hashAlg = halg;
+		rc = policyCalcOR(&orDigest, &pHashList);
+		if (rc == 0) {
+		    memcpy(above + ((size_t)(i / POLICY_OR_WIDTH) * digestSize),
+			   (uint8_t *)&orDigest.digest, digestSize);
+		}
+	    }
+	    else {	/* a single digest, move up unchanged */
+		memcpy(above + ((size_t)(i / POLICY_OR_WIDTH) * digestSize),
+		       below + ((size_t)i * digestSize), digestSize);
+	    }
+	}
+    }
+    if ((rc != 0) && (*tree != NULL)) {
+	policyCalcORTreeDelete(*tree);
+	*tree = NULL;
+    }
+    return rc;
+}
+
+/* policyCalcORTreeDelete() frees a tree created by policyCalcORTreeCreate().  NULL is
+   ignored. */
+
+void policyCalcORTreeDelete(POLICY_OR_TREE *tree)
+{
+    if (tree != NULL) {
+	free(tree->nodes);
+	free(tree);
+    }
+    return;
+}
+
+/* policyCalcORTreeRoot() returns the policy digest at the top of the tree */
+
+TPM_RC policyCalcORTreeRoot(TPMT_HA *root,
+			    const POLICY_OR_TREE *tree)
+{
+    root->hashAlg = tree->halg;
+    memcpy((uint8_t *)&root->digest,
+	   tree->nodes + ((size_t)tree->levelStart[tree->levelCount - 1] * tree->digestSize),
+	   tree->digestSize);
+    return 0;
+}
+
+/* policyCalcORTreePath() returns the PolicyOR lists that take branch leafIndex to the root, in
+   the order they are run.
+
+   pHashLists must have POLICY_OR_DEPTH_MAX entries.  Levels where the branch moved up unchanged
+   have no PolicyOR and are omitted.
+*/
+
+TPM_RC policyCalcORTreePath(TPML_DIGEST *pHashLists,
+			    uint32_t *pathCount,
+			    const POLICY_OR_TREE *tree,
+			    uint32_t leafIndex)
+{
+    TPM_RC	rc = 0;
+    uint32_t	index = leafIndex;	/* node index within the level */
+    uint32_t	count;			/* nodes in the level */
+    uint32_t	level;
+
+    if (rc == 0) {
+	if (leafIndex >= tree->leafCount) {
+	    if (tssUtilsVerbose) printf("policyCalcORTreePath: Error, branch %u of %u\n",
+					leafIndex, tree->leafCount);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	*pathCount = 0;
+	count = tree->leafCount;
+	for (level = 0 ; count > 1 ; level++) {
+	    uint32_t	first = index - (index % POLICY_OR_WIDTH);
+	    uint32_t	groupCount = count - first;
+	    uint32_t	g;
+	    if (groupCount > POLICY_OR_WIDTH) {
+		groupCount = POLICY_OR_WIDTH;
+	    }
+	    if (groupCount > 1) {
+		TPML_DIGEST *pHashList = &pHashLists[*pathCount];
+		pHashList->count = groupCount;
+		for (g = 0 ; g < groupCount ; g++) {
+		    pHashList->digests[g].t.size = tree->digestSize;
+		    memcpy(pHashList->digests[g].t.buffer,
+			   tree->nodes + ((size_t)(tree->levelStart[level] + first + g) *
+					  tree->digestSize),
+			   tree->digestSize);
+		}
+		(*pathCount)++;
+	    }
+	    index /= POLICY_OR_WIDTH;
+	    count = (count + POLICY_OR_WIDTH - 1) / POLICY_OR_WIDTH;
+	}
+    }
+    return rc;
+}
@@ -0,0 +1,163 @@
+/********************************************************************************/
+/*										*/
+/*			   Software Policy Calculator				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Software calculation of policy digests.
+
+   There is one function per TPM2_Policy command.  Each extends policyDigest exactly as the TPM
+   extends the session policyDigest, so a policy can be calculated without a TPM trial session.
+   policyCalcInit() sets the starting all zero digest.
+
+   The functions take the values that are hashed, not the command parameters.  E.g.,
+   policyCalcSigned() takes the Name of the authorizing key, not the signature.
+
+   For sealing to many acceptable PCR states, policyCalcPCRBatch() calculates one PolicyPCR
+   branch per reference PCR set, and policyCalcORTreeCreate() combines the branches with PolicyOR
+   commands of up to 8 digests per level.  The tree root is the policy to approve with
+   PolicyAuthorize or to use as an authPolicy.  At run time, the policy session runs its branch's
+   PolicyPCR and then, level by level, the PolicyOR lists returned by policyCalcORTreePath().
+*/
+
+#ifndef POLICYLIB_H
+#define POLICYLIB_H
+
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+
+#define POLICY_OR_WIDTH		8	/* the TPML_DIGEST maximum for PolicyOR */
+#define POLICY_OR_DEPTH_MAX	11	/* 8^11 > 2^32 branches */
+
+typedef struct {
+    TPMI_ALG_HASH	halg;
+    uint16_t		digestSize;
+    uint32_t		leafCount;
+    uint32_t		levelCount;			/* including the leaves and the root */
+    uint32_t		levelStart[POLICY_OR_DEPTH_MAX + 1];	/* first node of each level */
+    uint32_t		nodeCount;
+    uint8_t		*nodes;				/* nodeCount digests, leaves first */
+} POLICY_OR_TREE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    TPM_RC policyCalcInit(TPMT_HA *policyDigest,
+			  TPMI_ALG_HASH halg);
+    TPM_RC policyCalcSigned(TPMT_HA *policyDigest,
+			    const TPM2B_NAME *authObjectName,
+			    const TPM2B_NONCE *policyRef);
+    TPM_RC policyCalcSecret(TPMT_HA *policyDigest,
+			    const TPM2B_NAME *authName,
+			    const TPM2B_NONCE *policyRef);
+    TPM_RC policyCalcTicket(TPMT_HA *policyDigest,
+			    TPM_ST ticketTag,
+			    const TPM2B_NAME *authName,
+			    const TPM2B_NONCE *policyRef);
+    TPM_RC policyCalcOR(TPMT_HA *policyDigest,
+			const TPML_DIGEST *pHashList);
+    TPM_RC policyCalcPCR(TPMT_HA *policyDigest,
+			 const TPML_PCR_SELECTION *pcrs,
+			 const TPM2B_DIGEST *pcrDigest);
+    TPM_RC policyCalcPcrDigest(TPM2B_DIGEST *pcrDigest,
+			       TPMI_ALG_HASH halg,
+			       uint32_t pcrCount,
+			       const TPM2B_DIGEST *pcrValues);
+    TPM_RC policyCalcLocality(TPMT_HA *policyDigest,
+			      TPMA_LOCALITY locality);
+    TPM_RC policyCalcNV(TPMT_HA *policyDigest,
+			const TPM2B_NAME *nvIndexName,
+			const TPM2B_OPERAND *operandB,
+			UINT16 offset,
+			TPM_EO operation);
+    TPM_RC policyCalcCounterTimer(TPMT_HA *policyDigest,
+				  const TPM2B_OPERAND *operandB,
+				  UINT16 offset,
+				  TPM_EO operation);
+    TPM_RC policyCalcCommandCode(TPMT_HA *policyDigest,
+				 TPM_CC code);
+    TPM_RC policyCalcPhysicalPresence(TPMT_HA *policyDigest);
+    TPM_RC policyCalcCpHash(TPMT_HA *policyDigest,
+			    const TPM2B_DIGEST *cpHashA);
+    TPM_RC policyCalcNameHash(TPMT_HA *policyDigest,
+			      const TPM2B_DIGEST *nameHash);
+    TPM_RC policyCalcDuplicationSelect(TPMT_HA *policyDigest,
+				       const TPM2B_NAME *objectName,
+				       const TPM2B_NAME *newParentName,
+				       TPMI_YES_NO includeObject);
+    TPM_RC policyCalcAuthorize(TPMT_HA *policyDigest,
+			       const TPM2B_NAME *keySignName,
+			       const TPM2B_NONCE *policyRef);
+    TPM_RC policyCalcAuthValue(TPMT_HA *policyDigest);
+    TPM_RC policyCalcPassword(TPMT_HA *policyDigest);
+    TPM_RC policyCalcNvWritten(TPMT_HA *policyDigest,
+			       TPMI_YES_NO writtenSet);
+    TPM_RC policyCalcTemplate(TPMT_HA *policyDigest,
+			      const TPM2B_DIGEST *templateHash);
+    TPM_RC policyCalcAuthorizeNV(TPMT_HA *policyDigest,
+				 const TPM2B_NAME *nvIndexName);
+    TPM_RC policyCalcCapability(TPMT_HA *policyDigest,
+				const TPM2B_OPERAND *operandB,
+				UINT16 offset,
+				TPM_EO operation,
+				TPM_CAP capability,
+				UINT32 property);
+    TPM_RC policyCalcParameters(TPMT_HA *policyDigest,
+				const TPM2B_DIGEST *pHash);
+    TPM_RC policyCalcPCRBatch(TPMT_HA *policyDigests,
+			      TPMI_ALG_HASH halg,
+			      const TPMT_HA *startDigest,
+			      uint32_t count,
+			      const TPML_PCR_SELECTION *pcrs,
+			      const TPM2B_DIGEST *pcrDigests);
+    TPM_RC policyCalcORTreeCreate(POLICY_OR_TREE **tree,
+				  TPMI_ALG_HASH halg,
+				  uint32_t leafCount,
+				  const TPMT_HA *leaves);
+    void policyCalcORTreeDelete(POLICY_OR_TREE *tree);
+    TPM_RC policyCalcORTreeRoot(TPMT_HA *root,
+				const POLICY_OR_TREE *tree);
+    TPM_RC policyCalcORTreePath(TPML_DIGEST *pHashLists,
+				uint32_t *pathCount,
+				const POLICY_OR_TREE *tree,
+				uint32_t leafIndex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -51,7 +51,12 @@
 #include <ibmtss/tssmarshal.h>
 #include <ibmtss/Unmarshal_fp.h>
 
+#include "attestlib.h"
+
 static void printUsage(void);
+static TPM_RC readNonceList(TPM2B_DIGEST **nonces,
+			    uint32_t *nonceCount,
+			    const char *nonceListFilename);
 
 extern int tssUtilsVerbose;
 
@@ -70,6 +75,11 @@ int main(int argc, char *argv[])
     const char			*signatureFilename = NULL;
     const char			*attestInfoFilename = NULL;
     const char			*qualifyingDataFilename = NULL;
+    const char			*nonceListFilename = NULL;
+    const char			*proofFilenamePrefix = NULL;
+    TPM2B_DIGEST		*nonces = NULL;
+    uint32_t			nonceCount = 0;
+    MERKLE_TREE			*tree = NULL;
     TPM_ALG_ID			sigAlg = TPM_ALG_RSA;
     TPMS_ATTEST 		tpmsAttest;
     TPMI_SH_AUTH_SESSION    	sessionHandle0 = TPM_RS_PW;
@@ -229,6 +239,26 @@ int main(int argc, char *argv[])
 		printUsage();
 	    }
 	}
+	else if (strcmp(argv[i],"-qdl") == 0) {
+	    i++;
+	    if (i < argc) {
+		nonceListFilename = argv[i];
+	    }
+	    else {
+		printf("-qdl option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-op") == 0) {
+	    i++;
+	    if (i < argc) {
+		proofFilenamePrefix = argv[i];
+	    }
+	    else {
+		printf("-op option needs a value\n");
+		printUsage();
+	    }
+	}
 	else if (strcmp(argv[i],"-se0") == 0) {
 	    i++;
 	    if (i < argc) {
@@ -315,6 +345,15 @@ int main(int argc, char *argv[])
 	printf("Missing PCR handle parameter -hp\n");
 	printUsage();
     }
+    if ((nonceListFilename != NULL) && (qualifyingDataFilename != NULL)) {
+	printf("-qd and -qdl cannot both be specified\n");
+	printUsage();
+    }
+    if ((nonceListFilename != NULL) &&
+	((sessionHandle1 != TPM_RH_NULL) || (sessionHandle2 != TPM_RH_NULL))) {
+	printf("-qdl supports only -se0\n");
+	printUsage();
+    }
     if (rc == 0) {
 	/* Handle of key that will perform quoting */
 	in.signHandle = signHandle;
@@ -350,12 +389,15 @@ int main(int argc, char *argv[])
 	    in.qualifyingData.t.size = 0;
 	}
     }
+    if ((rc == 0) && (nonceListFilename != NULL)) {
+	rc = readNonceList(&nonces, &nonceCount, nonceListFilename);	/* freed @1 */
+    }
     /* Start a TSS context */
     if (rc == 0) {
 	rc = TSS_Create(&tssContext);
     }
     /* call TSS to execute the command */
-    if (rc == 0) {
+    if ((rc == 0) && (nonceListFilename == NULL)) {
 	rc = TSS_Execute(tssContext,
 			 (RESPONSE_PARAMETERS *)&out,
 			 (COMMAND_PARAMETERS *)&in,
@@ -366,6 +408,16 @@ int main(int argc, char *argv[])
 			 sessionHandle2, NULL, sessionAttributes2,
 			 TPM_RH_NULL, NULL, 0);
     }
+    /* one quote over the Merkle root of all the nonces */
+    if ((rc == 0) && (nonceListFilename != NULL)) {
+	rc = attestQuoteBatch(tssContext,
+			      &out,
+			      &tree,			/* freed @2 */
+			      &in,
+			      halg,			/* tree hash algorithm */
+			      nonceCount, nonces,
+			      sessionHandle0, keyPassword, sessionAttributes0);
+    }
     {
 	TPM_RC rc1 = TSS_Delete(tssContext);
 	if (rc == 0) {
@@ -398,6 +450,9 @@ int main(int argc, char *argv[])
 				      out.quoted.t.size,
 				      attestInfoFilename);
     }
+    if ((rc == 0) && (tree != NULL) && (proofFilenamePrefix != NULL)) {
+	rc = merkleProofWriteFiles(tree, proofFilenamePrefix);
+    }
     if (rc == 0) {
 	if (tssUtilsVerbose) TSS_TPMT_SIGNATURE_Print(&out.signature, 0);
 	if (tssUtilsVerbose) printf("quote: success\n");
@@ -411,6 +466,56 @@ int main(int argc, char *argv[])
 	printf("%s%s%s\n", msg, submsg, num);
 	rc = EXIT_FAILURE;
     }
+    free(nonces);			/* @1 */
+    merkleTreeDelete(tree);		/* @2 */
+    return rc;
+}
+
+/* readNonceList() reads the verifier nonces, one nonce file name per line */
+
+static TPM_RC readNonceList(TPM2B_DIGEST **nonces,	/* freed by caller */
+			    uint32_t *nonceCount,
+			    const char *nonceListFilename)
+{
+    TPM_RC	rc = 0;
+    FILE	*listFile = NULL;
+    char	line[4096];
+    uint32_t	nonceMax = 0;
+
+    if (rc == 0) {
+	listFile = fopen(nonceListFilename, "r");
+	if (listFile == NULL) {
+	    printf("readNonceList: Error opening %s\n", nonceListFilename);
+	    rc = TSS_RC_FILE_OPEN;
+	}
+    }
+    while ((rc == 0) && (fgets(line, sizeof(line), listFile) != NULL)) {
+	char *filename = strtok(line, " \t\r\n");
+	if (filename == NULL) {
+	    continue;
+	}
+	if (*nonceCount == nonceMax) {
+	    TPM2B_DIGEST *tmp;
+	    nonceMax = (nonceMax == 0) ? 64 : (nonceMax * 2);
+	    /* not TSS_Realloc(), a large batch can exceed its size limit */
+	    tmp = realloc(*nonces, nonceMax * sizeof(TPM2B_DIGEST));
+	    if (tmp == NULL) {
+		printf("readNonceList: Error allocating %u nonces\n", nonceMax);
+		rc = TSS_RC_OUT_OF_MEMORY;
+		break;
+	    }
+	    *nonces = tmp;
+	}
+	rc = TSS_File_Read2B(&(*nonces)[*nonceCount].b,
+			     sizeof((*nonces)[*nonceCount].t.buffer),
+			     filename);
+	if (rc == 0) {
+	    (*nonceCount)++;
+	}
+    }
+    if (listFile != NULL) {
+	fclose(listFile);
+    }
     return rc;
 }
 
@@ -428,6 +533,9 @@ static void printUsage(void)
     printf("\t[-palg\tfor PCR bank selection (sha1, sha256, sha384, sha512) (default sha256)]\n");
     printf("\t[-salg\tsignature algorithm (rsa, ecc, hmac) (default rsa)]\n");
     printf("\t[-qd\tqualifying data file name]\n");
+    printf("\t[-qdl\tlist of verifier nonce file names, one per line]\n");
+    printf("\t\tQuotes once over the Merkle root of the nonces (hashed with -halg)\n");
+    printf("\t[-op\tinclusion proof file name prefix for -qdl, writes prefixN.bin]\n");
     printf("\t[-os\tquote signature file name (default do not save)]\n");
     printf("\t[-oa\tattestation output file name (default do not save)]\n");
     printf("\n");
@@ -0,0 +1,225 @@
+/********************************************************************************/
+/*										*/
+/*			     TPM Random Number Pool				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* TPM random number pool.  See randomlib.h. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tsscrypto.h>
+#include <ibmtss/tssresponsecode.h>
+
+#include "randomlib.h"
+
+extern int tssUtilsVerbose;
+
+static TPM_RC randomPoolFill(RANDOM_POOL *randomPool);
+
+/* randomPoolCreate() allocates a pool of poolSize bytes and fills it.
+
+   watermark is the level below which randomPoolRefill() tops up the pool.  0 means refill only
+   when empty.
+*/
+
+TPM_RC randomPoolCreate(RANDOM_POOL **randomPool,
+			TSS_CONTEXT *tssContext,
+			uint32_t poolSize,
+			uint32_t watermark,
+			int mix)
+{
+    TPM_RC	rc = 0;
+
+    if (rc == 0) {
+	if ((poolSize == 0) || (watermark > poolSize)) {
+	    if (tssUtilsVerbose) printf("randomPoolCreate: Error, bad pool size %u watermark %u\n",
+					poolSize, watermark);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	*randomPool = NULL;
+	rc = TSS_Malloc((uint8_t **)randomPool, sizeof(RANDOM_POOL));	/* freed by
+									   randomPoolDelete */
+    }
+    if (rc == 0) {
+	(*randomPool)->tssContext = tssContext;
+	(*randomPool)->pool = NULL;
+	(*randomPool)->poolSize = poolSize;
+	(*randomPool)->available = 0;
+	(*randomPool)->watermark = watermark;
+	(*randomPool)->mix = mix;
+	(*randomPool)->tpmCommands = 0;
+	rc = TSS_Malloc(&(*randomPool)->pool, poolSize);
+    }
+    if (rc == 0) {
+	rc = randomPoolFill(*randomPool);
+    }
+    if ((rc != 0) && (*randomPool != NULL)) {
+	randomPoolDelete(*randomPool);
+	*randomPool = NULL;
+    }
+    return rc;
+}
+
+/* randomPoolDelete() erases and frees the pool.  It does not delete the TSS_CONTEXT. */
+
+void randomPoolDelete(RANDOM_POOL *randomPool)
+{
+    if (randomPool != NULL) {
+	if (randomPool->pool != NULL) {
+	    memset(randomPool->pool, 0, randomPool->poolSize);
+	}
+	free(randomPool->pool);
+	free(randomPool);
+    }
+    return;
+}
+
+/* randomPoolNeedsRefill() returns TRUE if the pool has fallen below the watermark.  An application
+   can use this to decide whether to call randomPoolRefill() at idle time. */
+
+int randomPoolNeedsRefill(const RANDOM_POOL *randomPool)
+{
+    return ((randomPool->available == 0) ||
+	    (randomPool->available < randomPool->watermark));
+}
+
+/* randomPoolRefill() fills the pool if it has fallen below the watermark */
+
+TPM_RC randomPoolRefill(RANDOM_POOL *randomPool)
+{
+    TPM_RC	rc = 0;
+
+    if (randomPoolNeedsRefill(randomPool)) {
+	rc = randomPoolFill(randomPool);
+    }
+    return rc;
+}
+
+/* randomPoolGet() returns bytes random bytes.
+
+   Bytes are served from the pool.  If the request is larger than the pool contents, the pool is
+   refilled as needed.  Bytes that have been returned are erased from the pool.
+*/
+
+TPM_RC randomPoolGet(RANDOM_POOL *randomPool,
+		     uint8_t *buffer,
+		     size_t bytes)
+{
+    TPM_RC	rc = 0;
+    uint32_t	copyBytes;
+
+    while ((rc == 0) && (bytes > 0)) {
+	if (randomPool->available == 0) {
+	    rc = randomPoolFill(randomPool);
+	}
+	if (rc == 0) {
+	    copyBytes = randomPool->available;
+	    if (copyBytes > bytes) {
+		copyBytes = (uint32_t)bytes;
+	    }
+	    /* take from the end of the valid bytes, so the remaining bytes do not move */
+	    randomPool->available -= copyBytes;
+	    memcpy(buffer, randomPool->pool + randomPool->available, copyBytes);
+	    memset(randomPool->pool + randomPool->available, 0, copyBytes);
+	    buffer += copyBytes;
+	    bytes -= copyBytes;
+	}
+    }
+    return rc;
+}
+
+/* randomPoolFill() fills the pool to poolSize using maximum size TPM2_GetRandom() commands,
+   optionally mixing in the crypto library DRBG output. */
+
+static TPM_RC randomPoolFill(RANDOM_POOL *randomPool)
+{
+    TPM_RC		rc = 0;
+    GetRandom_In 	in;
+    GetRandom_Out 	out;
+    uint32_t		fillBytes;
+    uint8_t		drbgBytes[sizeof(out.randomBytes.t.buffer)];
+
+    while ((rc == 0) && (randomPool->available < randomPool->poolSize)) {
+	/* ask for the maximum the response can hold, the TPM may return less */
+	if (rc == 0) {
+	    in.bytesRequested = sizeof(out.randomBytes.t.buffer);
+	    rc = TSS_Execute(randomPool->tssContext,
+			     (RESPONSE_PARAMETERS *)&out,
+			     (COMMAND_PARAMETERS *)&in,
+			     NULL,
+			     TPM_CC_GetRandom,
+			     TPM_RH_NULL, NULL, 0);
+	    randomPool->tpmCommands++;
+	}
+	if (rc == 0) {
+	    if (out.randomBytes.t.size == 0) {
+		if (tssUtilsVerbose) printf("randomPoolFill: Error, TPM returned no bytes\n");
+		rc = TSS_RC_RNG_FAILURE;
+	    }
+	}
+	if (rc == 0) {
+	    fillBytes = randomPool->poolSize - randomPool->available;
+	    if (fillBytes > out.randomBytes.t.size) {
+		fillBytes = out.randomBytes.t.size;
+	    }
+	    if (randomPool->mix) {
+		rc = TSS_RandBytes(drbgBytes, fillBytes);
+		if (rc == 0) {
+		    TSS_XOR(out.randomBytes.t.buffer, out.randomBytes.t.buffer, drbgBytes,
+			    fillBytes);
+		}
+	    }
+	}
+	if (rc == 0) {
+	    memcpy(randomPool->pool + randomPool->available, out.randomBytes.t.buffer, fillBytes);
+	    randomPool->available += fillBytes;
+	}
+	memset(out.randomBytes.t.buffer, 0, sizeof(out.randomBytes.t.buffer));
+	memset(drbgBytes, 0, sizeof(drbgBytes));
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("randomPoolFill: %u bytes available after %u commands\n",
+				    randomPool->available, randomPool->tpmCommands);
+    }
+    return rc;
+}
@@ -0,0 +1,91 @@
+/********************************************************************************/
+/*										*/
+/*			     TPM Random Number Pool				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* A RANDOM_POOL buffers TPM random bytes so that an application needing many random bytes does not
+   send a TPM2_GetRandom() for each request.
+
+   The pool is filled using TPM2_GetRandom() requests of the maximum size the TPM returns.  Requests
+   of any size are served from memory.  When the pool drops below the low watermark,
+   randomPoolRefill() tops it up.  Call it when the application is otherwise idle, so that the TPM
+   round trips are off the critical path.
+
+   If mix is TRUE, the TPM bytes are XORed with bytes from the crypto library DRBG, so that the
+   output is no weaker than either source.
+
+   A RANDOM_POOL uses the TSS_CONTEXT passed at creation.  Like the TSS_CONTEXT, it is not thread
+   safe.
+*/
+
+#ifndef RANDOMLIB_H
+#define RANDOMLIB_H
+
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+
+typedef struct {
+    TSS_CONTEXT	*tssContext;	/* not owned by the pool */
+    uint8_t	*pool;
+    uint32_t	poolSize;	/* bytes allocated */
+    uint32_t	available;	/* unused bytes, at the start of pool */
+    uint32_t	watermark;	/* randomPoolRefill() fills when available is below this */
+    int		mix;		/* TRUE to XOR with the crypto library DRBG */
+    uint32_t	tpmCommands;	/* TPM2_GetRandom() commands sent, for tuning */
+} RANDOM_POOL;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    TPM_RC randomPoolCreate(RANDOM_POOL **randomPool,
+			    TSS_CONTEXT *tssContext,
+			    uint32_t poolSize,
+			    uint32_t watermark,
+			    int mix);
+    void randomPoolDelete(RANDOM_POOL *randomPool);
+    TPM_RC randomPoolRefill(RANDOM_POOL *randomPool);
+    int randomPoolNeedsRefill(const RANDOM_POOL *randomPool);
+    TPM_RC randomPoolGet(RANDOM_POOL *randomPool,
+			 uint8_t *buffer,
+			 size_t bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -79,6 +79,10 @@ IF !ERRORLEVEL! NEQ 0 (
    exit /B 1
 )
 
+echo policies/aaa> tmpnonces.txt
+echo policies/policyccquote.bin>> tmpnonces.txt
+echo policies/policyccsign.bin>> tmpnonces.txt
+
 for %%S in ("" "-se0 02000000 1") do (
 
     for %%H in (%ITERATE_ALGS%) do (
@@ -179,6 +183,75 @@ IF !ERRORLEVEL! NEQ 0 (
    exit /B 1
 )
 
+echo ""
+echo "Attestation verified in software"
+echo ""
+
+for %%A in (rsa ecc) do (
+
+    IF "%%A" == "rsa" (
+       set KEY=signrsa2048
+    )
+    IF "%%A" == "ecc" (
+       set KEY=signeccnistp256
+    )
+
+    echo "Load the %%A restricted signing key under the primary key"
+    %TPM_EXE_PATH%load -hp 80000000 -ipr !KEY!rpriv.bin -ipu !KEY!rpub.bin -pwdp sto > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+       exit /B 1
+    )
+
+    echo "Quote sha256 %%A"
+    %TPM_EXE_PATH%quote -hp 0 -hk 80000001 -halg sha256 -palg sha256 -pwdk sig -os sig.bin -oa tmp.bin -qd policies/aaa -salg %%A > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+       exit /B 1
+    )
+
+    echo "Verify the %%A quote in software"
+    %TPM_EXE_PATH%verifyattest -ia tmp.bin -is sig.bin -ipu !KEY!rpub.bin -qd policies/aaa -type quote > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+       exit /B 1
+    )
+
+    echo "Verify the %%A quote with an unrestricted key - should fail"
+    %TPM_EXE_PATH%verifyattest -ia tmp.bin -is sig.bin -ipu !KEY!pub.bin -qd policies/aaa -type quote > run.out
+    IF !ERRORLEVEL! EQU 0 (
+       exit /B 1
+    )
+
+    echo "Verify the %%A quote with trailing bytes - should fail"
+    copy /b tmp.bin + policies\aaa tmpattest.bin > nul
+    %TPM_EXE_PATH%verifyattest -ia tmpattest.bin -is sig.bin -ipu !KEY!rpub.bin -qd policies/aaa -type quote > run.out
+    IF !ERRORLEVEL! EQU 0 (
+       exit /B 1
+    )
+
+    echo "Batch quote three nonces %%A"
+    %TPM_EXE_PATH%quote -hp 0 -hk 80000001 -halg sha256 -palg sha256 -pwdk sig -os sig.bin -oa tmp.bin -qdl tmpnonces.txt -op tmpproof -salg %%A > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+       exit /B 1
+    )
+
+    echo "Verify the second nonce against the batch quote"
+    %TPM_EXE_PATH%verifyattest -ia tmp.bin -is sig.bin -ipu !KEY!rpub.bin -qd policies/policyccquote.bin -ipr tmpproof1.bin -type quote > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+       exit /B 1
+    )
+
+    echo "Verify the first nonce with the second proof - should fail"
+    %TPM_EXE_PATH%verifyattest -ia tmp.bin -is sig.bin -ipu !KEY!rpub.bin -qd policies/aaa -ipr tmpproof1.bin -type quote > run.out
+    IF !ERRORLEVEL! EQU 0 (
+       exit /B 1
+    )
+
+    echo "Flush the %%A restricted signing key"
+    %TPM_EXE_PATH%flushcontext -ha 80000001 > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+       exit /B 1
+    )
+)
+
 echo ""
 echo "Attestation with an HMAC key"
 echo ""
@@ -411,7 +484,7 @@ for %%S in ("" "-se0 02000000 1") do (
        )
     
        echo "Get Session Audit Digest %%~S"
-       %TPM_EXE_PATH%getsessionauditdigest -hs 02000001 -hk 80000001 -pwdk sig -os sig.bin -oa tmp.bin %%~S -qd policies/aaa > run.out
+       %TPM_EXE_PATH%getsessionauditdigest -hs 02000001 -hk 80000001 -pwdk sig -os sig.bin -oa tmp.bin -ca %%~S -qd policies/aaa > run.out
        IF !ERRORLEVEL! NEQ 0 (
            exit /B 1
        )
@@ -573,6 +646,11 @@ rm -f tmpdigestr.bin
 rm -f tmpdigestg.bin
 rm -f sig.bin
 rm -f tmp.bin
+rm -f tmpattest.bin
+rm -f tmpnonces.txt
+rm -f tmpproof0.bin
+rm -f tmpproof1.bin
+rm -f tmpproof2.bin
 rm -f tmpcert.bin
 rm -f tmphkey.bin
 
@@ -72,6 +72,8 @@ echo "Start an HMAC session"
 ${PREFIX}startauthsession -se h > run.out
 checkSuccess $?
 
+printf "policies/aaa\npolicies/policyccquote.bin\npolicies/policyccsign.bin\n" > tmpnonces.txt
+
 for SESS in "" "-se0 02000000 1"
 do
     for HALG in ${ITERATE_ALGS}
@@ -146,6 +148,58 @@ echo "Flush the auth session"
 ${PREFIX}flushcontext -ha 02000000 > run.out
 checkSuccess $?
 
+echo ""
+echo "Attestation verified in software"
+echo ""
+
+for SALG in rsa ecc
+do
+
+    if [ ${SALG} == rsa ]; then
+	KEY=signrsa2048
+    else
+	KEY=signeccnistp256
+    fi
+
+    echo "Load the ${SALG} restricted signing key under the primary key"
+    ${PREFIX}load -hp 80000000 -ipr ${KEY}rpriv.bin -ipu ${KEY}rpub.bin -pwdp sto > run.out
+    checkSuccess $?
+
+    echo "Quote sha256 ${SALG}"
+    ${PREFIX}quote -hp 0 -hk 80000001 -halg sha256 -palg sha256 -pwdk sig -os sig.bin -oa tmp.bin -qd policies/aaa -salg ${SALG} > run.out
+    checkSuccess $?
+
+    echo "Verify the ${SALG} quote in software"
+    ${PREFIX}verifyattest -ia tmp.bin -is sig.bin -ipu ${KEY}rpub.bin -qd policies/aaa -type quote > run.out
+    checkSuccess $?
+
+    echo "Verify the ${SALG} quote with an unrestricted key - should fail"
+    ${PREFIX}verifyattest -ia tmp.bin -is sig.bin -ipu ${KEY}pub.bin -qd policies/aaa -type quote > run.out
+    checkFailure $?
+
+    echo "Verify the ${SALG} quote with trailing bytes - should fail"
+    cat tmp.bin policies/aaa > tmpattest.bin
+    ${PREFIX}verifyattest -ia tmpattest.bin -is sig.bin -ipu ${KEY}rpub.bin -qd policies/aaa -type quote > run.out
+    checkFailure $?
+
+    echo "Batch quote three nonces ${SALG}"
+    ${PREFIX}quote -hp 0 -hk 80000001 -halg sha256 -palg sha256 -pwdk sig -os sig.bin -oa tmp.bin -qdl tmpnonces.txt -op tmpproof -salg ${SALG} > run.out
+    checkSuccess $?
+
+    echo "Verify the second nonce against the batch quote"
+    ${PREFIX}verifyattest -ia tmp.bin -is sig.bin -ipu ${KEY}rpub.bin -qd policies/policyccquote.bin -ipr tmpproof1.bin -type quote > run.out
+    checkSuccess $?
+
+    echo "Verify the first nonce with the second proof - should fail"
+    ${PREFIX}verifyattest -ia tmp.bin -is sig.bin -ipu ${KEY}rpub.bin -qd policies/aaa -ipr tmpproof1.bin -type quote > run.out
+    checkFailure $?
+
+    echo "Flush the ${SALG} restricted signing key"
+    ${PREFIX}flushcontext -ha 80000001 > run.out
+    checkSuccess $?
+
+done
+
 echo ""
 echo "Attestation with an HMAC key"
 echo ""
@@ -317,7 +371,7 @@ do
 	checkSuccess $?
 
 	echo "Get Session Audit Digest ${SESS}"
-	${PREFIX}getsessionauditdigest -hs 02000001 -hk 80000001 -pwdk sig -os sig.bin -oa tmp.bin ${SESS} -qd policies/aaa > run.out
+	${PREFIX}getsessionauditdigest -hs 02000001 -hk 80000001 -pwdk sig -os sig.bin -oa tmp.bin -ca ${SESS} -qd policies/aaa > run.out
 	checkSuccess $?
 
 	echo "Verify the signature"
@@ -433,6 +487,11 @@ rm -f tmpdigestr.bin
 rm -f tmpdigestg.bin
 rm -f sig.bin
 rm -f tmp.bin
+rm -f tmpattest.bin
+rm -f tmpnonces.txt
+rm -f tmpproof0.bin
+rm -f tmpproof1.bin
+rm -f tmpproof2.bin
 rm -f tmphkey.bin
 rm -f tmpcert.bin
 
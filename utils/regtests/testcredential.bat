@@ -104,6 +104,36 @@ IF !ERRORLEVEL! NEQ 0 (
    exit /B 1
 )
 
+echo "Encrypt the credential in software using makecredential"
+%TPM_EXE_PATH%makecredential -ipu storersa2048pub.bin -icred tmpcredin.bin -in h80000002.bin -ocred tmpcredenc.bin -os tmpsecret.bin -v > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Start a policy session"
+%TPM_EXE_PATH%startauthsession -se p > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Policy command code - activatecredential"
+%TPM_EXE_PATH%policycommandcode -ha 03000000 -cc 00000147 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Activate the software credential"
+%TPM_EXE_PATH%activatecredential -ha 80000002 -hk 80000001 -icred tmpcredenc.bin -is tmpsecret.bin -pwdk sto -ocred tmpcreddec.bin -se0 03000000 0 -v > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Check the decrypted result"
+diff tmpcredin.bin tmpcreddec.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
 echo "Flush the storage key"
 %TPM_EXE_PATH%flushcontext -ha 80000001 > run.out
 IF !ERRORLEVEL! NEQ 0 (
@@ -116,6 +146,60 @@ IF !ERRORLEVEL! NEQ 0 (
    exit /B 1
 )
 
+echo "Create an ECC nistp256 endorsement primary key as the EK, 80000001"
+%TPM_EXE_PATH%createprimary -hi e -ecc nistp256 -st -opu tmpekpub.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Load the signing key under the storage primary key, 80000002"
+%TPM_EXE_PATH%load -hp 80000000 -ipr tmprpriv.bin -ipu tmprpub.bin -pwdp sto > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Encrypt the credential in software to the ECC EK using makecredential"
+%TPM_EXE_PATH%makecredential -ipu tmpekpub.bin -icred tmpcredin.bin -in h80000002.bin -ocred tmpcredenc.bin -os tmpsecret.bin -v > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Start a policy session"
+%TPM_EXE_PATH%startauthsession -se p > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Policy command code - activatecredential"
+%TPM_EXE_PATH%policycommandcode -ha 03000000 -cc 00000147 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Activate the software credential with the ECC EK"
+%TPM_EXE_PATH%activatecredential -ha 80000002 -hk 80000001 -icred tmpcredenc.bin -is tmpsecret.bin -ocred tmpcreddec.bin -se0 03000000 0 -v > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Check the decrypted result"
+diff tmpcredin.bin tmpcreddec.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Flush the ECC EK"
+%TPM_EXE_PATH%flushcontext -ha 80000001 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Flush the signing key"
+%TPM_EXE_PATH%flushcontext -ha 80000002 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
 echo ""
 echo "EK Certificate"
 echo ""
@@ -282,6 +366,18 @@ for /L %%i in (1,1,!L!) do (
         exit /B 1
     )
 
+    echo "Validate the !CALG[%%i]! EK certificate against a cached and reloaded CA store"
+    %TPM_EXE_PATH%createek -high -rsa !CALG[%%i]! -root certificates/rootcerts.windows.txt -cache > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+        exit /B 1
+    )
+
+    echo "Check that the second validation was cached and the reload invalidated the cache"
+    findstr /C:"generation 2 cache hits 1 misses 2" run.out > nul
+    IF !ERRORLEVEL! NEQ 0 (
+        exit /B 1
+    )
+
     echo "Create a signing key under the !CALG[%%i]! EK using the password"
     %TPM_EXE_PATH%create -hp 80000001 -si -pwdp kkk > run.out
     IF !ERRORLEVEL! NEQ 0 (
@@ -452,6 +548,18 @@ for /L %%i in (1,1,!L!) do (
         exit /B 1
     )
 
+    echo "Validate the !CALG[%%i]! EK certificate against a cached and reloaded CA store"
+    %TPM_EXE_PATH%createek -high -ecc !CALG[%%i]! -root certificates/rootcerts.windows.txt -cache > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+        exit /B 1
+    )
+
+    echo "Check that the second validation was cached and the reload invalidated the cache"
+    findstr /C:"generation 2 cache hits 1 misses 2" run.out > nul
+    IF !ERRORLEVEL! NEQ 0 (
+        exit /B 1
+    )
+
     echo "Create a signing key under the !CALG[%%i]! EK using the password"
     %TPM_EXE_PATH%create -hp 80000001 -si -pwdp kkk > run.out
     IF !ERRORLEVEL! NEQ 0 (
@@ -667,6 +775,18 @@ for %%A in ("-rsa 2048" "-ecc nistp256") do (
         exit /B 1
     )
 
+    echo "Validate the %%~A EK certificate against a cached and reloaded CA store"
+    %TPM_EXE_PATH%createek %%~A -root certificates/rootcerts.windows.txt -cache > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+        exit /B 1
+    )
+
+    echo "Check that the second validation was cached and the reload invalidated the cache"
+    findstr /C:"generation 2 cache hits 1 misses 2" run.out > nul
+    IF !ERRORLEVEL! NEQ 0 (
+        exit /B 1
+    )
+
     echo "Start a policy session"
     %TPM_EXE_PATH%startauthsession -se p > run.out
     IF !ERRORLEVEL! NEQ 0 (
@@ -705,6 +825,30 @@ for %%A in ("-rsa 2048" "-ecc nistp256") do (
 
 )
 
+echo "Create the RSA EK certificate from a device list"
+echo tpm0 > tmpdevices.txt
+rm -f tmpresume.txt
+%TPM_EXE_PATH%createekcert -rsa 2048 -cakey cakey.pem -capwd rrrr -pwdp ppp -pwde eee -il tmpdevices.txt -rf tmpresume.txt -of tmp > run.out
+IF !ERRORLEVEL! NEQ 0 (
+    exit /B 1
+)
+
+echo "Read the RSA EK certificate"
+%TPM_EXE_PATH%createek -rsa 2048 -ce > run.out
+IF !ERRORLEVEL! NEQ 0 (
+    exit /B 1
+)
+
+echo "Resume the device list, tpm0 is already provisioned"
+%TPM_EXE_PATH%createekcert -rsa 2048 -cakey cakey.pem -capwd rrrr -pwdp ppp -pwde eee -il tmpdevices.txt -rf tmpresume.txt > run.out
+IF !ERRORLEVEL! NEQ 0 (
+    exit /B 1
+)
+findstr /C:"0 issued, 1 skipped, 0 failed" run.out > nul
+IF !ERRORLEVEL! NEQ 0 (
+    exit /B 1
+)
+
 echo "Clear platform hierarchy auth"
  %TPM_EXE_PATH%hierarchychangeauth -hi p -pwda ppp > run.out
  IF !ERRORLEVEL! NEQ 0 (
@@ -738,9 +882,13 @@ echo "Low range EK certificates are now provisioned in NV"
 echo ""
 
 rm -f tmp.der
+rm -f tmptpm0.der
+rm -f tmpdevices.txt
+rm -f tmpresume.txt
 rm -r tmpcredin.bin
 rm -f tmprpriv.bin 
 rm -f tmprpub.bin
+rm -f tmpekpub.bin
 rm -f tmpcredenc.bin
 rm -f tmpsecret.bin
 rm -f tmpcreddec.bin
@@ -87,6 +87,26 @@ echo "Check the decrypted result"
 diff tmpcredin.bin tmpcreddec.bin > run.out
 checkSuccess $?
 
+echo "Encrypt the credential in software using makecredential"
+${PREFIX}makecredential -ipu storersa2048pub.bin -icred tmpcredin.bin -in h80000002.bin -ocred tmpcredenc.bin -os tmpsecret.bin -v > run.out
+checkSuccess $?
+
+echo "Start a policy session"
+${PREFIX}startauthsession -se p > run.out
+checkSuccess $?
+
+echo "Policy command code - activatecredential"
+${PREFIX}policycommandcode -ha 03000000 -cc 00000147 > run.out
+checkSuccess $?
+
+echo "Activate the software credential"
+${PREFIX}activatecredential -ha 80000002 -hk 80000001 -icred tmpcredenc.bin -is tmpsecret.bin -pwdk sto -ocred tmpcreddec.bin -se0 03000000 0 -v > run.out
+checkSuccess $?
+
+echo "Check the decrypted result"
+diff tmpcredin.bin tmpcreddec.bin > run.out
+checkSuccess $?
+
 echo "Flush the storage key"
 ${PREFIX}flushcontext -ha 80000001 > run.out
 checkSuccess $?
@@ -95,6 +115,42 @@ echo "Flush the signing key"
 ${PREFIX}flushcontext -ha 80000002 > run.out
 checkSuccess $?
 
+echo "Create an ECC nistp256 endorsement primary key as the EK, 80000001"
+${PREFIX}createprimary -hi e -ecc nistp256 -st -opu tmpekpub.bin > run.out
+checkSuccess $?
+
+echo "Load the signing key under the storage primary key, 80000002"
+${PREFIX}load -hp 80000000 -ipr tmprpriv.bin -ipu tmprpub.bin -pwdp sto > run.out
+checkSuccess $?
+
+echo "Encrypt the credential in software to the ECC EK using makecredential"
+${PREFIX}makecredential -ipu tmpekpub.bin -icred tmpcredin.bin -in h80000002.bin -ocred tmpcredenc.bin -os tmpsecret.bin -v > run.out
+checkSuccess $?
+
+echo "Start a policy session"
+${PREFIX}startauthsession -se p > run.out
+checkSuccess $?
+
+echo "Policy command code - activatecredential"
+${PREFIX}policycommandcode -ha 03000000 -cc 00000147 > run.out
+checkSuccess $?
+
+echo "Activate the software credential with the ECC EK"
+${PREFIX}activatecredential -ha 80000002 -hk 80000001 -icred tmpcredenc.bin -is tmpsecret.bin -ocred tmpcreddec.bin -se0 03000000 0 -v > run.out
+checkSuccess $?
+
+echo "Check the decrypted result"
+diff tmpcredin.bin tmpcreddec.bin > run.out
+checkSuccess $?
+
+echo "Flush the ECC EK"
+${PREFIX}flushcontext -ha 80000001 > run.out
+checkSuccess $?
+
+echo "Flush the signing key"
+${PREFIX}flushcontext -ha 80000002 > run.out
+checkSuccess $?
+
 # The low EK certificates remain in NV at the end of the test.  This
 # makes the test, when run stand alone, useful for provisioning a TPM.
 # It is not useful when the entire regression test runs, because a
@@ -335,6 +391,14 @@ NVNAME=(
 	${PREFIX}createek -high ${CALG[i]} -root certificates/rootcerts.txt > run.out
 	checkSuccess $?
 
+	echo "Validate the ${CALG[i]} EK certificate against a cached and reloaded CA store"
+	${PREFIX}createek -high ${CALG[i]} -root certificates/rootcerts.txt -cache > run.out
+	checkSuccess $?
+
+	echo "Check that the second validation was cached and the reload invalidated the cache"
+	grep -q "generation 2 cache hits 1 misses 2" run.out
+	checkSuccess $?
+
 	echo "Create a signing key under the ${CALG[i]} EK using the password"
 	${PREFIX}create -hp 80000001 -si -pwdp kkk > run.out
 	checkSuccess $?
@@ -449,6 +513,14 @@ NVNAME=(
 	${PREFIX}createek -high ${CALG[i]} -root certificates/rootcerts.txt > run.out
 	checkSuccess $?
 
+	echo "Validate the ${CALG[i]} EK certificate against a cached and reloaded CA store"
+	${PREFIX}createek -high ${CALG[i]} -root certificates/rootcerts.txt -cache > run.out
+	checkSuccess $?
+
+	echo "Check that the second validation was cached and the reload invalidated the cache"
+	grep -q "generation 2 cache hits 1 misses 2" run.out
+	checkSuccess $?
+
 	echo "Create a signing key under the ${CALG[i]} EK using the password"
 	${PREFIX}create -hp 80000001 -si -pwdp kkk > run.out
 	checkSuccess $?
@@ -599,6 +671,14 @@ NVNAME=(
 	${PREFIX}createek ${ALG} -root certificates/rootcerts.txt > run.out
 	checkSuccess $?
 
+	echo "Validate the ${ALG} EK certificate against a cached and reloaded CA store"
+	${PREFIX}createek ${ALG} -root certificates/rootcerts.txt -cache > run.out
+	checkSuccess $?
+
+	echo "Check that the second validation was cached and the reload invalidated the cache"
+	grep -q "generation 2 cache hits 1 misses 2" run.out
+	checkSuccess $?
+
 	echo "Start a policy session"
 	${PREFIX}startauthsession -se p > run.out
 	checkSuccess $?
@@ -625,6 +705,22 @@ NVNAME=(
 
     done
 
+    echo "Create the RSA EK certificate from a device list"
+    echo "tpm0" > tmpdevices.txt
+    rm -f tmpresume.txt
+    ${PREFIX}createekcert -rsa 2048 -cakey cakey.pem -capwd rrrr -pwdp ppp -pwde eee -il tmpdevices.txt -rf tmpresume.txt -of tmp > run.out
+    checkSuccess $?
+
+    echo "Read the RSA EK certificate"
+    ${PREFIX}createek -rsa 2048 -ce > run.out
+    checkSuccess $?
+
+    echo "Resume the device list, tpm0 is already provisioned"
+    ${PREFIX}createekcert -rsa 2048 -cakey cakey.pem -capwd rrrr -pwdp ppp -pwde eee -il tmpdevices.txt -rf tmpresume.txt > run.out
+    checkSuccess $?
+    grep -q "0 issued, 1 skipped, 0 failed" run.out
+    checkSuccess $?
+
     echo "Clear platform hierarchy auth"
     ${PREFIX}hierarchychangeauth -hi p -pwda ppp > run.out
     checkSuccess $?
@@ -654,9 +750,13 @@ echo "Low range EK certificates are now provisioned in NV"
 echo ""
 
 rm -f tmp.der
+rm -f tmptpm0.der
+rm -f tmpdevices.txt
+rm -f tmpresume.txt
 rm -r tmpcredin.bin
 rm -f tmprpriv.bin 
 rm -f tmprpub.bin
+rm -f tmpekpub.bin
 rm -f tmpcredenc.bin
 rm -f tmpsecret.bin
 rm -f tmpcreddec.bin
@@ -161,4 +161,48 @@ IF !ERRORLEVEL! NEQ 0 (
    exit /B 1
 )
 
+echo ""
+echo "Incremental Self Test"
+echo ""
+
+echo "Incremental self test, read the toDoList"
+%TPM_EXE_PATH%incrementalselftest > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Incremental self test, RSA, SHA-256, AES, one algorithm per step"
+%TPM_EXE_PATH%incrementalselftest -alg rsa -alg sha256 -alg aes -bs 1 -idle 10 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+findstr /C:"commands, complete" run.out > nul
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Incremental self test, all at once"
+%TPM_EXE_PATH%incrementalselftest -alg ecc -alg ecdsa -alg sha384 -alg hmac -idle 10 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+findstr /C:"commands, complete" run.out > nul
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Incremental self test, an unimplemented algorithm is not tested"
+%TPM_EXE_PATH%incrementalselftest -alg sha256 -alg 00ff -idle 10 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+findstr /C:"unsupported" run.out > nul
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+findstr /C:"commands, complete" run.out > nul
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
 exit /B 0
@@ -124,4 +124,31 @@ echo "Get Capability TPM_CAP_ACT"
 ${PREFIX}getcapability -cap a -pr 40000110 -v > run.out
 checkSuccess $?
 
+echo ""
+echo "Incremental Self Test"
+echo ""
+
+echo "Incremental self test, read the toDoList"
+${PREFIX}incrementalselftest > run.out
+checkSuccess $?
+
+echo "Incremental self test, RSA, SHA-256, AES, one algorithm per step"
+${PREFIX}incrementalselftest -alg rsa -alg sha256 -alg aes -bs 1 -idle 10 > run.out
+checkSuccess $?
+grep -q "commands, complete" run.out
+checkSuccess $?
+
+echo "Incremental self test, all at once"
+${PREFIX}incrementalselftest -alg ecc -alg ecdsa -alg sha384 -alg hmac -idle 10 > run.out
+checkSuccess $?
+grep -q "commands, complete" run.out
+checkSuccess $?
+
+echo "Incremental self test, an unimplemented algorithm is not tested"
+${PREFIX}incrementalselftest -alg sha256 -alg 00ff -idle 10 > run.out
+checkSuccess $?
+grep -q "unsupported" run.out
+checkSuccess $?
+grep -q "commands, complete" run.out
+checkSuccess $?
 
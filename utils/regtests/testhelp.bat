@@ -13806,6 +13806,78 @@ IF !ERRORLEVEL! EQU 0 (
    exit /B 1
 )
 
+echo "incrementalselftest"
+%TPM_EXE_PATH%incrementalselftest -v -h > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "incrementalselftest"
+%TPM_EXE_PATH%incrementalselftest -v -xxxxx > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "verifyattest"
+%TPM_EXE_PATH%verifyattest -v -h > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "verifyattest"
+%TPM_EXE_PATH%verifyattest -v -xxxxx > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "policycalc"
+%TPM_EXE_PATH%policycalc -v -h > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "policycalc"
+%TPM_EXE_PATH%policycalc -v -xxxxx > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "tssbench"
+%TPM_EXE_PATH%tssbench -v -h > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "tssbench"
+%TPM_EXE_PATH%tssbench -v -xxxxx > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "testprepared"
+%TPM_EXE_PATH%testprepared -h > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "testprepared"
+%TPM_EXE_PATH%testprepared -xxxxx > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "tpmbench"
+%TPM_EXE_PATH%tpmbench -v -h > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
+echo "tpmbench"
+%TPM_EXE_PATH%tpmbench -v -xxxxx > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
 REM # cleanup
 
 rm -rf tmp.bin
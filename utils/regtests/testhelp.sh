@@ -9236,6 +9236,78 @@ echo "zgen2phase"
 ${PREFIX}zgen2phase -pwd > run.out
 checkFailure $?
 
+echo "incrementalselftest"
+${PREFIX}incrementalselftest -v -h > run.out
+checkFailure $?
+
+echo "incrementalselftest"
+${PREFIX}incrementalselftest -v -xxxxx > run.out
+checkFailure $?
+
+echo "verifyattest"
+${PREFIX}verifyattest -v -h > run.out
+checkFailure $?
+
+echo "verifyattest"
+${PREFIX}verifyattest -v -xxxxx > run.out
+checkFailure $?
+
+echo "signd"
+${PREFIX}signd -v -h > run.out
+checkFailure $?
+
+echo "signd"
+${PREFIX}signd -v -xxxxx > run.out
+checkFailure $?
+
+echo "policycalc"
+${PREFIX}policycalc -v -h > run.out
+checkFailure $?
+
+echo "policycalc"
+${PREFIX}policycalc -v -xxxxx > run.out
+checkFailure $?
+
+echo "tssbench"
+${PREFIX}tssbench -v -h > run.out
+checkFailure $?
+
+echo "tssbench"
+${PREFIX}tssbench -v -xxxxx > run.out
+checkFailure $?
+
+echo "testprepared"
+${PREFIX}testprepared -h > run.out
+checkFailure $?
+
+echo "testprepared"
+${PREFIX}testprepared -xxxxx > run.out
+checkFailure $?
+
+echo "testtsshpp"
+${PREFIX}testtsshpp -h > run.out
+checkFailure $?
+
+echo "testtsshpp"
+${PREFIX}testtsshpp -xxxxx > run.out
+checkFailure $?
+
+echo "tpmbench"
+${PREFIX}tpmbench -v -h > run.out
+checkFailure $?
+
+echo "tpmbench"
+${PREFIX}tpmbench -v -xxxxx > run.out
+checkFailure $?
+
+echo "tsstool"
+${PREFIX}tsstool -h > run.out
+checkFailure $?
+
+echo "tsstool"
+${PREFIX}tsstool -xxxxx > run.out
+checkFailure $?
+
 # cleanup
 
 rm -rf tmp.bin
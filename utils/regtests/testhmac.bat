@@ -54,6 +54,14 @@ REM loaded HMAC key 80000001
 REM primary HMAC key 80000001
 REM sequence object 80000002
 
+echo "Create a 1024 byte message and a message larger than one TPM chunk"
+copy /b msg.bin tmp1k.bin > nul
+for /L %%I in (1,1,6) do (
+    copy /b tmp1k.bin+tmp1k.bin tmp1.bin > nul
+    move /y tmp1.bin tmp1k.bin > nul
+)
+copy /b tmp1k.bin+tmp1k.bin+tmp1k.bin+tmp1k.bin+msg.bin tmpbig.bin > nul
+
 for %%H in (%ITERATE_ALGS%) do (
 
     for %%S in ("" "-se0 02000000 1") do (
@@ -94,6 +102,60 @@ for %%H in (%ITERATE_ALGS%) do (
 	   exit /B 1
 	)
 
+	echo "HMAC %%H using the keyed hash key, message from file as a sequence %%~S"
+	%TPM_EXE_PATH%hmac -hk 80000001 -if msg.bin -os sig.bin -pwdk khk -halg %%H -seq %%~S > run.out
+	IF !ERRORLEVEL! NEQ 0 (
+	   exit /B 1
+	)
+
+	echo "Verify the HMAC %%H using the two methods"
+	diff sig.bin tmp.bin > run.out
+	IF !ERRORLEVEL! NEQ 0 (
+	   exit /B 1
+	)
+
+	echo "HMAC %%H start using the keyed hash key, large message %%~S"
+	%TPM_EXE_PATH%hmacstart -hk 80000001 -pwdk khk -pwda aaa %%~S -halg %%H > run.out
+	IF !ERRORLEVEL! NEQ 0 (
+	   exit /B 1
+	)
+
+	for /L %%I in (1,1,4) do (
+	    echo "HMAC %%H sequence update, 1024 bytes %%~S"
+	    %TPM_EXE_PATH%sequenceupdate -hs 80000002 -pwds aaa -if tmp1k.bin %%~S > run.out
+	    IF !ERRORLEVEL! NEQ 0 (
+	       exit /B 1
+	    )
+	)
+
+	echo "HMAC %%H sequence complete, large message %%~S"
+	%TPM_EXE_PATH%sequencecomplete -hs 80000002 -pwds aaa -if msg.bin -of tmp2.bin %%~S > run.out
+	IF !ERRORLEVEL! NEQ 0 (
+	   exit /B 1
+	)
+
+	echo "HMAC %%H using the keyed hash key, large message as a multi-chunk sequence %%~S"
+	%TPM_EXE_PATH%hmac -hk 80000001 -if tmpbig.bin -os tmp3.bin -pwdk khk -halg %%H -seq %%~S -v > run.out
+	IF !ERRORLEVEL! NEQ 0 (
+	   exit /B 1
+	)
+	findstr /C:"4112 bytes" run.out > nul
+	IF !ERRORLEVEL! NEQ 0 (
+	   exit /B 1
+	)
+
+	echo "Verify the large message HMAC %%H using the two methods"
+	diff tmp3.bin tmp2.bin > run.out
+	IF !ERRORLEVEL! NEQ 0 (
+	   exit /B 1
+	)
+
+	echo "HMAC %%H as a sequence with a -se1 session - should fail"
+	%TPM_EXE_PATH%hmac -hk 80000001 -if msg.bin -pwdk khk -halg %%H -seq -se1 02000000 1 > run.out
+	IF !ERRORLEVEL! EQU 0 (
+	   exit /B 1
+	)
+
 	echo "HMAC %%H using the keyed hash key, message from command line %%~S"
 	%TPM_EXE_PATH%hmac -hk 80000001 -ic 1234567890123456 -os sig.bin -pwdk khk -halg %%H %%~S > run.out
 	IF !ERRORLEVEL! NEQ 0 (
@@ -327,6 +389,10 @@ IF !ERRORLEVEL! NEQ 0 (
 )
 
 rm tkt.bin
+rm tmp1k.bin
+rm tmpbig.bin
+rm tmp2.bin
+rm tmp3.bin
 
 exit /B 0
 
@@ -53,6 +53,15 @@ checkSuccess $?
 # primary HMAC key 80000001
 # sequence object 80000002
 
+echo "Create a 1024 byte message and a message larger than one TPM chunk"
+cp msg.bin tmp1k.bin
+for I in 1 2 3 4 5 6
+do
+    cat tmp1k.bin tmp1k.bin > tmp1.bin
+    mv tmp1.bin tmp1k.bin
+done
+cat tmp1k.bin tmp1k.bin tmp1k.bin tmp1k.bin msg.bin > tmpbig.bin
+
 for HALG in ${ITERATE_ALGS}
 do
 
@@ -83,6 +92,43 @@ do
 	diff sig.bin tmp.bin > run.out
 	checkSuccess $?
 
+	echo "HMAC ${HALG} using the keyed hash key, message from file as a sequence ${SESS}"
+	${PREFIX}hmac -hk 80000001 -if msg.bin -os sig.bin -pwdk khk -halg ${HALG} -seq ${SESS} > run.out
+	checkSuccess $?
+
+	echo "Verify the HMAC ${HALG} using the two methods"
+	diff sig.bin tmp.bin > run.out
+	checkSuccess $?
+
+	echo "HMAC ${HALG} start using the keyed hash key, large message ${SESS}"
+	${PREFIX}hmacstart -hk 80000001 -pwdk khk -pwda aaa ${SESS} -halg ${HALG} > run.out
+	checkSuccess $?
+
+	for I in 1 2 3 4
+	do
+	    echo "HMAC ${HALG} sequence update, 1024 bytes ${SESS}"
+	    ${PREFIX}sequenceupdate -hs 80000002 -pwds aaa -if tmp1k.bin ${SESS} > run.out
+	    checkSuccess $?
+	done
+
+	echo "HMAC ${HALG} sequence complete, large message ${SESS}"
+	${PREFIX}sequencecomplete -hs 80000002 -pwds aaa -if msg.bin -of tmp2.bin ${SESS} > run.out
+	checkSuccess $?
+
+	echo "HMAC ${HALG} using the keyed hash key, large message as a multi-chunk sequence ${SESS}"
+	${PREFIX}hmac -hk 80000001 -if tmpbig.bin -os tmp3.bin -pwdk khk -halg ${HALG} -seq ${SESS} -v > run.out
+	checkSuccess $?
+	grep -q "4112 bytes" run.out
+	checkSuccess $?
+
+	echo "Verify the large message HMAC ${HALG} using the two methods"
+	diff tmp3.bin tmp2.bin > run.out
+	checkSuccess $?
+
+	echo "HMAC ${HALG} as a sequence with a -se1 session - should fail"
+	${PREFIX}hmac -hk 80000001 -if msg.bin -pwdk khk -halg ${HALG} -seq -se1 02000000 1 > run.out
+	checkFailure $?
+
 	echo "HMAC ${HALG} using the keyed hash key, message from command line ${SESS}"
 	${PREFIX}hmac -hk 80000001 -ic 1234567890123456 -os sig.bin -pwdk khk -halg ${HALG} ${SESS} > run.out
 	checkSuccess $?
@@ -147,6 +193,14 @@ do
 	    diff tmp.bin policies/${HALG}aaa.bin > run.out
 	    checkSuccess $?
 
+	    echo "Hash ${HALG} as a sequence, data from file"
+	    ${PREFIX}hash -hi ${HIER} -halg ${HALG} -if policies/aaa -oh tmp.bin -seq > run.out
+	    checkSuccess $?
+
+	    echo "Verify the hash ${HALG}"
+	    diff tmp.bin policies/${HALG}aaa.bin > run.out
+	    checkSuccess $?
+
 	    echo "Hash ${HALG} in one call, data on command line"
 	    ${PREFIX}hash -hi ${HIER} -halg ${HALG} -ic aaa -oh tmp.bin > run.out
 	    checkSuccess $?
@@ -252,6 +306,10 @@ checkSuccess $?
 
 rm -f tmp.bin
 rm -f tmp1.bin
+rm -f tmp1k.bin
+rm -f tmpbig.bin
+rm -f tmp2.bin
+rm -f tmp3.bin
 
 # ${PREFIX}getcapability -cap 1 -pr 80000000
 # ${PREFIX}getcapability -cap 1 -pr 02000000
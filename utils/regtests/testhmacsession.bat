@@ -108,4 +108,123 @@ IF !ERRORLEVEL! NEQ 0 (
   exit /B 1
 )
 
+echo ""
+echo "Record and Replay"
+echo ""
+
+rm -f tmptrace1.bin
+rm -f tmptrace2.bin
+
+echo "Start an HMAC auth session, record"
+set TPM_NONCE_SEED=replay
+set TPM_RECORD_FILE=tmptrace1.bin
+%TPM_EXE_PATH%startauthsession -se h > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+echo "Get random with the HMAC session, record"
+set TPM_RECORD_FILE=tmptrace2.bin
+%TPM_EXE_PATH%getrandom -by 16 -se0 02000000 0 -of tmp1.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+set TPM_RECORD_FILE=
+
+echo "Start an HMAC auth session, replay"
+set TPM_REPLAY_FILE=tmptrace1.bin
+%TPM_EXE_PATH%startauthsession -se h > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+echo "Get random with the HMAC session, replay"
+set TPM_REPLAY_FILE=tmptrace2.bin
+set TPM_REPLAY_TIMING=1
+%TPM_EXE_PATH%getrandom -by 16 -se0 02000000 0 -of tmp2.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+set TPM_REPLAY_TIMING=
+set TPM_NONCE_SEED=
+
+echo "Verify the replayed response"
+diff tmp1.bin tmp2.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+echo "Replay a different command - should fail"
+%TPM_EXE_PATH%getcapability -cap 6 > run.out
+IF !ERRORLEVEL! EQU 0 (
+  exit /B 1
+)
+set TPM_REPLAY_FILE=
+
+echo "Start an HMAC auth session with a nonce seed but no trace, seed ignored"
+set TPM_NONCE_SEED=replay
+%TPM_EXE_PATH%startauthsession -se h -v > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+set TPM_NONCE_SEED=
+
+echo "Check that the nonce seed was ignored"
+findstr /C:"TPM_NONCE_SEED ignored" run.out > nul
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+echo "Flush the session"
+%TPM_EXE_PATH%flushcontext -ha 02000000 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+rm -f tmptrace1.bin
+rm -f tmptrace2.bin
+rm -f tmp1.bin
+rm -f tmp2.bin
+
+echo ""
+echo "Session Directory"
+echo ""
+
+echo "Start an HMAC auth session in a session directory"
+set TPM_SESSION_DIR=tmpsessdir
+%TPM_EXE_PATH%startauthsession -se h > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+echo "Get random with the HMAC session, session directory"
+%TPM_EXE_PATH%getrandom -by 16 -se0 02000000 1 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+echo "Get random with the HMAC session, data directory - should fail"
+set TPM_SESSION_DIR=
+%TPM_EXE_PATH%getrandom -by 16 -se0 02000000 1 > run.out
+IF !ERRORLEVEL! EQU 0 (
+  exit /B 1
+)
+
+echo "Flush the session, session directory"
+set TPM_SESSION_DIR=tmpsessdir
+%TPM_EXE_PATH%flushcontext -ha 02000000 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+echo "Session directory with a path - should fail"
+set TPM_SESSION_DIR=a/b
+%TPM_EXE_PATH%startauthsession -se h > run.out
+IF !ERRORLEVEL! EQU 0 (
+  exit /B 1
+)
+set TPM_SESSION_DIR=
+
+rmdir tmpsessdir
+
 exit /B 0
\ No newline at end of file
@@ -88,3 +88,76 @@ checkSuccess $?
 echo "Flush the signing key"
 ${PREFIX}flushcontext -ha 80000001 > run.out
 checkSuccess $?
+
+echo ""
+echo "Record and Replay"
+echo ""
+
+rm -f tmptrace1.bin tmptrace2.bin
+
+echo "Start an HMAC auth session, record"
+TPM_NONCE_SEED=replay TPM_RECORD_FILE=tmptrace1.bin ${PREFIX}startauthsession -se h > run.out
+checkSuccess $?
+
+echo "Get random with the HMAC session, record"
+TPM_NONCE_SEED=replay TPM_RECORD_FILE=tmptrace2.bin ${PREFIX}getrandom -by 16 -se0 02000000 0 -of tmp1.bin > run.out
+checkSuccess $?
+
+echo "Start an HMAC auth session, replay"
+TPM_NONCE_SEED=replay TPM_REPLAY_FILE=tmptrace1.bin ${PREFIX}startauthsession -se h > run.out
+checkSuccess $?
+
+echo "Get random with the HMAC session, replay"
+TPM_NONCE_SEED=replay TPM_REPLAY_FILE=tmptrace2.bin TPM_REPLAY_TIMING=1 ${PREFIX}getrandom -by 16 -se0 02000000 0 -of tmp2.bin > run.out
+checkSuccess $?
+
+echo "Verify the replayed response"
+diff tmp1.bin tmp2.bin > run.out
+checkSuccess $?
+
+echo "Replay a different command - should fail"
+TPM_REPLAY_FILE=tmptrace2.bin ${PREFIX}getcapability -cap 6 > run.out
+checkFailure $?
+
+echo "Start an HMAC auth session with a nonce seed but no trace, seed ignored"
+TPM_NONCE_SEED=replay ${PREFIX}startauthsession -se h -v > run.out
+checkSuccess $?
+
+echo "Check that the nonce seed was ignored"
+grep -q "TPM_NONCE_SEED ignored" run.out
+checkSuccess $?
+
+echo "Flush the session"
+${PREFIX}flushcontext -ha 02000000 > run.out
+checkSuccess $?
+
+rm -f tmptrace1.bin
+rm -f tmptrace2.bin
+rm -f tmp1.bin
+rm -f tmp2.bin
+
+echo ""
+echo "Session Directory"
+echo ""
+
+echo "Start an HMAC auth session in a session directory"
+TPM_SESSION_DIR=tmpsessdir ${PREFIX}startauthsession -se h > run.out
+checkSuccess $?
+
+echo "Get random with the HMAC session, session directory"
+TPM_SESSION_DIR=tmpsessdir ${PREFIX}getrandom -by 16 -se0 02000000 1 > run.out
+checkSuccess $?
+
+echo "Get random with the HMAC session, data directory - should fail"
+${PREFIX}getrandom -by 16 -se0 02000000 1 > run.out
+checkFailure $?
+
+echo "Flush the session, session directory"
+TPM_SESSION_DIR=tmpsessdir ${PREFIX}flushcontext -ha 02000000 > run.out
+checkSuccess $?
+
+echo "Session directory with a path - should fail"
+TPM_SESSION_DIR=a/b ${PREFIX}startauthsession -se h > run.out
+checkFailure $?
+
+rmdir tmpsessdir
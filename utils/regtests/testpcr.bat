@@ -248,6 +248,37 @@ for /L %%i in (1,1,!L!) do (
       	)
     )
 
+    echo ""
+    echo "PCR Extend, prepared command"
+    echo ""
+
+    echo "PCR Reset"
+    %TPM_EXE_PATH%pcrreset -ha 16 > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+      exit /B 1
+      )
+
+    echo "PCR Extend !EXTEND[%%i]!, prepared with zero digests and patched"
+    %TPM_EXE_PATH%pcrextend -ha 16 !EXTEND[%%i]! -if policies/aaa -prep > run.out
+    IF !ERRORLEVEL! NEQ 0 (
+      exit /B 1
+      )
+
+    for %%H in (!BANKS[%%i]!) do (
+
+    	echo "PCR Read %%H"
+    	%TPM_EXE_PATH%pcrread -ha 16 -halg %%H -of tmp.bin > run.out
+    	IF !ERRORLEVEL! NEQ 0 (
+      	    exit /B 1
+      	)
+
+    	echo "Verify the read data %%H"
+    	diff policies/%%Hextaaa0.bin tmp.bin > run.out
+    	IF !ERRORLEVEL! NEQ 0 (
+      	    exit /B 1
+      	)
+    )
+
     echo ""
     echo "PCR Event"
     echo ""
@@ -337,6 +368,16 @@ IF !ERRORLEVEL! NEQ 0 (
   exit /B 1
 )
 
+echo "Prepared command handle and patch size checks"
+%TPM_EXE_PATH%testprepared -v > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+findstr /C:"patch a different length passed" run.out > nul
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
 REM # recreate the primary key that was flushed on the powerup
 
 echo "Create a platform primary storage key"
@@ -226,7 +226,32 @@ do
 	checkSuccess $?
 
     done
-    
+
+    echo ""
+    echo "PCR Extend, prepared command"
+    echo ""
+
+    echo "PCR Reset banks ${BANKS[i]}"
+    ${PREFIX}pcrreset -ha 16 > run.out
+    checkSuccess $?
+
+    echo "PCR Extend ${EXTEND[i]}, prepared with zero digests and patched"
+    ${PREFIX}pcrextend -ha 16 ${EXTEND[i]} -if policies/aaa -prep > run.out
+    checkSuccess $?
+
+    for HALG in ${BANKS[i]}
+    do
+
+	echo "PCR Read ${HALG}"
+	${PREFIX}pcrread -ha 16 -halg ${HALG} -of tmp.bin > run.out
+	checkSuccess $?
+
+	echo "Verify the read data ${HALG}"
+	diff policies/${HALG}extaaa0.bin tmp.bin > run.out
+	checkSuccess $?
+
+    done
+
     echo ""
     echo "PCR Event"
     echo ""
@@ -295,6 +320,12 @@ echo "PCR Reset"
 ${PREFIX}pcrreset -ha 16 > run.out
 checkSuccess $?
 
+echo "Prepared command handle and patch size checks"
+${PREFIX}testprepared -v > run.out
+checkSuccess $?
+grep -q "patch a different length passed" run.out
+checkSuccess $?
+
 # recreate the primary key that was flushed on the powerup
 
 initprimary
@@ -2736,6 +2736,91 @@ for %%H in (%ITERATE_ALGS%) do (
 
 )
 
+echo ""
+echo "Software Policy Calculator"
+echo ""
+
+echo "Calculate the command code sign policy"
+echo commandcode 15d > tmppol.txt
+%TPM_EXE_PATH%policycalc -if tmppol.txt -of tmp.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Verify the policy digest"
+diff tmp.bin policies/policyccsign.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Calculate the SHA-384 policy authorize policy"
+echo authorize 000ca8bfb42e75b4c22b366b372cd9994bafe8558aa182cf12c258406d197dab63ac46f5a5255b1deb2993a4e9fc92b1e26c > tmppol.txt
+%TPM_EXE_PATH%policycalc -halg sha384 -if tmppol.txt -of tmp.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Verify the policy digest"
+diff tmp.bin policies/policyauthorizesha384.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Calculate the PCR 16 policy from the PCR value"
+echo pcrvalues sha256 16 0000000000000000000000000000000000000000000000000000000000000000 > tmppol.txt
+%TPM_EXE_PATH%policycalc -if tmppol.txt -of tmp.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Verify the policy digest"
+diff tmp.bin policies/policypcr.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Calculate the policy OR of two policy digest files"
+echo or @policies/policyccsign.bin @policies/policyccquote.bin > tmppol.txt
+%TPM_EXE_PATH%policycalc -if tmppol.txt -of tmp.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Verify the policy digest"
+diff tmp.bin policies/policyor.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Calculate a PolicyOR tree over a two entry PCR database"
+echo sha256 16 1111111111111111111111111111111111111111111111111111111111111111 > tmppcrdb.txt
+echo sha256 16 0000000000000000000000000000000000000000000000000000000000000000 >> tmppcrdb.txt
+%TPM_EXE_PATH%policycalc -pcrdb tmppcrdb.txt -op tmppath -of tmppol.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Replay the second branch, PolicyPCR followed by its PolicyOR path"
+echo pcrvalues sha256 16 0000000000000000000000000000000000000000000000000000000000000000 > tmppol.txt
+type tmppath1.txt >> tmppol.txt
+%TPM_EXE_PATH%policycalc -if tmppol.txt -of tmp.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Verify the replayed policy digest"
+diff tmp.bin tmppol.bin > run.out
+IF !ERRORLEVEL! NEQ 0 (
+   exit /B 1
+)
+
+echo "Calculate a policy with an unknown statement - should fail"
+echo policyfoo 15d > tmppol.txt
+%TPM_EXE_PATH%policycalc -if tmppol.txt > run.out
+IF !ERRORLEVEL! EQU 0 (
+   exit /B 1
+)
+
 rm pssig.bin
 rm run.out
 rm sig.bin
@@ -2745,6 +2830,10 @@ rm tmpdup.bin
 rm tmphkey.bin
 rm tmpname.bin
 rm tmppol.bin
+rm tmppol.txt
+rm tmppcrdb.txt
+rm tmppath0.txt
+rm tmppath1.txt
 rm tmppriv.bin
 rm tmppub.bin
 rm tmppub.der
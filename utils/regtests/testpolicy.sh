@@ -2036,6 +2036,67 @@ do
 
 done
 
+echo ""
+echo "Software Policy Calculator"
+echo ""
+
+echo "Calculate the command code sign policy"
+echo "commandcode 15d" > tmppol.txt
+${PREFIX}policycalc -if tmppol.txt -of tmp.bin > run.out
+checkSuccess $?
+
+echo "Verify the policy digest"
+diff tmp.bin policies/policyccsign.bin > run.out
+checkSuccess $?
+
+echo "Calculate the SHA-384 policy authorize policy"
+echo "authorize 000ca8bfb42e75b4c22b366b372cd9994bafe8558aa182cf12c258406d197dab63ac46f5a5255b1deb2993a4e9fc92b1e26c" > tmppol.txt
+${PREFIX}policycalc -halg sha384 -if tmppol.txt -of tmp.bin > run.out
+checkSuccess $?
+
+echo "Verify the policy digest"
+diff tmp.bin policies/policyauthorizesha384.bin > run.out
+checkSuccess $?
+
+echo "Calculate the PCR 16 policy from the PCR value"
+echo "pcrvalues sha256 16 0000000000000000000000000000000000000000000000000000000000000000" > tmppol.txt
+${PREFIX}policycalc -if tmppol.txt -of tmp.bin > run.out
+checkSuccess $?
+
+echo "Verify the policy digest"
+diff tmp.bin policies/policypcr.bin > run.out
+checkSuccess $?
+
+echo "Calculate the policy OR of two policy digest files"
+echo "or @policies/policyccsign.bin @policies/policyccquote.bin" > tmppol.txt
+${PREFIX}policycalc -if tmppol.txt -of tmp.bin > run.out
+checkSuccess $?
+
+echo "Verify the policy digest"
+diff tmp.bin policies/policyor.bin > run.out
+checkSuccess $?
+
+echo "Calculate a PolicyOR tree over a two entry PCR database"
+echo "sha256 16 1111111111111111111111111111111111111111111111111111111111111111" > tmppcrdb.txt
+echo "sha256 16 0000000000000000000000000000000000000000000000000000000000000000" >> tmppcrdb.txt
+${PREFIX}policycalc -pcrdb tmppcrdb.txt -op tmppath -of tmppol.bin > run.out
+checkSuccess $?
+
+echo "Replay the second branch, PolicyPCR followed by its PolicyOR path"
+echo "pcrvalues sha256 16 0000000000000000000000000000000000000000000000000000000000000000" > tmppol.txt
+cat tmppath1.txt >> tmppol.txt
+${PREFIX}policycalc -if tmppol.txt -of tmp.bin > run.out
+checkSuccess $?
+
+echo "Verify the replayed policy digest"
+diff tmp.bin tmppol.bin > run.out
+checkSuccess $?
+
+echo "Calculate a policy with an unknown statement - should fail"
+echo "policyfoo 15d" > tmppol.txt
+${PREFIX}policycalc -if tmppol.txt > run.out
+checkFailure $?
+
 # cleanup
 
 rm -f pssig.bin
@@ -2047,6 +2108,10 @@ rm -f tmpdup.bin
 rm -f tmphkey.bin
 rm -f tmpname.bin
 rm -f tmppol.bin
+rm -f tmppol.txt
+rm -f tmppcrdb.txt
+rm -f tmppath0.txt
+rm -f tmppath1.txt
 rm -f tmppriv.bin
 rm -f tmppriv.bin 
 rm -f tmppub.bin
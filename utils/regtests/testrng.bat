@@ -55,4 +55,53 @@ IF !ERRORLEVEL! NEQ 0 (
   exit /B 1
 )
 
+echo "Get Random, buffers sized from the TPM"
+set TPM_TRACE_LEVEL=2
+%TPM_EXE_PATH%getrandom -by 64 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+findstr /C:"TSS_QueryBufferSize: command" run.out > nul
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+echo "Get Random, buffer sizes fixed, no TPM query"
+set TPM_MAX_COMMAND_SIZE=8192
+set TPM_MAX_RESPONSE_SIZE=8192
+%TPM_EXE_PATH%getrandom -by 64 > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+findstr /C:"TSS_QueryBufferSize: command" run.out > nul
+IF !ERRORLEVEL! EQU 0 (
+  exit /B 1
+)
+set TPM_TRACE_LEVEL=
+set TPM_MAX_RESPONSE_SIZE=
+
+echo "Get Random, buffer size below MAX_COMMAND_SIZE - should fail"
+set TPM_MAX_COMMAND_SIZE=100
+%TPM_EXE_PATH%getrandom -by 64 > run.out
+IF !ERRORLEVEL! EQU 0 (
+  exit /B 1
+)
+set TPM_MAX_COMMAND_SIZE=
+
+echo "Get Random from a pool, larger than the pool"
+%TPM_EXE_PATH%getrandom -by 1000 -pool 256 -v > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+findstr /C:"pool used" run.out > nul
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
+echo "Get Random from a pool, mixed with the DRBG, no zeros"
+%TPM_EXE_PATH%getrandom -by 64 -pool 4096 -mix -nz > run.out
+IF !ERRORLEVEL! NEQ 0 (
+  exit /B 1
+)
+
 exit /B 0
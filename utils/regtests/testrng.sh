@@ -51,3 +51,54 @@ checkSuccess $?
 echo "Get Random"
 ${PREFIX}getrandom -by 64 > run.out
 checkSuccess $?
+
+echo "Get Random, buffers sized from the TPM"
+TPM_TRACE_LEVEL=2 ${PREFIX}getrandom -by 64 > run.out
+checkSuccess $?
+grep -q "TSS_QueryBufferSize: command" run.out
+checkSuccess $?
+
+echo "Get Random, buffer sizes fixed, no TPM query"
+TPM_MAX_COMMAND_SIZE=8192 TPM_MAX_RESPONSE_SIZE=8192 TPM_TRACE_LEVEL=2 ${PREFIX}getrandom -by 64 > run.out
+checkSuccess $?
+grep -q "TSS_QueryBufferSize: command" run.out
+checkFailure $?
+
+echo "Get Random, buffer size below MAX_COMMAND_SIZE - should fail"
+TPM_MAX_COMMAND_SIZE=100 ${PREFIX}getrandom -by 64 > run.out
+checkFailure $?
+
+echo "Get Random from a pool, larger than the pool"
+${PREFIX}getrandom -by 1000 -pool 256 -v > run.out
+checkSuccess $?
+grep -q "pool used" run.out
+checkSuccess $?
+
+echo "Get Random from a pool, mixed with the DRBG, no zeros"
+${PREFIX}getrandom -by 64 -pool 4096 -mix -nz > run.out
+checkSuccess $?
+
+echo "tsstool script, the utilities share one TSS context"
+echo "# random number generator" > tmpscript.txt
+echo "stirrandom -if policies/aaa" >> tmpscript.txt
+echo "getrandom -by 64 -pool 256 -v" >> tmpscript.txt
+${PREFIX}tsstool -script tmpscript.txt > run.out
+checkSuccess $?
+grep -q "pool used" run.out
+checkSuccess $?
+
+echo "tsstool script, stop at the first failure"
+echo "nosuchutility" > tmpscript.txt
+echo "getrandom -by 64 -pool 256 -v" >> tmpscript.txt
+${PREFIX}tsstool -script tmpscript.txt > run.out
+checkFailure $?
+grep -q "pool used" run.out
+checkFailure $?
+
+echo "tsstool script, -k continues after a failure"
+${PREFIX}tsstool -k -script tmpscript.txt > run.out
+checkFailure $?
+grep -q "pool used" run.out
+checkSuccess $?
+
+rm -f tmpscript.txt
@@ -43,6 +43,10 @@ echo ""
 echo "RSA Signing key"
 echo ""
 
+echo policies/aaa> tmpmsgs.txt
+echo policies/policyccsign.bin>> tmpmsgs.txt
+echo policies/policyccquote.bin>> tmpmsgs.txt
+
 for %%B in (2048 3072) do (
 
     echo "Create an RSA key pair in PEM format using openssl"
@@ -78,6 +82,30 @@ for %%B in (2048 3072) do (
 	       exit /B 1
 	    )
 
+	    echo "Batch sign three messages - %%H %%S %%B"
+	    %TPM_EXE_PATH%sign -hk 80000001 -halg %%H -salg rsa -scheme %%S -ifl tmpmsgs.txt -op tmpproof -os sig.bin -pwdk sig > run.out
+	    IF !ERRORLEVEL! NEQ 0 (
+	       exit /B 1
+	    )
+
+	    echo "Verify the second message batch signature using the TPM - %%H"
+	    %TPM_EXE_PATH%verifysignature -hk 80000001 -halg %%H -rsa -if policies/policyccsign.bin -ipr tmpproof1.bin -is sig.bin > run.out
+	    IF !ERRORLEVEL! NEQ 0 (
+	       exit /B 1
+	    )
+
+	    echo "Verify the second message batch signature using PEM - %%H"
+	    %TPM_EXE_PATH%verifysignature -ipem signrsa%%Bpub.pem -halg %%H -if policies/policyccsign.bin -ipr tmpproof1.bin -is sig.bin > run.out
+	    IF !ERRORLEVEL! NEQ 0 (
+	       exit /B 1
+	    )
+
+	    echo "Verify the first message with the second proof - should fail"
+	    %TPM_EXE_PATH%verifysignature -ipem signrsa%%Bpub.pem -halg %%H -if policies/aaa -ipr tmpproof1.bin -is sig.bin > run.out
+	    IF !ERRORLEVEL! EQU 0 (
+	       exit /B 1
+	    )
+
 	    echo "Read the public part"
 	    %TPM_EXE_PATH%readpublic -ho 80000001 -opem tmppub.pem > run.out
 	    IF !ERRORLEVEL! NEQ 0 (
@@ -518,6 +546,10 @@ rm tmpkeypaireccnistp256.pem
 rm tmpkeypaireccnistp256.der
 rm tmpkeypaireccnistp384.pem
 rm tmpkeypaireccnistp384.der
+rm tmpmsgs.txt
+rm tmpproof0.bin
+rm tmpproof1.bin
+rm tmpproof2.bin
 rm pssig.bin
 rm tmppub.bin
 rm tmppub.pem
@@ -44,6 +44,8 @@ echo ""
 echo "RSA Signing key"
 echo ""
 
+printf "policies/aaa\npolicies/policyccsign.bin\npolicies/policyccquote.bin\n" > tmpmsgs.txt
+
 for BITS in 2048 3072
 do
 
@@ -73,6 +75,22 @@ do
 	    ${PREFIX}verifysignature -ipem signrsa${BITS}pub.pem -halg $HALG -if policies/aaa -is sig.bin > run.out
 	    checkSuccess $?
 
+	    echo "Batch sign three messages - $HALG $SCHEME $BITS"
+	    ${PREFIX}sign -hk 80000001 -halg $HALG -salg rsa -scheme $SCHEME -ifl tmpmsgs.txt -op tmpproof -os sig.bin -pwdk sig > run.out
+	    checkSuccess $?
+
+	    echo "Verify the second message batch signature using the TPM - $HALG"
+	    ${PREFIX}verifysignature -hk 80000001 -halg $HALG -rsa -if policies/policyccsign.bin -ipr tmpproof1.bin -is sig.bin > run.out
+	    checkSuccess $?
+
+	    echo "Verify the second message batch signature using PEM - $HALG"
+	    ${PREFIX}verifysignature -ipem signrsa${BITS}pub.pem -halg $HALG -if policies/policyccsign.bin -ipr tmpproof1.bin -is sig.bin > run.out
+	    checkSuccess $?
+
+	    echo "Verify the first message with the second proof - should fail"
+	    ${PREFIX}verifysignature -ipem signrsa${BITS}pub.pem -halg $HALG -if policies/aaa -ipr tmpproof1.bin -is sig.bin > run.out
+	    checkFailure $?
+
 	    echo "Read the public part"
 	    ${PREFIX}readpublic -ho 80000001 -opem tmppub.pem > run.out
 	    checkSuccess $?
@@ -101,6 +119,37 @@ do
     
     done
 
+    echo "The signing daemon must not remove a file that is not a socket - $BITS"
+    echo "not a socket" > tmpsignd.sock
+    ${PREFIX}signd -hk 80000001 -halg sha256 -scheme rsassa -pwdk sig -sock tmpsignd.sock -n 1 > run.out
+    checkFailure $?
+
+    echo "Check that the file is unchanged - $BITS"
+    grep -q "not a socket" tmpsignd.sock
+    checkSuccess $?
+    rm -f tmpsignd.sock
+
+    echo "Start the signing daemon with a resident HMAC session - $BITS"
+    ${PREFIX}signd -hk 80000001 -halg sha256 -scheme rsassa -pwdk sig -se -sock tmpsignd.sock -n 3 > tmpsignd.out &
+    SIGND_PID=$!
+    sleep 1
+
+    echo "Check that only the owner can connect to the daemon socket - $BITS"
+    ls -l tmpsignd.sock | grep -q "^srw-------"
+    checkSuccess $?
+
+    echo "Send three pipelined signing requests to the daemon - $BITS"
+    ${PREFIX}signd -client -sock tmpsignd.sock -halg sha256 -if policies/aaa -cnt 3 -os sig.bin > run.out
+    checkSuccess $?
+
+    echo "Wait for the signing daemon to exit - $BITS"
+    wait ${SIGND_PID}
+    checkSuccess $?
+
+    echo "Verify the daemon signature using PEM - $BITS"
+    ${PREFIX}verifysignature -ipem signrsa${BITS}pub.pem -halg sha256 -if policies/aaa -is sig.bin > run.out
+    checkSuccess $?
+
     echo "Flush the RSA signing key"
     ${PREFIX}flushcontext -ha 80000001 > run.out
     checkSuccess $?
@@ -432,6 +481,11 @@ checkSuccess $?
 
 # cleanup
 
+rm -f tmpmsgs.txt
+rm -f tmpproof0.bin
+rm -f tmpproof1.bin
+rm -f tmpproof2.bin
+rm -f tmpsignd.out
 rm -f tmpkeypairrsa2048.pem
 rm -f tmpkeypairrsa2048.der
 rm -f tmpkeypairrsa3072.pem
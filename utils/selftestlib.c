@@ -0,0 +1,427 @@
+/********************************************************************************/
+/*										*/
+/*			Incremental Self Test Scheduler				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* These routines schedule TPM2_IncrementalSelfTest() for a set of algorithms.  See selftestlib.h.
+
+   The usual flow is:
+
+   selfTestScheduleInit()
+   selfTestScheduleAddAlg() for each algorithm the application uses
+   selfTestScheduleStep() when idle, until schedule.complete is TRUE
+	or
+   selfTestScheduleRun() to loop until done
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef TPM_POSIX
+#include <unistd.h>
+#endif
+#ifdef TPM_WINDOWS
+#include <windows.h>
+#endif
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssresponsecode.h>
+
+#include "selftestlib.h"
+
+extern int tssUtilsVerbose;
+
+static int selfTestAlgListContains(const TPML_ALG *algList,
+				   TPM_ALG_ID algorithm);
+static void selfTestScheduleUpdate(SELFTEST_SCHEDULE *schedule);
+static TPM_RC selfTestCheckImplemented(TSS_CONTEXT *tssContext,
+				       SELFTEST_SCHEDULE *schedule);
+static TPM_RC selfTestIncremental(TSS_CONTEXT *tssContext,
+				  SELFTEST_SCHEDULE *schedule,
+				  const TPML_ALG *toTest);
+static TPM_RC selfTestGetTestResult(TSS_CONTEXT *tssContext,
+				    SELFTEST_SCHEDULE *schedule);
+static void selfTestSleep(uint32_t msec);
+
+/* selfTestScheduleInit() initializes an empty schedule */
+
+void selfTestScheduleInit(SELFTEST_SCHEDULE *schedule)
+{
+    schedule->needed.count = 0;
+    schedule->unsupported.count = 0;
+    schedule->implementedValid = FALSE;
+    schedule->toDoList.count = 0;
+    schedule->tested.count = 0;
+    schedule->toDoListValid = FALSE;
+    schedule->testing = FALSE;
+    schedule->commandCount = 0;
+    schedule->complete = TRUE;		/* nothing needed yet */
+    return;
+}
+
+/* selfTestScheduleAddAlg() adds an algorithm that the application requires.  Duplicates are
+   ignored. */
+
+TPM_RC selfTestScheduleAddAlg(SELFTEST_SCHEDULE *schedule,
+			      TPM_ALG_ID algorithm)
+{
+    TPM_RC	rc = 0;
+
+    if (!selfTestAlgListContains(&schedule->needed, algorithm) &&
+	!selfTestAlgListContains(&schedule->unsupported, algorithm)) {
+	if ((schedule->needed.count + schedule->unsupported.count) >= MAX_ALG_LIST_SIZE) {
+	    if (tssUtilsVerbose) printf("selfTestScheduleAddAlg: Error, more than %u algorithms\n",
+					MAX_ALG_LIST_SIZE);
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+	if (rc == 0) {
+	    schedule->needed.algorithms[schedule->needed.count] = algorithm;
+	    schedule->needed.count++;
+	    schedule->implementedValid = FALSE;
+	    selfTestScheduleUpdate(schedule);
+	}
+    }
+    return rc;
+}
+
+/* selfTestGetToDoList() sends TPM2_IncrementalSelfTest() with an empty toTest list.  This runs no
+   tests, but returns the TPM toDoList, the list of algorithms that still need testing. */
+
+TPM_RC selfTestGetToDoList(TSS_CONTEXT *tssContext,
+			   SELFTEST_SCHEDULE *schedule)
+{
+    TPM_RC	rc = 0;
+    TPML_ALG	toTest;
+
+    toTest.count = 0;
+    rc = selfTestIncremental(tssContext, schedule, &toTest);
+    return rc;
+}
+
+/* selfTestScheduleStep() does one unit of work and returns.  It is intended to be called when the
+   application is otherwise idle.
+
+   If the TPM is still testing, it polls TPM2_GetTestResult().  Otherwise it requests a test of up
+   to batchSize needed algorithms that are on the TPM toDoList.  A batchSize of 0 requests all of
+   them.
+
+   Needed algorithms that the TPM does not implement are moved to schedule->unsupported.  They are
+   never reported as tested.
+
+   schedule->complete is set when all needed algorithms have been tested.
+*/
+
+TPM_RC selfTestScheduleStep(TSS_CONTEXT *tssContext,
+			    SELFTEST_SCHEDULE *schedule,
+			    uint32_t batchSize)
+{
+    TPM_RC	rc = 0;
+    TPML_ALG	toTest;
+    uint32_t	i;
+
+    /* the first time through, and after an algorithm is added, drop what the TPM lacks */
+    if ((rc == 0) && !schedule->implementedValid) {
+	rc = selfTestCheckImplemented(tssContext, schedule);
+    }
+    /* the first time through, get the TPM toDoList */
+    if ((rc == 0) && !schedule->toDoListValid) {
+	rc = selfTestGetToDoList(tssContext, schedule);
+    }
+    /* a previous step started tests, check whether they completed */
+    if ((rc == 0) && schedule->testing) {
+	rc = selfTestGetTestResult(tssContext, schedule);
+	/* tests done, refresh the toDoList to see what was tested */
+	if ((rc == 0) && !schedule->testing) {
+	    rc = selfTestGetToDoList(tssContext, schedule);
+	}
+    }
+    /* still testing, try again at the next idle time */
+    if ((rc == 0) && !schedule->testing && !schedule->complete) {
+	toTest.count = 0;
+	for (i = 0 ; i < schedule->needed.count ; i++) {
+	    if ((batchSize != 0) && (toTest.count >= batchSize)) {
+		break;
+	    }
+	    if (selfTestAlgListContains(&schedule->toDoList, schedule->needed.algorithms[i])) {
+		toTest.algorithms[toTest.count] = schedule->needed.algorithms[i];
+		toTest.count++;
+	    }
+	}
+	if (toTest.count > 0) {
+	    if (tssUtilsVerbose) printf("selfTestScheduleStep: testing %u algorithms\n",
+					toTest.count);
+	    rc = selfTestIncremental(tssContext, schedule, &toTest);
+	}
+    }
+    return rc;
+}
+
+/* selfTestScheduleRun() calls selfTestScheduleStep() until all needed algorithms have been tested,
+   sleeping idleMsec between steps.
+
+   maxSteps limits the number of steps.  0 is unlimited.
+*/
+
+TPM_RC selfTestScheduleRun(TSS_CONTEXT *tssContext,
+			   SELFTEST_SCHEDULE *schedule,
+			   uint32_t batchSize,
+			   uint32_t idleMsec,
+			   uint32_t maxSteps)
+{
+    TPM_RC	rc = 0;
+    uint32_t	steps;
+
+    for (steps = 0 ; (rc == 0) && ((maxSteps == 0) || (steps < maxSteps)) ; steps++) {
+	rc = selfTestScheduleStep(tssContext, schedule, batchSize);
+	if ((rc == 0) && schedule->complete) {
+	    break;
+	}
+	if ((rc == 0) && (idleMsec != 0)) {
+	    selfTestSleep(idleMsec);
+	}
+    }
+    return rc;
+}
+
+/* selfTestIsTested() returns TRUE if the algorithm is known to be tested */
+
+int selfTestIsTested(const SELFTEST_SCHEDULE *schedule,
+		     TPM_ALG_ID algorithm)
+{
+    return selfTestAlgListContains(&schedule->tested, algorithm);
+}
+
+/* selfTestAlgListContains() returns TRUE if the algorithm is in the list */
+
+static int selfTestAlgListContains(const TPML_ALG *algList,
+				   TPM_ALG_ID algorithm)
+{
+    uint32_t	i;
+
+    for (i = 0 ; i < algList->count ; i++) {
+	if (algList->algorithms[i] == algorithm) {
+	    return TRUE;
+	}
+    }
+    return FALSE;
+}
+
+/* selfTestScheduleUpdate() recalculates the tested list from the needed list and the TPM
+   toDoList.
+
+   While the TPM is testing, an algorithm may be off the toDoList but not yet tested, so the tested
+   list is only updated when no test is in progress.
+*/
+
+static void selfTestScheduleUpdate(SELFTEST_SCHEDULE *schedule)
+{
+    uint32_t	i;
+
+    if (!schedule->testing) {
+	schedule->tested.count = 0;
+	/* before the toDoList is known, nothing is known to be tested */
+	if (schedule->toDoListValid) {
+	    for (i = 0 ; i < schedule->needed.count ; i++) {
+		if (!selfTestAlgListContains(&schedule->toDoList,
+					     schedule->needed.algorithms[i])) {
+		    schedule->tested.algorithms[schedule->tested.count] =
+			schedule->needed.algorithms[i];
+		    schedule->tested.count++;
+		}
+	    }
+	}
+	schedule->complete = (schedule->tested.count == schedule->needed.count);
+    }
+    return;
+}
+
+/* selfTestCheckImplemented() asks the TPM whether each needed algorithm is implemented, using
+   TPM2_GetCapability() with TPM_CAP_ALGS.  An algorithm that is not implemented never appears on
+   the toDoList, so without this check it would look tested.  It is moved to the unsupported list.
+*/
+
+static TPM_RC selfTestCheckImplemented(TSS_CONTEXT *tssContext,
+				       SELFTEST_SCHEDULE *schedule)
+{
+    TPM_RC			rc = 0;
+    GetCapability_In 		in;
+    GetCapability_Out		out;
+    TPML_ALG			needed = schedule->needed;
+    TPML_ALG_PROPERTY		*algorithms;
+    uint32_t			i;
+
+    schedule->needed.count = 0;
+    for (i = 0 ; (rc == 0) && (i < needed.count) ; i++) {
+	in.capability = TPM_CAP_ALGS;
+	in.property = needed.algorithms[i];
+	in.propertyCount = 1;
+	rc = TSS_Execute(tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_GetCapability,
+			 TPM_RH_NULL, NULL, 0);
+	if (rc == 0) {
+	    /* the TPM returns the next implemented algorithm at or after the property */
+	    algorithms = &out.capabilityData.data.algorithms;
+	    if ((algorithms->count > 0) &&
+		(algorithms->algProperties[0].alg == needed.algorithms[i])) {
+		schedule->needed.algorithms[schedule->needed.count] = needed.algorithms[i];
+		schedule->needed.count++;
+	    }
+	    else {
+		if (tssUtilsVerbose) printf("selfTestCheckImplemented: "
+					    "algorithm %04x not implemented\n",
+					    needed.algorithms[i]);
+		schedule->unsupported.algorithms[schedule->unsupported.count] =
+		    needed.algorithms[i];
+		schedule->unsupported.count++;
+	    }
+	}
+    }
+    if (rc == 0) {
+	schedule->implementedValid = TRUE;
+	selfTestScheduleUpdate(schedule);
+    }
+    else {
+	schedule->needed = needed;	/* retry at the next step */
+    }
+    return rc;
+}
+
+/* selfTestIncremental() sends TPM2_IncrementalSelfTest() and records the returned toDoList.
+
+   TPM_RC_TESTING is not an error.  It indicates that the TPM is busy with an earlier test.
+*/
+
+static TPM_RC selfTestIncremental(TSS_CONTEXT *tssContext,
+				  SELFTEST_SCHEDULE *schedule,
+				  const TPML_ALG *toTest)
+{
+    TPM_RC			rc = 0;
+    IncrementalSelfTest_In 	in;
+    IncrementalSelfTest_Out 	out;
+
+    if (rc == 0) {
+	in.toTest = *toTest;
+	rc = TSS_Execute(tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_IncrementalSelfTest,
+			 TPM_RH_NULL, NULL, 0);
+	if (toTest->count > 0) {
+	    schedule->commandCount++;
+	}
+    }
+    if (rc == 0) {
+	/* the TPM may test in the background, check completion at the next step */
+	if (toTest->count > 0) {
+	    schedule->testing = TRUE;
+	    schedule->complete = FALSE;
+	}
+	schedule->toDoList = out.toDoList;
+	schedule->toDoListValid = TRUE;
+	if (tssUtilsVerbose) printf("selfTestIncremental: toDoList has %u algorithms\n",
+				    schedule->toDoList.count);
+	selfTestScheduleUpdate(schedule);
+    }
+    else if (rc == TPM_RC_TESTING) {
+	if (tssUtilsVerbose) printf("selfTestIncremental: TPM is testing\n");
+	schedule->testing = TRUE;
+	schedule->complete = FALSE;
+	rc = 0;
+    }
+    else {
+	const char *msg;
+	const char *submsg;
+	const char *num;
+	if (tssUtilsVerbose) {
+	    printf("selfTestIncremental: failed, rc %08x\n", rc);
+	    TSS_ResponseCode_toString(&msg, &submsg, &num, rc);
+	    printf("%s%s%s\n", msg, submsg, num);
+	}
+    }
+    return rc;
+}
+
+/* selfTestGetTestResult() sends TPM2_GetTestResult() to determine whether the TPM is still
+   testing.  A test failure is returned as an error. */
+
+static TPM_RC selfTestGetTestResult(TSS_CONTEXT *tssContext,
+				    SELFTEST_SCHEDULE *schedule)
+{
+    TPM_RC			rc = 0;
+    GetTestResult_Out 		out;
+
+    if (rc == 0) {
+	rc = TSS_Execute(tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 NULL,
+			 NULL,
+			 TPM_CC_GetTestResult,
+			 TPM_RH_NULL, NULL, 0);
+    }
+    if (rc == 0) {
+	if (out.testResult == TPM_RC_TESTING) {
+	    if (tssUtilsVerbose) printf("selfTestGetTestResult: TPM is testing\n");
+	}
+	else if (out.testResult == TPM_RC_SUCCESS) {
+	    schedule->testing = FALSE;
+	}
+	else {
+	    if (tssUtilsVerbose) printf("selfTestGetTestResult: test failed, testResult %08x\n",
+					out.testResult);
+	    rc = out.testResult;
+	}
+    }
+    return rc;
+}
+
+/* selfTestSleep() waits between idle steps */
+
+static void selfTestSleep(uint32_t msec)
+{
+#ifdef TPM_POSIX
+    usleep(msec * 1000);	/* usleep() units are usec */
+#endif
+#ifdef TPM_WINDOWS
+    Sleep(msec);		/* Sleep units are msec */
+#endif
+    return;
+}
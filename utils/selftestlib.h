@@ -0,0 +1,92 @@
+/********************************************************************************/
+/*										*/
+/*			Incremental Self Test Scheduler				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* The TPM may defer testing an algorithm until its first use after TPM2_Startup.  That first
+   command then either stalls while the test runs or returns TPM_RC_TESTING.
+
+   These routines let an application test the algorithms its workload needs ahead of time, in
+   small batches while otherwise idle, using TPM2_IncrementalSelfTest().  The progress is kept in a
+   SELFTEST_SCHEDULE, which the application keeps alongside its TSS_CONTEXT.
+*/
+
+#ifndef SELFTESTLIB_H
+#define SELFTESTLIB_H
+
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+
+/* Holds the self test state for one TPM.  Initialize with selfTestScheduleInit(). */
+
+typedef struct {
+    TPML_ALG	needed;		/* algorithms the workload requires */
+    TPML_ALG	unsupported;	/* requested algorithms that the TPM does not implement */
+    int		implementedValid; /* TRUE after needed has been checked against the TPM */
+    TPML_ALG	toDoList;	/* most recent toDoList returned by the TPM */
+    TPML_ALG	tested;		/* needed algorithms that the TPM no longer reports as untested */
+    int		toDoListValid;	/* TRUE after the TPM has returned a toDoList */
+    int		testing;	/* TRUE while the TPM reports that a test is in progress */
+    uint32_t	commandCount;	/* number of TPM2_IncrementalSelfTest commands issued */
+    int		complete;	/* TRUE when every needed algorithm has been tested */
+} SELFTEST_SCHEDULE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    void selfTestScheduleInit(SELFTEST_SCHEDULE *schedule);
+    TPM_RC selfTestScheduleAddAlg(SELFTEST_SCHEDULE *schedule,
+				  TPM_ALG_ID algorithm);
+    TPM_RC selfTestGetToDoList(TSS_CONTEXT *tssContext,
+			       SELFTEST_SCHEDULE *schedule);
+    TPM_RC selfTestScheduleStep(TSS_CONTEXT *tssContext,
+				SELFTEST_SCHEDULE *schedule,
+				uint32_t batchSize);
+    TPM_RC selfTestScheduleRun(TSS_CONTEXT *tssContext,
+			       SELFTEST_SCHEDULE *schedule,
+			       uint32_t batchSize,
+			       uint32_t idleMsec,
+			       uint32_t maxSteps);
+    int selfTestIsTested(const SELFTEST_SCHEDULE *schedule,
+			 TPM_ALG_ID algorithm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,391 @@
+/********************************************************************************/
+/*										*/
+/*			Hash and HMAC Sequence Streaming			*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Hash and HMAC sequence streaming.  See sequencelib.h.
+
+   The usual flow is:
+
+   sequenceHashStart() or sequenceHmacStart()
+   sequenceUpdate() and / or sequenceUpdateFile(), any number of times
+   sequenceComplete()
+
+   On an error after the sequence is started, call sequenceAbort() to flush the sequence object.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tssresponsecode.h>
+
+#include "sequencelib.h"
+
+extern int tssUtilsVerbose;
+
+/* size of the stdio buffer used when streaming a file, a multiple of any reasonable chunk size */
+#define SEQUENCE_FILE_BUFFER_SIZE	0x100000
+
+static TPM_RC sequenceStreamInit(SEQUENCE_STREAM *stream,
+				 TSS_CONTEXT *tssContext,
+				 uint32_t chunkSize);
+static TPM_RC sequenceSendChunk(SEQUENCE_STREAM *stream);
+
+/* sequenceGetChunkSize() returns the largest buffer that the TPM and the TSS both accept for
+   TPM2_SequenceUpdate, using the TPM_PT_INPUT_BUFFER property. */
+
+TPM_RC sequenceGetChunkSize(TSS_CONTEXT *tssContext,
+			    uint32_t *chunkSize)
+{
+    TPM_RC			rc = 0;
+    GetCapability_In 		in;
+    GetCapability_Out		out;
+
+    if (rc == 0) {
+	in.capability = TPM_CAP_TPM_PROPERTIES;
+	in.property = TPM_PT_INPUT_BUFFER;
+	in.propertyCount = 1;
+	rc = TSS_Execute(tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_GetCapability,
+			 TPM_RH_NULL, NULL, 0);
+    }
+    if (rc == 0) {
+	if ((out.capabilityData.data.tpmProperties.count > 0) &&
+	    (out.capabilityData.data.tpmProperties.tpmProperty[0].property ==
+	     TPM_PT_INPUT_BUFFER)) {
+	    *chunkSize = out.capabilityData.data.tpmProperties.tpmProperty[0].value;
+	}
+	else {
+	    /* use the TCG minimum for a TPM that does not report the property */
+	    *chunkSize = 1024;
+	}
+	/* the TSS side structure may be smaller than the TPM value */
+	if (*chunkSize > MAX_DIGEST_BUFFER) {
+	    *chunkSize = MAX_DIGEST_BUFFER;
+	}
+	if (tssUtilsVerbose) printf("sequenceGetChunkSize: %u\n", *chunkSize);
+    }
+    return rc;
+}
+
+/* sequenceHashStart() starts a hash sequence using TPM2_HashSequenceStart().
+
+   chunkSize is the number of bytes per TPM2_SequenceUpdate.  0 queries the TPM.
+*/
+
+TPM_RC sequenceHashStart(SEQUENCE_STREAM *stream,
+			 TSS_CONTEXT *tssContext,
+			 TPMI_ALG_HASH halg,
+			 uint32_t chunkSize)
+{
+    TPM_RC			rc = 0;
+    HashSequenceStart_In 	in;
+    HashSequenceStart_Out 	out;
+
+    if (rc == 0) {
+	rc = sequenceStreamInit(stream, tssContext, chunkSize);
+    }
+    if (rc == 0) {
+	/* the sequence is private to this stream, so it has an empty auth value */
+	in.auth.t.size = 0;
+	in.hashAlg = halg;
+	rc = TSS_Execute(tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_HashSequenceStart,
+			 TPM_RH_NULL, NULL, 0);
+	stream->tpmCommands++;
+    }
+    if (rc == 0) {
+	stream->sequenceHandle = out.sequenceHandle;
+	if (tssUtilsVerbose) printf("sequenceHashStart: handle %08x\n", stream->sequenceHandle);
+    }
+    return rc;
+}
+
+/* sequenceHmacStart() starts an HMAC sequence using TPM2_HMAC_Start() with the keyed hash key
+   keyHandle.
+
+   sessionHandle and sessionAttributes authorize the key, TPM_RS_PW for a password session with
+   keyPassword.  The sequence commands that follow use the empty sequence auth.
+
+   chunkSize is the number of bytes per TPM2_SequenceUpdate.  0 queries the TPM.
+*/
+
+TPM_RC sequenceHmacStart(SEQUENCE_STREAM *stream,
+			 TSS_CONTEXT *tssContext,
+			 TPMI_DH_OBJECT keyHandle,
+			 const char *keyPassword,
+			 TPMI_SH_AUTH_SESSION sessionHandle,
+			 unsigned int sessionAttributes,
+			 TPMI_ALG_HASH halg,
+			 uint32_t chunkSize)
+{
+    TPM_RC			rc = 0;
+    HMAC_Start_In 		in;
+    HMAC_Start_Out 		out;
+
+    if (rc == 0) {
+	rc = sequenceStreamInit(stream, tssContext, chunkSize);
+    }
+    if (rc == 0) {
+	in.handle = keyHandle;
+	in.auth.t.size = 0;
+	in.hashAlg = halg;
+	rc = TSS_Execute(tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_HMAC_Start,
+			 sessionHandle, keyPassword, sessionAttributes,
+			 TPM_RH_NULL, NULL, 0);
+	stream->tpmCommands++;
+    }
+    if (rc == 0) {
+	stream->sequenceHandle = out.sequenceHandle;
+	if (tssUtilsVerbose) printf("sequenceHmacStart: handle %08x\n", stream->sequenceHandle);
+    }
+    return rc;
+}
+
+/* sequenceUpdate() adds data to the sequence.
+
+   Data is accumulated until a full chunk is available.  A full chunk is only sent when more data
+   follows it, so that the last chunk can be sent with TPM2_SequenceComplete().
+*/
+
+TPM_RC sequenceUpdate(SEQUENCE_STREAM *stream,
+		      const uint8_t *data,
+		      size_t length)
+{
+    TPM_RC	rc = 0;
+    uint32_t	copyLength;
+
+    while ((rc == 0) && (length > 0)) {
+	/* the pending chunk is full and there is more data, so it is not the last chunk */
+	if (stream->pending.t.size == stream->chunkSize) {
+	    rc = sequenceSendChunk(stream);
+	}
+	if (rc == 0) {
+	    copyLength = stream->chunkSize - stream->pending.t.size;
+	    if (copyLength > length) {
+		copyLength = (uint32_t)length;
+	    }
+	    memcpy(stream->pending.t.buffer + stream->pending.t.size, data, copyLength);
+	    stream->pending.t.size += (uint16_t)copyLength;	/* cast safe, at most chunkSize */
+	    stream->totalBytes += copyLength;
+	    data += copyLength;
+	    length -= copyLength;
+	}
+    }
+    return rc;
+}
+
+#ifndef TPM_TSS_NOFILE
+
+/* sequenceUpdateFile() adds the contents of filename to the sequence.
+
+   The file is read sequentially in chunks through a large stdio buffer, so the whole file is never
+   in memory.
+*/
+
+TPM_RC sequenceUpdateFile(SEQUENCE_STREAM *stream,
+			  const char *filename)
+{
+    TPM_RC	rc = 0;
+    FILE	*file = NULL;
+    uint8_t	*readBuffer = NULL;
+    size_t	readLength;
+
+    if (rc == 0) {
+	rc = TSS_File_Open(&file, filename, "rb");	/* closed @1 */
+    }
+    if (rc == 0) {
+	rc = TSS_Malloc(&readBuffer, stream->chunkSize);	/* freed @2 */
+    }
+    if (rc == 0) {
+	/* not fatal, the default buffer still works */
+	setvbuf(file, NULL, _IOFBF, SEQUENCE_FILE_BUFFER_SIZE);
+    }
+    while (rc == 0) {
+	readLength = fread(readBuffer, 1, stream->chunkSize, file);
+	if (readLength > 0) {
+	    rc = sequenceUpdate(stream, readBuffer, readLength);
+	}
+	if (readLength < stream->chunkSize) {
+	    if (ferror(file)) {
+		if (tssUtilsVerbose) printf("sequenceUpdateFile: Error reading %s\n", filename);
+		rc = TSS_RC_FILE_READ;
+	    }
+	    break;	/* end of file */
+	}
+    }
+    if (file != NULL) {
+	fclose(file);		/* @1 */
+    }
+    free(readBuffer);		/* @2 */
+    return rc;
+}
+
+#endif	/* TPM_TSS_NOFILE */
+
+/* sequenceComplete() sends the last chunk with TPM2_SequenceComplete() and returns the result.
+
+   For a hash sequence, hierarchy selects the ticket hierarchy and validation, if not NULL, returns
+   the ticket.  For an HMAC sequence, use TPM_RH_NULL.
+*/
+
+TPM_RC sequenceComplete(SEQUENCE_STREAM *stream,
+			TPMI_RH_HIERARCHY hierarchy,
+			TPM2B_DIGEST *result,
+			TPMT_TK_HASHCHECK *validation)
+{
+    TPM_RC			rc = 0;
+    SequenceComplete_In 	in;
+    SequenceComplete_Out 	out;
+
+    if (rc == 0) {
+	in.sequenceHandle = stream->sequenceHandle;
+	in.buffer = stream->pending;
+	in.hierarchy = hierarchy;
+	rc = TSS_Execute(stream->tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_SequenceComplete,
+			 TPM_RS_PW, NULL, 0,
+			 TPM_RH_NULL, NULL, 0);
+	stream->tpmCommands++;
+    }
+    /* the TPM flushes the sequence object on success */
+    if (rc == 0) {
+	stream->sequenceHandle = TPM_RH_NULL;
+	stream->pending.t.size = 0;
+	*result = out.result;
+	if (validation != NULL) {
+	    *validation = out.validation;
+	}
+	if (tssUtilsVerbose) printf("sequenceComplete: %llu bytes in %u commands\n",
+				    (unsigned long long)stream->totalBytes, stream->tpmCommands);
+    }
+    return rc;
+}
+
+/* sequenceAbort() flushes an active sequence.  It is safe to call if no sequence is active. */
+
+TPM_RC sequenceAbort(SEQUENCE_STREAM *stream)
+{
+    TPM_RC		rc = 0;
+    FlushContext_In 	in;
+
+    if (stream->sequenceHandle != TPM_RH_NULL) {
+	in.flushHandle = stream->sequenceHandle;
+	rc = TSS_Execute(stream->tssContext,
+			 NULL,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_FlushContext,
+			 TPM_RH_NULL, NULL, 0);
+	stream->sequenceHandle = TPM_RH_NULL;
+    }
+    stream->pending.t.size = 0;
+    return rc;
+}
+
+/* sequenceStreamInit() initializes the stream and determines the chunk size */
+
+static TPM_RC sequenceStreamInit(SEQUENCE_STREAM *stream,
+				 TSS_CONTEXT *tssContext,
+				 uint32_t chunkSize)
+{
+    TPM_RC	rc = 0;
+
+    stream->tssContext = tssContext;
+    stream->sequenceHandle = TPM_RH_NULL;
+    stream->pending.t.size = 0;
+    stream->totalBytes = 0;
+    stream->tpmCommands = 0;
+    if (chunkSize == 0) {
+	rc = sequenceGetChunkSize(tssContext, &chunkSize);
+	stream->tpmCommands++;
+    }
+    if (rc == 0) {
+	if (chunkSize == 0) {
+	    if (tssUtilsVerbose) printf("sequenceStreamInit: Error, chunk size 0\n");
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+    }
+    if (rc == 0) {
+	if (chunkSize > sizeof(stream->pending.t.buffer)) {
+	    chunkSize = sizeof(stream->pending.t.buffer);
+	}
+	stream->chunkSize = chunkSize;
+    }
+    return rc;
+}
+
+/* sequenceSendChunk() sends the pending chunk with TPM2_SequenceUpdate() */
+
+static TPM_RC sequenceSendChunk(SEQUENCE_STREAM *stream)
+{
+    TPM_RC			rc = 0;
+    SequenceUpdate_In 		in;
+
+    if (rc == 0) {
+	in.sequenceHandle = stream->sequenceHandle;
+	in.buffer = stream->pending;
+	rc = TSS_Execute(stream->tssContext,
+			 NULL,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_SequenceUpdate,
+			 TPM_RS_PW, NULL, 0,
+			 TPM_RH_NULL, NULL, 0);
+	stream->tpmCommands++;
+    }
+    if (rc == 0) {
+	stream->pending.t.size = 0;
+    }
+    return rc;
+}
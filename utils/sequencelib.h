@@ -0,0 +1,100 @@
+/********************************************************************************/
+/*										*/
+/*			Hash and HMAC Sequence Streaming			*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* A SEQUENCE_STREAM hashes or HMACs input of any length using a TPM hash or HMAC sequence.
+
+   TPM2_Hash and TPM2_HMAC are limited to one TPM2B_MAX_BUFFER of input.  These routines start the
+   sequence, feed TPM2_SequenceUpdate with chunks of the maximum size the TPM accepts, and send the
+   final chunk with TPM2_SequenceComplete, returning the digest and, for a hash, the ticket.
+
+   Input can be supplied in pieces of any size.  It is buffered so that each TPM command carries a
+   full chunk.
+*/
+
+#ifndef SEQUENCELIB_H
+#define SEQUENCELIB_H
+
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+
+typedef struct {
+    TSS_CONTEXT		*tssContext;	/* not owned by the stream */
+    TPMI_DH_OBJECT	sequenceHandle;	/* TPM_RH_NULL when no sequence is active */
+    uint32_t		chunkSize;	/* bytes per TPM2_SequenceUpdate */
+    TPM2B_MAX_BUFFER	pending;	/* input not yet sent to the TPM */
+    uint64_t		totalBytes;	/* input bytes, for tracing */
+    uint32_t		tpmCommands;	/* TPM commands sent, for tracing */
+} SEQUENCE_STREAM;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    TPM_RC sequenceHashStart(SEQUENCE_STREAM *stream,
+			     TSS_CONTEXT *tssContext,
+			     TPMI_ALG_HASH halg,
+			     uint32_t chunkSize);
+    TPM_RC sequenceHmacStart(SEQUENCE_STREAM *stream,
+			     TSS_CONTEXT *tssContext,
+			     TPMI_DH_OBJECT keyHandle,
+			     const char *keyPassword,
+			     TPMI_SH_AUTH_SESSION sessionHandle,
+			     unsigned int sessionAttributes,
+			     TPMI_ALG_HASH halg,
+			     uint32_t chunkSize);
+    TPM_RC sequenceUpdate(SEQUENCE_STREAM *stream,
+			  const uint8_t *data,
+			  size_t length);
+#ifndef TPM_TSS_NOFILE
+    TPM_RC sequenceUpdateFile(SEQUENCE_STREAM *stream,
+			      const char *filename);
+#endif
+    TPM_RC sequenceComplete(SEQUENCE_STREAM *stream,
+			    TPMI_RH_HIERARCHY hierarchy,
+			    TPM2B_DIGEST *result,
+			    TPMT_TK_HASHCHECK *validation);
+    TPM_RC sequenceAbort(SEQUENCE_STREAM *stream);
+    TPM_RC sequenceGetChunkSize(TSS_CONTEXT *tssContext,
+				uint32_t *chunkSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -61,8 +61,13 @@
 #include <ibmtss/Unmarshal_fp.h>
 
 #include "cryptoutils.h"
+#include "merklelib.h"
 
 static void printUsage(void);
+static TPM_RC readDigestList(TPM2B_DIGEST **digests,
+			     uint32_t *digestCount,
+			     TPMI_ALG_HASH halg,
+			     const char *messageListFilename);
 
 extern int tssUtilsVerbose;
 
@@ -77,6 +82,11 @@ int main(int argc, char *argv[])
     TPMI_ALG_HASH		halg = TPM_ALG_SHA256;
     TPMI_ALG_SIG_SCHEME		scheme = TPM_ALG_RSASSA;
     const char			*messageFilename = NULL;
+    const char			*messageListFilename = NULL;
+    const char			*proofFilenamePrefix = NULL;
+    TPM2B_DIGEST		*digests = NULL;
+    uint32_t			digestCount = 0;
+    MERKLE_TREE			*tree = NULL;
     const char                  *counterFilename = NULL;
     const char			*ticketFilename = NULL;
     const char			*publicKeyFilename = NULL;
@@ -211,6 +221,26 @@ int main(int argc, char *argv[])
 		printUsage();
 	    }
 	}
+	else if (strcmp(argv[i],"-ifl") == 0) {
+	    i++;
+	    if (i < argc) {
+		messageListFilename = argv[i];
+	    }
+	    else {
+		printf("-ifl option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-op") == 0) {
+	    i++;
+	    if (i < argc) {
+		proofFilenamePrefix = argv[i];
+	    }
+	    else {
+		printf("-op option needs a value\n");
+		printUsage();
+	    }
+	}
 	else if (strcmp(argv[i],"-ipu") == 0) {
 	    i++;
 	    if (i < argc) {
@@ -319,8 +349,17 @@ int main(int argc, char *argv[])
 	    printUsage();
 	}
     }
-    if (messageFilename == NULL) {
-	printf("Missing message file name -if\n");
+    if ((messageFilename == NULL) && (messageListFilename == NULL)) {
+	printf("Missing message file name -if or message list file name -ifl\n");
+	printUsage();
+    }
+    if ((messageFilename != NULL) && (messageListFilename != NULL)) {
+	printf("-if and -ifl cannot both be specified\n");
+	printUsage();
+    }
+    if ((messageListFilename != NULL) &&
+	((sessionHandle1 != TPM_RH_NULL) || (sessionHandle2 != TPM_RH_NULL))) {
+	printf("-ifl supports only -se0\n");
 	printUsage();
     }
     if (keyHandle == 0) {
@@ -331,13 +370,13 @@ int main(int argc, char *argv[])
 	printf("Missing counter file name -cf for ECDAA algorithm\n");
 	printUsage();
     }
-    if (rc == 0) {
+    if ((rc == 0) && (messageFilename != NULL)) {
 	rc = TSS_File_ReadBinaryFile(&data,     /* freed @1 */
 				     &length,
 				     messageFilename);
     }
     /* hash the file */
-    if (rc == 0) {
+    if ((rc == 0) && (messageFilename != NULL)) {
 	digest.hashAlg = halg;
 	sizeInBytes = TSS_GetDigestSize(digest.hashAlg);
 	rc = TSS_Hash_Generate(&digest,
@@ -348,9 +387,11 @@ int main(int argc, char *argv[])
 	/* Handle of key that will perform signing */
 	in.keyHandle = keyHandle;
 
-	/* digest to be signed */
-	in.digest.t.size = sizeInBytes;
-	memcpy(&in.digest.t.buffer, (uint8_t *)&digest.digest, sizeInBytes);
+	/* digest to be signed, for -ifl the Merkle root is set by merkleSignBatch() */
+	if (messageFilename != NULL) {
+	    in.digest.t.size = sizeInBytes;
+	    memcpy(&in.digest.t.buffer, (uint8_t *)&digest.digest, sizeInBytes);
+	}
 	/* Table 145 - Definition of TPMT_SIG_SCHEME inScheme */
 	in.inScheme.scheme = scheme;
 	/* Table 144 - Definition of TPMU_SIG_SCHEME details > */
@@ -385,12 +426,25 @@ int main(int argc, char *argv[])
 					ticketFilename);
 	}
     }
+    if ((rc == 0) && (messageListFilename != NULL)) {
+	rc = readDigestList(&digests, &digestCount, halg,	/* freed @3 */
+			    messageListFilename);
+    }
     /* Start a TSS context */
     if (rc == 0) {
 	rc = TSS_Create(&tssContext);
     }
+    /* one signature over the Merkle root of all the digests */
+    if ((rc == 0) && (messageListFilename != NULL)) {
+	rc = merkleSignBatch(tssContext,
+			     &out,
+			     &tree,			/* freed @4 */
+			     &in,
+			     digestCount, digests,
+			     sessionHandle0, keyPassword, sessionAttributes0);
+    }
     /* call TSS to execute the command */
-    if (rc == 0) {
+    if ((rc == 0) && (messageListFilename == NULL)) {
 	rc = TSS_Execute(tssContext,
 			 (RESPONSE_PARAMETERS *)&out,
 			 (COMMAND_PARAMETERS *)&in,
@@ -412,6 +466,9 @@ int main(int argc, char *argv[])
 				     (MarshalFunction_t)TSS_TPMT_SIGNATURE_Marshalu,
 				     signatureFilename);
     }
+    if ((rc == 0) && (tree != NULL) && (proofFilenamePrefix != NULL)) {
+	rc = merkleProofWriteFiles(tree, proofFilenamePrefix);
+    }
     /* if a public key was specified, use openssl to verify the signature using an openssl RSA
        format key token */
     if (publicKeyFilename != NULL) {
@@ -449,6 +506,8 @@ int main(int argc, char *argv[])
 	TSS_RsaFree(rsaPubKey); 		/* @2 */
     }
     free(data);					/* @1 */
+    free(digests);				/* @3 */
+    merkleTreeDelete(tree);			/* @4 */
     if (rc == 0) {
 	if (tssUtilsVerbose) printf("sign: success\n");
     }
@@ -464,6 +523,72 @@ int main(int argc, char *argv[])
     return rc;
 }
     
+/* readDigestList() reads the message file names, one per line, and hashes each message with
+   halg */
+
+static TPM_RC readDigestList(TPM2B_DIGEST **digests,	/* freed by caller */
+			     uint32_t *digestCount,
+			     TPMI_ALG_HASH halg,
+			     const char *messageListFilename)
+{
+    TPM_RC	rc = 0;
+    FILE	*listFile = NULL;
+    char	line[4096];
+    uint32_t	digestMax = 0;
+
+    if (rc == 0) {
+	listFile = fopen(messageListFilename, "r");
+	if (listFile == NULL) {
+	    printf("readDigestList: Error opening %s\n", messageListFilename);
+	    rc = TSS_RC_FILE_OPEN;
+	}
+    }
+    while ((rc == 0) && (fgets(line, sizeof(line), listFile) != NULL)) {
+	char		*filename = strtok(line, " \t\r\n");
+	unsigned char 	*data = NULL;
+	size_t 		length;
+	TPMT_HA 	digest;
+
+	if (filename == NULL) {
+	    continue;
+	}
+	if (*digestCount == digestMax) {
+	    TPM2B_DIGEST *tmp;
+	    digestMax = (digestMax == 0) ? 64 : (digestMax * 2);
+	    /* not TSS_Realloc(), a large batch can exceed its size limit */
+	    tmp = realloc(*digests, digestMax * sizeof(TPM2B_DIGEST));
+	    if (tmp == NULL) {
+		printf("readDigestList: Error allocating %u digests\n", digestMax);
+		rc = TSS_RC_OUT_OF_MEMORY;
+		break;
+	    }
+	    *digests = tmp;
+	}
+	rc = TSS_File_ReadBinaryFile(&data,     /* freed @1 */
+				     &length,
+				     filename);
+	if (rc == 0) {
+	    digest.hashAlg = halg;
+	    rc = TSS_Hash_Generate(&digest,
+				   length, data,
+				   0, NULL);
+	}
+	if (rc == 0) {
+	    rc = TSS_TPM2B_Create(&(*digests)[*digestCount].b,
+				  (uint8_t *)&digest.digest, TSS_GetDigestSize(halg),
+				  sizeof((*digests)[*digestCount].t.buffer));
+	}
+	if (rc == 0) {
+	    (*digestCount)++;
+	}
+	free(data);		/* @1 */
+    }
+    if (listFile != NULL) {
+	fclose(listFile);
+    }
+    return rc;
+}
+
 static void printUsage(void)
 {
     printf("\n");
@@ -479,6 +604,9 @@ static void printUsage(void)
     printf("\t[-scheme signing scheme (rsassa, rsapss, ecdsa, ecdaa, hmac)]\n");
     printf("\t\t(default rsassa, ecdsa, hmac)]\n");
     printf("\t[-cf\tinput counter file (commit count required for ECDAA scheme]\n");
+    printf("\t[-ifl\tlist of message file names to hash and sign, one per line]\n");
+    printf("\t\tSigns once over the Merkle root of the message digests\n");
+    printf("\t[-op\tinclusion proof file name prefix for -ifl, writes prefixN.bin]\n");
     printf("\t[-ipu\tpublic key file name to verify signature (default no verify)]\n");
     printf("\t\tVerify only supported for RSA now\n");
     printf("\t[-os\tsignature file name (default do not save)]\n");
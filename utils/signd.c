@@ -0,0 +1,1171 @@
+/********************************************************************************/
+/*										*/
+/*				 Signing Daemon					*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* signd is a long running signing service.
+
+   The signing key is loaded (or referenced by handle) once and, optionally, an HMAC session is
+   started once with continueSession SET.  If the TPM reports that the session is no longer valid
+   (e.g., after a TPM restart or a resource manager flush), the session is restarted and the
+   command is retried once.
+
+   Clients connect over a Unix domain socket and send any number of requests without waiting for
+   the responses.  Requests are executed in order, one at a time, since the TPM serializes
+   commands anyway.  The latency from request receipt to signature is returned with each
+   response.
+
+   Since any client can have any digest signed, the socket is created mode 0600, so only the
+   daemon's user can connect.  An existing file at the socket path is removed only if it is a
+   socket.  Responses are written without blocking.  A client that stops reading its responses
+   is no longer read from, so it cannot stall the other clients.
+
+   request:	uint16 digest size, digest
+   response:	uint32 rc, uint32 latency in microseconds, uint16 signature size, TPMT_SIGNATURE
+
+   All integers are big endian.
+
+   The same program is a test client with -client.
+
+   Since the daemon holds its TPM connection open, use it with a resource manager or tpmproxy
+   when other programs share the TPM.
+
+   This program uses Unix domain sockets and is POSIX only.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/un.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tssresponsecode.h>
+#include <ibmtss/tssmarshal.h>
+#include <ibmtss/tsscryptoh.h>
+#include <ibmtss/tsscrypto.h>
+#include <ibmtss/Unmarshal_fp.h>
+
+#define SIGND_SOCKET_DEFAULT	"/tmp/signd.sock"
+#define SIGND_CLIENTS_MAX	16
+/* request header plus the largest digest */
+#define SIGND_REQUEST_MAX	(sizeof(uint16_t) + sizeof(TPMU_HA))
+#define SIGND_RESPONSE_HEADER	(sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint16_t))
+#define SIGND_RESPONSE_MAX	(SIGND_RESPONSE_HEADER + sizeof(TPMT_SIGNATURE))
+/* unsent responses per client, requests are not read while there is no room for another */
+#define SIGND_OUTPUT_MAX	(4 * SIGND_RESPONSE_MAX)
+
+/* the daemon state, one key and at most one session */
+
+typedef struct {
+    TSS_CONTEXT			*tssContext;
+    TPMI_DH_OBJECT		keyHandle;
+    int				keyLoaded;	/* flush the key at exit */
+    const char			*keyPassword;
+    TPMI_ALG_HASH		halg;
+    TPMI_ALG_SIG_SCHEME		scheme;
+    int				useSession;
+    TPMI_SH_AUTH_SESSION	sessionHandle;	/* TPM_RH_NULL if not started */
+    /* statistics */
+    uint32_t			requests;
+    uint32_t			failures;
+    uint32_t			sessionRestarts;
+    uint64_t			latencyTotal;	/* microseconds */
+    uint32_t			latencyMin;
+    uint32_t			latencyMax;
+} SIGND_STATE;
+
+/* a connected client, its partially received request, and its unsent responses */
+
+typedef struct {
+    int				fd;		/* -1 if unused */
+    uint8_t			buffer[SIGND_REQUEST_MAX];
+    size_t			length;
+    uint8_t			output[SIGND_OUTPUT_MAX];
+    size_t			outputLength;
+} SIGND_CLIENT;
+
+static void printUsage(void);
+static void signalHandler(int sig);
+static uint64_t timeMicroseconds(void);
+static TPM_RC loadKey(SIGND_STATE *state,
+		      TPMI_DH_OBJECT parentHandle,
+		      const char *parentPassword,
+		      const char *privateKeyFilename,
+		      const char *publicKeyFilename);
+static TPM_RC startSession(SIGND_STATE *state);
+static void flushHandle(SIGND_STATE *state,
+			TPM_HANDLE handle);
+static int sessionInvalid(TPM_RC rc);
+static TPM_RC signDigest(SIGND_STATE *state,
+			 TPMT_SIGNATURE *signature,
+			 const uint8_t *digest,
+			 uint16_t digestSize);
+static int serveRequest(SIGND_STATE *state,
+			SIGND_CLIENT *client,
+			uint64_t receiveTime);
+static TPM_RC serve(SIGND_STATE *state,
+		    const char *socketFilename,
+		    uint32_t requestLimit);
+static TPM_RC clientFlush(SIGND_CLIENT *client);
+static TPM_RC socketWriteAll(int fd,
+			     const uint8_t *buffer,
+			     size_t length);
+static TPM_RC socketReadAll(int fd,
+			    uint8_t *buffer,
+			    size_t length);
+static TPM_RC client(const char *socketFilename,
+		     TPMI_ALG_HASH halg,
+		     const char *messageFilename,
+		     uint32_t count,
+		     const char *signatureFilename);
+
+extern int tssUtilsVerbose;
+
+/* set by SIGINT or SIGTERM to end the server loop */
+static volatile sig_atomic_t terminate = 0;
+
+int main(int argc, char *argv[])
+{
+    TPM_RC			rc = 0;
+    int				i;    /* argc iterator */
+    SIGND_STATE			state;
+    TPMI_DH_OBJECT		parentHandle = 0;
+    const char			*parentPassword = NULL;
+    const char			*privateKeyFilename = NULL;
+    const char			*publicKeyFilename = NULL;
+    const char			*socketFilename = SIGND_SOCKET_DEFAULT;
+    int				clientMode = FALSE;
+    const char			*messageFilename = NULL;
+    const char			*signatureFilename = NULL;
+    uint32_t			count = 1;		/* client requests */
+    uint32_t			requestLimit = 0;	/* server requests, 0 is no limit */
+
+    setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
+    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "1");
+    tssUtilsVerbose = FALSE;
+
+    memset(&state, 0, sizeof(SIGND_STATE));
+    state.keyHandle = 0;
+    state.halg = TPM_ALG_SHA256;
+    state.scheme = TPM_ALG_RSASSA;
+    state.sessionHandle = TPM_RH_NULL;
+    state.latencyMin = UINT32_MAX;
+    
+    /* command line argument defaults */
+    for (i=1 ; (i<argc) && (rc == 0) ; i++) {
+	if (strcmp(argv[i],"-hk") == 0) {
+	    i++;
+	    if (i < argc) {
+		sscanf(argv[i],"%x",&state.keyHandle);
+	    }
+	    else {
+		printf("Missing parameter for -hk\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-hp") == 0) {
+	    i++;
+	    if (i < argc) {
+		sscanf(argv[i],"%x",&parentHandle);
+	    }
+	    else {
+		printf("Missing parameter for -hp\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-pwdp") == 0) {
+	    i++;
+	    if (i < argc) {
+		parentPassword = argv[i];
+	    }
+	    else {
+		printf("-pwdp option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-ipr") == 0) {
+	    i++;
+	    if (i < argc) {
+		privateKeyFilename = argv[i];
+	    }
+	    else {
+		printf("-ipr option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-ipu") == 0) {
+	    i++;
+	    if (i < argc) {
+		publicKeyFilename = argv[i];
+	    }
+	    else {
+		printf("-ipu option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-pwdk") == 0) {
+	    i++;
+	    if (i < argc) {
+		state.keyPassword = argv[i];
+	    }
+	    else {
+		printf("-pwdk option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-halg") == 0) {
+	    i++;
+	    if (i < argc) {
+		if (strcmp(argv[i],"sha1") == 0) {
+		    state.halg = TPM_ALG_SHA1;
+		}
+		else if (strcmp(argv[i],"sha256") == 0) {
+		    state.halg = TPM_ALG_SHA256;
+		}
+		else if (strcmp(argv[i],"sha384") == 0) {
+		    state.halg = TPM_ALG_SHA384;
+		}
+		else if (strcmp(argv[i],"sha512") == 0) {
+		    state.halg = TPM_ALG_SHA512;
+		}
+		else {
+		    printf("Bad parameter %s for -halg\n", argv[i]);
+		    printUsage();
+		}
+	    }
+	    else {
+		printf("-halg option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-scheme") == 0) {
+            i++;
+	    if (i < argc) {
+		if (strcmp(argv[i],"rsassa") == 0) {
+		    state.scheme = TPM_ALG_RSASSA;
+		}
+		else if (strcmp(argv[i],"rsapss") == 0) {
+		    state.scheme = TPM_ALG_RSAPSS;
+		}
+		else if (strcmp(argv[i],"ecdsa") == 0) {
+		    state.scheme = TPM_ALG_ECDSA;
+		}
+		else if (strcmp(argv[i],"hmac") == 0) {
+		    state.scheme = TPM_ALG_HMAC;
+		}
+		else {
+		    printf("Bad parameter %s for -scheme\n", argv[i]);
+		    printUsage();
+		}
+	    }
+	    else {
+		printf("-scheme option needs a value\n");
+		printUsage();
+	    }
+        }
+	else if (strcmp(argv[i],"-se") == 0) {
+	    state.useSession = TRUE;
+	}
+	else if (strcmp(argv[i],"-sock") == 0) {
+	    i++;
+	    if (i < argc) {
+		socketFilename = argv[i];
+	    }
+	    else {
+		printf("-sock option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-n") == 0) {
+	    i++;
+	    if (i < argc) {
+		sscanf(argv[i],"%u", &requestLimit);
+	    }
+	    else {
+		printf("-n option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-client") == 0) {
+	    clientMode = TRUE;
+	}
+	else if (strcmp(argv[i],"-if") == 0) {
+	    i++;
+	    if (i < argc) {
+		messageFilename = argv[i];
+	    }
+	    else {
+		printf("-if option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-cnt") == 0) {
+	    i++;
+	    if (i < argc) {
+		sscanf(argv[i],"%u", &count);
+	    }
+	    else {
+		printf("-cnt option needs a value\n");
+		printUsage();
+	    }
+	}
+ 	else if (strcmp(argv[i],"-os") == 0) {
+	    i++;
+	    if (i < argc) {
+		signatureFilename = argv[i];
+	    }
+	    else {
+		printf("-os option needs a value\n");
+		printUsage();
+	    }
+	}
+ 	else if (strcmp(argv[i],"-h") == 0) {
+	    printUsage();
+	}
+	else if (strcmp(argv[i],"-v") == 0) {
+	    tssUtilsVerbose = TRUE;
+	    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "2");
+	}
+	else {
+	    printf("\n%s is not a valid option\n", argv[i]);
+	    printUsage();
+	}
+    }
+    if (strlen(socketFilename) >= sizeof(((struct sockaddr_un *)NULL)->sun_path)) {
+	printf("-sock name %s is too long\n", socketFilename);
+	printUsage();
+    }
+    if (clientMode) {
+	if (messageFilename == NULL) {
+	    printf("Missing message file name -if\n");
+	    printUsage();
+	}
+	if (count == 0) {
+	    printf("-cnt must be at least 1\n");
+	    printUsage();
+	}
+	rc = client(socketFilename, state.halg, messageFilename, count, signatureFilename);
+    }
+    else {
+	if ((state.keyHandle == 0) && (privateKeyFilename == NULL)) {
+	    printf("Missing key handle -hk or key files -ipr and -ipu\n");
+	    printUsage();
+	}
+	if ((state.keyHandle != 0) && (privateKeyFilename != NULL)) {
+	    printf("-hk and -ipr cannot both be specified\n");
+	    printUsage();
+	}
+	if ((privateKeyFilename != NULL) &&
+	    ((publicKeyFilename == NULL) || (parentHandle == 0))) {
+	    printf("-ipr requires -ipu and -hp\n");
+	    printUsage();
+	}
+	/* Start a TSS context, kept for the life of the daemon */
+	if (rc == 0) {
+	    rc = TSS_Create(&state.tssContext);
+	}
+	/* load the signing key once */
+	if ((rc == 0) && (privateKeyFilename != NULL)) {
+	    rc = loadKey(&state, parentHandle, parentPassword,
+			 privateKeyFilename, publicKeyFilename);
+	}
+	if ((rc == 0) && state.useSession) {
+	    rc = startSession(&state);
+	}
+	if (rc == 0) {
+	    rc = serve(&state, socketFilename, requestLimit);
+	}
+	if (state.sessionHandle != TPM_RH_NULL) {
+	    flushHandle(&state, state.sessionHandle);
+	}
+	if (state.keyLoaded) {
+	    flushHandle(&state, state.keyHandle);
+	}
+	if (state.tssContext != NULL) {
+	    TPM_RC rc1 = TSS_Delete(state.tssContext);
+	    if (rc == 0) {
+		rc = rc1;
+	    }
+	}
+	if (state.requests > 0) {
+	    printf("signd: %u requests, %u failed, %u session restarts, "
+		   "latency usec min %u avg %u max %u\n",
+		   state.requests, state.failures, state.sessionRestarts,
+		   state.latencyMin,
+		   (uint32_t)(state.latencyTotal / state.requests),
+		   state.latencyMax);
+	}
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("signd: success\n");
+    }
+    else {
+	const char *msg;
+	const char *submsg;
+	const char *num;
+	printf("signd: failed, rc %08x\n", rc);
+	TSS_ResponseCode_toString(&msg, &submsg, &num, rc);
+	printf("%s%s%s\n", msg, submsg, num);
+	rc = EXIT_FAILURE;
+    }
+    return rc;
+}
+
+static void signalHandler(int sig)
+{
+    sig = sig;
+    terminate = 1;
+    return;
+}
+
+/* timeMicroseconds() returns a monotonic time in microseconds */
+
+static uint64_t timeMicroseconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
+
+/* loadKey() loads the signing key from files under parentHandle.  The key is flushed when the
+   daemon exits. */
+
+static TPM_RC loadKey(SIGND_STATE *state,
+		      TPMI_DH_OBJECT parentHandle,
+		      const char *parentPassword,
+		      const char *privateKeyFilename,
+		      const char *publicKeyFilename)
+{
+    TPM_RC	rc = 0;
+    Load_In 	in;
+    Load_Out 	out;
+
+    if (rc == 0) {
+	in.parentHandle = parentHandle;
+	rc = TSS_File_ReadStructure(&in.inPrivate,
+				    (UnmarshalFunction_t)TSS_TPM2B_PRIVATE_Unmarshalu,
+				    privateKeyFilename);
+    }
+    if (rc == 0) {
+	rc = TSS_File_ReadStructureFlag(&in.inPublic,
+					(UnmarshalFunctionFlag_t)TSS_TPM2B_PUBLIC_Unmarshalu,
+					FALSE,			/* NULL not permitted */
+					publicKeyFilename);
+    }
+    if (rc == 0) {
+	rc = TSS_Execute(state->tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_Load,
+			 TPM_RS_PW, parentPassword, 0,
+			 TPM_RH_NULL, NULL, 0);
+    }
+    if (rc == 0) {
+	state->keyHandle = out.objectHandle;
+	state->keyLoaded = TRUE;
+	if (tssUtilsVerbose) printf("signd: key handle %08x\n", state->keyHandle);
+    }
+    return rc;
+}
+
+/* startSession() starts an unbound, unsalted HMAC session.  The key password is the HMAC key. */
+
+static TPM_RC startSession(SIGND_STATE *state)
+{
+    TPM_RC			rc = 0;
+    StartAuthSession_In 	in;
+    StartAuthSession_Out 	out;
+    StartAuthSession_Extra	extra;
+
+    if (rc == 0) {
+	in.tpmKey = TPM_RH_NULL;
+	in.bind = TPM_RH_NULL;
+	extra.bindPassword = NULL;
+	in.sessionType = TPM_SE_HMAC;
+	in.authHash = TPM_ALG_SHA256;
+	in.symmetric.algorithm = TPM_ALG_NULL;
+	rc = TSS_Execute(state->tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 (EXTRA_PARAMETERS *)&extra,
+			 TPM_CC_StartAuthSession,
+			 TPM_RH_NULL, NULL, 0);
+    }
+    if (rc == 0) {
+	state->sessionHandle = out.sessionHandle;
+	if (tssUtilsVerbose) printf("signd: session handle %08x\n", state->sessionHandle);
+    }
+    return rc;
+}
+
+/* flushHandle() flushes a key or session.  Errors are ignored, since the handle may already be
+   gone. */
+
+static void flushHandle(SIGND_STATE *state,
+			TPM_HANDLE handle)
+{
+    FlushContext_In 		in;
+
+    in.flushHandle = handle;
+    TSS_Execute(state->tssContext,
+		NULL, 
+		(COMMAND_PARAMETERS *)&in,
+		NULL,
+		TPM_CC_FlushContext,
+		TPM_RH_NULL, NULL, 0);
+    return;
+}
+
+/* sessionInvalid() returns TRUE if rc indicates that the first session is no longer loaded in
+   the TPM.
+
+   Authorization failures are not included, since a retry would increment the dictionary attack
+   counter again.
+*/
+
+static int sessionInvalid(TPM_RC rc)
+{
+    int invalid = FALSE;
+    if (rc == TPM_RC_REFERENCE_S0) {
+	invalid = TRUE;
+    }
+    else if (rc == (TPM_RC_HANDLE | TPM_RC_S | TPM_RC_1)) {
+	invalid = TRUE;
+    }
+    else if (rc == (TPM_RC_VALUE | TPM_RC_S | TPM_RC_1)) {
+	invalid = TRUE;
+    }
+    else if (rc == TPM_RC_CONTEXT_GAP) {
+	invalid = TRUE;
+    }
+    return invalid;
+}
+
+/* signDigest() signs one digest with the resident key.
+
+   If the session is no longer valid, it is restarted and the command retried once.
+*/
+
+static TPM_RC signDigest(SIGND_STATE *state,
+			 TPMT_SIGNATURE *signature,
+			 const uint8_t *digest,
+			 uint16_t digestSize)
+{
+    TPM_RC			rc = 0;
+    Sign_In 			in;
+    Sign_Out 			out;
+    int				retry;
+    TPMI_SH_AUTH_SESSION    	sessionHandle;
+    unsigned int		sessionAttributes;
+
+    if (digestSize > sizeof(in.digest.t.buffer)) {
+	rc = TSS_RC_INSUFFICIENT_BUFFER;
+    }
+    if (rc == 0) {
+	in.keyHandle = state->keyHandle;
+	in.digest.t.size = digestSize;
+	memcpy(in.digest.t.buffer, digest, digestSize);
+	in.inScheme.scheme = state->scheme;
+	/* all hash based schemes have the hash algorithm in the same place */
+	in.inScheme.details.any.hashAlg = state->halg;
+	/* proof that digest was created by the TPM (NULL ticket) */
+	in.validation.tag = TPM_ST_HASHCHECK;
+	in.validation.hierarchy = TPM_RH_NULL;
+	in.validation.digest.t.size = 0;
+    }
+    for (retry = 0 ; (rc == 0) && (retry < 2) ; retry++) {
+	/* restart a session that was found invalid on the first try */
+	if (state->useSession && (state->sessionHandle == TPM_RH_NULL)) {
+	    rc = startSession(state);
+	    if (rc != 0) {
+		break;
+	    }
+	}
+	if (state->useSession) {
+	    sessionHandle = state->sessionHandle;
+	    sessionAttributes = TPMA_SESSION_CONTINUESESSION;
+	}
+	else {
+	    sessionHandle = TPM_RS_PW;
+	    sessionAttributes = 0;
+	}
+	rc = TSS_Execute(state->tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_Sign,
+			 sessionHandle, state->keyPassword, sessionAttributes,
+			 TPM_RH_NULL, NULL, 0);
+	if ((rc != 0) && state->useSession && (retry == 0) && sessionInvalid(rc)) {
+	    if (tssUtilsVerbose) printf("signd: session %08x invalid, rc %08x, restarting\n",
+					state->sessionHandle, rc);
+	    flushHandle(state, state->sessionHandle);
+	    state->sessionHandle = TPM_RH_NULL;
+	    state->sessionRestarts++;
+	    rc = 0;
+	}
+	else {
+	    break;
+	}
+    }
+    if (rc == 0) {
+	*signature = out.signature;
+    }
+    return rc;
+}
+
+/* serveRequest() signs the complete request in the client buffer and queues the response.  The
+   caller guarantees room for SIGND_RESPONSE_MAX in the client output.
+
+   Returns FALSE if the client connection should be closed.
+*/
+
+static int serveRequest(SIGND_STATE *state,
+			SIGND_CLIENT *client,
+			uint64_t receiveTime)
+{
+    TPM_RC		rc = 0;
+    TPM_RC		signRc;
+    TPMT_SIGNATURE	signature;
+    uint32_t		latency;
+    uint16_t		signatureSize = 0;
+    uint8_t		response[SIGND_RESPONSE_MAX];
+    uint8_t		*buffer;
+    uint32_t		size;
+    UINT16		written;
+
+    signRc = signDigest(state, &signature,
+			client->buffer + sizeof(uint16_t),
+			(uint16_t)(client->length - sizeof(uint16_t)));
+    latency = (uint32_t)(timeMicroseconds() - receiveTime);
+    /* marshal the signature after the header */
+    if (signRc == 0) {
+	buffer = response + SIGND_RESPONSE_HEADER;
+	size = sizeof(response) - SIGND_RESPONSE_HEADER;
+	written = 0;
+	rc = TSS_TPMT_SIGNATURE_Marshalu(&signature, &written, &buffer, &size);
+	signatureSize = written;
+    }
+    if (rc == 0) {
+	buffer = response;
+	size = SIGND_RESPONSE_HEADER;
+	written = 0;
+	rc = TSS_UINT32_Marshalu(&signRc, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(&latency, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT16_Marshalu(&signatureSize, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	memcpy(client->output + client->outputLength, response,
+	       SIGND_RESPONSE_HEADER + signatureSize);
+	client->outputLength += SIGND_RESPONSE_HEADER + signatureSize;
+	rc = clientFlush(client);
+    }
+    /* statistics */
+    state->requests++;
+    if (signRc != 0) {
+	state->failures++;
+    }
+    state->latencyTotal += latency;
+    if (latency < state->latencyMin) {
+	state->latencyMin = latency;
+    }
+    if (latency > state->latencyMax) {
+	state->latencyMax = latency;
+    }
+    if (tssUtilsVerbose) printf("signd: request %u fd %d rc %08x latency %u usec\n",
+				state->requests, client->fd, signRc, latency);
+    client->length = 0;
+    return (rc == 0);
+}
+
+/* serve() accepts client connections on socketFilename and serves requests until SIGINT,
+   SIGTERM, or requestLimit requests if it is not zero.  After the last request, it exits once the
+   responses are sent. */
+
+static TPM_RC serve(SIGND_STATE *state,
+		    const char *socketFilename,
+		    uint32_t requestLimit)
+{
+    TPM_RC		rc = 0;
+    int			irc;
+    int			listenFd = -1;
+    int			bound = FALSE;		/* unlink the socket at exit */
+    struct sockaddr_un	addr;
+    struct stat		statBuf;
+    mode_t		oldMask;
+    struct sigaction	sa;
+    SIGND_CLIENT	clients[SIGND_CLIENTS_MAX];
+    fd_set		readFds;
+    fd_set		writeFds;
+    int			maxFd;
+    int			limitReached;
+    int			pending;
+    int			done = FALSE;
+    size_t		c;
+    
+    for (c = 0 ; c < SIGND_CLIENTS_MAX ; c++) {
+	clients[c].fd = -1;
+	clients[c].length = 0;
+	clients[c].outputLength = 0;
+    }
+    /* interrupted system calls are not restarted, so select() returns on a signal */
+    if (rc == 0) {
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = signalHandler;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+	/* a client that closes early must not terminate the daemon */
+	signal(SIGPIPE, SIG_IGN);
+    }
+    if (rc == 0) {
+	listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0) {
+	    printf("serve: socket error, %s\n", strerror(errno));
+	    rc = TSS_RC_NO_CONNECTION;
+	}
+    }
+    /* remove a stale socket from a previous run, but never any other kind of file */
+    if (rc == 0) {
+	if (lstat(socketFilename, &statBuf) == 0) {
+	    if (S_ISSOCK(statBuf.st_mode)) {
+		unlink(socketFilename);
+	    }
+	    else {
+		printf("serve: %s exists and is not a socket\n", socketFilename);
+		rc = TSS_RC_NO_CONNECTION;
+	    }
+	}
+    }
+    /* only the daemon user can connect, the umask closes the window before the chmod */
+    if (rc == 0) {
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socketFilename, sizeof(addr.sun_path) - 1);
+	oldMask = umask(S_IRWXG | S_IRWXO);
+	irc = bind(listenFd, (struct sockaddr *)&addr, sizeof(addr));
+	umask(oldMask);
+	if (irc != 0) {
+	    printf("serve: bind %s error, %s\n", socketFilename, strerror(errno));
+	    rc = TSS_RC_NO_CONNECTION;
+	}
+	else {
+	    bound = TRUE;
+	}
+    }
+    if (rc == 0) {
+	irc = chmod(socketFilename, S_IRUSR | S_IWUSR);
+	if (irc != 0) {
+	    printf("serve: chmod %s error, %s\n", socketFilename, strerror(errno));
+	    rc = TSS_RC_NO_CONNECTION;
+	}
+    }
+    if (rc == 0) {
+	irc = listen(listenFd, SIGND_CLIENTS_MAX);
+	if (irc != 0) {
+	    printf("serve: listen error, %s\n", strerror(errno));
+	    rc = TSS_RC_NO_CONNECTION;
+	}
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("signd: listening on %s\n", socketFilename);
+    }
+    while ((rc == 0) && !terminate && !done) {
+	limitReached = (requestLimit != 0) && (state->requests >= requestLimit);
+	pending = FALSE;
+	FD_ZERO(&readFds);
+	FD_ZERO(&writeFds);
+	maxFd = listenFd;
+	if (!limitReached) {
+	    FD_SET(listenFd, &readFds);
+	}
+	for (c = 0 ; c < SIGND_CLIENTS_MAX ; c++) {
+	    if (clients[c].fd < 0) {
+		continue;
+	    }
+	    /* a client that is not reading its responses is not read from */
+	    if (!limitReached &&
+		(clients[c].outputLength + SIGND_RESPONSE_MAX <= SIGND_OUTPUT_MAX)) {
+		FD_SET(clients[c].fd, &readFds);
+	    }
+	    if (clients[c].outputLength > 0) {
+		FD_SET(clients[c].fd, &writeFds);
+		pending = TRUE;
+	    }
+	    if (clients[c].fd > maxFd) {
+		maxFd = clients[c].fd;
+	    }
+	}
+	if (limitReached && !pending) {
+	    done = TRUE;
+	    continue;
+	}
+	irc = select(maxFd + 1, &readFds, &writeFds, NULL, NULL);
+	if (irc < 0) {
+	    if (errno != EINTR) {
+		printf("serve: select error, %s\n", strerror(errno));
+		rc = TSS_RC_NO_CONNECTION;
+	    }
+	    continue;
+	}
+	/* new connection, non-blocking so that a response write never waits for a client */
+	if (FD_ISSET(listenFd, &readFds)) {
+	    int fd = accept(listenFd, NULL, NULL);
+	    if (fd >= 0) {
+		for (c = 0 ; (c < SIGND_CLIENTS_MAX) && (clients[c].fd >= 0) ; c++);
+		if (c == SIGND_CLIENTS_MAX) {
+		    printf("serve: too many clients\n");
+		    close(fd);
+		}
+		else if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0) {
+		    printf("serve: fcntl error, %s\n", strerror(errno));
+		    close(fd);
+		}
+		else {
+		    clients[c].fd = fd;
+		    clients[c].length = 0;
+		    clients[c].outputLength = 0;
+		}
+	    }
+	}
+	for (c = 0 ; c < SIGND_CLIENTS_MAX ; c++) {
+	    ssize_t	readLength;
+	    size_t	needed;
+	    int		keep = TRUE;
+	    uint64_t	receiveTime;
+
+	    if (clients[c].fd < 0) {
+		continue;
+	    }
+	    /* send queued responses that did not fit in the socket */
+	    if (FD_ISSET(clients[c].fd, &writeFds)) {
+		keep = (clientFlush(&clients[c]) == 0);
+	    }
+	    /* read at most the rest of one request, so that each request finds room for its
+	       response, and each client's requests are served in order */
+	    if (keep && FD_ISSET(clients[c].fd, &readFds)) {
+		if (clients[c].length < sizeof(uint16_t)) {
+		    needed = sizeof(uint16_t);
+		}
+		else {
+		    needed = sizeof(uint16_t) +
+			     ((clients[c].buffer[0] << 8) | clients[c].buffer[1]);
+		}
+		readLength = read(clients[c].fd,
+				  clients[c].buffer + clients[c].length,
+				  needed - clients[c].length);
+		receiveTime = timeMicroseconds();
+		if (readLength == 0) {
+		    keep = FALSE;
+		}
+		else if (readLength < 0) {
+		    if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+			keep = FALSE;
+		    }
+		}
+		else {
+		    clients[c].length += readLength;
+		}
+		if (keep && (clients[c].length >= sizeof(uint16_t))) {
+		    needed = sizeof(uint16_t) +
+			     ((clients[c].buffer[0] << 8) | clients[c].buffer[1]);
+		    if (needed > SIGND_REQUEST_MAX) {
+			printf("serve: digest size %u too large\n",
+			       (unsigned int)(needed - sizeof(uint16_t)));
+			keep = FALSE;
+		    }
+		    else if (clients[c].length == needed) {
+			keep = serveRequest(state, &clients[c], receiveTime);
+		    }
+		}
+	    }
+	    if (!keep) {
+		close(clients[c].fd);
+		clients[c].fd = -1;
+	    }
+	}
+    }
+    for (c = 0 ; c < SIGND_CLIENTS_MAX ; c++) {
+	if (clients[c].fd >= 0) {
+	    close(clients[c].fd);
+	}
+    }
+    if (listenFd >= 0) {
+	close(listenFd);
+    }
+    if (bound) {
+	unlink(socketFilename);
+    }
+    return rc;
+}
+
+/* clientFlush() writes as much of the client's queued responses as the socket accepts without
+   blocking.  The rest stays queued until select() reports the socket writable.  Returns an error
+   if the connection failed. */
+
+static TPM_RC clientFlush(SIGND_CLIENT *client)
+{
+    TPM_RC	rc = 0;
+    ssize_t	nwritten;
+    int		full = FALSE;
+
+    while ((rc == 0) && !full && (client->outputLength > 0)) {
+	nwritten = write(client->fd, client->output, client->outputLength);
+	if (nwritten < 0) {
+	    if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+		full = TRUE;
+	    }
+	    else if (errno != EINTR) {
+		rc = TSS_RC_BAD_CONNECTION;
+	    }
+	}
+	else {
+	    client->outputLength -= nwritten;
+	    memmove(client->output, client->output + nwritten, client->outputLength);
+	}
+    }
+    return rc;
+}
+
+static TPM_RC socketWriteAll(int fd,
+			     const uint8_t *buffer,
+			     size_t length)
+{
+    TPM_RC	rc = 0;
+    ssize_t	nwritten;
+
+    while ((rc == 0) && (length > 0)) {
+	nwritten = write(fd, buffer, length);
+	if (nwritten < 0) {
+	    if (errno != EINTR) {
+		rc = TSS_RC_BAD_CONNECTION;
+	    }
+	}
+	else {
+	    buffer += nwritten;
+	    length -= nwritten;
+	}
+    }
+    return rc;
+}
+
+static TPM_RC socketReadAll(int fd,
+			    uint8_t *buffer,
+			    size_t length)
+{
+    TPM_RC	rc = 0;
+    ssize_t	nread;
+
+    while ((rc == 0) && (length > 0)) {
+	nread = read(fd, buffer, length);
+	if ((nread < 0) && (errno == EINTR)) {
+	    continue;
+	}
+	if (nread <= 0) {
+	    rc = TSS_RC_BAD_CONNECTION;
+	}
+	else {
+	    buffer += nread;
+	    length -= nread;
+	}
+    }
+    return rc;
+}
+
+/* client() hashes messageFilename, sends count pipelined requests for the digest, and then reads
+   the responses.  The last signature is written to signatureFilename. */
+
+static TPM_RC client(const char *socketFilename,
+		     TPMI_ALG_HASH halg,
+		     const char *messageFilename,
+		     uint32_t count,
+		     const char *signatureFilename)
+{
+    TPM_RC		rc = 0;
+    int			fd = -1;
+    struct sockaddr_un	addr;
+    unsigned char 	*data = NULL;	/* message */
+    size_t 		length;
+    TPMT_HA 		digest;
+    uint16_t		digestSize = 0;
+    uint8_t		request[SIGND_REQUEST_MAX];
+    uint8_t		header[SIGND_RESPONSE_HEADER];
+    uint8_t		signatureBuffer[sizeof(TPMT_SIGNATURE)];
+    TPMT_SIGNATURE	signature;
+    TPM_RC		signFailure = 0;
+    uint32_t		n;
+
+    if (rc == 0) {
+	rc = TSS_File_ReadBinaryFile(&data,     /* freed @1 */
+				     &length,
+				     messageFilename);
+    }
+    if (rc == 0) {
+	digest.hashAlg = halg;
+	digestSize = TSS_GetDigestSize(halg);
+	rc = TSS_Hash_Generate(&digest,
+			       length, data,
+			       0, NULL);
+    }
+    if (rc == 0) {
+	request[0] = (uint8_t)(digestSize >> 8);
+	request[1] = (uint8_t)(digestSize >> 0);
+	memcpy(request + sizeof(uint16_t), (uint8_t *)&digest.digest, digestSize);
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+	    printf("client: socket error, %s\n", strerror(errno));
+	    rc = TSS_RC_NO_CONNECTION;
+	}
+    }
+    if (rc == 0) {
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socketFilename, sizeof(addr.sun_path) - 1);
+	if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+	    printf("client: connect %s error, %s\n", socketFilename, strerror(errno));
+	    rc = TSS_RC_NO_CONNECTION;
+	}
+    }
+    /* pipeline all the requests before reading any response */
+    for (n = 0 ; (rc == 0) && (n < count) ; n++) {
+	rc = socketWriteAll(fd, request, sizeof(uint16_t) + digestSize);
+    }
+    for (n = 0 ; (rc == 0) && (n < count) ; n++) {
+	uint8_t		*buffer = header;
+	uint32_t	size = sizeof(header);
+	TPM_RC		signRc = 0;
+	uint32_t	latency = 0;
+	uint16_t	signatureSize = 0;
+
+	rc = socketReadAll(fd, header, sizeof(header));
+	if (rc == 0) {
+	    rc = TSS_UINT32_Unmarshalu(&signRc, &buffer, &size);
+	}
+	if (rc == 0) {
+	    rc = TSS_UINT32_Unmarshalu(&latency, &buffer, &size);
+	}
+	if (rc == 0) {
+	    rc = TSS_UINT16_Unmarshalu(&signatureSize, &buffer, &size);
+	}
+	if (rc == 0) {
+	    if (signatureSize > sizeof(signatureBuffer)) {
+		rc = TSS_RC_INSUFFICIENT_BUFFER;
+	    }
+	}
+	if (rc == 0) {
+	    rc = socketReadAll(fd, signatureBuffer, signatureSize);
+	}
+	if (rc == 0) {
+	    printf("client: response %u rc %08x latency %u usec\n", n, signRc, latency);
+	    /* read the remaining responses, report the first failure */
+	    if (signRc != 0) {
+		if (signFailure == 0) {
+		    signFailure = signRc;
+		}
+		continue;
+	    }
+	}
+	if (rc == 0) {
+	    buffer = signatureBuffer;
+	    size = signatureSize;
+	    rc = TSS_TPMT_SIGNATURE_Unmarshalu(&signature, &buffer, &size, NO);
+	}
+    }
+    if (fd >= 0) {
+	close(fd);
+    }
+    if (rc == 0) {
+	rc = signFailure;
+    }
+    if ((rc == 0) && (signatureFilename != NULL)) {
+	rc = TSS_File_WriteStructure(&signature,
+				     (MarshalFunction_t)TSS_TPMT_SIGNATURE_Marshalu,
+				     signatureFilename);
+    }
+    free(data);			/* @1 */
+    return rc;
+}
+
+static void printUsage(void)
+{
+    printf("\n");
+    printf("signd\n");
+    printf("\n");
+    printf("Long running signing service over a Unix domain socket\n");
+    printf("\n");
+    printf("Server:\n");
+    printf("\n");
+    printf("\t-hk\tkey handle of a loaded signing key\n");
+    printf("\t\tor\n");
+    printf("\t-hp\tparent handle\n");
+    printf("\t-ipr\tprivate key file name, loaded once, flushed at exit\n");
+    printf("\t-ipu\tpublic key file name\n");
+    printf("\t[-pwdp\tparent password (default empty)]\n");
+    printf("\t[-pwdk\tpassword for key (default empty)]\n");
+    printf("\t[-halg\t(sha1, sha256, sha384, sha512) (default sha256)]\n");
+    printf("\t[-scheme\tsigning scheme (rsassa rsapss ecdsa hmac) (default rsassa)]\n");
+    printf("\t[-se\tuse a resident HMAC session, restarted if invalid (default password)]\n");
+    printf("\t[-sock\tsocket file name (default %s)]\n", SIGND_SOCKET_DEFAULT);
+    printf("\t[-n\texit after n requests (default run until SIGINT or SIGTERM)]\n");
+    printf("\n");
+    printf("Client:\n");
+    printf("\n");
+    printf("\t-client\n");
+    printf("\t-if\tinput message to hash and sign\n");
+    printf("\t[-halg\t(sha1, sha256, sha384, sha512) (default sha256)]\n");
+    printf("\t[-cnt\tnumber of pipelined requests (default 1)]\n");
+    printf("\t[-os\tsignature file name]\n");
+    printf("\t[-sock\tsocket file name (default %s)]\n", SIGND_SOCKET_DEFAULT);
+    printf("\n");
+    exit(1);	
+}
@@ -0,0 +1,225 @@
+/********************************************************************************/
+/*										*/
+/*			Prepared Command Regression Test			*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* 
+   testprepared is a regression test for the prepared command API.  There is no TPM.
+
+   It checks the argument validation of TSS_Prepare(), TSS_PreparedSetHandle(), and
+   TSS_PreparedSetParameter(), which happens before any command is sent.  The complete
+   TSS_ExecutePrepared() path is tested against the TPM with pcrextend -prep.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tssresponsecode.h>
+#include <ibmtss/tssmarshal.h>
+
+static void printUsage(void);
+static int checkRc(const char *test, TPM_RC rc, TPM_RC expectRc);
+static TPM_RC marshalDigests(uint8_t *digestsBuffer,
+			     uint16_t *written,
+			     TPMI_ALG_HASH hashAlg);
+
+extern int tssUtilsVerbose;
+
+int main(int argc, char *argv[])
+{
+    TPM_RC			rc = 0;
+    int				i;    /* argc iterator */
+    int				failures = 0;
+    TSS_CONTEXT			*tssContext = NULL;
+    TSS_PREPARED		*prepared = NULL;
+    TSS_PREPARED		*unsupported = NULL;
+    PCR_Extend_In 		pcrExtendIn;
+    Load_In 			loadIn;
+    uint8_t 			digestsBuffer[sizeof(TPML_DIGEST_VALUES)];
+    uint16_t 			written;
+
+    setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
+    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "1");
+    tssUtilsVerbose = FALSE;
+
+    for (i=1 ; (i<argc) && (rc == 0) ; i++) {
+ 	if (strcmp(argv[i],"-h") == 0) {
+	    printUsage();
+	}
+	else if (strcmp(argv[i],"-v") == 0) {
+	    tssUtilsVerbose = TRUE;
+	    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "2");
+	}
+	else {
+	    printf("\n%s is not a valid option\n", argv[i]);
+	    printUsage();
+	}
+    }
+    /* Start a TSS context */
+    if (rc == 0) {
+	rc = TSS_Create(&tssContext);
+    }
+    /* PCR_Extend of one SHA-1 bank, marshaled once with a zero digest */
+    if (rc == 0) {
+	memset(&pcrExtendIn, 0, sizeof(pcrExtendIn));
+	pcrExtendIn.pcrHandle = 16;
+	pcrExtendIn.digests.count = 1;
+	pcrExtendIn.digests.digests[0].hashAlg = TPM_ALG_SHA1;
+	rc = TSS_Prepare(tssContext, &prepared,
+			 (COMMAND_PARAMETERS *)&pcrExtendIn,
+			 TPM_CC_PCR_Extend);
+	failures += checkRc("prepare PCR_Extend", rc, 0);
+    }
+    /* a SHA-1 patch has the marshaled length */
+    if (rc == 0) {
+	rc = marshalDigests(digestsBuffer, &written, TPM_ALG_SHA1);
+    }
+    if (rc == 0) {
+	failures += checkRc("patch the same length",
+			    TSS_PreparedSetParameter(prepared, 0, digestsBuffer, written),
+			    0);
+	failures += checkRc("patch from an offset",
+			    TSS_PreparedSetParameter(prepared, 4, digestsBuffer + 4, written - 4),
+			    0);
+	failures += checkRc("patch past the end",
+			    TSS_PreparedSetParameter(prepared, written + 1, digestsBuffer, 0),
+			    TSS_RC_PREPARE_SIZE);
+    }
+    /* a SHA-256 patch would change the command size */
+    if (rc == 0) {
+	rc = marshalDigests(digestsBuffer, &written, TPM_ALG_SHA256);
+    }
+    if (rc == 0) {
+	failures += checkRc("patch a different length",
+			    TSS_PreparedSetParameter(prepared, 0, digestsBuffer, written),
+			    TSS_RC_PREPARE_SIZE);
+    }
+    /* PCR_Extend has one handle */
+    if (rc == 0) {
+	failures += checkRc("set handle 0",
+			    TSS_PreparedSetHandle(prepared, 0, 17),
+			    0);
+	failures += checkRc("set handle 1",
+			    TSS_PreparedSetHandle(prepared, 1, 17),
+			    TSS_RC_BAD_HANDLE_NUMBER);
+    }
+    /* Load has a post processor that saves the public area, so it cannot be prepared */
+    if (rc == 0) {
+	memset(&loadIn, 0, sizeof(loadIn));
+	failures += checkRc("prepare Load",
+			    TSS_Prepare(tssContext, &unsupported,
+					(COMMAND_PARAMETERS *)&loadIn,
+					TPM_CC_Load),
+			    TSS_RC_PREPARE_UNSUPPORTED);
+	if (unsupported != NULL) {
+	    printf("testprepared: prepare Load returned a prepared command\n");
+	    failures++;
+	}
+    }
+    TSS_PreparedDelete(prepared);
+    TSS_PreparedDelete(unsupported);
+    {
+	TPM_RC rc1 = TSS_Delete(tssContext);
+	if (rc == 0) {
+	    rc = rc1;
+	}
+    }
+    if ((rc == 0) && (failures != 0)) {
+	printf("testprepared: %d tests failed\n", failures);
+	rc = EXIT_FAILURE;
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("testprepared: success\n");
+    }
+    else {
+	const char *msg;
+	const char *submsg;
+	const char *num;
+	printf("testprepared: failed, rc %08x\n", rc);
+	TSS_ResponseCode_toString(&msg, &submsg, &num, rc);
+	printf("%s%s%s\n", msg, submsg, num);
+	rc = EXIT_FAILURE;
+    }
+    return rc;
+}
+
+/* checkRc() prints the result of one test.  It returns 1 if rc is not expectRc. */
+
+static int checkRc(const char *test, TPM_RC rc, TPM_RC expectRc)
+{
+    if (rc != expectRc) {
+	printf("testprepared: %s failed, rc %08x expected %08x\n", test, rc, expectRc);
+	return 1;
+    }
+    if (tssUtilsVerbose) printf("testprepared: %s passed, rc %08x\n", test, rc);
+    return 0;
+}
+
+/* marshalDigests() marshals a TPML_DIGEST_VALUES with one bank of hashAlg */
+
+static TPM_RC marshalDigests(uint8_t *digestsBuffer,
+			     uint16_t *written,
+			     TPMI_ALG_HASH hashAlg)
+{
+    TPM_RC		rc = 0;
+    TPML_DIGEST_VALUES 	digests;
+    uint8_t 		*buffer = digestsBuffer;
+    uint32_t 		size = sizeof(TPML_DIGEST_VALUES);
+
+    memset(&digests, 0, sizeof(digests));
+    digests.count = 1;
+    digests.digests[0].hashAlg = hashAlg;
+    memset((uint8_t *)&digests.digests[0].digest, 0xa5, sizeof(TPMU_HA));
+    *written = 0;
+    rc = TSS_TPML_DIGEST_VALUES_Marshalu(&digests, written, &buffer, &size);
+    return rc;
+}
+
+static void printUsage(void)
+{
+    printf("\n");
+    printf("testprepared\n");
+    printf("\n");
+    printf("Regression test for TSS_Prepare(), TSS_PreparedSetHandle(),\n");
+    printf("and TSS_PreparedSetParameter().  There is no TPM.\n");
+    printf("\n");
+    printf("\t[-v\tprint each test result]\n");
+    exit(1);	
+}
@@ -0,0 +1,310 @@
+/********************************************************************************/
+/*										*/
+/*			    TSS C++ Interface Test				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/*
+   testtsshpp is a compile and regression test for the ibmtss/tss.hpp C++ interface.  There is no
+   TPM.
+
+   Compiling it checks the CommandTraits table against the _In and _Out structures and instantiates
+   Execute() with valid session lists.  tsshppcheck.sh compiles it again with each
+   TSS_HPP_NEGATIVE case, each of which must fail with the expected diagnostic.
+
+   Running it checks the ownership rules of Context, Handle, and Session, which send no command
+   while the handle is TPM_RH_NULL.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+
+#include <ibmtss/tss.hpp>
+#include <ibmtss/tssresponsecode.h>
+
+static void printUsage(void);
+static int checkRc(const char *test, TPM_RC rc, TPM_RC expectRc);
+static int checkHandle(const char *test, TPM_HANDLE handle, TPM_HANDLE expectHandle);
+TPM_RC compileSessions(TSS_CONTEXT *tssContext);
+
+static int verbose = FALSE;
+
+/* the table maps each command to its own structures and authorization handle count */
+
+static_assert(std::is_same<ibmtss::CommandTraits<TPM_CC_Quote>::In, Quote_In>::value,
+	      "Quote In");
+static_assert(std::is_same<ibmtss::CommandTraits<TPM_CC_Quote>::Out, Quote_Out>::value,
+	      "Quote Out");
+static_assert(ibmtss::CommandTraits<TPM_CC_Quote>::authHandles == 1,
+	      "Quote authHandles");
+static_assert(ibmtss::CommandTraits<TPM_CC_ActivateCredential>::authHandles == 2,
+	      "ActivateCredential authHandles");
+static_assert(std::is_same<ibmtss::CommandTraits<TPM_CC_PCR_Extend>::Out,
+	      ibmtss::NoParameters>::value,
+	      "PCR_Extend Out");
+static_assert(std::is_same<ibmtss::CommandTraits<TPM_CC_ReadClock>::In,
+	      ibmtss::NoParameters>::value,
+	      "ReadClock In");
+static_assert(ibmtss::CommandTraits<TPM_CC_ContextSave>::maxSessions == 0,
+	      "ContextSave maxSessions");
+static_assert(ibmtss::CommandTraits<TPM_CC_GetRandom>::maxSessions == MAX_SESSION_NUM,
+	      "GetRandom maxSessions");
+
+/* the owners are move only */
+
+static_assert(!std::is_copy_constructible<ibmtss::Context>::value, "Context copy");
+static_assert(!std::is_copy_constructible<ibmtss::Handle>::value, "Handle copy");
+static_assert(!std::is_copy_assignable<ibmtss::Session>::value, "Session copy");
+static_assert(std::is_move_constructible<ibmtss::Session>::value, "Session move");
+
+int main(int argc, char *argv[])
+{
+    TPM_RC			rc = 0;
+    int				i;    /* argc iterator */
+    int				failures = 0;
+
+    setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
+    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "1");
+
+    for (i=1 ; (i<argc) && (rc == 0) ; i++) {
+ 	if (strcmp(argv[i],"-h") == 0) {
+	    printUsage();
+	}
+	else if (strcmp(argv[i],"-v") == 0) {
+	    verbose = TRUE;
+	    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "2");
+	}
+	else {
+	    printf("\n%s is not a valid option\n", argv[i]);
+	    printUsage();
+	}
+    }
+    /* Context owns the TSS_CONTEXT and passes it on when moved */
+    {
+	ibmtss::Context context;
+	rc = context.Create();
+	failures += checkRc("create context", rc, 0);
+	if (rc == 0) {
+	    TSS_CONTEXT *tssContext = context.Get();
+	    ibmtss::Context moved(std::move(context));
+	    if ((context.Get() != NULL) || (moved.Get() != tssContext)) {
+		printf("testtsshpp: move context failed\n");
+		failures++;
+	    }
+	    /* Handle and Session give up the handle when moved or released, so nothing is
+	       flushed */
+	    ibmtss::Handle handle(moved, 0x80000001);
+	    ibmtss::Handle movedHandle(std::move(handle));
+	    failures += checkHandle("move handle, source", handle.Get(), TPM_RH_NULL);
+	    failures += checkHandle("move handle, target", movedHandle.Get(), 0x80000001);
+	    failures += checkHandle("release handle", movedHandle.Release(), 0x80000001);
+	    failures += checkHandle("released handle", movedHandle.Get(), TPM_RH_NULL);
+	    failures += checkRc("flush released handle", movedHandle.Flush(), 0);
+
+	    ibmtss::Session session;
+	    session.Reset(moved, 0x02000000);
+	    ibmtss::Auth auth = session.Use("a");
+	    failures += checkHandle("session auth", auth.sessionHandle, 0x02000000);
+	    if ((auth.owner != &session) ||
+		(auth.sessionAttributes != TPMA_SESSION_CONTINUESESSION)) {
+		printf("testtsshpp: session auth failed\n");
+		failures++;
+	    }
+	    ibmtss::Session movedSession;
+	    movedSession = std::move(session);
+	    failures += checkHandle("move session, source", session.Get(), TPM_RH_NULL);
+	    failures += checkHandle("move session, target", movedSession.Get(), 0x02000000);
+	    movedSession.Release();
+
+	    ibmtss::Auth password = ibmtss::Password(NULL);
+	    failures += checkHandle("password auth", password.sessionHandle, TPM_RS_PW);
+	    /* more sessions than TSS_Execute() accepts is rejected before any command is sent */
+	    {
+		ibmtss::Auth auths[MAX_SESSION_NUM + 1] = {password, password, password, password};
+		GetRandom_In in;
+		GetRandom_Out out;
+		in.bytesRequested = 1;
+		failures += checkRc("too many sessions",
+				    ibmtss::detail::Execute(moved,
+							    reinterpret_cast<RESPONSE_PARAMETERS *>(&out),
+							    reinterpret_cast<COMMAND_PARAMETERS *>(&in),
+							    NULL,
+							    TPM_CC_GetRandom,
+							    auths, MAX_SESSION_NUM + 1),
+				    TSS_RC_SESSION_NUMBER);
+	    }
+	    rc = moved.Delete();
+	    failures += checkRc("delete context", rc, 0);
+	}
+    }
+    if ((rc == 0) && (failures != 0)) {
+	printf("testtsshpp: %d tests failed\n", failures);
+	rc = EXIT_FAILURE;
+    }
+    if (rc == 0) {
+	if (verbose) printf("testtsshpp: success\n");
+    }
+    else {
+	const char *msg;
+	const char *submsg;
+	const char *num;
+	printf("testtsshpp: failed, rc %08x\n", rc);
+	TSS_ResponseCode_toString(&msg, &submsg, &num, rc);
+	printf("%s%s%s\n", msg, submsg, num);
+	rc = EXIT_FAILURE;
+    }
+    return rc;
+}
+
+/* compileSessions() is compiled but not run.  It instantiates Execute() with valid session lists,
+   and with each TSS_HPP_NEGATIVE case that tsshppcheck.sh expects to fail. */
+
+TPM_RC compileSessions(TSS_CONTEXT *tssContext)
+{
+    TPM_RC					rc = 0;
+    ibmtss::Session				session;
+    ibmtss::Command<TPM_CC_GetRandom>		getRandom;
+    ibmtss::Command<TPM_CC_Create>		create;
+    ibmtss::Command<TPM_CC_ActivateCredential>	activateCredential;
+    ibmtss::Command<TPM_CC_PCR_Read>		pcrRead;
+    ibmtss::Command<TPM_CC_ReadClock>		readClock;
+    ibmtss::Command<TPM_CC_PCR_Extend>		pcrExtend;
+    FlushContext_In				flushContextIn;
+    Quote_In					quoteIn;
+    Quote_Out					quoteOut;
+
+    if (rc == 0) {
+	rc = getRandom.Execute(tssContext);
+    }
+    if (rc == 0) {
+	rc = getRandom.Execute(tssContext, session.Use());
+    }
+    if (rc == 0) {
+	rc = create.Execute(tssContext, ibmtss::Password(NULL));
+    }
+    if (rc == 0) {
+	rc = activateCredential.Execute(tssContext,
+					ibmtss::Password(NULL), session.Use("a", 0));
+    }
+    if (rc == 0) {
+	rc = pcrRead.Execute(tssContext,
+			     session.Use(), session.Use(), session.Use());
+    }
+    if (rc == 0) {
+	rc = readClock.Execute(tssContext);
+    }
+    if (rc == 0) {
+	rc = pcrExtend.Execute(tssContext, ibmtss::Password(NULL));
+    }
+    if (rc == 0) {
+	rc = ibmtss::Execute<TPM_CC_FlushContext>(tssContext, NULL, &flushContextIn);
+    }
+    if (rc == 0) {
+	rc = ibmtss::Execute<TPM_CC_Quote>(tssContext, &quoteOut, &quoteIn,
+					   ibmtss::Password(NULL));
+    }
+#if TSS_HPP_NEGATIVE == 1
+    /* a session for a command that does not accept sessions */
+    rc = ibmtss::Execute<TPM_CC_FlushContext>(tssContext, NULL, &flushContextIn,
+					      ibmtss::Password(NULL));
+#elif TSS_HPP_NEGATIVE == 2
+    /* no session for a command with an authorization handle */
+    rc = create.Execute(tssContext);
+#elif TSS_HPP_NEGATIVE == 3
+    /* more sessions than MAX_SESSION_NUM */
+    rc = getRandom.Execute(tssContext,
+			   session.Use(), session.Use(), session.Use(), session.Use());
+#elif TSS_HPP_NEGATIVE == 4
+    /* a session that is not an ibmtss::Auth */
+    rc = getRandom.Execute(tssContext, TPM_RS_PW);
+#elif TSS_HPP_NEGATIVE == 5
+    /* the _In structure of another command */
+    {
+	Sign_In signIn;
+	rc = ibmtss::Execute<TPM_CC_Quote>(tssContext, &quoteOut, &signIn,
+					   ibmtss::Password(NULL));
+    }
+#elif TSS_HPP_NEGATIVE == 6
+    /* a command that is not in the table */
+    {
+	ibmtss::Command<TPM_CC_Vendor_TCG_Test> vendor;
+	rc = vendor.Execute(tssContext);
+    }
+#elif TSS_HPP_NEGATIVE == 7
+    /* a copy of an owner */
+    {
+	ibmtss::Session copy(session);
+	rc = copy.Flush();
+    }
+#endif
+    return rc;
+}
+
+/* checkRc() prints the result of one test.  It returns 1 if rc is not expectRc. */
+
+static int checkRc(const char *test, TPM_RC rc, TPM_RC expectRc)
+{
+    if (rc != expectRc) {
+	printf("testtsshpp: %s failed, rc %08x expected %08x\n", test, rc, expectRc);
+	return 1;
+    }
+    if (verbose) printf("testtsshpp: %s passed, rc %08x\n", test, rc);
+    return 0;
+}
+
+/* checkHandle() prints the result of one test.  It returns 1 if handle is not expectHandle. */
+
+static int checkHandle(const char *test, TPM_HANDLE handle, TPM_HANDLE expectHandle)
+{
+    if (handle != expectHandle) {
+	printf("testtsshpp: %s failed, handle %08x expected %08x\n", test, handle, expectHandle);
+	return 1;
+    }
+    if (verbose) printf("testtsshpp: %s passed, handle %08x\n", test, handle);
+    return 0;
+}
+
+static void printUsage(void)
+{
+    printf("\n");
+    printf("testtsshpp\n");
+    printf("\n");
+    printf("Regression test for the ibmtss/tss.hpp C++ interface.  There is no TPM.\n");
+    printf("\n");
+    printf("\t[-v\tprint each test result]\n");
+    exit(1);	
+}
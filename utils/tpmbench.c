@@ -0,0 +1,1033 @@
+/********************************************************************************/
+/*										*/
+/*				 TPM Benchmark					*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* 
+   tpmbench measures TPM command throughput and latency.
+
+   It runs one workload for a count of operations or a duration, timing each operation with a
+   monotonic nanosecond clock.  The TPM time is the time in the transport reported by
+   TSS_GetTransmitTime(), which includes the driver or socket.  The TSS time is the rest:
+   marshaling, sessions, and crypto.  The report has the throughput and the p50, p95, p99, and
+   maximum latency of each.
+
+   Workloads:
+
+   sign			TPM2_Sign with a primary signing key
+   quote		TPM2_Quote of PCR 16 with a primary restricted signing key
+   hmac			TPM2_HMAC with a primary keyed hash key
+   unseal		TPM2_Unseal of a sealed data object under a primary storage key
+   pcrextend		TPM2_PCR_Extend of PCR 16, SHA-256
+   nvread		TPM2_NV_Read of 32 bytes
+   nvwrite		TPM2_NV_Write of 32 bytes
+   startauthsession	TPM2_StartAuthSession and TPM2_FlushContext, -salt selects the salt key
+   createprimary	TPM2_CreatePrimary of a storage key and TPM2_FlushContext
+
+   Keys are RSA 2048, or ECC NIST P256 with -ecc.  The setup (primary keys, the sealed object, the
+   NV index) is not timed, and the teardown flushes the objects and undefines the NV index.  The
+   NV index must not already be defined.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef TPM_WINDOWS
+#include <windows.h>
+#endif
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tsstransmit.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tssresponsecode.h>
+
+#include "objecttemplates.h"
+
+#define TPMBENCH_COUNT_DEFAULT		100
+#define TPMBENCH_NV_INDEX_DEFAULT	0x01000000
+#define TPMBENCH_NV_SIZE		32
+#define TPMBENCH_PCR			16
+
+typedef struct {
+    TSS_CONTEXT			*tssContext;
+    TPMI_ALG_PUBLIC		algPublic;	/* RSA or ECC keys */
+    TPMI_ALG_PUBLIC		saltAlg;	/* startauthsession, TPM_ALG_NULL for unsalted */
+    const char			*parentPassword;	/* hierarchy password */
+    TPMI_SH_AUTH_SESSION	sessionHandle;	/* TPM_RS_PW or an HMAC session */
+    unsigned int		sessionAttributes;
+    TPMI_DH_OBJECT		keyHandle;	/* workload key or salt key */
+    TPMI_DH_OBJECT		parentHandle;	/* sealed data object parent */
+    TPMI_RH_NV_INDEX		nvIndex;
+    int				nvDefined;
+} TPMBENCH_STATE;
+
+typedef TPM_RC (*WorkloadFunction_t)(TPMBENCH_STATE *state);
+
+typedef struct {
+    const char			*name;
+    WorkloadFunction_t		setup;		/* NULL if none */
+    WorkloadFunction_t		run;		/* one operation */
+} WORKLOAD;
+
+/* latency samples in nanoseconds, one per operation */
+
+typedef struct {
+    uint64_t			*total;
+    uint64_t			*tpm;
+    uint64_t			*tss;
+    size_t			count;
+    size_t			capacity;
+} SAMPLES;
+
+static void printUsage(void);
+static uint64_t nanoseconds(void);
+static TPM_RC runWorkload(SAMPLES *samples,
+			  uint64_t *elapsed,
+			  TPMBENCH_STATE *state,
+			  const WORKLOAD *workload,
+			  unsigned long count,
+			  unsigned long seconds);
+static TPM_RC addSample(SAMPLES *samples,
+			uint64_t total,
+			uint64_t tpm);
+static void freeSamples(SAMPLES *samples);
+static int compareUint64(const void *a, const void *b);
+static double percentileMsec(uint64_t *sorted, size_t count, unsigned int percentile);
+static void printReport(SAMPLES *samples,
+			uint64_t elapsed,
+			const char *workloadName,
+			int csv);
+
+static TPM_RC createPrimary(TPMBENCH_STATE *state,
+			    TPMI_DH_OBJECT *objectHandle,
+			    int keyType,
+			    TPMI_ALG_PUBLIC algPublic);
+static TPM_RC flushContext(TPMBENCH_STATE *state,
+			   TPMI_DH_CONTEXT *flushHandle);
+static TPM_RC startSession(TPMBENCH_STATE *state,
+			   TPMI_SH_AUTH_SESSION *sessionHandle,
+			   TPMI_DH_OBJECT tpmKey);
+static TPM_RC teardown(TPMBENCH_STATE *state);
+
+static TPM_RC signSetup(TPMBENCH_STATE *state);
+static TPM_RC signRun(TPMBENCH_STATE *state);
+static TPM_RC quoteSetup(TPMBENCH_STATE *state);
+static TPM_RC quoteRun(TPMBENCH_STATE *state);
+static TPM_RC hmacSetup(TPMBENCH_STATE *state);
+static TPM_RC hmacRun(TPMBENCH_STATE *state);
+static TPM_RC unsealSetup(TPMBENCH_STATE *state);
+static TPM_RC unsealRun(TPMBENCH_STATE *state);
+static TPM_RC pcrExtendRun(TPMBENCH_STATE *state);
+static TPM_RC nvSetup(TPMBENCH_STATE *state);
+static TPM_RC nvReadSetup(TPMBENCH_STATE *state);
+static TPM_RC nvReadRun(TPMBENCH_STATE *state);
+static TPM_RC nvWriteRun(TPMBENCH_STATE *state);
+static TPM_RC startAuthSessionSetup(TPMBENCH_STATE *state);
+static TPM_RC startAuthSessionRun(TPMBENCH_STATE *state);
+static TPM_RC createPrimaryRun(TPMBENCH_STATE *state);
+
+static const WORKLOAD workloadTable[] = {
+    {"sign", signSetup, signRun},
+    {"quote", quoteSetup, quoteRun},
+    {"hmac", hmacSetup, hmacRun},
+    {"unseal", unsealSetup, unsealRun},
+    {"pcrextend", NULL, pcrExtendRun},
+    {"nvread", nvReadSetup, nvReadRun},
+    {"nvwrite", nvSetup, nvWriteRun},
+    {"startauthsession", startAuthSessionSetup, startAuthSessionRun},
+    {"createprimary", NULL, createPrimaryRun},
+};
+
+extern int tssUtilsVerbose;
+
+int main(int argc, char *argv[])
+{
+    TPM_RC			rc = 0;
+    TPM_RC			rc1;
+    int				i;    			/* argc iterator */
+    const char			*workloadName = NULL;
+    const WORKLOAD		*workload = NULL;
+    unsigned long		count = 0;
+    unsigned long		seconds = 0;
+    int				hmacSession = FALSE;
+    int				csv = FALSE;
+    size_t			w;
+    TPMBENCH_STATE		state;
+    SAMPLES			samples;
+    uint64_t			elapsed = 0;
+
+    setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
+    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "1");
+    tssUtilsVerbose = FALSE;
+
+    state.tssContext = NULL;
+    state.algPublic = TPM_ALG_RSA;
+    state.saltAlg = TPM_ALG_NULL;
+    state.parentPassword = NULL;
+    state.sessionHandle = TPM_RS_PW;
+    state.sessionAttributes = 0;
+    state.keyHandle = TPM_RH_NULL;
+    state.parentHandle = TPM_RH_NULL;
+    state.nvIndex = TPMBENCH_NV_INDEX_DEFAULT;
+    state.nvDefined = FALSE;
+    samples.total = NULL;
+    samples.tpm = NULL;
+    samples.tss = NULL;
+    samples.count = 0;
+    samples.capacity = 0;
+
+    for (i=1 ; (i<argc) && (rc == 0) ; i++) {
+	if (strcmp(argv[i],"-w") == 0) {
+	    i++;
+	    if (i < argc) {
+		workloadName = argv[i];
+	    }
+	    else {
+		printf("-w option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-n") == 0) {
+	    i++;
+	    if (i < argc) {
+		count = strtoul(argv[i], NULL, 0);
+	    }
+	    else {
+		printf("-n option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-t") == 0) {
+	    i++;
+	    if (i < argc) {
+		seconds = strtoul(argv[i], NULL, 0);
+	    }
+	    else {
+		printf("-t option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-ecc") == 0) {
+	    state.algPublic = TPM_ALG_ECC;
+	}
+	else if (strcmp(argv[i],"-salt") == 0) {
+	    i++;
+	    if (i < argc) {
+		if (strcmp(argv[i],"none") == 0) {
+		    state.saltAlg = TPM_ALG_NULL;
+		}
+		else if (strcmp(argv[i],"rsa") == 0) {
+		    state.saltAlg = TPM_ALG_RSA;
+		}
+		else if (strcmp(argv[i],"ecc") == 0) {
+		    state.saltAlg = TPM_ALG_ECC;
+		}
+		else {
+		    printf("Bad parameter %s for -salt\n", argv[i]);
+		    printUsage();
+		}
+	    }
+	    else {
+		printf("-salt option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-se") == 0) {
+	    hmacSession = TRUE;
+	}
+	else if (strcmp(argv[i],"-ha") == 0) {
+	    i++;
+	    if (i < argc) {
+		sscanf(argv[i],"%x", &state.nvIndex);
+	    }
+	    else {
+		printf("Missing parameter for -ha\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-pwdp") == 0) {
+	    i++;
+	    if (i < argc) {
+		state.parentPassword = argv[i];
+	    }
+	    else {
+		printf("-pwdp option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-csv") == 0) {
+	    csv = TRUE;
+	}
+	else if (strcmp(argv[i],"-h") == 0) {
+	    printUsage();
+	}
+	else if (strcmp(argv[i],"-v") == 0) {
+	    tssUtilsVerbose = TRUE;
+	    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "2");
+	}
+	else {
+	    printf("\n%s is not a valid option\n", argv[i]);
+	    printUsage();
+	}
+    }
+    if (workloadName == NULL) {
+	printf("Missing workload parameter -w\n");
+	printUsage();
+    }
+    for (w = 0 ; w < sizeof(workloadTable) / sizeof(WORKLOAD) ; w++) {
+	if (strcmp(workloadName, workloadTable[w].name) == 0) {
+	    workload = &workloadTable[w];
+	    break;
+	}
+    }
+    if (workload == NULL) {
+	printf("Bad parameter %s for -w\n", workloadName);
+	printUsage();
+    }
+    if ((count != 0) && (seconds != 0)) {
+	printf("-n and -t cannot both be specified\n");
+	printUsage();
+    }
+    if ((count == 0) && (seconds == 0)) {
+	count = TPMBENCH_COUNT_DEFAULT;
+    }
+    /* Start a TSS context */
+    if (rc == 0) {
+	rc = TSS_Create(&state.tssContext);
+    }
+    /* the workload commands optionally use an HMAC session rather than a password */
+    if ((rc == 0) && hmacSession) {
+	rc = startSession(&state, &state.sessionHandle, TPM_RH_NULL);
+	if (rc == 0) {
+	    state.sessionAttributes = TPMA_SESSION_CONTINUESESSION;
+	}
+    }
+    if ((rc == 0) && (workload->setup != NULL)) {
+	rc = workload->setup(&state);
+    }
+    if (rc == 0) {
+	rc = runWorkload(&samples, &elapsed, &state, workload, count, seconds);
+    }
+    /* teardown even after a failure, to flush objects and undefine the NV index */
+    if (state.tssContext != NULL) {
+	rc1 = teardown(&state);
+	if (rc == 0) {
+	    rc = rc1;
+	}
+	rc1 = TSS_Delete(state.tssContext);
+	if (rc == 0) {
+	    rc = rc1;
+	}
+    }
+    if (rc == 0) {
+	printReport(&samples, elapsed, workload->name, csv);
+    }
+    freeSamples(&samples);
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("tpmbench: success\n");
+    }
+    else {
+	const char *msg;
+	const char *submsg;
+	const char *num;
+	printf("tpmbench: failed, rc %08x\n", rc);
+	TSS_ResponseCode_toString(&msg, &submsg, &num, rc);
+	printf("%s%s%s\n", msg, submsg, num);
+	rc = EXIT_FAILURE;
+    }
+    return rc;
+}
+
+/* nanoseconds() returns a monotonic time in nanoseconds */
+
+static uint64_t nanoseconds(void)
+{
+#ifdef TPM_POSIX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+#endif
+#ifdef TPM_WINDOWS
+    LARGE_INTEGER count;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)count.QuadPart * 1e9 / (double)frequency.QuadPart);
+#endif
+}
+
+/* runWorkload() runs count operations, or operations for the duration seconds, and records the
+   total and TPM time of each */
+
+static TPM_RC runWorkload(SAMPLES *samples,
+			  uint64_t *elapsed,
+			  TPMBENCH_STATE *state,
+			  const WORKLOAD *workload,
+			  unsigned long count,
+			  unsigned long seconds)
+{
+    TPM_RC		rc = 0;
+    uint64_t		duration = (uint64_t)seconds * 1000000000;
+    uint64_t		start;
+    uint64_t		opStart;
+    uint64_t		opEnd = 0;
+    uint64_t		tpmStart;
+    uint64_t		tpmEnd;
+    unsigned long	ops;
+
+    start = nanoseconds();
+    for (ops = 0 ; rc == 0 ; ops++) {
+	if ((count != 0) && (ops >= count)) {
+	    break;
+	}
+	if ((count == 0) && (ops != 0) && ((opEnd - start) >= duration)) {
+	    break;
+	}
+	if (rc == 0) {
+	    rc = TSS_GetTransmitTime(state->tssContext, &tpmStart);
+	}
+	if (rc == 0) {
+	    opStart = nanoseconds();
+	    rc = workload->run(state);
+	    opEnd = nanoseconds();
+	}
+	if (rc == 0) {
+	    rc = TSS_GetTransmitTime(state->tssContext, &tpmEnd);
+	}
+	if (rc == 0) {
+	    rc = addSample(samples, opEnd - opStart, tpmEnd - tpmStart);
+	}
+    }
+    *elapsed = opEnd - start;
+    return rc;
+}
+
+/* addSample() appends one operation's latencies, growing the arrays as needed */
+
+static TPM_RC addSample(SAMPLES *samples,
+			uint64_t total,
+			uint64_t tpm)
+{
+    TPM_RC		rc = 0;
+
+    if (samples->count == samples->capacity) {
+	size_t capacity = (samples->capacity == 0) ? 1024 : (samples->capacity * 2);
+	uint64_t *tmpTotal;
+	uint64_t *tmpTpm;
+	uint64_t *tmpTss;
+	/* not TSS_Realloc(), which has a 64k limit, freed @1 */
+	tmpTotal = realloc(samples->total, capacity * sizeof(uint64_t));
+	if (tmpTotal != NULL) {
+	    samples->total = tmpTotal;
+	}
+	tmpTpm = realloc(samples->tpm, capacity * sizeof(uint64_t));
+	if (tmpTpm != NULL) {
+	    samples->tpm = tmpTpm;
+	}
+	tmpTss = realloc(samples->tss, capacity * sizeof(uint64_t));
+	if (tmpTss != NULL) {
+	    samples->tss = tmpTss;
+	}
+	if ((tmpTotal == NULL) || (tmpTpm == NULL) || (tmpTss == NULL)) {
+	    printf("addSample: Error allocating %lu samples\n", (unsigned long)capacity);
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+	else {
+	    samples->capacity = capacity;
+	}
+    }
+    if (rc == 0) {
+	samples->total[samples->count] = total;
+	samples->tpm[samples->count] = tpm;
+	/* the transport time cannot exceed the operation time, but guard against clock skew */
+	samples->tss[samples->count] = (total > tpm) ? (total - tpm) : 0;
+	samples->count++;
+    }
+    return rc;
+}
+
+static void freeSamples(SAMPLES *samples)
+{
+    free(samples->total);	/* @1 */
+    free(samples->tpm);		/* @1 */
+    free(samples->tss);		/* @1 */
+    return;
+}
+
+static int compareUint64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* percentileMsec() returns the nearest rank percentile of the sorted samples in milliseconds */
+
+static double percentileMsec(uint64_t *sorted, size_t count, unsigned int percentile)
+{
+    size_t rank = ((count * percentile) + 99) / 100;	/* ceiling */
+    if (rank == 0) {
+	rank = 1;
+    }
+    return (double)sorted[rank - 1] / 1e6;
+}
+
+static void printReport(SAMPLES *samples,
+			uint64_t elapsed,
+			const char *workloadName,
+			int csv)
+{
+    static const char	*rowName[3] = {"total", "tpm", "tss"};
+    uint64_t		*row[3];
+    double		seconds = (double)elapsed / 1e9;
+    double		opsPerSec = (elapsed > 0) ? (samples->count / seconds) : 0;
+    size_t		r;
+
+    if (samples->count == 0) {
+	printf("tpmbench: no operations\n");
+	return;
+    }
+    row[0] = samples->total;
+    row[1] = samples->tpm;
+    row[2] = samples->tss;
+    for (r = 0 ; r < 3 ; r++) {
+	qsort(row[r], samples->count, sizeof(uint64_t), compareUint64);
+    }
+    if (csv) {
+	printf("workload,operations,seconds,ops_per_sec,"
+	       "total_p50_ms,total_p95_ms,total_p99_ms,total_max_ms,"
+	       "tpm_p50_ms,tpm_p95_ms,tpm_p99_ms,tpm_max_ms,"
+	       "tss_p50_ms,tss_p95_ms,tss_p99_ms,tss_max_ms\n");
+	printf("%s,%lu,%.3f,%.2f", workloadName, (unsigned long)samples->count,
+	       seconds, opsPerSec);
+	for (r = 0 ; r < 3 ; r++) {
+	    printf(",%.3f,%.3f,%.3f,%.3f",
+		   percentileMsec(row[r], samples->count, 50),
+		   percentileMsec(row[r], samples->count, 95),
+		   percentileMsec(row[r], samples->count, 99),
+		   percentileMsec(row[r], samples->count, 100));
+	}
+	printf("\n");
+    }
+    else {
+	printf("workload %s: %lu operations in %.3f sec, %.2f ops/sec\n",
+	       workloadName, (unsigned long)samples->count, seconds, opsPerSec);
+	printf("latency msec\t     p50\t     p95\t     p99\t     max\n");
+	for (r = 0 ; r < 3 ; r++) {
+	    printf("%s\t\t%8.3f\t%8.3f\t%8.3f\t%8.3f\n", rowName[r],
+		   percentileMsec(row[r], samples->count, 50),
+		   percentileMsec(row[r], samples->count, 95),
+		   percentileMsec(row[r], samples->count, 99),
+		   percentileMsec(row[r], samples->count, 100));
+	}
+    }
+    return;
+}
+
+/*
+  TPM helpers
+*/
+
+/* createPrimary() creates a primary key in the owner hierarchy with empty authorization */
+
+static TPM_RC createPrimary(TPMBENCH_STATE *state,
+			    TPMI_DH_OBJECT *objectHandle,
+			    int keyType,
+			    TPMI_ALG_PUBLIC algPublic)
+{
+    TPM_RC			rc = 0;
+    CreatePrimary_In 		in;
+    CreatePrimary_Out 		out;
+    TPMA_OBJECT			addObjectAttributes;
+    TPMA_OBJECT			deleteObjectAttributes;
+
+    addObjectAttributes.val = TPMA_OBJECT_NODA | TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT;
+    deleteObjectAttributes.val = 0;
+    in.primaryHandle = TPM_RH_OWNER;
+    in.inSensitive.sensitive.userAuth.t.size = 0;
+    in.inSensitive.sensitive.data.t.size = 0;
+    if (rc == 0) {
+	if (keyType == TYPE_KH) {
+	    rc = keyedHashPublicTemplate(&in.inPublic.publicArea,
+					 addObjectAttributes, deleteObjectAttributes,
+					 keyType, TPM_ALG_SHA256, TPM_ALG_SHA256,
+					 NULL);
+	}
+	else {
+	    rc = asymPublicTemplate(&in.inPublic.publicArea,
+				    addObjectAttributes, deleteObjectAttributes,
+				    keyType, algPublic, 2048, TPM_ECC_NIST_P256,
+				    TPM_ALG_SHA256, TPM_ALG_SHA256,
+				    NULL);
+	}
+    }
+    if (rc == 0) {
+	in.inPublic.publicArea.unique.rsa.t.size = 0;
+	in.outsideInfo.t.size = 0;
+	in.creationPCR.count = 0;
+	rc = TSS_Execute(state->tssContext,
+			 (RESPONSE_PARAMETERS *)&out,
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_CreatePrimary,
+			 TPM_RS_PW, state->parentPassword, 0,
+			 TPM_RH_NULL, NULL, 0);
+    }
+    if (rc == 0) {
+	*objectHandle = out.objectHandle;
+    }
+    return rc;
+}
+
+/* flushContext() flushes the handle if it is not TPM_RH_NULL and sets it to TPM_RH_NULL */
+
+static TPM_RC flushContext(TPMBENCH_STATE *state,
+			   TPMI_DH_CONTEXT *flushHandle)
+{
+    TPM_RC			rc = 0;
+    FlushContext_In 		in;
+
+    if (*flushHandle != TPM_RH_NULL) {
+	in.flushHandle = *flushHandle;
+	rc = TSS_Execute(state->tssContext,
+			 NULL, 
+			 (COMMAND_PARAMETERS *)&in,
+			 NULL,
+			 TPM_CC_FlushContext,
+			 TPM_RH_NULL, NULL, 0);
+	*flushHandle = TPM_RH_NULL;
+    }
+    return rc;
+}
+
+/* startSession() starts an unbound HMAC session with AES-128 CFB and SHA-256.  tpmKey is the salt
+   key or TPM_RH_NULL. */
+
+static TPM_RC startSession(TPMBENCH_STATE *state,
+			   TPMI_SH_AUTH_SESSION *sessionHandle,
+			   TPMI_DH_OBJECT tpmKey)
+{
+    TPM_RC			rc = 0;
+    StartAuthSession_In 	in;
+    StartAuthSession_Out 	out;
+    StartAuthSession_Extra	extra;
+
+    in.tpmKey = tpmKey;
+    in.bind = TPM_RH_NULL;
+    in.sessionType = TPM_SE_HMAC;
+    in.symmetric.algorithm = TPM_ALG_AES;
+    in.symmetric.keyBits.aes = 128;
+    in.symmetric.mode.aes = TPM_ALG_CFB;
+    in.authHash = TPM_ALG_SHA256;
+    extra.bindPassword = NULL;
+    rc = TSS_Execute(state->tssContext,
+		     (RESPONSE_PARAMETERS *)&out,
+		     (COMMAND_PARAMETERS *)&in,
+		     (EXTRA_PARAMETERS *)&extra,
+		     TPM_CC_StartAuthSession,
+		     TPM_RH_NULL, NULL, 0);
+    if (rc == 0) {
+	*sessionHandle = out.sessionHandle;
+    }
+    return rc;
+}
+
+/* teardown() flushes the workload objects and the HMAC session and undefines the NV index.  It
+   continues after an error. */
+
+static TPM_RC teardown(TPMBENCH_STATE *state)
+{
+    TPM_RC			rc = 0;
+    TPM_RC			rc1;
+
+    rc1 = flushContext(state, &state->keyHandle);
+    if (rc == 0) {
+	rc = rc1;
+    }
+    rc1 = flushContext(state, &state->parentHandle);
+    if (rc == 0) {
+	rc = rc1;
+    }
+    if (state->sessionHandle != TPM_RS_PW) {
+	rc1 = flushContext(state, &state->sessionHandle);
+	state->sessionHandle = TPM_RS_PW;
+	if (rc == 0) {
+	    rc = rc1;
+	}
+    }
+    if (state->nvDefined) {
+	NV_UndefineSpace_In in;
+	in.authHandle = TPM_RH_OWNER;
+	in.nvIndex = state->nvIndex;
+	rc1 = TSS_Execute(state->tssContext,
+			  NULL,
+			  (COMMAND_PARAMETERS *)&in,
+			  NULL,
+			  TPM_CC_NV_UndefineSpace,
+			  TPM_RS_PW, state->parentPassword, 0,
+			  TPM_RH_NULL, NULL, 0);
+	state->nvDefined = FALSE;
+	if (rc == 0) {
+	    rc = rc1;
+	}
+    }
+    return rc;
+}
+
+/*
+  Workloads
+*/
+
+static TPM_RC signSetup(TPMBENCH_STATE *state)
+{
+    return createPrimary(state, &state->keyHandle, TYPE_SI, state->algPublic);
+}
+
+static TPM_RC signRun(TPMBENCH_STATE *state)
+{
+    Sign_In 			in;
+    Sign_Out 			out;
+
+    in.keyHandle = state->keyHandle;
+    in.digest.t.size = SHA256_DIGEST_SIZE;
+    memset(in.digest.t.buffer, 0x5a, SHA256_DIGEST_SIZE);
+    if (state->algPublic == TPM_ALG_RSA) {
+	in.inScheme.scheme = TPM_ALG_RSASSA;
+	in.inScheme.details.rsassa.hashAlg = TPM_ALG_SHA256;
+    }
+    else {
+	in.inScheme.scheme = TPM_ALG_ECDSA;
+	in.inScheme.details.ecdsa.hashAlg = TPM_ALG_SHA256;
+    }
+    in.validation.tag = TPM_ST_HASHCHECK;
+    in.validation.hierarchy = TPM_RH_NULL;
+    in.validation.digest.t.size = 0;
+    return TSS_Execute(state->tssContext,
+		       (RESPONSE_PARAMETERS *)&out,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_Sign,
+		       state->sessionHandle, NULL, state->sessionAttributes,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+static TPM_RC quoteSetup(TPMBENCH_STATE *state)
+{
+    return createPrimary(state, &state->keyHandle, TYPE_SIR, state->algPublic);
+}
+
+static TPM_RC quoteRun(TPMBENCH_STATE *state)
+{
+    Quote_In 			in;
+    Quote_Out 			out;
+
+    in.signHandle = state->keyHandle;
+    in.qualifyingData.t.size = SHA256_DIGEST_SIZE;
+    memset(in.qualifyingData.t.buffer, 0xa5, SHA256_DIGEST_SIZE);
+    in.inScheme.scheme = TPM_ALG_NULL;		/* the key scheme */
+    in.PCRselect.count = 1;
+    in.PCRselect.pcrSelections[0].hash = TPM_ALG_SHA256;
+    in.PCRselect.pcrSelections[0].sizeofSelect = 3;
+    in.PCRselect.pcrSelections[0].pcrSelect[0] = 0;
+    in.PCRselect.pcrSelections[0].pcrSelect[1] = 0;
+    in.PCRselect.pcrSelections[0].pcrSelect[2] = 0;
+    in.PCRselect.pcrSelections[0].pcrSelect[TPMBENCH_PCR / 8] = 1 << (TPMBENCH_PCR % 8);
+    return TSS_Execute(state->tssContext,
+		       (RESPONSE_PARAMETERS *)&out,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_Quote,
+		       state->sessionHandle, NULL, state->sessionAttributes,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+static TPM_RC hmacSetup(TPMBENCH_STATE *state)
+{
+    return createPrimary(state, &state->keyHandle, TYPE_KH, TPM_ALG_KEYEDHASH);
+}
+
+static TPM_RC hmacRun(TPMBENCH_STATE *state)
+{
+    HMAC_In 			in;
+    HMAC_Out 			out;
+
+    in.handle = state->keyHandle;
+    in.buffer.t.size = SHA256_DIGEST_SIZE;
+    memset(in.buffer.t.buffer, 0x5a, SHA256_DIGEST_SIZE);
+    in.hashAlg = TPM_ALG_SHA256;
+    return TSS_Execute(state->tssContext,
+		       (RESPONSE_PARAMETERS *)&out,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_HMAC,
+		       state->sessionHandle, NULL, state->sessionAttributes,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+/* unsealSetup() creates and loads a sealed data object under a primary storage key */
+
+static TPM_RC unsealSetup(TPMBENCH_STATE *state)
+{
+    TPM_RC			rc = 0;
+    Create_In 			createIn;
+    Create_Out 			createOut;
+    Load_In 			loadIn;
+    Load_Out 			loadOut;
+    TPMA_OBJECT			addObjectAttributes;
+    TPMA_OBJECT			deleteObjectAttributes;
+
+    if (rc == 0) {
+	rc = createPrimary(state, &state->parentHandle, TYPE_ST, state->algPublic);
+    }
+    if (rc == 0) {
+	addObjectAttributes.val = TPMA_OBJECT_NODA | TPMA_OBJECT_FIXEDTPM |
+				  TPMA_OBJECT_FIXEDPARENT;
+	deleteObjectAttributes.val = 0;
+	rc = blPublicTemplate(&createIn.inPublic.publicArea,
+			      addObjectAttributes, deleteObjectAttributes,
+			      TPM_ALG_SHA256,
+			      NULL);
+    }
+    if (rc == 0) {
+	createIn.parentHandle = state->parentHandle;
+	createIn.inSensitive.sensitive.userAuth.t.size = 0;
+	createIn.inSensitive.sensitive.data.t.size = TPMBENCH_NV_SIZE;
+	memset(createIn.inSensitive.sensitive.data.t.buffer, 0x5a, TPMBENCH_NV_SIZE);
+	createIn.outsideInfo.t.size = 0;
+	createIn.creationPCR.count = 0;
+	rc = TSS_Execute(state->tssContext,
+			 (RESPONSE_PARAMETERS *)&createOut,
+			 (COMMAND_PARAMETERS *)&createIn,
+			 NULL,
+			 TPM_CC_Create,
+			 TPM_RS_PW, NULL, 0,
+			 TPM_RH_NULL, NULL, 0);
+    }
+    if (rc == 0) {
+	loadIn.parentHandle = state->parentHandle;
+	loadIn.inPrivate = createOut.outPrivate;
+	loadIn.inPublic = createOut.outPublic;
+	rc = TSS_Execute(state->tssContext,
+			 (RESPONSE_PARAMETERS *)&loadOut,
+			 (COMMAND_PARAMETERS *)&loadIn,
+			 NULL,
+			 TPM_CC_Load,
+			 TPM_RS_PW, NULL, 0,
+			 TPM_RH_NULL, NULL, 0);
+    }
+    if (rc == 0) {
+	state->keyHandle = loadOut.objectHandle;
+    }
+    return rc;
+}
+
+static TPM_RC unsealRun(TPMBENCH_STATE *state)
+{
+    Unseal_In 			in;
+    Unseal_Out 			out;
+
+    in.itemHandle = state->keyHandle;
+    return TSS_Execute(state->tssContext,
+		       (RESPONSE_PARAMETERS *)&out,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_Unseal,
+		       state->sessionHandle, NULL, state->sessionAttributes,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+static TPM_RC pcrExtendRun(TPMBENCH_STATE *state)
+{
+    PCR_Extend_In 		in;
+
+    in.pcrHandle = TPMBENCH_PCR;
+    in.digests.count = 1;
+    in.digests.digests[0].hashAlg = TPM_ALG_SHA256;
+    memset((uint8_t *)&in.digests.digests[0].digest, 0x5a, SHA256_DIGEST_SIZE);
+    return TSS_Execute(state->tssContext,
+		       NULL,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_PCR_Extend,
+		       state->sessionHandle, NULL, state->sessionAttributes,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+/* nvSetup() defines an ordinary index with empty authorization */
+
+static TPM_RC nvSetup(TPMBENCH_STATE *state)
+{
+    TPM_RC			rc = 0;
+    NV_DefineSpace_In 		in;
+
+    in.authHandle = TPM_RH_OWNER;
+    in.auth.t.size = 0;
+    in.publicInfo.nvPublic.nvIndex = state->nvIndex;
+    in.publicInfo.nvPublic.nameAlg = TPM_ALG_SHA256;
+    in.publicInfo.nvPublic.attributes.val = TPMA_NVA_ORDINARY | TPMA_NVA_NO_DA |
+					    TPMA_NVA_AUTHREAD | TPMA_NVA_AUTHWRITE;
+    in.publicInfo.nvPublic.authPolicy.t.size = 0;
+    in.publicInfo.nvPublic.dataSize = TPMBENCH_NV_SIZE;
+    rc = TSS_Execute(state->tssContext,
+		     NULL,
+		     (COMMAND_PARAMETERS *)&in,
+		     NULL,
+		     TPM_CC_NV_DefineSpace,
+		     TPM_RS_PW, state->parentPassword, 0,
+		     TPM_RH_NULL, NULL, 0);
+    if (rc == 0) {
+	state->nvDefined = TRUE;
+    }
+    return rc;
+}
+
+/* nvReadSetup() defines and writes the index, since an unwritten index cannot be read */
+
+static TPM_RC nvReadSetup(TPMBENCH_STATE *state)
+{
+    TPM_RC			rc = 0;
+
+    if (rc == 0) {
+	rc = nvSetup(state);
+    }
+    if (rc == 0) {
+	rc = nvWriteRun(state);
+    }
+    return rc;
+}
+
+static TPM_RC nvReadRun(TPMBENCH_STATE *state)
+{
+    NV_Read_In 			in;
+    NV_Read_Out 		out;
+
+    in.authHandle = state->nvIndex;
+    in.nvIndex = state->nvIndex;
+    in.size = TPMBENCH_NV_SIZE;
+    in.offset = 0;
+    return TSS_Execute(state->tssContext,
+		       (RESPONSE_PARAMETERS *)&out,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_NV_Read,
+		       state->sessionHandle, NULL, state->sessionAttributes,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+static TPM_RC nvWriteRun(TPMBENCH_STATE *state)
+{
+    NV_Write_In 		in;
+
+    in.authHandle = state->nvIndex;
+    in.nvIndex = state->nvIndex;
+    in.data.t.size = TPMBENCH_NV_SIZE;
+    memset(in.data.t.buffer, 0x5a, TPMBENCH_NV_SIZE);
+    in.offset = 0;
+    return TSS_Execute(state->tssContext,
+		       NULL,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_NV_Write,
+		       state->sessionHandle, NULL, state->sessionAttributes,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+/* startAuthSessionSetup() creates the primary storage key used as the salt key */
+
+static TPM_RC startAuthSessionSetup(TPMBENCH_STATE *state)
+{
+    TPM_RC			rc = 0;
+
+    if (state->saltAlg != TPM_ALG_NULL) {
+	rc = createPrimary(state, &state->keyHandle, TYPE_ST, state->saltAlg);
+    }
+    return rc;
+}
+
+static TPM_RC startAuthSessionRun(TPMBENCH_STATE *state)
+{
+    TPM_RC			rc = 0;
+    TPMI_SH_AUTH_SESSION	sessionHandle = TPM_RH_NULL;
+
+    if (rc == 0) {
+	rc = startSession(state, &sessionHandle, state->keyHandle);
+    }
+    if (rc == 0) {
+	rc = flushContext(state, &sessionHandle);
+    }
+    return rc;
+}
+
+static TPM_RC createPrimaryRun(TPMBENCH_STATE *state)
+{
+    TPM_RC			rc = 0;
+    TPMI_DH_OBJECT		objectHandle = TPM_RH_NULL;
+
+    if (rc == 0) {
+	rc = createPrimary(state, &objectHandle, TYPE_ST, state->algPublic);
+    }
+    if (rc == 0) {
+	rc = flushContext(state, &objectHandle);
+    }
+    return rc;
+}
+
+static void printUsage(void)
+{
+    printf("\n");
+    printf("tpmbench\n");
+    printf("\n");
+    printf("Measures TPM command throughput and latency percentiles, split into TPM and TSS time\n");
+    printf("\n");
+    printf("\t-w\tworkload\n");
+    printf("\t\tsign, quote, hmac, unseal, pcrextend, nvread, nvwrite,\n");
+    printf("\t\tstartauthsession, createprimary\n");
+    printf("\t[-n\tnumber of operations (default %u)]\n", TPMBENCH_COUNT_DEFAULT);
+    printf("\t[-t\tduration in seconds, instead of -n]\n");
+    printf("\t[-ecc\tECC NIST P256 keys (default RSA 2048)]\n");
+    printf("\t[-salt\tstartauthsession salt key (none, rsa, ecc) (default none)]\n");
+    printf("\t[-se\tauthorize with an HMAC session (default password)]\n");
+    printf("\t[-ha\tNV index for nvread and nvwrite (default %08x)]\n",
+	   TPMBENCH_NV_INDEX_DEFAULT);
+    printf("\t[-pwdp\towner hierarchy password (default empty)]\n");
+    printf("\t[-csv\tCSV output]\n");
+    printf("\t[-v\tverbose]\n");
+    printf("\n");
+    exit(1);	
+}
@@ -60,6 +60,9 @@
 #include <ibmtss/tsscryptoh.h>
 #endif
 #include <ibmtss/tssprintcmd.h>
+#ifndef TPM_TSS_NOFILE
+#include <ibmtss/tssfile.h>
+#endif
 #ifdef TPM_TPM20
 #include "tss20.h"
 #endif
@@ -70,6 +73,13 @@
 /* local prototypes */
 
 static TPM_RC TSS_Context_Init(TSS_CONTEXT *tssContext);
+#ifdef TPM_TPM20
+static TPM_RC TSS_QueryBufferSize(TSS_CONTEXT *tssContext);
+#endif
+#ifdef TPM_TSS_NOFILE
+static size_t TSS_HandleTable_Hash(TPM_HANDLE handle);
+static TPM_RC TSS_HandleTable_Grow(TSS_HANDLE_TABLE *table);
+#endif
 
 extern int tssVerbose;
 extern int tssVverbose;
@@ -161,17 +171,17 @@ TPM_RC TSS_Delete(TSS_CONTEXT *tssContext)
 #ifdef TPM_TSS_NOFILE
 	{
 	    size_t i;
-	    for (i = 0 ; i < (sizeof(tssContext->sessions) / sizeof(TSS_SESSIONS)) ; i++) {
-		tssContext->sessions[i].sessionHandle = TPM_RH_NULL;
+	    for (i = 0 ; i < tssContext->sessions.size ; i++) {
+		TSS_SESSIONS *session = tssContext->sessions.slots[i];
 		/* erase any secrets */
-		if (tssContext->sessions[i].sessionData != NULL) {
-		    memset(tssContext->sessions[i].sessionData,
-			   0, tssContext->sessions[i].sessionDataLength);
+		if ((session != NULL) && (session->sessionData != NULL)) {
+		    memset(session->sessionData, 0, session->sessionDataLength);
+		    free(session->sessionData);
 		}
-		free(tssContext->sessions[i].sessionData);
-		tssContext->sessions[i].sessionData = NULL;
-		tssContext->sessions[i].sessionDataLength = 0;
 	    }
+	    TSS_HandleTable_Delete(&tssContext->sessions);
+	    TSS_HandleTable_Delete(&tssContext->objectPublic);
+	    TSS_HandleTable_Delete(&tssContext->nvPublic);
 	}
 #endif	/* TPM_TSS_NOFILE */
 #ifndef TPM_TSS_NOFILE
@@ -179,6 +189,14 @@ TPM_RC TSS_Delete(TSS_CONTEXT *tssContext)
 	TSS_AES_KeyFree(tssContext->tssSessionEncKey,
 			tssContext->tssSessionDecKey);
 #endif
+#endif
+#ifndef TPM_TSS_NOFILE
+	/* a per process session directory is empty once its sessions and objects are flushed */
+	if ((tssContext->tssSessionDirectory != NULL) &&
+	    (strcmp(tssContext->tssSessionDirectory, "pid") == 0) &&
+	    (tssContext->tssSessionPath[0] != '\0')) {
+	    TSS_File_RemoveDirectory(tssContext->tssSessionPath);
+	}
 #endif
 	rc = TSS_Close(tssContext);
 	free(tssContext);
@@ -231,6 +249,10 @@ TPM_RC TSS_Execute(TSS_CONTEXT *tssContext,
 	    rc = TSS_RC_FAIL;
 	}
     }
+    /* size the command and response buffers, a TPM 2.0 command may first read the TPM maximums */
+    if (rc == 0) {
+	rc = TSS_AuthSizeBuffers(tssContext, tpm20Command);
+    }
     if (rc == 0) {
 	va_start(ap, commandCode);
 	if (tpm20Command) {
@@ -266,4 +288,295 @@ TPM_RC TSS_Execute(TSS_CONTEXT *tssContext,
     return rc;
 }
 
+/* TSS_GetBufferSize() returns the command and response buffer sizes and the NV read and write
+   chunk size.
+
+   The TPM_MAX_COMMAND_SIZE and TPM_MAX_RESPONSE_SIZE properties fix the sizes.  If a property is
+   0, the default, the first TPM 2.0 command on a connection reads TPM_PT_MAX_COMMAND_SIZE and
+   TPM_PT_MAX_RESPONSE_SIZE.  The sizes are never smaller than the compiled in MAX_COMMAND_SIZE
+   and MAX_RESPONSE_SIZE.
+
+   nvBufferMax is TPM_PT_NV_BUFFER_MAX, read with the sizes and limited by MAX_NV_BUFFER_SIZE, or 0
+   if the TPM was not read.
+*/
+
+TPM_RC TSS_GetBufferSize(TSS_CONTEXT *tssContext,
+			 uint32_t *commandBufferSize,
+			 uint32_t *responseBufferSize,
+			 uint32_t *nvBufferMax)
+{
+    TPM_RC		rc = 0;
+
+    if (!tssContext->tssBufferSizeValid) {
+	/* set first, the query is itself a command */
+	tssContext->tssBufferSizeValid = TRUE;
+#ifdef TPM_TPM20
+	if ((tssContext->tssMaxCommandSize == 0) || (tssContext->tssMaxResponseSize == 0)) {
+	    rc = TSS_QueryBufferSize(tssContext);
+	}
+#endif
+    }
+    if (rc == 0) {
+	*commandBufferSize = tssContext->tssCommandBufferSize;
+	*responseBufferSize = tssContext->tssResponseBufferSize;
+	*nvBufferMax = tssContext->tssNvBufferMax;
+    }
+    return rc;
+}
+
+#ifdef TPM_TPM20
+
+/* TSS_QueryBufferSize() reads TPM_PT_MAX_COMMAND_SIZE through TPM_PT_NV_BUFFER_MAX from the TPM
+   with one TPM2_GetCapability.
+
+   If the TPM returns an error, the current sizes are kept.  A TPM that is not started is read
+   again at the next command.  A connection error is returned.
+*/
+
+static TPM_RC TSS_QueryBufferSize(TSS_CONTEXT *tssContext)
+{
+    TPM_RC		rc = 0;
+    GetCapability_In 	in;
+    GetCapability_Out	out;
+    uint32_t		i;
+
+    in.capability = TPM_CAP_TPM_PROPERTIES;
+    in.property = TPM_PT_MAX_COMMAND_SIZE;
+    in.propertyCount = TPM_PT_NV_BUFFER_MAX - TPM_PT_MAX_COMMAND_SIZE + 1;
+    rc = TSS_Execute(tssContext,
+		     (RESPONSE_PARAMETERS *)&out,
+		     (COMMAND_PARAMETERS *)&in,
+		     NULL,
+		     TPM_CC_GetCapability,
+		     TPM_RH_NULL, NULL, 0);
+    if (rc == 0) {
+	for (i = 0 ; i < out.capabilityData.data.tpmProperties.count ; i++) {
+	    TPMS_TAGGED_PROPERTY *tpmProperty =
+		&out.capabilityData.data.tpmProperties.tpmProperty[i];
+	    uint32_t value = tpmProperty->value;
+	    if (value > TPM_BUFFER_SIZE_LIMIT) {
+		value = TPM_BUFFER_SIZE_LIMIT;
+	    }
+	    switch (tpmProperty->property) {
+	      case TPM_PT_MAX_COMMAND_SIZE:
+		if ((tssContext->tssMaxCommandSize == 0) && (value > MAX_COMMAND_SIZE)) {
+		    tssContext->tssCommandBufferSize = value;
+		}
+		break;
+	      case TPM_PT_MAX_RESPONSE_SIZE:
+		if ((tssContext->tssMaxResponseSize == 0) && (value > MAX_RESPONSE_SIZE)) {
+		    tssContext->tssResponseBufferSize = value;
+		}
+		break;
+	      case TPM_PT_NV_BUFFER_MAX:
+		tssContext->tssNvBufferMax = (value < MAX_NV_BUFFER_SIZE) ?
+					     value : MAX_NV_BUFFER_SIZE;
+		break;
+	      default:
+		break;
+	    }
+	}
+    }
+    /* the command would fail the same way, so return the connection error */
+    else if ((rc == TSS_RC_NO_CONNECTION) || (rc == TSS_RC_BAD_CONNECTION)) {
+	tssContext->tssBufferSizeValid = FALSE;
+    }
+    else {
+	if (tssVverbose) printf("TSS_QueryBufferSize: TPM query failed, using current sizes\n");
+	if (rc == TPM_RC_INITIALIZE) {
+	    tssContext->tssBufferSizeValid = FALSE;
+	}
+	rc = 0;
+    }
+    if (tssVverbose) printf("TSS_QueryBufferSize: command %u response %u NV %u\n",
+			    tssContext->tssCommandBufferSize, tssContext->tssResponseBufferSize,
+			    tssContext->tssNvBufferMax);
+    return rc;
+}
+
+#endif	/* TPM_TPM20 */
+
+#ifdef TPM_TSS_NOFILE
+
+/* The handle tables hold the session, object, and NV state for a TSS with no file support.
+
+   The table is open addressed with linear probing.  Each entry is a separately allocated
+   TSS_SESSIONS, TSS_OBJECT_PUBLIC, or TSS_NVPUBLIC, whose first member is the handle.  The slot
+   array is allocated at the first TSS_HandleTable_Add() and doubles when it becomes 3/4 full, so
+   the number of entries is limited only by memory.
+*/
+
+#define TSS_HANDLE_TABLE_INITIAL	8
+
+/* TSS_HandleTable_Init() initializes an empty table */
+
+void TSS_HandleTable_Init(TSS_HANDLE_TABLE *table)
+{
+    table->slots = NULL;
+    table->size = 0;
+    table->count = 0;
+    return;
+}
+
+/* TSS_HandleTable_Hash() mixes the handle bits.  Handles of one type differ mostly in the low
+   bits, but the upper byte is the same. */
+
+static size_t TSS_HandleTable_Hash(TPM_HANDLE handle)
+{
+    uint32_t hash = handle;
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/* TSS_HandleTable_Find() returns the entry for the handle, or NULL if there is none */
+
+void *TSS_HandleTable_Find(TSS_HANDLE_TABLE *table,
+			   TPM_HANDLE handle)
+{
+    size_t 	mask;
+    size_t	i;
+
+    if (table->count == 0) {
+	return NULL;
+    }
+    mask = table->size - 1;
+    for (i = TSS_HandleTable_Hash(handle) & mask ;
+	 table->slots[i] != NULL ;
+	 i = (i + 1) & mask) {
+	if (*(TPM_HANDLE *)table->slots[i] == handle) {
+	    return table->slots[i];
+	}
+    }
+    return NULL;
+}
+
+/* TSS_HandleTable_Grow() allocates the slot array, or doubles it and rehashes the entries */
+
+static TPM_RC TSS_HandleTable_Grow(TSS_HANDLE_TABLE *table)
+{
+    TPM_RC	rc = 0;
+    void 	**slots = NULL;
+    size_t 	size;
+    size_t 	mask;
+    size_t	i;
+    size_t	j;
+
+    if (rc == 0) {
+	size = (table->size == 0) ? TSS_HANDLE_TABLE_INITIAL : table->size * 2;
+	mask = size - 1;
+	rc = TSS_Malloc((uint8_t **)&slots, (uint32_t)(size * sizeof(void *)));
+    }
+    if (rc == 0) {
+	memset(slots, 0, size * sizeof(void *));
+	for (i = 0 ; i < table->size ; i++) {
+	    if (table->slots[i] != NULL) {
+		for (j = TSS_HandleTable_Hash(*(TPM_HANDLE *)table->slots[i]) & mask ;
+		     slots[j] != NULL ;
+		     j = (j + 1) & mask) ;
+		slots[j] = table->slots[i];
+	    }
+	}
+	free(table->slots);
+	table->slots = slots;
+	table->size = size;
+    }
+    return rc;
+}
+
+/* TSS_HandleTable_Add() returns the entry for the handle.  If there is none, it adds a zeroed
+   entry of entrySize bytes with the handle set. */
+
+TPM_RC TSS_HandleTable_Add(TSS_HANDLE_TABLE *table,
+			   void **entry,
+			   TPM_HANDLE handle,
+			   uint32_t entrySize)
+{
+    TPM_RC	rc = 0;
+    size_t 	mask;
+    size_t	i;
+
+    *entry = TSS_HandleTable_Find(table, handle);
+    if (*entry != NULL) {
+	return rc;
+    }
+    /* keep the load at most 3/4 so that probe sequences stay short */
+    if ((rc == 0) && ((table->count + 1) * 4 > table->size * 3)) {
+	rc = TSS_HandleTable_Grow(table);
+    }
+    if (rc == 0) {
+	rc = TSS_Malloc((uint8_t **)entry, entrySize);
+    }
+    if (rc == 0) {
+	memset(*entry, 0, entrySize);
+	*(TPM_HANDLE *)*entry = handle;
+	mask = table->size - 1;
+	for (i = TSS_HandleTable_Hash(handle) & mask ;
+	     table->slots[i] != NULL ;
+	     i = (i + 1) & mask) ;
+	table->slots[i] = *entry;
+	table->count++;
+    }
+    return rc;
+}
+
+/* TSS_HandleTable_Remove() removes the entry for the handle from the table and returns it, or
+   returns NULL if there is none.  The caller frees the entry. */
+
+void *TSS_HandleTable_Remove(TSS_HANDLE_TABLE *table,
+			     TPM_HANDLE handle)
+{
+    void 	*entry = NULL;
+    size_t 	mask;
+    size_t	i;
+    size_t	j;
+    size_t	k;
+
+    if (table->count == 0) {
+	return NULL;
+    }
+    mask = table->size - 1;
+    for (i = TSS_HandleTable_Hash(handle) & mask ;
+	 table->slots[i] != NULL ;
+	 i = (i + 1) & mask) {
+	if (*(TPM_HANDLE *)table->slots[i] == handle) {
+	    entry = table->slots[i];
+	    break;
+	}
+    }
+    if (entry == NULL) {
+	return NULL;
+    }
+    /* close the gap, moving back any later entry in the probe run whose home slot is not
+       between the gap and its current slot */
+    table->slots[i] = NULL;
+    table->count--;
+    for (j = (i + 1) & mask ; table->slots[j] != NULL ; j = (j + 1) & mask) {
+	k = TSS_HandleTable_Hash(*(TPM_HANDLE *)table->slots[j]) & mask;
+	if (((j > i) && ((k <= i) || (k > j))) ||
+	    ((j < i) && ((k <= i) && (k > j)))) {
+	    table->slots[i] = table->slots[j];
+	    table->slots[j] = NULL;
+	    i = j;
+	}
+    }
+    return entry;
+}
+
+/* TSS_HandleTable_Delete() frees all entries and the slot array.  The caller first erases any
+   secrets held by the entries. */
+
+void TSS_HandleTable_Delete(TSS_HANDLE_TABLE *table)
+{
+    size_t	i;
 
+    for (i = 0 ; i < table->size ; i++) {
+	free(table->slots[i]);
+    }
+    free(table->slots);
+    TSS_HandleTable_Init(table);
+    return;
+}
+
+#endif	/* TPM_TSS_NOFILE */
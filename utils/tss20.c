@@ -65,6 +65,41 @@
 #include <ibmtss/tssprintcmd.h>
 #include "tss20.h"
 
+/* With TPM_TSS_CC_SUBSET, helpers that only command processors use are compiled only if one of
+   those commands is.  These group the commands by the helper they share. */
+
+/* commands whose post processor copies the name and public area between handles and files */
+#ifndef TPM_TSS_NOFILE
+#define TSS_CC_COPY		(CC_ContextSave || CC_ContextLoad || CC_EvictControl)
+#else
+#define TSS_CC_COPY		CC_EvictControl
+#endif
+/* commands whose post processor is TSS_PO_NV_Write() */
+#define TSS_CC_NV_WRITE		(CC_NV_Write || CC_NV_Increment || CC_NV_Extend || CC_NV_SetBits)
+/* commands whose post processor updates, saves, or deletes the saved NV public area */
+#ifndef TPM_TSS_NOCRYPTO
+#define TSS_CC_NV_UPDATE	(TSS_CC_NV_WRITE || CC_NV_WriteLock || CC_NV_ReadLock)
+#define TSS_CC_NV_STORE		(CC_NV_DefineSpace || CC_NV_ReadPublic || TSS_CC_NV_UPDATE)
+#define TSS_CC_NV_DELETE	(CC_NV_UndefineSpace || CC_NV_UndefineSpaceSpecial || TSS_CC_NV_UPDATE)
+#else
+#define TSS_CC_NV_UPDATE	0
+#define TSS_CC_NV_STORE		0
+#define TSS_CC_NV_DELETE	CC_NV_UndefineSpaceSpecial
+#endif
+/* commands whose post processor saves an object public area */
+#define TSS_CC_PUBLIC_STORE	(CC_Load || CC_LoadExternal || CC_ReadPublic ||		\
+				 CC_CreateLoaded || CC_CreatePrimary || TSS_CC_COPY)
+/* commands whose post processor saves a name */
+#define TSS_CC_NAME_STORE	(TSS_CC_PUBLIC_STORE || TSS_CC_NV_STORE ||		\
+				 CC_HMAC_Start || CC_HashSequenceStart)
+/* commands whose parameter check rejects a SHA-1 signing scheme */
+#define TSS_CC_CHECK_SIGSCHEME	(CC_Certify || CC_CertifyCreation || CC_CertifyX509 ||	\
+				 CC_GetCommandAuditDigest || CC_GetSessionAuditDigest || \
+				 CC_GetTime || CC_NV_Certify || CC_Quote || CC_Sign)
+/* commands whose parameter check rejects a SHA-1 public area */
+#define TSS_CC_CHECK_PUBLIC	(CC_Create || CC_CreateLoaded || CC_CreatePrimary ||	\
+				 CC_Import || CC_Load || CC_LoadExternal)
+
 /* Files:
 
    h01xxxxxx.bin - NV index name
@@ -103,10 +138,16 @@ struct TSS_HMAC_CONTEXT {
     TPM_SE			sessionType;		/* HMAC (0), policy (1), or trial policy */
     uint8_t			isPasswordNeeded;	/* flag set by policy password */
     uint8_t			isAuthValueNeeded;	/* flag set by policy authvalue */
+#ifndef TPM_TSS_NOCRYPTO
+    TPM2B_DIGEST		auditDigest;		/* running session audit digest, size 0
+							   until the first audited command */
+#endif	/* TPM_TSS_NOCRYPTO */
     /* Items below this line are for the lifetime of one command.  They are not saved and loaded. */
     TPM2B_KEY			hmacKey;		/* HMAC key calculated for each command */
 #ifndef TPM_TSS_NOCRYPTO
     TPM2B_KEY			sessionValue;		/* KDFa secret for parameter encryption */
+    uint8_t			auditAttributes;	/* command audit and auditReset attributes */
+    TPM2B_DIGEST		auditCpHash;		/* cpHash saved for the audit digest */
 #endif	/* TPM_TSS_NOCRYPTO */
 } TSS_HMAC_CONTEXT;
 
@@ -127,119 +168,175 @@ typedef TPM_RC (*TSS_PostProcessFunction_t)(TSS_CONTEXT *tssContext,
 					    RESPONSE_PARAMETERS *out,
 					    EXTRA_PARAMETERS *extra);
 
+#if CC_StartAuthSession
 static TPM_RC TSS_PR_StartAuthSession(TSS_CONTEXT *tssContext,
 				      StartAuthSession_In *in,
 				      StartAuthSession_Extra *extra);
+#endif
+#if CC_NV_DefineSpace
 static TPM_RC TSS_PR_NV_DefineSpace(TSS_CONTEXT *tssContext,
 				    NV_DefineSpace_In *in,
 				    void *extra);
+#endif
 
+#if CC_HierarchyChangeAuth
 static TPM_RC TSS_CA_HierarchyChangeAuth(TSS_CONTEXT *tssContext,
 					 struct TSS_HMAC_CONTEXT *session,
 					 size_t handleNumber,
 					 HierarchyChangeAuth_In *in);
+#endif
+#if CC_NV_UndefineSpaceSpecial
 static TPM_RC TSS_CA_NV_UndefineSpaceSpecial(TSS_CONTEXT *tssContext,
 					     struct TSS_HMAC_CONTEXT *session,
 					     size_t handleNumber,
 					     NV_UndefineSpaceSpecial_In *in);
+#endif
+#if CC_NV_ChangeAuth
 static TPM_RC TSS_CA_NV_ChangeAuth(TSS_CONTEXT *tssContext,
 				   struct TSS_HMAC_CONTEXT *session,
 				   size_t handleNumber,
 				   NV_ChangeAuth_In *in);
+#endif
 
 
+#if CC_StartAuthSession
 static TPM_RC TSS_PO_StartAuthSession(TSS_CONTEXT *tssContext,
 				      StartAuthSession_In *in,
 				      StartAuthSession_Out *out,
 				      StartAuthSession_Extra *extra);
+#endif
+#if CC_ContextSave
 static TPM_RC TSS_PO_ContextSave(TSS_CONTEXT *tssContext,
 				 ContextSave_In *in,
 				 ContextSave_Out *out,
 				 void *extra);
+#endif
+#if CC_ContextLoad
 static TPM_RC TSS_PO_ContextLoad(TSS_CONTEXT *tssContext,
 				 ContextLoad_In *in,
 				 ContextLoad_Out *out,
 				 void *extra);
+#endif
+#if CC_FlushContext
 static TPM_RC TSS_PO_FlushContext(TSS_CONTEXT *tssContext,
 				  FlushContext_In *in,
 				  void *out,
 				  void *extra);
+#endif
+#if CC_EvictControl
 static TPM_RC TSS_PO_EvictControl(TSS_CONTEXT *tssContext,
 				  EvictControl_In *in,
 				  void *out,
 				  void *extra);
+#endif
+#if CC_Load
 static TPM_RC TSS_PO_Load(TSS_CONTEXT *tssContext,
 			  Load_In *in,
 			  Load_Out *out,
 			  void *extra);
+#endif
+#if CC_LoadExternal
 static TPM_RC TSS_PO_LoadExternal(TSS_CONTEXT *tssContext,
 				  LoadExternal_In *in,
 				  LoadExternal_Out *out,
 				  void *extra);
+#endif
+#if CC_ReadPublic
 static TPM_RC TSS_PO_ReadPublic(TSS_CONTEXT *tssContext,
 				ReadPublic_In *in,
 				ReadPublic_Out *out,
 				void *extra);
+#endif
+#if CC_CreateLoaded
 static TPM_RC TSS_PO_CreateLoaded(TSS_CONTEXT *tssContext,
 				  CreateLoaded_In *in,
 				  CreateLoaded_Out *out,
 				  void *extra);
+#endif
+#if CC_HMAC_Start
 static TPM_RC TSS_PO_HMAC_Start(TSS_CONTEXT *tssContext,
 				HMAC_Start_In *in,
 				HMAC_Start_Out *out,
 				void *extra);
+#endif
+#if CC_HashSequenceStart
 static TPM_RC TSS_PO_HashSequenceStart(TSS_CONTEXT *tssContext,
 				       HashSequenceStart_In *in,
 				       HashSequenceStart_Out *out,
 				       void *extra);
+#endif
+#if CC_SequenceComplete
 static TPM_RC TSS_PO_SequenceComplete(TSS_CONTEXT *tssContext,
 				      SequenceComplete_In *in,
 				      SequenceComplete_Out *out,
 				      void *extra);
+#endif
+#if CC_EventSequenceComplete
 static TPM_RC TSS_PO_EventSequenceComplete(TSS_CONTEXT *tssContext,
 					   EventSequenceComplete_In *in,
 					   EventSequenceComplete_Out *out,
 					   void *extra);
+#endif
+#if CC_PolicyAuthValue
 static TPM_RC TSS_PO_PolicyAuthValue(TSS_CONTEXT *tssContext,
 				     PolicyAuthValue_In *in,
 				     void *out,
 				     void *extra);
+#endif
+#if CC_PolicyPassword
 static TPM_RC TSS_PO_PolicyPassword(TSS_CONTEXT *tssContext,
 				    PolicyPassword_In *in,
 				    void *out,
 				    void *extra);
+#endif
+#if CC_CreatePrimary
 static TPM_RC TSS_PO_CreatePrimary(TSS_CONTEXT *tssContext,
 				   CreatePrimary_In *in,
 				   CreatePrimary_Out *out,
 				   void *extra);
+#endif
+#if CC_NV_DefineSpace
 static TPM_RC TSS_PO_NV_DefineSpace(TSS_CONTEXT *tssContext,
 				    NV_DefineSpace_In *in,
 				    void *out,
 				    void *extra);
+#endif
+#if CC_NV_ReadPublic
 static TPM_RC TSS_PO_NV_ReadPublic(TSS_CONTEXT *tssContext,
 				   NV_ReadPublic_In *in,
 				   NV_ReadPublic_Out *out,
 				   void *extra);
+#endif
+#if CC_NV_UndefineSpace
 static TPM_RC TSS_PO_NV_UndefineSpace(TSS_CONTEXT *tssContext,
 				      NV_UndefineSpace_In *in,
 				      void *out,
 				      void *extra);
+#endif
+#if CC_NV_UndefineSpaceSpecial
 static TPM_RC TSS_PO_NV_UndefineSpaceSpecial(TSS_CONTEXT *tssContext,
 					     NV_UndefineSpaceSpecial_In *in,
 					     void *out,
 					     void *extra);
+#endif
+#if TSS_CC_NV_WRITE
 static TPM_RC TSS_PO_NV_Write(TSS_CONTEXT *tssContext,
 			      NV_Write_In *in,
 			      void *out,
 			      void *extra);
+#endif
+#if CC_NV_WriteLock
 static TPM_RC TSS_PO_NV_WriteLock(TSS_CONTEXT *tssContext,
 				  NV_WriteLock_In *in,
 				  void *out,
 				  void *extra);
+#endif
+#if CC_NV_ReadLock
 static TPM_RC TSS_PO_NV_ReadLock(TSS_CONTEXT *tssContext,
 				 NV_ReadLock_In *in,
 				 void *out,
 				 void *extra);
+#endif
 
 #ifdef TPM_TSS_NODEPRECATEDALGS
 
@@ -247,6 +344,7 @@ static TPM_RC TSS_PO_NV_ReadLock(TSS_CONTEXT *tssContext,
   Functions to check for usage of deprecated algorithms.
 */
 
+#if TSS_CC_CHECK_PUBLIC
 static TPM_RC TSS_CheckSha1_PublicArea(TPMT_PUBLIC *publicArea)
 {
     TPM_RC rc = 0;
@@ -267,7 +365,9 @@ static TPM_RC TSS_CheckSha1_PublicArea(TPMT_PUBLIC *publicArea)
 
     return rc;
 }
+#endif
 
+#if TSS_CC_CHECK_SIGSCHEME
 static TPM_RC TSS_CheckSha1_SigScheme(TPMT_SIG_SCHEME *sigScheme)
 {
     TPM_RC rc = 0;
@@ -280,7 +380,9 @@ static TPM_RC TSS_CheckSha1_SigScheme(TPMT_SIG_SCHEME *sigScheme)
 
     return rc;
 }
+#endif
 
+#if CC_StartAuthSession
 static TPM_RC TSS_CH_StartAuthSession(StartAuthSession_In *in)
 {
     TPM_RC rc = 0;
@@ -293,7 +395,9 @@ static TPM_RC TSS_CH_StartAuthSession(StartAuthSession_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_Create
 static TPM_RC TSS_CH_Create(Create_In *in)
 {
     TPM_RC rc = 0;
@@ -304,7 +408,9 @@ static TPM_RC TSS_CH_Create(Create_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_Load
 static TPM_RC TSS_CH_Load(Load_In *in)
 {
     TPM_RC rc = 0;
@@ -315,7 +421,9 @@ static TPM_RC TSS_CH_Load(Load_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_LoadExternal
 static TPM_RC TSS_CH_LoadExternal(LoadExternal_In *in)
 {
     TPM_RC rc = 0;
@@ -326,7 +434,9 @@ static TPM_RC TSS_CH_LoadExternal(LoadExternal_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_CreateLoaded
 static TPM_RC TSS_CH_CreateLoaded(CreateLoaded_In *in)
 {
     TPM_RC rc = 0;
@@ -344,7 +454,9 @@ static TPM_RC TSS_CH_CreateLoaded(CreateLoaded_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_Import
 static TPM_RC TSS_CH_Import(Import_In *in)
 {
     TPM_RC rc = 0;
@@ -355,7 +467,9 @@ static TPM_RC TSS_CH_Import(Import_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_RSA_Encrypt
 static TPM_RC TSS_CH_RSA_Encrypt(RSA_Encrypt_In *in)
 {
     TPM_RC rc = 0;
@@ -368,7 +482,9 @@ static TPM_RC TSS_CH_RSA_Encrypt(RSA_Encrypt_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_RSA_Decrypt
 static TPM_RC TSS_CH_RSA_Decrypt(RSA_Decrypt_In *in)
 {
     TPM_RC rc = 0;
@@ -381,7 +497,9 @@ static TPM_RC TSS_CH_RSA_Decrypt(RSA_Decrypt_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_ECC_Encrypt
 static TPM_RC TSS_CH_ECC_Encrypt(ECC_Encrypt_In *in)
 {
     TPM_RC rc = 0;
@@ -394,7 +512,9 @@ static TPM_RC TSS_CH_ECC_Encrypt(ECC_Encrypt_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_ECC_Decrypt
 static TPM_RC TSS_CH_ECC_Decrypt(ECC_Decrypt_In *in)
 {
     TPM_RC rc = 0;
@@ -407,7 +527,9 @@ static TPM_RC TSS_CH_ECC_Decrypt(ECC_Decrypt_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_Hash
 static TPM_RC TSS_CH_Hash(Hash_In *in)
 {
     TPM_RC rc = 0;
@@ -420,7 +542,9 @@ static TPM_RC TSS_CH_Hash(Hash_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_HMAC
 static TPM_RC TSS_CH_HMAC(HMAC_In *in)
 {
     TPM_RC rc = 0;
@@ -433,7 +557,9 @@ static TPM_RC TSS_CH_HMAC(HMAC_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_HMAC_Start
 static TPM_RC TSS_CH_HMAC_Start(HMAC_Start_In *in)
 {
     TPM_RC rc = 0;
@@ -446,7 +572,9 @@ static TPM_RC TSS_CH_HMAC_Start(HMAC_Start_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_HashSequenceStart
 static TPM_RC TSS_CH_HashSequenceStart(HashSequenceStart_In *in)
 {
     TPM_RC rc = 0;
@@ -459,7 +587,9 @@ static TPM_RC TSS_CH_HashSequenceStart(HashSequenceStart_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_Certify
 static TPM_RC TSS_CH_Certify(Certify_In *in)
 {
     TPM_RC rc = 0;
@@ -470,7 +600,9 @@ static TPM_RC TSS_CH_Certify(Certify_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_CertifyX509
 static TPM_RC TSS_CH_CertifyX509(CertifyX509_In *in)
 {
     TPM_RC rc = 0;
@@ -481,7 +613,9 @@ static TPM_RC TSS_CH_CertifyX509(CertifyX509_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_CertifyCreation
 static TPM_RC TSS_CH_CertifyCreation(CertifyCreation_In *in)
 {
     TPM_RC rc = 0;
@@ -492,7 +626,9 @@ static TPM_RC TSS_CH_CertifyCreation(CertifyCreation_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_Quote
 static TPM_RC TSS_CH_Quote(Quote_In *in)
 {
     TPM_RC rc = 0;
@@ -503,7 +639,9 @@ static TPM_RC TSS_CH_Quote(Quote_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_GetSessionAuditDigest
 static TPM_RC TSS_CH_GetSessionAuditDigest(GetSessionAuditDigest_In *in)
 {
     TPM_RC rc = 0;
@@ -514,7 +652,9 @@ static TPM_RC TSS_CH_GetSessionAuditDigest(GetSessionAuditDigest_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_GetCommandAuditDigest
 static TPM_RC TSS_CH_GetCommandAuditDigest(GetCommandAuditDigest_In *in)
 {
     TPM_RC rc = 0;
@@ -525,7 +665,9 @@ static TPM_RC TSS_CH_GetCommandAuditDigest(GetCommandAuditDigest_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_GetTime
 static TPM_RC TSS_CH_GetTime(GetTime_In *in)
 {
     TPM_RC rc = 0;
@@ -536,7 +678,9 @@ static TPM_RC TSS_CH_GetTime(GetTime_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_VerifySignature
 static TPM_RC TSS_CH_VerifySignature(VerifySignature_In *in)
 {
     TPM_RC rc = 0;
@@ -549,7 +693,9 @@ static TPM_RC TSS_CH_VerifySignature(VerifySignature_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_Sign
 static TPM_RC TSS_CH_Sign(Sign_In *in)
 {
     TPM_RC rc = 0;
@@ -560,7 +706,9 @@ static TPM_RC TSS_CH_Sign(Sign_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_SetCommandCodeAuditStatus
 static TPM_RC TSS_CH_SetCommandCodeAuditStatus(SetCommandCodeAuditStatus_In *in)
 {
     TPM_RC rc = 0;
@@ -573,7 +721,9 @@ static TPM_RC TSS_CH_SetCommandCodeAuditStatus(SetCommandCodeAuditStatus_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_PolicySigned
 static TPM_RC TSS_CH_PolicySigned(PolicySigned_In *in)
 {
     TPM_RC rc = 0;
@@ -586,7 +736,9 @@ static TPM_RC TSS_CH_PolicySigned(PolicySigned_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_CreatePrimary
 static TPM_RC TSS_CH_CreatePrimary(CreatePrimary_In *in)
 {
     TPM_RC rc = 0;
@@ -597,7 +749,9 @@ static TPM_RC TSS_CH_CreatePrimary(CreatePrimary_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_SetPrimaryPolicy
 static TPM_RC TSS_CH_SetPrimaryPolicy(SetPrimaryPolicy_In *in)
 {
     TPM_RC rc = 0;
@@ -610,7 +764,9 @@ static TPM_RC TSS_CH_SetPrimaryPolicy(SetPrimaryPolicy_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_NV_DefineSpace
 static TPM_RC TSS_CH_NV_DefineSpace(NV_DefineSpace_In *in)
 {
     TPM_RC rc = 0;
@@ -623,7 +779,9 @@ static TPM_RC TSS_CH_NV_DefineSpace(NV_DefineSpace_In *in)
 
     return rc;
 }
+#endif
 
+#if CC_NV_Certify
 static TPM_RC TSS_CH_NV_Certify(NV_Certify_In *in)
 {
     TPM_RC rc = 0;
@@ -634,6 +792,7 @@ static TPM_RC TSS_CH_NV_Certify(NV_Certify_In *in)
 
     return rc;
 }
+#endif
 
 #endif /* TPM_TSS_NODEPRECATEDALGS */
 
@@ -649,120 +808,348 @@ typedef struct TSS_TABLE {
 
 static const TSS_TABLE tssTable [] = {
 
+#if CC_Startup
     {TPM_CC_Startup, NULL, NULL, NULL},
+#endif
+#if CC_Shutdown
     {TPM_CC_Shutdown, NULL, NULL, NULL},
+#endif
+#if CC_SelfTest
     {TPM_CC_SelfTest, NULL, NULL, NULL},
+#endif
+#if CC_IncrementalSelfTest
     {TPM_CC_IncrementalSelfTest, NULL, NULL, NULL},
+#endif
+#if CC_GetTestResult
     {TPM_CC_GetTestResult, NULL, NULL, NULL},
+#endif
+#if CC_StartAuthSession
     {TPM_CC_StartAuthSession, (TSS_PreProcessFunction_t)TSS_PR_StartAuthSession, NULL, (TSS_PostProcessFunction_t)TSS_PO_StartAuthSession},
+#endif
+#if CC_PolicyRestart
     {TPM_CC_PolicyRestart, NULL, NULL, NULL},
+#endif
+#if CC_Create
     {TPM_CC_Create, NULL, NULL, NULL},
+#endif
+#if CC_Load
     {TPM_CC_Load, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_Load},
+#endif
+#if CC_LoadExternal
     {TPM_CC_LoadExternal, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_LoadExternal},
+#endif
+#if CC_ReadPublic
     {TPM_CC_ReadPublic, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_ReadPublic},
+#endif
+#if CC_ActivateCredential
     {TPM_CC_ActivateCredential, NULL, NULL, NULL},
+#endif
+#if CC_MakeCredential
     {TPM_CC_MakeCredential, NULL, NULL, NULL},
+#endif
+#if CC_Unseal
     {TPM_CC_Unseal, NULL, NULL, NULL},
+#endif
+#if CC_ObjectChangeAuth
     {TPM_CC_ObjectChangeAuth, NULL, NULL, NULL},
+#endif
+#if CC_CreateLoaded
     {TPM_CC_CreateLoaded, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_CreateLoaded},
+#endif
+#if CC_Duplicate
     {TPM_CC_Duplicate, NULL, NULL, NULL},
+#endif
+#if CC_Rewrap
     {TPM_CC_Rewrap, NULL, NULL, NULL},
+#endif
+#if CC_Import
     {TPM_CC_Import, NULL, NULL, NULL},
+#endif
+#if CC_RSA_Encrypt
     {TPM_CC_RSA_Encrypt, NULL, NULL, NULL},
+#endif
+#if CC_RSA_Decrypt
     {TPM_CC_RSA_Decrypt, NULL, NULL, NULL},
+#endif
+#if CC_ECDH_KeyGen
     {TPM_CC_ECDH_KeyGen, NULL, NULL, NULL},
+#endif
+#if CC_ECDH_ZGen
     {TPM_CC_ECDH_ZGen, NULL, NULL, NULL},
+#endif
+#if CC_ECC_Encrypt
     {TPM_CC_ECC_Encrypt, NULL, NULL, NULL},
+#endif
+#if CC_ECC_Decrypt
     {TPM_CC_ECC_Decrypt, NULL, NULL, NULL},
+#endif
+#if CC_ECC_Parameters
     {TPM_CC_ECC_Parameters, NULL, NULL, NULL},
+#endif
+#if CC_ZGen_2Phase
     {TPM_CC_ZGen_2Phase, NULL, NULL, NULL},
+#endif
+#if CC_EncryptDecrypt
     {TPM_CC_EncryptDecrypt, NULL, NULL, NULL},
+#endif
+#if CC_EncryptDecrypt2
     {TPM_CC_EncryptDecrypt2, NULL, NULL, NULL},
+#endif
+#if CC_Hash
     {TPM_CC_Hash, NULL, NULL, NULL},
+#endif
+#if CC_HMAC
     {TPM_CC_HMAC, NULL, NULL, NULL},
+#endif
+#if CC_GetRandom
     {TPM_CC_GetRandom, NULL, NULL, NULL},
+#endif
+#if CC_StirRandom
     {TPM_CC_StirRandom, NULL, NULL, NULL},
+#endif
+#if CC_HMAC_Start
     {TPM_CC_HMAC_Start, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_HMAC_Start},
+#endif
+#if CC_HashSequenceStart
     {TPM_CC_HashSequenceStart, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_HashSequenceStart},
+#endif
+#if CC_SequenceUpdate
     {TPM_CC_SequenceUpdate, NULL, NULL, NULL},
+#endif
+#if CC_SequenceComplete
     {TPM_CC_SequenceComplete, NULL,NULL, (TSS_PostProcessFunction_t)TSS_PO_SequenceComplete},
+#endif
+#if CC_EventSequenceComplete
     {TPM_CC_EventSequenceComplete, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_EventSequenceComplete},
+#endif
+#if CC_Certify
     {TPM_CC_Certify, NULL, NULL, NULL},
+#endif
+#if CC_CertifyX509
     {TPM_CC_CertifyX509, NULL, NULL, NULL},
+#endif
+#if CC_CertifyCreation
     {TPM_CC_CertifyCreation, NULL, NULL, NULL},
+#endif
+#if CC_Quote
     {TPM_CC_Quote, NULL, NULL, NULL},
+#endif
+#if CC_GetSessionAuditDigest
     {TPM_CC_GetSessionAuditDigest, NULL, NULL, NULL},
+#endif
+#if CC_GetCommandAuditDigest
     {TPM_CC_GetCommandAuditDigest, NULL, NULL, NULL},
+#endif
+#if CC_GetTime
     {TPM_CC_GetTime, NULL, NULL, NULL},
+#endif
+#if CC_Commit
     {TPM_CC_Commit, NULL, NULL, NULL},
+#endif
+#if CC_EC_Ephemeral
     {TPM_CC_EC_Ephemeral, NULL, NULL, NULL},
+#endif
+#if CC_VerifySignature
     {TPM_CC_VerifySignature, NULL, NULL, NULL},
+#endif
+#if CC_Sign
     {TPM_CC_Sign, NULL, NULL, NULL},
+#endif
+#if CC_SetCommandCodeAuditStatus
     {TPM_CC_SetCommandCodeAuditStatus, NULL, NULL, NULL},
+#endif
+#if CC_PCR_Extend
     {TPM_CC_PCR_Extend, NULL, NULL, NULL},
+#endif
+#if CC_PCR_Event
     {TPM_CC_PCR_Event, NULL, NULL, NULL},
+#endif
+#if CC_PCR_Read
     {TPM_CC_PCR_Read, NULL, NULL, NULL},
+#endif
+#if CC_PCR_Allocate
     {TPM_CC_PCR_Allocate, NULL, NULL, NULL},
+#endif
+#if CC_PCR_SetAuthPolicy
     {TPM_CC_PCR_SetAuthPolicy, NULL, NULL, NULL},
+#endif
+#if CC_PCR_SetAuthValue
     {TPM_CC_PCR_SetAuthValue, NULL, NULL, NULL},
+#endif
+#if CC_PCR_Reset
     {TPM_CC_PCR_Reset, NULL, NULL, NULL},
+#endif
+#if CC_PolicySigned
     {TPM_CC_PolicySigned, NULL, NULL, NULL},
+#endif
+#if CC_PolicySecret
     {TPM_CC_PolicySecret, NULL, NULL, NULL},
+#endif
+#if CC_PolicyTicket
     {TPM_CC_PolicyTicket, NULL, NULL, NULL},
+#endif
+#if CC_PolicyOR
     {TPM_CC_PolicyOR, NULL, NULL, NULL},
+#endif
+#if CC_PolicyPCR
     {TPM_CC_PolicyPCR, NULL, NULL, NULL},
+#endif
+#if CC_PolicyLocality
     {TPM_CC_PolicyLocality, NULL, NULL, NULL},
+#endif
+#if CC_PolicyNV
     {TPM_CC_PolicyNV, NULL, NULL, NULL},
+#endif
+#if CC_PolicyAuthorizeNV
     {TPM_CC_PolicyAuthorizeNV, NULL, NULL, NULL},
+#endif
+#if CC_PolicyCounterTimer
     {TPM_CC_PolicyCounterTimer, NULL, NULL, NULL},
+#endif
+#if CC_PolicyCommandCode
     {TPM_CC_PolicyCommandCode, NULL, NULL, NULL},
+#endif
+#if CC_PolicyPhysicalPresence
     {TPM_CC_PolicyPhysicalPresence, NULL, NULL, NULL},
+#endif
+#if CC_PolicyCpHash
     {TPM_CC_PolicyCpHash, NULL, NULL, NULL},
+#endif
+#if CC_PolicyNameHash
     {TPM_CC_PolicyNameHash, NULL, NULL, NULL},
+#endif
+#if CC_PolicyDuplicationSelect
     {TPM_CC_PolicyDuplicationSelect, NULL, NULL, NULL},
+#endif
+#if CC_PolicyAuthorize
     {TPM_CC_PolicyAuthorize, NULL, NULL, NULL},
+#endif
+#if CC_PolicyAuthValue
     {TPM_CC_PolicyAuthValue, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_PolicyAuthValue},
+#endif
+#if CC_PolicyPassword
     {TPM_CC_PolicyPassword, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_PolicyPassword},
+#endif
+#if CC_PolicyGetDigest
     {TPM_CC_PolicyGetDigest, NULL, NULL, NULL},
+#endif
+#if CC_PolicyNvWritten
     {TPM_CC_PolicyNvWritten, NULL, NULL, NULL},
+#endif
+#if CC_PolicyTemplate
     {TPM_CC_PolicyTemplate, NULL, NULL, NULL},
+#endif
+#if CC_PolicyCapability
     {TPM_CC_PolicyCapability, NULL, NULL, NULL},
+#endif
+#if CC_PolicyParameters
     {TPM_CC_PolicyParameters, NULL, NULL, NULL},
+#endif
+#if CC_CreatePrimary
     {TPM_CC_CreatePrimary, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_CreatePrimary},
+#endif
+#if CC_HierarchyControl
     {TPM_CC_HierarchyControl, NULL, NULL, NULL},
+#endif
+#if CC_SetPrimaryPolicy
     {TPM_CC_SetPrimaryPolicy, NULL, NULL, NULL},
+#endif
+#if CC_ChangePPS
     {TPM_CC_ChangePPS, NULL, NULL, NULL},
+#endif
+#if CC_ChangeEPS
     {TPM_CC_ChangeEPS, NULL, NULL, NULL},
+#endif
+#if CC_Clear
     {TPM_CC_Clear, NULL, NULL, NULL},
+#endif
+#if CC_ClearControl
     {TPM_CC_ClearControl, NULL, NULL, NULL},
+#endif
+#if CC_HierarchyChangeAuth
     {TPM_CC_HierarchyChangeAuth, NULL, (TSS_ChangeAuthFunction_t)TSS_CA_HierarchyChangeAuth, NULL},
+#endif
+#if CC_DictionaryAttackLockReset
     {TPM_CC_DictionaryAttackLockReset, NULL, NULL, NULL},
+#endif
+#if CC_DictionaryAttackParameters
     {TPM_CC_DictionaryAttackParameters, NULL, NULL, NULL},
+#endif
+#if CC_PP_Commands
     {TPM_CC_PP_Commands, NULL, NULL, NULL},
+#endif
+#if CC_SetAlgorithmSet
     {TPM_CC_SetAlgorithmSet, NULL, NULL, NULL},
+#endif
+#if CC_ContextSave
     {TPM_CC_ContextSave, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_ContextSave},
+#endif
+#if CC_ContextLoad
     {TPM_CC_ContextLoad, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_ContextLoad},
+#endif
+#if CC_FlushContext
     {TPM_CC_FlushContext, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_FlushContext},
+#endif
+#if CC_EvictControl
     {TPM_CC_EvictControl, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_EvictControl},
+#endif
+#if CC_ReadClock
     {TPM_CC_ReadClock, NULL, NULL, NULL},
+#endif
+#if CC_ClockSet
     {TPM_CC_ClockSet, NULL, NULL, NULL},
+#endif
+#if CC_ClockRateAdjust
     {TPM_CC_ClockRateAdjust, NULL, NULL, NULL},
+#endif
+#if CC_GetCapability
     {TPM_CC_GetCapability, NULL, NULL, NULL},
+#endif
+#if CC_TestParms
     {TPM_CC_TestParms, NULL, NULL, NULL},
+#endif
+#if CC_NV_DefineSpace
     {TPM_CC_NV_DefineSpace, (TSS_PreProcessFunction_t)TSS_PR_NV_DefineSpace, NULL,  (TSS_PostProcessFunction_t)TSS_PO_NV_DefineSpace},
+#endif
+#if CC_NV_UndefineSpace
     {TPM_CC_NV_UndefineSpace, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_NV_UndefineSpace},
+#endif
+#if CC_NV_UndefineSpaceSpecial
     {TPM_CC_NV_UndefineSpaceSpecial, NULL, (TSS_ChangeAuthFunction_t)TSS_CA_NV_UndefineSpaceSpecial, (TSS_PostProcessFunction_t)TSS_PO_NV_UndefineSpaceSpecial},
+#endif
+#if CC_NV_ReadPublic
     {TPM_CC_NV_ReadPublic, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_NV_ReadPublic},
+#endif
+#if CC_NV_Write
     {TPM_CC_NV_Write, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_NV_Write},
+#endif
+#if CC_NV_Increment
     {TPM_CC_NV_Increment, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_NV_Write},
+#endif
+#if CC_NV_Extend
     {TPM_CC_NV_Extend, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_NV_Write},
+#endif
+#if CC_NV_SetBits
     {TPM_CC_NV_SetBits, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_NV_Write},
+#endif
+#if CC_NV_WriteLock
     {TPM_CC_NV_WriteLock, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_NV_WriteLock},
+#endif
+#if CC_NV_GlobalWriteLock
     {TPM_CC_NV_GlobalWriteLock, NULL, NULL, NULL},
+#endif
+#if CC_NV_Read
     {TPM_CC_NV_Read, NULL, NULL, NULL},
+#endif
+#if CC_NV_ReadLock
     {TPM_CC_NV_ReadLock, NULL, NULL, (TSS_PostProcessFunction_t)TSS_PO_NV_ReadLock},
+#endif
+#if CC_NV_ChangeAuth
     {TPM_CC_NV_ChangeAuth, NULL, (TSS_ChangeAuthFunction_t)TSS_CA_NV_ChangeAuth, NULL},
+#endif
+#if CC_NV_Certify
     {TPM_CC_NV_Certify, NULL, NULL, NULL}
+#endif
 };
 
 #ifdef TPM_TSS_NODEPRECATEDALGS
@@ -777,120 +1164,348 @@ typedef struct TSS_CH_TABLE {
 
 static const TSS_CH_TABLE tssChTable [] = {
 
+#if CC_Startup
     {TPM_CC_Startup, NULL},
+#endif
+#if CC_Shutdown
     {TPM_CC_Shutdown, NULL},
+#endif
+#if CC_SelfTest
     {TPM_CC_SelfTest, NULL},
+#endif
+#if CC_IncrementalSelfTest
     {TPM_CC_IncrementalSelfTest, NULL},
+#endif
+#if CC_GetTestResult
     {TPM_CC_GetTestResult, NULL},
+#endif
+#if CC_StartAuthSession
     {TPM_CC_StartAuthSession, (TSS_CheckParametersFunction_t)TSS_CH_StartAuthSession},
+#endif
+#if CC_PolicyRestart
     {TPM_CC_PolicyRestart, NULL},
+#endif
+#if CC_Create
     {TPM_CC_Create, (TSS_CheckParametersFunction_t)TSS_CH_Create},
+#endif
+#if CC_Load
     {TPM_CC_Load, (TSS_CheckParametersFunction_t)TSS_CH_Load},
+#endif
+#if CC_LoadExternal
     {TPM_CC_LoadExternal, (TSS_CheckParametersFunction_t)TSS_CH_LoadExternal},
+#endif
+#if CC_ReadPublic
     {TPM_CC_ReadPublic, NULL},
+#endif
+#if CC_ActivateCredential
     {TPM_CC_ActivateCredential, NULL},
+#endif
+#if CC_MakeCredential
     {TPM_CC_MakeCredential, NULL},
+#endif
+#if CC_Unseal
     {TPM_CC_Unseal, NULL},
+#endif
+#if CC_ObjectChangeAuth
     {TPM_CC_ObjectChangeAuth, NULL},
+#endif
+#if CC_CreateLoaded
     {TPM_CC_CreateLoaded, (TSS_CheckParametersFunction_t)TSS_CH_CreateLoaded},
+#endif
+#if CC_Duplicate
     {TPM_CC_Duplicate, NULL},
+#endif
+#if CC_Rewrap
     {TPM_CC_Rewrap, NULL},
+#endif
+#if CC_Import
     {TPM_CC_Import, (TSS_CheckParametersFunction_t)TSS_CH_Import},
+#endif
+#if CC_RSA_Encrypt
     {TPM_CC_RSA_Encrypt, (TSS_CheckParametersFunction_t)TSS_CH_RSA_Encrypt},
+#endif
+#if CC_RSA_Decrypt
     {TPM_CC_RSA_Decrypt, (TSS_CheckParametersFunction_t)TSS_CH_RSA_Decrypt},
+#endif
+#if CC_ECDH_KeyGen
     {TPM_CC_ECDH_KeyGen, NULL},
+#endif
+#if CC_ECDH_ZGen
     {TPM_CC_ECDH_ZGen, NULL},
+#endif
+#if CC_ECC_Encrypt
     {TPM_CC_ECC_Encrypt, (TSS_CheckParametersFunction_t)TSS_CH_ECC_Encrypt},
+#endif
+#if CC_ECC_Decrypt
     {TPM_CC_ECC_Decrypt, (TSS_CheckParametersFunction_t)TSS_CH_ECC_Decrypt},
+#endif
+#if CC_ECC_Parameters
     {TPM_CC_ECC_Parameters, NULL},
+#endif
+#if CC_ZGen_2Phase
     {TPM_CC_ZGen_2Phase, NULL},
+#endif
+#if CC_EncryptDecrypt
     {TPM_CC_EncryptDecrypt, NULL},
+#endif
+#if CC_EncryptDecrypt2
     {TPM_CC_EncryptDecrypt2, NULL},
+#endif
+#if CC_Hash
     {TPM_CC_Hash, (TSS_CheckParametersFunction_t)TSS_CH_Hash},
+#endif
+#if CC_HMAC
     {TPM_CC_HMAC, (TSS_CheckParametersFunction_t)TSS_CH_HMAC},
+#endif
+#if CC_GetRandom
     {TPM_CC_GetRandom, NULL},
+#endif
+#if CC_StirRandom
     {TPM_CC_StirRandom, NULL},
+#endif
+#if CC_HMAC_Start
     {TPM_CC_HMAC_Start, (TSS_CheckParametersFunction_t)TSS_CH_HMAC_Start},
+#endif
+#if CC_HashSequenceStart
     {TPM_CC_HashSequenceStart, (TSS_CheckParametersFunction_t)TSS_CH_HashSequenceStart},
+#endif
+#if CC_SequenceUpdate
     {TPM_CC_SequenceUpdate, NULL},
+#endif
+#if CC_SequenceComplete
     {TPM_CC_SequenceComplete, NULL},
+#endif
+#if CC_EventSequenceComplete
     {TPM_CC_EventSequenceComplete, NULL},
+#endif
+#if CC_Certify
     {TPM_CC_Certify, (TSS_CheckParametersFunction_t)TSS_CH_Certify},
+#endif
+#if CC_CertifyX509
     {TPM_CC_CertifyX509, (TSS_CheckParametersFunction_t)TSS_CH_CertifyX509},
+#endif
+#if CC_CertifyCreation
     {TPM_CC_CertifyCreation, (TSS_CheckParametersFunction_t)TSS_CH_CertifyCreation},
+#endif
+#if CC_Quote
     {TPM_CC_Quote, (TSS_CheckParametersFunction_t)TSS_CH_Quote},
+#endif
+#if CC_GetSessionAuditDigest
     {TPM_CC_GetSessionAuditDigest, (TSS_CheckParametersFunction_t)TSS_CH_GetSessionAuditDigest},
+#endif
+#if CC_GetCommandAuditDigest
     {TPM_CC_GetCommandAuditDigest, (TSS_CheckParametersFunction_t)TSS_CH_GetCommandAuditDigest},
+#endif
+#if CC_GetTime
     {TPM_CC_GetTime, (TSS_CheckParametersFunction_t)TSS_CH_GetTime},
+#endif
+#if CC_Commit
     {TPM_CC_Commit, NULL},
+#endif
+#if CC_EC_Ephemeral
     {TPM_CC_EC_Ephemeral, NULL},
+#endif
+#if CC_VerifySignature
     {TPM_CC_VerifySignature, (TSS_CheckParametersFunction_t)TSS_CH_VerifySignature},
+#endif
+#if CC_Sign
     {TPM_CC_Sign, (TSS_CheckParametersFunction_t)TSS_CH_Sign},
+#endif
+#if CC_SetCommandCodeAuditStatus
     {TPM_CC_SetCommandCodeAuditStatus, (TSS_CheckParametersFunction_t)TSS_CH_SetCommandCodeAuditStatus},
+#endif
+#if CC_PCR_Extend
     {TPM_CC_PCR_Extend, NULL},
+#endif
+#if CC_PCR_Event
     {TPM_CC_PCR_Event, NULL},
+#endif
+#if CC_PCR_Read
     {TPM_CC_PCR_Read, NULL},
+#endif
+#if CC_PCR_Allocate
     {TPM_CC_PCR_Allocate, NULL},
+#endif
+#if CC_PCR_SetAuthPolicy
     {TPM_CC_PCR_SetAuthPolicy, NULL},
+#endif
+#if CC_PCR_SetAuthValue
     {TPM_CC_PCR_SetAuthValue, NULL},
+#endif
+#if CC_PCR_Reset
     {TPM_CC_PCR_Reset, NULL},
+#endif
+#if CC_PolicySigned
     {TPM_CC_PolicySigned, (TSS_CheckParametersFunction_t)TSS_CH_PolicySigned},
+#endif
+#if CC_PolicySecret
     {TPM_CC_PolicySecret, NULL},
+#endif
+#if CC_PolicyTicket
     {TPM_CC_PolicyTicket, NULL},
+#endif
+#if CC_PolicyOR
     {TPM_CC_PolicyOR, NULL},
+#endif
+#if CC_PolicyPCR
     {TPM_CC_PolicyPCR, NULL},
+#endif
+#if CC_PolicyLocality
     {TPM_CC_PolicyLocality, NULL},
+#endif
+#if CC_PolicyNV
     {TPM_CC_PolicyNV, NULL},
+#endif
+#if CC_PolicyAuthorizeNV
     {TPM_CC_PolicyAuthorizeNV, NULL},
+#endif
+#if CC_PolicyCounterTimer
     {TPM_CC_PolicyCounterTimer, NULL},
+#endif
+#if CC_PolicyCommandCode
     {TPM_CC_PolicyCommandCode, NULL},
+#endif
+#if CC_PolicyPhysicalPresence
     {TPM_CC_PolicyPhysicalPresence, NULL},
+#endif
+#if CC_PolicyCpHash
     {TPM_CC_PolicyCpHash, NULL},
+#endif
+#if CC_PolicyNameHash
     {TPM_CC_PolicyNameHash, NULL},
+#endif
+#if CC_PolicyDuplicationSelect
     {TPM_CC_PolicyDuplicationSelect, NULL},
+#endif
+#if CC_PolicyAuthorize
     {TPM_CC_PolicyAuthorize, NULL},
+#endif
+#if CC_PolicyAuthValue
     {TPM_CC_PolicyAuthValue, NULL},
+#endif
+#if CC_PolicyPassword
     {TPM_CC_PolicyPassword, NULL},
+#endif
+#if CC_PolicyGetDigest
     {TPM_CC_PolicyGetDigest, NULL},
+#endif
+#if CC_PolicyNvWritten
     {TPM_CC_PolicyNvWritten, NULL},
+#endif
+#if CC_PolicyTemplate
     {TPM_CC_PolicyTemplate, NULL},
+#endif
+#if CC_PolicyCapability
     {TPM_CC_PolicyCapability, NULL},
+#endif
+#if CC_PolicyParameters
     {TPM_CC_PolicyParameters, NULL},
+#endif
+#if CC_CreatePrimary
     {TPM_CC_CreatePrimary, (TSS_CheckParametersFunction_t)TSS_CH_CreatePrimary},
+#endif
+#if CC_HierarchyControl
     {TPM_CC_HierarchyControl, NULL},
+#endif
+#if CC_SetPrimaryPolicy
     {TPM_CC_SetPrimaryPolicy, (TSS_CheckParametersFunction_t)TSS_CH_SetPrimaryPolicy},
+#endif
+#if CC_ChangePPS
     {TPM_CC_ChangePPS, NULL},
+#endif
+#if CC_ChangeEPS
     {TPM_CC_ChangeEPS, NULL},
+#endif
+#if CC_Clear
     {TPM_CC_Clear, NULL},
+#endif
+#if CC_ClearControl
     {TPM_CC_ClearControl, NULL},
+#endif
+#if CC_HierarchyChangeAuth
     {TPM_CC_HierarchyChangeAuth, NULL},
+#endif
+#if CC_DictionaryAttackLockReset
     {TPM_CC_DictionaryAttackLockReset, NULL},
+#endif
+#if CC_DictionaryAttackParameters
     {TPM_CC_DictionaryAttackParameters, NULL},
+#endif
+#if CC_PP_Commands
     {TPM_CC_PP_Commands, NULL},
+#endif
+#if CC_SetAlgorithmSet
     {TPM_CC_SetAlgorithmSet, NULL},
+#endif
+#if CC_ContextSave
     {TPM_CC_ContextSave, NULL},
+#endif
+#if CC_ContextLoad
     {TPM_CC_ContextLoad, NULL},
+#endif
+#if CC_FlushContext
     {TPM_CC_FlushContext, NULL},
+#endif
+#if CC_EvictControl
     {TPM_CC_EvictControl, NULL},
+#endif
+#if CC_ReadClock
     {TPM_CC_ReadClock, NULL},
+#endif
+#if CC_ClockSet
     {TPM_CC_ClockSet, NULL},
+#endif
+#if CC_ClockRateAdjust
     {TPM_CC_ClockRateAdjust, NULL},
+#endif
+#if CC_GetCapability
     {TPM_CC_GetCapability, NULL},
+#endif
+#if CC_TestParms
     {TPM_CC_TestParms, NULL},
+#endif
+#if CC_NV_DefineSpace
     {TPM_CC_NV_DefineSpace, (TSS_CheckParametersFunction_t)TSS_CH_NV_DefineSpace},
+#endif
+#if CC_NV_UndefineSpace
     {TPM_CC_NV_UndefineSpace, NULL},
+#endif
+#if CC_NV_UndefineSpaceSpecial
     {TPM_CC_NV_UndefineSpaceSpecial, NULL},
+#endif
+#if CC_NV_ReadPublic
     {TPM_CC_NV_ReadPublic, NULL},
+#endif
+#if CC_NV_Write
     {TPM_CC_NV_Write, NULL},
+#endif
+#if CC_NV_Increment
     {TPM_CC_NV_Increment, NULL},
+#endif
+#if CC_NV_Extend
     {TPM_CC_NV_Extend, NULL},
+#endif
+#if CC_NV_SetBits
     {TPM_CC_NV_SetBits, NULL},
+#endif
+#if CC_NV_WriteLock
     {TPM_CC_NV_WriteLock, NULL},
+#endif
+#if CC_NV_GlobalWriteLock
     {TPM_CC_NV_GlobalWriteLock, NULL},
+#endif
+#if CC_NV_Read
     {TPM_CC_NV_Read, NULL},
+#endif
+#if CC_NV_ReadLock
     {TPM_CC_NV_ReadLock, NULL},
+#endif
+#if CC_NV_ChangeAuth
     {TPM_CC_NV_ChangeAuth, NULL},
+#endif
+#if CC_NV_Certify
     {TPM_CC_NV_Certify, (TSS_CheckParametersFunction_t)TSS_CH_NV_Certify}
+#endif
 };
 
 #endif  /* TPM_TSS_NODEPRECATEDALGS */
@@ -909,120 +1524,348 @@ typedef struct TSS_PRINT_TABLE {
 
 static const TSS_PRINT_TABLE tssPrintTable [] = {
 				 
+#if CC_Startup
     {TPM_CC_Startup, (TSS_InPrintFunction_t)Startup_In_Print},
+#endif
+#if CC_Shutdown
     {TPM_CC_Shutdown, (TSS_InPrintFunction_t)Shutdown_In_Print},
+#endif
+#if CC_SelfTest
     {TPM_CC_SelfTest, (TSS_InPrintFunction_t)SelfTest_In_Print},
+#endif
+#if CC_IncrementalSelfTest
     {TPM_CC_IncrementalSelfTest, (TSS_InPrintFunction_t)IncrementalSelfTest_In_Print},
+#endif
+#if CC_GetTestResult
     {TPM_CC_GetTestResult, NULL},
+#endif
+#if CC_StartAuthSession
     {TPM_CC_StartAuthSession, (TSS_InPrintFunction_t)StartAuthSession_In_Print},
+#endif
+#if CC_PolicyRestart
     {TPM_CC_PolicyRestart, (TSS_InPrintFunction_t)PolicyRestart_In_Print},
+#endif
+#if CC_Create
     {TPM_CC_Create,(TSS_InPrintFunction_t)Create_In_Print},
+#endif
+#if CC_Load
     {TPM_CC_Load, (TSS_InPrintFunction_t)Load_In_Print},
+#endif
+#if CC_LoadExternal
     {TPM_CC_LoadExternal, (TSS_InPrintFunction_t)LoadExternal_In_Print},
+#endif
+#if CC_ReadPublic
     {TPM_CC_ReadPublic, (TSS_InPrintFunction_t)ReadPublic_In_Print},
+#endif
+#if CC_ActivateCredential
     {TPM_CC_ActivateCredential, (TSS_InPrintFunction_t)ActivateCredential_In_Print},
+#endif
+#if CC_MakeCredential
     {TPM_CC_MakeCredential, (TSS_InPrintFunction_t)MakeCredential_In_Print},
+#endif
+#if CC_Unseal
     {TPM_CC_Unseal, (TSS_InPrintFunction_t)Unseal_In_Print},
+#endif
+#if CC_ObjectChangeAuth
     {TPM_CC_ObjectChangeAuth, (TSS_InPrintFunction_t)ObjectChangeAuth_In_Print},
+#endif
+#if CC_CreateLoaded
     {TPM_CC_CreateLoaded, (TSS_InPrintFunction_t)CreateLoaded_In_Print},
+#endif
+#if CC_Duplicate
     {TPM_CC_Duplicate, (TSS_InPrintFunction_t)Duplicate_In_Print},
+#endif
+#if CC_Rewrap
     {TPM_CC_Rewrap, (TSS_InPrintFunction_t)Rewrap_In_Print},
+#endif
+#if CC_Import
     {TPM_CC_Import, (TSS_InPrintFunction_t)Import_In_Print},
+#endif
+#if CC_RSA_Encrypt
     {TPM_CC_RSA_Encrypt, (TSS_InPrintFunction_t)RSA_Encrypt_In_Print},
+#endif
+#if CC_RSA_Decrypt
     {TPM_CC_RSA_Decrypt, (TSS_InPrintFunction_t)RSA_Decrypt_In_Print},
+#endif
+#if CC_ECDH_KeyGen
     {TPM_CC_ECDH_KeyGen, (TSS_InPrintFunction_t)ECDH_KeyGen_In_Print},
+#endif
+#if CC_ECDH_ZGen
     {TPM_CC_ECDH_ZGen, (TSS_InPrintFunction_t)ECDH_ZGen_In_Print},
+#endif
+#if CC_ECC_Encrypt
     {TPM_CC_ECC_Encrypt, (TSS_InPrintFunction_t)ECC_Encrypt_In_Print},
+#endif
+#if CC_ECC_Decrypt
     {TPM_CC_ECC_Decrypt, (TSS_InPrintFunction_t)ECC_Decrypt_In_Print},
+#endif
+#if CC_ECC_Parameters
     {TPM_CC_ECC_Parameters, (TSS_InPrintFunction_t)ECC_Parameters_In_Print},
+#endif
+#if CC_ZGen_2Phase
     {TPM_CC_ZGen_2Phase, (TSS_InPrintFunction_t)ZGen_2Phase_In_Print},
+#endif
+#if CC_EncryptDecrypt
     {TPM_CC_EncryptDecrypt, (TSS_InPrintFunction_t)EncryptDecrypt_In_Print},
+#endif
+#if CC_EncryptDecrypt2
     {TPM_CC_EncryptDecrypt2, (TSS_InPrintFunction_t)EncryptDecrypt2_In_Print},
+#endif
+#if CC_Hash
     {TPM_CC_Hash, (TSS_InPrintFunction_t)Hash_In_Print},
+#endif
+#if CC_HMAC
     {TPM_CC_HMAC, (TSS_InPrintFunction_t)HMAC_In_Print},
+#endif
+#if CC_GetRandom
     {TPM_CC_GetRandom, (TSS_InPrintFunction_t)GetRandom_In_Print},
+#endif
+#if CC_StirRandom
     {TPM_CC_StirRandom, (TSS_InPrintFunction_t)StirRandom_In_Print},
+#endif
+#if CC_HMAC_Start
     {TPM_CC_HMAC_Start, (TSS_InPrintFunction_t)HMAC_Start_In_Print},
+#endif
+#if CC_HashSequenceStart
     {TPM_CC_HashSequenceStart, (TSS_InPrintFunction_t)HashSequenceStart_In_Print},
+#endif
+#if CC_SequenceUpdate
     {TPM_CC_SequenceUpdate, (TSS_InPrintFunction_t)SequenceUpdate_In_Print},
+#endif
+#if CC_SequenceComplete
     {TPM_CC_SequenceComplete, (TSS_InPrintFunction_t)SequenceComplete_In_Print},
+#endif
+#if CC_EventSequenceComplete
     {TPM_CC_EventSequenceComplete, (TSS_InPrintFunction_t)EventSequenceComplete_In_Print},
+#endif
+#if CC_Certify
     {TPM_CC_Certify, (TSS_InPrintFunction_t)Certify_In_Print},
+#endif
+#if CC_CertifyX509
     {TPM_CC_CertifyX509, (TSS_InPrintFunction_t)CertifyX509_In_Print},
+#endif
+#if CC_CertifyCreation
     {TPM_CC_CertifyCreation, (TSS_InPrintFunction_t)CertifyCreation_In_Print},
+#endif
+#if CC_Quote
     {TPM_CC_Quote, (TSS_InPrintFunction_t)Quote_In_Print},
+#endif
+#if CC_GetSessionAuditDigest
     {TPM_CC_GetSessionAuditDigest, (TSS_InPrintFunction_t)GetSessionAuditDigest_In_Print},
+#endif
+#if CC_GetCommandAuditDigest
     {TPM_CC_GetCommandAuditDigest, (TSS_InPrintFunction_t)GetCommandAuditDigest_In_Print},
+#endif
+#if CC_GetTime
     {TPM_CC_GetTime, (TSS_InPrintFunction_t)GetTime_In_Print},
+#endif
+#if CC_Commit
     {TPM_CC_Commit, (TSS_InPrintFunction_t)Commit_In_Print},
+#endif
+#if CC_EC_Ephemeral
     {TPM_CC_EC_Ephemeral, (TSS_InPrintFunction_t)EC_Ephemeral_In_Print},
+#endif
+#if CC_VerifySignature
     {TPM_CC_VerifySignature, (TSS_InPrintFunction_t)VerifySignature_In_Print},
+#endif
+#if CC_Sign
     {TPM_CC_Sign, (TSS_InPrintFunction_t)Sign_In_Print},
+#endif
+#if CC_SetCommandCodeAuditStatus
     {TPM_CC_SetCommandCodeAuditStatus, (TSS_InPrintFunction_t)SetCommandCodeAuditStatus_In_Print},
+#endif
+#if CC_PCR_Extend
     {TPM_CC_PCR_Extend, (TSS_InPrintFunction_t)PCR_Extend_In_Print},
+#endif
+#if CC_PCR_Event
     {TPM_CC_PCR_Event, (TSS_InPrintFunction_t)PCR_Event_In_Print},
+#endif
+#if CC_PCR_Read
     {TPM_CC_PCR_Read, (TSS_InPrintFunction_t)PCR_Read_In_Print},
+#endif
+#if CC_PCR_Allocate
     {TPM_CC_PCR_Allocate, (TSS_InPrintFunction_t)PCR_Allocate_In_Print},
+#endif
+#if CC_PCR_SetAuthPolicy
     {TPM_CC_PCR_SetAuthPolicy, (TSS_InPrintFunction_t)PCR_SetAuthPolicy_In_Print},
+#endif
+#if CC_PCR_SetAuthValue
     {TPM_CC_PCR_SetAuthValue, (TSS_InPrintFunction_t)PCR_SetAuthValue_In_Print},
+#endif
+#if CC_PCR_Reset
     {TPM_CC_PCR_Reset, (TSS_InPrintFunction_t)PCR_Reset_In_Print},
+#endif
+#if CC_PolicySigned
     {TPM_CC_PolicySigned, (TSS_InPrintFunction_t)PolicySigned_In_Print},
+#endif
+#if CC_PolicySecret
     {TPM_CC_PolicySecret, (TSS_InPrintFunction_t)PolicySecret_In_Print},
+#endif
+#if CC_PolicyTicket
     {TPM_CC_PolicyTicket, (TSS_InPrintFunction_t)PolicyTicket_In_Print},
+#endif
+#if CC_PolicyOR
     {TPM_CC_PolicyOR, (TSS_InPrintFunction_t)PolicyOR_In_Print},
+#endif
+#if CC_PolicyPCR
     {TPM_CC_PolicyPCR, (TSS_InPrintFunction_t)PolicyPCR_In_Print},
+#endif
+#if CC_PolicyLocality
     {TPM_CC_PolicyLocality, (TSS_InPrintFunction_t)PolicyLocality_In_Print},
+#endif
+#if CC_PolicyNV
     {TPM_CC_PolicyNV, (TSS_InPrintFunction_t)PolicyNV_In_Print},
+#endif
+#if CC_PolicyAuthorizeNV
     {TPM_CC_PolicyAuthorizeNV, (TSS_InPrintFunction_t)PolicyAuthorizeNV_In_Print},
+#endif
+#if CC_PolicyCounterTimer
     {TPM_CC_PolicyCounterTimer, (TSS_InPrintFunction_t)PolicyCounterTimer_In_Print},
+#endif
+#if CC_PolicyCommandCode
     {TPM_CC_PolicyCommandCode, (TSS_InPrintFunction_t)PolicyCommandCode_In_Print},
+#endif
+#if CC_PolicyPhysicalPresence
     {TPM_CC_PolicyPhysicalPresence, (TSS_InPrintFunction_t)PolicyPhysicalPresence_In_Print},
+#endif
+#if CC_PolicyCpHash
     {TPM_CC_PolicyCpHash, (TSS_InPrintFunction_t)PolicyCpHash_In_Print},
+#endif
+#if CC_PolicyNameHash
     {TPM_CC_PolicyNameHash, (TSS_InPrintFunction_t)PolicyNameHash_In_Print},
+#endif
+#if CC_PolicyDuplicationSelect
     {TPM_CC_PolicyDuplicationSelect, (TSS_InPrintFunction_t)PolicyDuplicationSelect_In_Print},
+#endif
+#if CC_PolicyAuthorize
     {TPM_CC_PolicyAuthorize, (TSS_InPrintFunction_t)PolicyAuthorize_In_Print},
+#endif
+#if CC_PolicyAuthValue
     {TPM_CC_PolicyAuthValue, (TSS_InPrintFunction_t)PolicyAuthValue_In_Print},
+#endif
+#if CC_PolicyPassword
     {TPM_CC_PolicyPassword, (TSS_InPrintFunction_t)PolicyPassword_In_Print},
+#endif
+#if CC_PolicyGetDigest
     {TPM_CC_PolicyGetDigest, (TSS_InPrintFunction_t)PolicyGetDigest_In_Print},
+#endif
+#if CC_PolicyNvWritten
     {TPM_CC_PolicyNvWritten, (TSS_InPrintFunction_t)PolicyNvWritten_In_Print},
+#endif
+#if CC_PolicyTemplate
     {TPM_CC_PolicyTemplate, (TSS_InPrintFunction_t)PolicyTemplate_In_Print},
+#endif
+#if CC_PolicyCapability
     {TPM_CC_PolicyCapability, (TSS_InPrintFunction_t)PolicyCapability_In_Print},
+#endif
+#if CC_PolicyParameters
     {TPM_CC_PolicyParameters, (TSS_InPrintFunction_t)PolicyParameters_In_Print},
+#endif
+#if CC_CreatePrimary
     {TPM_CC_CreatePrimary, (TSS_InPrintFunction_t)CreatePrimary_In_Print},
+#endif
+#if CC_HierarchyControl
     {TPM_CC_HierarchyControl, (TSS_InPrintFunction_t)HierarchyControl_In_Print},
+#endif
+#if CC_SetPrimaryPolicy
     {TPM_CC_SetPrimaryPolicy, (TSS_InPrintFunction_t)SetPrimaryPolicy_In_Print},
+#endif
+#if CC_ChangePPS
     {TPM_CC_ChangePPS, (TSS_InPrintFunction_t)ChangePPS_In_Print},
+#endif
+#if CC_ChangeEPS
     {TPM_CC_ChangeEPS, (TSS_InPrintFunction_t)ChangeEPS_In_Print},
+#endif
+#if CC_Clear
     {TPM_CC_Clear, (TSS_InPrintFunction_t)Clear_In_Print},
+#endif
+#if CC_ClearControl
     {TPM_CC_ClearControl, (TSS_InPrintFunction_t)ClearControl_In_Print},
+#endif
+#if CC_HierarchyChangeAuth
     {TPM_CC_HierarchyChangeAuth, (TSS_InPrintFunction_t)HierarchyChangeAuth_In_Print},
+#endif
+#if CC_DictionaryAttackLockReset
     {TPM_CC_DictionaryAttackLockReset, (TSS_InPrintFunction_t)DictionaryAttackLockReset_In_Print},
+#endif
+#if CC_DictionaryAttackParameters
     {TPM_CC_DictionaryAttackParameters, (TSS_InPrintFunction_t)DictionaryAttackParameters_In_Print},
+#endif
+#if CC_PP_Commands
     {TPM_CC_PP_Commands, (TSS_InPrintFunction_t)PP_Commands_In_Print},
+#endif
+#if CC_SetAlgorithmSet
     {TPM_CC_SetAlgorithmSet, (TSS_InPrintFunction_t)SetAlgorithmSet_In_Print},
+#endif
+#if CC_ContextSave
     {TPM_CC_ContextSave, (TSS_InPrintFunction_t)ContextSave_In_Print},
+#endif
+#if CC_ContextLoad
     {TPM_CC_ContextLoad, (TSS_InPrintFunction_t)ContextLoad_In_Print},
+#endif
+#if CC_FlushContext
     {TPM_CC_FlushContext, (TSS_InPrintFunction_t)FlushContext_In_Print},
+#endif
+#if CC_EvictControl
     {TPM_CC_EvictControl, (TSS_InPrintFunction_t)EvictControl_In_Print},
+#endif
+#if CC_ReadClock
     {TPM_CC_ReadClock, (TSS_InPrintFunction_t)NULL},
+#endif
+#if CC_ClockSet
     {TPM_CC_ClockSet, (TSS_InPrintFunction_t)ClockSet_In_Print},
+#endif
+#if CC_ClockRateAdjust
     {TPM_CC_ClockRateAdjust, (TSS_InPrintFunction_t)ClockRateAdjust_In_Print},
+#endif
+#if CC_GetCapability
     {TPM_CC_GetCapability, (TSS_InPrintFunction_t)GetCapability_In_Print},
+#endif
+#if CC_TestParms
     {TPM_CC_TestParms, (TSS_InPrintFunction_t)TestParms_In_Print},
+#endif
+#if CC_NV_DefineSpace
     {TPM_CC_NV_DefineSpace, (TSS_InPrintFunction_t)NV_DefineSpace_In_Print},
+#endif
+#if CC_NV_UndefineSpace
     {TPM_CC_NV_UndefineSpace, (TSS_InPrintFunction_t)NV_UndefineSpace_In_Print},
+#endif
+#if CC_NV_UndefineSpaceSpecial
     {TPM_CC_NV_UndefineSpaceSpecial, (TSS_InPrintFunction_t)NV_UndefineSpaceSpecial_In_Print},
+#endif
+#if CC_NV_ReadPublic
     {TPM_CC_NV_ReadPublic, (TSS_InPrintFunction_t)NV_ReadPublic_In_Print},
+#endif
+#if CC_NV_Write
     {TPM_CC_NV_Write, (TSS_InPrintFunction_t)NV_Write_In_Print},
+#endif
+#if CC_NV_Increment
     {TPM_CC_NV_Increment, (TSS_InPrintFunction_t)NV_Increment_In_Print},
+#endif
+#if CC_NV_Extend
     {TPM_CC_NV_Extend, (TSS_InPrintFunction_t)NV_Extend_In_Print},
+#endif
+#if CC_NV_SetBits
     {TPM_CC_NV_SetBits, (TSS_InPrintFunction_t)NV_SetBits_In_Print},
+#endif
+#if CC_NV_WriteLock
     {TPM_CC_NV_WriteLock, (TSS_InPrintFunction_t)NV_WriteLock_In_Print},
+#endif
+#if CC_NV_GlobalWriteLock
     {TPM_CC_NV_GlobalWriteLock, (TSS_InPrintFunction_t)NV_GlobalWriteLock_In_Print},
+#endif
+#if CC_NV_Read
     {TPM_CC_NV_Read, (TSS_InPrintFunction_t)NV_Read_In_Print},
+#endif
+#if CC_NV_ReadLock
     {TPM_CC_NV_ReadLock, (TSS_InPrintFunction_t)NV_ReadLock_In_Print},
+#endif
+#if CC_NV_ChangeAuth
     {TPM_CC_NV_ChangeAuth, (TSS_InPrintFunction_t)NV_ChangeAuth_In_Print},
+#endif
+#if CC_NV_Certify
     {TPM_CC_NV_Certify, (TSS_InPrintFunction_t)NV_Certify_In_Print}
+#endif
 };
 
 #endif /* TPM_TSS_NO_PRINT */
@@ -1043,12 +1886,15 @@ static void   TSS_HmacSession_InitContext(struct TSS_HMAC_CONTEXT *session);
 static void   TSS_HmacSession_FreeContext(struct TSS_HMAC_CONTEXT *session);
 
 #ifndef TPM_TSS_NOCRYPTO
+#if CC_StartAuthSession
 static TPM_RC TSS_HmacSession_SetSessionKey(TSS_CONTEXT *tssContext,
 					    struct TSS_HMAC_CONTEXT *session,
 					    TPM2B_DIGEST *salt,
 					    TPMI_DH_ENTITY bind,
 					    TPM2B_AUTH *bindAuthValue);
-static TPM_RC TSS_HmacSession_SetNonceCaller(struct TSS_HMAC_CONTEXT *session,
+#endif
+static TPM_RC TSS_HmacSession_SetNonceCaller(TSS_CONTEXT *tssContext,
+					     struct TSS_HMAC_CONTEXT *session,
 					     TPMS_AUTH_COMMAND 	*authC);
 static TPM_RC TSS_HmacSession_SetHmacKey(TSS_CONTEXT *tssContext,
 					 struct TSS_HMAC_CONTEXT *session,
@@ -1068,6 +1914,8 @@ static TPM_RC TSS_HmacSession_SetHMAC(TSS_AUTH_CONTEXT *tssAuthContext,
 static TPM_RC TSS_HmacSession_Verify(TSS_AUTH_CONTEXT *tssAuthContext,
 				     struct TSS_HMAC_CONTEXT *session,
 				     TPMS_AUTH_RESPONSE *authResponse);
+static TPM_RC TSS_HmacSession_AuditExtend(struct TSS_HMAC_CONTEXT *session,
+					  TPMT_HA *rpHash);
 #endif	/* TPM_TSS_NOCRYPTO */
 static TPM_RC TSS_HmacSession_Continue(TSS_CONTEXT *tssContext,
 				       struct TSS_HMAC_CONTEXT *session,
@@ -1090,7 +1938,7 @@ static TPM_RC TSS_HmacSession_LoadData(TSS_CONTEXT *tssContext,
 static TPM_RC TSS_HmacSession_DeleteData(TSS_CONTEXT *tssContext,
 					 TPMI_SH_AUTH_SESSION sessionHandle);
 static TPM_RC TSS_HmacSession_GetSlotForHandle(TSS_CONTEXT *tssContext,
-					       size_t *slotIndex,
+					       TSS_SESSIONS **session,
 					       TPMI_SH_AUTH_SESSION sessionHandle);
 #endif
 static TPM_RC TSS_HmacSession_Marshal(struct TSS_HMAC_CONTEXT *source,
@@ -1103,56 +1951,80 @@ static TPM_RC TSS_Name_GetAllNames(TSS_CONTEXT *tssContext,
 static TPM_RC TSS_Name_GetName(TSS_CONTEXT *tssContext,
 			       TPM2B_NAME *name,
 			       TPM_HANDLE  handle);
+#if TSS_CC_NAME_STORE
 static TPM_RC TSS_Name_Store(TSS_CONTEXT *tssContext,
 			     TPM2B_NAME *name,
 			     TPM_HANDLE handle,
 			     const char *string);
+#endif
 static TPM_RC TSS_Name_Load(TSS_CONTEXT *tssContext,
 			    TPM2B_NAME *name,
 			    TPM_HANDLE handle,
 			    const char *string);
+#if TSS_CC_COPY
 static TPM_RC TSS_Name_Copy(TSS_CONTEXT *tssContext,
 			    TPM_HANDLE outHandle,
 			    const char *outString,
 			    TPM_HANDLE inHandle,
 			    const char *inString);
+#endif
+#if TSS_CC_PUBLIC_STORE
 static TPM_RC TSS_Public_Store(TSS_CONTEXT *tssContext,
 			       TPM2B_PUBLIC *public,
 			       TPM_HANDLE handle,
 			       const char *string);
+#endif
+#if TSS_CC_COPY || (CC_StartAuthSession && !defined TPM_TSS_NOCRYPTO)
 static TPM_RC TSS_Public_Load(TSS_CONTEXT *tssContext,
 			      TPM2B_PUBLIC *public,
 			      TPM_HANDLE handle,
 			      const char *string);
+#endif
+#if TSS_CC_COPY
 static TPM_RC TSS_Public_Copy(TSS_CONTEXT *tssContext,
 			      TPM_HANDLE outHandle,
 			      const char *outString,
 			      TPM_HANDLE inHandle,
 			      const char *inString);
+#endif
 #ifdef TPM_TSS_NOFILE
 static TPM_RC TSS_ObjectPublic_GetSlotForHandle(TSS_CONTEXT *tssContext,
-						size_t *slotIndex,
+						TSS_OBJECT_PUBLIC **objectPublic,
 						TPM_HANDLE handle);
 static TPM_RC TSS_ObjectPublic_DeleteData(TSS_CONTEXT *tssContext, TPM_HANDLE handle);
 #endif
 static TPM_RC TSS_DeleteHandle(TSS_CONTEXT *tssContext,
 			       TPM_HANDLE handle);
+#ifndef TPM_TSS_NOFILE
+static TPM_RC TSS_HandleFilename(TSS_CONTEXT *tssContext,
+				 char *filename,
+				 const char *prefix,
+				 TPM_HANDLE handle);
+#endif
 #ifndef TPM_TSS_NOCRYPTO
+#if CC_ReadPublic
 static TPM_RC TSS_ObjectPublic_GetName(TPM2B_NAME *name,
 				       TPMT_PUBLIC *tpmtPublic);
+#endif
 
+#if TSS_CC_NV_STORE
 static TPM_RC TSS_NVPublic_Store(TSS_CONTEXT *tssContext,
 				 TPMS_NV_PUBLIC *nvPublic,
 				 TPMI_RH_NV_INDEX handle);
+#endif
+#if TSS_CC_NV_UPDATE
 static TPM_RC TSS_NVPublic_Load(TSS_CONTEXT *tssContext,
 				TPMS_NV_PUBLIC *nvPublic,
 				TPMI_RH_NV_INDEX handle);
 #endif
+#endif
+#if TSS_CC_NV_DELETE
 static TPM_RC TSS_NVPublic_Delete(TSS_CONTEXT *tssContext,
 				  TPMI_RH_NV_INDEX nvIndex);
+#endif
 #ifdef TPM_TSS_NOFILE
 static TPM_RC TSS_NvPublic_GetSlotForHandle(TSS_CONTEXT *tssContext,
-					    size_t *slotIndex,
+					    TSS_NVPUBLIC **nvPublic,
 					    TPMI_RH_NV_INDEX nvIndex);
 #endif
 
@@ -1206,14 +2078,22 @@ static TPM_RC TSS_Sessions_GetEncryptSession(unsigned int *isEncrypt,
 					     unsigned int sessionAttributes[]);
 
 #ifndef TPM_TSS_NOFILE
+#if CC_ContextSave || CC_ContextLoad
 static TPM_RC TSS_HashToString(char *str, uint8_t *digest);
 #endif
+#endif
 #ifndef TPM_TSS_NOCRYPTO
 #ifndef TPM_TSS_NORSA
-static TPM_RC TSS_RSA_Salt(TPM2B_DIGEST 		*salt,
+#if CC_StartAuthSession
+static TPM_RC TSS_RSA_Salt(TSS_CONTEXT 		*tssContext,
+			   TPM2B_DIGEST 		*salt,
 			   TPM2B_ENCRYPTED_SECRET	*encryptedSalt,
 			   TPMT_PUBLIC			*publicArea);
+#endif
 #endif /* TPM_TSS_NORSA */
+static TPM_RC TSS_RandNonce(TSS_CONTEXT *tssContext,
+			    uint8_t *buffer,
+			    uint16_t size);
 #endif /* TPM_TSS_NOCRYPTO */
 extern int tssVerbose;
 extern int tssVverbose;
@@ -1241,38 +2121,205 @@ TPM_RC TSS_Execute20(TSS_CONTEXT *tssContext,
     }
     /* handle any command specific command pre-processing */
     if (rc == 0) {
-	rc = TSS_Command_PreProcessor(tssContext,
-				      commandCode,
-				      in,
-				      extra);
+	rc = TSS_Command_PreProcessor(tssContext,
+				      commandCode,
+				      in,
+				      extra);
+    }
+    /* marshal input parameters */
+    if (rc == 0) {
+	if (tssVverbose) printf("TSS_Execute20: Command %08x marshal\n", commandCode);
+	rc = TSS_Marshal(tssContext->tssAuthContext,
+			 in,
+			 commandCode);
+    }
+    /* execute the command */
+    if (rc == 0) {
+	rc = TSS_Execute_valist(tssContext, in, ap);
+    }
+    /* unmarshal the response parameters */
+    if (rc == 0) {
+	if (tssVverbose) printf("TSS_Execute20: Command %08x unmarshal\n", commandCode);
+	rc = TSS_Unmarshal(tssContext->tssAuthContext, out);
+    }
+    /* handle any command specific response post-processing */
+    if (rc == 0) {
+	if (tssVverbose) printf("TSS_Execute20: Command %08x post processor\n", commandCode);
+	rc = TSS_Response_PostProcessor(tssContext,
+					in,
+					out,
+					extra);
+    }
+    return rc;
+}
+
+/* TSS_Prepare() marshals a command once, for repeated execution with TSS_ExecutePrepared().
+
+   Between executions, TSS_PreparedSetHandle() and TSS_PreparedSetParameter() can patch the
+   marshaled handles and parameters in place.  Authorizations, cpHash, HMACs, and parameter
+   encryption are calculated at each execution.
+
+   Commands with TSS pre-processing or post-processing, e.g., those that save names or session
+   state, cannot be prepared.
+
+   The caller must free the prepared command with TSS_PreparedDelete().
+*/
+
+TPM_RC TSS_Prepare(TSS_CONTEXT *tssContext,
+		   TSS_PREPARED **prepared,
+		   COMMAND_PARAMETERS *in,
+		   TPM_CC commandCode)
+{
+    TPM_RC		rc = 0;
+    size_t 		index;
+
+    if (rc == 0) {
+	*prepared = NULL;
+	/* the command must not need the TSS pre- or post-processing functions, which use the
+	   unmarshaled in structure */
+	for (index = 0 ; index < (sizeof(tssTable) / sizeof(TSS_TABLE)) ; index++) {
+	    if (tssTable[index].commandCode == commandCode) {
+		if ((tssTable[index].preProcessFunction != NULL) ||
+		    (tssTable[index].changeAuthFunction != NULL) ||
+		    (tssTable[index].postProcessFunction != NULL)) {
+		    if (tssVerbose) printf("TSS_Prepare: Command %08x cannot be prepared\n",
+					   commandCode);
+		    rc = TSS_RC_PREPARE_UNSUPPORTED;
+		}
+		break;
+	    }
+	}
+    }
+#ifdef TPM_TSS_NODEPRECATEDALGS
+    if (rc == 0) {
+	rc = TSS_Command_CheckParameters(commandCode, in);
+    }
+#endif
+    if (rc == 0) {
+	rc = TSS_Malloc((uint8_t **)prepared, sizeof(TSS_PREPARED));
+    }
+    if (rc == 0) {
+	(*prepared)->commandBuffer = NULL;
+	rc = TSS_AuthSizeBuffers(tssContext, FALSE);	/* no TPM, see TSS_ExecutePrepared() */
+    }
+    if (rc == 0) {
+	TSS_InitAuthContext(tssContext->tssAuthContext);
+	if (tssVverbose) printf("TSS_Prepare: Command %08x marshal\n", commandCode);
+	rc = TSS_Marshal(tssContext->tssAuthContext,
+			 in,
+			 commandCode);
+    }
+    if (rc == 0) {
+	rc = TSS_AuthSave(*prepared, tssContext->tssAuthContext);
+    }
+    if ((rc != 0) && (*prepared != NULL)) {
+	TSS_PreparedDelete(*prepared);
+	*prepared = NULL;
+    }
+    return rc;
+}
+
+/* TSS_PreparedSetHandle() replaces the command handle at the zero based index */
+
+TPM_RC TSS_PreparedSetHandle(TSS_PREPARED *prepared,
+			     size_t index,
+			     TPM_HANDLE handle)
+{
+    TPM_RC	rc = 0;
+    uint8_t 	*buffer;
+    uint16_t 	written = 0;
+
+    if (rc == 0) {
+	if (index >= prepared->authContext.commandHandleCount) {
+	    if (tssVerbose) printf("TSS_PreparedSetHandle: index %u too large for command\n",
+				   (unsigned int)index);
+	    rc = TSS_RC_BAD_HANDLE_NUMBER;
+	}
+    }
+    if (rc == 0) {
+	buffer = prepared->commandBuffer +
+		 sizeof(TPMI_ST_COMMAND_TAG) + sizeof (uint32_t) + sizeof(TPM_CC) +
+		 (sizeof(TPM_HANDLE) * index);
+	rc = TSS_TPM_HANDLE_Marshalu(&handle, &written, &buffer, NULL);
+    }
+    return rc;
+}
+
+/* TSS_PreparedSetParameter() replaces the marshaled command parameters from 'offset' bytes after
+   the handles through the end of the parameters.
+
+   'length' must equal the originally marshaled length from 'offset', so the command size cannot
+   change.  E.g., to replace all parameters, offset is 0 and data is the newly marshaled parameter
+   area.  To replace a later parameter, re-marshal it and the parameters that follow it.
+*/
+
+TPM_RC TSS_PreparedSetParameter(TSS_PREPARED *prepared,
+				uint32_t offset,
+				const uint8_t *data,
+				uint32_t length)
+{
+    TPM_RC	rc = 0;
+
+    if (rc == 0) {
+	if ((offset > prepared->authContext.cpBufferSize) ||
+	    (length != (prepared->authContext.cpBufferSize - offset))) {
+	    if (tssVerbose)
+		printf("TSS_PreparedSetParameter: offset %u length %u, marshaled parameters %u\n",
+		       offset, length, prepared->authContext.cpBufferSize);
+	    rc = TSS_RC_PREPARE_SIZE;
+	}
+    }
+    if (rc == 0) {
+	memcpy(prepared->commandBuffer + prepared->cpOffset + offset, data, length);
+    }
+    return rc;
+}
+
+/* TSS_ExecutePrepared() executes a command prepared by TSS_Prepare().
+
+   The varargs are the same as for TSS_Execute().
+*/
+
+TPM_RC TSS_ExecutePrepared(TSS_CONTEXT *tssContext,
+			   RESPONSE_PARAMETERS *out,
+			   TSS_PREPARED *prepared,
+			   ...)
+{
+    TPM_RC		rc = 0;
+    va_list		ap;
+
+    if (rc == 0) {
+	tssContext->tpm12Command = FALSE;
+	rc = TSS_AuthSizeBuffers(tssContext, TRUE);
     }
-    /* marshal input parameters */
+    /* restore the marshaled command rather than marshaling again */
     if (rc == 0) {
-	if (tssVverbose) printf("TSS_Execute20: Command %08x marshal\n", commandCode);
-	rc = TSS_Marshal(tssContext->tssAuthContext,
-			 in,
-			 commandCode);
+	rc = TSS_AuthRestore(tssContext->tssAuthContext, prepared);
     }
-    /* execute the command */
     if (rc == 0) {
-	rc = TSS_Execute_valist(tssContext, in, ap);
+	va_start(ap, prepared);
+	rc = TSS_Execute_valist(tssContext, NULL, ap);
+	va_end(ap);
     }
-    /* unmarshal the response parameters */
     if (rc == 0) {
-	if (tssVverbose) printf("TSS_Execute20: Command %08x unmarshal\n", commandCode);
+	if (tssVverbose) printf("TSS_ExecutePrepared: Command %08x unmarshal\n",
+				prepared->authContext.commandCode);
 	rc = TSS_Unmarshal(tssContext->tssAuthContext, out);
     }
-    /* handle any command specific response post-processing */
-    if (rc == 0) {
-	if (tssVverbose) printf("TSS_Execute20: Command %08x post processor\n", commandCode);
-	rc = TSS_Response_PostProcessor(tssContext,
-					in,
-					out,
-					extra);
-    }
     return rc;
 }
 
+/* TSS_PreparedDelete() frees a command prepared by TSS_Prepare() */
+
+TPM_RC TSS_PreparedDelete(TSS_PREPARED *prepared)
+{
+    if (prepared != NULL) {
+	free(prepared->commandBuffer);
+	free(prepared);
+    }
+    return 0;
+}
+
 /* TSS_Execute_valist() transmits the marshaled command and receives the marshaled response.
 
    varargs are TPMI_SH_AUTH_SESSION sessionHandle, const char *password, unsigned int
@@ -1412,7 +2459,7 @@ static TPM_RC TSS_Execute_valist(TSS_CONTEXT *tssContext,
 	    if (tssVverbose)
 		printf("TSS_Execute_valist: Step 3: nonceCaller %08x\n", sessionHandle[i]);
 #ifndef TPM_TSS_NOCRYPTO
-	    rc = TSS_HmacSession_SetNonceCaller(session[i], authC[i]);
+	    rc = TSS_HmacSession_SetNonceCaller(tssContext, session[i], authC[i]);
 #else
 	    authC[i]->nonce.b.size = 16;
 	    memset(&authC[i]->nonce.b.buffer, 0, 16);
@@ -1658,11 +2705,16 @@ static void TSS_HmacSession_InitContext(struct TSS_HMAC_CONTEXT *session)
     session->sessionType = 0;
     session->isPasswordNeeded = FALSE;
     session->isAuthValueNeeded = FALSE;
+#ifndef TPM_TSS_NOCRYPTO
+    session->auditDigest.b.size = 0;
+#endif
     memset(session->hmacKey.t.buffer, 0, sizeof(TPMU_HA) + sizeof(TPMU_HA));
     session->hmacKey.b.size = 0;
 #ifndef TPM_TSS_NOCRYPTO
     memset(session->sessionValue.t.buffer, 0, sizeof(TPMU_HA) + sizeof(TPMU_HA));
     session->sessionValue.b.size = 0;
+    session->auditAttributes = 0;
+    session->auditCpHash.b.size = 0;
 #endif
 }
 
@@ -1683,6 +2735,7 @@ void TSS_HmacSession_FreeContext(struct TSS_HMAC_CONTEXT *session)
 
 #ifndef TPM_TSS_NOCRYPTO
 
+#if CC_StartAuthSession
 static TPM_RC TSS_HmacSession_SetSessionKey(TSS_CONTEXT *tssContext,
 					    struct TSS_HMAC_CONTEXT *session,
 					    TPM2B_DIGEST *salt,
@@ -1743,6 +2796,7 @@ static TPM_RC TSS_HmacSession_SetSessionKey(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 #endif	/* TPM_TSS_NOCRYPTO */
 
@@ -1795,13 +2849,12 @@ static TPM_RC TSS_HmacSession_SaveSession(TSS_CONTEXT *tssContext,
     /* save the session in a hard coded file name hxxxxxxxx.bin where xxxxxxxx is the session
        handle */
     if (rc == 0) {
-	sprintf(sessionFilename, "%s/h%08x.bin",
-		tssContext->tssDataDirectory, session->sessionHandle);
+	rc = TSS_HandleFilename(tssContext, sessionFilename, "h", session->sessionHandle);
     }
     if (rc == 0) {
-	rc = TSS_File_WriteBinaryFile(outBuffer,
-				      outLength,
-				      sessionFilename);
+	rc = TSS_File_ReplaceBinaryFile(outBuffer,
+					outLength,
+					sessionFilename);
     }
     if (tssContext->tssEncryptSessions) {
 	free(outBuffer);	/* @2 */
@@ -1842,7 +2895,9 @@ static TPM_RC TSS_HmacSession_LoadSession(TSS_CONTEXT *tssContext,
     /* load the session from a hard coded file name hxxxxxxxx.bin where xxxxxxxx is the session
        handle */
     if (rc == 0) {
-	sprintf(sessionFilename, "%s/h%08x.bin", tssContext->tssDataDirectory, sessionHandle);
+	rc = TSS_HandleFilename(tssContext, sessionFilename, "h", sessionHandle);
+    }
+    if (rc == 0) {
 	rc = TSS_File_ReadBinaryFile(&buffer,     /* freed @1 */
 				     &length,
 				     sessionFilename);
@@ -1894,31 +2949,26 @@ static TPM_RC TSS_HmacSession_SaveData(TSS_CONTEXT *tssContext,
 				       uint32_t outLength,
 				       uint8_t *outBuffer)
 {
-    TPM_RC	rc = 0;
-    size_t	slotIndex;
+    TPM_RC		rc = 0;
+    TSS_SESSIONS	*session = NULL;
 
     /* if this handle is already used, overwrite the slot */
     if (rc == 0) {
-	rc = TSS_HmacSession_GetSlotForHandle(tssContext, &slotIndex, sessionHandle);
+	rc = TSS_HandleTable_Add(&tssContext->sessions, (void **)&session,
+				 sessionHandle, sizeof(TSS_SESSIONS));
 	if (rc != 0) {
-	    rc = TSS_HmacSession_GetSlotForHandle(tssContext, &slotIndex, TPM_RH_NULL);
-	    if (rc == 0) {
-		tssContext->sessions[slotIndex].sessionHandle = sessionHandle;
-	    }
-	    else {
-		if (tssVerbose)
-		    printf("TSS_HmacSession_SaveData: Error, no slot available for handle %08x\n",
-			   sessionHandle);
-	    }
+	    if (tssVerbose)
+		printf("TSS_HmacSession_SaveData: Error, no slot available for handle %08x\n",
+		       sessionHandle);
 	}
     }
     /* reallocate memory and adjust the size */
     if (rc == 0) {
-	rc = TSS_Realloc(&tssContext->sessions[slotIndex].sessionData, outLength);
+	rc = TSS_Realloc(&session->sessionData, outLength);
     }
     if (rc == 0) {
-	tssContext->sessions[slotIndex].sessionDataLength = outLength;
-	memcpy(tssContext->sessions[slotIndex].sessionData, outBuffer, outLength);
+	session->sessionDataLength = outLength;
+	memcpy(session->sessionData, outBuffer, outLength);
     }
     return rc;
 }
@@ -1927,11 +2977,11 @@ static TPM_RC TSS_HmacSession_LoadData(TSS_CONTEXT *tssContext,
 				       uint32_t *inLength, uint8_t **inData,
 				       TPMI_SH_AUTH_SESSION sessionHandle)
 {
-    TPM_RC	rc = 0;
-    size_t	slotIndex;
+    TPM_RC		rc = 0;
+    TSS_SESSIONS	*session = NULL;
 
     if (rc == 0) {
-	rc = TSS_HmacSession_GetSlotForHandle(tssContext, &slotIndex, sessionHandle);
+	rc = TSS_HmacSession_GetSlotForHandle(tssContext, &session, sessionHandle);
 	if (rc != 0) {
 	    if (tssVerbose)
 		printf("TSS_HmacSession_LoadData: Error, no slot found for handle %08x\n",
@@ -1939,8 +2989,8 @@ static TPM_RC TSS_HmacSession_LoadData(TSS_CONTEXT *tssContext,
 	}
     }
     if (rc == 0) {
-	*inLength = tssContext->sessions[slotIndex].sessionDataLength;
-	*inData = tssContext->sessions[slotIndex].sessionData;
+	*inLength = session->sessionDataLength;
+	*inData = session->sessionData;
     }
     return rc;
 }
@@ -1948,25 +2998,23 @@ static TPM_RC TSS_HmacSession_LoadData(TSS_CONTEXT *tssContext,
 static TPM_RC TSS_HmacSession_DeleteData(TSS_CONTEXT *tssContext,
 					 TPMI_SH_AUTH_SESSION sessionHandle)
 {
-    TPM_RC	rc = 0;
-    size_t	slotIndex;
+    TPM_RC		rc = 0;
+    TSS_SESSIONS	*session = NULL;
 
     if (rc == 0) {
-	rc = TSS_HmacSession_GetSlotForHandle(tssContext, &slotIndex, sessionHandle);
-	if (rc != 0) {
+	session = TSS_HandleTable_Remove(&tssContext->sessions, sessionHandle);
+	if (session == NULL) {
 	    if (tssVerbose)
 		printf("TSS_HmacSession_DeleteData: Error, no slot found for handle %08x\n",
 		       sessionHandle);
+	    rc = TSS_RC_NO_SESSION_SLOT;
 	}
     }    
     if (rc == 0) {
-	tssContext->sessions[slotIndex].sessionHandle = TPM_RH_NULL;
 	/* erase any secrets */
-	memset(tssContext->sessions[slotIndex].sessionData, 0,
-	       tssContext->sessions[slotIndex].sessionDataLength);
-	free(tssContext->sessions[slotIndex].sessionData);
-	tssContext->sessions[slotIndex].sessionData = NULL;
-	tssContext->sessions[slotIndex].sessionDataLength = 0;
+	memset(session->sessionData, 0, session->sessionDataLength);
+	free(session->sessionData);
+	free(session);
     }
     return rc;
 }
@@ -1977,19 +3025,14 @@ static TPM_RC TSS_HmacSession_DeleteData(TSS_CONTEXT *tssContext,
 */
 
 static TPM_RC TSS_HmacSession_GetSlotForHandle(TSS_CONTEXT *tssContext,
-					       size_t *slotIndex,
+					       TSS_SESSIONS **session,
 					       TPMI_SH_AUTH_SESSION sessionHandle)
 {
-    size_t 	i;
-
-    /* search all slots for handle */
-    for (i = 0 ; i < (sizeof(tssContext->sessions) / sizeof(TSS_SESSIONS)) ; i++) {
-	if (tssContext->sessions[i].sessionHandle == sessionHandle) {
-	    *slotIndex = i;
-	    return 0;
-	}
+    *session = TSS_HandleTable_Find(&tssContext->sessions, sessionHandle);
+    if (*session == NULL) {
+	return TSS_RC_NO_SESSION_SLOT;
     }
-    return TSS_RC_NO_SESSION_SLOT;
+    return 0;
 }
 
 #endif
@@ -2048,6 +3091,11 @@ static TPM_RC TSS_HmacSession_Marshal(struct TSS_HMAC_CONTEXT *source,
     if (rc == 0) {
 	rc = TSS_UINT8_Marshalu(&source->isAuthValueNeeded, written, buffer, size);
     }  
+#ifndef TPM_TSS_NOCRYPTO
+    if (rc == 0) {
+	rc = TSS_TPM2B_DIGEST_Marshalu(&source->auditDigest, written, buffer, size);
+    }
+#endif
     return rc;
 }
 
@@ -2099,6 +3147,17 @@ static TPM_RC TSS_HmacSession_Unmarshal(struct TSS_HMAC_CONTEXT *target,
     if (rc == 0) {
 	rc = TSS_UINT8_Unmarshalu(&target->isAuthValueNeeded, buffer, size);
     }
+#ifndef TPM_TSS_NOCRYPTO
+    /* a session saved by an earlier TSS release has no audit digest */
+    if (rc == 0) {
+	if (*size != 0) {
+	    rc = TSS_TPM2B_DIGEST_Unmarshalu(&target->auditDigest, buffer, size);
+	}
+	else {
+	    target->auditDigest.t.size = 0;
+	}
+    }
+#endif
     return rc;
 }
 
@@ -2191,6 +3250,7 @@ static TPM_RC TSS_Name_GetName(TSS_CONTEXT *tssContext,
 
 #ifndef TPM_TSS_NOFILE
 
+#if TSS_CC_NAME_STORE
 static TPM_RC TSS_Name_Store(TSS_CONTEXT *tssContext,
 			     TPM2B_NAME *name,
 			     TPM_HANDLE handle,
@@ -2202,7 +3262,7 @@ static TPM_RC TSS_Name_Store(TSS_CONTEXT *tssContext,
     if (rc == 0) {
 	if (string == NULL) {
 	    if (handle != 0) {
-		sprintf(nameFilename, "%s/h%08x.bin", tssContext->tssDataDirectory, handle);
+		rc = TSS_HandleFilename(tssContext, nameFilename, "h", handle);
 	    }
 	    else {
 		if (tssVerbose) printf("TSS_Name_Store: handle and string are both null");
@@ -2221,10 +3281,11 @@ static TPM_RC TSS_Name_Store(TSS_CONTEXT *tssContext,
     }
     if (rc == 0) {
 	if (tssVverbose) printf("TSS_Name_Store: File %s\n", nameFilename);
-	rc = TSS_File_WriteBinaryFile(name->b.buffer, name->b.size, nameFilename);
+	rc = TSS_File_ReplaceBinaryFile(name->b.buffer, name->b.size, nameFilename);
     }
     return rc;
 }
+#endif
 
 #endif
 
@@ -2248,7 +3309,7 @@ static TPM_RC TSS_Name_Load(TSS_CONTEXT *tssContext,
     if (rc == 0) {
 	if (string == NULL) {
 	    if (handle != 0) {
-		sprintf(nameFilename, "%s/h%08x.bin", tssContext->tssDataDirectory, handle);
+		rc = TSS_HandleFilename(tssContext, nameFilename, "h", handle);
 	    }
 	    else {
 		if (tssVerbose) printf("TSS_Name_Load: handle and string are both null\n");
@@ -2282,14 +3343,16 @@ static TPM_RC TSS_Name_Load(TSS_CONTEXT *tssContext,
 
 #ifdef TPM_TSS_NOFILE
 
+#if TSS_CC_NAME_STORE
 static TPM_RC TSS_Name_Store(TSS_CONTEXT *tssContext,
 			     TPM2B_NAME *name,
 			     TPM_HANDLE handle,
 			     const char *string)
 {
-    TPM_RC 	rc = 0;
-    TPM_HT 	handleType;
-    size_t	slotIndex;
+    TPM_RC 		rc = 0;
+    TPM_HT 		handleType;
+    TSS_NVPUBLIC	*nvPublic = NULL;
+    TSS_OBJECT_PUBLIC	*objectPublic = NULL;
 
     if (tssVverbose) printf("TSS_Name_Store: Handle %08x\n", handle);
     handleType = (TPM_HT) ((handle & HR_RANGE_MASK) >> HR_SHIFT);
@@ -2297,19 +3360,14 @@ static TPM_RC TSS_Name_Store(TSS_CONTEXT *tssContext,
     switch (handleType) {
       case TPM_HT_NV_INDEX:
 	/* for NV, the Name was returned at creation */
-	rc = TSS_NvPublic_GetSlotForHandle(tssContext, &slotIndex, handle);
+	rc = TSS_HandleTable_Add(&tssContext->nvPublic, (void **)&nvPublic,
+				 handle, sizeof(TSS_NVPUBLIC));
 	if (rc != 0) {
-	    rc = TSS_NvPublic_GetSlotForHandle(tssContext, &slotIndex, TPM_RH_NULL);
-	    if (rc == 0) {
-		tssContext->nvPublic[slotIndex].nvIndex = handle;
-	    }
-	    else {
-		if (tssVerbose)
-		    printf("TSS_Name_Store: Error, no slot available for handle %08x\n", handle);
-	    }
+	    if (tssVerbose)
+		printf("TSS_Name_Store: Error, no slot available for handle %08x\n", handle);
 	}
 	if (rc == 0) {
-	    tssContext->nvPublic[slotIndex].name = *name;
+	    nvPublic->name = *name;
 	}
 	break;
       case TPM_HT_TRANSIENT:
@@ -2318,18 +3376,13 @@ static TPM_RC TSS_Name_Store(TSS_CONTEXT *tssContext,
 	    if (string == NULL) {
 		if (handle != 0) {
 		    /* if this handle is already used, overwrite the slot */
-		    rc = TSS_ObjectPublic_GetSlotForHandle(tssContext, &slotIndex, handle);
+		    rc = TSS_HandleTable_Add(&tssContext->objectPublic, (void **)&objectPublic,
+					     handle, sizeof(TSS_OBJECT_PUBLIC));
 		    if (rc != 0) {
-			rc = TSS_ObjectPublic_GetSlotForHandle(tssContext, &slotIndex, TPM_RH_NULL);
-			if (rc == 0) {
-			    tssContext->objectPublic[slotIndex].objectHandle = handle;
-			}
-			else {
-			    if (tssVerbose)
-				printf("TSS_Name_Store: "
-				       "Error, no slot available for handle %08x\n",
-				       handle);
-			}
+			if (tssVerbose)
+			    printf("TSS_Name_Store: "
+				   "Error, no slot available for handle %08x\n",
+				   handle);
 		    }
 		}
 		else {
@@ -2349,7 +3402,7 @@ static TPM_RC TSS_Name_Store(TSS_CONTEXT *tssContext,
 	    }
 	}
 	if (rc == 0) {
-	    tssContext->objectPublic[slotIndex].name = *name;
+	    objectPublic->name = *name;
 	}
 	break;
       default:
@@ -2358,6 +3411,7 @@ static TPM_RC TSS_Name_Store(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 #endif
 
@@ -2372,9 +3426,10 @@ static TPM_RC TSS_Name_Load(TSS_CONTEXT *tssContext,
 			    TPM_HANDLE handle,
 			    const char *string)
 {
-    TPM_RC 	rc = 0;
-    TPM_HT 	handleType;
-    size_t	slotIndex;
+    TPM_RC 		rc = 0;
+    TPM_HT 		handleType;
+    TSS_NVPUBLIC	*nvPublic = NULL;
+    TSS_OBJECT_PUBLIC	*objectPublic = NULL;
 
     string = string;
     
@@ -2383,24 +3438,24 @@ static TPM_RC TSS_Name_Load(TSS_CONTEXT *tssContext,
 
     switch (handleType) {
       case TPM_HT_NV_INDEX:
-	rc = TSS_NvPublic_GetSlotForHandle(tssContext, &slotIndex, handle);
+	rc = TSS_NvPublic_GetSlotForHandle(tssContext, &nvPublic, handle);
 	if (rc != 0) {
 	    if (tssVerbose)
 		printf("TSS_Name_Load: Error, no slot found for handle %08x\n", handle);
 	}
 	if (rc == 0) {
-	    *name = tssContext->nvPublic[slotIndex].name;
+	    *name = nvPublic->name;
 	}
 	break;
       case TPM_HT_TRANSIENT:
       case TPM_HT_PERSISTENT:
-	rc = TSS_ObjectPublic_GetSlotForHandle(tssContext, &slotIndex, handle);
+	rc = TSS_ObjectPublic_GetSlotForHandle(tssContext, &objectPublic, handle);
 	if (rc != 0) {
 	    if (tssVerbose)
 		printf("TSS_Name_Load: Error, no slot found for handle %08x\n", handle);
 	}
 	if (rc == 0) {
-	    *name = tssContext->objectPublic[slotIndex].name;
+	    *name = objectPublic->name;
 	}
 	break;
       default:
@@ -2416,6 +3471,7 @@ static TPM_RC TSS_Name_Load(TSS_CONTEXT *tssContext,
 /* TSS_Name_Copy() copies the name from either inHandle or inString to either outHandle or
    outString */
 
+#if TSS_CC_COPY
 static TPM_RC TSS_Name_Copy(TSS_CONTEXT *tssContext,
 			    TPM_HANDLE outHandle,
 			    const char *outString,
@@ -2433,6 +3489,7 @@ static TPM_RC TSS_Name_Copy(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 /* TSS_Public_Store() stores the 'public' parameter in a file.
 
@@ -2443,6 +3500,7 @@ static TPM_RC TSS_Name_Copy(TSS_CONTEXT *tssContext,
 
 #ifndef TPM_TSS_NOFILE
 
+#if TSS_CC_PUBLIC_STORE
 static TPM_RC TSS_Public_Store(TSS_CONTEXT *tssContext,
 			       TPM2B_PUBLIC *public,
 			       TPM_HANDLE handle,
@@ -2454,7 +3512,7 @@ static TPM_RC TSS_Public_Store(TSS_CONTEXT *tssContext,
     if (rc == 0) {
 	if (string == NULL) {
 	    if (handle != 0) {		/* store by handle */
-		sprintf(publicFilename, "%s/hp%08x.bin", tssContext->tssDataDirectory, handle);
+		rc = TSS_HandleFilename(tssContext, publicFilename, "hp", handle);
 	    }
 	    else {
 		if (tssVerbose) printf("TSS_Public_Store: handle and string are both null");
@@ -2473,12 +3531,13 @@ static TPM_RC TSS_Public_Store(TSS_CONTEXT *tssContext,
     }
     if (rc == 0) {
 	if (tssVverbose) printf("TSS_Public_Store: File %s\n", publicFilename);
-	rc = TSS_File_WriteStructure(public,
-				     (MarshalFunction_t)TSS_TPM2B_PUBLIC_Marshalu,
-				     publicFilename);
+	rc = TSS_File_ReplaceStructure(public,
+				       (MarshalFunction_t)TSS_TPM2B_PUBLIC_Marshalu,
+				       publicFilename);
     }
     return rc;
 }
+#endif
 
 #endif
 
@@ -2491,6 +3550,7 @@ static TPM_RC TSS_Public_Store(TSS_CONTEXT *tssContext,
    
 #ifndef TPM_TSS_NOFILE
 
+#if TSS_CC_COPY || (CC_StartAuthSession && !defined TPM_TSS_NOCRYPTO)
 static TPM_RC TSS_Public_Load(TSS_CONTEXT *tssContext,
 			      TPM2B_PUBLIC *public,
 			      TPM_HANDLE handle,
@@ -2502,7 +3562,7 @@ static TPM_RC TSS_Public_Load(TSS_CONTEXT *tssContext,
     if (rc == 0) {
 	if (string == NULL) {
 	    if (handle != 0) {
-		sprintf(publicFilename, "%s/hp%08x.bin", tssContext->tssDataDirectory, handle);
+		rc = TSS_HandleFilename(tssContext, publicFilename, "hp", handle);
 	    }
 	    else {
 		if (tssVerbose) printf("TSS_Public_Load: handle and string are both null\n");
@@ -2528,12 +3588,14 @@ static TPM_RC TSS_Public_Load(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 #endif 	/* TPM_TSS_NOFILE */
 
 /* TSS_Public_Copy() copies the TPM2B_PUBLIC from either inHandle or inString to either outHandle or
    outString */
 
+#if TSS_CC_COPY
 static TPM_RC TSS_Public_Copy(TSS_CONTEXT *tssContext,
 			      TPM_HANDLE outHandle,
 			      const char *outString,
@@ -2551,35 +3613,32 @@ static TPM_RC TSS_Public_Copy(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 /* TSS_Public_Store() stores the 'public' parameter in the TSS context. 
  */
    
 #ifdef TPM_TSS_NOFILE
 
+#if TSS_CC_PUBLIC_STORE
 static TPM_RC TSS_Public_Store(TSS_CONTEXT *tssContext,
 			       TPM2B_PUBLIC *public,
 			       TPM_HANDLE handle,
 			       const char *string)
 {
-    TPM_RC 	rc = 0;
-    size_t	slotIndex;
+    TPM_RC 		rc = 0;
+    TSS_OBJECT_PUBLIC	*objectPublic = NULL;
 
     if (rc == 0) {
 	if (string == NULL) {
 	    if (handle != 0) {
 		/* if this handle is already used, overwrite the slot */
-		rc = TSS_ObjectPublic_GetSlotForHandle(tssContext, &slotIndex, handle);
+		rc = TSS_HandleTable_Add(&tssContext->objectPublic, (void **)&objectPublic,
+					 handle, sizeof(TSS_OBJECT_PUBLIC));
 		if (rc != 0) {
-		    rc = TSS_ObjectPublic_GetSlotForHandle(tssContext, &slotIndex, TPM_RH_NULL);
-		    if (rc == 0) {
-			tssContext->objectPublic[slotIndex].objectHandle = handle;
-		    }
-		    else {
-			if (tssVerbose)
-			    printf("TSS_Public_Store: Error, no slot available for handle %08x\n",
-				   handle);
-		    }
+		    if (tssVerbose)
+			printf("TSS_Public_Store: Error, no slot available for handle %08x\n",
+			       handle);
 		}
 	    }
 	    else {
@@ -2599,10 +3658,11 @@ static TPM_RC TSS_Public_Store(TSS_CONTEXT *tssContext,
 	}
     }
     if (rc == 0) {
-	tssContext->objectPublic[slotIndex].objectPublic = *public;
+	objectPublic->objectPublic = *public;
     }
     return rc;
 }
+#endif
 
 #endif
 
@@ -2612,18 +3672,19 @@ static TPM_RC TSS_Public_Store(TSS_CONTEXT *tssContext,
    
 #ifdef TPM_TSS_NOFILE
 
+#if TSS_CC_COPY || (CC_StartAuthSession && !defined TPM_TSS_NOCRYPTO)
 static TPM_RC TSS_Public_Load(TSS_CONTEXT *tssContext,
 			      TPM2B_PUBLIC *public,
 			      TPM_HANDLE handle,
 			      const char *string)
 {
-    TPM_RC 	rc = 0;
-    size_t	slotIndex;
+    TPM_RC 		rc = 0;
+    TSS_OBJECT_PUBLIC	*objectPublic = NULL;
 		
     if (rc == 0) {
 	if (string == NULL) {
 	    if (handle != 0) {
-		rc = TSS_ObjectPublic_GetSlotForHandle(tssContext, &slotIndex, handle);
+		rc = TSS_ObjectPublic_GetSlotForHandle(tssContext, &objectPublic, handle);
 		if (rc != 0) {
 		    if (tssVerbose)
 			printf("TSS_Public_Load: Error, no slot found for handle %08x\n",
@@ -2647,10 +3708,11 @@ static TPM_RC TSS_Public_Load(TSS_CONTEXT *tssContext,
 	}
     }
     if (rc == 0) {
-	*public = tssContext->objectPublic[slotIndex].objectPublic;
+	*public = objectPublic->objectPublic;
     }
     return rc;
 }
+#endif
 
 #endif 	/* TPM_TSS_NOFILE */
 
@@ -2662,19 +3724,14 @@ static TPM_RC TSS_Public_Load(TSS_CONTEXT *tssContext,
 */
 
 static TPM_RC TSS_ObjectPublic_GetSlotForHandle(TSS_CONTEXT *tssContext,
-						size_t *slotIndex,
+						TSS_OBJECT_PUBLIC **objectPublic,
 						TPM_HANDLE handle)
 {
-    size_t 	i;
-
-    /* search all slots for handle */
-    for (i = 0 ; i < (sizeof(tssContext->sessions) / sizeof(TSS_SESSIONS)) ; i++) {
-	if (tssContext->objectPublic[i].objectHandle == handle) {
-	    *slotIndex = i;
-	    return 0;
-	}
+    *objectPublic = TSS_HandleTable_Find(&tssContext->objectPublic, handle);
+    if (*objectPublic == NULL) {
+	return TSS_RC_NO_OBJECTPUBLIC_SLOT;
     }
-    return TSS_RC_NO_OBJECTPUBLIC_SLOT;
+    return 0;
 }	
 
 #endif
@@ -2683,19 +3740,20 @@ static TPM_RC TSS_ObjectPublic_GetSlotForHandle(TSS_CONTEXT *tssContext,
 
 static TPM_RC TSS_ObjectPublic_DeleteData(TSS_CONTEXT *tssContext, TPM_HANDLE handle)
 {
-    TPM_RC	rc = 0;
-    size_t	slotIndex;
+    TPM_RC		rc = 0;
+    TSS_OBJECT_PUBLIC	*objectPublic = NULL;
 
     if (rc == 0) {
-	rc = TSS_ObjectPublic_GetSlotForHandle(tssContext, &slotIndex, handle);
-	if (rc != 0) {
+	objectPublic = TSS_HandleTable_Remove(&tssContext->objectPublic, handle);
+	if (objectPublic == NULL) {
 	    if (tssVerbose)
 		printf("TSS_ObjectPublic_DeleteData: Error, no slot found for handle %08x\n",
 		       handle);
+	    rc = TSS_RC_NO_OBJECTPUBLIC_SLOT;
 	}
     }    
     if (rc == 0) {
-	tssContext->objectPublic[slotIndex].objectHandle = TPM_RH_NULL;
+	free(objectPublic);
     }
     return rc;
 }
@@ -2703,6 +3761,40 @@ static TPM_RC TSS_ObjectPublic_DeleteData(TSS_CONTEXT *tssContext, TPM_HANDLE ha
 #endif
 
 
+/* TSS_HandleFilename() builds the file name for the state that the TSS retains for a handle,
+   <directory>/<prefix>xxxxxxxx.bin.  filename must be TPM_DATA_DIR_PATH_LENGTH bytes.
+
+   Session and transient object handles are only meaningful to one TPM connection (especially
+   through a resource manager), so their state goes in the session directory, see
+   TSS_GetSessionDirectory().  Persistent object and NV index state goes in the data directory,
+   where it is shared.
+*/
+
+#ifndef TPM_TSS_NOFILE
+
+static TPM_RC TSS_HandleFilename(TSS_CONTEXT *tssContext,
+				 char *filename,
+				 const char *prefix,
+				 TPM_HANDLE handle)
+{
+    TPM_RC		rc = 0;
+    TPM_HT 		handleType;
+    const char		*directory = tssContext->tssDataDirectory;
+
+    handleType = (TPM_HT) ((handle & HR_RANGE_MASK) >> HR_SHIFT);
+    if ((handleType == TPM_HT_HMAC_SESSION) ||
+	(handleType == TPM_HT_POLICY_SESSION) ||
+	(handleType == TPM_HT_TRANSIENT)) {
+	rc = TSS_GetSessionDirectory(tssContext, &directory);
+    }
+    if (rc == 0) {
+	sprintf(filename, "%s/%s%08x.bin", directory, prefix, handle);
+    }
+    return rc;
+}
+
+#endif
+
 /* TSS_DeleteHandle() removes retained state stored by the TSS for a handle 
  */
 
@@ -2719,7 +3811,9 @@ static TPM_RC TSS_DeleteHandle(TSS_CONTEXT *tssContext,
 #ifndef TPM_TSS_NOFILE
     /* delete the Name */
     if (rc == 0) {
-	sprintf(filename, "%s/h%08x.bin", tssContext->tssDataDirectory, handle);
+	rc = TSS_HandleFilename(tssContext, filename, "h", handle);
+    }
+    if (rc == 0) {
 	if (tssVverbose) printf("TSS_DeleteHandle: delete Name file %s\n", filename);
 	rc = TSS_File_DeleteFile(filename);
     }
@@ -2727,9 +3821,11 @@ static TPM_RC TSS_DeleteHandle(TSS_CONTEXT *tssContext,
     if (rc == 0) {
 	if ((handleType == TPM_HT_TRANSIENT) ||
 	    (handleType == TPM_HT_PERSISTENT)) {
-	    sprintf(filename, "%s/hp%08x.bin", tssContext->tssDataDirectory, handle);
-	    if (tssVverbose) printf("TSS_DeleteHandle: delete public file %s\n", filename);
-	    TSS_File_DeleteFile(filename);
+	    rc = TSS_HandleFilename(tssContext, filename, "hp", handle);
+	    if (rc == 0) {
+		if (tssVverbose) printf("TSS_DeleteHandle: delete public file %s\n", filename);
+		TSS_File_DeleteFile(filename);
+	    }
 	}
     }
 #else
@@ -2760,6 +3856,7 @@ static TPM_RC TSS_DeleteHandle(TSS_CONTEXT *tssContext,
    because the Name returned from the TPM2_ReadPublic cannot be trusted.
 */
 
+#if CC_ReadPublic
 static TPM_RC TSS_ObjectPublic_GetName(TPM2B_NAME *name,
 				       TPMT_PUBLIC *tpmtPublic)
 {
@@ -2801,6 +3898,7 @@ static TPM_RC TSS_ObjectPublic_GetName(TPM2B_NAME *name,
     free(buffer);	/* @1 */
     return rc;
 }
+#endif
 
 #endif	/* TPM_TSS_NOCRYPTO */
 
@@ -2812,6 +3910,7 @@ static TPM_RC TSS_ObjectPublic_GetName(TPM2B_NAME *name,
 #ifndef TPM_TSS_NOFILE
 #ifndef TPM_TSS_NOCRYPTO
 
+#if TSS_CC_NV_STORE
 static TPM_RC TSS_NVPublic_Store(TSS_CONTEXT *tssContext,
 				 TPMS_NV_PUBLIC *nvPublic,
 				 TPMI_RH_NV_INDEX nvIndex)
@@ -2821,12 +3920,13 @@ static TPM_RC TSS_NVPublic_Store(TSS_CONTEXT *tssContext,
 
     if (rc == 0) {
 	sprintf(nvpFilename, "%s/nvp%08x.bin", tssContext->tssDataDirectory, nvIndex);
-	rc = TSS_File_WriteStructure(nvPublic,
-				     (MarshalFunction_t)TSS_TPMS_NV_PUBLIC_Marshalu,
-				     nvpFilename);
+	rc = TSS_File_ReplaceStructure(nvPublic,
+				       (MarshalFunction_t)TSS_TPMS_NV_PUBLIC_Marshalu,
+				       nvpFilename);
     }
     return rc;
 }
+#endif
 
 #endif
 #endif
@@ -2838,6 +3938,7 @@ static TPM_RC TSS_NVPublic_Store(TSS_CONTEXT *tssContext,
 #ifndef TPM_TSS_NOFILE
 #ifndef TPM_TSS_NOCRYPTO
 
+#if TSS_CC_NV_UPDATE
 static TPM_RC TSS_NVPublic_Load(TSS_CONTEXT *tssContext,
 				TPMS_NV_PUBLIC *nvPublic,
 				TPMI_RH_NV_INDEX nvIndex)
@@ -2853,12 +3954,14 @@ static TPM_RC TSS_NVPublic_Load(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 #endif
 #endif
 
 #ifndef TPM_TSS_NOFILE
 
+#if TSS_CC_NV_DELETE
 static TPM_RC TSS_NVPublic_Delete(TSS_CONTEXT *tssContext,
 				  TPMI_RH_NV_INDEX nvIndex)
 {
@@ -2871,6 +3974,7 @@ static TPM_RC TSS_NVPublic_Delete(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 #endif
 
@@ -2881,32 +3985,29 @@ static TPM_RC TSS_NVPublic_Delete(TSS_CONTEXT *tssContext,
 
  */
 
+#if TSS_CC_NV_STORE
 static TPM_RC TSS_NVPublic_Store(TSS_CONTEXT *tssContext,
 				 TPMS_NV_PUBLIC *nvPublic,
 				 TPMI_RH_NV_INDEX nvIndex)
 {
-    TPM_RC 	rc = 0;
-    size_t	slotIndex;
+    TPM_RC 		rc = 0;
+    TSS_NVPUBLIC	*entry = NULL;
 
     if (rc == 0) {
-	rc = TSS_NvPublic_GetSlotForHandle(tssContext, &slotIndex, nvIndex);
+	rc = TSS_HandleTable_Add(&tssContext->nvPublic, (void **)&entry,
+				 nvIndex, sizeof(TSS_NVPUBLIC));
 	if (rc != 0) {
-	    rc = TSS_NvPublic_GetSlotForHandle(tssContext, &slotIndex, TPM_RH_NULL);
-	    if (rc == 0) {
-		tssContext->nvPublic[slotIndex].nvIndex = nvIndex;
-	    }
-	    else {
-		if (tssVerbose)
-		    printf("TSS_NVPublic_Store: Error, no slot available for handle %08x\n",
-			   nvIndex);
-	    }
+	    if (tssVerbose)
+		printf("TSS_NVPublic_Store: Error, no slot available for handle %08x\n",
+		       nvIndex);
 	}
     }
     if (rc == 0) {
-	tssContext->nvPublic[slotIndex].nvPublic = *nvPublic;
+	entry->nvPublic = *nvPublic;
     }
     return rc;
 }
+#endif
 
 #endif
 #endif
@@ -2918,15 +4019,16 @@ static TPM_RC TSS_NVPublic_Store(TSS_CONTEXT *tssContext,
 
  */
 
+#if TSS_CC_NV_UPDATE
 static TPM_RC TSS_NVPublic_Load(TSS_CONTEXT *tssContext,
 				TPMS_NV_PUBLIC *nvPublic,
 				TPMI_RH_NV_INDEX nvIndex)
 {
-    TPM_RC 	rc = 0;
-    size_t	slotIndex;
+    TPM_RC 		rc = 0;
+    TSS_NVPUBLIC	*entry = NULL;
 
     if (rc == 0) {
-	rc = TSS_NvPublic_GetSlotForHandle(tssContext, &slotIndex, nvIndex);
+	rc = TSS_NvPublic_GetSlotForHandle(tssContext, &entry, nvIndex);
 	if (rc != 0) {
 	    if (tssVerbose)
 		printf("TSS_NVPublic_Load: Error, no slot found for handle %08x\n",
@@ -2934,35 +4036,39 @@ static TPM_RC TSS_NVPublic_Load(TSS_CONTEXT *tssContext,
 	}
     }
     if (rc == 0) {
-	*nvPublic = tssContext->nvPublic[slotIndex].nvPublic;
+	*nvPublic = entry->nvPublic;
     }
     return rc;
 }
+#endif
 
 #endif
 #endif
 
 #ifdef TPM_TSS_NOFILE
 
+#if TSS_CC_NV_DELETE
 static TPM_RC TSS_NVPublic_Delete(TSS_CONTEXT *tssContext,
 				  TPMI_RH_NV_INDEX nvIndex)
 {
-    TPM_RC 	rc = 0;
-    size_t	slotIndex;
+    TPM_RC 		rc = 0;
+    TSS_NVPUBLIC	*nvPublic = NULL;
     
     if (rc == 0) {
-	rc = TSS_NvPublic_GetSlotForHandle(tssContext, &slotIndex, nvIndex);
-	if (rc != 0) {
+	nvPublic = TSS_HandleTable_Remove(&tssContext->nvPublic, nvIndex);
+	if (nvPublic == NULL) {
 	    if (tssVerbose)
 		printf("TSS_NVPublic_Delete: Error, no slot found for handle %08x\n",
 		       nvIndex);
+	    rc = TSS_RC_NO_NVPUBLIC_SLOT;
 	}
     }
     if (rc == 0) {
-	tssContext->nvPublic[slotIndex].nvIndex = TPM_RH_NULL;
+	free(nvPublic);
     }
     return rc;
 }
+#endif
 
 #endif
 
@@ -2974,19 +4080,14 @@ static TPM_RC TSS_NVPublic_Delete(TSS_CONTEXT *tssContext,
 */
 
 static TPM_RC TSS_NvPublic_GetSlotForHandle(TSS_CONTEXT *tssContext,
-					    size_t *slotIndex,
+					    TSS_NVPUBLIC **nvPublic,
 					    TPMI_RH_NV_INDEX nvIndex)
 {
-    size_t 	i;
-
-    /* search all slots for handle */
-    for (i = 0 ; i < (sizeof(tssContext->nvPublic) / sizeof(TSS_NVPUBLIC)) ; i++) {
-	if (tssContext->nvPublic[i].nvIndex == nvIndex) {
-	    *slotIndex = i;
-	    return 0;
-	}
+    *nvPublic = TSS_HandleTable_Find(&tssContext->nvPublic, nvIndex);
+    if (*nvPublic == NULL) {
+	return TSS_RC_NO_NVPUBLIC_SLOT;
     }
-    return TSS_RC_NO_NVPUBLIC_SLOT;
+    return 0;
 }	
 
 #endif
@@ -2997,6 +4098,7 @@ static TPM_RC TSS_NvPublic_GetSlotForHandle(TSS_CONTEXT *tssContext,
 
 #ifndef TPM_TSS_NOCRYPTO
 
+#if TSS_CC_NV_STORE
 static TPM_RC TSS_NVPublic_GetName(TPM2B_NAME *name,
 				   TPMS_NV_PUBLIC *nvPublic)
 {
@@ -3038,12 +4140,14 @@ static TPM_RC TSS_NVPublic_GetName(TPM2B_NAME *name,
     free(buffer);	/* @1 */
     return rc;
 }
+#endif
 
 #endif
 
 #ifndef TPM_TSS_NOCRYPTO
 
-static TPM_RC TSS_HmacSession_SetNonceCaller(struct TSS_HMAC_CONTEXT *session,
+static TPM_RC TSS_HmacSession_SetNonceCaller(TSS_CONTEXT *tssContext,
+					     struct TSS_HMAC_CONTEXT *session,
 					     TPMS_AUTH_COMMAND 	*authC)
 {
     TPM_RC		rc = 0;
@@ -3051,7 +4155,8 @@ static TPM_RC TSS_HmacSession_SetNonceCaller(struct TSS_HMAC_CONTEXT *session,
     /* generate a new nonceCaller */
     if (rc == 0) {
 	session->nonceCaller.b.size = session->sizeInBytes;
-	rc = TSS_RandBytes(session->nonceCaller.t.buffer, session->sizeInBytes);
+	rc = TSS_RandNonce(tssContext, session->nonceCaller.t.buffer,
+			   session->nonceCaller.b.size);
     }
     /* nonceCaller for the command */
     if (rc == 0) {
@@ -3060,6 +4165,54 @@ static TPM_RC TSS_HmacSession_SetNonceCaller(struct TSS_HMAC_CONTEXT *session,
     return rc;
 }
 
+/* TSS_RandNonce() generates a caller nonce or salt.
+
+   If the TPM_NONCE_SEED property is set and a trace is being recorded or replayed, the bytes are
+   the deterministic SHA-256(seed || counter) stream, so that a replayed HMAC session flow
+   reproduces the recorded one.  Otherwise they are random.  A seed without TPM_RECORD_FILE or
+   TPM_REPLAY_FILE is ignored, so that a stray environment variable cannot make the nonces and
+   salts for a TPM predictable.
+*/
+
+static TPM_RC TSS_RandNonce(TSS_CONTEXT *tssContext,
+			    uint8_t *buffer,
+			    uint16_t size)
+{
+    TPM_RC		rc = 0;
+    TPMT_HA 		digest;
+    uint32_t 		counterNbo;
+    uint16_t		bytes;
+    int			seeded = (tssContext->tssNonceSeed != NULL);
+
+    if (seeded &&
+	(tssContext->tssRecordFile == NULL) && (tssContext->tssReplayFile == NULL)) {
+	if (tssVerbose) printf("TSS_RandNonce: TPM_NONCE_SEED ignored, "
+			       "neither TPM_RECORD_FILE nor TPM_REPLAY_FILE is set\n");
+	seeded = FALSE;
+    }
+    if (!seeded) {
+	rc = TSS_RandBytes(buffer, size);
+    }
+    else {
+	digest.hashAlg = TPM_ALG_SHA256;
+	while ((rc == 0) && (size > 0)) {
+	    counterNbo = htonl(tssContext->tssNonceCounter);
+	    tssContext->tssNonceCounter++;
+	    rc = TSS_Hash_Generate(&digest,
+				   (int)strlen(tssContext->tssNonceSeed), tssContext->tssNonceSeed,
+				   sizeof(uint32_t), &counterNbo,
+				   0, NULL);
+	    if (rc == 0) {
+		bytes = (size < SHA256_DIGEST_SIZE) ? size : SHA256_DIGEST_SIZE;
+		memcpy(buffer, (uint8_t *)&digest.digest, bytes);
+		buffer += bytes;
+		size -= bytes;
+	    }
+	}
+    }
+    return rc;
+}
+
 #endif	/* TPM_TSS_NOCRYPTO */
 
 #ifndef TPM_TSS_NOCRYPTO
@@ -3379,6 +4532,15 @@ static TPM_RC TSS_HmacSession_SetHMAC(TSS_AUTH_CONTEXT *tssAuthContext,	/* autho
 		    nonceTPMDecrypt.t.size = 0;
 		    nonceTPMEncrypt.t.size = 0;
 		}
+		/* an audit session extends its audit digest with the cpHash after the response */
+		if ((rc == 0) && (sessionAttr8 & TPMA_SESSION_AUDIT)) {
+		    session[i]->auditAttributes =
+			sessionAttr8 & (TPMA_SESSION_AUDIT | TPMA_SESSION_AUDITRESET);
+		    rc = TSS_TPM2B_Create(&session[i]->auditCpHash.b,
+					  (uint8_t *)&cpHash.digest,
+					  (uint16_t)session[i]->sizeInBytes,
+					  sizeof(session[i]->auditCpHash.t.buffer));
+		}
 		/* */
 		if (rc == 0) {
 		    hmac.hashAlg = session[i]->authHashAlg;
@@ -3535,6 +4697,47 @@ static TPM_RC TSS_HmacSession_Verify(TSS_AUTH_CONTEXT *tssAuthContext,	/* author
 			     sizeof(uint8_t), &authResponse->sessionAttributes.val,
 			     0, NULL);
     }
+    /* the response is valid, extend the audit digest */
+    if ((rc == 0) && (session->auditAttributes & TPMA_SESSION_AUDIT)) {
+	rc = TSS_HmacSession_AuditExtend(session, &rpHash);
+    }
+    return rc;
+}
+
+/* TSS_HmacSession_AuditExtend() extends the running session audit digest for a successful
+   command that had the audit attribute set.
+
+   auditDigest = HsessionAlg (auditDigest || cpHash || rpHash)
+
+   As in the TPM, the digest is first set to all zeros on the first audited command and when
+   auditReset is set.
+*/
+
+static TPM_RC TSS_HmacSession_AuditExtend(struct TSS_HMAC_CONTEXT *session,
+					  TPMT_HA *rpHash)
+{
+    TPM_RC		rc = 0;
+    TPMT_HA 		auditDigest;
+
+    if ((session->auditDigest.t.size == 0) ||
+	(session->auditAttributes & TPMA_SESSION_AUDITRESET)) {
+	session->auditDigest.t.size = (uint16_t)session->sizeInBytes;
+	memset(session->auditDigest.t.buffer, 0, session->sizeInBytes);
+    }
+    if (rc == 0) {
+	auditDigest.hashAlg = session->authHashAlg;
+	rc = TSS_Hash_Generate(&auditDigest,
+			       session->auditDigest.b.size, session->auditDigest.b.buffer,
+			       session->auditCpHash.b.size, session->auditCpHash.b.buffer,
+			       session->sizeInBytes, (uint8_t *)&rpHash->digest,
+			       0, NULL);
+    }
+    if (rc == 0) {
+	memcpy(session->auditDigest.t.buffer, (uint8_t *)&auditDigest.digest,
+	       session->sizeInBytes);
+	if (tssVverbose) TSS_PrintAll("TSS_HmacSession_AuditExtend: auditDigest",
+				      session->auditDigest.t.buffer, session->auditDigest.t.size);
+    }
     return rc;
 }
 
@@ -3566,6 +4769,89 @@ static TPM_RC TSS_HmacSession_Continue(TSS_CONTEXT *tssContext,
     return rc;
 }
 
+/* TSS_GetAuditDigest() returns the running session audit digest that the TSS maintains for the
+   audit session sessionHandle.
+
+   The digest is extended for each successful command that used the session with the audit
+   attribute set.  It has size zero if the session has not yet audited a command.
+*/
+
+TPM_RC TSS_GetAuditDigest(TSS_CONTEXT *tssContext,
+			  TPM2B_DIGEST *auditDigest,
+			  TPMI_SH_AUTH_SESSION sessionHandle)
+{
+    TPM_RC			rc = 0;
+#ifndef TPM_TSS_NOCRYPTO
+    struct TSS_HMAC_CONTEXT 	*session = NULL;
+
+    if (rc == 0) {
+	rc = TSS_HmacSession_GetContext(&session);	/* freed @1 */
+    }
+    if (rc == 0) {
+	rc = TSS_HmacSession_LoadSession(tssContext, session, sessionHandle);
+    }
+    if (rc == 0) {
+	rc = TSS_TPM2B_Copy(&auditDigest->b, &session->auditDigest.b,
+			    sizeof(auditDigest->t.buffer));
+    }
+    TSS_HmacSession_FreeContext(session);	/* @1 */
+#else
+    tssContext = tssContext;
+    auditDigest = auditDigest;
+    sessionHandle = sessionHandle;
+    if (tssVerbose) printf("TSS_GetAuditDigest: Error, with no crypto not implemented\n");
+    rc = TSS_RC_NOT_IMPLEMENTED;
+#endif	/* TPM_TSS_NOCRYPTO */
+    return rc;
+}
+
+/* TSS_VerifyAuditDigest() compares the session digest in the TPM2_GetSessionAuditDigest auditInfo
+   with the running session audit digest for sessionHandle.
+
+   Returns TSS_RC_AUDIT_DIGEST if auditInfo is not a session audit attestation or the digests do
+   not match.  The caller must still verify the signature over auditInfo.
+*/
+
+TPM_RC TSS_VerifyAuditDigest(TSS_CONTEXT *tssContext,
+			     TPMI_SH_AUTH_SESSION sessionHandle,
+			     const TPM2B_ATTEST *auditInfo)
+{
+    TPM_RC		rc = 0;
+    TPMS_ATTEST 	attest;
+    TPM2B_DIGEST	auditDigest;
+
+    if (rc == 0) {
+	uint8_t *tmpBuffer = (uint8_t *)auditInfo->t.attestationData;
+	uint32_t tmpSize = auditInfo->t.size;
+	rc = TSS_TPMS_ATTEST_Unmarshalu(&attest, &tmpBuffer, &tmpSize);
+    }
+    if (rc == 0) {
+	if ((attest.magic != TPM_GENERATED_VALUE) ||
+	    (attest.type != TPM_ST_ATTEST_SESSION_AUDIT)) {
+	    if (tssVerbose) printf("TSS_VerifyAuditDigest: Error, not a session audit attestation\n");
+	    rc = TSS_RC_AUDIT_DIGEST;
+	}
+    }
+    if (rc == 0) {
+	rc = TSS_GetAuditDigest(tssContext, &auditDigest, sessionHandle);
+    }
+    if (rc == 0) {
+	if (tssVverbose) {
+	    TSS_PrintAll("TSS_VerifyAuditDigest: TSS audit digest",
+			 auditDigest.t.buffer, auditDigest.t.size);
+	    TSS_PrintAll("TSS_VerifyAuditDigest: TPM audit digest",
+			 attest.attested.sessionAudit.sessionDigest.t.buffer,
+			 attest.attested.sessionAudit.sessionDigest.t.size);
+	}
+	if (!TSS_TPM2B_Compare(&auditDigest.b, &attest.attested.sessionAudit.sessionDigest.b)) {
+	    if (tssVerbose) printf("TSS_VerifyAuditDigest: Error, session %08x digest mismatch\n",
+				   sessionHandle);
+	    rc = TSS_RC_AUDIT_DIGEST;
+	}
+    }
+    return rc;
+}
+
 /* TSS_Sessions_GetDecryptSession() searches for a command decrypt session.  If found, returns
    isDecrypt TRUE, and the session number in decryptSession.
 
@@ -4206,6 +5492,7 @@ static TPM_RC TSS_Command_ChangeAuthProcessor(TSS_CONTEXT *tssContext,
 
 #endif	/* TPM_TSS_NOCRYPTO */
 
+#if CC_HierarchyChangeAuth
 static TPM_RC TSS_CA_HierarchyChangeAuth(TSS_CONTEXT *tssContext,
 					 struct TSS_HMAC_CONTEXT *session,
 					 size_t handleNumber,
@@ -4244,7 +5531,9 @@ static TPM_RC TSS_CA_HierarchyChangeAuth(TSS_CONTEXT *tssContext,
     free(password);	/* @1 */
     return rc;
 }
+#endif
 
+#if CC_NV_ChangeAuth
 static TPM_RC TSS_CA_NV_ChangeAuth(TSS_CONTEXT *tssContext,
 				   struct TSS_HMAC_CONTEXT *session,
 				   size_t handleNumber,
@@ -4283,7 +5572,9 @@ static TPM_RC TSS_CA_NV_ChangeAuth(TSS_CONTEXT *tssContext,
     free(password);	/* @1 */
     return rc;
 }
+#endif
 
+#if CC_NV_UndefineSpaceSpecial
 static TPM_RC TSS_CA_NV_UndefineSpaceSpecial(TSS_CONTEXT *tssContext,
 					     struct TSS_HMAC_CONTEXT *session,
 					     size_t handleNumber,
@@ -4311,6 +5602,7 @@ static TPM_RC TSS_CA_NV_UndefineSpaceSpecial(TSS_CONTEXT *tssContext,
 #endif	/* TPM_TSS_NOCRYPTO */
     return rc;
 }
+#endif
 
 #ifdef TPM_TSS_NODEPRECATEDALGS
 static TPM_RC TSS_Command_CheckParameters(TPM_CC commandCode,
@@ -4417,6 +5709,7 @@ static TPM_RC TSS_Command_PreProcessor(TSS_CONTEXT *tssContext,
    Returns an error if the key is not an RSA key.
 */
 
+#if CC_StartAuthSession
 static TPM_RC TSS_PR_StartAuthSession(TSS_CONTEXT *tssContext,
 				      StartAuthSession_In *in,
 				      StartAuthSession_Extra *extra)
@@ -4439,7 +5732,8 @@ static TPM_RC TSS_PR_StartAuthSession(TSS_CONTEXT *tssContext,
 	}
     }
     if (rc == 0) {
-	rc = TSS_RandBytes((unsigned char *)&in->nonceCaller.t.buffer, in->nonceCaller.t.size);
+	rc = TSS_RandNonce(tssContext, (uint8_t *)&in->nonceCaller.t.buffer,
+			   in->nonceCaller.t.size);
     }
 #else
     in->nonceCaller.t.size = 16;
@@ -4478,7 +5772,8 @@ static TPM_RC TSS_PR_StartAuthSession(TSS_CONTEXT *tssContext,
 #endif	/* TPM_TSS_NOECC */
 #ifndef TPM_TSS_NORSA
 	      case TPM_ALG_RSA:
-		rc = TSS_RSA_Salt(&extra->salt,
+		rc = TSS_RSA_Salt(tssContext,
+				  &extra->salt,
 				  &in->encryptedSalt,
 				  &bPublic.publicArea);
 		break;
@@ -4497,13 +5792,16 @@ static TPM_RC TSS_PR_StartAuthSession(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 #ifndef TPM_TSS_NOCRYPTO
 #ifndef TPM_TSS_NORSA
 
 /* TSS_RSA_Salt() returns both the plaintext and excrypted salt, based on the salt key bPublic. */
 
-static TPM_RC TSS_RSA_Salt(TPM2B_DIGEST 		*salt,
+#if CC_StartAuthSession
+static TPM_RC TSS_RSA_Salt(TSS_CONTEXT 		*tssContext,
+			   TPM2B_DIGEST 		*salt,
 			   TPM2B_ENCRYPTED_SECRET	*encryptedSalt,
 			   TPMT_PUBLIC			*publicArea)
 {
@@ -4541,7 +5839,7 @@ static TPM_RC TSS_RSA_Salt(TPM2B_DIGEST 		*salt,
 				"Hash algorithm %04x Salt size %u\n",
 				publicArea->nameAlg, salt->t.size);
 	/* place the salt in extra so that it can be retrieved by post processor */
-	rc = TSS_RandBytes((uint8_t *)&salt->t.buffer, salt->t.size);
+	rc = TSS_RandNonce(tssContext, (uint8_t *)&salt->t.buffer, salt->t.size);
     }
     /* In TPM2_StartAuthSession(), when tpmKey is an RSA key, the secret value (salt) is
        encrypted using OAEP as described in B.4. The string "SECRET" (see 4.5) is used as
@@ -4577,10 +5875,12 @@ static TPM_RC TSS_RSA_Salt(TPM2B_DIGEST 		*salt,
     }
     return rc;
 }
+#endif
 
 #endif /* TPM_TSS_NORSA */
 #endif /* TPM_TSS_NOCRYPTO */
 
+#if CC_NV_DefineSpace
 static TPM_RC TSS_PR_NV_DefineSpace(TSS_CONTEXT *tssContext,
 				    NV_DefineSpace_In *in,
 				    void *extra)
@@ -4603,6 +5903,7 @@ static TPM_RC TSS_PR_NV_DefineSpace(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 /*
   Response Post Processor
@@ -4663,6 +5964,7 @@ static TPM_RC TSS_Response_PostProcessor(TSS_CONTEXT *tssContext,
    Finally, it marshals the session and stores it
 */
 
+#if CC_StartAuthSession
 static TPM_RC TSS_PO_StartAuthSession(TSS_CONTEXT *tssContext,
 				      StartAuthSession_In *in,
 				      StartAuthSession_Out *out,
@@ -4726,12 +6028,14 @@ static TPM_RC TSS_PO_StartAuthSession(TSS_CONTEXT *tssContext,
     TSS_HmacSession_FreeContext(session);
     return rc;
 }
+#endif
 
 /* TSS_PO_ContextSave() saves the name of an object in a filename that is a hash of the contextBlob.
 
    This permits the name to be found during ContextLoad.
 */
 
+#if CC_ContextSave
 static TPM_RC TSS_PO_ContextSave(TSS_CONTEXT *tssContext,
 				 ContextSave_In *in,
 				 ContextSave_Out *out,
@@ -4787,7 +6091,9 @@ static TPM_RC TSS_PO_ContextSave(TSS_CONTEXT *tssContext,
 #endif
     return rc;
 }
+#endif
 
+#if CC_ContextLoad
 static TPM_RC TSS_PO_ContextLoad(TSS_CONTEXT *tssContext,
 				 ContextLoad_In *in,
 				 ContextLoad_Out *out,
@@ -4845,6 +6151,7 @@ static TPM_RC TSS_PO_ContextLoad(TSS_CONTEXT *tssContext,
 #endif
     return rc;
 }
+#endif
 
 /* TSS_HashToString() converts a SHA-256 binary hash (really any 32-byte value) to a string 
 
@@ -4855,6 +6162,7 @@ static TPM_RC TSS_PO_ContextLoad(TSS_CONTEXT *tssContext,
 
 #ifndef TPM_TSS_NOFILE
 
+#if CC_ContextSave || CC_ContextLoad
 static TPM_RC TSS_HashToString(char *str, uint8_t *digest)
 {
     size_t i;
@@ -4865,11 +6173,13 @@ static TPM_RC TSS_HashToString(char *str, uint8_t *digest)
     if (tssVverbose) printf("TSS_HashToString: %s\n", str);
     return 0;
 }
+#endif
 
 #endif
 
 /* TSS_PO_FlushContext() removes persistent state associated with the handle */
 
+#if CC_FlushContext
 static TPM_RC TSS_PO_FlushContext(TSS_CONTEXT *tssContext,
 				  FlushContext_In *in,
 				  void *out,
@@ -4885,9 +6195,11 @@ static TPM_RC TSS_PO_FlushContext(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 /* TSS_PO_EvictControl() removes persistent state associated with the handle */
 
+#if CC_EvictControl
 static TPM_RC TSS_PO_EvictControl(TSS_CONTEXT *tssContext,
 				  EvictControl_In *in,
 				  void *out,
@@ -4926,9 +6238,11 @@ static TPM_RC TSS_PO_EvictControl(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 /* TSS_PO_Load() saves the Name returned for the loaded object.  It saves the TPM2B_PUBLIC */
 
+#if CC_Load
 static TPM_RC TSS_PO_Load(TSS_CONTEXT *tssContext,
 			  Load_In *in,
 			  Load_Out *out,
@@ -4948,9 +6262,11 @@ static TPM_RC TSS_PO_Load(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 /* TSS_PO_LoadExternal() saves the Name returned for the loaded object */
 
+#if CC_LoadExternal
 static TPM_RC TSS_PO_LoadExternal(TSS_CONTEXT *tssContext,
 				  LoadExternal_In *in,
 				  LoadExternal_Out *out,
@@ -4970,9 +6286,11 @@ static TPM_RC TSS_PO_LoadExternal(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 /* TSS_PO_ReadPublic() saves the Name returned for the loaded object */
 
+#if CC_ReadPublic
 static TPM_RC TSS_PO_ReadPublic(TSS_CONTEXT *tssContext,
 				ReadPublic_In *in,
 				ReadPublic_Out *out,
@@ -5026,9 +6344,11 @@ static TPM_RC TSS_PO_ReadPublic(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 /* TSS_PO_Load() saves the Name returned for the loaded object.  It saves the TPM2B_PUBLIC */
 
+#if CC_CreateLoaded
 static TPM_RC TSS_PO_CreateLoaded(TSS_CONTEXT *tssContext,
 				  CreateLoaded_In *in,
 				  CreateLoaded_Out *out,
@@ -5048,9 +6368,11 @@ static TPM_RC TSS_PO_CreateLoaded(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 /* TSS_PO_HashSequenceStart() saves the Name returned for the started sequence object */
 
+#if CC_HashSequenceStart
 static TPM_RC TSS_PO_HashSequenceStart(TSS_CONTEXT *tssContext,
 				       HashSequenceStart_In *in,
 				       HashSequenceStart_Out *out,
@@ -5071,10 +6393,12 @@ static TPM_RC TSS_PO_HashSequenceStart(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
 
 /* TSS_PO_HMAC_Start() saves the Name returned for the started sequence object */
 
+#if CC_HMAC_Start
 static TPM_RC TSS_PO_HMAC_Start(TSS_CONTEXT *tssContext,
 				HMAC_Start_In *in,
 				HMAC_Start_Out *out,
@@ -5095,7 +6419,9 @@ static TPM_RC TSS_PO_HMAC_Start(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
+#if CC_SequenceComplete
 static TPM_RC TSS_PO_SequenceComplete(TSS_CONTEXT *tssContext,
 				      SequenceComplete_In *in,
 				      SequenceComplete_Out *out,
@@ -5112,6 +6438,8 @@ static TPM_RC TSS_PO_SequenceComplete(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
+#if CC_EventSequenceComplete
 static TPM_RC TSS_PO_EventSequenceComplete(TSS_CONTEXT *tssContext,
 					   EventSequenceComplete_In *in,
 					   EventSequenceComplete_Out *out,
@@ -5127,7 +6455,9 @@ static TPM_RC TSS_PO_EventSequenceComplete(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
+#if CC_PolicyAuthValue
 static TPM_RC TSS_PO_PolicyAuthValue(TSS_CONTEXT *tssContext,
 				     PolicyAuthValue_In *in,
 				     void *out,
@@ -5153,7 +6483,9 @@ static TPM_RC TSS_PO_PolicyAuthValue(TSS_CONTEXT *tssContext,
     free(session);		/* @1 */
     return rc;
 }
+#endif
 
+#if CC_PolicyPassword
 static TPM_RC TSS_PO_PolicyPassword(TSS_CONTEXT *tssContext,
 				    PolicyPassword_In *in,
 				    void *out,
@@ -5179,7 +6511,9 @@ static TPM_RC TSS_PO_PolicyPassword(TSS_CONTEXT *tssContext,
     free(session);		/* @1 */
     return rc;
 }
+#endif
 
+#if CC_CreatePrimary
 static TPM_RC TSS_PO_CreatePrimary(TSS_CONTEXT *tssContext,
 				   CreatePrimary_In *in,
 				   CreatePrimary_Out *out,
@@ -5199,7 +6533,9 @@ static TPM_RC TSS_PO_CreatePrimary(TSS_CONTEXT *tssContext,
     }
     return rc;
 }
+#endif
 
+#if CC_NV_DefineSpace
 static TPM_RC TSS_PO_NV_DefineSpace(TSS_CONTEXT *tssContext,
 				    NV_DefineSpace_In *in,
 				    void *out,
@@ -5239,8 +6575,10 @@ static TPM_RC TSS_PO_NV_DefineSpace(TSS_CONTEXT *tssContext,
     extra = extra;
     return rc;
 }
+#endif
 
 
+#if CC_NV_ReadPublic
 static TPM_RC TSS_PO_NV_ReadPublic(TSS_CONTEXT *tssContext,
 				   NV_ReadPublic_In *in,
 				   NV_ReadPublic_Out *out,
@@ -5296,7 +6634,9 @@ static TPM_RC TSS_PO_NV_ReadPublic(TSS_CONTEXT *tssContext,
     extra = extra;
     return rc;
 }
+#endif
 
+#if CC_NV_UndefineSpace
 static TPM_RC TSS_PO_NV_UndefineSpace(TSS_CONTEXT *tssContext,
 				      NV_UndefineSpace_In *in,
 				      void *out,
@@ -5317,7 +6657,9 @@ static TPM_RC TSS_PO_NV_UndefineSpace(TSS_CONTEXT *tssContext,
 #endif
     return rc;
 }
+#endif
 
+#if CC_NV_UndefineSpaceSpecial
 static TPM_RC TSS_PO_NV_UndefineSpaceSpecial(TSS_CONTEXT *tssContext,
 					     NV_UndefineSpaceSpecial_In *in,
 					     void *out,
@@ -5333,10 +6675,12 @@ static TPM_RC TSS_PO_NV_UndefineSpaceSpecial(TSS_CONTEXT *tssContext,
     TSS_NVPublic_Delete(tssContext, in->nvIndex);
     return rc;
 }
+#endif
 
 /* TSS_PO_NV_Write() handles the Name and NVPublic update for the 4 NV write commands: write,
    increment, extend, and setbits */
 
+#if TSS_CC_NV_WRITE
 static TPM_RC TSS_PO_NV_Write(TSS_CONTEXT *tssContext,
 			      NV_Write_In *in,
 			      void *out,
@@ -5386,9 +6730,11 @@ static TPM_RC TSS_PO_NV_Write(TSS_CONTEXT *tssContext,
     extra = extra;
     return rc;
 }
+#endif
 
 /* TSS_PO_NV_WriteLock() handles the Name and NVPublic update for the write lock command */
 
+#if CC_NV_WriteLock
 static TPM_RC TSS_PO_NV_WriteLock(TSS_CONTEXT *tssContext,
 				  NV_WriteLock_In *in,
 				  void *out,
@@ -5438,9 +6784,11 @@ static TPM_RC TSS_PO_NV_WriteLock(TSS_CONTEXT *tssContext,
     extra = extra;
     return rc;
 }
+#endif
 
 /* TSS_PO_NV_WriteLock() handles the Name and NVPublic update for the read lock command */
 
+#if CC_NV_ReadLock
 static TPM_RC TSS_PO_NV_ReadLock(TSS_CONTEXT *tssContext,
 				 NV_ReadLock_In *in,
 				 void *out,
@@ -5490,4 +6838,5 @@ static TPM_RC TSS_PO_NV_ReadLock(TSS_CONTEXT *tssContext,
     extra = extra;
     return rc;
 }
+#endif
 
@@ -65,7 +65,11 @@
 extern int tssVerbose;
 extern int tssVverbose;
 
-/* TSS_AuthCreate() allocates and initializes a TSS_AUTH_CONTEXT */
+/* TSS_AuthCreate() allocates and initializes a TSS_AUTH_CONTEXT.
+
+   The command and response buffers are not allocated until the first command, see
+   TSS_AuthSizeBuffers(), so that a context that is created but never used stays small.
+*/
 
 TPM_RC TSS_AuthCreate(TSS_AUTH_CONTEXT **tssAuthContext)
 {
@@ -73,18 +77,66 @@ TPM_RC TSS_AuthCreate(TSS_AUTH_CONTEXT **tssAuthContext)
     if (rc == 0) {
         rc = TSS_Malloc((uint8_t **)tssAuthContext, sizeof(TSS_AUTH_CONTEXT));
    }
+    if (rc == 0) {
+	(*tssAuthContext)->commandBuffer = NULL;
+	(*tssAuthContext)->commandBufferSize = 0;
+	(*tssAuthContext)->responseBuffer = NULL;
+	(*tssAuthContext)->responseBufferSize = 0;
+    }
     if (rc == 0) {
 	TSS_InitAuthContext(*tssAuthContext);
     }
     return rc;
 }
 
+/* TSS_AuthSetBufferSize() (re)allocates the command and response buffers.
+
+   The buffers are only reallocated if the size changes.  Since the buffers are only valid within
+   one command, the contents are not preserved.
+*/
+
+TPM_RC TSS_AuthSetBufferSize(TSS_AUTH_CONTEXT *tssAuthContext,
+			     uint32_t commandBufferSize,
+			     uint32_t responseBufferSize)
+{
+    TPM_RC rc = 0;
+    if ((rc == 0) && (commandBufferSize != tssAuthContext->commandBufferSize)) {
+	free(tssAuthContext->commandBuffer);
+	tssAuthContext->commandBuffer = NULL;
+	tssAuthContext->commandBufferSize = 0;
+	rc = TSS_Malloc(&tssAuthContext->commandBuffer, commandBufferSize);
+	if (rc == 0) {
+	    tssAuthContext->commandBufferSize = commandBufferSize;
+	    memset(tssAuthContext->commandBuffer, 0, commandBufferSize);
+	}
+    }
+    if ((rc == 0) && (responseBufferSize != tssAuthContext->responseBufferSize)) {
+	free(tssAuthContext->responseBuffer);
+	tssAuthContext->responseBuffer = NULL;
+	tssAuthContext->responseBufferSize = 0;
+	rc = TSS_Malloc(&tssAuthContext->responseBuffer, responseBufferSize);
+	if (rc == 0) {
+	    tssAuthContext->responseBufferSize = responseBufferSize;
+	    memset(tssAuthContext->responseBuffer, 0, responseBufferSize);
+	}
+    }
+    if ((rc == 0) && tssVverbose) {
+	printf("TSS_AuthSetBufferSize: command %u response %u\n",
+	       tssAuthContext->commandBufferSize, tssAuthContext->responseBufferSize);
+    }
+    return rc;
+}
+
 /* TSS_InitAuthContext() sets initial values for an allocated TSS_AUTH_CONTEXT */
 
 void TSS_InitAuthContext(TSS_AUTH_CONTEXT *tssAuthContext)
 {
-    memset(tssAuthContext->commandBuffer, 0, sizeof(tssAuthContext->commandBuffer));
-    memset(tssAuthContext->responseBuffer, 0, sizeof(tssAuthContext->responseBuffer));
+    if (tssAuthContext->commandBuffer != NULL) {
+	memset(tssAuthContext->commandBuffer, 0, tssAuthContext->commandBufferSize);
+    }
+    if (tssAuthContext->responseBuffer != NULL) {
+	memset(tssAuthContext->responseBuffer, 0, tssAuthContext->responseBufferSize);
+    }
     tssAuthContext->commandText = NULL;
     tssAuthContext->commandCode = 0;
     tssAuthContext->responseCode = 0;
@@ -114,11 +166,38 @@ TPM_RC TSS_AuthDelete(TSS_AUTH_CONTEXT *tssAuthContext)
 {
     if (tssAuthContext != NULL) {
 	TSS_InitAuthContext(tssAuthContext);
+	free(tssAuthContext->commandBuffer);
+	free(tssAuthContext->responseBuffer);
 	free(tssAuthContext);
     }
     return 0;
 }
 
+/* TSS_AuthSizeBuffers() sizes the command and response buffers for the next command.
+
+   If query is TRUE, the first command on a connection may first read the TPM maximums, see
+   TSS_GetBufferSize().  Otherwise, the current sizes are used.  The buffers are only reallocated
+   when the size changes.
+*/
+
+TPM_RC TSS_AuthSizeBuffers(TSS_CONTEXT *tssContext,
+			   int query)
+{
+    TPM_RC rc = 0;
+    uint32_t commandBufferSize = tssContext->tssCommandBufferSize;
+    uint32_t responseBufferSize = tssContext->tssResponseBufferSize;
+    uint32_t nvBufferMax;
+
+    if ((rc == 0) && query) {
+	rc = TSS_GetBufferSize(tssContext, &commandBufferSize, &responseBufferSize, &nvBufferMax);
+    }
+    if (rc == 0) {
+	rc = TSS_AuthSetBufferSize(tssContext->tssAuthContext,
+				   commandBufferSize, responseBufferSize);
+    }
+    return rc;
+}
+
 TPM_CC TSS_GetCommandCode(TSS_AUTH_CONTEXT *tssAuthContext)
 {
     TPM_CC commandCode = tssAuthContext->commandCode;
@@ -150,6 +229,8 @@ TPM_RC TSS_AuthExecute(TSS_CONTEXT *tssContext)
 			    tssContext->tssAuthContext->commandText);
     /* transmit the command and receive the response.  Normally returns the TPM response code. */
     if (rc == 0) {
+	/* the response buffer may be larger than a TSS_Transmit() caller's MAX_RESPONSE_SIZE */
+	tssContext->tssTransmitResponseSize = tssContext->tssAuthContext->responseBufferSize;
 	rc = TSS_Transmit(tssContext,
 			  tssContext->tssAuthContext->responseBuffer,
 			  &tssContext->tssAuthContext->responseSize,
@@ -58,8 +58,10 @@ typedef TPM_RC (*UnmarshalInFunction_t)(COMMAND_PARAMETERS *target,
    this structure */
 
 typedef struct TSS_AUTH_CONTEXT {
-    uint8_t 		commandBuffer [MAX_COMMAND_SIZE];
-    uint8_t 		responseBuffer [MAX_RESPONSE_SIZE];
+    uint8_t 		*commandBuffer;		/* allocated, see TSS_AuthSetBufferSize() */
+    uint32_t		commandBufferSize;
+    uint8_t 		*responseBuffer;
+    uint32_t		responseBufferSize;
     const char 		*commandText;
     COMMAND_INDEX    	tpmCommandIndex;	/* index into attributes table */
     TPM_CC 		commandCode;
@@ -89,6 +91,13 @@ void TSS_InitAuthContext(TSS_AUTH_CONTEXT *tssAuthContext);
 
 TPM_RC TSS_AuthDelete(TSS_AUTH_CONTEXT *tssAuthContext);
 
+TPM_RC TSS_AuthSetBufferSize(TSS_AUTH_CONTEXT *tssAuthContext,
+			     uint32_t commandBufferSize,
+			     uint32_t responseBufferSize);
+
+TPM_RC TSS_AuthSizeBuffers(TSS_CONTEXT *tssContext,
+			   int query);
+
 TPM_CC TSS_GetCommandCode(TSS_AUTH_CONTEXT *tssAuthContext);
 
 TPM_RC TSS_GetCpBuffer(TSS_AUTH_CONTEXT *tssAuthContext,
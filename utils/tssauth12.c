@@ -294,7 +294,7 @@ TPM_RC TSS_Marshal12(TSS_AUTH_CONTEXT *tssAuthContext,
     if (rc == 0) {
 	/* make a copy of the command buffer and size since the marshal functions move them */
 	buffer = tssAuthContext->commandBuffer;
-	size = MAX_COMMAND_SIZE;
+	size = tssAuthContext->commandBufferSize;
 	/* marshal header, preliminary tag and command size */
 	rc = TSS_UINT16_Marshalu(&tag, &tssAuthContext->commandSize, &buffer, &size);
     }
@@ -341,7 +341,7 @@ TPM_RC TSS_Marshal12(TSS_AUTH_CONTEXT *tssAuthContext,
     if ((rc == 0) && (tssAuthContext->unmarshalInFunction != NULL)) {
 	COMMAND_PARAMETERS target;
 	TPM_HANDLE 	handles[MAX_HANDLE_NUM];
-	size = MAX_COMMAND_SIZE;
+	size = tssAuthContext->commandBufferSize;
 	rc = tssAuthContext->unmarshalInFunction(&target, &bufferu, &size, handles);
 	if ((rc != 0) && tssVerbose) {
 	    printf("TSS_Marshal12: Invalid command parameter\n");
@@ -480,7 +480,7 @@ TPM_RC TSS_SetCmdAuths12(TSS_AUTH_CONTEXT 	*tssAuthContext,
     }
     for (i = 0 ; (rc == 0) && (i < numSessions) ; i++) {
 	uint16_t written = 0;
-	uint32_t size = MAX_COMMAND_SIZE - cpBufferSize;
+	uint32_t size = tssAuthContext->commandBufferSize - cpBufferSize;
 	/* marshal authHandle */
 	if (rc == 0) {
 	    rc = TSS_UINT32_Marshalu(&authC[i]->sessionHandle, &written, &cpBuffer, &size); 
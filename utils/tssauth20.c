@@ -80,6 +80,7 @@ typedef struct MARSHAL_TABLE {
 
 static const MARSHAL_TABLE marshalTable [] = {
 
+#if CC_Startup
     {TPM_CC_Startup, "TPM2_Startup",
      (MarshalInFunction_t)TSS_Startup_In_Marshalu,
      NULL
@@ -87,6 +88,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Startup_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Shutdown
     {TPM_CC_Shutdown, "TPM2_Shutdown",
      (MarshalInFunction_t)TSS_Shutdown_In_Marshalu,
      NULL
@@ -94,6 +97,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Shutdown_In_Unmarshal
 #endif
     },
+#endif
+#if CC_SelfTest
     {TPM_CC_SelfTest, "TPM2_SelfTest",
      (MarshalInFunction_t)TSS_SelfTest_In_Marshalu,
      NULL
@@ -101,6 +106,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)SelfTest_In_Unmarshal
 #endif
     },
+#endif
+#if CC_IncrementalSelfTest
     {TPM_CC_IncrementalSelfTest, "TPM2_IncrementalSelfTest",
      (MarshalInFunction_t)TSS_IncrementalSelfTest_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_IncrementalSelfTest_Out_Unmarshalu
@@ -108,6 +115,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)IncrementalSelfTest_In_Unmarshal
 #endif
     },
+#endif
+#if CC_GetTestResult
     {TPM_CC_GetTestResult, "TPM2_GetTestResult",
      NULL,
      (UnmarshalOutFunction_t)TSS_GetTestResult_Out_Unmarshalu
@@ -115,6 +124,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,NULL
 #endif
     },
+#endif
+#if CC_StartAuthSession
     {TPM_CC_StartAuthSession, "TPM2_StartAuthSession",
      (MarshalInFunction_t)TSS_StartAuthSession_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_StartAuthSession_Out_Unmarshalu
@@ -122,6 +133,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)StartAuthSession_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyRestart
     {TPM_CC_PolicyRestart, "TPM2_PolicyRestart",
      (MarshalInFunction_t)TSS_PolicyRestart_In_Marshalu,
      NULL
@@ -129,6 +142,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyRestart_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Create
     {TPM_CC_Create, "TPM2_Create",
      (MarshalInFunction_t)TSS_Create_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Create_Out_Unmarshalu
@@ -136,6 +151,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Create_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Load
     {TPM_CC_Load, "TPM2_Load",
      (MarshalInFunction_t)TSS_Load_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Load_Out_Unmarshalu
@@ -143,6 +160,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Load_In_Unmarshal
 #endif
     },
+#endif
+#if CC_LoadExternal
     {TPM_CC_LoadExternal, "TPM2_LoadExternal",
      (MarshalInFunction_t)TSS_LoadExternal_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_LoadExternal_Out_Unmarshalu
@@ -150,6 +169,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)LoadExternal_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ReadPublic
     {TPM_CC_ReadPublic, "TPM2_ReadPublic",
      (MarshalInFunction_t)TSS_ReadPublic_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ReadPublic_Out_Unmarshalu
@@ -157,6 +178,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ReadPublic_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ActivateCredential
     {TPM_CC_ActivateCredential, "TPM2_ActivateCredential",
      (MarshalInFunction_t)TSS_ActivateCredential_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ActivateCredential_Out_Unmarshalu
@@ -164,6 +187,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ActivateCredential_In_Unmarshal
 #endif
     },
+#endif
+#if CC_MakeCredential
     {TPM_CC_MakeCredential, "TPM2_MakeCredential",
      (MarshalInFunction_t)TSS_MakeCredential_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_MakeCredential_Out_Unmarshalu
@@ -171,6 +196,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)MakeCredential_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Unseal
     {TPM_CC_Unseal, "TPM2_Unseal",
      (MarshalInFunction_t)TSS_Unseal_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Unseal_Out_Unmarshalu
@@ -178,6 +205,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Unseal_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ObjectChangeAuth
     {TPM_CC_ObjectChangeAuth, "TPM2_ObjectChangeAuth",
      (MarshalInFunction_t)TSS_ObjectChangeAuth_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ObjectChangeAuth_Out_Unmarshalu
@@ -185,6 +214,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ObjectChangeAuth_In_Unmarshal
 #endif
     },
+#endif
+#if CC_CreateLoaded
     {TPM_CC_CreateLoaded, "TPM2_CreateLoaded",
      (MarshalInFunction_t)TSS_CreateLoaded_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_CreateLoaded_Out_Unmarshalu
@@ -192,6 +223,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)CreateLoaded_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Duplicate
     {TPM_CC_Duplicate, "TPM2_Duplicate",
      (MarshalInFunction_t)TSS_Duplicate_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Duplicate_Out_Unmarshalu
@@ -199,6 +232,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Duplicate_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Rewrap
     {TPM_CC_Rewrap, "TPM2_Rewrap",
      (MarshalInFunction_t)TSS_Rewrap_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Rewrap_Out_Unmarshalu
@@ -206,6 +241,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Rewrap_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Import
     {TPM_CC_Import, "TPM2_Import",
      (MarshalInFunction_t)TSS_Import_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Import_Out_Unmarshalu
@@ -213,6 +250,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Import_In_Unmarshal
 #endif
     },
+#endif
+#if CC_RSA_Encrypt
     {TPM_CC_RSA_Encrypt, "TPM2_RSA_Encrypt",
      (MarshalInFunction_t)TSS_RSA_Encrypt_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_RSA_Encrypt_Out_Unmarshalu
@@ -220,6 +259,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)RSA_Encrypt_In_Unmarshal
 #endif
     },
+#endif
+#if CC_RSA_Decrypt
     {TPM_CC_RSA_Decrypt, "TPM2_RSA_Decrypt",
      (MarshalInFunction_t)TSS_RSA_Decrypt_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_RSA_Decrypt_Out_Unmarshalu
@@ -227,6 +268,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)RSA_Decrypt_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ECDH_KeyGen
     {TPM_CC_ECDH_KeyGen, "TPM2_ECDH_KeyGen",
      (MarshalInFunction_t)TSS_ECDH_KeyGen_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ECDH_KeyGen_Out_Unmarshalu
@@ -234,6 +277,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ECDH_KeyGen_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ECDH_ZGen
     {TPM_CC_ECDH_ZGen, "TPM2_ECDH_ZGen",
      (MarshalInFunction_t)TSS_ECDH_ZGen_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ECDH_ZGen_Out_Unmarshalu
@@ -241,6 +286,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ECDH_ZGen_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ECC_Encrypt
     {TPM_CC_ECC_Encrypt, "TPM2_ECC_Encrypt",
      (MarshalInFunction_t)TSS_ECC_Encrypt_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ECC_Encrypt_Out_Unmarshalu
@@ -248,6 +295,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ECC_Encrypt_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ECC_Decrypt
     {TPM_CC_ECC_Decrypt, "TPM2_ECC_Decrypt",
      (MarshalInFunction_t)TSS_ECC_Decrypt_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ECC_Decrypt_Out_Unmarshalu
@@ -255,6 +304,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ECC_Decrypt_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ECC_Parameters
     {TPM_CC_ECC_Parameters, "TPM2_ECC_Parameters",
      (MarshalInFunction_t)TSS_ECC_Parameters_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ECC_Parameters_Out_Unmarshalu
@@ -262,6 +313,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ECC_Parameters_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ZGen_2Phase
     {TPM_CC_ZGen_2Phase, "TPM2_ZGen_2Phase",
      (MarshalInFunction_t)TSS_ZGen_2Phase_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ZGen_2Phase_Out_Unmarshalu
@@ -269,6 +322,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ZGen_2Phase_In_Unmarshal
 #endif
     },
+#endif
+#if CC_EncryptDecrypt
     {TPM_CC_EncryptDecrypt, "TPM2_EncryptDecrypt",
      (MarshalInFunction_t)TSS_EncryptDecrypt_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_EncryptDecrypt_Out_Unmarshalu
@@ -276,6 +331,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)EncryptDecrypt_In_Unmarshal
 #endif
     },
+#endif
+#if CC_EncryptDecrypt2
     {TPM_CC_EncryptDecrypt2, "TPM2_EncryptDecrypt2",
      (MarshalInFunction_t)TSS_EncryptDecrypt2_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_EncryptDecrypt2_Out_Unmarshalu
@@ -283,6 +340,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)EncryptDecrypt2_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Hash
     {TPM_CC_Hash, "TPM2_Hash",
      (MarshalInFunction_t)TSS_Hash_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Hash_Out_Unmarshalu
@@ -290,6 +349,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Hash_In_Unmarshal
 #endif
     },
+#endif
+#if CC_HMAC
     {TPM_CC_HMAC, "TPM2_HMAC",
      (MarshalInFunction_t)TSS_HMAC_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_HMAC_Out_Unmarshalu
@@ -297,6 +358,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)HMAC_In_Unmarshal
 #endif
     },
+#endif
+#if CC_GetRandom
     {TPM_CC_GetRandom, "TPM2_GetRandom",
      (MarshalInFunction_t)TSS_GetRandom_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_GetRandom_Out_Unmarshalu
@@ -304,6 +367,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)GetRandom_In_Unmarshal
 #endif
     },
+#endif
+#if CC_StirRandom
     {TPM_CC_StirRandom, "TPM2_StirRandom",
      (MarshalInFunction_t)TSS_StirRandom_In_Marshalu,
      NULL
@@ -311,6 +376,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)StirRandom_In_Unmarshal
 #endif
     },
+#endif
+#if CC_HMAC_Start
     {TPM_CC_HMAC_Start, "TPM2_HMAC_Start",
      (MarshalInFunction_t)TSS_HMAC_Start_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_HMAC_Start_Out_Unmarshalu
@@ -318,6 +385,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)HMAC_Start_In_Unmarshal
 #endif
     },
+#endif
+#if CC_HashSequenceStart
     {TPM_CC_HashSequenceStart, "TPM2_HashSequenceStart",
      (MarshalInFunction_t)TSS_HashSequenceStart_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_HashSequenceStart_Out_Unmarshalu
@@ -325,6 +394,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)HashSequenceStart_In_Unmarshal
 #endif
     },
+#endif
+#if CC_SequenceUpdate
     {TPM_CC_SequenceUpdate, "TPM2_SequenceUpdate",
      (MarshalInFunction_t)TSS_SequenceUpdate_In_Marshalu,
      NULL
@@ -332,6 +403,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)SequenceUpdate_In_Unmarshal
 #endif
     },
+#endif
+#if CC_SequenceComplete
     {TPM_CC_SequenceComplete, "TPM2_SequenceComplete",
      (MarshalInFunction_t)TSS_SequenceComplete_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_SequenceComplete_Out_Unmarshalu
@@ -339,6 +412,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)SequenceComplete_In_Unmarshal
 #endif
     },
+#endif
+#if CC_EventSequenceComplete
     {TPM_CC_EventSequenceComplete, "TPM2_EventSequenceComplete",
      (MarshalInFunction_t)TSS_EventSequenceComplete_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_EventSequenceComplete_Out_Unmarshalu
@@ -346,6 +421,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)EventSequenceComplete_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Certify
     {TPM_CC_Certify, "TPM2_Certify",
      (MarshalInFunction_t)TSS_Certify_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Certify_Out_Unmarshalu
@@ -353,6 +430,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Certify_In_Unmarshal
 #endif
     },
+#endif
+#if CC_CertifyX509
     {TPM_CC_CertifyX509, "TPM2_CertifyX509",
      (MarshalInFunction_t)TSS_CertifyX509_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_CertifyX509_Out_Unmarshalu
@@ -360,6 +439,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)CertifyX509_In_Unmarshal
 #endif
     },
+#endif
+#if CC_CertifyCreation
     {TPM_CC_CertifyCreation, "TPM2_CertifyCreation",
      (MarshalInFunction_t)TSS_CertifyCreation_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_CertifyCreation_Out_Unmarshalu
@@ -367,6 +448,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)CertifyCreation_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Quote
     {TPM_CC_Quote, "TPM2_Quote",
      (MarshalInFunction_t)TSS_Quote_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Quote_Out_Unmarshalu
@@ -374,6 +457,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Quote_In_Unmarshal
 #endif
     },
+#endif
+#if CC_GetSessionAuditDigest
     {TPM_CC_GetSessionAuditDigest, "TPM2_GetSessionAuditDigest",
      (MarshalInFunction_t)TSS_GetSessionAuditDigest_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_GetSessionAuditDigest_Out_Unmarshalu
@@ -381,6 +466,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)GetSessionAuditDigest_In_Unmarshal
 #endif
     },
+#endif
+#if CC_GetCommandAuditDigest
     {TPM_CC_GetCommandAuditDigest, "TPM2_GetCommandAuditDigest",
      (MarshalInFunction_t)TSS_GetCommandAuditDigest_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_GetCommandAuditDigest_Out_Unmarshalu
@@ -388,6 +475,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)GetCommandAuditDigest_In_Unmarshal
 #endif
     },
+#endif
+#if CC_GetTime
     {TPM_CC_GetTime, "TPM2_GetTime",
      (MarshalInFunction_t)TSS_GetTime_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_GetTime_Out_Unmarshalu
@@ -395,6 +484,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)GetTime_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Commit
     {TPM_CC_Commit, "TPM2_Commit",
      (MarshalInFunction_t)TSS_Commit_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Commit_Out_Unmarshalu
@@ -402,6 +493,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Commit_In_Unmarshal
 #endif
     },
+#endif
+#if CC_EC_Ephemeral
     {TPM_CC_EC_Ephemeral, "TPM2_EC_Ephemeral",
      (MarshalInFunction_t)TSS_EC_Ephemeral_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_EC_Ephemeral_Out_Unmarshalu
@@ -409,6 +502,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)EC_Ephemeral_In_Unmarshal
 #endif
     },
+#endif
+#if CC_VerifySignature
     {TPM_CC_VerifySignature, "TPM2_VerifySignature",
      (MarshalInFunction_t)TSS_VerifySignature_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_VerifySignature_Out_Unmarshalu
@@ -416,6 +511,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)VerifySignature_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Sign
     {TPM_CC_Sign, "TPM2_Sign",
      (MarshalInFunction_t)TSS_Sign_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_Sign_Out_Unmarshalu
@@ -423,6 +520,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Sign_In_Unmarshal
 #endif
     },
+#endif
+#if CC_SetCommandCodeAuditStatus
     {TPM_CC_SetCommandCodeAuditStatus, "TPM2_SetCommandCodeAuditStatus",
      (MarshalInFunction_t)TSS_SetCommandCodeAuditStatus_In_Marshalu,
      NULL
@@ -430,6 +529,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)SetCommandCodeAuditStatus_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PCR_Extend
     {TPM_CC_PCR_Extend, "TPM2_PCR_Extend",
      (MarshalInFunction_t)TSS_PCR_Extend_In_Marshalu,
      NULL
@@ -437,6 +538,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PCR_Extend_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PCR_Event
     {TPM_CC_PCR_Event, "TPM2_PCR_Event",
      (MarshalInFunction_t)TSS_PCR_Event_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_PCR_Event_Out_Unmarshalu
@@ -444,6 +547,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PCR_Event_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PCR_Read
     {TPM_CC_PCR_Read, "TPM2_PCR_Read",
      (MarshalInFunction_t)TSS_PCR_Read_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_PCR_Read_Out_Unmarshalu
@@ -451,6 +556,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PCR_Read_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PCR_Allocate
     {TPM_CC_PCR_Allocate, "TPM2_PCR_Allocate",
      (MarshalInFunction_t)TSS_PCR_Allocate_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_PCR_Allocate_Out_Unmarshalu
@@ -458,6 +565,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PCR_Allocate_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PCR_SetAuthPolicy
     {TPM_CC_PCR_SetAuthPolicy, "TPM2_PCR_SetAuthPolicy",
      (MarshalInFunction_t)TSS_PCR_SetAuthPolicy_In_Marshalu,
      NULL
@@ -465,6 +574,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PCR_SetAuthPolicy_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PCR_SetAuthValue
     {TPM_CC_PCR_SetAuthValue, "TPM2_PCR_SetAuthValue",
      (MarshalInFunction_t)TSS_PCR_SetAuthValue_In_Marshalu,
      NULL
@@ -472,6 +583,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PCR_SetAuthValue_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PCR_Reset
     {TPM_CC_PCR_Reset, "TPM2_PCR_Reset",
      (MarshalInFunction_t)TSS_PCR_Reset_In_Marshalu,
      NULL
@@ -479,6 +592,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PCR_Reset_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicySigned
     {TPM_CC_PolicySigned, "TPM2_PolicySigned",
      (MarshalInFunction_t)TSS_PolicySigned_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_PolicySigned_Out_Unmarshalu
@@ -486,6 +601,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicySigned_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicySecret
     {TPM_CC_PolicySecret, "TPM2_PolicySecret",
      (MarshalInFunction_t)TSS_PolicySecret_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_PolicySecret_Out_Unmarshalu
@@ -493,6 +610,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicySecret_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyTicket
     {TPM_CC_PolicyTicket, "TPM2_PolicyTicket",
      (MarshalInFunction_t)TSS_PolicyTicket_In_Marshalu,
      NULL
@@ -500,6 +619,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyTicket_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyOR
     {TPM_CC_PolicyOR, "TPM2_PolicyOR",
      (MarshalInFunction_t)TSS_PolicyOR_In_Marshalu,
      NULL
@@ -507,6 +628,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyOR_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyPCR
     {TPM_CC_PolicyPCR, "TPM2_PolicyPCR",
      (MarshalInFunction_t)TSS_PolicyPCR_In_Marshalu,
      NULL
@@ -514,6 +637,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyPCR_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyLocality
     {TPM_CC_PolicyLocality, "TPM2_PolicyLocality",
      (MarshalInFunction_t)TSS_PolicyLocality_In_Marshalu,
      NULL
@@ -521,6 +646,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyLocality_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyNV
     {TPM_CC_PolicyNV, "TPM2_PolicyNV",
      (MarshalInFunction_t)TSS_PolicyNV_In_Marshalu,
      NULL
@@ -528,6 +655,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyNV_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyAuthorizeNV
     {TPM_CC_PolicyAuthorizeNV, "TPM2_PolicyAuthorizeNV",
      (MarshalInFunction_t)TSS_PolicyAuthorizeNV_In_Marshalu,
      NULL
@@ -535,6 +664,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyAuthorizeNV_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyCounterTimer
     {TPM_CC_PolicyCounterTimer, "TPM2_PolicyCounterTimer",
      (MarshalInFunction_t)TSS_PolicyCounterTimer_In_Marshalu,
      NULL
@@ -542,6 +673,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyCounterTimer_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyCommandCode
     {TPM_CC_PolicyCommandCode, "TPM2_PolicyCommandCode",
      (MarshalInFunction_t)TSS_PolicyCommandCode_In_Marshalu,
      NULL
@@ -549,6 +682,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyCommandCode_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyPhysicalPresence
     {TPM_CC_PolicyPhysicalPresence, "TPM2_PolicyPhysicalPresence",
      (MarshalInFunction_t)TSS_PolicyPhysicalPresence_In_Marshalu,
      NULL
@@ -556,6 +691,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyPhysicalPresence_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyCpHash
     {TPM_CC_PolicyCpHash, "TPM2_PolicyCpHash",
      (MarshalInFunction_t)TSS_PolicyCpHash_In_Marshalu,
      NULL
@@ -563,6 +700,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyCpHash_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyNameHash
     {TPM_CC_PolicyNameHash, "TPM2_PolicyNameHash",
      (MarshalInFunction_t)TSS_PolicyNameHash_In_Marshalu,
      NULL
@@ -570,6 +709,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyNameHash_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyDuplicationSelect
     {TPM_CC_PolicyDuplicationSelect, "TPM2_PolicyDuplicationSelect",
      (MarshalInFunction_t)TSS_PolicyDuplicationSelect_In_Marshalu,
      NULL
@@ -577,6 +718,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyDuplicationSelect_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyAuthorize
     {TPM_CC_PolicyAuthorize, "TPM2_PolicyAuthorize",
      (MarshalInFunction_t)TSS_PolicyAuthorize_In_Marshalu,
      NULL
@@ -584,6 +727,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyAuthorize_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyAuthValue
     {TPM_CC_PolicyAuthValue, "TPM2_PolicyAuthValue",
      (MarshalInFunction_t)TSS_PolicyAuthValue_In_Marshalu,
      NULL
@@ -591,6 +736,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyAuthValue_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyPassword
     {TPM_CC_PolicyPassword, "TPM2_PolicyPassword",
      (MarshalInFunction_t)TSS_PolicyPassword_In_Marshalu,
      NULL
@@ -598,6 +745,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyPassword_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyGetDigest
     {TPM_CC_PolicyGetDigest, "TPM2_PolicyGetDigest",
      (MarshalInFunction_t)TSS_PolicyGetDigest_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_PolicyGetDigest_Out_Unmarshalu
@@ -605,6 +754,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyGetDigest_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyNvWritten
     {TPM_CC_PolicyNvWritten, "TPM2_PolicyNvWritten",
      (MarshalInFunction_t)TSS_PolicyNvWritten_In_Marshalu,
      NULL
@@ -612,6 +763,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyNvWritten_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyTemplate
     {TPM_CC_PolicyTemplate, "TPM2_PolicyTemplate",
      (MarshalInFunction_t)TSS_PolicyTemplate_In_Marshalu,
      NULL
@@ -619,6 +772,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyTemplate_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyCapability
     {TPM_CC_PolicyCapability, "TPM2_PolicyCapability",
      (MarshalInFunction_t)TSS_PolicyCapability_In_Marshalu,
      NULL
@@ -626,6 +781,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyCapability_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PolicyParameters
     {TPM_CC_PolicyParameters, "TPM2_PolicyParameters",
      (MarshalInFunction_t)TSS_PolicyParameters_In_Marshalu,
      NULL
@@ -633,6 +790,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PolicyParameters_In_Unmarshal
 #endif
     },
+#endif
+#if CC_CreatePrimary
     {TPM_CC_CreatePrimary, "TPM2_CreatePrimary",
      (MarshalInFunction_t)TSS_CreatePrimary_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_CreatePrimary_Out_Unmarshalu
@@ -640,6 +799,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)CreatePrimary_In_Unmarshal
 #endif
     },
+#endif
+#if CC_HierarchyControl
     {TPM_CC_HierarchyControl, "TPM2_HierarchyControl",
      (MarshalInFunction_t)TSS_HierarchyControl_In_Marshalu,
      NULL
@@ -647,6 +808,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)HierarchyControl_In_Unmarshal
 #endif
     },
+#endif
+#if CC_SetPrimaryPolicy
     {TPM_CC_SetPrimaryPolicy, "TPM2_SetPrimaryPolicy",
      (MarshalInFunction_t)TSS_SetPrimaryPolicy_In_Marshalu,
      NULL
@@ -654,6 +817,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)SetPrimaryPolicy_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ChangePPS
     {TPM_CC_ChangePPS, "TPM2_ChangePPS",
      (MarshalInFunction_t)TSS_ChangePPS_In_Marshalu,
      NULL
@@ -661,6 +826,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ChangePPS_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ChangeEPS
     {TPM_CC_ChangeEPS, "TPM2_ChangeEPS",
      (MarshalInFunction_t)TSS_ChangeEPS_In_Marshalu,
      NULL
@@ -668,6 +835,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ChangeEPS_In_Unmarshal
 #endif
     },
+#endif
+#if CC_Clear
     {TPM_CC_Clear, "TPM2_Clear",
      (MarshalInFunction_t)TSS_Clear_In_Marshalu,
      NULL
@@ -675,6 +844,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)Clear_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ClearControl
     {TPM_CC_ClearControl, "TPM2_ClearControl",
      (MarshalInFunction_t)TSS_ClearControl_In_Marshalu,
      NULL
@@ -682,6 +853,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ClearControl_In_Unmarshal
 #endif
     },
+#endif
+#if CC_HierarchyChangeAuth
     {TPM_CC_HierarchyChangeAuth, "TPM2_HierarchyChangeAuth",
      (MarshalInFunction_t)TSS_HierarchyChangeAuth_In_Marshalu,
      NULL
@@ -689,6 +862,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)HierarchyChangeAuth_In_Unmarshal
 #endif
     },
+#endif
+#if CC_DictionaryAttackLockReset
     {TPM_CC_DictionaryAttackLockReset, "TPM2_DictionaryAttackLockReset",
      (MarshalInFunction_t)TSS_DictionaryAttackLockReset_In_Marshalu,
      NULL
@@ -696,6 +871,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)DictionaryAttackLockReset_In_Unmarshal
 #endif
     },
+#endif
+#if CC_DictionaryAttackParameters
     {TPM_CC_DictionaryAttackParameters, "TPM2_DictionaryAttackParameters",
      (MarshalInFunction_t)TSS_DictionaryAttackParameters_In_Marshalu,
      NULL
@@ -703,6 +880,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)DictionaryAttackParameters_In_Unmarshal
 #endif
     },
+#endif
+#if CC_PP_Commands
     {TPM_CC_PP_Commands, "TPM2_PP_Commands",
      (MarshalInFunction_t)TSS_PP_Commands_In_Marshalu,
      NULL
@@ -710,6 +889,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)PP_Commands_In_Unmarshal
 #endif
     },
+#endif
+#if CC_SetAlgorithmSet
     {TPM_CC_SetAlgorithmSet, "TPM2_SetAlgorithmSet",
      (MarshalInFunction_t)TSS_SetAlgorithmSet_In_Marshalu,
      NULL
@@ -717,6 +898,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)SetAlgorithmSet_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ContextSave
     {TPM_CC_ContextSave, "TPM2_ContextSave",
      (MarshalInFunction_t)TSS_ContextSave_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ContextSave_Out_Unmarshalu
@@ -724,6 +907,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ContextSave_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ContextLoad
     {TPM_CC_ContextLoad, "TPM2_ContextLoad",
      (MarshalInFunction_t)TSS_ContextLoad_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_ContextLoad_Out_Unmarshalu
@@ -731,6 +916,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ContextLoad_In_Unmarshal
 #endif
     },
+#endif
+#if CC_FlushContext
     {TPM_CC_FlushContext, "TPM2_FlushContext",
      (MarshalInFunction_t)TSS_FlushContext_In_Marshalu,
      NULL
@@ -738,6 +925,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)FlushContext_In_Unmarshal
 #endif
     },
+#endif
+#if CC_EvictControl
     {TPM_CC_EvictControl, "TPM2_EvictControl",
      (MarshalInFunction_t)TSS_EvictControl_In_Marshalu,
      NULL
@@ -745,6 +934,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)EvictControl_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ReadClock
     {TPM_CC_ReadClock, "TPM2_ReadClock",
      NULL,
      (UnmarshalOutFunction_t)TSS_ReadClock_Out_Unmarshalu
@@ -752,6 +943,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,NULL
 #endif
     },
+#endif
+#if CC_ClockSet
     {TPM_CC_ClockSet, "TPM2_ClockSet",
      (MarshalInFunction_t)TSS_ClockSet_In_Marshalu,
      NULL
@@ -759,6 +952,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ClockSet_In_Unmarshal
 #endif
     },
+#endif
+#if CC_ClockRateAdjust
     {TPM_CC_ClockRateAdjust, "TPM2_ClockRateAdjust",
      (MarshalInFunction_t)TSS_ClockRateAdjust_In_Marshalu,
      NULL
@@ -766,6 +961,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)ClockRateAdjust_In_Unmarshal
 #endif
     },
+#endif
+#if CC_GetCapability
     {TPM_CC_GetCapability, "TPM2_GetCapability",
      (MarshalInFunction_t)TSS_GetCapability_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_GetCapability_Out_Unmarshalu
@@ -773,6 +970,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)GetCapability_In_Unmarshal
 #endif
     },
+#endif
+#if CC_TestParms
     {TPM_CC_TestParms, "TPM2_TestParms",
      (MarshalInFunction_t)TSS_TestParms_In_Marshalu,
      NULL
@@ -780,6 +979,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)TestParms_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_DefineSpace
     {TPM_CC_NV_DefineSpace, "TPM2_NV_DefineSpace",
      (MarshalInFunction_t)TSS_NV_DefineSpace_In_Marshalu,
      NULL
@@ -787,6 +988,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_DefineSpace_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_UndefineSpace
     {TPM_CC_NV_UndefineSpace, "TPM2_NV_UndefineSpace",
      (MarshalInFunction_t)TSS_NV_UndefineSpace_In_Marshalu,
      NULL
@@ -794,6 +997,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_UndefineSpace_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_UndefineSpaceSpecial
     {TPM_CC_NV_UndefineSpaceSpecial, "TPM2_NV_UndefineSpaceSpecial",
      (MarshalInFunction_t)TSS_NV_UndefineSpaceSpecial_In_Marshalu,
      NULL
@@ -801,6 +1006,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_UndefineSpaceSpecial_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_ReadPublic
     {TPM_CC_NV_ReadPublic, "TPM2_NV_ReadPublic",
      (MarshalInFunction_t)TSS_NV_ReadPublic_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_NV_ReadPublic_Out_Unmarshalu
@@ -808,6 +1015,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_ReadPublic_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_Write
     {TPM_CC_NV_Write, "TPM2_NV_Write",
      (MarshalInFunction_t)TSS_NV_Write_In_Marshalu,
      NULL
@@ -815,6 +1024,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_Write_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_Increment
     {TPM_CC_NV_Increment, "TPM2_NV_Increment",
      (MarshalInFunction_t)TSS_NV_Increment_In_Marshalu,
      NULL
@@ -822,6 +1033,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_Increment_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_Extend
     {TPM_CC_NV_Extend, "TPM2_NV_Extend",
      (MarshalInFunction_t)TSS_NV_Extend_In_Marshalu,
      NULL
@@ -829,6 +1042,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_Extend_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_SetBits
     {TPM_CC_NV_SetBits, "TPM2_NV_SetBits",
      (MarshalInFunction_t)TSS_NV_SetBits_In_Marshalu,
      NULL
@@ -836,6 +1051,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_SetBits_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_WriteLock
     {TPM_CC_NV_WriteLock, "TPM2_NV_WriteLock",
      (MarshalInFunction_t)TSS_NV_WriteLock_In_Marshalu,
      NULL
@@ -843,6 +1060,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_WriteLock_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_GlobalWriteLock
     {TPM_CC_NV_GlobalWriteLock, "TPM2_NV_GlobalWriteLock",
      (MarshalInFunction_t)TSS_NV_GlobalWriteLock_In_Marshalu,
      NULL
@@ -850,6 +1069,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_GlobalWriteLock_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_Read
     {TPM_CC_NV_Read, "TPM2_NV_Read",
      (MarshalInFunction_t)TSS_NV_Read_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_NV_Read_Out_Unmarshalu
@@ -857,6 +1078,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_Read_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_ReadLock
     {TPM_CC_NV_ReadLock, "TPM2_NV_ReadLock",
      (MarshalInFunction_t)TSS_NV_ReadLock_In_Marshalu,
      NULL
@@ -864,6 +1087,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_ReadLock_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_ChangeAuth
     {TPM_CC_NV_ChangeAuth, "TPM2_NV_ChangeAuth",
      (MarshalInFunction_t)TSS_NV_ChangeAuth_In_Marshalu,
      NULL
@@ -871,6 +1096,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_ChangeAuth_In_Unmarshal
 #endif
     },
+#endif
+#if CC_NV_Certify
     {TPM_CC_NV_Certify, "TPM2_NV_Certify",
      (MarshalInFunction_t)TSS_NV_Certify_In_Marshalu,
      (UnmarshalOutFunction_t)TSS_NV_Certify_Out_Unmarshalu
@@ -878,7 +1105,9 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)NV_Certify_In_Unmarshal
 #endif
     },
+#endif
 #ifdef TPM_TSS_NUVOTON
+#if CC_NTC2_PreConfig
     {NTC2_CC_PreConfig,"NTC2_CC_PreConfig",
      (MarshalInFunction_t)TSS_NTC2_PreConfig_In_Marshalu,
      NULL
@@ -886,6 +1115,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,(UnmarshalInFunction_t)TSS_NTC2_PreConfig_In_Unmarshalu
 #endif
     },
+#endif
+#if CC_NTC2_LockPreConfig
     {NTC2_CC_LockPreConfig,"NTC2_CC_LockPreConfig",
      NULL,
      NULL
@@ -893,6 +1124,8 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,NULL
 #endif
     },
+#endif
+#if CC_NTC2_GetConfig
     {NTC2_CC_GetConfig,"NTC2_CC_GetConfig",
      NULL,
      (UnmarshalOutFunction_t)TSS_NTC2_GetConfig_Out_Unmarshalu
@@ -900,6 +1133,7 @@ static const MARSHAL_TABLE marshalTable [] = {
      ,NULL
 #endif
     },
+#endif
 
 #endif	/* TPM_TSS_NUVOTON */
 };
@@ -979,7 +1213,7 @@ TPM_RC TSS_Marshal(TSS_AUTH_CONTEXT *tssAuthContext,
     if (rc == 0) {
 	/* make a copy of the command buffer and size since the marshal functions move them */
 	buffer = tssAuthContext->commandBuffer;
-	size = sizeof(tssAuthContext->commandBuffer);
+	size = tssAuthContext->commandBufferSize;
 	/* marshal header, preliminary tag and command size */
 	rc = TSS_TPMI_ST_COMMAND_TAG_Marshalu(&tag, &tssAuthContext->commandSize, &buffer, &size);
     }
@@ -1033,7 +1267,7 @@ TPM_RC TSS_Marshal(TSS_AUTH_CONTEXT *tssAuthContext,
 			    sizeof(COMMAND_PARAMETERS));	/* freed @1 */
 	}
 	if (rc == 0) {
-	    size = (uint32_t)(sizeof(tssAuthContext->commandBuffer) -
+	    size = (uint32_t)(tssAuthContext->commandBufferSize -
 			      (tssAuthContext->commandHandleCount * sizeof(TPM_HANDLE)));
 	    rc = tssAuthContext->unmarshalInFunction(target, &bufferu, &size, handles);
 	    if ((rc != 0) && tssVerbose) {
@@ -1171,7 +1405,7 @@ TPM_RC TSS_SetCmdAuths(TSS_AUTH_CONTEXT *tssAuthContext, ...)
 		cpBufferSize +
 		sizeof (uint32_t) +		/* authorizationSize */
 		authorizationSize		/* authorization area */
-		> tssAuthContext->commandBuffer + sizeof(tssAuthContext->commandBuffer)) {
+		> tssAuthContext->commandBuffer + tssAuthContext->commandBufferSize) {
 
 		if (tssVerbose)
 		    printf("TSS_SetCmdAuths: Command authorizations overflow command buffer\n");
@@ -1571,3 +1805,63 @@ TPM_RC TSS_SetResponseDecryptParam(TSS_AUTH_CONTEXT *tssAuthContext,
     }
     return rc;
 }
+
+/* TSS_AuthSave() saves the marshaled command and the authorization context state after
+   TSS_Marshal(), before the authorizations are added.
+
+   prepared->commandBuffer must be NULL on entry.
+*/
+
+TPM_RC TSS_AuthSave(TSS_PREPARED *prepared,
+		    TSS_AUTH_CONTEXT *tssAuthContext)
+{
+    TPM_RC 	rc = 0;
+
+    if (rc == 0) {
+	rc = TSS_Malloc(&prepared->commandBuffer, tssAuthContext->commandSize);
+    }
+    if (rc == 0) {
+	memcpy(prepared->commandBuffer, tssAuthContext->commandBuffer,
+	       tssAuthContext->commandSize);
+	prepared->cpOffset = (uint32_t)(tssAuthContext->cpBuffer - tssAuthContext->commandBuffer);
+	prepared->authContext = *tssAuthContext;
+	prepared->authContext.commandBuffer = NULL;
+	prepared->authContext.responseBuffer = NULL;
+	prepared->authContext.cpBuffer = NULL;
+    }
+    return rc;
+}
+
+/* TSS_AuthRestore() restores the authorization context to the state saved by TSS_AuthSave().
+
+   The command buffer contents are replaced by the saved marshaled command.  The authorizations are
+   added, parameters encrypted, etc. as for a newly marshaled command.
+*/
+
+TPM_RC TSS_AuthRestore(TSS_AUTH_CONTEXT *tssAuthContext,
+		       TSS_PREPARED *prepared)
+{
+    TPM_RC 	rc = 0;
+    uint8_t 	*commandBuffer = tssAuthContext->commandBuffer;
+    uint32_t	commandBufferSize = tssAuthContext->commandBufferSize;
+    uint8_t 	*responseBuffer = tssAuthContext->responseBuffer;
+    uint32_t	responseBufferSize = tssAuthContext->responseBufferSize;
+
+    if (rc == 0) {
+	if (prepared->authContext.commandSize > commandBufferSize) {
+	    if (tssVerbose) printf("TSS_AuthRestore: command size %u greater than buffer %u\n",
+				   prepared->authContext.commandSize, commandBufferSize);
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	}
+    }
+    if (rc == 0) {
+	*tssAuthContext = prepared->authContext;
+	tssAuthContext->commandBuffer = commandBuffer;
+	tssAuthContext->commandBufferSize = commandBufferSize;
+	tssAuthContext->responseBuffer = responseBuffer;
+	tssAuthContext->responseBufferSize = responseBufferSize;
+	memcpy(commandBuffer, prepared->commandBuffer, prepared->authContext.commandSize);
+	tssAuthContext->cpBuffer = commandBuffer + prepared->cpOffset;
+    }
+    return rc;
+}
@@ -45,6 +45,15 @@
 #include <ibmtss/tss.h>
 #include "tssccattributes.h"
 
+/* A prepared command holds the marshaled command without authorizations and the authorization
+   context state that TSS_Marshal() set */
+
+struct TSS_PREPARED {
+    TSS_AUTH_CONTEXT	authContext;	/* buffer pointers are not used */
+    uint8_t		*commandBuffer;	/* marshaled command, authContext.commandSize bytes */
+    uint32_t		cpOffset;	/* offset of the command parameters */
+};
+
 TPM_RC TSS_Marshal(TSS_AUTH_CONTEXT *tssAuthContext,
 		   COMMAND_PARAMETERS *in,
 		   TPM_CC commandCode);
@@ -83,4 +92,10 @@ TPM_RC TSS_SetResponseDecryptParam(TSS_AUTH_CONTEXT *tssAuthContext,
 				   uint32_t decryptParamSize,
 				   uint8_t *decryptParamBuffer);
 
+TPM_RC TSS_AuthSave(TSS_PREPARED *prepared,
+		    TSS_AUTH_CONTEXT *tssAuthContext);
+
+TPM_RC TSS_AuthRestore(TSS_AUTH_CONTEXT *tssAuthContext,
+		       TSS_PREPARED *prepared);
+
 #endif
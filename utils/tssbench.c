@@ -0,0 +1,1443 @@
+/********************************************************************************/
+/*										*/
+/*			      TSS Microbenchmarks				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* 
+   tssbench is a microbenchmark suite for the TSS internals.  There is no TPM.
+
+   Each benchmark times a TSS function in a loop and prints one CSV line:
+
+   benchmark,iterations,ns_per_op,ops_per_sec,allocs_per_op
+
+   allocs_per_op counts the calls to malloc(), calloc(), and realloc() from the program, the TSS
+   libraries, and the crypto library.  It is -1 where the count is not available (non-glibc).
+
+   marshal-* and unmarshal-* use the per-command marshal functions for representative commands.
+
+   kdfa, hmac, and aes-cfb are the session crypto primitives.
+
+   execute-* run the complete TSS_Execute() path, including session state files, against a mock
+   TPM registered through TSS_SetTransport().  The mock supports only what the benchmarks send:
+   PCR_Extend, GetRandom, StartAuthSession, and FlushContext, with SHA-256 unbound, unsalted
+   sessions and AES-128 CFB response encryption.  It cannot decrypt a salt, so the salted
+   benchmarks time StartAuthSession (salt generation and session key derivation) and
+   FlushContext.  They write the salt key public area hp81ffff00.bin and hp81ffff01.bin to the
+   TPM_DATA_DIR and remove them afterwards.
+
+   event2-line-read, ima-event2-readbuffer, and efi-dbx-readbuffer parse large synthetic logs.
+   One operation is the entire log, BENCH_LOG_EVENTS events or a dbx with BENCH_DBX_ENTRIES
+   signatures.
+
+   Example:
+
+   tssbench -n 10000 -b execute
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef TPM_WINDOWS
+#include <windows.h>
+#endif
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tsstransmit.h>
+#include <ibmtss/tssfile.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tssmarshal.h>
+#include <ibmtss/Unmarshal_fp.h>
+#include <ibmtss/tssresponsecode.h>
+#include <ibmtss/tsscrypto.h>
+#include <ibmtss/tsscryptoh.h>
+
+#include "eventlib.h"
+#include "efilib.h"
+#include "imalib.h"
+
+#define BENCH_ITERATIONS_DEFAULT	1000
+#define BENCH_BUFFER_SIZE		4096	/* marshaled commands and responses */
+#define BENCH_CRYPTO_SIZE		1024	/* hmac and aes-cfb input */
+#define BENCH_LOG_EVENTS		1000	/* events in the event2 and IMA logs */
+#define BENCH_DBX_ENTRIES		1000	/* SHA-256 entries in the dbx signature list */
+#define BENCH_SALT_RSA_HANDLE		0x81ffff00
+#define BENCH_SALT_ECC_HANDLE		0x81ffff01
+#define BENCH_PATH_LENGTH		256
+
+/* the mock TPM state, the transport context */
+
+typedef struct {
+    uint32_t		sessionCount;	/* for the next session handle */
+    uint32_t		nonceCount;	/* for the next nonceTPM */
+} BENCH_MOCK_TPM;
+
+/* the first command session, which is all the mock uses */
+
+typedef struct {
+    TPMI_SH_AUTH_SESSION	sessionHandle;
+    TPM2B_NONCE			nonceCaller;
+    TPMA_SESSION		sessionAttributes;
+} BENCH_MOCK_AUTH;
+
+typedef struct {
+    TSS_CONTEXT		*tssContext;
+    BENCH_MOCK_TPM	mockTpm;
+    TPMI_SH_AUTH_SESSION sessionHandle;	/* execute-* HMAC session */
+    TPM_HANDLE		saltHandle;	/* execute-salted-* salt key */
+    const char		*dataDir;
+    uint8_t		buffer[BENCH_BUFFER_SIZE];
+    uint32_t		bufferLength;
+    uint8_t		*log;		/* IMA log or EFI event */
+    size_t		logLength;
+    FILE		*logFile;	/* event2 log */
+    union {
+	Sign_In		signIn;
+	Create_In	createIn;
+	Sign_Out	signOut;
+	CreatePrimary_Out createPrimaryOut;
+    } parameters;
+} BENCH_STATE;
+
+typedef TPM_RC (*BenchFunction_t)(BENCH_STATE *state);
+
+typedef struct {
+    const char		*name;
+    BenchFunction_t	setup;		/* NULL if none */
+    BenchFunction_t	run;		/* one operation */
+    BenchFunction_t	teardown;	/* NULL if none */
+} BENCH_ENTRY;
+
+static void printUsage(void);
+static TPM_RC benchRun(BENCH_STATE *state,
+		       const BENCH_ENTRY *entry,
+		       unsigned long iterations);
+static uint64_t benchNanoseconds(void);
+static void benchPublicRsa(TPMT_PUBLIC *publicArea);
+static void benchPublicEcc(TPMT_PUBLIC *publicArea);
+
+static TPM_RC benchMarshalSignInSetup(BENCH_STATE *state);
+static TPM_RC benchMarshalSignIn(BENCH_STATE *state);
+static TPM_RC benchUnmarshalSignOutSetup(BENCH_STATE *state);
+static TPM_RC benchUnmarshalSignOut(BENCH_STATE *state);
+static TPM_RC benchMarshalCreateInSetup(BENCH_STATE *state);
+static TPM_RC benchMarshalCreateIn(BENCH_STATE *state);
+static TPM_RC benchUnmarshalCreatePrimaryOutSetup(BENCH_STATE *state);
+static TPM_RC benchUnmarshalCreatePrimaryOut(BENCH_STATE *state);
+
+static TPM_RC benchKdfa(BENCH_STATE *state);
+static TPM_RC benchHmac(BENCH_STATE *state);
+static TPM_RC benchAesCfb(BENCH_STATE *state);
+
+static TPM_RC benchMockSetup(BENCH_STATE *state);
+static TPM_RC benchMockTeardown(BENCH_STATE *state);
+static TPM_RC benchMockTransmit(TSS_CONTEXT *tssContext,
+				uint8_t *responseBuffer, uint32_t *read,
+				const uint8_t *commandBuffer, uint32_t written,
+				const char *message);
+static TPM_RC benchMockResponse(uint8_t *responseBuffer,
+				uint32_t *read,
+				BENCH_MOCK_TPM *mockTpm,
+				TPM_CC commandCode,
+				const BENCH_MOCK_AUTH *auth,
+				const TPM_HANDLE *handle,
+				uint8_t *parameters,
+				uint16_t parameterSize);
+static TPM_RC benchStartSession(BENCH_STATE *state,
+				TPMI_SH_AUTH_SESSION *sessionHandle,
+				TPMI_DH_OBJECT tpmKey);
+static TPM_RC benchFlush(BENCH_STATE *state,
+			 TPMI_SH_AUTH_SESSION sessionHandle);
+static TPM_RC benchHmacSessionSetup(BENCH_STATE *state);
+static TPM_RC benchHmacSessionTeardown(BENCH_STATE *state);
+static TPM_RC benchSaltRsaSetup(BENCH_STATE *state);
+static TPM_RC benchSaltEccSetup(BENCH_STATE *state);
+static TPM_RC benchSaltTeardown(BENCH_STATE *state);
+static TPM_RC benchExecuteGetRandom(BENCH_STATE *state);
+static TPM_RC benchExecutePcrExtendPassword(BENCH_STATE *state);
+static TPM_RC benchExecutePcrExtendHmac(BENCH_STATE *state);
+static TPM_RC benchExecuteGetRandomEncrypt(BENCH_STATE *state);
+static TPM_RC benchExecuteSalted(BENCH_STATE *state);
+
+static TPM_RC benchEvent2LogSetup(BENCH_STATE *state);
+static TPM_RC benchEvent2LogRead(BENCH_STATE *state);
+static TPM_RC benchEvent2LogTeardown(BENCH_STATE *state);
+static TPM_RC benchImaLogSetup(BENCH_STATE *state);
+static TPM_RC benchImaLogRead(BENCH_STATE *state);
+static TPM_RC benchDbxSetup(BENCH_STATE *state);
+static TPM_RC benchDbxRead(BENCH_STATE *state);
+static TPM_RC benchLogTeardown(BENCH_STATE *state);
+
+static const BENCH_ENTRY benchTable[] = {
+    {"marshal-sign-in", benchMarshalSignInSetup, benchMarshalSignIn, NULL},
+    {"unmarshal-sign-out", benchUnmarshalSignOutSetup, benchUnmarshalSignOut, NULL},
+    {"marshal-create-in", benchMarshalCreateInSetup, benchMarshalCreateIn, NULL},
+    {"unmarshal-createprimary-out", benchUnmarshalCreatePrimaryOutSetup,
+     benchUnmarshalCreatePrimaryOut, NULL},
+    {"kdfa-sha256", NULL, benchKdfa, NULL},
+    {"hmac-sha256-1k", NULL, benchHmac, NULL},
+    {"aes128-cfb-1k", NULL, benchAesCfb, NULL},
+    {"execute-getrandom", benchMockSetup, benchExecuteGetRandom, benchMockTeardown},
+    {"execute-pcrextend-pw", benchMockSetup, benchExecutePcrExtendPassword, benchMockTeardown},
+    {"execute-pcrextend-hmac", benchHmacSessionSetup, benchExecutePcrExtendHmac,
+     benchHmacSessionTeardown},
+    {"execute-getrandom-hmac-enc", benchHmacSessionSetup, benchExecuteGetRandomEncrypt,
+     benchHmacSessionTeardown},
+    {"execute-salted-rsa", benchSaltRsaSetup, benchExecuteSalted, benchSaltTeardown},
+    {"execute-salted-ecc", benchSaltEccSetup, benchExecuteSalted, benchSaltTeardown},
+    {"event2-line-read", benchEvent2LogSetup, benchEvent2LogRead, benchEvent2LogTeardown},
+    {"ima-event2-readbuffer", benchImaLogSetup, benchImaLogRead, benchLogTeardown},
+    {"efi-dbx-readbuffer", benchDbxSetup, benchDbxRead, benchLogTeardown},
+};
+
+static const TSS_TRANSPORT benchMockTransport = {
+    benchMockTransmit,
+    NULL,
+    NULL,
+    NULL
+};
+
+/* Allocation counting.  With glibc, the program's malloc(), calloc(), and realloc() interpose on
+   the libraries' calls and forward to the glibc implementation.  free() is not wrapped. */
+
+#ifdef __GLIBC__
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static unsigned long benchAllocCount = 0;
+
+void *malloc(size_t size)
+{
+    benchAllocCount++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    benchAllocCount++;
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    benchAllocCount++;
+    return __libc_realloc(ptr, size);
+}
+
+#define BENCH_ALLOC_COUNTING	1
+#endif	/* __GLIBC__ */
+
+extern int tssUtilsVerbose;
+
+int main(int argc, char *argv[])
+{
+    TPM_RC		rc = 0;
+    int			i;    			/* argc iterator */
+    unsigned long	iterations = BENCH_ITERATIONS_DEFAULT;
+    const char		*benchName = NULL;
+    int			list = FALSE;
+    size_t		b;
+    BENCH_STATE		state;
+
+    setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
+    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "1");
+    tssUtilsVerbose = FALSE;
+    
+    for (i=1 ; (i<argc) && (rc == 0) ; i++) {
+	if (strcmp(argv[i],"-n") == 0) {
+	    i++;
+	    if (i < argc) {
+		iterations = strtoul(argv[i], NULL, 0);
+		if (iterations == 0) {
+		    printf("Bad parameter %s for -n\n", argv[i]);
+		    printUsage();
+		}
+	    }
+	    else {
+		printf("-n option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-b") == 0) {
+	    i++;
+	    if (i < argc) {
+		benchName = argv[i];
+	    }
+	    else {
+		printf("-b option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-l") == 0) {
+	    list = TRUE;
+	}
+	else if (strcmp(argv[i],"-h") == 0) {
+	    printUsage();
+	}
+	else if (strcmp(argv[i],"-v") == 0) {
+	    tssUtilsVerbose = TRUE;
+	    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "2");
+	}
+	else {
+	    printf("\n%s is not a valid option\n", argv[i]);
+	    printUsage();
+	}
+    }
+    if (list) {
+	for (b = 0 ; b < sizeof(benchTable) / sizeof(BENCH_ENTRY) ; b++) {
+	    printf("%s\n", benchTable[b].name);
+	}
+	return 0;
+    }
+    memset(&state, 0, sizeof(state));
+    state.dataDir = getenv("TPM_DATA_DIR");
+    if (state.dataDir == NULL) {
+	state.dataDir = ".";
+    }
+    if (rc == 0) {
+	printf("benchmark,iterations,ns_per_op,ops_per_sec,allocs_per_op\n");
+    }
+    /* a benchmark is selected if its name starts with -b */
+    for (b = 0 ; (rc == 0) && (b < sizeof(benchTable) / sizeof(BENCH_ENTRY)) ; b++) {
+	if ((benchName == NULL) ||
+	    (strncmp(benchTable[b].name, benchName, strlen(benchName)) == 0)) {
+	    rc = benchRun(&state, &benchTable[b], iterations);
+	}
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("tssbench: success\n");
+    }
+    else {
+	const char *msg;
+	const char *submsg;
+	const char *num;
+	printf("tssbench: failed, rc %08x\n", rc);
+	TSS_ResponseCode_toString(&msg, &submsg, &num, rc);
+	printf("%s%s%s\n", msg, submsg, num);
+	rc = EXIT_FAILURE;
+    }
+    return rc;
+}
+
+/* benchRun() runs one benchmark.  The setup and one untimed warm up operation are outside the
+   measurement. */
+
+static TPM_RC benchRun(BENCH_STATE *state,
+		       const BENCH_ENTRY *entry,
+		       unsigned long iterations)
+{
+    TPM_RC		rc = 0;
+    TPM_RC		rc1;
+    unsigned long	count;
+    uint64_t		start = 0;
+    uint64_t		elapsed = 0;
+    double		nsPerOp;
+    double		opsPerSec;
+    double		allocsPerOp = -1;
+#ifdef BENCH_ALLOC_COUNTING
+    unsigned long	allocStart = 0;
+#endif
+
+    if (tssUtilsVerbose) printf("benchRun: %s\n", entry->name);
+    if ((rc == 0) && (entry->setup != NULL)) {
+	rc = entry->setup(state);
+    }
+    if (rc == 0) {
+	rc = entry->run(state);
+    }
+    if (rc == 0) {
+#ifdef BENCH_ALLOC_COUNTING
+	allocStart = benchAllocCount;
+#endif
+	start = benchNanoseconds();
+	for (count = 0 ; (rc == 0) && (count < iterations) ; count++) {
+	    rc = entry->run(state);
+	}
+	elapsed = benchNanoseconds() - start;
+#ifdef BENCH_ALLOC_COUNTING
+	allocsPerOp = (double)(benchAllocCount - allocStart) / iterations;
+#endif
+    }
+    if (rc != 0) {
+	printf("benchRun: %s failed\n", entry->name);
+    }
+    /* teardown even after a failure, to flush sessions and remove files */
+    if (entry->teardown != NULL) {
+	rc1 = entry->teardown(state);
+	if (rc == 0) {
+	    rc = rc1;
+	}
+    }
+    if (rc == 0) {
+	nsPerOp = (double)elapsed / iterations;
+	opsPerSec = (nsPerOp > 0) ? (1e9 / nsPerOp) : 0;
+	printf("%s,%lu,%.1f,%.1f,%.2f\n",
+	       entry->name, iterations, nsPerOp, opsPerSec, allocsPerOp);
+    }
+    return rc;
+}
+
+/* benchNanoseconds() returns a monotonic time in nanoseconds */
+
+static uint64_t benchNanoseconds(void)
+{
+#ifdef TPM_POSIX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+#endif
+#ifdef TPM_WINDOWS
+    LARGE_INTEGER count;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)count.QuadPart * 1e9 / (double)frequency.QuadPart);
+#endif
+}
+
+/* benchPublicRsa() fills an RSA 2048 storage key public area.  The modulus is a fixed pattern, a
+   public key for encryption and marshaling, not a usable key pair. */
+
+static void benchPublicRsa(TPMT_PUBLIC *publicArea)
+{
+    publicArea->type = TPM_ALG_RSA;
+    publicArea->nameAlg = TPM_ALG_SHA256;
+    publicArea->objectAttributes.val = TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT |
+				       TPMA_OBJECT_SENSITIVEDATAORIGIN |
+				       TPMA_OBJECT_USERWITHAUTH |
+				       TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT;
+    publicArea->authPolicy.t.size = 0;
+    publicArea->parameters.rsaDetail.symmetric.algorithm = TPM_ALG_AES;
+    publicArea->parameters.rsaDetail.symmetric.keyBits.aes = 128;
+    publicArea->parameters.rsaDetail.symmetric.mode.aes = TPM_ALG_CFB;
+    publicArea->parameters.rsaDetail.scheme.scheme = TPM_ALG_NULL;
+    publicArea->parameters.rsaDetail.keyBits = 2048;
+    publicArea->parameters.rsaDetail.exponent = 0;
+    publicArea->unique.rsa.t.size = 256;
+    memset(publicArea->unique.rsa.t.buffer, 0xff, 256);
+    return;
+}
+
+/* benchPublicEcc() fills an ECC NIST P256 storage key public area.  The public point is the
+   curve generator. */
+
+static void benchPublicEcc(TPMT_PUBLIC *publicArea)
+{
+    static const uint8_t gx[] = {
+	0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+	0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0, 0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96
+    };
+    static const uint8_t gy[] = {
+	0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b, 0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+	0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce, 0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5
+    };
+    publicArea->type = TPM_ALG_ECC;
+    publicArea->nameAlg = TPM_ALG_SHA256;
+    publicArea->objectAttributes.val = TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT |
+				       TPMA_OBJECT_SENSITIVEDATAORIGIN |
+				       TPMA_OBJECT_USERWITHAUTH |
+				       TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT;
+    publicArea->authPolicy.t.size = 0;
+    publicArea->parameters.eccDetail.symmetric.algorithm = TPM_ALG_AES;
+    publicArea->parameters.eccDetail.symmetric.keyBits.aes = 128;
+    publicArea->parameters.eccDetail.symmetric.mode.aes = TPM_ALG_CFB;
+    publicArea->parameters.eccDetail.scheme.scheme = TPM_ALG_NULL;
+    publicArea->parameters.eccDetail.curveID = TPM_ECC_NIST_P256;
+    publicArea->parameters.eccDetail.kdf.scheme = TPM_ALG_NULL;
+    publicArea->unique.ecc.x.t.size = sizeof(gx);
+    memcpy(publicArea->unique.ecc.x.t.buffer, gx, sizeof(gx));
+    publicArea->unique.ecc.y.t.size = sizeof(gy);
+    memcpy(publicArea->unique.ecc.y.t.buffer, gy, sizeof(gy));
+    return;
+}
+
+/*
+  Marshal and unmarshal
+*/
+
+static TPM_RC benchMarshalSignInSetup(BENCH_STATE *state)
+{
+    Sign_In *in = &state->parameters.signIn;
+
+    in->keyHandle = 0x80000001;
+    in->digest.t.size = SHA256_DIGEST_SIZE;
+    memset(in->digest.t.buffer, 0x5a, SHA256_DIGEST_SIZE);
+    in->inScheme.scheme = TPM_ALG_RSASSA;
+    in->inScheme.details.rsassa.hashAlg = TPM_ALG_SHA256;
+    in->validation.tag = TPM_ST_HASHCHECK;
+    in->validation.hierarchy = TPM_RH_NULL;
+    in->validation.digest.t.size = 0;
+    return 0;
+}
+
+static TPM_RC benchMarshalSignIn(BENCH_STATE *state)
+{
+    uint16_t	written = 0;
+    uint8_t	*buffer = state->buffer;
+    uint32_t	size = sizeof(state->buffer);
+
+    return TSS_Sign_In_Marshalu(&state->parameters.signIn, &written, &buffer, &size);
+}
+
+/* benchUnmarshalSignOutSetup() marshals an RSA 2048 signature, the Sign response parameters */
+
+static TPM_RC benchUnmarshalSignOutSetup(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    TPMT_SIGNATURE	signature;
+    uint16_t		written = 0;
+    uint8_t		*buffer = state->buffer;
+    uint32_t		size = sizeof(state->buffer);
+
+    signature.sigAlg = TPM_ALG_RSASSA;
+    signature.signature.rsassa.hash = TPM_ALG_SHA256;
+    signature.signature.rsassa.sig.t.size = 256;
+    memset(signature.signature.rsassa.sig.t.buffer, 0xa5, 256);
+    rc = TSS_TPMT_SIGNATURE_Marshalu(&signature, &written, &buffer, &size);
+    state->bufferLength = written;
+    return rc;
+}
+
+static TPM_RC benchUnmarshalSignOut(BENCH_STATE *state)
+{
+    uint8_t	*buffer = state->buffer;
+    uint32_t	size = state->bufferLength;
+
+    return TSS_Sign_Out_Unmarshalu(&state->parameters.signOut, TPM_ST_NO_SESSIONS,
+				   &buffer, &size);
+}
+
+static TPM_RC benchMarshalCreateInSetup(BENCH_STATE *state)
+{
+    Create_In *in = &state->parameters.createIn;
+
+    in->parentHandle = 0x80000000;
+    in->inSensitive.sensitive.userAuth.t.size = 8;
+    memcpy(in->inSensitive.sensitive.userAuth.t.buffer, "password", 8);
+    in->inSensitive.sensitive.data.t.size = 0;
+    benchPublicRsa(&in->inPublic.publicArea);
+    /* the template has an empty unique field */
+    in->inPublic.publicArea.unique.rsa.t.size = 0;
+    in->outsideInfo.t.size = 0;
+    in->creationPCR.count = 1;
+    in->creationPCR.pcrSelections[0].hash = TPM_ALG_SHA256;
+    in->creationPCR.pcrSelections[0].sizeofSelect = 3;
+    in->creationPCR.pcrSelections[0].pcrSelect[0] = 0xff;
+    in->creationPCR.pcrSelections[0].pcrSelect[1] = 0x00;
+    in->creationPCR.pcrSelections[0].pcrSelect[2] = 0x00;
+    return 0;
+}
+
+static TPM_RC benchMarshalCreateIn(BENCH_STATE *state)
+{
+    uint16_t	written = 0;
+    uint8_t	*buffer = state->buffer;
+    uint32_t	size = sizeof(state->buffer);
+
+    return TSS_Create_In_Marshalu(&state->parameters.createIn, &written, &buffer, &size);
+}
+
+/* benchUnmarshalCreatePrimaryOutSetup() marshals the CreatePrimary response handle and
+   parameters for an RSA 2048 storage key */
+
+static TPM_RC benchUnmarshalCreatePrimaryOutSetup(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    TPM_HANDLE		objectHandle = 0x80000000;
+    TPM2B_PUBLIC	outPublic;
+    TPM2B_CREATION_DATA	creationData;
+    TPM2B_DIGEST	creationHash;
+    TPMT_TK_CREATION	creationTicket;
+    TPM2B_NAME		name;
+    uint16_t		written = 0;
+    uint8_t		*buffer = state->buffer;
+    uint32_t		size = sizeof(state->buffer);
+
+    benchPublicRsa(&outPublic.publicArea);
+    creationData.creationData.pcrSelect.count = 1;
+    creationData.creationData.pcrSelect.pcrSelections[0].hash = TPM_ALG_SHA256;
+    creationData.creationData.pcrSelect.pcrSelections[0].sizeofSelect = 3;
+    memset(creationData.creationData.pcrSelect.pcrSelections[0].pcrSelect, 0, 3);
+    creationData.creationData.pcrDigest.t.size = SHA256_DIGEST_SIZE;
+    memset(creationData.creationData.pcrDigest.t.buffer, 0x11, SHA256_DIGEST_SIZE);
+    creationData.creationData.locality.val = TPMA_LOCALITY_ZERO;
+    creationData.creationData.parentNameAlg = TPM_ALG_NULL;
+    creationData.creationData.parentName.t.size = 4;
+    memcpy(creationData.creationData.parentName.t.name, "\x40\x00\x00\x01", 4);
+    creationData.creationData.parentQualifiedName = creationData.creationData.parentName;
+    creationData.creationData.outsideInfo.t.size = 0;
+    creationHash.t.size = SHA256_DIGEST_SIZE;
+    memset(creationHash.t.buffer, 0x22, SHA256_DIGEST_SIZE);
+    creationTicket.tag = TPM_ST_CREATION;
+    creationTicket.hierarchy = TPM_RH_OWNER;
+    creationTicket.digest.t.size = SHA256_DIGEST_SIZE;
+    memset(creationTicket.digest.t.buffer, 0x33, SHA256_DIGEST_SIZE);
+    name.t.size = 2 + SHA256_DIGEST_SIZE;
+    memset(name.t.name, 0x44, name.t.size);
+
+    if (rc == 0) {
+	rc = TSS_TPM_HANDLE_Marshalu(&objectHandle, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_TPM2B_PUBLIC_Marshalu(&outPublic, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_TPM2B_CREATION_DATA_Marshalu(&creationData, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_TPM2B_DIGEST_Marshalu(&creationHash, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_TPMT_TK_CREATION_Marshalu(&creationTicket, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_TPM2B_NAME_Marshalu(&name, &written, &buffer, &size);
+    }
+    state->bufferLength = written;
+    return rc;
+}
+
+static TPM_RC benchUnmarshalCreatePrimaryOut(BENCH_STATE *state)
+{
+    uint8_t	*buffer = state->buffer;
+    uint32_t	size = state->bufferLength;
+
+    return TSS_CreatePrimary_Out_Unmarshalu(&state->parameters.createPrimaryOut,
+					    TPM_ST_NO_SESSIONS, &buffer, &size);
+}
+
+/*
+  Session crypto
+*/
+
+/* benchKdfa() derives an AES-128 CFB key and IV, as for parameter encryption */
+
+static TPM_RC benchKdfa(BENCH_STATE *state)
+{
+    TPM2B_DIGEST	key;
+    TPM2B_NONCE		nonceNewer;
+    TPM2B_NONCE		nonceOlder;
+
+    key.t.size = SHA256_DIGEST_SIZE;
+    memset(key.t.buffer, 0x01, SHA256_DIGEST_SIZE);
+    nonceNewer.t.size = SHA256_DIGEST_SIZE;
+    memset(nonceNewer.t.buffer, 0x02, SHA256_DIGEST_SIZE);
+    nonceOlder.t.size = SHA256_DIGEST_SIZE;
+    memset(nonceOlder.t.buffer, 0x03, SHA256_DIGEST_SIZE);
+    return TSS_KDFA(state->buffer, TPM_ALG_SHA256, &key.b, "CFB",
+		    &nonceNewer.b, &nonceOlder.b, 256);
+}
+
+static TPM_RC benchHmac(BENCH_STATE *state)
+{
+    TPMT_HA	hmac;
+    TPM2B_KEY	hmacKey;
+
+    hmac.hashAlg = TPM_ALG_SHA256;
+    hmacKey.t.size = SHA256_DIGEST_SIZE;
+    memset(hmacKey.t.buffer, 0x04, SHA256_DIGEST_SIZE);
+    return TSS_HMAC_Generate(&hmac, &hmacKey,
+			     BENCH_CRYPTO_SIZE, state->buffer,
+			     0, NULL);
+}
+
+static TPM_RC benchAesCfb(BENCH_STATE *state)
+{
+    uint8_t	key[16];
+    uint8_t	iv[16];
+
+    memset(key, 0x05, sizeof(key));
+    memset(iv, 0x06, sizeof(iv));
+    /* in place, the output of one operation is the input to the next */
+    return TSS_AES_EncryptCFB(state->buffer, 128, key, iv,
+			      BENCH_CRYPTO_SIZE, state->buffer);
+}
+
+/*
+  TSS_Execute() against the mock TPM
+*/
+
+static TPM_RC benchMockSetup(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+
+    state->mockTpm.sessionCount = 0;
+    state->mockTpm.nonceCount = 0;
+    if (rc == 0) {
+	rc = TSS_Create(&state->tssContext);
+    }
+    if (rc == 0) {
+	rc = TSS_SetTransport(state->tssContext, &benchMockTransport, &state->mockTpm);
+    }
+    return rc;
+}
+
+static TPM_RC benchMockTeardown(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+
+    if (state->tssContext != NULL) {
+	rc = TSS_Delete(state->tssContext);
+	state->tssContext = NULL;
+    }
+    return rc;
+}
+
+/* benchMockTransmit() is the mock TPM.  It parses the handles and the first session of the
+   command, and returns a success response with sessions that the TSS verifies. */
+
+static TPM_RC benchMockTransmit(TSS_CONTEXT *tssContext,
+				uint8_t *responseBuffer, uint32_t *read,
+				const uint8_t *commandBuffer, uint32_t written,
+				const char *message)
+{
+    TPM_RC		rc = 0;
+    BENCH_MOCK_TPM	*mockTpm = TSS_GetTransportContext(tssContext);
+    uint8_t		*buffer = (uint8_t *)commandBuffer;	/* unmarshal is not const */
+    uint32_t		size = written;
+    TPM_ST		tag;
+    uint32_t		commandSize;
+    TPM_CC		commandCode;
+    TPM_HANDLE		handle;
+    uint32_t		handleCount = 0;
+    uint32_t		h;
+    uint32_t		authSize;
+    BENCH_MOCK_AUTH	auth;
+    TPM2B_AUTH		hmac;
+    TPM_HANDLE		responseHandle;
+    uint16_t		bytesRequested;
+    uint8_t		parameters[2 + SHA512_DIGEST_SIZE];
+    uint16_t		parameterSize = 0;
+
+    message = message;
+    if (rc == 0) {
+	rc = TSS_UINT16_Unmarshalu(&tag, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Unmarshalu(&commandSize, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Unmarshalu(&commandCode, &buffer, &size);
+    }
+    if (rc == 0) {
+	switch (commandCode) {
+	  case TPM_CC_PCR_Extend:
+	    handleCount = 1;
+	    break;
+	  case TPM_CC_StartAuthSession:
+	    handleCount = 2;
+	    break;
+	  case TPM_CC_GetRandom:
+	  case TPM_CC_FlushContext:
+	    handleCount = 0;
+	    break;
+	  default:
+	    printf("benchMockTransmit: command %08x not supported\n", commandCode);
+	    rc = TPM_RC_COMMAND_CODE;
+	}
+    }
+    for (h = 0 ; (rc == 0) && (h < handleCount) ; h++) {
+	rc = TSS_UINT32_Unmarshalu(&handle, &buffer, &size);
+    }
+    /* only the first session is used, skip the rest of the authorization area */
+    if ((rc == 0) && (tag == TPM_ST_SESSIONS)) {
+	uint8_t *authEnd;
+	if (rc == 0) {
+	    rc = TSS_UINT32_Unmarshalu(&authSize, &buffer, &size);
+	}
+	if (rc == 0) {
+	    if (authSize > size) {
+		rc = TSS_RC_INSUFFICIENT_BUFFER;
+	    }
+	}
+	if (rc == 0) {
+	    authEnd = buffer + authSize;
+	    rc = TSS_UINT32_Unmarshalu(&auth.sessionHandle, &buffer, &size);
+	    if (rc == 0) {
+		rc = TSS_TPM2B_NONCE_Unmarshalu(&auth.nonceCaller, &buffer, &size);
+	    }
+	    if (rc == 0) {
+		rc = TSS_UINT8_Unmarshalu(&auth.sessionAttributes.val, &buffer, &size);
+	    }
+	    if (rc == 0) {
+		rc = TSS_TPM2B_DIGEST_Unmarshalu(&hmac, &buffer, &size);
+	    }
+	    if (rc == 0) {
+		size -= (uint32_t)(authEnd - buffer);
+		buffer = authEnd;
+	    }
+	}
+    }
+    /* the response parameters */
+    if (rc == 0) {
+	switch (commandCode) {
+	  case TPM_CC_GetRandom:
+	    rc = TSS_UINT16_Unmarshalu(&bytesRequested, &buffer, &size);
+	    if (rc == 0) {
+		if (bytesRequested > SHA512_DIGEST_SIZE) {
+		    bytesRequested = SHA512_DIGEST_SIZE;
+		}
+		parameters[0] = (uint8_t)(bytesRequested >> 8);
+		parameters[1] = (uint8_t)(bytesRequested >> 0);
+		memset(parameters + 2, 0xa5, bytesRequested);
+		parameterSize = 2 + bytesRequested;
+	    }
+	    break;
+	  case TPM_CC_StartAuthSession:
+	    /* the mock assumes authHash SHA-256 */
+	    responseHandle = HMAC_SESSION_FIRST + (mockTpm->sessionCount++ % 0x100);
+	    parameters[0] = 0;
+	    parameters[1] = SHA256_DIGEST_SIZE;
+	    memset(parameters + 2, (uint8_t)mockTpm->nonceCount++, SHA256_DIGEST_SIZE);
+	    parameterSize = 2 + SHA256_DIGEST_SIZE;
+	    break;
+	  default:
+	    break;
+	}
+    }
+    if (rc == 0) {
+	rc = benchMockResponse(responseBuffer, read,
+			       mockTpm,
+			       commandCode,
+			       (tag == TPM_ST_SESSIONS) ? &auth : NULL,
+			       (commandCode == TPM_CC_StartAuthSession) ? &responseHandle : NULL,
+			       parameters, parameterSize);
+    }
+    return rc;
+}
+
+/* benchMockResponse() marshals the response.  For an HMAC session, it encrypts the first response
+   parameter if requested, rolls nonceTPM, and calculates the response HMAC.  The mock sessions
+   are unbound and unsalted, so the HMAC key and the session value are empty. */
+
+static TPM_RC benchMockResponse(uint8_t *responseBuffer,
+				uint32_t *read,
+				BENCH_MOCK_TPM *mockTpm,
+				TPM_CC commandCode,
+				const BENCH_MOCK_AUTH *auth,	/* NULL for no sessions */
+				const TPM_HANDLE *handle,	/* NULL for no response handle */
+				uint8_t *parameters,
+				uint16_t parameterSize)
+{
+    TPM_RC		rc = 0;
+    uint16_t		written = 0;
+    uint8_t		*buffer = responseBuffer;
+    uint32_t		size = MAX_RESPONSE_SIZE;
+    TPM_ST		tag = (auth != NULL) ? TPM_ST_SESSIONS : TPM_ST_NO_SESSIONS;
+    uint32_t		responseSize = 0;
+    TPM_RC		responseCode = TPM_RC_SUCCESS;
+    uint32_t		parameterSize32 = parameterSize;
+    uint8_t		*sizePtr;
+    int			hmacSession = (auth != NULL) && (auth->sessionHandle != TPM_RS_PW);
+    TPM2B_NONCE		nonceTPM;
+    TPM2B_KEY		hmacKey;
+    TPMT_HA		rpHash;
+    TPMT_HA		hmac;
+    uint8_t		responseCodeNbo[4];
+    uint8_t		commandCodeNbo[4];
+
+    nonceTPM.t.size = 0;
+    hmacKey.t.size = 0;
+    if (hmacSession) {
+	nonceTPM.t.size = SHA256_DIGEST_SIZE;
+	memset(nonceTPM.t.buffer, (uint8_t)mockTpm->nonceCount++, SHA256_DIGEST_SIZE);
+    }
+    /* encrypt the first TPM2B response parameter, KDFa (hashAlg, sessionValue, "CFB", nonceTPM,
+       nonceCaller) */
+    if ((rc == 0) && hmacSession && (auth->sessionAttributes.val & TPMA_SESSION_ENCRYPT) &&
+	(parameterSize > 2)) {
+	uint8_t symParmString[32];		/* AES-128 key and IV */
+	TPM2B_DIGEST sessionValue;
+	sessionValue.t.size = 0;
+	if (rc == 0) {
+	    rc = TSS_KDFA(symParmString, TPM_ALG_SHA256, &sessionValue.b, "CFB",
+			  &nonceTPM.b, &auth->nonceCaller.b, 256);
+	}
+	if (rc == 0) {
+	    rc = TSS_AES_EncryptCFB(parameters + 2, 128, symParmString, symParmString + 16,
+				    parameterSize - 2, parameters + 2);
+	}
+    }
+    if (rc == 0) {
+	rc = TSS_UINT16_Marshalu(&tag, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	sizePtr = buffer;
+	rc = TSS_UINT32_Marshalu(&responseSize, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(&responseCode, &written, &buffer, &size);
+    }
+    if ((rc == 0) && (handle != NULL)) {
+	rc = TSS_UINT32_Marshalu(handle, &written, &buffer, &size);
+    }
+    if ((rc == 0) && (auth != NULL)) {
+	rc = TSS_UINT32_Marshalu(&parameterSize32, &written, &buffer, &size);
+    }
+    if (rc == 0) {
+	rc = TSS_Array_Marshalu(parameters, parameterSize, &written, &buffer, &size);
+    }
+    /* rpHash = H(responseCode || commandCode || parameters) */
+    if ((rc == 0) && hmacSession) {
+	uint16_t tmpWritten = 0;
+	uint8_t *tmpBuffer;
+	tmpBuffer = responseCodeNbo;
+	TSS_UINT32_Marshalu(&responseCode, &tmpWritten, &tmpBuffer, NULL);
+	tmpBuffer = commandCodeNbo;
+	TSS_UINT32_Marshalu(&commandCode, &tmpWritten, &tmpBuffer, NULL);
+	rpHash.hashAlg = TPM_ALG_SHA256;
+	rc = TSS_Hash_Generate(&rpHash,
+			       sizeof(responseCodeNbo), responseCodeNbo,
+			       sizeof(commandCodeNbo), commandCodeNbo,
+			       parameterSize, parameters,
+			       0, NULL);
+    }
+    if ((rc == 0) && hmacSession) {
+	hmac.hashAlg = TPM_ALG_SHA256;
+	rc = TSS_HMAC_Generate(&hmac, &hmacKey,
+			       SHA256_DIGEST_SIZE, (uint8_t *)&rpHash.digest,
+			       nonceTPM.t.size, nonceTPM.t.buffer,
+			       auth->nonceCaller.t.size, auth->nonceCaller.t.buffer,
+			       sizeof(uint8_t), &auth->sessionAttributes.val,
+			       0, NULL);
+    }
+    /* the response session, nonceTPM, sessionAttributes, and hmac (empty for a password) */
+    if ((rc == 0) && (auth != NULL)) {
+	rc = TSS_TPM2B_Marshalu(&nonceTPM.b, &written, &buffer, &size);
+    }
+    /* the TPM always sets continueSession for a password */
+    if ((rc == 0) && (auth != NULL)) {
+	uint8_t sessionAttributes = auth->sessionAttributes.val;
+	if (!hmacSession) {
+	    sessionAttributes |= TPMA_SESSION_CONTINUESESSION;
+	}
+	rc = TSS_UINT8_Marshalu(&sessionAttributes, &written, &buffer, &size);
+    }
+    if ((rc == 0) && (auth != NULL)) {
+	uint16_t hmacSize = hmacSession ? SHA256_DIGEST_SIZE : 0;
+	rc = TSS_UINT16_Marshalu(&hmacSize, &written, &buffer, &size);
+	if ((rc == 0) && hmacSession) {
+	    rc = TSS_Array_Marshalu((uint8_t *)&hmac.digest, hmacSize, &written, &buffer, &size);
+	}
+    }
+    /* backfill the response size */
+    if (rc == 0) {
+	uint16_t tmpWritten = 0;
+	responseSize = written;
+	rc = TSS_UINT32_Marshalu(&responseSize, &tmpWritten, &sizePtr, NULL);
+	*read = written;
+    }
+    return rc;
+}
+
+/* benchStartSession() starts an HMAC session with AES-128 CFB and SHA-256.  tpmKey is the salt key
+   or TPM_RH_NULL. */
+
+static TPM_RC benchStartSession(BENCH_STATE *state,
+				TPMI_SH_AUTH_SESSION *sessionHandle,
+				TPMI_DH_OBJECT tpmKey)
+{
+    TPM_RC			rc = 0;
+    StartAuthSession_In 	in;
+    StartAuthSession_Out 	out;
+    StartAuthSession_Extra	extra;
+
+    in.tpmKey = tpmKey;
+    in.bind = TPM_RH_NULL;
+    in.sessionType = TPM_SE_HMAC;
+    in.symmetric.algorithm = TPM_ALG_AES;
+    in.symmetric.keyBits.aes = 128;
+    in.symmetric.mode.aes = TPM_ALG_CFB;
+    in.authHash = TPM_ALG_SHA256;
+    extra.bindPassword = NULL;
+    rc = TSS_Execute(state->tssContext,
+		     (RESPONSE_PARAMETERS *)&out,
+		     (COMMAND_PARAMETERS *)&in,
+		     (EXTRA_PARAMETERS *)&extra,
+		     TPM_CC_StartAuthSession,
+		     TPM_RH_NULL, NULL, 0);
+    *sessionHandle = out.sessionHandle;
+    return rc;
+}
+
+static TPM_RC benchFlush(BENCH_STATE *state,
+			 TPMI_SH_AUTH_SESSION sessionHandle)
+{
+    FlushContext_In 		in;
+
+    in.flushHandle = sessionHandle;
+    return TSS_Execute(state->tssContext,
+		       NULL, 
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_FlushContext,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+static TPM_RC benchHmacSessionSetup(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+
+    state->sessionHandle = TPM_RH_NULL;
+    if (rc == 0) {
+	rc = benchMockSetup(state);
+    }
+    if (rc == 0) {
+	rc = benchStartSession(state, &state->sessionHandle, TPM_RH_NULL);
+    }
+    return rc;
+}
+
+static TPM_RC benchHmacSessionTeardown(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    TPM_RC		rc1;
+
+    if ((state->tssContext != NULL) && (state->sessionHandle != TPM_RH_NULL)) {
+	rc = benchFlush(state, state->sessionHandle);
+	state->sessionHandle = TPM_RH_NULL;
+    }
+    rc1 = benchMockTeardown(state);
+    if (rc == 0) {
+	rc = rc1;
+    }
+    return rc;
+}
+
+/* benchSaltSetup() writes the salt key public area where TSS_Execute() loads it */
+
+static TPM_RC benchSaltSetup(BENCH_STATE *state,
+			     TPM_HANDLE saltHandle,
+			     void (*fillPublic)(TPMT_PUBLIC *publicArea))
+{
+    TPM_RC		rc = 0;
+    TPM2B_PUBLIC	saltPublic;
+    char		filename[BENCH_PATH_LENGTH];
+
+    state->saltHandle = saltHandle;
+    fillPublic(&saltPublic.publicArea);
+    if (rc == 0) {
+	if (snprintf(filename, sizeof(filename), "%s/hp%08x.bin",
+		     state->dataDir, saltHandle) >= (int)sizeof(filename)) {
+	    printf("benchSaltSetup: TPM_DATA_DIR %s too long\n", state->dataDir);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	rc = TSS_File_WriteStructure(&saltPublic,
+				     (MarshalFunction_t)TSS_TPM2B_PUBLIC_Marshalu,
+				     filename);
+    }
+    if (rc == 0) {
+	rc = benchMockSetup(state);
+    }
+    return rc;
+}
+
+static TPM_RC benchSaltRsaSetup(BENCH_STATE *state)
+{
+    return benchSaltSetup(state, BENCH_SALT_RSA_HANDLE, benchPublicRsa);
+}
+
+static TPM_RC benchSaltEccSetup(BENCH_STATE *state)
+{
+    return benchSaltSetup(state, BENCH_SALT_ECC_HANDLE, benchPublicEcc);
+}
+
+static TPM_RC benchSaltTeardown(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    TPM_RC		rc1;
+    char		filename[BENCH_PATH_LENGTH];
+
+    rc = benchMockTeardown(state);
+    snprintf(filename, sizeof(filename), "%s/hp%08x.bin", state->dataDir, state->saltHandle);
+    rc1 = TSS_File_DeleteFile(filename);
+    if (rc == 0) {
+	rc = rc1;
+    }
+    return rc;
+}
+
+static TPM_RC benchExecuteGetRandom(BENCH_STATE *state)
+{
+    GetRandom_In 		in;
+    GetRandom_Out 		out;
+
+    in.bytesRequested = SHA256_DIGEST_SIZE;
+    return TSS_Execute(state->tssContext,
+		       (RESPONSE_PARAMETERS *)&out,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_GetRandom,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+/* benchPcrExtendIn() fills a PCR_Extend of PCR 16 with a SHA-256 digest */
+
+static void benchPcrExtendIn(PCR_Extend_In *in)
+{
+    in->pcrHandle = 16;
+    in->digests.count = 1;
+    in->digests.digests[0].hashAlg = TPM_ALG_SHA256;
+    memset((uint8_t *)&in->digests.digests[0].digest, 0x5a, SHA256_DIGEST_SIZE);
+    return;
+}
+
+static TPM_RC benchExecutePcrExtendPassword(BENCH_STATE *state)
+{
+    PCR_Extend_In 		in;
+
+    benchPcrExtendIn(&in);
+    return TSS_Execute(state->tssContext,
+		       NULL,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_PCR_Extend,
+		       TPM_RS_PW, NULL, 0,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+static TPM_RC benchExecutePcrExtendHmac(BENCH_STATE *state)
+{
+    PCR_Extend_In 		in;
+
+    benchPcrExtendIn(&in);
+    return TSS_Execute(state->tssContext,
+		       NULL,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_PCR_Extend,
+		       state->sessionHandle, NULL, TPMA_SESSION_CONTINUESESSION,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+static TPM_RC benchExecuteGetRandomEncrypt(BENCH_STATE *state)
+{
+    GetRandom_In 		in;
+    GetRandom_Out 		out;
+
+    in.bytesRequested = SHA256_DIGEST_SIZE;
+    return TSS_Execute(state->tssContext,
+		       (RESPONSE_PARAMETERS *)&out,
+		       (COMMAND_PARAMETERS *)&in,
+		       NULL,
+		       TPM_CC_GetRandom,
+		       state->sessionHandle, NULL,
+		       TPMA_SESSION_CONTINUESESSION | TPMA_SESSION_ENCRYPT,
+		       TPM_RH_NULL, NULL, 0);
+}
+
+/* benchExecuteSalted() starts a salted session and flushes it */
+
+static TPM_RC benchExecuteSalted(BENCH_STATE *state)
+{
+    TPM_RC			rc = 0;
+    TPMI_SH_AUTH_SESSION	sessionHandle;
+
+    if (rc == 0) {
+	rc = benchStartSession(state, &sessionHandle, state->saltHandle);
+    }
+    if (rc == 0) {
+	rc = benchFlush(state, sessionHandle);
+    }
+    return rc;
+}
+
+/*
+  Event logs
+*/
+
+/* benchEvent2LogSetup() writes a little endian TPM 2.0 event log with SHA-1 and SHA-256
+   digests */
+
+static TPM_RC benchEvent2LogSetup(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    TCG_PCR_EVENT2	event2;
+    uint32_t		e;
+    uint16_t		written;
+    uint8_t		*buffer;
+    uint32_t		size;
+
+    event2.pcrIndex = 4;
+    event2.eventType = EV_IPL;
+    event2.digests.count = 2;
+    event2.digests.digests[0].hashAlg = TPM_ALG_SHA1;
+    memset((uint8_t *)&event2.digests.digests[0].digest, 0x11, SHA1_DIGEST_SIZE);
+    event2.digests.digests[1].hashAlg = TPM_ALG_SHA256;
+    memset((uint8_t *)&event2.digests.digests[1].digest, 0x22, SHA256_DIGEST_SIZE);
+    event2.eventSize = 64;
+    memset(event2.event, 'e', event2.eventSize);
+    if (rc == 0) {
+	state->logFile = tmpfile();		/* closed @1 */
+	if (state->logFile == NULL) {
+	    printf("benchEvent2LogSetup: Error opening temporary file\n");
+	    rc = TSS_RC_FILE_OPEN;
+	}
+    }
+    for (e = 0 ; (rc == 0) && (e < BENCH_LOG_EVENTS) ; e++) {
+	written = 0;
+	buffer = state->buffer;
+	size = sizeof(state->buffer);
+	rc = TSS_EVENT2_Line_LE_Marshal(&event2, &written, &buffer, &size);
+	if (rc == 0) {
+	    if (fwrite(state->buffer, 1, written, state->logFile) != written) {
+		printf("benchEvent2LogSetup: Error writing temporary file\n");
+		rc = TSS_RC_FILE_WRITE;
+	    }
+	}
+    }
+    return rc;
+}
+
+static TPM_RC benchEvent2LogRead(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    TCG_PCR_EVENT2	event2;
+    int			endOfFile = FALSE;
+    uint32_t		events = 0;
+
+    rewind(state->logFile);
+    while ((rc == 0) && !endOfFile) {
+	rc = TSS_EVENT2_Line_Read(&event2, &endOfFile, state->logFile);
+	if ((rc == 0) && !endOfFile) {
+	    events++;
+	}
+    }
+    if ((rc == 0) && (events != BENCH_LOG_EVENTS)) {
+	printf("benchEvent2LogRead: read %u events\n", events);
+	rc = TSS_RC_MALFORMED_RESPONSE;
+    }
+    return rc;
+}
+
+static TPM_RC benchEvent2LogTeardown(BENCH_STATE *state)
+{
+    if (state->logFile != NULL) {
+	fclose(state->logFile);		/* @1 */
+	state->logFile = NULL;
+    }
+    return 0;
+}
+
+/* benchImaLogSetup() builds a big endian ima-ng log in memory */
+
+static TPM_RC benchImaLogSetup(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    ImaEvent2		imaEvent;
+    uint8_t		templateData[4 + 8 + SHA256_DIGEST_SIZE + 4 + 32];
+    uint8_t		*templatePtr = templateData;
+    uint32_t		e;
+    uint16_t		written = 0;
+    uint8_t		*buffer;
+    uint32_t		size;
+    uint32_t		eventSize;
+
+    /* ima-ng template data, d-ng hash "sha256:" digest, n-ng file name */
+    memcpy(templatePtr, "\x28\x00\x00\x00" "sha256:\0", 12);
+    templatePtr += 12;
+    memset(templatePtr, 0x33, SHA256_DIGEST_SIZE);
+    templatePtr += SHA256_DIGEST_SIZE;
+    memcpy(templatePtr, "\x20\x00\x00\x00", 4);
+    templatePtr += 4;
+    memcpy(templatePtr, "/usr/lib/x86_64-linux-gnu/bench", 32);
+
+    imaEvent.pcrIndex = IMA_PCR;
+    imaEvent.templateHashAlg = TPM_ALG_SHA256;
+    imaEvent.templateHashSize = SHA256_DIGEST_SIZE;
+    memset(imaEvent.digest, 0x44, SHA256_DIGEST_SIZE);
+    imaEvent.name_len = 6;
+    memcpy(imaEvent.name, "ima-ng", 6);
+    imaEvent.template_data_len = sizeof(templateData);
+    imaEvent.template_data = templateData;
+    /* the size of one event */
+    if (rc == 0) {
+	rc = IMA_Event2_Marshal(&imaEvent, &written, NULL, NULL);
+	eventSize = written;
+    }
+    if (rc == 0) {
+	state->logLength = (size_t)eventSize * BENCH_LOG_EVENTS;
+	/* not TSS_Malloc(), which has a 64k limit, freed @1 */
+	state->log = malloc(state->logLength);
+	if (state->log == NULL) {
+	    printf("benchImaLogSetup: Error allocating %lu bytes\n",
+		   (unsigned long)state->logLength);
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    buffer = state->log;
+    for (e = 0 ; (rc == 0) && (e < BENCH_LOG_EVENTS) ; e++) {
+	written = 0;
+	size = eventSize;
+	rc = IMA_Event2_Marshal(&imaEvent, &written, &buffer, &size);
+    }
+    return rc;
+}
+
+static TPM_RC benchImaLogRead(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    ImaEvent2		imaEvent;
+    uint8_t		*buffer = state->log;
+    size_t		length = state->logLength;
+    int			endOfBuffer = FALSE;
+    uint32_t		events = 0;
+
+    while ((rc == 0) && !endOfBuffer) {
+	IMA_Event2_Init(&imaEvent);
+	rc = IMA_Event2_ReadBuffer(&imaEvent, &length, &buffer, &endOfBuffer,
+				   FALSE,		/* big endian */
+				   TRUE);		/* getTemplate */
+	if ((rc == 0) && !endOfBuffer) {
+	    events++;
+	}
+	IMA_Event2_Free(&imaEvent);
+    }
+    if ((rc == 0) && (events != BENCH_LOG_EVENTS)) {
+	printf("benchImaLogRead: read %u events\n", events);
+	rc = TSS_RC_MALFORMED_RESPONSE;
+    }
+    return rc;
+}
+
+/* benchDbxSetup() builds an EV_EFI_VARIABLE_DRIVER_CONFIG dbx event with one SHA-256 signature
+   list */
+
+static TPM_RC benchDbxSetup(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    uint8_t		*ptr;
+    uint32_t		signatureListSize = 28 + (BENCH_DBX_ENTRIES * 48);
+    uint32_t		e;
+    /* EFI_IMAGE_SECURITY_DATABASE_GUID d719b2cb-3d3a-4596-a3bc-dad00e67656f */
+    static const uint8_t variableName[16] = {
+	0xcb, 0xb2, 0x19, 0xd7, 0x3a, 0x3d, 0x96, 0x45,
+	0xa3, 0xbc, 0xda, 0xd0, 0x0e, 0x67, 0x65, 0x6f
+    };
+    /* EFI_CERT_SHA256_GUID c1c41626-504c-4092-aca9-41f936934328 */
+    static const uint8_t signatureType[16] = {
+	0x26, 0x16, 0xc4, 0xc1, 0x4c, 0x50, 0x92, 0x40,
+	0xac, 0xa9, 0x41, 0xf9, 0x36, 0x93, 0x43, 0x28
+    };
+
+    /* VariableName, UnicodeNameLength, VariableDataLength, UnicodeName, VariableData */
+    state->logLength = 16 + 8 + 8 + 6 + signatureListSize;
+    /* not TSS_Malloc(), which has a 64k limit, freed @1 */
+    state->log = malloc(state->logLength);
+    if (state->log == NULL) {
+	printf("benchDbxSetup: Error allocating %lu bytes\n", (unsigned long)state->logLength);
+	rc = TSS_RC_OUT_OF_MEMORY;
+    }
+    if (rc == 0) {
+	ptr = state->log;
+	memcpy(ptr, variableName, 16);
+	ptr += 16;
+	memcpy(ptr, "\x03\x00\x00\x00\x00\x00\x00\x00", 8);
+	ptr += 8;
+	ptr[0] = (uint8_t)(signatureListSize >> 0);
+	ptr[1] = (uint8_t)(signatureListSize >> 8);
+	ptr[2] = (uint8_t)(signatureListSize >> 16);
+	memset(ptr + 3, 0, 5);
+	ptr += 8;
+	memcpy(ptr, "d\0b\0x\0", 6);
+	ptr += 6;
+	/* EFI_SIGNATURE_LIST SignatureType, SignatureListSize, SignatureHeaderSize,
+	   SignatureSize */
+	memcpy(ptr, signatureType, 16);
+	ptr += 16;
+	ptr[0] = (uint8_t)(signatureListSize >> 0);
+	ptr[1] = (uint8_t)(signatureListSize >> 8);
+	ptr[2] = (uint8_t)(signatureListSize >> 16);
+	ptr[3] = 0;
+	ptr += 4;
+	memset(ptr, 0, 4);
+	ptr += 4;
+	memcpy(ptr, "\x30\x00\x00\x00", 4);
+	ptr += 4;
+	/* EFI_SIGNATURE_DATA SignatureOwner and SHA-256 digest */
+	for (e = 0 ; e < BENCH_DBX_ENTRIES ; e++) {
+	    memset(ptr, 0x77, 16);
+	    ptr += 16;
+	    memset(ptr, (uint8_t)e, SHA256_DIGEST_SIZE);
+	    ptr += SHA256_DIGEST_SIZE;
+	}
+    }
+    return rc;
+}
+
+static TPM_RC benchDbxRead(BENCH_STATE *state)
+{
+    TPM_RC		rc = 0;
+    TSST_EFIData	*efiData = NULL;
+
+    if (rc == 0) {
+	rc = TSS_EFIData_Init(&efiData, EV_EFI_VARIABLE_DRIVER_CONFIG, NULL);
+    }
+    if (rc == 0) {
+	rc = TSS_EFIData_ReadBuffer(efiData, state->log, (uint32_t)state->logLength, 7, NULL);
+    }
+    TSS_EFIData_Free(efiData, NULL);
+    return rc;
+}
+
+static TPM_RC benchLogTeardown(BENCH_STATE *state)
+{
+    free(state->log);		/* @1 */
+    state->log = NULL;
+    return 0;
+}
+
+static void printUsage(void)
+{
+    printf("\n");
+    printf("tssbench\n");
+    printf("\n");
+    printf("Runs microbenchmarks of the TSS internals, without a TPM.\n");
+    printf("Output is CSV: benchmark,iterations,ns_per_op,ops_per_sec,allocs_per_op\n");
+    printf("\n");
+    printf("\t[-n\titerations per benchmark (default %u)]\n", BENCH_ITERATIONS_DEFAULT);
+    printf("\t[-b\trun the benchmarks whose name starts with this (default all)]\n");
+    printf("\t[-l\tlist the benchmark names]\n");
+    printf("\t[-v\tverbose]\n");
+    printf("\n");
+    exit(1);	
+}
@@ -0,0 +1,86 @@
+#!/bin/sh
+#
+
+#################################################################################
+#										#
+#			TSS Command Subset Header				#
+#			     Written by Ken Goldman				#
+#		       IBM Thomas J. Watson Research Center			#
+#										#
+# (c) Copyright IBM Corporation 2026						#
+# 										#
+# All rights reserved.								#
+# 										#
+# Redistribution and use in source and binary forms, with or without		#
+# modification, are permitted provided that the following conditions are	#
+# met:										#
+# 										#
+# Redistributions of source code must retain the above copyright notice,	#
+# this list of conditions and the following disclaimer.				#
+# 										#
+# Redistributions in binary form must reproduce the above copyright		#
+# notice, this list of conditions and the following disclaimer in the		#
+# documentation and/or other materials provided with the distribution.		#
+# 										#
+# Neither the names of the IBM Corporation nor the names of its			#
+# contributors may be used to endorse or promote products derived from		#
+# this software without specific prior written permission.			#
+# 										#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		#
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		#
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR		#
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		#
+# HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	#
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		#
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,		#
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY		#
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		#
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE		#
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		#
+#										#
+#################################################################################
+
+# tssccsubset.sh writes tssccsubset.h to stdout, for building the TSS with TPM_TSS_CC_SUBSET.
+#
+# Usage: tssccsubset.sh "command list" [Implementation.h]
+#
+# The list is comma or space separated TPM 2.0 command names without the TPM2_ or TPM_CC_
+# prefix, e.g. "PCR_Extend,PCR_Read,Quote".  Each CC_ in Implementation.h that is not in the
+# list is redefined as CC_NO.  GetCapability is always included because the TSS uses it to query
+# the TPM buffer sizes.
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 \"command list\" [Implementation.h]" >&2
+    exit 1
+fi
+
+COMMANDS=`echo "$1" | tr ',' ' '`
+IMPLEMENTATION=${2:-`dirname $0`/ibmtss/Implementation.h}
+
+ALL=`sed -n 's/^#define[ 	]*CC_\([A-Za-z0-9_]*\)[ 	].*/\1/p' $IMPLEMENTATION | grep -v '^YES$\|^NO$'`
+
+for CMD in ${COMMANDS}; do
+    CMD=`echo ${CMD} | sed 's/^TPM2_//; s/^TPM_CC_//'`
+    if ! echo "${ALL}" | grep -q "^${CMD}$"; then
+	echo "$0: unknown command ${CMD}" >&2
+	exit 1
+    fi
+done
+
+echo "/* tssccsubset.h generated by tssccsubset.sh, do not edit */"
+echo
+echo "/* ${COMMANDS} */"
+echo
+for CC in ${ALL}; do
+    INCLUDED=NO
+    for CMD in GetCapability ${COMMANDS}; do
+	CMD=`echo ${CMD} | sed 's/^TPM2_//; s/^TPM_CC_//'`
+	if [ "${CC}" = "${CMD}" ]; then
+	    INCLUDED=YES
+	fi
+    done
+    if [ ${INCLUDED} = NO ]; then
+	echo "#undef   CC_${CC}"
+	echo "#define  CC_${CC} CC_NO"
+    fi
+done
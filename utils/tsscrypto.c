@@ -1026,6 +1026,20 @@ static TPM_RC TSS_ECC_TPMTPublicToEcPoint(EC_GROUP *ecGroup,
 TPM_RC TSS_ECC_Salt(TPM2B_DIGEST 		*salt,
 		    TPM2B_ENCRYPTED_SECRET	*encryptedSalt,
 		    TPMT_PUBLIC			*publicArea)		/* salt asymmetric key */
+{
+    return TSS_ECC_Seed(salt, encryptedSalt, publicArea, "SECRET");
+}
+
+/* TSS_ECC_Seed() returns both the plaintext and encrypted seed, based on the ECC key publicArea.
+
+   The KDFe label is "SECRET" for a session salt and "IDENTITY" for a credential seed (Part 1
+   Annex C.6.1).
+*/
+
+TPM_RC TSS_ECC_Seed(TPM2B_DIGEST 		*salt,
+		    TPM2B_ENCRYPTED_SECRET	*encryptedSalt,
+		    TPMT_PUBLIC			*publicArea,		/* seed asymmetric key */
+		    const char			*label)			/* KDFe label */
 {
     TPM_RC		rc = 0;
     int			irc = 0;
@@ -1051,7 +1065,7 @@ TPM_RC TSS_ECC_Salt(TPM2B_DIGEST 		*salt,
     /* ecGroup defines the used curve */
     if (rc == 0) {
 	if (!(ecGroup = EC_GROUP_new_by_curve_name(nid))) {
-	    if (tssVerbose) printf("TSS_ECC_Salt: "
+	    if (tssVerbose) printf("TSS_ECC_Seed: "
 				    "Error calling EC_GROUP_new_by_curve_name()\n");
 	    rc = TSS_RC_EC_KEY_CONVERT;
 	}
@@ -1059,7 +1073,7 @@ TPM_RC TSS_ECC_Salt(TPM2B_DIGEST 		*salt,
     /* Generate the TSS ECC ephemeral key pair outside the TPM for the salt. The public part of this
        key becomes the encrypted salt. */
     if (rc == 0) {
-	if (tssVverbose) printf("TSS_ECC_Salt: "
+	if (tssVverbose) printf("TSS_ECC_Seed: "
 				"Calling TSS_ECC_GeneratePlatformEphemeralKey()\n");
 	rc = TSS_ECC_GeneratePlatformEphemeralKey(&ephPrivKey,	/* freed @3 */
 						  &ephPubX,	/* freed @4 */
@@ -1085,7 +1099,7 @@ TPM_RC TSS_ECC_Salt(TPM2B_DIGEST 		*salt,
     if (rc == 0) {
 	pointP = EC_POINT_new(ecGroup);
 	if (pointP == NULL) {
-	    if (tssVerbose) printf("TSS_ECC_Salt: EC_POINT_new for pointP failed\n");
+	    if (tssVerbose) printf("TSS_ECC_Seed: EC_POINT_new for pointP failed\n");
 	    rc = TSS_RC_OUT_OF_MEMORY;
 	}
     }
@@ -1099,7 +1113,7 @@ TPM_RC TSS_ECC_Salt(TPM2B_DIGEST 		*salt,
 			   ephPrivKey,	/* m */
 			   NULL);	/* ctx */
 	if (irc != 1) {
-	    if (tssVerbose) printf("TSS_ECC_Salt: EC_POINT_mul failed\n");
+	    if (tssVerbose) printf("TSS_ECC_Seed: EC_POINT_mul failed\n");
 	    rc = TSS_RC_EC_KEY_CONVERT;
 	}
     }
@@ -1111,7 +1125,7 @@ TPM_RC TSS_ECC_Salt(TPM2B_DIGEST 		*salt,
 	irc = EC_POINT_get_affine_coordinates(ecGroup, pointP,
 					      ZeeX, NULL, NULL);
 	if (irc != 1) {
-	    if (tssVerbose) printf("TSS_ECC_Salt: EC_POINT_get_affine_coordinates failed\n");
+	    if (tssVerbose) printf("TSS_ECC_Seed: EC_POINT_get_affine_coordinates failed\n");
 	    rc = TSS_RC_EC_KEY_CONVERT;
 	}
     }
@@ -1132,24 +1146,24 @@ TPM_RC TSS_ECC_Salt(TPM2B_DIGEST 		*salt,
     if (rc == 0) {
 	sizeInBytes = TSS_GetDigestSize(publicArea->nameAlg);
 	sizeInBits =  sizeInBytes * 8;
-	if (tssVverbose) printf("TSS_ECC_Salt: "
+	if (tssVverbose) printf("TSS_ECC_Seed: "
 				"Calling TSS_KDFE\n");
 	/* TPM2B_DIGEST salt size is the largest supported digest algorithm.
 	   This has already been validated when unmarshaling the Name hash algorithm.
 	*/
-	/* salt = KDFe(tpmKey_NameAlg, sharedX, "SECRET", P_caller, P_tpm,
+	/* salt = KDFe(tpmKey_NameAlg, sharedX, label, P_caller, P_tpm,
 	   tpmKey_NameAlgSizeBits) */
 	salt->t.size = sizeInBytes;
 	rc = TSS_KDFE((uint8_t *)&salt->t.buffer, 	/* KDFe output */
 		      publicArea->nameAlg,		/* hash algorithm */
 		      &Zee.b,				/* Z - X point of pointP */
-		      "SECRET",				/* KDFe label */
+		      label,				/* KDFe label */
 		      &Qeu.x.b,				/* context U - ephemeral public point X */
 		      &publicArea->unique.ecc.x.b,	/* context V - X point of TPM key */
 		      sizeInBits);			/* required size of key in bits */
     }
     if (rc == 0) { 
-	if (tssVverbose) TSS_PrintAll("TSS_ECC_Salt: salt",
+	if (tssVverbose) TSS_PrintAll("TSS_ECC_Seed: salt",
 				      (uint8_t *)&salt->t.buffer,
 				      salt->t.size);
     }
@@ -61,7 +61,8 @@
 static uint32_t TSS_Dev_Open(TSS_CONTEXT *tssContext);
 static uint32_t TSS_Dev_SendCommand(int dev_fd, const uint8_t *buffer, uint16_t length,
 				    const char *message);
-static uint32_t TSS_Dev_ReceiveResponse(int dev_fd, uint8_t *buffer, uint32_t *length);
+static uint32_t TSS_Dev_ReceiveResponse(int dev_fd, uint8_t *buffer, uint32_t bufferSize,
+					uint32_t *length);
 
 /* global configuration */
 
@@ -96,7 +97,8 @@ TPM_RC TSS_Dev_Transmit(TSS_CONTEXT *tssContext,
     /* receive the response from the dev_fd.  Returns dev_fd errors, malformed response errors.
        Else returns the TPM response code. */
     if (rc == 0) {
-	rc = TSS_Dev_ReceiveResponse(tssContext->dev_fd, responseBuffer, read);
+	rc = TSS_Dev_ReceiveResponse(tssContext->dev_fd, responseBuffer,
+				     tssContext->tssTransmitResponseSize, read);
     }
     return rc;
 }
@@ -149,14 +151,15 @@ static uint32_t TSS_Dev_SendCommand(int dev_fd,
 }
 
 /* TSS_Dev_ReceiveResponse() reads a response buffer from the device.  'buffer' must be at least
-   MAX_RESPONSE_SIZE bytes.
+   'bufferSize' bytes.
 
    Returns TPM packet error code.
 
    Validates that the packet length and the packet responseSize match 
 */
 
-static uint32_t TSS_Dev_ReceiveResponse(int dev_fd, uint8_t *buffer, uint32_t *length)
+static uint32_t TSS_Dev_ReceiveResponse(int dev_fd, uint8_t *buffer, uint32_t bufferSize,
+					uint32_t *length)
 {
     uint32_t 	rc = 0;
     int 	irc;		/* read() return code, negative is error, positive is length */
@@ -168,7 +171,7 @@ static uint32_t TSS_Dev_ReceiveResponse(int dev_fd, uint8_t *buffer, uint32_t *l
     if (tssVverbose) printf("TSS_Dev_ReceiveResponse:\n");
     /* read the TPM device */
     if (rc == 0) {
-	irc = read(dev_fd, buffer, MAX_RESPONSE_SIZE);
+	irc = read(dev_fd, buffer, bufferSize);
 	if (irc <= 0) {
 	    rc = TSS_RC_BAD_CONNECTION;
 	    if (irc < 0) {
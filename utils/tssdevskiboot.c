@@ -112,10 +112,10 @@ TPM_RC TSS_Dev_Transmit(TSS_CONTEXT *tssContext,
 #error "MAX_COMMAND_SIZE cannot be greater than MAX_RESPONSE_SIZE. Potential overflow on the buffer for Command and Response"
 #endif
 	if (rc == 0) {
-		if (written > MAX_RESPONSE_SIZE) {
+		if (written > tssContext->tssTransmitResponseSize) {
 			if (tssVerbose)
 				printf("TSS_Skiboot_Transmit: Response Overflow. TPM wrote %u bytes, Max response size is %u ",
-				       written, MAX_RESPONSE_SIZE);
+				       written, tssContext->tssTransmitResponseSize);
 			rc = TSS_RC_BAD_CONNECTION;
 		}
 	}
@@ -132,7 +132,7 @@ TPM_RC TSS_Dev_Transmit(TSS_CONTEXT *tssContext,
 		 * max response size to length. In the response length will
 		 * contain the length of the response buffer.
 	 	 */
-		buffer_length = MAX_RESPONSE_SIZE;
+		buffer_length = tssContext->tssTransmitResponseSize;
 
 		memcpy(responseBuffer, commandBuffer, written);
 		rc = tssContext->tpm_driver->transmit(tssContext->tpm_device,
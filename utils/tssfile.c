@@ -41,6 +41,17 @@
 #include <string.h>
 #include <errno.h>
 
+#ifdef TPM_POSIX
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+#ifdef TPM_WINDOWS
+#include <windows.h>
+#include <direct.h>
+#include <process.h>
+#endif
+
 #include <ibmtss/tssresponsecode.h>
 #include <ibmtss/tsserror.h>
 #include <ibmtss/tssprint.h>
@@ -184,6 +195,57 @@ TPM_RC TSS_File_WriteBinaryFile(const unsigned char *data,
     return rc;
 }
 
+/* TSS_File_ReplaceBinaryFile() writes 'data' to 'filename' so that a concurrent reader sees either
+   the old or the new contents, never a partial file.
+
+   The data is written to a temporary file in the same directory, which is then renamed over
+   'filename'.  The temporary file name includes the process ID and a counter, so concurrent
+   writers do not collide.
+*/
+
+TPM_RC TSS_File_ReplaceBinaryFile(const unsigned char *data,
+				  size_t length,
+				  const char *filename) 
+{
+    TPM_RC		rc = 0;
+    int			irc;
+    char		*tmpFilename = NULL;
+    size_t		tmpLength;
+    unsigned long	pid;
+    static unsigned int	counter = 0;
+
+    /* filename.pid.counter.tmp */
+    if (rc == 0) {
+	tmpLength = strlen(filename) + 32;
+	rc = TSS_Malloc((unsigned char **)&tmpFilename, (uint32_t)tmpLength);	/* freed @1 */
+    }
+    if (rc == 0) {
+#ifdef TPM_WINDOWS
+	pid = (unsigned long)_getpid();
+#else
+	pid = (unsigned long)getpid();
+#endif
+	sprintf(tmpFilename, "%s.%lu.%u.tmp", filename, pid, counter++);
+	rc = TSS_File_WriteBinaryFile(data, length, tmpFilename);
+    }
+    if (rc == 0) {
+#ifdef TPM_WINDOWS
+	/* Windows rename() fails if the target exists */
+	irc = !MoveFileExA(tmpFilename, filename, MOVEFILE_REPLACE_EXISTING);
+#else
+	irc = rename(tmpFilename, filename);
+#endif
+	if (irc != 0) {
+	    if (tssVerbose) printf("TSS_File_ReplaceBinaryFile: Error renaming %s to %s\n",
+				   tmpFilename, filename);
+	    remove(tmpFilename);
+	    rc = TSS_RC_FILE_WRITE;
+	}
+    }
+    free(tmpFilename);		/* @1 */
+    return rc;
+}
+
 /* TSS_File_ReadStructure() is a general purpose "read a structure" function.
    
    It reads the filename, and then unmarshals the structure using "unmarshalFunction".
@@ -272,6 +334,33 @@ TPM_RC TSS_File_WriteStructure(void 			*structure,
     return rc;
 }
 
+/* TSS_File_ReplaceStructure() is TSS_File_WriteStructure() using TSS_File_ReplaceBinaryFile(), for
+   files that may be read concurrently.
+*/
+
+TPM_RC TSS_File_ReplaceStructure(void 			*structure,
+				 MarshalFunction_t 	marshalFunction,
+				 const char 		*filename)
+{
+    TPM_RC 	rc = 0;
+    uint16_t	written = 0;
+    uint8_t	*buffer = NULL;		/* for the free */
+
+    if (rc == 0) {
+	rc = TSS_Structure_Marshal(&buffer,	/* freed @1 */
+				   &written,
+				   structure,
+				   marshalFunction);
+    }
+    if (rc == 0) {
+	rc = TSS_File_ReplaceBinaryFile(buffer,
+					written,
+					filename); 
+    }
+    free(buffer);	/* @1 */
+    return rc;
+}
+
 /* TSS_File_Read2B() reads 'filename' and copies the data to 'tpm2b', checking targetSize
 
  */
@@ -319,3 +408,48 @@ TPM_RC TSS_File_DeleteFile(const char *filename)
     }
     return rc;
 }
+
+/* TSS_File_CreateDirectory() creates 'dirname'.  It is not an error if the directory already
+   exists.  The new directory is accessible only by the owner.
+*/
+
+TPM_RC TSS_File_CreateDirectory(const char *dirname) 
+{
+    TPM_RC 	rc = 0;
+    int		irc;
+    
+    if (rc == 0) {
+#ifdef TPM_WINDOWS
+	irc = _mkdir(dirname);
+#else
+	irc = mkdir(dirname, 0700);
+#endif
+	if ((irc != 0) && (errno != EEXIST)) {
+	    if (tssVerbose) printf("TSS_File_CreateDirectory: Error creating %s, %s\n",
+				   dirname, strerror(errno));
+	    rc = TSS_RC_FILE_OPEN;
+	}
+    }
+    return rc;
+}
+
+/* TSS_File_RemoveDirectory() removes 'dirname', which must be empty.
+ */
+
+TPM_RC TSS_File_RemoveDirectory(const char *dirname) 
+{
+    TPM_RC 	rc = 0;
+    int		irc;
+    
+    if (rc == 0) {
+#ifdef TPM_WINDOWS
+	irc = _rmdir(dirname);
+#else
+	irc = rmdir(dirname);
+#endif
+	if (irc != 0) {
+	    rc = TSS_RC_FILE_REMOVE;
+	}
+    }
+    return rc;
+}
@@ -0,0 +1,87 @@
+#!/bin/sh
+#
+
+#################################################################################
+#										#
+#			    TSS C++ Interface Check				#
+#			     Written by Ken Goldman				#
+#		       IBM Thomas J. Watson Research Center			#
+#										#
+# (c) Copyright IBM Corporation 2026						#
+# 										#
+# All rights reserved.								#
+# 										#
+# Redistribution and use in source and binary forms, with or without		#
+# modification, are permitted provided that the following conditions are	#
+# met:										#
+# 										#
+# Redistributions of source code must retain the above copyright notice,	#
+# this list of conditions and the following disclaimer.				#
+# 										#
+# Redistributions in binary form must reproduce the above copyright		#
+# notice, this list of conditions and the following disclaimer in the		#
+# documentation and/or other materials provided with the distribution.		#
+# 										#
+# Neither the names of the IBM Corporation nor the names of its			#
+# contributors may be used to endorse or promote products derived from		#
+# this software without specific prior written permission.			#
+# 										#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		#
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		#
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR		#
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		#
+# HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	#
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		#
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,		#
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY		#
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		#
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE		#
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		#
+#										#
+#################################################################################
+
+# tsshppcheck.sh compiles testtsshpp.cpp with each TSS_HPP_NEGATIVE case, each of which must fail
+# to compile with the expected diagnostic.  It guards the compile time checks of ibmtss/tss.hpp.
+#
+# Usage: tsshppcheck.sh "C++ compiler and flags"
+#
+# e.g. tsshppcheck.sh "g++ -std=c++11 -DTPM_POSIX -DTPM_TPM20 -I."
+#
+# The patterns match both gcc and clang diagnostics.
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 \"C++ compiler and flags\"" >&2
+    exit 1
+fi
+
+CXXCMD="$1"
+SOURCE=`dirname $0`/testtsshpp.cpp
+OUT=tsshppcheck.out
+FAILURES=0
+
+check()
+{
+    if ${CXXCMD} -DTSS_HPP_NEGATIVE=$1 -fsyntax-only ${SOURCE} > ${OUT} 2>&1; then
+	echo "$0: case $1, $2, compiled" >&2
+	FAILURES=`expr ${FAILURES} + 1`
+    elif ! grep -E -q "$3" ${OUT}; then
+	echo "$0: case $1, $2, failed without \"$3\"" >&2
+	cat ${OUT} >&2
+	FAILURES=`expr ${FAILURES} + 1`
+    fi
+}
+
+check 1 "session for a command without sessions"	"too many sessions for this command"
+check 2 "no session for an authorization handle"	"too few sessions"
+check 3 "more than MAX_SESSION_NUM sessions"		"more than MAX_SESSION_NUM sessions"
+check 4 "session that is not an Auth"			"sessions must be ibmtss::Auth"
+check 5 "_In structure of another command"		"no matching function"
+check 6 "command not in the table"			"incomplete type|undefined template"
+check 7 "copy of an owner"				"deleted"
+
+rm -f ${OUT}
+if [ ${FAILURES} -ne 0 ]; then
+    echo "$0: ${FAILURES} cases failed" >&2
+    exit 1
+fi
+exit 0
@@ -43,6 +43,8 @@
 #include <ibmtss/tssprint.h>
 #include <ibmtss/Unmarshal_fp.h>
 
+#include "tssmarshaldesc.h"
+
 /* This file holds:
 
    ---------------------------------------
@@ -239,6 +241,7 @@ TSS_Array_Marshalu(const BYTE *source, uint16_t sourceSize, uint16_t *written, B
   TPM 2.0 Command parameter marshaling
 */
 
+#if CC_Startup
 TPM_RC
 TSS_Startup_In_Marshalu(const Startup_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -248,6 +251,8 @@ TSS_Startup_In_Marshalu(const Startup_In *source, uint16_t *written, BYTE **buff
     }
     return rc;
 }
+#endif
+#if CC_Shutdown
 TPM_RC
 TSS_Shutdown_In_Marshalu(const Shutdown_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -257,6 +262,8 @@ TSS_Shutdown_In_Marshalu(const Shutdown_In *source, uint16_t *written, BYTE **bu
     }
     return rc;
 }
+#endif
+#if CC_SelfTest
 TPM_RC
 TSS_SelfTest_In_Marshalu(const SelfTest_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -266,6 +273,8 @@ TSS_SelfTest_In_Marshalu(const SelfTest_In *source, uint16_t *written, BYTE **bu
     }
     return rc;
 }
+#endif
+#if CC_IncrementalSelfTest
 TPM_RC
 TSS_IncrementalSelfTest_In_Marshalu(const IncrementalSelfTest_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -275,6 +284,8 @@ TSS_IncrementalSelfTest_In_Marshalu(const IncrementalSelfTest_In *source, uint16
     }
     return rc;
 }
+#endif
+#if CC_StartAuthSession
 TPM_RC
 TSS_StartAuthSession_In_Marshalu(const StartAuthSession_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -302,6 +313,8 @@ TSS_StartAuthSession_In_Marshalu(const StartAuthSession_In *source, uint16_t *wr
     }
     return rc;
 }
+#endif
+#if CC_PolicyRestart
 TPM_RC
 TSS_PolicyRestart_In_Marshalu(const PolicyRestart_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -311,6 +324,8 @@ TSS_PolicyRestart_In_Marshalu(const PolicyRestart_In *source, uint16_t *written,
     }
     return rc;
 }
+#endif
+#if CC_Create
 TPM_RC
 TSS_Create_In_Marshalu(const Create_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -332,6 +347,8 @@ TSS_Create_In_Marshalu(const Create_In *source, uint16_t *written, BYTE **buffer
     }
     return rc;
 }
+#endif
+#if CC_Load
 TPM_RC
 TSS_Load_In_Marshalu(const Load_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -347,6 +364,8 @@ TSS_Load_In_Marshalu(const Load_In *source, uint16_t *written, BYTE **buffer, ui
     }
     return rc;
 }
+#endif
+#if CC_LoadExternal
 TPM_RC
 TSS_LoadExternal_In_Marshalu(const LoadExternal_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -369,6 +388,8 @@ TSS_LoadExternal_In_Marshalu(const LoadExternal_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_ReadPublic
 TPM_RC
 TSS_ReadPublic_In_Marshalu(const ReadPublic_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -378,6 +399,8 @@ TSS_ReadPublic_In_Marshalu(const ReadPublic_In *source, uint16_t *written, BYTE
     }
     return rc;
 }
+#endif
+#if CC_ActivateCredential
 TPM_RC
 TSS_ActivateCredential_In_Marshalu(const ActivateCredential_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -396,6 +419,8 @@ TSS_ActivateCredential_In_Marshalu(const ActivateCredential_In *source, uint16_t
     }
     return rc;
 }
+#endif
+#if CC_MakeCredential
 TPM_RC
 TSS_MakeCredential_In_Marshalu(const MakeCredential_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -411,6 +436,8 @@ TSS_MakeCredential_In_Marshalu(const MakeCredential_In *source, uint16_t *writte
     }
     return rc;
 }
+#endif
+#if CC_Unseal
 TPM_RC
 TSS_Unseal_In_Marshalu(const Unseal_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -420,6 +447,8 @@ TSS_Unseal_In_Marshalu(const Unseal_In *source, uint16_t *written, BYTE **buffer
     }
     return rc;
 }
+#endif
+#if CC_ObjectChangeAuth
 TPM_RC
 TSS_ObjectChangeAuth_In_Marshalu(const ObjectChangeAuth_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -435,6 +464,8 @@ TSS_ObjectChangeAuth_In_Marshalu(const ObjectChangeAuth_In *source, uint16_t *wr
     }
     return rc;
 }
+#endif
+#if CC_CreateLoaded
 TPM_RC
 TSS_CreateLoaded_In_Marshalu(const CreateLoaded_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -450,6 +481,8 @@ TSS_CreateLoaded_In_Marshalu(const CreateLoaded_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_Duplicate
 TPM_RC
 TSS_Duplicate_In_Marshalu(const Duplicate_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -468,6 +501,8 @@ TSS_Duplicate_In_Marshalu(const Duplicate_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_Rewrap
 TPM_RC
 TSS_Rewrap_In_Marshalu(const Rewrap_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -489,6 +524,8 @@ TSS_Rewrap_In_Marshalu(const Rewrap_In *source, uint16_t *written, BYTE **buffer
     }
     return rc;
 }
+#endif
+#if CC_Import
 TPM_RC
 TSS_Import_In_Marshalu(const Import_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -513,6 +550,8 @@ TSS_Import_In_Marshalu(const Import_In *source, uint16_t *written, BYTE **buffer
     }
     return rc;
 }
+#endif
+#if CC_RSA_Encrypt
 TPM_RC
 TSS_RSA_Encrypt_In_Marshalu(const RSA_Encrypt_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -531,6 +570,8 @@ TSS_RSA_Encrypt_In_Marshalu(const RSA_Encrypt_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_RSA_Decrypt
 TPM_RC
 TSS_RSA_Decrypt_In_Marshalu(const RSA_Decrypt_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -549,6 +590,8 @@ TSS_RSA_Decrypt_In_Marshalu(const RSA_Decrypt_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_ECDH_KeyGen
 TPM_RC
 TSS_ECDH_KeyGen_In_Marshalu(const ECDH_KeyGen_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -558,6 +601,8 @@ TSS_ECDH_KeyGen_In_Marshalu(const ECDH_KeyGen_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_ECDH_ZGen
 TPM_RC
 TSS_ECDH_ZGen_In_Marshalu(const ECDH_ZGen_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -570,6 +615,8 @@ TSS_ECDH_ZGen_In_Marshalu(const ECDH_ZGen_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_ECC_Parameters
 TPM_RC
 TSS_ECC_Parameters_In_Marshalu(const ECC_Parameters_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -579,6 +626,8 @@ TSS_ECC_Parameters_In_Marshalu(const ECC_Parameters_In *source, uint16_t *writte
     }
     return rc;
 }
+#endif
+#if CC_ECC_Encrypt
 TPM_RC
 TSS_ECC_Encrypt_In_Marshalu(const ECC_Encrypt_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -594,6 +643,8 @@ TSS_ECC_Encrypt_In_Marshalu(const ECC_Encrypt_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_ECC_Decrypt
 TPM_RC
 TSS_ECC_Decrypt_In_Marshalu(const ECC_Decrypt_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -615,6 +666,8 @@ TSS_ECC_Decrypt_In_Marshalu(const ECC_Decrypt_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_ZGen_2Phase
 TPM_RC
 TSS_ZGen_2Phase_In_Marshalu(const ZGen_2Phase_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -636,6 +689,8 @@ TSS_ZGen_2Phase_In_Marshalu(const ZGen_2Phase_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_EncryptDecrypt
 TPM_RC
 TSS_EncryptDecrypt_In_Marshalu(const EncryptDecrypt_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -657,6 +712,8 @@ TSS_EncryptDecrypt_In_Marshalu(const EncryptDecrypt_In *source, uint16_t *writte
     }
     return rc;
 }
+#endif
+#if CC_EncryptDecrypt2
 TPM_RC
 TSS_EncryptDecrypt2_In_Marshalu(const EncryptDecrypt2_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -678,6 +735,8 @@ TSS_EncryptDecrypt2_In_Marshalu(const EncryptDecrypt2_In *source, uint16_t *writ
     }
     return rc;
 }
+#endif
+#if CC_Hash
 TPM_RC
 TSS_Hash_In_Marshalu(const Hash_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -693,6 +752,8 @@ TSS_Hash_In_Marshalu(const Hash_In *source, uint16_t *written, BYTE **buffer, ui
     }
     return rc;
 }
+#endif
+#if CC_HMAC
 TPM_RC
 TSS_HMAC_In_Marshalu(const HMAC_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -708,6 +769,8 @@ TSS_HMAC_In_Marshalu(const HMAC_In *source, uint16_t *written, BYTE **buffer, ui
     }
     return rc;
 }
+#endif
+#if CC_GetRandom
 TPM_RC
 TSS_GetRandom_In_Marshalu(const GetRandom_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -717,6 +780,8 @@ TSS_GetRandom_In_Marshalu(const GetRandom_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_StirRandom
 TPM_RC
 TSS_StirRandom_In_Marshalu(const StirRandom_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -726,6 +791,8 @@ TSS_StirRandom_In_Marshalu(const StirRandom_In *source, uint16_t *written, BYTE
     }
     return rc;
 }
+#endif
+#if CC_HMAC_Start
 TPM_RC
 TSS_HMAC_Start_In_Marshalu(const HMAC_Start_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -741,6 +808,8 @@ TSS_HMAC_Start_In_Marshalu(const HMAC_Start_In *source, uint16_t *written, BYTE
     }
     return rc;
 }
+#endif
+#if CC_HashSequenceStart
 TPM_RC
 TSS_HashSequenceStart_In_Marshalu(const HashSequenceStart_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -753,6 +822,8 @@ TSS_HashSequenceStart_In_Marshalu(const HashSequenceStart_In *source, uint16_t *
     }
     return rc;
 }
+#endif
+#if CC_SequenceUpdate
 TPM_RC
 TSS_SequenceUpdate_In_Marshalu(const SequenceUpdate_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -765,6 +836,8 @@ TSS_SequenceUpdate_In_Marshalu(const SequenceUpdate_In *source, uint16_t *writte
     }
     return rc;
 }
+#endif
+#if CC_SequenceComplete
 TPM_RC
 TSS_SequenceComplete_In_Marshalu(const SequenceComplete_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -780,6 +853,8 @@ TSS_SequenceComplete_In_Marshalu(const SequenceComplete_In *source, uint16_t *wr
     }
     return rc;
 }
+#endif
+#if CC_EventSequenceComplete
 TPM_RC
 TSS_EventSequenceComplete_In_Marshalu(const EventSequenceComplete_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -795,6 +870,8 @@ TSS_EventSequenceComplete_In_Marshalu(const EventSequenceComplete_In *source, ui
     }
     return rc;
 }
+#endif
+#if CC_Certify
 TPM_RC
 TSS_Certify_In_Marshalu(const Certify_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -813,6 +890,8 @@ TSS_Certify_In_Marshalu(const Certify_In *source, uint16_t *written, BYTE **buff
     }
     return rc;
 }
+#endif
+#if CC_CertifyCreation
 TPM_RC
 TSS_CertifyCreation_In_Marshalu(const CertifyCreation_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -837,6 +916,8 @@ TSS_CertifyCreation_In_Marshalu(const CertifyCreation_In *source, uint16_t *writ
     }
     return rc;
 }
+#endif
+#if CC_CertifyX509
 TPM_RC
 TSS_CertifyX509_In_Marshalu(const CertifyX509_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -858,6 +939,8 @@ TSS_CertifyX509_In_Marshalu(const CertifyX509_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_Quote
 TPM_RC
 TSS_Quote_In_Marshalu(const Quote_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -876,6 +959,8 @@ TSS_Quote_In_Marshalu(const Quote_In *source, uint16_t *written, BYTE **buffer,
     }
     return rc;
 }
+#endif
+#if CC_GetSessionAuditDigest
 TPM_RC
 TSS_GetSessionAuditDigest_In_Marshalu(const GetSessionAuditDigest_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -897,6 +982,8 @@ TSS_GetSessionAuditDigest_In_Marshalu(const GetSessionAuditDigest_In *source, ui
     }
     return rc;
 }
+#endif
+#if CC_GetCommandAuditDigest
 TPM_RC
 TSS_GetCommandAuditDigest_In_Marshalu(const GetCommandAuditDigest_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -915,6 +1002,8 @@ TSS_GetCommandAuditDigest_In_Marshalu(const GetCommandAuditDigest_In *source, ui
     }
     return rc;
 }
+#endif
+#if CC_GetTime
 TPM_RC
 TSS_GetTime_In_Marshalu(const GetTime_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -933,6 +1022,8 @@ TSS_GetTime_In_Marshalu(const GetTime_In *source, uint16_t *written, BYTE **buff
     }
     return rc;
 }
+#endif
+#if CC_Commit
 TPM_RC
 TSS_Commit_In_Marshalu(const Commit_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -951,6 +1042,8 @@ TSS_Commit_In_Marshalu(const Commit_In *source, uint16_t *written, BYTE **buffer
     }
     return rc;
 }
+#endif
+#if CC_EC_Ephemeral
 TPM_RC
 TSS_EC_Ephemeral_In_Marshalu(const EC_Ephemeral_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -960,6 +1053,8 @@ TSS_EC_Ephemeral_In_Marshalu(const EC_Ephemeral_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_VerifySignature
 TPM_RC
 TSS_VerifySignature_In_Marshalu(const VerifySignature_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -975,6 +1070,8 @@ TSS_VerifySignature_In_Marshalu(const VerifySignature_In *source, uint16_t *writ
     }
     return rc;
 }
+#endif
+#if CC_Sign
 TPM_RC
 TSS_Sign_In_Marshalu(const Sign_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -993,6 +1090,8 @@ TSS_Sign_In_Marshalu(const Sign_In *source, uint16_t *written, BYTE **buffer, ui
     }
     return rc;
 }
+#endif
+#if CC_SetCommandCodeAuditStatus
 TPM_RC
 TSS_SetCommandCodeAuditStatus_In_Marshalu(const SetCommandCodeAuditStatus_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1011,6 +1110,8 @@ TSS_SetCommandCodeAuditStatus_In_Marshalu(const SetCommandCodeAuditStatus_In *so
     }
     return rc;
 }
+#endif
+#if CC_PCR_Extend
 TPM_RC
 TSS_PCR_Extend_In_Marshalu(const PCR_Extend_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1023,6 +1124,8 @@ TSS_PCR_Extend_In_Marshalu(const PCR_Extend_In *source, uint16_t *written, BYTE
     }
     return rc;
 }
+#endif
+#if CC_PCR_Event
 TPM_RC
 TSS_PCR_Event_In_Marshalu(const PCR_Event_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1035,6 +1138,8 @@ TSS_PCR_Event_In_Marshalu(const PCR_Event_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_PCR_Read
 TPM_RC
 TSS_PCR_Read_In_Marshalu(const PCR_Read_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1044,6 +1149,8 @@ TSS_PCR_Read_In_Marshalu(const PCR_Read_In *source, uint16_t *written, BYTE **bu
     }
     return rc;
 }
+#endif
+#if CC_PCR_Allocate
 TPM_RC
 TSS_PCR_Allocate_In_Marshalu(const PCR_Allocate_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1056,6 +1163,8 @@ TSS_PCR_Allocate_In_Marshalu(const PCR_Allocate_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_PCR_SetAuthPolicy
 TPM_RC
 TSS_PCR_SetAuthPolicy_In_Marshalu(const PCR_SetAuthPolicy_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1074,6 +1183,8 @@ TSS_PCR_SetAuthPolicy_In_Marshalu(const PCR_SetAuthPolicy_In *source, uint16_t *
     }
     return rc;
 }
+#endif
+#if CC_PCR_SetAuthValue
 TPM_RC
 TSS_PCR_SetAuthValue_In_Marshalu(const PCR_SetAuthValue_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1086,6 +1197,8 @@ TSS_PCR_SetAuthValue_In_Marshalu(const PCR_SetAuthValue_In *source, uint16_t *wr
     }
     return rc;
 }
+#endif
+#if CC_PCR_Reset
 TPM_RC
 TSS_PCR_Reset_In_Marshalu(const PCR_Reset_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1095,6 +1208,8 @@ TSS_PCR_Reset_In_Marshalu(const PCR_Reset_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_PolicySigned
 TPM_RC
 TSS_PolicySigned_In_Marshalu(const PolicySigned_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1122,6 +1237,8 @@ TSS_PolicySigned_In_Marshalu(const PolicySigned_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_PolicySecret
 TPM_RC
 TSS_PolicySecret_In_Marshalu(const PolicySecret_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1146,6 +1263,8 @@ TSS_PolicySecret_In_Marshalu(const PolicySecret_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_PolicyTicket
 TPM_RC
 TSS_PolicyTicket_In_Marshalu(const PolicyTicket_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1170,6 +1289,8 @@ TSS_PolicyTicket_In_Marshalu(const PolicyTicket_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_PolicyOR
 TPM_RC
 TSS_PolicyOR_In_Marshalu(const PolicyOR_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1182,6 +1303,8 @@ TSS_PolicyOR_In_Marshalu(const PolicyOR_In *source, uint16_t *written, BYTE **bu
     }
     return rc;
 }
+#endif
+#if CC_PolicyPCR
 TPM_RC
 TSS_PolicyPCR_In_Marshalu(const PolicyPCR_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1197,6 +1320,8 @@ TSS_PolicyPCR_In_Marshalu(const PolicyPCR_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_PolicyLocality
 TPM_RC
 TSS_PolicyLocality_In_Marshalu(const PolicyLocality_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1209,6 +1334,8 @@ TSS_PolicyLocality_In_Marshalu(const PolicyLocality_In *source, uint16_t *writte
     }
     return rc;
 }
+#endif
+#if CC_PolicyNV
 TPM_RC
 TSS_PolicyNV_In_Marshalu(const PolicyNV_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1233,6 +1360,8 @@ TSS_PolicyNV_In_Marshalu(const PolicyNV_In *source, uint16_t *written, BYTE **bu
     }
     return rc;
 }
+#endif
+#if CC_PolicyCounterTimer
 TPM_RC
 TSS_PolicyCounterTimer_In_Marshalu(const PolicyCounterTimer_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1251,6 +1380,8 @@ TSS_PolicyCounterTimer_In_Marshalu(const PolicyCounterTimer_In *source, uint16_t
     }
     return rc;
 }
+#endif
+#if CC_PolicyCommandCode
 TPM_RC
 TSS_PolicyCommandCode_In_Marshalu(const PolicyCommandCode_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1263,6 +1394,8 @@ TSS_PolicyCommandCode_In_Marshalu(const PolicyCommandCode_In *source, uint16_t *
     }
     return rc;
 }
+#endif
+#if CC_PolicyPhysicalPresence
 TPM_RC
 TSS_PolicyPhysicalPresence_In_Marshalu(const PolicyPhysicalPresence_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1272,6 +1405,8 @@ TSS_PolicyPhysicalPresence_In_Marshalu(const PolicyPhysicalPresence_In *source,
     }
     return rc;
 }
+#endif
+#if CC_PolicyCpHash
 TPM_RC
 TSS_PolicyCpHash_In_Marshalu(const PolicyCpHash_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1284,6 +1419,8 @@ TSS_PolicyCpHash_In_Marshalu(const PolicyCpHash_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_PolicyNameHash
 TPM_RC
 TSS_PolicyNameHash_In_Marshalu(const PolicyNameHash_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1296,6 +1433,8 @@ TSS_PolicyNameHash_In_Marshalu(const PolicyNameHash_In *source, uint16_t *writte
     }
     return rc;
 }
+#endif
+#if CC_PolicyDuplicationSelect
 TPM_RC
 TSS_PolicyDuplicationSelect_In_Marshalu(const PolicyDuplicationSelect_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1314,6 +1453,8 @@ TSS_PolicyDuplicationSelect_In_Marshalu(const PolicyDuplicationSelect_In *source
     }
     return rc;
 }
+#endif
+#if CC_PolicyAuthorize
 TPM_RC
 TSS_PolicyAuthorize_In_Marshalu(const PolicyAuthorize_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1335,6 +1476,8 @@ TSS_PolicyAuthorize_In_Marshalu(const PolicyAuthorize_In *source, uint16_t *writ
     }
     return rc;
 }
+#endif
+#if CC_PolicyAuthValue
 TPM_RC
 TSS_PolicyAuthValue_In_Marshalu(const PolicyAuthValue_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1344,6 +1487,8 @@ TSS_PolicyAuthValue_In_Marshalu(const PolicyAuthValue_In *source, uint16_t *writ
     }
     return rc;
 }
+#endif
+#if CC_PolicyPassword
 TPM_RC
 TSS_PolicyPassword_In_Marshalu(const PolicyPassword_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1353,6 +1498,8 @@ TSS_PolicyPassword_In_Marshalu(const PolicyPassword_In *source, uint16_t *writte
     }
     return rc;
 }
+#endif
+#if CC_PolicyGetDigest
 TPM_RC
 TSS_PolicyGetDigest_In_Marshalu(const PolicyGetDigest_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1362,6 +1509,8 @@ TSS_PolicyGetDigest_In_Marshalu(const PolicyGetDigest_In *source, uint16_t *writ
     }
     return rc;
 }
+#endif
+#if CC_PolicyNvWritten
 TPM_RC
 TSS_PolicyNvWritten_In_Marshalu(const PolicyNvWritten_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1374,6 +1523,8 @@ TSS_PolicyNvWritten_In_Marshalu(const PolicyNvWritten_In *source, uint16_t *writ
     }
     return rc;
 }
+#endif
+#if CC_PolicyTemplate
 TPM_RC
 TSS_PolicyTemplate_In_Marshalu(const PolicyTemplate_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1386,6 +1537,8 @@ TSS_PolicyTemplate_In_Marshalu(const PolicyTemplate_In *source, uint16_t *writte
     }
     return rc;
 }
+#endif
+#if CC_PolicyCapability
 TPM_RC
 TSS_PolicyCapability_In_Marshalu(const PolicyCapability_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1410,6 +1563,8 @@ TSS_PolicyCapability_In_Marshalu(const PolicyCapability_In *source, uint16_t *wr
     }
     return rc;
 }
+#endif
+#if CC_PolicyParameters
 TPM_RC
 TSS_PolicyParameters_In_Marshalu(const PolicyParameters_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1422,6 +1577,8 @@ TSS_PolicyParameters_In_Marshalu(const PolicyParameters_In *source, uint16_t *wr
     }
     return rc;
 }
+#endif
+#if CC_PolicyAuthorizeNV
 TPM_RC
 TSS_PolicyAuthorizeNV_In_Marshalu(const PolicyAuthorizeNV_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1437,6 +1594,8 @@ TSS_PolicyAuthorizeNV_In_Marshalu(const PolicyAuthorizeNV_In *source, uint16_t *
     }
     return rc;
 }
+#endif
+#if CC_CreatePrimary
 TPM_RC
 TSS_CreatePrimary_In_Marshalu(const CreatePrimary_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1458,6 +1617,8 @@ TSS_CreatePrimary_In_Marshalu(const CreatePrimary_In *source, uint16_t *written,
     }
     return rc;
 }
+#endif
+#if CC_HierarchyControl
 TPM_RC
 TSS_HierarchyControl_In_Marshalu(const HierarchyControl_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1473,6 +1634,8 @@ TSS_HierarchyControl_In_Marshalu(const HierarchyControl_In *source, uint16_t *wr
     }
     return rc;
 }
+#endif
+#if CC_SetPrimaryPolicy
 TPM_RC
 TSS_SetPrimaryPolicy_In_Marshalu(const SetPrimaryPolicy_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1488,6 +1651,8 @@ TSS_SetPrimaryPolicy_In_Marshalu(const SetPrimaryPolicy_In *source, uint16_t *wr
     }
     return rc;
 }
+#endif
+#if CC_ChangePPS
 TPM_RC
 TSS_ChangePPS_In_Marshalu(const ChangePPS_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1497,6 +1662,8 @@ TSS_ChangePPS_In_Marshalu(const ChangePPS_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_ChangeEPS
 TPM_RC
 TSS_ChangeEPS_In_Marshalu(const ChangeEPS_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1506,6 +1673,8 @@ TSS_ChangeEPS_In_Marshalu(const ChangeEPS_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_Clear
 TPM_RC
 TSS_Clear_In_Marshalu(const Clear_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1515,6 +1684,8 @@ TSS_Clear_In_Marshalu(const Clear_In *source, uint16_t *written, BYTE **buffer,
     }
     return rc;
 }
+#endif
+#if CC_ClearControl
 TPM_RC
 TSS_ClearControl_In_Marshalu(const ClearControl_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1527,6 +1698,8 @@ TSS_ClearControl_In_Marshalu(const ClearControl_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_HierarchyChangeAuth
 TPM_RC
 TSS_HierarchyChangeAuth_In_Marshalu(const HierarchyChangeAuth_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1539,6 +1712,8 @@ TSS_HierarchyChangeAuth_In_Marshalu(const HierarchyChangeAuth_In *source, uint16
     }
     return rc;
 }
+#endif
+#if CC_DictionaryAttackLockReset
 TPM_RC
 TSS_DictionaryAttackLockReset_In_Marshalu(const DictionaryAttackLockReset_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1548,6 +1723,8 @@ TSS_DictionaryAttackLockReset_In_Marshalu(const DictionaryAttackLockReset_In *so
     }
     return rc;
 }
+#endif
+#if CC_DictionaryAttackParameters
 TPM_RC
 TSS_DictionaryAttackParameters_In_Marshalu(const DictionaryAttackParameters_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1566,6 +1743,8 @@ TSS_DictionaryAttackParameters_In_Marshalu(const DictionaryAttackParameters_In *
     }
     return rc;
 }
+#endif
+#if CC_PP_Commands
 TPM_RC
 TSS_PP_Commands_In_Marshalu(const PP_Commands_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1581,6 +1760,8 @@ TSS_PP_Commands_In_Marshalu(const PP_Commands_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_SetAlgorithmSet
 TPM_RC
 TSS_SetAlgorithmSet_In_Marshalu(const SetAlgorithmSet_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1593,6 +1774,8 @@ TSS_SetAlgorithmSet_In_Marshalu(const SetAlgorithmSet_In *source, uint16_t *writ
     }
     return rc;
 }
+#endif
+#if CC_ContextSave
 TPM_RC
 TSS_ContextSave_In_Marshalu(const ContextSave_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1602,6 +1785,8 @@ TSS_ContextSave_In_Marshalu(const ContextSave_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_ContextLoad
 TPM_RC
 TSS_ContextLoad_In_Marshalu(const ContextLoad_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1611,6 +1796,8 @@ TSS_ContextLoad_In_Marshalu(const ContextLoad_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_FlushContext
 TPM_RC
 TSS_FlushContext_In_Marshalu(const FlushContext_In *source, uint16_t *written, BYTE **buffer, uint32_t *size) 
 {
@@ -1620,6 +1807,8 @@ TSS_FlushContext_In_Marshalu(const FlushContext_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_EvictControl
 TPM_RC
 TSS_EvictControl_In_Marshalu(const EvictControl_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1635,6 +1824,8 @@ TSS_EvictControl_In_Marshalu(const EvictControl_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_ClockSet
 TPM_RC
 TSS_ClockSet_In_Marshalu(const ClockSet_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1647,6 +1838,8 @@ TSS_ClockSet_In_Marshalu(const ClockSet_In *source, uint16_t *written, BYTE **bu
     }
     return rc;
 }
+#endif
+#if CC_ClockRateAdjust
 TPM_RC
 TSS_ClockRateAdjust_In_Marshalu(const ClockRateAdjust_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1659,6 +1852,8 @@ TSS_ClockRateAdjust_In_Marshalu(const ClockRateAdjust_In *source, uint16_t *writ
     }
     return rc;
 }
+#endif
+#if CC_GetCapability
 TPM_RC
 TSS_GetCapability_In_Marshalu(const GetCapability_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1674,6 +1869,8 @@ TSS_GetCapability_In_Marshalu(const GetCapability_In *source, uint16_t *written,
     }
     return rc;
 }
+#endif
+#if CC_TestParms
 TPM_RC
 TSS_TestParms_In_Marshalu(const TestParms_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1683,6 +1880,8 @@ TSS_TestParms_In_Marshalu(const TestParms_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_NV_DefineSpace
 TPM_RC
 TSS_NV_DefineSpace_In_Marshalu(const NV_DefineSpace_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1698,6 +1897,8 @@ TSS_NV_DefineSpace_In_Marshalu(const NV_DefineSpace_In *source, uint16_t *writte
     }
     return rc;
 }
+#endif
+#if CC_NV_UndefineSpace
 TPM_RC
 TSS_NV_UndefineSpace_In_Marshalu(const NV_UndefineSpace_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1710,6 +1911,8 @@ TSS_NV_UndefineSpace_In_Marshalu(const NV_UndefineSpace_In *source, uint16_t *wr
     }
     return rc;
 }
+#endif
+#if CC_NV_UndefineSpaceSpecial
 TPM_RC
 TSS_NV_UndefineSpaceSpecial_In_Marshalu(const NV_UndefineSpaceSpecial_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1722,6 +1925,8 @@ TSS_NV_UndefineSpaceSpecial_In_Marshalu(const NV_UndefineSpaceSpecial_In *source
     }
     return rc;
 }
+#endif
+#if CC_NV_ReadPublic
 TPM_RC
 TSS_NV_ReadPublic_In_Marshalu(const NV_ReadPublic_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1731,6 +1936,8 @@ TSS_NV_ReadPublic_In_Marshalu(const NV_ReadPublic_In *source, uint16_t *written,
     }
     return rc;
 }
+#endif
+#if CC_NV_Write
 TPM_RC
 TSS_NV_Write_In_Marshalu(const NV_Write_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1749,6 +1956,8 @@ TSS_NV_Write_In_Marshalu(const NV_Write_In *source, uint16_t *written, BYTE **bu
     }
     return rc;
 }
+#endif
+#if CC_NV_Increment
 TPM_RC
 TSS_NV_Increment_In_Marshalu(const NV_Increment_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1761,6 +1970,8 @@ TSS_NV_Increment_In_Marshalu(const NV_Increment_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_NV_Extend
 TPM_RC
 TSS_NV_Extend_In_Marshalu(const NV_Extend_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1776,6 +1987,8 @@ TSS_NV_Extend_In_Marshalu(const NV_Extend_In *source, uint16_t *written, BYTE **
     }
     return rc;
 }
+#endif
+#if CC_NV_SetBits
 TPM_RC
 TSS_NV_SetBits_In_Marshalu(const NV_SetBits_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1791,6 +2004,8 @@ TSS_NV_SetBits_In_Marshalu(const NV_SetBits_In *source, uint16_t *written, BYTE
     }
     return rc;
 }
+#endif
+#if CC_NV_WriteLock
 TPM_RC
 TSS_NV_WriteLock_In_Marshalu(const NV_WriteLock_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1803,6 +2018,8 @@ TSS_NV_WriteLock_In_Marshalu(const NV_WriteLock_In *source, uint16_t *written, B
     }
     return rc;
 }
+#endif
+#if CC_NV_GlobalWriteLock
 TPM_RC
 TSS_NV_GlobalWriteLock_In_Marshalu(const NV_GlobalWriteLock_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1812,6 +2029,8 @@ TSS_NV_GlobalWriteLock_In_Marshalu(const NV_GlobalWriteLock_In *source, uint16_t
     }
     return rc;
 }
+#endif
+#if CC_NV_Read
 TPM_RC
 TSS_NV_Read_In_Marshalu(const NV_Read_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1830,6 +2049,8 @@ TSS_NV_Read_In_Marshalu(const NV_Read_In *source, uint16_t *written, BYTE **buff
     }
     return rc;
 }
+#endif
+#if CC_NV_ReadLock
 TPM_RC
 TSS_NV_ReadLock_In_Marshalu(const NV_ReadLock_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1842,6 +2063,8 @@ TSS_NV_ReadLock_In_Marshalu(const NV_ReadLock_In *source, uint16_t *written, BYT
     }
     return rc;
 }
+#endif
+#if CC_NV_ChangeAuth
 TPM_RC
 TSS_NV_ChangeAuth_In_Marshalu(const NV_ChangeAuth_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1854,6 +2077,8 @@ TSS_NV_ChangeAuth_In_Marshalu(const NV_ChangeAuth_In *source, uint16_t *written,
     }
     return rc;
 }
+#endif
+#if CC_NV_Certify
 TPM_RC
 TSS_NV_Certify_In_Marshalu(const NV_Certify_In *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
@@ -1881,11 +2106,13 @@ TSS_NV_Certify_In_Marshalu(const NV_Certify_In *source, uint16_t *written, BYTE
     }
     return rc;
 }
+#endif
 
 /*
   TPM 2.0 Response parameter unmarshaling
 */
 
+#if CC_IncrementalSelfTest
 TPM_RC
 TSS_IncrementalSelfTest_Out_Unmarshalu(IncrementalSelfTest_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -1901,6 +2128,8 @@ TSS_IncrementalSelfTest_Out_Unmarshalu(IncrementalSelfTest_Out *target, TPM_ST t
     }
     return rc;
 }
+#endif
+#if CC_GetTestResult
 TPM_RC
 TSS_GetTestResult_Out_Unmarshalu(GetTestResult_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -1920,6 +2149,8 @@ TSS_GetTestResult_Out_Unmarshalu(GetTestResult_Out *target, TPM_ST tag, BYTE **b
     }
     return rc;
 }
+#endif
+#if CC_StartAuthSession
 TPM_RC
 TSS_StartAuthSession_Out_Unmarshalu(StartAuthSession_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -1939,6 +2170,8 @@ TSS_StartAuthSession_Out_Unmarshalu(StartAuthSession_Out *target, TPM_ST tag, BY
     }
     return rc;
 }
+#endif
+#if CC_Create
 TPM_RC
 TSS_Create_Out_Unmarshalu(Create_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -1967,6 +2200,8 @@ TSS_Create_Out_Unmarshalu(Create_Out *target, TPM_ST tag, BYTE **buffer, uint32_
     }
     return rc;
 }
+#endif
+#if CC_Load
 TPM_RC
 TSS_Load_Out_Unmarshalu(Load_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -1986,6 +2221,8 @@ TSS_Load_Out_Unmarshalu(Load_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *s
     }
     return rc;
 }
+#endif
+#if CC_LoadExternal
 TPM_RC
 TSS_LoadExternal_Out_Unmarshalu(LoadExternal_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2005,6 +2242,8 @@ TSS_LoadExternal_Out_Unmarshalu(LoadExternal_Out *target, TPM_ST tag, BYTE **buf
     }
     return rc;
 }
+#endif
+#if CC_ReadPublic
 TPM_RC
 TSS_ReadPublic_Out_Unmarshalu(ReadPublic_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2027,6 +2266,8 @@ TSS_ReadPublic_Out_Unmarshalu(ReadPublic_Out *target, TPM_ST tag, BYTE **buffer,
     }
     return rc;
 }
+#endif
+#if CC_ActivateCredential
 TPM_RC
 TSS_ActivateCredential_Out_Unmarshalu(ActivateCredential_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2043,6 +2284,8 @@ TSS_ActivateCredential_Out_Unmarshalu(ActivateCredential_Out *target, TPM_ST tag
     }
     return rc;
 }
+#endif
+#if CC_MakeCredential
 TPM_RC
 TSS_MakeCredential_Out_Unmarshalu(MakeCredential_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2062,6 +2305,8 @@ TSS_MakeCredential_Out_Unmarshalu(MakeCredential_Out *target, TPM_ST tag, BYTE *
     }
     return rc;
 }
+#endif
+#if CC_Unseal
 TPM_RC
 TSS_Unseal_Out_Unmarshalu(Unseal_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2077,6 +2322,8 @@ TSS_Unseal_Out_Unmarshalu(Unseal_Out *target, TPM_ST tag, BYTE **buffer, uint32_
     }
     return rc;
 }
+#endif
+#if CC_ObjectChangeAuth
 TPM_RC
 TSS_ObjectChangeAuth_Out_Unmarshalu(ObjectChangeAuth_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2092,6 +2339,8 @@ TSS_ObjectChangeAuth_Out_Unmarshalu(ObjectChangeAuth_Out *target, TPM_ST tag, BY
     }
     return rc;
 }
+#endif
+#if CC_CreateLoaded
 TPM_RC
 TSS_CreateLoaded_Out_Unmarshalu(CreateLoaded_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2117,6 +2366,8 @@ TSS_CreateLoaded_Out_Unmarshalu(CreateLoaded_Out *target, TPM_ST tag, BYTE **buf
     }
     return rc;
 }
+#endif
+#if CC_Duplicate
 TPM_RC
 TSS_Duplicate_Out_Unmarshalu(Duplicate_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2138,6 +2389,8 @@ TSS_Duplicate_Out_Unmarshalu(Duplicate_Out *target, TPM_ST tag, BYTE **buffer, u
     }
     return rc;
 }
+#endif
+#if CC_Rewrap
 TPM_RC
 TSS_Rewrap_Out_Unmarshalu(Rewrap_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2156,6 +2409,8 @@ TSS_Rewrap_Out_Unmarshalu(Rewrap_Out *target, TPM_ST tag, BYTE **buffer, uint32_
     }
     return rc;
 }
+#endif
+#if CC_Import
 TPM_RC
 TSS_Import_Out_Unmarshalu(Import_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2171,6 +2426,8 @@ TSS_Import_Out_Unmarshalu(Import_Out *target, TPM_ST tag, BYTE **buffer, uint32_
     }
     return rc;
 }
+#endif
+#if CC_RSA_Encrypt
 TPM_RC
 TSS_RSA_Encrypt_Out_Unmarshalu(RSA_Encrypt_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2186,6 +2443,8 @@ TSS_RSA_Encrypt_Out_Unmarshalu(RSA_Encrypt_Out *target, TPM_ST tag, BYTE **buffe
     }
     return rc;
 }
+#endif
+#if CC_RSA_Decrypt
 TPM_RC
 TSS_RSA_Decrypt_Out_Unmarshalu(RSA_Decrypt_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2201,6 +2460,8 @@ TSS_RSA_Decrypt_Out_Unmarshalu(RSA_Decrypt_Out *target, TPM_ST tag, BYTE **buffe
     }
     return rc;
 }
+#endif
+#if CC_ECDH_KeyGen
 TPM_RC
 TSS_ECDH_KeyGen_Out_Unmarshalu(ECDH_KeyGen_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2219,6 +2480,8 @@ TSS_ECDH_KeyGen_Out_Unmarshalu(ECDH_KeyGen_Out *target, TPM_ST tag, BYTE **buffe
     }
     return rc;
 }
+#endif
+#if CC_ECDH_ZGen
 TPM_RC
 TSS_ECDH_ZGen_Out_Unmarshalu(ECDH_ZGen_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2234,6 +2497,8 @@ TSS_ECDH_ZGen_Out_Unmarshalu(ECDH_ZGen_Out *target, TPM_ST tag, BYTE **buffer, u
     }
     return rc;
 }
+#endif
+#if CC_ECC_Parameters
 TPM_RC
 TSS_ECC_Parameters_Out_Unmarshalu(ECC_Parameters_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2249,6 +2514,8 @@ TSS_ECC_Parameters_Out_Unmarshalu(ECC_Parameters_Out *target, TPM_ST tag, BYTE *
     }
     return rc;
 }
+#endif
+#if CC_ECC_Encrypt
 TPM_RC
 TSS_ECC_Encrypt_Out_Unmarshalu(ECC_Encrypt_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2270,6 +2537,8 @@ TSS_ECC_Encrypt_Out_Unmarshalu(ECC_Encrypt_Out *target, TPM_ST tag, BYTE **buffe
     }
     return rc;
 }
+#endif
+#if CC_ECC_Decrypt
 TPM_RC
 TSS_ECC_Decrypt_Out_Unmarshalu(ECC_Decrypt_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2285,6 +2554,8 @@ TSS_ECC_Decrypt_Out_Unmarshalu(ECC_Decrypt_Out *target, TPM_ST tag, BYTE **buffe
     }
     return rc;
 }
+#endif
+#if CC_ZGen_2Phase
 TPM_RC
 TSS_ZGen_2Phase_Out_Unmarshalu(ZGen_2Phase_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2303,6 +2574,8 @@ TSS_ZGen_2Phase_Out_Unmarshalu(ZGen_2Phase_Out *target, TPM_ST tag, BYTE **buffe
     }
     return rc;
 }
+#endif
+#if CC_EncryptDecrypt
 TPM_RC
 TSS_EncryptDecrypt_Out_Unmarshalu(EncryptDecrypt_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2321,11 +2594,15 @@ TSS_EncryptDecrypt_Out_Unmarshalu(EncryptDecrypt_Out *target, TPM_ST tag, BYTE *
     }
     return rc;
 }
+#endif
+#if CC_EncryptDecrypt2
 TPM_RC
 TSS_EncryptDecrypt2_Out_Unmarshalu(EncryptDecrypt2_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
     return TSS_EncryptDecrypt_Out_Unmarshalu((EncryptDecrypt_Out *)target, tag, buffer, size);
 }
+#endif
+#if CC_Hash
 TPM_RC
 TSS_Hash_Out_Unmarshalu(Hash_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2344,6 +2621,8 @@ TSS_Hash_Out_Unmarshalu(Hash_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *s
     }
     return rc;
 }
+#endif
+#if CC_HMAC
 TPM_RC
 TSS_HMAC_Out_Unmarshalu(HMAC_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2359,6 +2638,8 @@ TSS_HMAC_Out_Unmarshalu(HMAC_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *s
     }
     return rc;
 }
+#endif
+#if CC_GetRandom
 TPM_RC
 TSS_GetRandom_Out_Unmarshalu(GetRandom_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2374,6 +2655,8 @@ TSS_GetRandom_Out_Unmarshalu(GetRandom_Out *target, TPM_ST tag, BYTE **buffer, u
     }
     return rc;
 }
+#endif
+#if CC_HMAC_Start
 TPM_RC
 TSS_HMAC_Start_Out_Unmarshalu(HMAC_Start_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2389,6 +2672,8 @@ TSS_HMAC_Start_Out_Unmarshalu(HMAC_Start_Out *target, TPM_ST tag, BYTE **buffer,
     }
     return rc;
 }
+#endif
+#if CC_HashSequenceStart
 TPM_RC
 TSS_HashSequenceStart_Out_Unmarshalu(HashSequenceStart_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2404,6 +2689,8 @@ TSS_HashSequenceStart_Out_Unmarshalu(HashSequenceStart_Out *target, TPM_ST tag,
     }
     return rc;
 }
+#endif
+#if CC_SequenceComplete
 TPM_RC
 TSS_SequenceComplete_Out_Unmarshalu(SequenceComplete_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2422,6 +2709,8 @@ TSS_SequenceComplete_Out_Unmarshalu(SequenceComplete_Out *target, TPM_ST tag, BY
     }
     return rc;
 }
+#endif
+#if CC_EventSequenceComplete
 TPM_RC
 TSS_EventSequenceComplete_Out_Unmarshalu(EventSequenceComplete_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2437,6 +2726,8 @@ TSS_EventSequenceComplete_Out_Unmarshalu(EventSequenceComplete_Out *target, TPM_
     }
     return rc;
 }
+#endif
+#if CC_Certify
 TPM_RC
 TSS_Certify_Out_Unmarshalu(Certify_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2455,6 +2746,8 @@ TSS_Certify_Out_Unmarshalu(Certify_Out *target, TPM_ST tag, BYTE **buffer, uint3
     }
     return rc;
 }
+#endif
+#if CC_CertifyCreation
 TPM_RC
 TSS_CertifyCreation_Out_Unmarshalu(CertifyCreation_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2473,6 +2766,8 @@ TSS_CertifyCreation_Out_Unmarshalu(CertifyCreation_Out *target, TPM_ST tag, BYTE
     }
     return rc;
 }
+#endif
+#if CC_CertifyX509
 TPM_RC
 TSS_CertifyX509_Out_Unmarshalu(CertifyX509_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2494,6 +2789,8 @@ TSS_CertifyX509_Out_Unmarshalu(CertifyX509_Out *target, TPM_ST tag, BYTE **buffe
     }
     return rc;
 }
+#endif
+#if CC_Quote
 TPM_RC
 TSS_Quote_Out_Unmarshalu(Quote_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2512,6 +2809,8 @@ TSS_Quote_Out_Unmarshalu(Quote_Out *target, TPM_ST tag, BYTE **buffer, uint32_t
     }
     return rc;
 }
+#endif
+#if CC_GetSessionAuditDigest
 TPM_RC
 TSS_GetSessionAuditDigest_Out_Unmarshalu(GetSessionAuditDigest_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2530,6 +2829,8 @@ TSS_GetSessionAuditDigest_Out_Unmarshalu(GetSessionAuditDigest_Out *target, TPM_
     }
     return rc;
 }
+#endif
+#if CC_GetCommandAuditDigest
 TPM_RC
 TSS_GetCommandAuditDigest_Out_Unmarshalu(GetCommandAuditDigest_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2548,6 +2849,8 @@ TSS_GetCommandAuditDigest_Out_Unmarshalu(GetCommandAuditDigest_Out *target, TPM_
     }
     return rc;
 }
+#endif
+#if CC_GetTime
 TPM_RC
 TSS_GetTime_Out_Unmarshalu(GetTime_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2566,6 +2869,8 @@ TSS_GetTime_Out_Unmarshalu(GetTime_Out *target, TPM_ST tag, BYTE **buffer, uint3
     }
     return rc;
 }
+#endif
+#if CC_Commit
 TPM_RC
 TSS_Commit_Out_Unmarshalu(Commit_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2590,6 +2895,8 @@ TSS_Commit_Out_Unmarshalu(Commit_Out *target, TPM_ST tag, BYTE **buffer, uint32_
     }
     return rc;
 }
+#endif
+#if CC_EC_Ephemeral
 TPM_RC
 TSS_EC_Ephemeral_Out_Unmarshalu(EC_Ephemeral_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2608,6 +2915,8 @@ TSS_EC_Ephemeral_Out_Unmarshalu(EC_Ephemeral_Out *target, TPM_ST tag, BYTE **buf
     }
     return rc;
 }
+#endif
+#if CC_VerifySignature
 TPM_RC
 TSS_VerifySignature_Out_Unmarshalu(VerifySignature_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2623,6 +2932,8 @@ TSS_VerifySignature_Out_Unmarshalu(VerifySignature_Out *target, TPM_ST tag, BYTE
     }
     return rc;
 }
+#endif
+#if CC_Sign
 TPM_RC
 TSS_Sign_Out_Unmarshalu(Sign_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2638,6 +2949,8 @@ TSS_Sign_Out_Unmarshalu(Sign_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *s
     }
     return rc;
 }
+#endif
+#if CC_PCR_Event
 TPM_RC
 TSS_PCR_Event_Out_Unmarshalu(PCR_Event_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2653,6 +2966,8 @@ TSS_PCR_Event_Out_Unmarshalu(PCR_Event_Out *target, TPM_ST tag, BYTE **buffer, u
     }
     return rc;
 }
+#endif
+#if CC_PCR_Read
 TPM_RC
 TSS_PCR_Read_Out_Unmarshalu(PCR_Read_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2674,6 +2989,8 @@ TSS_PCR_Read_Out_Unmarshalu(PCR_Read_Out *target, TPM_ST tag, BYTE **buffer, uin
     }
     return rc;
 }
+#endif
+#if CC_PCR_Allocate
 TPM_RC
 TSS_PCR_Allocate_Out_Unmarshalu(PCR_Allocate_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2698,6 +3015,8 @@ TSS_PCR_Allocate_Out_Unmarshalu(PCR_Allocate_Out *target, TPM_ST tag, BYTE **buf
     }
     return rc;
 }
+#endif
+#if CC_PolicySigned
 TPM_RC
 TSS_PolicySigned_Out_Unmarshalu(PolicySigned_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2716,6 +3035,8 @@ TSS_PolicySigned_Out_Unmarshalu(PolicySigned_Out *target, TPM_ST tag, BYTE **buf
     }
     return rc;
 }
+#endif
+#if CC_PolicySecret
 TPM_RC
 TSS_PolicySecret_Out_Unmarshalu(PolicySecret_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2734,6 +3055,8 @@ TSS_PolicySecret_Out_Unmarshalu(PolicySecret_Out *target, TPM_ST tag, BYTE **buf
     }
     return rc;
 }
+#endif
+#if CC_PolicyGetDigest
 TPM_RC
 TSS_PolicyGetDigest_Out_Unmarshalu(PolicyGetDigest_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2749,6 +3072,8 @@ TSS_PolicyGetDigest_Out_Unmarshalu(PolicyGetDigest_Out *target, TPM_ST tag, BYTE
     }
     return rc;
 }
+#endif
+#if CC_CreatePrimary
 TPM_RC
 TSS_CreatePrimary_Out_Unmarshalu(CreatePrimary_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2780,6 +3105,8 @@ TSS_CreatePrimary_Out_Unmarshalu(CreatePrimary_Out *target, TPM_ST tag, BYTE **b
     }
     return rc;
 }
+#endif
+#if CC_ContextSave
 TPM_RC
 TSS_ContextSave_Out_Unmarshalu(ContextSave_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2795,6 +3122,8 @@ TSS_ContextSave_Out_Unmarshalu(ContextSave_Out *target, TPM_ST tag, BYTE **buffe
     }
     return rc;
 }
+#endif
+#if CC_ContextLoad
 TPM_RC
 TSS_ContextLoad_Out_Unmarshalu(ContextLoad_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2810,6 +3139,8 @@ TSS_ContextLoad_Out_Unmarshalu(ContextLoad_Out *target, TPM_ST tag, BYTE **buffe
     }
     return rc;
 }
+#endif
+#if CC_ReadClock
 TPM_RC
 TSS_ReadClock_Out_Unmarshalu(ReadClock_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2825,6 +3156,8 @@ TSS_ReadClock_Out_Unmarshalu(ReadClock_Out *target, TPM_ST tag, BYTE **buffer, u
     }
     return rc;
 }
+#endif
+#if CC_GetCapability
 TPM_RC
 TSS_GetCapability_Out_Unmarshalu(GetCapability_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2844,6 +3177,8 @@ TSS_GetCapability_Out_Unmarshalu(GetCapability_Out *target, TPM_ST tag, BYTE **b
     }
     return rc;
 }
+#endif
+#if CC_NV_ReadPublic
 TPM_RC
 TSS_NV_ReadPublic_Out_Unmarshalu(NV_ReadPublic_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2862,6 +3197,8 @@ TSS_NV_ReadPublic_Out_Unmarshalu(NV_ReadPublic_Out *target, TPM_ST tag, BYTE **b
     }
     return rc;
 }
+#endif
+#if CC_NV_Read
 TPM_RC
 TSS_NV_Read_Out_Unmarshalu(NV_Read_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2877,6 +3214,8 @@ TSS_NV_Read_Out_Unmarshalu(NV_Read_Out *target, TPM_ST tag, BYTE **buffer, uint3
     }
     return rc;
 }
+#endif
+#if CC_NV_Certify
 TPM_RC
 TSS_NV_Certify_Out_Unmarshalu(NV_Certify_Out *target, TPM_ST tag, BYTE **buffer, uint32_t *size)
 {
@@ -2895,109 +3234,880 @@ TSS_NV_Certify_Out_Unmarshalu(NV_Certify_Out *target, TPM_ST tag, BYTE **buffer,
     }
     return rc;
 }
+#endif
 
 /*
   TPM 2.0 Structure marshaling
 */
 
+/* TSS_TPM2B_Marshalu() is called for every TPM2B, so when the buffer is large enough, the size and
+   the array are marshaled inline rather than through TSS_UINT16_Marshalu() and
+   TSS_Array_Marshalu(). */
+
 TPM_RC
 TSS_TPM2B_Marshalu(const TPM2B *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
     TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT16_Marshalu(&(source->size), written, buffer, size);
+    if (buffer == NULL) {
+	*written += sizeof(uint16_t) + source->size;
     }
-    if (rc == 0) {
-	rc = TSS_Array_Marshalu(source->buffer, source->size, written, buffer, size);
+    else if ((size == NULL) || (*size >= sizeof(uint16_t) + (uint32_t)source->size)) {
+	(*buffer)[0] = (BYTE)((source->size >> 8) & 0xff);
+	(*buffer)[1] = (BYTE)((source->size >> 0) & 0xff);
+	memcpy(*buffer + sizeof(uint16_t), source->buffer, source->size);
+	*buffer += sizeof(uint16_t) + source->size;
+	if (size != NULL) {
+	    *size -= sizeof(uint16_t) + source->size;
+	}
+	*written += sizeof(uint16_t) + source->size;
     }
-    return rc;
-}
-
-/* Table 5 - Definition of Types for Documentation Clarity */
-
-TPM_RC
-TSS_TPM_KEY_BITS_Marshalu(const TPM_KEY_BITS *source, uint16_t *written, BYTE **buffer, uint32_t *size)
-{
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT16_Marshalu(source, written, buffer, size);
+    else {
+	/* insufficient buffer, the same partial result and response code as before */
+	rc = TSS_UINT16_Marshalu(&(source->size), written, buffer, size);
+	if (rc == 0) {
+	    rc = TSS_Array_Marshalu(source->buffer, source->size, written, buffer, size);
+	}
     }
     return rc;
 }
-   
-/* Table 7 - Definition of (UINT32) TPM_GENERATED Constants <O> */
 
-TPM_RC
-TSS_TPM_GENERATED_Marshalu(const TPM_GENERATED *source, uint16_t *written, BYTE **buffer, uint32_t *size)
-{
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(source, written, buffer, size);
-    }
-    return rc;
-}
- 
-/* Table 9 - Definition of (UINT16) TPM_ALG_ID Constants <IN/OUT, S> */
+/* Descriptor tables for the structures marshaled and unmarshaled by TSS_Desc_Marshalu() and
+   TSS_Desc_Unmarshalu().  The fields are in marshaling order.  See tssmarshaldesc.h. */
 
-TPM_RC
-TSS_TPM_ALG_ID_Marshalu(const TPM_ALG_ID *source, uint16_t *written, BYTE **buffer, uint32_t *size)
-{
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT16_Marshalu(source, written, buffer, size);
-    }
-    return rc;
-}
+/* TPML elements that are scalars */
 
-/* Table 10 - Definition of (uint16_t) {ECC} TPM_ECC_CURVE Constants <IN/OUT, S> */
+static const TSS_DESC_FIELD tssFieldsUINT16[] = {
+    TSS_DESC_ELEMENT(TSS_DESC_UINT16)
+};
+static TSS_DESC_DEFINE(tssDescUINT16, UINT16, tssFieldsUINT16);
 
-#ifdef TPM_ALG_ECC
-TPM_RC
-TSS_TPM_ECC_CURVE_Marshalu(const TPM_ECC_CURVE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
-{
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT16_Marshalu(source, written, buffer, size);
-    }
-    return rc;
-}
-#endif
+static const TSS_DESC_FIELD tssFieldsUINT32[] = {
+    TSS_DESC_ELEMENT(TSS_DESC_UINT32)
+};
+static TSS_DESC_DEFINE(tssDescUINT32, UINT32, tssFieldsUINT32);
 
-/* Table 17 - Definition of (UINT32) TPM_RC Constants (Actions) <OUT> */
+static const TSS_DESC_FIELD tssFieldsTPMA_CC[] = {
+    TSS_DESC_CHECKED_ELEMENT(TSS_DESC_UINT32, TSS_TPMA_CC_Unmarshalu)
+};
+static TSS_DESC_DEFINE(tssDescTPMA_CC, TPMA_CC, tssFieldsTPMA_CC);
 
-TPM_RC
-TSS_TPM_RC_Marshalu(const TPM_RC *source, uint16_t *written, BYTE **buffer, uint32_t *size)
-{
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(source, written, buffer, size);
-    }
-    return rc;
-}
+/* Table 71 - Definition of TPMT_HA Structure <IN/OUT> */
 
-/* Table 18 - Definition of (INT8) TPM_CLOCK_ADJUST Constants <IN> */
+static const TSS_DESC_FIELD tssFieldsTPMT_HA[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_HA, hashAlg),
+    TSS_DESC_SELECTED(TPMT_HA, digest, hashAlg, TSS_TPMU_HA_Marshalu, TSS_TPMU_HA_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_HA, TPMT_HA, tssFieldsTPMT_HA);
 
-TPM_RC
-TSS_TPM_CLOCK_ADJUST_Marshalu(const TPM_CLOCK_ADJUST *source, uint16_t *written, BYTE **buffer, uint32_t *size)
-{
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_INT8_Marshalu(source, written, buffer, size);
-    }
-    return rc;
-}
+/* Table 85 - Definition of TPMS_PCR_SELECTION Structure */
 
-/* Table 19 - Definition of (UINT16) TPM_EO Constants <IN/OUT> */
+static const TSS_DESC_FIELD tssFieldsTPMS_PCR_SELECTION[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_PCR_SELECTION, hash),
+    TSS_DESC_SELECTION(TPMS_PCR_SELECTION, sizeofSelect, pcrSelect, PCR_SELECT_MAX)
+};
+TSS_DESC_DEFINE(tssDescTPMS_PCR_SELECTION, TPMS_PCR_SELECTION, tssFieldsTPMS_PCR_SELECTION);
 
-TPM_RC
-TSS_TPM_EO_Marshalu(const TPM_EO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
-{
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT16_Marshalu(source, written, buffer, size);
-    }
-    return rc;
-}
+/* Table 92 - Definition of TPMS_ALG_PROPERTY Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_ALG_PROPERTY[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_ALG_PROPERTY, alg),
+    TSS_DESC_CHECKED(TSS_DESC_UINT32, TPMS_ALG_PROPERTY, algProperties,
+		     TSS_TPMA_ALGORITHM_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMS_ALG_PROPERTY, TPMS_ALG_PROPERTY, tssFieldsTPMS_ALG_PROPERTY);
+
+/* Table 93 - Definition of TPMS_TAGGED_PROPERTY Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_TAGGED_PROPERTY[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_TAGGED_PROPERTY, property),
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_TAGGED_PROPERTY, value)
+};
+TSS_DESC_DEFINE(tssDescTPMS_TAGGED_PROPERTY, TPMS_TAGGED_PROPERTY, tssFieldsTPMS_TAGGED_PROPERTY);
+
+/* Table 94 - Definition of TPMS_TAGGED_PCR_SELECT Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_TAGGED_PCR_SELECT[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_TAGGED_PCR_SELECT, tag),
+    TSS_DESC_SELECTION(TPMS_TAGGED_PCR_SELECT, sizeofSelect, pcrSelect, PCR_SELECT_MAX)
+};
+TSS_DESC_DEFINE(tssDescTPMS_TAGGED_PCR_SELECT, TPMS_TAGGED_PCR_SELECT,
+		tssFieldsTPMS_TAGGED_PCR_SELECT);
+
+/* Table 100 - Definition of TPMS_TAGGED_POLICY Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_TAGGED_POLICY[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_TAGGED_POLICY, handle),
+    TSS_DESC_NESTED(TPMS_TAGGED_POLICY, policyHash, tssDescTPMT_HA)
+};
+TSS_DESC_DEFINE(tssDescTPMS_TAGGED_POLICY, TPMS_TAGGED_POLICY, tssFieldsTPMS_TAGGED_POLICY);
+
+/* Table 105 - Definition of TPMS_ACT_DATA Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_ACT_DATA[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_ACT_DATA, handle),
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_ACT_DATA, timeout),
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_ACT_DATA, attributes)
+};
+TSS_DESC_DEFINE(tssDescTPMS_ACT_DATA, TPMS_ACT_DATA, tssFieldsTPMS_ACT_DATA);
+
+/* Table 95 - Definition of TPML_CC Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPML_CC[] = {
+    TSS_DESC_ARRAY(TPML_CC, count, commandCodes, MAX_CAP_CC, tssDescUINT32)
+};
+TSS_DESC_DEFINE(tssDescTPML_CC, TPML_CC, tssFieldsTPML_CC);
+
+/* Table 96 - Definition of TPML_CCA Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPML_CCA[] = {
+    TSS_DESC_ARRAY(TPML_CCA, count, commandAttributes, MAX_CAP_CC, tssDescTPMA_CC)
+};
+TSS_DESC_DEFINE(tssDescTPML_CCA, TPML_CCA, tssFieldsTPML_CCA);
+
+/* Table 97 - Definition of TPML_ALG Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPML_ALG[] = {
+    TSS_DESC_ARRAY(TPML_ALG, count, algorithms, MAX_ALG_LIST_SIZE, tssDescUINT16)
+};
+TSS_DESC_DEFINE(tssDescTPML_ALG, TPML_ALG, tssFieldsTPML_ALG);
+
+/* Table 98 - Definition of TPML_HANDLE Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPML_HANDLE[] = {
+    TSS_DESC_ARRAY(TPML_HANDLE, count, handle, MAX_CAP_HANDLES, tssDescUINT32)
+};
+TSS_DESC_DEFINE(tssDescTPML_HANDLE, TPML_HANDLE, tssFieldsTPML_HANDLE);
+
+/* Table 100 - Definition of TPML_DIGEST_VALUES Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPML_DIGEST_VALUES[] = {
+    TSS_DESC_ARRAY(TPML_DIGEST_VALUES, count, digests, HASH_COUNT, tssDescTPMT_HA)
+};
+TSS_DESC_DEFINE(tssDescTPML_DIGEST_VALUES, TPML_DIGEST_VALUES, tssFieldsTPML_DIGEST_VALUES);
+
+/* Table 103 - Definition of TPML_ALG_PROPERTY Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPML_ALG_PROPERTY[] = {
+    TSS_DESC_ARRAY(TPML_ALG_PROPERTY, count, algProperties, MAX_CAP_ALGS,
+		   tssDescTPMS_ALG_PROPERTY)
+};
+TSS_DESC_DEFINE(tssDescTPML_ALG_PROPERTY, TPML_ALG_PROPERTY, tssFieldsTPML_ALG_PROPERTY);
+
+/* Table 104 - Definition of TPML_TAGGED_TPM_PROPERTY Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPML_TAGGED_TPM_PROPERTY[] = {
+    TSS_DESC_ARRAY(TPML_TAGGED_TPM_PROPERTY, count, tpmProperty, MAX_TPM_PROPERTIES,
+		   tssDescTPMS_TAGGED_PROPERTY)
+};
+TSS_DESC_DEFINE(tssDescTPML_TAGGED_TPM_PROPERTY, TPML_TAGGED_TPM_PROPERTY,
+		tssFieldsTPML_TAGGED_TPM_PROPERTY);
+
+/* Table 105 - Definition of TPML_TAGGED_PCR_PROPERTY Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPML_TAGGED_PCR_PROPERTY[] = {
+    TSS_DESC_ARRAY(TPML_TAGGED_PCR_PROPERTY, count, pcrProperty, MAX_PCR_PROPERTIES,
+		   tssDescTPMS_TAGGED_PCR_SELECT)
+};
+TSS_DESC_DEFINE(tssDescTPML_TAGGED_PCR_PROPERTY, TPML_TAGGED_PCR_PROPERTY,
+		tssFieldsTPML_TAGGED_PCR_PROPERTY);
+
+/* Table 106 - Definition of {ECC} TPML_ECC_CURVE Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPML_ECC_CURVE[] = {
+    TSS_DESC_ARRAY(TPML_ECC_CURVE, count, eccCurves, MAX_ECC_CURVES, tssDescUINT16)
+};
+TSS_DESC_DEFINE(tssDescTPML_ECC_CURVE, TPML_ECC_CURVE, tssFieldsTPML_ECC_CURVE);
+
+/* Table 112 - Definition of TPML_TAGGED_POLICY Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPML_TAGGED_POLICY[] = {
+    TSS_DESC_ARRAY(TPML_TAGGED_POLICY, count, policies, MAX_TAGGED_POLICIES,
+		   tssDescTPMS_TAGGED_POLICY)
+};
+TSS_DESC_DEFINE(tssDescTPML_TAGGED_POLICY, TPML_TAGGED_POLICY, tssFieldsTPML_TAGGED_POLICY);
+
+/* Table 112 - Definition of TPML_ACT_DATA Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPML_ACT_DATA[] = {
+    TSS_DESC_ARRAY(TPML_ACT_DATA, count, actData, MAX_ACT_DATA, tssDescTPMS_ACT_DATA)
+};
+TSS_DESC_DEFINE(tssDescTPML_ACT_DATA, TPML_ACT_DATA, tssFieldsTPML_ACT_DATA);
+
+/* Table 108 - Definition of TPMS_CAPABILITY_DATA Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_CAPABILITY_DATA[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_CAPABILITY_DATA, capability),
+    TSS_DESC_SELECTED(TPMS_CAPABILITY_DATA, data, capability,
+		      TSS_TPMU_CAPABILITIES_Marshalu, TSS_TPMU_CAPABILITIES_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMS_CAPABILITY_DATA, TPMS_CAPABILITY_DATA, tssFieldsTPMS_CAPABILITY_DATA);
+
+/* Table 109 - Definition of TPMS_CLOCK_INFO Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_CLOCK_INFO[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT64, TPMS_CLOCK_INFO, clock),
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_CLOCK_INFO, resetCount),
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_CLOCK_INFO, restartCount),
+    TSS_DESC_SCALAR(TSS_DESC_UINT8,  TPMS_CLOCK_INFO, safe)
+};
+TSS_DESC_DEFINE(tssDescTPMS_CLOCK_INFO, TPMS_CLOCK_INFO, tssFieldsTPMS_CLOCK_INFO);
+
+/* Table 110 - Definition of TPMS_TIME_INFO Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_TIME_INFO[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT64, TPMS_TIME_INFO, time),
+    TSS_DESC_NESTED(TPMS_TIME_INFO, clockInfo, tssDescTPMS_CLOCK_INFO)
+};
+TSS_DESC_DEFINE(tssDescTPMS_TIME_INFO, TPMS_TIME_INFO, tssFieldsTPMS_TIME_INFO);
+
+/* Table 111 - Definition of TPMS_TIME_ATTEST_INFO Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_TIME_ATTEST_INFO[] = {
+    TSS_DESC_NESTED(TPMS_TIME_ATTEST_INFO, time, tssDescTPMS_TIME_INFO),
+    TSS_DESC_SCALAR(TSS_DESC_UINT64, TPMS_TIME_ATTEST_INFO, firmwareVersion)
+};
+TSS_DESC_DEFINE(tssDescTPMS_TIME_ATTEST_INFO, TPMS_TIME_ATTEST_INFO,
+		tssFieldsTPMS_TIME_ATTEST_INFO);
+
+/* Table 112 - Definition of TPMS_CERTIFY_INFO Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_CERTIFY_INFO[] = {
+    TSS_DESC_2B(TPMS_CERTIFY_INFO, name, name),
+    TSS_DESC_2B(TPMS_CERTIFY_INFO, qualifiedName, name)
+};
+TSS_DESC_DEFINE(tssDescTPMS_CERTIFY_INFO, TPMS_CERTIFY_INFO, tssFieldsTPMS_CERTIFY_INFO);
+
+/* Table 113 - Definition of TPMS_QUOTE_INFO Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_QUOTE_INFO[] = {
+    TSS_DESC_SCALAR(TSS_DESC_PCR_SELECTION, TPMS_QUOTE_INFO, pcrSelect),
+    TSS_DESC_2B(TPMS_QUOTE_INFO, pcrDigest, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_QUOTE_INFO, TPMS_QUOTE_INFO, tssFieldsTPMS_QUOTE_INFO);
+
+/* Table 114 - Definition of TPMS_COMMAND_AUDIT_INFO Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_COMMAND_AUDIT_INFO[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT64, TPMS_COMMAND_AUDIT_INFO, auditCounter),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_COMMAND_AUDIT_INFO, digestAlg),
+    TSS_DESC_2B(TPMS_COMMAND_AUDIT_INFO, auditDigest, buffer),
+    TSS_DESC_2B(TPMS_COMMAND_AUDIT_INFO, commandDigest, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_COMMAND_AUDIT_INFO, TPMS_COMMAND_AUDIT_INFO,
+		tssFieldsTPMS_COMMAND_AUDIT_INFO);
+
+/* Table 115 - Definition of TPMS_SESSION_AUDIT_INFO Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_SESSION_AUDIT_INFO[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT8, TPMS_SESSION_AUDIT_INFO, exclusiveSession),
+    TSS_DESC_2B(TPMS_SESSION_AUDIT_INFO, sessionDigest, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_SESSION_AUDIT_INFO, TPMS_SESSION_AUDIT_INFO,
+		tssFieldsTPMS_SESSION_AUDIT_INFO);
+
+/* Table 116 - Definition of TPMS_CREATION_INFO Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_CREATION_INFO[] = {
+    TSS_DESC_2B(TPMS_CREATION_INFO, objectName, name),
+    TSS_DESC_2B(TPMS_CREATION_INFO, creationHash, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_CREATION_INFO, TPMS_CREATION_INFO, tssFieldsTPMS_CREATION_INFO);
+
+/* Table 117 - Definition of TPMS_NV_CERTIFY_INFO Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_NV_CERTIFY_INFO[] = {
+    TSS_DESC_2B(TPMS_NV_CERTIFY_INFO, indexName, name),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_NV_CERTIFY_INFO, offset),
+    TSS_DESC_2B(TPMS_NV_CERTIFY_INFO, nvContents, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_NV_CERTIFY_INFO, TPMS_NV_CERTIFY_INFO, tssFieldsTPMS_NV_CERTIFY_INFO);
+
+/* Table 125 - Definition of TPMS_NV_DIGEST_CERTIFY_INFO Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_NV_DIGEST_CERTIFY_INFO[] = {
+    TSS_DESC_2B(TPMS_NV_DIGEST_CERTIFY_INFO, indexName, name),
+    TSS_DESC_2B(TPMS_NV_DIGEST_CERTIFY_INFO, nvDigest, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_NV_DIGEST_CERTIFY_INFO, TPMS_NV_DIGEST_CERTIFY_INFO,
+		tssFieldsTPMS_NV_DIGEST_CERTIFY_INFO);
+
+/* Table 120 - Definition of TPMS_ATTEST Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_ATTEST[] = {
+    TSS_DESC_SCALAR(TSS_DESC_GENERATED, TPMS_ATTEST, magic),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_ATTEST, type),
+    TSS_DESC_2B(TPMS_ATTEST, qualifiedSigner, name),
+    TSS_DESC_2B(TPMS_ATTEST, extraData, buffer),
+    TSS_DESC_NESTED(TPMS_ATTEST, clockInfo, tssDescTPMS_CLOCK_INFO),
+    TSS_DESC_SCALAR(TSS_DESC_UINT64, TPMS_ATTEST, firmwareVersion),
+    TSS_DESC_SELECTED(TPMS_ATTEST, attested, type,
+		      TSS_TPMU_ATTEST_Marshalu, TSS_TPMU_ATTEST_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMS_ATTEST, TPMS_ATTEST, tssFieldsTPMS_ATTEST);
+
+/* Table 122 - Definition of TPMS_AUTH_COMMAND Structure <IN> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_AUTH_COMMAND[] = {
+    TSS_DESC_CHECKED(TSS_DESC_UINT32, TPMS_AUTH_COMMAND, sessionHandle,
+		     TSS_TPMI_SH_AUTH_SESSION_Unmarshalu),
+    TSS_DESC_2B(TPMS_AUTH_COMMAND, nonce, buffer),
+    TSS_DESC_CHECKED(TSS_DESC_UINT8, TPMS_AUTH_COMMAND, sessionAttributes,
+		     TSS_TPMA_SESSION_Unmarshalu),
+    TSS_DESC_2B(TPMS_AUTH_COMMAND, hmac, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_AUTH_COMMAND, TPMS_AUTH_COMMAND, tssFieldsTPMS_AUTH_COMMAND);
+
+/* Table 123 - Definition of TPMS_AUTH_RESPONSE Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_AUTH_RESPONSE[] = {
+    TSS_DESC_2B(TPMS_AUTH_RESPONSE, nonce, buffer),
+    TSS_DESC_CHECKED(TSS_DESC_UINT8, TPMS_AUTH_RESPONSE, sessionAttributes,
+		     TSS_TPMA_SESSION_Unmarshalu),
+    TSS_DESC_2B(TPMS_AUTH_RESPONSE, hmac, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_AUTH_RESPONSE, TPMS_AUTH_RESPONSE, tssFieldsTPMS_AUTH_RESPONSE);
+
+/* Table 128 - Definition of TPMT_SYM_DEF Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_SYM_DEF[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_SYM_DEF, algorithm),
+    TSS_DESC_SELECTED(TPMT_SYM_DEF, keyBits, algorithm,
+		      TSS_TPMU_SYM_KEY_BITS_Marshalu, TSS_TPMU_SYM_KEY_BITS_Unmarshalu),
+    TSS_DESC_SELECTED(TPMT_SYM_DEF, mode, algorithm,
+		      TSS_TPMU_SYM_MODE_Marshalu, TSS_TPMU_SYM_MODE_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_SYM_DEF, TPMT_SYM_DEF, tssFieldsTPMT_SYM_DEF);
+
+/* Table 129 - Definition of TPMT_SYM_DEF_OBJECT Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_SYM_DEF_OBJECT[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_SYM_DEF_OBJECT, algorithm),
+    TSS_DESC_SELECTED(TPMT_SYM_DEF_OBJECT, keyBits, algorithm,
+		      TSS_TPMU_SYM_KEY_BITS_Marshalu, TSS_TPMU_SYM_KEY_BITS_Unmarshalu),
+    TSS_DESC_SELECTED(TPMT_SYM_DEF_OBJECT, mode, algorithm,
+		      TSS_TPMU_SYM_MODE_Marshalu, TSS_TPMU_SYM_MODE_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_SYM_DEF_OBJECT, TPMT_SYM_DEF_OBJECT, tssFieldsTPMT_SYM_DEF_OBJECT);
+
+/* Table 131 - Definition of TPMS_SYMCIPHER_PARMS Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_SYMCIPHER_PARMS[] = {
+    TSS_DESC_NESTED(TPMS_SYMCIPHER_PARMS, sym, tssDescTPMT_SYM_DEF_OBJECT)
+};
+TSS_DESC_DEFINE(tssDescTPMS_SYMCIPHER_PARMS, TPMS_SYMCIPHER_PARMS, tssFieldsTPMS_SYMCIPHER_PARMS);
+
+/* Table 139 - Definition of TPMS_DERIVE Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_DERIVE[] = {
+    TSS_DESC_2B(TPMS_DERIVE, label, buffer),
+    TSS_DESC_2B(TPMS_DERIVE, context, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_DERIVE, TPMS_DERIVE, tssFieldsTPMS_DERIVE);
+
+/* Table 133 - Definition of TPMS_SENSITIVE_CREATE Structure <IN> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_SENSITIVE_CREATE[] = {
+    TSS_DESC_2B(TPMS_SENSITIVE_CREATE, userAuth, buffer),
+    TSS_DESC_2B(TPMS_SENSITIVE_CREATE, data, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_SENSITIVE_CREATE, TPMS_SENSITIVE_CREATE,
+		tssFieldsTPMS_SENSITIVE_CREATE);
+
+/* Table 134 - Definition of TPM2B_SENSITIVE_CREATE Structure <IN, S> */
+
+static const TSS_DESC_FIELD tssFieldsTPM2B_SENSITIVE_CREATE[] = {
+    TSS_DESC_SIZED(TPM2B_SENSITIVE_CREATE, size, NO),
+    TSS_DESC_NESTED(TPM2B_SENSITIVE_CREATE, sensitive, tssDescTPMS_SENSITIVE_CREATE)
+};
+TSS_DESC_DEFINE(tssDescTPM2B_SENSITIVE_CREATE, TPM2B_SENSITIVE_CREATE,
+		tssFieldsTPM2B_SENSITIVE_CREATE);
+
+/* Table 135 - Definition of TPMS_SCHEME_HASH Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_SCHEME_HASH[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_SCHEME_HASH, hashAlg)
+};
+TSS_DESC_DEFINE(tssDescTPMS_SCHEME_HASH, TPMS_SCHEME_HASH, tssFieldsTPMS_SCHEME_HASH);
+
+/* Table 136 - Definition of {ECC} TPMS_SCHEME_ECDAA Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_SCHEME_ECDAA[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_SCHEME_ECDAA, hashAlg),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_SCHEME_ECDAA, count)
+};
+TSS_DESC_DEFINE(tssDescTPMS_SCHEME_ECDAA, TPMS_SCHEME_ECDAA, tssFieldsTPMS_SCHEME_ECDAA);
+
+/* Table 139 - Definition of TPMS_SCHEME_XOR Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_SCHEME_XOR[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_SCHEME_XOR, hashAlg),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_SCHEME_XOR, kdf)
+};
+TSS_DESC_DEFINE(tssDescTPMS_SCHEME_XOR, TPMS_SCHEME_XOR, tssFieldsTPMS_SCHEME_XOR);
+
+/* Table 141 - Definition of TPMT_KEYEDHASH_SCHEME Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_KEYEDHASH_SCHEME[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_KEYEDHASH_SCHEME, scheme),
+    TSS_DESC_SELECTED(TPMT_KEYEDHASH_SCHEME, details, scheme,
+		      TSS_TPMU_SCHEME_KEYEDHASH_Marshalu, TSS_TPMU_SCHEME_KEYEDHASH_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_KEYEDHASH_SCHEME, TPMT_KEYEDHASH_SCHEME,
+		tssFieldsTPMT_KEYEDHASH_SCHEME);
+
+/* Table 145 - Definition of TPMT_SIG_SCHEME Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_SIG_SCHEME[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_SIG_SCHEME, scheme),
+    TSS_DESC_SELECTED(TPMT_SIG_SCHEME, details, scheme,
+		      TSS_TPMU_SIG_SCHEME_Marshalu, TSS_TPMU_SIG_SCHEME_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_SIG_SCHEME, TPMT_SIG_SCHEME, tssFieldsTPMT_SIG_SCHEME);
+
+/* Table 150 - Definition of TPMT_KDF_SCHEME Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_KDF_SCHEME[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_KDF_SCHEME, scheme),
+    TSS_DESC_SELECTED(TPMT_KDF_SCHEME, details, scheme,
+		      TSS_TPMU_KDF_SCHEME_Marshalu, TSS_TPMU_KDF_SCHEME_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_KDF_SCHEME, TPMT_KDF_SCHEME, tssFieldsTPMT_KDF_SCHEME);
+
+/* Table 152 - Definition of TPMT_ASYM_SCHEME Structure <> */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_ASYM_SCHEME[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_ASYM_SCHEME, scheme),
+    TSS_DESC_SELECTED(TPMT_ASYM_SCHEME, details, scheme,
+		      TSS_TPMU_ASYM_SCHEME_Marshalu, TSS_TPMU_ASYM_SCHEME_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_ASYM_SCHEME, TPMT_ASYM_SCHEME, tssFieldsTPMT_ASYM_SCHEME);
+
+/* Table 155 - Definition of {RSA} TPMT_RSA_SCHEME Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_RSA_SCHEME[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_RSA_SCHEME, scheme),
+    TSS_DESC_SELECTED(TPMT_RSA_SCHEME, details, scheme,
+		      TSS_TPMU_ASYM_SCHEME_Marshalu, TSS_TPMU_ASYM_SCHEME_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_RSA_SCHEME, TPMT_RSA_SCHEME, tssFieldsTPMT_RSA_SCHEME);
+
+/* Table 157 - Definition of {RSA} TPMT_RSA_DECRYPT Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_RSA_DECRYPT[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_RSA_DECRYPT, scheme),
+    TSS_DESC_SELECTED(TPMT_RSA_DECRYPT, details, scheme,
+		      TSS_TPMU_ASYM_SCHEME_Marshalu, TSS_TPMU_ASYM_SCHEME_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_RSA_DECRYPT, TPMT_RSA_DECRYPT, tssFieldsTPMT_RSA_DECRYPT);
+
+/* Table 162 - Definition of {ECC} TPMS_ECC_POINT Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_ECC_POINT[] = {
+    TSS_DESC_2B(TPMS_ECC_POINT, x, buffer),
+    TSS_DESC_2B(TPMS_ECC_POINT, y, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_ECC_POINT, TPMS_ECC_POINT, tssFieldsTPMS_ECC_POINT);
+
+/* Table 163 - Definition of {ECC} TPM2B_ECC_POINT Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPM2B_ECC_POINT[] = {
+    TSS_DESC_SIZED(TPM2B_ECC_POINT, size, NO),
+    TSS_DESC_NESTED(TPM2B_ECC_POINT, point, tssDescTPMS_ECC_POINT)
+};
+TSS_DESC_DEFINE(tssDescTPM2B_ECC_POINT, TPM2B_ECC_POINT, tssFieldsTPM2B_ECC_POINT);
+
+/* Table 166 - Definition of (TPMT_SIG_SCHEME) {ECC} TPMT_ECC_SCHEME Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_ECC_SCHEME[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_ECC_SCHEME, scheme),
+    TSS_DESC_SELECTED(TPMT_ECC_SCHEME, details, scheme,
+		      TSS_TPMU_ASYM_SCHEME_Marshalu, TSS_TPMU_ASYM_SCHEME_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_ECC_SCHEME, TPMT_ECC_SCHEME, tssFieldsTPMT_ECC_SCHEME);
+
+/* Table 167 - Definition of {ECC} TPMS_ALGORITHM_DETAIL_ECC Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_ALGORITHM_DETAIL_ECC[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_ALGORITHM_DETAIL_ECC, curveID),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_ALGORITHM_DETAIL_ECC, keySize),
+    TSS_DESC_NESTED(TPMS_ALGORITHM_DETAIL_ECC, kdf, tssDescTPMT_KDF_SCHEME),
+    TSS_DESC_NESTED(TPMS_ALGORITHM_DETAIL_ECC, sign, tssDescTPMT_ECC_SCHEME),
+    TSS_DESC_2B(TPMS_ALGORITHM_DETAIL_ECC, p, buffer),
+    TSS_DESC_2B(TPMS_ALGORITHM_DETAIL_ECC, a, buffer),
+    TSS_DESC_2B(TPMS_ALGORITHM_DETAIL_ECC, b, buffer),
+    TSS_DESC_2B(TPMS_ALGORITHM_DETAIL_ECC, gX, buffer),
+    TSS_DESC_2B(TPMS_ALGORITHM_DETAIL_ECC, gY, buffer),
+    TSS_DESC_2B(TPMS_ALGORITHM_DETAIL_ECC, n, buffer),
+    TSS_DESC_2B(TPMS_ALGORITHM_DETAIL_ECC, h, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_ALGORITHM_DETAIL_ECC, TPMS_ALGORITHM_DETAIL_ECC,
+		tssFieldsTPMS_ALGORITHM_DETAIL_ECC);
+
+/* Table 168 - Definition of {RSA} TPMS_SIGNATURE_RSA Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_SIGNATURE_RSA[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_SIGNATURE_RSA, hash),
+    TSS_DESC_2B(TPMS_SIGNATURE_RSA, sig, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_SIGNATURE_RSA, TPMS_SIGNATURE_RSA, tssFieldsTPMS_SIGNATURE_RSA);
+
+/* Table 170 - Definition of {ECC} TPMS_SIGNATURE_ECC Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_SIGNATURE_ECC[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_SIGNATURE_ECC, hash),
+    TSS_DESC_2B(TPMS_SIGNATURE_ECC, signatureR, buffer),
+    TSS_DESC_2B(TPMS_SIGNATURE_ECC, signatureS, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_SIGNATURE_ECC, TPMS_SIGNATURE_ECC, tssFieldsTPMS_SIGNATURE_ECC);
+
+/* Table 173 - Definition of TPMT_SIGNATURE Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_SIGNATURE[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_SIGNATURE, sigAlg),
+    TSS_DESC_SELECTED(TPMT_SIGNATURE, signature, sigAlg,
+		      TSS_TPMU_SIGNATURE_Marshalu, TSS_TPMU_SIGNATURE_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_SIGNATURE, TPMT_SIGNATURE, tssFieldsTPMT_SIGNATURE);
+
+/* Table 178 - Definition of TPMS_KEYEDHASH_PARMS Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_KEYEDHASH_PARMS[] = {
+    TSS_DESC_NESTED(TPMS_KEYEDHASH_PARMS, scheme, tssDescTPMT_KEYEDHASH_SCHEME)
+};
+TSS_DESC_DEFINE(tssDescTPMS_KEYEDHASH_PARMS, TPMS_KEYEDHASH_PARMS, tssFieldsTPMS_KEYEDHASH_PARMS);
+
+/* Table 181 - Definition of {RSA} TPMS_ASYM_PARMS Structure <> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_ASYM_PARMS[] = {
+    TSS_DESC_NESTED(TPMS_ASYM_PARMS, symmetric, tssDescTPMT_SYM_DEF_OBJECT),
+    TSS_DESC_NESTED(TPMS_ASYM_PARMS, scheme, tssDescTPMT_ASYM_SCHEME)
+};
+TSS_DESC_DEFINE(tssDescTPMS_ASYM_PARMS, TPMS_ASYM_PARMS, tssFieldsTPMS_ASYM_PARMS);
+
+/* Table 180 - Definition of {RSA} TPMS_RSA_PARMS Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_RSA_PARMS[] = {
+    TSS_DESC_NESTED(TPMS_RSA_PARMS, symmetric, tssDescTPMT_SYM_DEF_OBJECT),
+    TSS_DESC_NESTED(TPMS_RSA_PARMS, scheme, tssDescTPMT_RSA_SCHEME),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_RSA_PARMS, keyBits),
+    TSS_DESC_SCALAR(TSS_DESC_UINT32, TPMS_RSA_PARMS, exponent)
+};
+TSS_DESC_DEFINE(tssDescTPMS_RSA_PARMS, TPMS_RSA_PARMS, tssFieldsTPMS_RSA_PARMS);
+
+/* Table 181 - Definition of {ECC} TPMS_ECC_PARMS Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_ECC_PARMS[] = {
+    TSS_DESC_NESTED(TPMS_ECC_PARMS, symmetric, tssDescTPMT_SYM_DEF_OBJECT),
+    TSS_DESC_NESTED(TPMS_ECC_PARMS, scheme, tssDescTPMT_ECC_SCHEME),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_ECC_PARMS, curveID),
+    TSS_DESC_NESTED(TPMS_ECC_PARMS, kdf, tssDescTPMT_KDF_SCHEME)
+};
+TSS_DESC_DEFINE(tssDescTPMS_ECC_PARMS, TPMS_ECC_PARMS, tssFieldsTPMS_ECC_PARMS);
+
+/* Table 183 - Definition of TPMT_PUBLIC_PARMS Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_PUBLIC_PARMS[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_PUBLIC_PARMS, type),
+    TSS_DESC_SELECTED(TPMT_PUBLIC_PARMS, parameters, type,
+		      TSS_TPMU_PUBLIC_PARMS_Marshalu, TSS_TPMU_PUBLIC_PARMS_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_PUBLIC_PARMS, TPMT_PUBLIC_PARMS, tssFieldsTPMT_PUBLIC_PARMS);
+
+/* Table 184 - Definition of TPMT_PUBLIC Structure.  TSS_TPMT_PUBLIC_Marshalu() and
+   TSS_TPMT_PUBLIC_Unmarshalu() are the fast paths, and fall back to this table for a short
+   buffer. */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_PUBLIC[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_PUBLIC, type),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_PUBLIC, nameAlg),
+    TSS_DESC_CHECKED(TSS_DESC_UINT32, TPMT_PUBLIC, objectAttributes, TSS_TPMA_OBJECT_Unmarshalu),
+    TSS_DESC_2B(TPMT_PUBLIC, authPolicy, buffer),
+    TSS_DESC_SELECTED(TPMT_PUBLIC, parameters, type,
+		      TSS_TPMU_PUBLIC_PARMS_Marshalu, TSS_TPMU_PUBLIC_PARMS_Unmarshalu),
+    TSS_DESC_SELECTED(TPMT_PUBLIC, unique, type,
+		      TSS_TPMU_PUBLIC_ID_Marshalu, TSS_TPMU_PUBLIC_ID_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_PUBLIC, TPMT_PUBLIC, tssFieldsTPMT_PUBLIC);
+
+/* Table 185 - Definition of TPM2B_PUBLIC Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPM2B_PUBLIC[] = {
+    TSS_DESC_SIZED(TPM2B_PUBLIC, size, NO),
+    TSS_DESC_SCALAR(TSS_DESC_PUBLIC, TPM2B_PUBLIC, publicArea)
+};
+TSS_DESC_DEFINE(tssDescTPM2B_PUBLIC, TPM2B_PUBLIC, tssFieldsTPM2B_PUBLIC);
+
+/* Table 188 - Definition of TPMT_SENSITIVE Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMT_SENSITIVE[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMT_SENSITIVE, sensitiveType),
+    TSS_DESC_2B(TPMT_SENSITIVE, authValue, buffer),
+    TSS_DESC_2B(TPMT_SENSITIVE, seedValue, buffer),
+    TSS_DESC_SELECTED(TPMT_SENSITIVE, sensitive, sensitiveType,
+		      TSS_TPMU_SENSITIVE_COMPOSITE_Marshalu,
+		      TSS_TPMU_SENSITIVE_COMPOSITE_Unmarshalu)
+};
+TSS_DESC_DEFINE(tssDescTPMT_SENSITIVE, TPMT_SENSITIVE, tssFieldsTPMT_SENSITIVE);
+
+/* Table 189 - Definition of TPM2B_SENSITIVE Structure <IN/OUT>.  A zero size is an empty
+   sensitive area. */
+
+static const TSS_DESC_FIELD tssFieldsTPM2B_SENSITIVE[] = {
+    TSS_DESC_SIZED(TPM2B_SENSITIVE, t.size, YES),
+    TSS_DESC_NESTED(TPM2B_SENSITIVE, t.sensitiveArea, tssDescTPMT_SENSITIVE)
+};
+TSS_DESC_DEFINE(tssDescTPM2B_SENSITIVE, TPM2B_SENSITIVE, tssFieldsTPM2B_SENSITIVE);
+
+/* Table 197 - Definition of TPMS_NV_PUBLIC Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_NV_PUBLIC[] = {
+    TSS_DESC_CHECKED_NULL(TSS_DESC_UINT32, TPMS_NV_PUBLIC, nvIndex,
+			  TSS_TPMI_RH_NV_INDEX_Unmarshalu, NO),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_NV_PUBLIC, nameAlg),
+    TSS_DESC_CHECKED(TSS_DESC_UINT32, TPMS_NV_PUBLIC, attributes, TSS_TPMA_NV_Unmarshalu),
+    TSS_DESC_2B(TPMS_NV_PUBLIC, authPolicy, buffer),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_NV_PUBLIC, dataSize)
+};
+TSS_DESC_DEFINE(tssDescTPMS_NV_PUBLIC, TPMS_NV_PUBLIC, tssFieldsTPMS_NV_PUBLIC);
+
+/* Table 198 - Definition of TPM2B_NV_PUBLIC Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPM2B_NV_PUBLIC[] = {
+    TSS_DESC_SIZED(TPM2B_NV_PUBLIC, size, NO),
+    TSS_DESC_NESTED(TPM2B_NV_PUBLIC, nvPublic, tssDescTPMS_NV_PUBLIC)
+};
+TSS_DESC_DEFINE(tssDescTPM2B_NV_PUBLIC, TPM2B_NV_PUBLIC, tssFieldsTPM2B_NV_PUBLIC);
+
+/* Table 200 - Definition of TPMS_CONTEXT_DATA Structure <IN/OUT, S> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_CONTEXT_DATA[] = {
+    TSS_DESC_2B(TPMS_CONTEXT_DATA, integrity, buffer),
+    TSS_DESC_2B(TPMS_CONTEXT_DATA, encrypted, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_CONTEXT_DATA, TPMS_CONTEXT_DATA, tssFieldsTPMS_CONTEXT_DATA);
+
+/* Table 202 - Definition of TPMS_CONTEXT Structure */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_CONTEXT[] = {
+    TSS_DESC_SCALAR(TSS_DESC_UINT64, TPMS_CONTEXT, sequence),
+    TSS_DESC_CHECKED_NULL(TSS_DESC_UINT32, TPMS_CONTEXT, savedHandle,
+			  TSS_TPMI_DH_SAVED_Unmarshalu, NO),
+    TSS_DESC_CHECKED_NULL(TSS_DESC_UINT32, TPMS_CONTEXT, hierarchy,
+			  TSS_TPMI_RH_HIERARCHY_Unmarshalu, YES),
+    TSS_DESC_2B(TPMS_CONTEXT, contextBlob, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_CONTEXT, TPMS_CONTEXT, tssFieldsTPMS_CONTEXT);
+
+/* Table 204 - Definition of TPMS_CREATION_DATA Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPMS_CREATION_DATA[] = {
+    TSS_DESC_SCALAR(TSS_DESC_PCR_SELECTION, TPMS_CREATION_DATA, pcrSelect),
+    TSS_DESC_2B(TPMS_CREATION_DATA, pcrDigest, buffer),
+    TSS_DESC_SCALAR(TSS_DESC_UINT8, TPMS_CREATION_DATA, locality),
+    TSS_DESC_SCALAR(TSS_DESC_UINT16, TPMS_CREATION_DATA, parentNameAlg),
+    TSS_DESC_2B(TPMS_CREATION_DATA, parentName, name),
+    TSS_DESC_2B(TPMS_CREATION_DATA, parentQualifiedName, name),
+    TSS_DESC_2B(TPMS_CREATION_DATA, outsideInfo, buffer)
+};
+TSS_DESC_DEFINE(tssDescTPMS_CREATION_DATA, TPMS_CREATION_DATA, tssFieldsTPMS_CREATION_DATA);
+
+/* Table 205 - Definition of TPM2B_CREATION_DATA Structure <OUT> */
+
+static const TSS_DESC_FIELD tssFieldsTPM2B_CREATION_DATA[] = {
+    TSS_DESC_SIZED(TPM2B_CREATION_DATA, size, NO),
+    TSS_DESC_NESTED(TPM2B_CREATION_DATA, creationData, tssDescTPMS_CREATION_DATA)
+};
+TSS_DESC_DEFINE(tssDescTPM2B_CREATION_DATA, TPM2B_CREATION_DATA, tssFieldsTPM2B_CREATION_DATA);
+
+/* TSS_Desc_Marshalu() marshals the structure 'source' as described by 'desc'.  The parameters and
+   the result are those of the TSS_structure_Marshalu() functions.
+
+   After a TSS_DESC_SIZE field, the following fields are counted in sizeWritten, and the size is
+   back filled at the end, as the hand written TPM2B wrapped structure functions did. */
+
+TPM_RC
+TSS_Desc_Marshalu(const void *source, const TSS_DESC_STRUCT *desc,
+		  uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    TPM_RC rc = 0;
+    uint16_t i;
+    uint32_t j;
+    const TSS_DESC_FIELD *field;
+    const BYTE *member;
+    uint8_t type;
+    uint32_t selector;
+    uint16_t *w = written;	/* the running count, sizeWritten after a TSS_DESC_SIZE */
+    uint16_t sizeWritten = 0;	/* of the TPM2B wrapped structure */
+    BYTE *sizePtr = NULL;
+    BOOL sized = FALSE;
+
+    for (i = 0 ; (rc == 0) && (i < desc->fieldCount) ; i++) {
+	field = &desc->fields[i];
+	member = (const BYTE *)source + field->offset;
+	/* the TSS does not value check on marshal, so a TSS_DESC_CHECK is its scalar */
+	type = (field->type == TSS_DESC_CHECK) ? (uint8_t)field->param : field->type;
+	switch (type) {
+	  case TSS_DESC_UINT8:
+	    rc = TSS_UINT8_Marshalu((const UINT8 *)member, w, buffer, size);
+	    break;
+	  case TSS_DESC_UINT16:
+	    rc = TSS_UINT16_Marshalu((const UINT16 *)member, w, buffer, size);
+	    break;
+	  case TSS_DESC_UINT32:
+	  case TSS_DESC_GENERATED:
+	    rc = TSS_UINT32_Marshalu((const UINT32 *)member, w, buffer, size);
+	    break;
+	  case TSS_DESC_UINT64:
+	    rc = TSS_UINT64_Marshalu((const UINT64 *)member, w, buffer, size);
+	    break;
+	  case TSS_DESC_TPM2B:
+	    rc = TSS_TPM2B_Marshalu((const TPM2B *)member, w, buffer, size);
+	    break;
+	  case TSS_DESC_SELECT:
+	    rc = TSS_UINT8_Marshalu((const UINT8 *)member, w, buffer, size);
+	    if (rc == 0) {
+		rc = TSS_Array_Marshalu((const BYTE *)source + field->array, *(const UINT8 *)member,
+					w, buffer, size);
+	    }
+	    break;
+	  case TSS_DESC_LIST:
+	    rc = TSS_UINT32_Marshalu((const UINT32 *)member, w, buffer, size);
+	    for (j = 0 ; (rc == 0) && (j < *(const UINT32 *)member) ; j++) {
+		rc = TSS_Desc_Marshalu((const BYTE *)source + field->array + (j * field->desc->size),
+				       field->desc, w, buffer, size);
+	    }
+	    break;
+	  case TSS_DESC_UNION:
+	    if (field->flag == sizeof(UINT8)) {
+		selector = *((const UINT8 *)source + field->param);
+	    }
+	    else if (field->flag == sizeof(UINT16)) {
+		selector = *(const UINT16 *)((const BYTE *)source + field->param);
+	    }
+	    else {
+		selector = *(const UINT32 *)((const BYTE *)source + field->param);
+	    }
+	    rc = ((TSS_DescMarshalUnion_t)field->marshal)(member, w, buffer, size, selector);
+	    break;
+	  case TSS_DESC_SIZE:
+	    if (buffer != NULL) {
+		sizePtr = *buffer;
+		*buffer += sizeof(uint16_t);
+	    }
+	    w = &sizeWritten;
+	    sized = TRUE;
+	    break;
+	  case TSS_DESC_STRUCTURE:
+	    rc = TSS_Desc_Marshalu(member, field->desc, w, buffer, size);
+	    break;
+	  case TSS_DESC_PCR_SELECTION:
+	    rc = TSS_TPML_PCR_SELECTION_Marshalu((const TPML_PCR_SELECTION *)member,
+						 w, buffer, size);
+	    break;
+	  case TSS_DESC_PUBLIC:
+	    rc = TSS_TPMT_PUBLIC_Marshalu((const TPMT_PUBLIC *)member, w, buffer, size);
+	    break;
+	  default:
+	    rc = TSS_RC_NOT_IMPLEMENTED;
+	}
+    }
+    if ((rc == 0) && sized) {
+	*written += sizeWritten;
+	if (buffer != NULL) {
+	    rc = TSS_UINT16_Marshalu(&sizeWritten, written, &sizePtr, size);
+	}
+	else {
+	    *written += sizeof(uint16_t);
+	}
+    }
+    return rc;
+}
+
+/* Table 5 - Definition of Types for Documentation Clarity */
+
+TPM_RC
+TSS_TPM_KEY_BITS_Marshalu(const TPM_KEY_BITS *source, uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    TPM_RC rc = 0;
+    if (rc == 0) {
+	rc = TSS_UINT16_Marshalu(source, written, buffer, size);
+    }
+    return rc;
+}
+   
+/* Table 7 - Definition of (UINT32) TPM_GENERATED Constants <O> */
+
+TPM_RC
+TSS_TPM_GENERATED_Marshalu(const TPM_GENERATED *source, uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    TPM_RC rc = 0;
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(source, written, buffer, size);
+    }
+    return rc;
+}
+ 
+/* Table 9 - Definition of (UINT16) TPM_ALG_ID Constants <IN/OUT, S> */
+
+TPM_RC
+TSS_TPM_ALG_ID_Marshalu(const TPM_ALG_ID *source, uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    TPM_RC rc = 0;
+    if (rc == 0) {
+	rc = TSS_UINT16_Marshalu(source, written, buffer, size);
+    }
+    return rc;
+}
+
+/* Table 10 - Definition of (uint16_t) {ECC} TPM_ECC_CURVE Constants <IN/OUT, S> */
+
+#ifdef TPM_ALG_ECC
+TPM_RC
+TSS_TPM_ECC_CURVE_Marshalu(const TPM_ECC_CURVE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    TPM_RC rc = 0;
+    if (rc == 0) {
+	rc = TSS_UINT16_Marshalu(source, written, buffer, size);
+    }
+    return rc;
+}
+#endif
+
+/* Table 17 - Definition of (UINT32) TPM_RC Constants (Actions) <OUT> */
+
+TPM_RC
+TSS_TPM_RC_Marshalu(const TPM_RC *source, uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    TPM_RC rc = 0;
+    if (rc == 0) {
+	rc = TSS_UINT32_Marshalu(source, written, buffer, size);
+    }
+    return rc;
+}
+
+/* Table 18 - Definition of (INT8) TPM_CLOCK_ADJUST Constants <IN> */
+
+TPM_RC
+TSS_TPM_CLOCK_ADJUST_Marshalu(const TPM_CLOCK_ADJUST *source, uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    TPM_RC rc = 0;
+    if (rc == 0) {
+	rc = TSS_INT8_Marshalu(source, written, buffer, size);
+    }
+    return rc;
+}
+
+/* Table 19 - Definition of (UINT16) TPM_EO Constants <IN/OUT> */
+
+TPM_RC
+TSS_TPM_EO_Marshalu(const TPM_EO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    TPM_RC rc = 0;
+    if (rc == 0) {
+	rc = TSS_UINT16_Marshalu(source, written, buffer, size);
+    }
+    return rc;
+}
 
 /* Table 20 - Definition of (UINT16) TPM_ST Constants <IN/OUT, S> */
 
@@ -3583,14 +4693,7 @@ TSS_TPMU_HA_Marshalu(const TPMU_HA *source, uint16_t *written, BYTE **buffer, ui
 TPM_RC
 TSS_TPMT_HA_Marshalu(const TPMT_HA *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_HASH_Marshalu(&source->hashAlg, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_HA_Marshalu(&source->digest, written, buffer, size, source->hashAlg);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_HA, written, buffer, size);
 }
 
 /* Table 72 - Definition of TPM2B_DIGEST Structure */
@@ -3730,18 +4833,7 @@ TSS_TPM2B_NAME_Marshalu(const TPM2B_NAME *source, uint16_t *written, BYTE **buff
 TPM_RC
 TSS_TPMS_PCR_SELECTION_Marshalu(const TPMS_PCR_SELECTION *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_HASH_Marshalu(&source->hash, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT8_Marshalu(&source->sizeofSelect, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_Array_Marshalu(&source->pcrSelect[0], source->sizeofSelect, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_PCR_SELECTION, written, buffer, size);
 }
 
 /* Table 88 - Definition of TPMT_TK_CREATION Structure */
@@ -3821,14 +4913,7 @@ TSS_TPMT_TK_HASHCHECK_Marshalu(const TPMT_TK_HASHCHECK *source, uint16_t *writte
 TPM_RC
 TSS_TPMS_ALG_PROPERTY_Marshalu(const TPMS_ALG_PROPERTY *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM_ALG_ID_Marshalu(&source->alg, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMA_ALGORITHM_Marshalu(&source->algProperties, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_ALG_PROPERTY, written, buffer, size);
 }
 
 /* Table 93 - Definition of TPMS_TAGGED_PROPERTY Structure <OUT> */
@@ -3836,14 +4921,7 @@ TSS_TPMS_ALG_PROPERTY_Marshalu(const TPMS_ALG_PROPERTY *source, uint16_t *writte
 TPM_RC
 TSS_TPMS_TAGGED_PROPERTY_Marshalu(const TPMS_TAGGED_PROPERTY *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM_PT_Marshalu(&source->property, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->value, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_TAGGED_PROPERTY, written, buffer, size);
 }
 
 /* Table 94 - Definition of TPMS_TAGGED_PCR_SELECT Structure <OUT> */
@@ -3851,17 +4929,7 @@ TSS_TPMS_TAGGED_PROPERTY_Marshalu(const TPMS_TAGGED_PROPERTY *source, uint16_t *
 TPM_RC
 TSS_TPMS_TAGGED_PCR_SELECT_Marshalu(const TPMS_TAGGED_PCR_SELECT *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM_PT_PCR_Marshalu(&source->tag, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT8_Marshalu(&source->sizeofSelect, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_Array_Marshalu(&source->pcrSelect[0], source->sizeofSelect, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_TAGGED_PCR_SELECT, written, buffer, size);
 }
 
 /* Table 95 - Definition of TPML_CC Structure */
@@ -3869,18 +4937,7 @@ TSS_TPMS_TAGGED_PCR_SELECT_Marshalu(const TPMS_TAGGED_PCR_SELECT *source, uint16
 TPM_RC
 TSS_TPML_CC_Marshalu(const TPML_CC *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint32_t i;
-    
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
-    }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPM_CC_Marshalu(&source->commandCodes[i], written, buffer, size);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPML_CC, written, buffer, size);
 }
 
 /* Table 96 - Definition of TPML_CCA Structure <OUT> */
@@ -3888,18 +4945,7 @@ TSS_TPML_CC_Marshalu(const TPML_CC *source, uint16_t *written, BYTE **buffer, ui
 TPM_RC
 TSS_TPML_CCA_Marshalu(const TPML_CCA *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint32_t i;
-    
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
-    }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPMA_CC_Marshalu(&source->commandAttributes[i], written, buffer, size);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPML_CCA, written, buffer, size);
 }
 
 /* Table 97 - Definition of TPML_ALG Structure */
@@ -3907,18 +4953,7 @@ TSS_TPML_CCA_Marshalu(const TPML_CCA *source, uint16_t *written, BYTE **buffer,
 TPM_RC
 TSS_TPML_ALG_Marshalu(const TPML_ALG *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint32_t i;
-    
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
-    }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPM_ALG_ID_Marshalu(&source->algorithms[i], written, buffer, size);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPML_ALG, written, buffer, size);
 }
 
 /* Table 98 - Definition of TPML_HANDLE Structure <OUT> */
@@ -3926,18 +4961,7 @@ TSS_TPML_ALG_Marshalu(const TPML_ALG *source, uint16_t *written, BYTE **buffer,
 TPM_RC
 TSS_TPML_HANDLE_Marshalu(const TPML_HANDLE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint32_t i;
-    
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
-    }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPM_HANDLE_Marshalu(&source->handle[i], written, buffer, size);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPML_HANDLE, written, buffer, size);
 }
 
 /* Table 99 - Definition of TPML_DIGEST Structure */
@@ -3964,34 +4988,43 @@ TSS_TPML_DIGEST_Marshalu(const TPML_DIGEST *source, uint16_t *written, BYTE **bu
 TPM_RC
 TSS_TPML_DIGEST_VALUES_Marshalu(const TPML_DIGEST_VALUES *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint32_t i;
-    
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
-    }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPMT_HA_Marshalu(&source->digests[i], written, buffer, size);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPML_DIGEST_VALUES, written, buffer, size);
 }
 
-/* Table 102 - Definition of TPML_PCR_SELECTION Structure */
+/* Table 102 - Definition of TPML_PCR_SELECTION Structure
+
+   TPML_PCR_SELECTION is in every quote and creation data, so when the buffer is large enough, each
+   TPMS_PCR_SELECTION is marshaled inline.
+*/
 
 TPM_RC
 TSS_TPML_PCR_SELECTION_Marshalu(const TPML_PCR_SELECTION *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
     TPM_RC rc = 0;
     uint32_t i;
+    const TPMS_PCR_SELECTION *selection;
+    uint16_t selectionSize;
     
     if (rc == 0) {
 	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
     }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPMS_PCR_SELECTION_Marshalu(&source->pcrSelections[i], written, buffer, size);
+    for (i = 0 ; (rc == 0) && (i < source->count) ; i++) {
+	selection = &source->pcrSelections[i];
+	selectionSize = sizeof(UINT16) + sizeof(UINT8) + selection->sizeofSelect;
+	if ((buffer != NULL) && ((size == NULL) || (*size >= selectionSize))) {
+	    (*buffer)[0] = (BYTE)((selection->hash >> 8) & 0xff);
+	    (*buffer)[1] = (BYTE)((selection->hash >> 0) & 0xff);
+	    (*buffer)[2] = selection->sizeofSelect;
+	    memcpy(*buffer + sizeof(UINT16) + sizeof(UINT8), selection->pcrSelect,
+		   selection->sizeofSelect);
+	    *buffer += selectionSize;
+	    if (size != NULL) {
+		*size -= selectionSize;
+	    }
+	    *written += selectionSize;
+	}
+	else {
+	    rc = TSS_TPMS_PCR_SELECTION_Marshalu(selection, written, buffer, size);
 	}
     }
     return rc;
@@ -4002,18 +5035,7 @@ TSS_TPML_PCR_SELECTION_Marshalu(const TPML_PCR_SELECTION *source, uint16_t *writ
 TPM_RC
 TSS_TPML_ALG_PROPERTY_Marshalu(const TPML_ALG_PROPERTY *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint32_t i;
-    
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
-    }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPMS_ALG_PROPERTY_Marshalu(&source->algProperties[i], written, buffer, size);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPML_ALG_PROPERTY, written, buffer, size);
 }
 
 /* Table 104 - Definition of TPML_TAGGED_TPM_PROPERTY Structure <OUT> */
@@ -4021,18 +5043,7 @@ TSS_TPML_ALG_PROPERTY_Marshalu(const TPML_ALG_PROPERTY *source, uint16_t *writte
 TPM_RC
 TSS_TPML_TAGGED_TPM_PROPERTY_Marshalu(const TPML_TAGGED_TPM_PROPERTY *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint32_t i;
-    
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
-    }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPMS_TAGGED_PROPERTY_Marshalu(&source->tpmProperty[i], written, buffer, size);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPML_TAGGED_TPM_PROPERTY, written, buffer, size);
 }
 
 /* Table 105 - Definition of TPML_TAGGED_PCR_PROPERTY Structure <OUT> */
@@ -4040,18 +5051,7 @@ TSS_TPML_TAGGED_TPM_PROPERTY_Marshalu(const TPML_TAGGED_TPM_PROPERTY *source, ui
 TPM_RC
 TSS_TPML_TAGGED_PCR_PROPERTY_Marshalu(const TPML_TAGGED_PCR_PROPERTY *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint32_t i;
-    
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
-    }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPMS_TAGGED_PCR_SELECT_Marshalu(&source->pcrProperty[i], written, buffer, size);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPML_TAGGED_PCR_PROPERTY, written, buffer, size);
 }
 
 /* Table 106 - Definition of {ECC} TPML_ECC_CURVE Structure <OUT> */
@@ -4059,18 +5059,7 @@ TSS_TPML_TAGGED_PCR_PROPERTY_Marshalu(const TPML_TAGGED_PCR_PROPERTY *source, ui
 TPM_RC
 TSS_TPML_ECC_CURVE_Marshalu(const TPML_ECC_CURVE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint32_t i;
-    
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->count, written, buffer, size);
-    }
-    for (i = 0 ; i < source->count ; i++) {
-	if (rc == 0) {
-	    rc = TSS_TPM_ECC_CURVE_Marshalu(&source->eccCurves[i], written, buffer, size);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPML_ECC_CURVE, written, buffer, size);
 }
 
 /* Table 107 - Definition of TPMU_CAPABILITIES Union <OUT> */
@@ -4136,14 +5125,7 @@ TSS_TPMU_CAPABILITIES_Marshalu(const TPMU_CAPABILITIES *source, uint16_t *writte
 TPM_RC
 TSS_TPMS_CAPABILITY_DATA_Marshalu(const TPMS_CAPABILITY_DATA *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM_CAP_Marshalu(&source->capability, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_CAPABILITIES_Marshalu(&source->data, written, buffer, size, source->capability);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_CAPABILITY_DATA, written, buffer, size);
 }
 
 /* Table 109 - Definition of TPMS_CLOCK_INFO Structure */
@@ -4151,20 +5133,7 @@ TSS_TPMS_CAPABILITY_DATA_Marshalu(const TPMS_CAPABILITY_DATA *source, uint16_t *
 TPM_RC
 TSS_TPMS_CLOCK_INFO_Marshalu(const TPMS_CLOCK_INFO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT64_Marshalu(&source->clock, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->resetCount, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->restartCount, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMI_YES_NO_Marshalu(&source->safe, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_CLOCK_INFO, written, buffer, size);
 }
 
 /* Table 110 - Definition of TPMS_TIME_INFO Structure */
@@ -4172,14 +5141,7 @@ TSS_TPMS_CLOCK_INFO_Marshalu(const TPMS_CLOCK_INFO *source, uint16_t *written, B
 TPM_RC
 TSS_TPMS_TIME_INFO_Marshalu(const TPMS_TIME_INFO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT64_Marshalu(&source->time, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMS_CLOCK_INFO_Marshalu(&source->clockInfo, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_TIME_INFO, written, buffer, size);
 }
     
 /* Table 111 - Definition of TPMS_TIME_ATTEST_INFO Structure <OUT> */
@@ -4187,14 +5149,7 @@ TSS_TPMS_TIME_INFO_Marshalu(const TPMS_TIME_INFO *source, uint16_t *written, BYT
 TPM_RC
 TSS_TPMS_TIME_ATTEST_INFO_Marshalu(const TPMS_TIME_ATTEST_INFO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMS_TIME_INFO_Marshalu(&source->time, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT64_Marshalu(&source->firmwareVersion, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_TIME_ATTEST_INFO, written, buffer, size);
 }
 
 /* Table 112 - Definition of TPMS_CERTIFY_INFO Structure <OUT> */
@@ -4202,14 +5157,7 @@ TSS_TPMS_TIME_ATTEST_INFO_Marshalu(const TPMS_TIME_ATTEST_INFO *source, uint16_t
 TPM_RC
 TSS_TPMS_CERTIFY_INFO_Marshalu(const TPMS_CERTIFY_INFO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM2B_NAME_Marshalu(&source->name, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_NAME_Marshalu(&source->qualifiedName, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_CERTIFY_INFO, written, buffer, size);
 }
 
 /* Table 113 - Definition of TPMS_QUOTE_INFO Structure <OUT> */
@@ -4217,14 +5165,7 @@ TSS_TPMS_CERTIFY_INFO_Marshalu(const TPMS_CERTIFY_INFO *source, uint16_t *writte
 TPM_RC
 TSS_TPMS_QUOTE_INFO_Marshalu(const TPMS_QUOTE_INFO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPML_PCR_SELECTION_Marshalu(&source->pcrSelect, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DIGEST_Marshalu(&source->pcrDigest, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_QUOTE_INFO, written, buffer, size);
 }
 
 /* Table 114 - Definition of TPMS_COMMAND_AUDIT_INFO Structure <OUT> */
@@ -4232,20 +5173,7 @@ TSS_TPMS_QUOTE_INFO_Marshalu(const TPMS_QUOTE_INFO *source, uint16_t *written, B
 TPM_RC
 TSS_TPMS_COMMAND_AUDIT_INFO_Marshalu(const TPMS_COMMAND_AUDIT_INFO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT64_Marshalu(&source->auditCounter, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM_ALG_ID_Marshalu(&source->digestAlg, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DIGEST_Marshalu(&source->auditDigest, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DIGEST_Marshalu(&source->commandDigest, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_COMMAND_AUDIT_INFO, written, buffer, size);
 }
 
 /* Table 115 - Definition of TPMS_SESSION_AUDIT_INFO Structure <OUT> */
@@ -4253,14 +5181,7 @@ TSS_TPMS_COMMAND_AUDIT_INFO_Marshalu(const TPMS_COMMAND_AUDIT_INFO *source, uint
 TPM_RC
 TSS_TPMS_SESSION_AUDIT_INFO_Marshalu(const TPMS_SESSION_AUDIT_INFO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_YES_NO_Marshalu(&source->exclusiveSession, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DIGEST_Marshalu(&source->sessionDigest, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_SESSION_AUDIT_INFO, written, buffer, size);
 }
 
 /* Table 116 - Definition of TPMS_CREATION_INFO Structure <OUT> */
@@ -4268,14 +5189,7 @@ TSS_TPMS_SESSION_AUDIT_INFO_Marshalu(const TPMS_SESSION_AUDIT_INFO *source, uint
 TPM_RC
 TSS_TPMS_CREATION_INFO_Marshalu(const TPMS_CREATION_INFO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM2B_NAME_Marshalu(&source->objectName, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DIGEST_Marshalu(&source->creationHash, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_CREATION_INFO, written, buffer, size);
 }
 
 /* Table 117 - Definition of TPMS_NV_CERTIFY_INFO Structure <OUT> */
@@ -4283,17 +5197,7 @@ TSS_TPMS_CREATION_INFO_Marshalu(const TPMS_CREATION_INFO *source, uint16_t *writ
 TPM_RC
 TSS_TPMS_NV_CERTIFY_INFO_Marshalu(const TPMS_NV_CERTIFY_INFO *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM2B_NAME_Marshalu(&source->indexName, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT16_Marshalu(&source->offset, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_MAX_NV_BUFFER_Marshalu(&source->nvContents, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_NV_CERTIFY_INFO, written, buffer, size);
 }
 
 /* Table 118 - Definition of (TPM_ST) TPMI_ST_ATTEST Type <OUT> */
@@ -4355,35 +5259,13 @@ TSS_TPMU_ATTEST_Marshalu(const TPMU_ATTEST  *source, uint16_t *written, BYTE **b
     }
     return rc;
 }
-
-/* Table 120 - Definition of TPMS_ATTEST Structure <OUT> */
-
-TPM_RC
-TSS_TPMS_ATTEST_Marshalu(const TPMS_ATTEST  *source, uint16_t *written, BYTE **buffer, uint32_t *size)
-{
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM_GENERATED_Marshalu(&source->magic, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMI_ST_ATTEST_Marshalu(&source->type, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_NAME_Marshalu(&source->qualifiedSigner, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DATA_Marshalu(&source->extraData, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMS_CLOCK_INFO_Marshalu(&source->clockInfo, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT64_Marshalu(&source->firmwareVersion, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_ATTEST_Marshalu(&source->attested, written, buffer, size,source->type);
-    }
-    return rc;
+
+/* Table 120 - Definition of TPMS_ATTEST Structure <OUT> */
+
+TPM_RC
+TSS_TPMS_ATTEST_Marshalu(const TPMS_ATTEST  *source, uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_ATTEST, written, buffer, size);
 }
 
 /* Table 121 - Definition of TPM2B_ATTEST Structure <OUT> */
@@ -4403,20 +5285,7 @@ TSS_TPM2B_ATTEST_Marshalu(const TPM2B_ATTEST *source, uint16_t *written, BYTE **
 TPM_RC
 TSS_TPMS_AUTH_COMMAND_Marshalu(const TPMS_AUTH_COMMAND *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_SH_AUTH_SESSION_Marshalu(&source->sessionHandle, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_NONCE_Marshalu(&source->nonce, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMA_SESSION_Marshalu(&source->sessionAttributes, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_AUTH_Marshalu(&source->hmac, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_AUTH_COMMAND, written, buffer, size);
 }
 
 /* Table 124 - Definition of {AES} (TPM_KEY_BITS) TPMI_!ALG.S_KEY_BITS Type */
@@ -4518,17 +5387,7 @@ TSS_TPMU_SYM_MODE_Marshalu(const TPMU_SYM_MODE *source, uint16_t *written, BYTE
 TPM_RC
 TSS_TPMT_SYM_DEF_Marshalu(const TPMT_SYM_DEF *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_SYM_Marshalu(&source->algorithm, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_SYM_KEY_BITS_Marshalu(&source->keyBits, written, buffer, size, source->algorithm);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_SYM_MODE_Marshalu(&source->mode, written, buffer, size, source->algorithm);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_SYM_DEF, written, buffer, size);
 }
 
 /* Table 129 - Definition of TPMT_SYM_DEF_OBJECT Structure */
@@ -4536,17 +5395,7 @@ TSS_TPMT_SYM_DEF_Marshalu(const TPMT_SYM_DEF *source, uint16_t *written, BYTE **
 TPM_RC
 TSS_TPMT_SYM_DEF_OBJECT_Marshalu(const TPMT_SYM_DEF_OBJECT *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_SYM_OBJECT_Marshalu(&source->algorithm, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_SYM_KEY_BITS_Marshalu(&source->keyBits, written, buffer, size, source->algorithm);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_SYM_MODE_Marshalu(&source->mode, written, buffer, size, source->algorithm);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_SYM_DEF_OBJECT, written, buffer, size);
 }
 
 /* Table 130 - Definition of TPM2B_SYM_KEY Structure */
@@ -4578,14 +5427,7 @@ TSS_TPM2B_LABEL_Marshalu(const TPM2B_LABEL *source, uint16_t *written, BYTE **bu
 TPM_RC
 TSS_TPMS_DERIVE_Marshalu(const TPMS_DERIVE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM2B_LABEL_Marshalu(&source->label, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_LABEL_Marshalu(&source->context, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_DERIVE, written, buffer, size);
 }
 
 /* Table 131 - Definition of TPMS_SYMCIPHER_PARMS Structure */
@@ -4593,11 +5435,7 @@ TSS_TPMS_DERIVE_Marshalu(const TPMS_DERIVE *source, uint16_t *written, BYTE **bu
 TPM_RC
 TSS_TPMS_SYMCIPHER_PARMS_Marshalu(const TPMS_SYMCIPHER_PARMS *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMT_SYM_DEF_OBJECT_Marshalu(&source->sym, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_SYMCIPHER_PARMS, written, buffer, size);
 }
 
 /* Table 132 - Definition of TPM2B_SENSITIVE_DATA Structure */
@@ -4617,14 +5455,7 @@ TSS_TPM2B_SENSITIVE_DATA_Marshalu(const TPM2B_SENSITIVE_DATA *source, uint16_t *
 TPM_RC
 TSS_TPMS_SENSITIVE_CREATE_Marshalu(const TPMS_SENSITIVE_CREATE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM2B_AUTH_Marshalu(&source->userAuth, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_SENSITIVE_DATA_Marshalu(&source->data, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_SENSITIVE_CREATE, written, buffer, size);
 }
 
 /* Table 134 - Definition of TPM2B_SENSITIVE_CREATE Structure <IN, S> */
@@ -4632,27 +5463,7 @@ TSS_TPMS_SENSITIVE_CREATE_Marshalu(const TPMS_SENSITIVE_CREATE *source, uint16_t
 TPM_RC
 TSS_TPM2B_SENSITIVE_CREATE_Marshalu(const TPM2B_SENSITIVE_CREATE  *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint16_t sizeWritten = 0;	/* of structure */
-    BYTE *sizePtr;
-
-    if (buffer != NULL) {
-	sizePtr = *buffer;
-	*buffer += sizeof(uint16_t);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMS_SENSITIVE_CREATE_Marshalu(&source->sensitive, &sizeWritten, buffer, size);
-    }
-    if (rc == 0) {
-	*written += sizeWritten;
-	if (buffer != NULL) {
-	    rc = TSS_UINT16_Marshalu(&sizeWritten, written, &sizePtr, size);	/* backfill 2B size */
-	}
-	else {
-	    *written += sizeof(uint16_t);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPM2B_SENSITIVE_CREATE, written, buffer, size);
 }
 
 /* Table 135 - Definition of TPMS_SCHEME_HASH Structure */
@@ -4660,11 +5471,7 @@ TSS_TPM2B_SENSITIVE_CREATE_Marshalu(const TPM2B_SENSITIVE_CREATE  *source, uint1
 TPM_RC
 TSS_TPMS_SCHEME_HASH_Marshalu(const TPMS_SCHEME_HASH *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_HASH_Marshalu(&source->hashAlg, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_SCHEME_HASH, written, buffer, size);
 }
     
 /* Table 136 - Definition of {ECC} TPMS_SCHEME_ECDAA Structure */
@@ -4672,14 +5479,7 @@ TSS_TPMS_SCHEME_HASH_Marshalu(const TPMS_SCHEME_HASH *source, uint16_t *written,
 TPM_RC
 TSS_TPMS_SCHEME_ECDAA_Marshalu(const TPMS_SCHEME_ECDAA *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_HASH_Marshalu(&source->hashAlg, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT16_Marshalu(&source->count, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_SCHEME_ECDAA, written, buffer, size);
 }
 
 /* Table 137 - Definition of (TPM_ALG_ID) TPMI_ALG_KEYEDHASH_SCHEME Type */
@@ -4711,14 +5511,7 @@ TSS_TPMS_SCHEME_HMAC_Marshalu(const TPMS_SCHEME_HMAC *source, uint16_t *written,
 TPM_RC
 TSS_TPMS_SCHEME_XOR_Marshalu(const TPMS_SCHEME_XOR *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_HASH_Marshalu(&source->hashAlg, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_KDF_Marshalu(&source->kdf, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_SCHEME_XOR, written, buffer, size);
 }
 
 /* Table 140 - Definition of TPMU_SCHEME_KEYEDHASH Union <IN/OUT, S> */
@@ -4755,14 +5548,7 @@ TSS_TPMU_SCHEME_KEYEDHASH_Marshalu(const TPMU_SCHEME_KEYEDHASH *source, uint16_t
 TPM_RC
 TSS_TPMT_KEYEDHASH_SCHEME_Marshalu(const TPMT_KEYEDHASH_SCHEME *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_KEYEDHASH_SCHEME_Marshalu(&source->scheme, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_SCHEME_KEYEDHASH_Marshalu(&source->details, written, buffer, size, source->scheme);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_KEYEDHASH_SCHEME, written, buffer, size);
 }
 
 /* Table 142 - Definition of {RSA} Types for RSA Signature Schemes */
@@ -4898,14 +5684,7 @@ TSS_TPMU_SIG_SCHEME_Marshalu(const TPMU_SIG_SCHEME *source, uint16_t *written, B
 TPM_RC
 TSS_TPMT_SIG_SCHEME_Marshalu(const TPMT_SIG_SCHEME *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_SIG_SCHEME_Marshalu(&source->scheme, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_SIG_SCHEME_Marshalu(&source->details, written, buffer, size,source->scheme);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_SIG_SCHEME, written, buffer, size);
 }
 
 /* Table 146 - Definition of Types for {RSA} Encryption Schemes */
@@ -5043,14 +5822,7 @@ TSS_TPMU_KDF_SCHEME_Marshalu(const TPMU_KDF_SCHEME *source, uint16_t *written, B
 TPM_RC
 TSS_TPMT_KDF_SCHEME_Marshalu(const TPMT_KDF_SCHEME *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_KDF_Marshalu(&source->scheme, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_KDF_SCHEME_Marshalu(&source->details, written, buffer, size, source->scheme);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_KDF_SCHEME, written, buffer, size);
 }
 
 /* Table 152 - Definition of TPMU_ASYM_SCHEME Union */
@@ -5155,14 +5927,7 @@ TSS_TPMI_ALG_RSA_SCHEME_Marshalu(const TPMI_ALG_RSA_SCHEME *source, uint16_t *wr
 TPM_RC
 TSS_TPMT_RSA_SCHEME_Marshalu(const TPMT_RSA_SCHEME *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_RSA_SCHEME_Marshalu(&source->scheme, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_ASYM_SCHEME_Marshalu(&source->details, written, buffer, size, source->scheme);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_RSA_SCHEME, written, buffer, size);
 }
 
 /* Table 156 - Definition of (TPM_ALG_ID) {RSA} TPMI_ALG_RSA_DECRYPT Type */
@@ -5182,14 +5947,7 @@ TSS_TPMI_ALG_RSA_DECRYPT_Marshalu(const TPMI_ALG_RSA_DECRYPT *source, uint16_t *
 TPM_RC
 TSS_TPMT_RSA_DECRYPT_Marshalu(const TPMT_RSA_DECRYPT  *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_RSA_DECRYPT_Marshalu(&source->scheme, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_ASYM_SCHEME_Marshalu(&source->details, written, buffer, size, source->scheme);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_RSA_DECRYPT, written, buffer, size);
 }
 
 /* Table 158 - Definition of {RSA} TPM2B_PUBLIC_KEY_RSA Structure */
@@ -5245,14 +6003,7 @@ TSS_TPM2B_ECC_PARAMETER_Marshalu(const TPM2B_ECC_PARAMETER *source, uint16_t *wr
 TPM_RC
 TSS_TPMS_ECC_POINT_Marshalu(const TPMS_ECC_POINT *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->x, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->y, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_ECC_POINT, written, buffer, size);
 }
 
 /* Table 163 - Definition of {ECC} TPM2B_ECC_POINT Structure */
@@ -5260,27 +6011,7 @@ TSS_TPMS_ECC_POINT_Marshalu(const TPMS_ECC_POINT *source, uint16_t *written, BYT
 TPM_RC
 TSS_TPM2B_ECC_POINT_Marshalu(const TPM2B_ECC_POINT *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint16_t sizeWritten = 0;	/* of structure */
-    BYTE *sizePtr;
-
-    if (buffer != NULL) {
-	sizePtr = *buffer;
-	*buffer += sizeof(uint16_t);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMS_ECC_POINT_Marshalu(&source->point, &sizeWritten, buffer, size);
-    }
-    if (rc == 0) {
-	*written += sizeWritten;
-	if (buffer != NULL) {
-	    rc = TSS_UINT16_Marshalu(&sizeWritten, written, &sizePtr, size);
-	}
-	else {
-	    *written += sizeof(uint16_t);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPM2B_ECC_POINT, written, buffer, size);
 }
 
 /* Table 164 - Definition of (TPM_ALG_ID) {ECC} TPMI_ALG_ECC_SCHEME Type */
@@ -5312,14 +6043,7 @@ TSS_TPMI_ECC_CURVE_Marshalu(const TPMI_ECC_CURVE *source, uint16_t *written, BYT
 TPM_RC
 TSS_TPMT_ECC_SCHEME_Marshalu(const TPMT_ECC_SCHEME *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_ECC_SCHEME_Marshalu(&source->scheme, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_ASYM_SCHEME_Marshalu(&source->details, written, buffer, size, source->scheme);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_ECC_SCHEME, written, buffer, size);
 }
 
 /* Table 167 - Definition of {ECC} TPMS_ALGORITHM_DETAIL_ECC Structure <OUT> */
@@ -5327,41 +6051,7 @@ TSS_TPMT_ECC_SCHEME_Marshalu(const TPMT_ECC_SCHEME *source, uint16_t *written, B
 TPM_RC
 TSS_TPMS_ALGORITHM_DETAIL_ECC_Marshalu(const TPMS_ALGORITHM_DETAIL_ECC *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPM_ECC_CURVE_Marshalu(&source->curveID, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT16_Marshalu(&source->keySize, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMT_KDF_SCHEME_Marshalu(&source->kdf, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMT_ECC_SCHEME_Marshalu(&source->sign, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->p, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->a, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->b, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->gX, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->gY, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->n, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->h, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_ALGORITHM_DETAIL_ECC, written, buffer, size);
 }
     
 /* Table 168 - Definition of {RSA} TPMS_SIGNATURE_RSA Structure */
@@ -5369,14 +6059,7 @@ TSS_TPMS_ALGORITHM_DETAIL_ECC_Marshalu(const TPMS_ALGORITHM_DETAIL_ECC *source,
 TPM_RC
 TSS_TPMS_SIGNATURE_RSA_Marshalu(const TPMS_SIGNATURE_RSA *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_HASH_Marshalu(&source->hash, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_PUBLIC_KEY_RSA_Marshalu(&source->sig, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_SIGNATURE_RSA, written, buffer, size);
 }
 
 /* Table 169 - Definition of Types for {RSA} Signature */
@@ -5405,17 +6088,7 @@ TSS_TPMS_SIGNATURE_RSAPSS_Marshalu(const TPMS_SIGNATURE_RSAPSS *source, uint16_t
 TPM_RC
 TSS_TPMS_SIGNATURE_ECC_Marshalu(const TPMS_SIGNATURE_ECC *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_HASH_Marshalu(&source->hash, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->signatureR, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_ECC_PARAMETER_Marshalu(&source->signatureS, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_SIGNATURE_ECC, written, buffer, size);
 }
     
 /* Table 171 - Definition of Types for {ECC} TPMS_SIGNATURE_ECC */
@@ -5529,14 +6202,7 @@ TSS_TPMU_SIGNATURE_Marshalu(const TPMU_SIGNATURE *source, uint16_t *written, BYT
 TPM_RC
 TSS_TPMT_SIGNATURE_Marshalu(const TPMT_SIGNATURE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_SIG_SCHEME_Marshalu(&source->sigAlg, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_SIGNATURE_Marshalu(&source->signature, written, buffer, size, source->sigAlg);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_SIGNATURE, written, buffer, size);
 }
 
 /* Table 175 - Definition of TPM2B_ENCRYPTED_SECRET Structure */
@@ -5609,11 +6275,7 @@ TSS_TPMU_PUBLIC_ID_Marshalu(const TPMU_PUBLIC_ID *source, uint16_t *written, BYT
 TPM_RC
 TSS_TPMS_KEYEDHASH_PARMS_Marshalu(const TPMS_KEYEDHASH_PARMS *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMT_KEYEDHASH_SCHEME_Marshalu(&source->scheme, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_KEYEDHASH_PARMS, written, buffer, size);
 }
 
 /* Table 180 - Definition of {RSA} TPMS_RSA_PARMS Structure */
@@ -5621,40 +6283,14 @@ TSS_TPMS_KEYEDHASH_PARMS_Marshalu(const TPMS_KEYEDHASH_PARMS *source, uint16_t *
 TPM_RC
 TSS_TPMS_RSA_PARMS_Marshalu(const TPMS_RSA_PARMS *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMT_SYM_DEF_OBJECT_Marshalu(&source->symmetric, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMT_RSA_SCHEME_Marshalu(&source->scheme, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMI_RSA_KEY_BITS_Marshalu(&source->keyBits, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT32_Marshalu(&source->exponent, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_RSA_PARMS, written, buffer, size);
 }
 /* Table 181 - Definition of {ECC} TPMS_ECC_PARMS Structure */
 
 TPM_RC
 TSS_TPMS_ECC_PARMS_Marshalu(const TPMS_ECC_PARMS *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMT_SYM_DEF_OBJECT_Marshalu(&source->symmetric, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMT_ECC_SCHEME_Marshalu(&source->scheme, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMI_ECC_CURVE_Marshalu(&source->curveID, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMT_KDF_SCHEME_Marshalu(&source->kdf, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_ECC_PARMS, written, buffer, size);
 }
 
 /* Table 182 - Definition of TPMU_PUBLIC_PARMS Union <IN/OUT, S> */
@@ -5703,33 +6339,41 @@ TSS_TPMU_PUBLIC_PARMS_Marshalu(const TPMU_PUBLIC_PARMS *source, uint16_t *writte
 TPM_RC
 TSS_TPMT_PUBLIC_PARMS_Marshalu(const TPMT_PUBLIC_PARMS *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_PUBLIC_Marshalu(&source->type, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_PUBLIC_PARMS_Marshalu(&source->parameters, written, buffer, size, source->type);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_PUBLIC_PARMS, written, buffer, size);
 }
 
-/* Table 184 - Definition of TPMT_PUBLIC Structure */
+/* Table 184 - Definition of TPMT_PUBLIC Structure
+
+   TPMT_PUBLIC is marshaled for every object name and TPM2B_PUBLIC, so when the buffer is large
+   enough, type, nameAlg, and objectAttributes are marshaled inline.
+*/
 
 TPM_RC
 TSS_TPMT_PUBLIC_Marshalu(const TPMT_PUBLIC *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
     TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_PUBLIC_Marshalu(&source->type, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_HASH_Marshalu(&source->nameAlg, written, buffer, size);
+    BYTE *b;
+
+    if ((buffer == NULL) ||
+	((size != NULL) && (*size < sizeof(UINT16) + sizeof(UINT16) + sizeof(UINT32)))) {
+	return TSS_Desc_Marshalu(source, &tssDescTPMT_PUBLIC, written, buffer, size);
     }
-    if (rc == 0) {
-	rc = TSS_TPMA_OBJECT_Marshalu(&source->objectAttributes, written, buffer, size);
+    b = *buffer;
+    b[0] = (BYTE)((source->type >> 8) & 0xff);
+    b[1] = (BYTE)((source->type >> 0) & 0xff);
+    b[2] = (BYTE)((source->nameAlg >> 8) & 0xff);
+    b[3] = (BYTE)((source->nameAlg >> 0) & 0xff);
+    b[4] = (BYTE)((source->objectAttributes.val >> 24) & 0xff);
+    b[5] = (BYTE)((source->objectAttributes.val >> 16) & 0xff);
+    b[6] = (BYTE)((source->objectAttributes.val >>  8) & 0xff);
+    b[7] = (BYTE)((source->objectAttributes.val >>  0) & 0xff);
+    *buffer += sizeof(UINT16) + sizeof(UINT16) + sizeof(UINT32);
+    if (size != NULL) {
+	*size -= sizeof(UINT16) + sizeof(UINT16) + sizeof(UINT32);
     }
+    *written += sizeof(UINT16) + sizeof(UINT16) + sizeof(UINT32);
     if (rc == 0) {
-	rc = TSS_TPM2B_DIGEST_Marshalu(&source->authPolicy, written, buffer, size);
+	rc = TSS_TPM2B_Marshalu(&source->authPolicy.b, written, buffer, size);
     }
     if (rc == 0) {
 	rc = TSS_TPMU_PUBLIC_PARMS_Marshalu(&source->parameters, written, buffer, size, source->type);
@@ -5773,27 +6417,7 @@ TSS_TPMT_PUBLIC_D_Marshalu(const TPMT_PUBLIC *source, uint16_t *written, BYTE **
 TPM_RC
 TSS_TPM2B_PUBLIC_Marshalu(const TPM2B_PUBLIC *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint16_t sizeWritten = 0;	/* of structure */
-    BYTE *sizePtr;
-    
-    if (buffer != NULL) {
-	sizePtr = *buffer;
-	*buffer += sizeof(uint16_t);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMT_PUBLIC_Marshalu(&source->publicArea, &sizeWritten, buffer, size);
-    }
-    if (rc == 0) {
-	*written += sizeWritten;
-	if (buffer != NULL) {
-	    rc = TSS_UINT16_Marshalu(&sizeWritten, written, &sizePtr, size);
-	}
-	else {
-	    *written += sizeof(uint16_t);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPM2B_PUBLIC, written, buffer, size);
 }
 
 TPM_RC
@@ -5850,22 +6474,9 @@ TSS_TPMU_SENSITIVE_COMPOSITE_Marshalu(const TPMU_SENSITIVE_COMPOSITE *source, ui
 /* Table 188 - Definition of TPMT_SENSITIVE Structure */
 
 TPM_RC
-TSS_TPMT_SENSITIVE_Marshalu(const TPMT_SENSITIVE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
-{
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_PUBLIC_Marshalu(&source->sensitiveType, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_AUTH_Marshalu(&source->authValue, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DIGEST_Marshalu(&source->seedValue, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMU_SENSITIVE_COMPOSITE_Marshalu(&source->sensitive, written, buffer, size, source->sensitiveType);
-    }
-    return rc;
+TSS_TPMT_SENSITIVE_Marshalu(const TPMT_SENSITIVE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
+{
+    return TSS_Desc_Marshalu(source, &tssDescTPMT_SENSITIVE, written, buffer, size);
 }
 
 /* Table 189 - Definition of TPM2B_SENSITIVE Structure <IN/OUT> */
@@ -5873,27 +6484,7 @@ TSS_TPMT_SENSITIVE_Marshalu(const TPMT_SENSITIVE *source, uint16_t *written, BYT
 TPM_RC
 TSS_TPM2B_SENSITIVE_Marshalu(const TPM2B_SENSITIVE *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint16_t sizeWritten = 0;	/* of structure */
-    BYTE *sizePtr;
-    
-    if (buffer != NULL) {
-	sizePtr = *buffer;
-	*buffer += sizeof(uint16_t);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMT_SENSITIVE_Marshalu(&source->t.sensitiveArea, &sizeWritten, buffer, size);
-    }
-    if (rc == 0) {
-	*written += sizeWritten;
-	if (buffer != NULL) {
-	    rc = TSS_UINT16_Marshalu(&sizeWritten, written, &sizePtr, size);
-	}
-	else {
-	    *written += sizeof(uint16_t);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPM2B_SENSITIVE, written, buffer, size);
 }
 
 /* Table 191 - Definition of TPM2B_PRIVATE Structure <IN/OUT, S> */
@@ -5937,23 +6528,7 @@ TSS_TPMA_NV_Marshalu(const TPMA_NV *source, uint16_t *written, BYTE **buffer, ui
 TPM_RC
 TSS_TPMS_NV_PUBLIC_Marshalu(const TPMS_NV_PUBLIC *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPMI_RH_NV_INDEX_Marshalu(&source->nvIndex, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMI_ALG_HASH_Marshalu(&source->nameAlg, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMA_NV_Marshalu(&source->attributes, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DIGEST_Marshalu(&source->authPolicy, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_UINT16_Marshalu(&source->dataSize, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_NV_PUBLIC, written, buffer, size);
 }
 
 /* Table 198 - Definition of TPM2B_NV_PUBLIC Structure */
@@ -5961,27 +6536,7 @@ TSS_TPMS_NV_PUBLIC_Marshalu(const TPMS_NV_PUBLIC *source, uint16_t *written, BYT
 TPM_RC
 TSS_TPM2B_NV_PUBLIC_Marshalu(const TPM2B_NV_PUBLIC *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint16_t sizeWritten = 0;	/* of structure */
-    BYTE *sizePtr;
-
-    if (buffer != NULL) {
- 	sizePtr = *buffer;
-	*buffer += sizeof(uint16_t);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMS_NV_PUBLIC_Marshalu(&source->nvPublic, &sizeWritten, buffer, size);
-    }
-    if (rc == 0) {
-	*written += sizeWritten;
-	if (buffer != NULL) {
-	    rc = TSS_UINT16_Marshalu(&sizeWritten, written, &sizePtr, size);
-	}
-	else {
-	    *written += sizeof(uint16_t);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPM2B_NV_PUBLIC, written, buffer, size);
 }
 
 /* Table 199 - Definition of TPM2B_CONTEXT_SENSITIVE Structure <IN/OUT> */
@@ -6013,20 +6568,7 @@ TSS_TPM2B_CONTEXT_DATA_Marshalu(const TPM2B_CONTEXT_DATA  *source, uint16_t *wri
 TPM_RC
 TSS_TPMS_CONTEXT_Marshalu(const TPMS_CONTEXT *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_UINT64_Marshalu(&source->sequence, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMI_DH_SAVED_Marshalu(&source->savedHandle, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMI_RH_HIERARCHY_Marshalu(&source->hierarchy, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_CONTEXT_DATA_Marshalu(&source->contextBlob, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_CONTEXT, written, buffer, size);
 }
 
 /* Table 204 - Definition of TPMS_CREATION_DATA Structure <OUT> */
@@ -6034,29 +6576,7 @@ TSS_TPMS_CONTEXT_Marshalu(const TPMS_CONTEXT *source, uint16_t *written, BYTE **
 TPM_RC
 TSS_TPMS_CREATION_DATA_Marshalu(const TPMS_CREATION_DATA *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    if (rc == 0) {
-	rc = TSS_TPML_PCR_SELECTION_Marshalu(&source->pcrSelect, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DIGEST_Marshalu(&source->pcrDigest, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMA_LOCALITY_Marshalu(&source->locality, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM_ALG_ID_Marshalu(&source->parentNameAlg, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_NAME_Marshalu(&source->parentName, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_NAME_Marshalu(&source->parentQualifiedName, written, buffer, size);
-    }
-    if (rc == 0) {
-	rc = TSS_TPM2B_DATA_Marshalu(&source->outsideInfo, written, buffer, size);
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPMS_CREATION_DATA, written, buffer, size);
 }
 
 /* Table 205 - Definition of TPM2B_CREATION_DATA Structure <OUT> */
@@ -6064,27 +6584,7 @@ TSS_TPMS_CREATION_DATA_Marshalu(const TPMS_CREATION_DATA *source, uint16_t *writ
 TPM_RC
 TSS_TPM2B_CREATION_DATA_Marshalu(const TPM2B_CREATION_DATA *source, uint16_t *written, BYTE **buffer, uint32_t *size)
 {
-    TPM_RC rc = 0;
-    uint16_t sizeWritten = 0;	/* of structure */
-    BYTE *sizePtr;
-
-    if (buffer != NULL) {
-	sizePtr = *buffer;
-	*buffer += sizeof(uint16_t);
-    }
-    if (rc == 0) {
-	rc = TSS_TPMS_CREATION_DATA_Marshalu(&source->creationData, &sizeWritten, buffer, size);
-    }
-    if (rc == 0) {
-	*written += sizeWritten;
-	if (buffer != NULL) {
-	    rc = TSS_UINT16_Marshalu(&sizeWritten, written, &sizePtr, size);
-	}
-	else {
-	    *written += sizeof(uint16_t);
-	}
-    }
-    return rc;
+    return TSS_Desc_Marshalu(source, &tssDescTPM2B_CREATION_DATA, written, buffer, size);
 }
 
 #ifndef TPM_TSS_NODEPRECATED
@@ -7063,814 +7563,1136 @@ TSS_TPM2B_CREATION_DATA_Marshal(const TPM2B_CREATION_DATA *source, UINT16 *writt
 
 
 
+#if CC_Startup
 TPM_RC
 TSS_Startup_In_Marshal(const Startup_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Startup_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Shutdown
 TPM_RC
 TSS_Shutdown_In_Marshal(const Shutdown_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Shutdown_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_SelfTest
 TPM_RC
 TSS_SelfTest_In_Marshal(const SelfTest_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_SelfTest_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_IncrementalSelfTest
 TPM_RC
 TSS_IncrementalSelfTest_In_Marshal(const IncrementalSelfTest_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_IncrementalSelfTest_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_StartAuthSession
 TPM_RC
 TSS_StartAuthSession_In_Marshal(const StartAuthSession_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_StartAuthSession_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyRestart
 TPM_RC
 TSS_PolicyRestart_In_Marshal(const PolicyRestart_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyRestart_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Create
 TPM_RC
 TSS_Create_In_Marshal(const Create_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Create_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Load
 TPM_RC
 TSS_Load_In_Marshal(const Load_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Load_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_LoadExternal
 TPM_RC
 TSS_LoadExternal_In_Marshal(const LoadExternal_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_LoadExternal_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ReadPublic
 TPM_RC
 TSS_ReadPublic_In_Marshal(const ReadPublic_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ReadPublic_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ActivateCredential
 TPM_RC
 TSS_ActivateCredential_In_Marshal(const ActivateCredential_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ActivateCredential_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_MakeCredential
 TPM_RC
 TSS_MakeCredential_In_Marshal(const MakeCredential_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_MakeCredential_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Unseal
 TPM_RC
 TSS_Unseal_In_Marshal(const Unseal_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Unseal_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ObjectChangeAuth
 TPM_RC
 TSS_ObjectChangeAuth_In_Marshal(const ObjectChangeAuth_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ObjectChangeAuth_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_CreateLoaded
 TPM_RC
 TSS_CreateLoaded_In_Marshal(const CreateLoaded_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_CreateLoaded_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Duplicate
 TPM_RC
 TSS_Duplicate_In_Marshal(const Duplicate_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Duplicate_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Rewrap
 TPM_RC
 TSS_Rewrap_In_Marshal(const Rewrap_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Rewrap_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Import
 TPM_RC
 TSS_Import_In_Marshal(const Import_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Import_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_RSA_Encrypt
 TPM_RC
 TSS_RSA_Encrypt_In_Marshal(const RSA_Encrypt_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_RSA_Encrypt_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_RSA_Decrypt
 TPM_RC
 TSS_RSA_Decrypt_In_Marshal(const RSA_Decrypt_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_RSA_Decrypt_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ECDH_KeyGen
 TPM_RC
 TSS_ECDH_KeyGen_In_Marshal(const ECDH_KeyGen_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ECDH_KeyGen_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ECDH_ZGen
 TPM_RC
 TSS_ECDH_ZGen_In_Marshal(const ECDH_ZGen_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ECDH_ZGen_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ECC_Parameters
 TPM_RC
 TSS_ECC_Parameters_In_Marshal(const ECC_Parameters_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ECC_Parameters_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ZGen_2Phase
 TPM_RC
 TSS_ZGen_2Phase_In_Marshal(const ZGen_2Phase_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ZGen_2Phase_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_EncryptDecrypt
 TPM_RC
 TSS_EncryptDecrypt_In_Marshal(const EncryptDecrypt_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_EncryptDecrypt_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_EncryptDecrypt2
 TPM_RC
 TSS_EncryptDecrypt2_In_Marshal(const EncryptDecrypt2_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_EncryptDecrypt2_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Hash
 TPM_RC
 TSS_Hash_In_Marshal(const Hash_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Hash_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_HMAC
 TPM_RC
 TSS_HMAC_In_Marshal(const HMAC_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_HMAC_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetRandom
 TPM_RC
 TSS_GetRandom_In_Marshal(const GetRandom_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_GetRandom_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_StirRandom
 TPM_RC
 TSS_StirRandom_In_Marshal(const StirRandom_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_StirRandom_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_HMAC_Start
 TPM_RC
 TSS_HMAC_Start_In_Marshal(const HMAC_Start_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_HMAC_Start_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_HashSequenceStart
 TPM_RC
 TSS_HashSequenceStart_In_Marshal(const HashSequenceStart_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_HashSequenceStart_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_SequenceUpdate
 TPM_RC
 TSS_SequenceUpdate_In_Marshal(const SequenceUpdate_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_SequenceUpdate_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_SequenceComplete
 TPM_RC
 TSS_SequenceComplete_In_Marshal(const SequenceComplete_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_SequenceComplete_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_EventSequenceComplete
 TPM_RC
 TSS_EventSequenceComplete_In_Marshal(const EventSequenceComplete_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_EventSequenceComplete_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Certify
 TPM_RC
 TSS_Certify_In_Marshal(const Certify_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Certify_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_CertifyCreation
 TPM_RC
 TSS_CertifyCreation_In_Marshal(const CertifyCreation_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_CertifyCreation_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Quote
 TPM_RC
 TSS_Quote_In_Marshal(const Quote_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Quote_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetSessionAuditDigest
 TPM_RC
 TSS_GetSessionAuditDigest_In_Marshal(const GetSessionAuditDigest_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_GetSessionAuditDigest_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetCommandAuditDigest
 TPM_RC
 TSS_GetCommandAuditDigest_In_Marshal(const GetCommandAuditDigest_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_GetCommandAuditDigest_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetTime
 TPM_RC
 TSS_GetTime_In_Marshal(const GetTime_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_GetTime_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Commit
 TPM_RC
 TSS_Commit_In_Marshal(const Commit_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Commit_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_EC_Ephemeral
 TPM_RC
 TSS_EC_Ephemeral_In_Marshal(const EC_Ephemeral_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_EC_Ephemeral_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_VerifySignature
 TPM_RC
 TSS_VerifySignature_In_Marshal(const VerifySignature_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_VerifySignature_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Sign
 TPM_RC
 TSS_Sign_In_Marshal(const Sign_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Sign_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_SetCommandCodeAuditStatus
 TPM_RC
 TSS_SetCommandCodeAuditStatus_In_Marshal(const SetCommandCodeAuditStatus_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_SetCommandCodeAuditStatus_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_Extend
 TPM_RC
 TSS_PCR_Extend_In_Marshal(const PCR_Extend_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_Extend_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_Event
 TPM_RC
 TSS_PCR_Event_In_Marshal(const PCR_Event_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_Event_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_Read
 TPM_RC
 TSS_PCR_Read_In_Marshal(const PCR_Read_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_Read_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_Allocate
 TPM_RC
 TSS_PCR_Allocate_In_Marshal(const PCR_Allocate_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_Allocate_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_SetAuthPolicy
 TPM_RC
 TSS_PCR_SetAuthPolicy_In_Marshal(const PCR_SetAuthPolicy_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_SetAuthPolicy_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_SetAuthValue
 TPM_RC
 TSS_PCR_SetAuthValue_In_Marshal(const PCR_SetAuthValue_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_SetAuthValue_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_Reset
 TPM_RC
 TSS_PCR_Reset_In_Marshal(const PCR_Reset_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_Reset_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicySigned
 TPM_RC
 TSS_PolicySigned_In_Marshal(const PolicySigned_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicySigned_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicySecret
 TPM_RC
 TSS_PolicySecret_In_Marshal(const PolicySecret_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicySecret_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyTicket
 TPM_RC
 TSS_PolicyTicket_In_Marshal(const PolicyTicket_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyTicket_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyOR
 TPM_RC
 TSS_PolicyOR_In_Marshal(const PolicyOR_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyOR_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyPCR
 TPM_RC
 TSS_PolicyPCR_In_Marshal(const PolicyPCR_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyPCR_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyLocality
 TPM_RC
 TSS_PolicyLocality_In_Marshal(const PolicyLocality_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyLocality_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyNV
 TPM_RC
 TSS_PolicyNV_In_Marshal(const PolicyNV_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyNV_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyCounterTimer
 TPM_RC
 TSS_PolicyCounterTimer_In_Marshal(const PolicyCounterTimer_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyCounterTimer_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyCommandCode
 TPM_RC
 TSS_PolicyCommandCode_In_Marshal(const PolicyCommandCode_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyCommandCode_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyPhysicalPresence
 TPM_RC
 TSS_PolicyPhysicalPresence_In_Marshal(const PolicyPhysicalPresence_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyPhysicalPresence_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyCpHash
 TPM_RC
 TSS_PolicyCpHash_In_Marshal(const PolicyCpHash_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyCpHash_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyNameHash
 TPM_RC
 TSS_PolicyNameHash_In_Marshal(const PolicyNameHash_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyNameHash_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyDuplicationSelect
 TPM_RC
 TSS_PolicyDuplicationSelect_In_Marshal(const PolicyDuplicationSelect_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyDuplicationSelect_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyAuthorize
 TPM_RC
 TSS_PolicyAuthorize_In_Marshal(const PolicyAuthorize_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyAuthorize_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyAuthValue
 TPM_RC
 TSS_PolicyAuthValue_In_Marshal(const PolicyAuthValue_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyAuthValue_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyPassword
 TPM_RC
 TSS_PolicyPassword_In_Marshal(const PolicyPassword_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyPassword_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyGetDigest
 TPM_RC
 TSS_PolicyGetDigest_In_Marshal(const PolicyGetDigest_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyGetDigest_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyNvWritten
 TPM_RC
 TSS_PolicyNvWritten_In_Marshal(const PolicyNvWritten_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyNvWritten_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyTemplate
 TPM_RC
 TSS_PolicyTemplate_In_Marshal(const PolicyTemplate_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyTemplate_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyAuthorizeNV
 TPM_RC
 TSS_PolicyAuthorizeNV_In_Marshal(const PolicyAuthorizeNV_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyAuthorizeNV_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_CreatePrimary
 TPM_RC
 TSS_CreatePrimary_In_Marshal(const CreatePrimary_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_CreatePrimary_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_HierarchyControl
 TPM_RC
 TSS_HierarchyControl_In_Marshal(const HierarchyControl_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_HierarchyControl_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_SetPrimaryPolicy
 TPM_RC
 TSS_SetPrimaryPolicy_In_Marshal(const SetPrimaryPolicy_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_SetPrimaryPolicy_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ChangePPS
 TPM_RC
 TSS_ChangePPS_In_Marshal(const ChangePPS_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ChangePPS_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ChangeEPS
 TPM_RC
 TSS_ChangeEPS_In_Marshal(const ChangeEPS_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ChangeEPS_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Clear
 TPM_RC
 TSS_Clear_In_Marshal(const Clear_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_Clear_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ClearControl
 TPM_RC
 TSS_ClearControl_In_Marshal(const ClearControl_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ClearControl_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_HierarchyChangeAuth
 TPM_RC
 TSS_HierarchyChangeAuth_In_Marshal(const HierarchyChangeAuth_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_HierarchyChangeAuth_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_DictionaryAttackLockReset
 TPM_RC
 TSS_DictionaryAttackLockReset_In_Marshal(const DictionaryAttackLockReset_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_DictionaryAttackLockReset_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_DictionaryAttackParameters
 TPM_RC
 TSS_DictionaryAttackParameters_In_Marshal(const DictionaryAttackParameters_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_DictionaryAttackParameters_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PP_Commands
 TPM_RC
 TSS_PP_Commands_In_Marshal(const PP_Commands_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_PP_Commands_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_SetAlgorithmSet
 TPM_RC
 TSS_SetAlgorithmSet_In_Marshal(const SetAlgorithmSet_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_SetAlgorithmSet_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ContextSave
 TPM_RC
 TSS_ContextSave_In_Marshal(const ContextSave_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ContextSave_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ContextLoad
 TPM_RC
 TSS_ContextLoad_In_Marshal(const ContextLoad_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ContextLoad_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_FlushContext
 TPM_RC
 TSS_FlushContext_In_Marshal(const FlushContext_In *source, uint16_t *written, BYTE **buffer, int32_t *size) 
 {
     return TSS_FlushContext_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_EvictControl
 TPM_RC
 TSS_EvictControl_In_Marshal(const EvictControl_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_EvictControl_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ClockSet
 TPM_RC
 TSS_ClockSet_In_Marshal(const ClockSet_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ClockSet_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ClockRateAdjust
 TPM_RC
 TSS_ClockRateAdjust_In_Marshal(const ClockRateAdjust_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_ClockRateAdjust_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetCapability
 TPM_RC
 TSS_GetCapability_In_Marshal(const GetCapability_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_GetCapability_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_TestParms
 TPM_RC
 TSS_TestParms_In_Marshal(const TestParms_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_TestParms_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_DefineSpace
 TPM_RC
 TSS_NV_DefineSpace_In_Marshal(const NV_DefineSpace_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_DefineSpace_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_UndefineSpace
 TPM_RC
 TSS_NV_UndefineSpace_In_Marshal(const NV_UndefineSpace_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_UndefineSpace_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_UndefineSpaceSpecial
 TPM_RC
 TSS_NV_UndefineSpaceSpecial_In_Marshal(const NV_UndefineSpaceSpecial_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_UndefineSpaceSpecial_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_ReadPublic
 TPM_RC
 TSS_NV_ReadPublic_In_Marshal(const NV_ReadPublic_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_ReadPublic_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_Write
 TPM_RC
 TSS_NV_Write_In_Marshal(const NV_Write_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_Write_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_Increment
 TPM_RC
 TSS_NV_Increment_In_Marshal(const NV_Increment_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_Increment_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_Extend
 TPM_RC
 TSS_NV_Extend_In_Marshal(const NV_Extend_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_Extend_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_SetBits
 TPM_RC
 TSS_NV_SetBits_In_Marshal(const NV_SetBits_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_SetBits_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_WriteLock
 TPM_RC
 TSS_NV_WriteLock_In_Marshal(const NV_WriteLock_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_WriteLock_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_GlobalWriteLock
 TPM_RC
 TSS_NV_GlobalWriteLock_In_Marshal(const NV_GlobalWriteLock_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_GlobalWriteLock_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_Read
 TPM_RC
 TSS_NV_Read_In_Marshal(const NV_Read_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_Read_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_ReadLock
 TPM_RC
 TSS_NV_ReadLock_In_Marshal(const NV_ReadLock_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_ReadLock_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_ChangeAuth
 TPM_RC
 TSS_NV_ChangeAuth_In_Marshal(const NV_ChangeAuth_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_ChangeAuth_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_Certify
 TPM_RC
 TSS_NV_Certify_In_Marshal(const NV_Certify_In *source, uint16_t *written, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_Certify_In_Marshalu(source, written, buffer, (uint32_t *)size);
 }
+#endif
 
 
 
+#if CC_IncrementalSelfTest
 TPM_RC
 TSS_IncrementalSelfTest_Out_Unmarshal(IncrementalSelfTest_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_IncrementalSelfTest_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetTestResult
 TPM_RC
 TSS_GetTestResult_Out_Unmarshal(GetTestResult_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_GetTestResult_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_StartAuthSession
 TPM_RC
 TSS_StartAuthSession_Out_Unmarshal(StartAuthSession_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_StartAuthSession_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Create
 TPM_RC
 TSS_Create_Out_Unmarshal(Create_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Create_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Load
 TPM_RC
 TSS_Load_Out_Unmarshal(Load_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Load_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_LoadExternal
 TPM_RC
 TSS_LoadExternal_Out_Unmarshal(LoadExternal_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_LoadExternal_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ReadPublic
 TPM_RC
 TSS_ReadPublic_Out_Unmarshal(ReadPublic_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ReadPublic_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ActivateCredential
 TPM_RC
 TSS_ActivateCredential_Out_Unmarshal(ActivateCredential_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ActivateCredential_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_MakeCredential
 TPM_RC
 TSS_MakeCredential_Out_Unmarshal(MakeCredential_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_MakeCredential_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Unseal
 TPM_RC
 TSS_Unseal_Out_Unmarshal(Unseal_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Unseal_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ObjectChangeAuth
 TPM_RC
 TSS_ObjectChangeAuth_Out_Unmarshal(ObjectChangeAuth_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ObjectChangeAuth_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_CreateLoaded
 TPM_RC
 TSS_CreateLoaded_Out_Unmarshal(CreateLoaded_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_CreateLoaded_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Duplicate
 TPM_RC
 TSS_Duplicate_Out_Unmarshal(Duplicate_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Duplicate_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Rewrap
 TPM_RC
 TSS_Rewrap_Out_Unmarshal(Rewrap_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Rewrap_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Import
 TPM_RC
 TSS_Import_Out_Unmarshal(Import_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Import_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_RSA_Encrypt
 TPM_RC
 TSS_RSA_Encrypt_Out_Unmarshal(RSA_Encrypt_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_RSA_Encrypt_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_RSA_Decrypt
 TPM_RC
 TSS_RSA_Decrypt_Out_Unmarshal(RSA_Decrypt_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_RSA_Decrypt_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ECDH_KeyGen
 TPM_RC
 TSS_ECDH_KeyGen_Out_Unmarshal(ECDH_KeyGen_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ECDH_KeyGen_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ECDH_ZGen
 TPM_RC
 TSS_ECDH_ZGen_Out_Unmarshal(ECDH_ZGen_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ECDH_ZGen_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ECC_Parameters
 TPM_RC
 TSS_ECC_Parameters_Out_Unmarshal(ECC_Parameters_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ECC_Parameters_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ZGen_2Phase
 TPM_RC
 TSS_ZGen_2Phase_Out_Unmarshal(ZGen_2Phase_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ZGen_2Phase_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_EncryptDecrypt
 TPM_RC
 TSS_EncryptDecrypt_Out_Unmarshal(EncryptDecrypt_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_EncryptDecrypt_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_EncryptDecrypt2
 TPM_RC
 TSS_EncryptDecrypt2_Out_Unmarshal(EncryptDecrypt2_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_EncryptDecrypt2_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Hash
 TPM_RC
 TSS_Hash_Out_Unmarshal(Hash_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Hash_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_HMAC
 TPM_RC
 TSS_HMAC_Out_Unmarshal(HMAC_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_HMAC_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetRandom
 TPM_RC
 TSS_GetRandom_Out_Unmarshal(GetRandom_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_GetRandom_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_HMAC_Start
 TPM_RC
 TSS_HMAC_Start_Out_Unmarshal(HMAC_Start_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_HMAC_Start_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_HashSequenceStart
 TPM_RC
 TSS_HashSequenceStart_Out_Unmarshal(HashSequenceStart_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_HashSequenceStart_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_SequenceComplete
 TPM_RC
 TSS_SequenceComplete_Out_Unmarshal(SequenceComplete_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_SequenceComplete_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_EventSequenceComplete
 TPM_RC
 TSS_EventSequenceComplete_Out_Unmarshal(EventSequenceComplete_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_EventSequenceComplete_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Certify
 TPM_RC
 TSS_Certify_Out_Unmarshal(Certify_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Certify_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_CertifyCreation
 TPM_RC
 TSS_CertifyCreation_Out_Unmarshal(CertifyCreation_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_CertifyCreation_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Quote
 TPM_RC
 TSS_Quote_Out_Unmarshal(Quote_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Quote_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetSessionAuditDigest
 TPM_RC
 TSS_GetSessionAuditDigest_Out_Unmarshal(GetSessionAuditDigest_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_GetSessionAuditDigest_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetCommandAuditDigest
 TPM_RC
 TSS_GetCommandAuditDigest_Out_Unmarshal(GetCommandAuditDigest_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_GetCommandAuditDigest_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetTime
 TPM_RC
 TSS_GetTime_Out_Unmarshal(GetTime_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_GetTime_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Commit
 TPM_RC
 TSS_Commit_Out_Unmarshal(Commit_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Commit_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_EC_Ephemeral
 TPM_RC
 TSS_EC_Ephemeral_Out_Unmarshal(EC_Ephemeral_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_EC_Ephemeral_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_VerifySignature
 TPM_RC
 TSS_VerifySignature_Out_Unmarshal(VerifySignature_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_VerifySignature_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_Sign
 TPM_RC
 TSS_Sign_Out_Unmarshal(Sign_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_Sign_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_Event
 TPM_RC
 TSS_PCR_Event_Out_Unmarshal(PCR_Event_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_Event_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_Read
 TPM_RC
 TSS_PCR_Read_Out_Unmarshal(PCR_Read_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_Read_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PCR_Allocate
 TPM_RC
 TSS_PCR_Allocate_Out_Unmarshal(PCR_Allocate_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_PCR_Allocate_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicySigned
 TPM_RC
 TSS_PolicySigned_Out_Unmarshal(PolicySigned_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicySigned_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicySecret
 TPM_RC
 TSS_PolicySecret_Out_Unmarshal(PolicySecret_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicySecret_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_PolicyGetDigest
 TPM_RC
 TSS_PolicyGetDigest_Out_Unmarshal(PolicyGetDigest_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_PolicyGetDigest_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_CreatePrimary
 TPM_RC
 TSS_CreatePrimary_Out_Unmarshal(CreatePrimary_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_CreatePrimary_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ContextSave
 TPM_RC
 TSS_ContextSave_Out_Unmarshal(ContextSave_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ContextSave_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ContextLoad
 TPM_RC
 TSS_ContextLoad_Out_Unmarshal(ContextLoad_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ContextLoad_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_ReadClock
 TPM_RC
 TSS_ReadClock_Out_Unmarshal(ReadClock_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_ReadClock_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_GetCapability
 TPM_RC
 TSS_GetCapability_Out_Unmarshal(GetCapability_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_GetCapability_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_ReadPublic
 TPM_RC
 TSS_NV_ReadPublic_Out_Unmarshal(NV_ReadPublic_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_ReadPublic_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_Read
 TPM_RC
 TSS_NV_Read_Out_Unmarshal(NV_Read_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_Read_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
+#if CC_NV_Certify
 TPM_RC
 TSS_NV_Certify_Out_Unmarshal(NV_Certify_Out *target, TPM_ST tag, BYTE **buffer, int32_t *size)
 {
     return TSS_NV_Certify_Out_Unmarshalu(target, tag, buffer, (uint32_t *)size);
 }
+#endif
 
 #endif	/* TPM_TSS_NODEPRECATED */
 #endif /* TPM 2.0 */
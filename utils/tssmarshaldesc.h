@@ -0,0 +1,266 @@
+/********************************************************************************/
+/*										*/
+/*		    Descriptor Driven Marshal and Unmarshal			*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* Descriptor driven marshal and unmarshal.
+
+   A TPM 2.0 structure is described by a table of TSS_DESC_FIELD, in marshaling order, rather than
+   by a hand written pair of functions.  TSS_Desc_Marshalu() and TSS_Desc_Unmarshalu() interpret
+   the table.  The result is byte for byte identical to the chained calls that the table replaces,
+   including the response codes.
+
+   The field types are:
+
+   TSS_DESC_UINT8 to _UINT64	scalars.  The TSS does not value check TPMI_ALG_*, TPM_ST,
+				TPM_HANDLE, etc. on unmarshal (the TPM does), so these are plain
+				scalars.  For the same reason, the allowNull argument of the
+				TPMT_*_Unmarshalu() functions has no effect.
+   TSS_DESC_GENERATED		TPM_GENERATED, unmarshal checks TPM_GENERATED_VALUE
+   TSS_DESC_CHECK		a scalar whose unmarshal function checks the value, TPMA reserved
+				bits or a TPMI_RH_* handle range.  param is the scalar type,
+				flag the allowNull argument.
+   TSS_DESC_TPM2B		a TPM2B byte buffer.  param is the buffer capacity.
+   TSS_DESC_SELECT		sizeofSelect and a PCR bit map.  param is the maximum sizeofSelect,
+				array the offset of the bit map.
+   TSS_DESC_LIST		a TPML UINT32 count and array.  param is the maximum count, array
+				the offset of the array, desc the element.
+   TSS_DESC_UNION		a TPMU, marshaled by its hand written function.  param is the offset
+				of the selector, flag the size of the selector.
+   TSS_DESC_SIZE		the UINT16 size of a TPM2B wrapped structure.  The fields that
+				follow must unmarshal exactly that many bytes.  On marshal, the size
+				is back filled.  flag is YES if a zero size is allowed.
+   TSS_DESC_STRUCTURE		a nested structure, desc
+   TSS_DESC_PCR_SELECTION	TPML_PCR_SELECTION
+   TSS_DESC_PUBLIC		TPMT_PUBLIC
+
+   TPM2B, TPML_PCR_SELECTION, and TPMT_PUBLIC are the fast paths.  They are on nearly every
+   response and in every attestation, so the engine calls their specialized functions rather than
+   walking a table.
+
+   The TPMU unions, the TPMI and TPMA value checks, the tickets (tag check), TPML_DIGEST (minimum
+   count), and TPMT_PUBLIC_D (conditional TPMS_DERIVE) remain hand written.
+*/
+
+#ifndef TSSMARSHALDESC_H
+#define TSSMARSHALDESC_H
+
+#include <stddef.h>
+
+#include <ibmtss/TPM_Types.h>
+#include <ibmtss/tssutils.h>
+
+/* field types */
+
+#define TSS_DESC_UINT8		1
+#define TSS_DESC_UINT16		2
+#define TSS_DESC_UINT32		3
+#define TSS_DESC_UINT64		4
+#define TSS_DESC_GENERATED	5
+#define TSS_DESC_TPM2B		6
+#define TSS_DESC_PCR_SELECTION	7
+#define TSS_DESC_STRUCTURE	8
+#define TSS_DESC_CHECK		9
+#define TSS_DESC_SELECT		10
+#define TSS_DESC_LIST		11
+#define TSS_DESC_UNION		12
+#define TSS_DESC_SIZE		13
+#define TSS_DESC_PUBLIC		14
+
+/* TSS_DESC_CHECK flag */
+
+#define TSS_DESC_CHECK_PLAIN	0	/* the unmarshal function has no allowNull argument */
+#define TSS_DESC_CHECK_NO	1	/* allowNull NO */
+#define TSS_DESC_CHECK_YES	2	/* allowNull YES */
+
+/* generic function pointer, cast back to one of the below by field type */
+
+typedef void (*TSS_DescFunction_t)(void);
+
+typedef TPM_RC (*TSS_DescMarshalUnion_t)(const void *source, uint16_t *written,
+					 BYTE **buffer, uint32_t *size, uint32_t selector);
+typedef TPM_RC (*TSS_DescUnmarshalUnion_t)(void *target,
+					   BYTE **buffer, uint32_t *size, uint32_t selector);
+
+typedef struct TSS_DESC_STRUCT TSS_DESC_STRUCT;
+
+typedef struct {
+    uint8_t			type;
+    uint8_t			flag;
+    uint16_t			offset;		/* offsetof() the member */
+    uint16_t			param;
+    uint16_t			array;
+    const TSS_DESC_STRUCT	*desc;
+    TSS_DescFunction_t		marshal;	/* TSS_DESC_UNION */
+    TSS_DescFunction_t		unmarshal;	/* TSS_DESC_CHECK, TSS_DESC_UNION */
+} TSS_DESC_FIELD;
+
+struct TSS_DESC_STRUCT {
+    const TSS_DESC_FIELD	*fields;
+    uint16_t			fieldCount;
+    uint32_t			size;		/* sizeof() the structure, for TSS_DESC_LIST */
+};
+
+/* field initializers */
+
+#define TSS_DESC_MEMBER_SIZE(structure, member)	sizeof(((structure *)NULL)->member)
+
+#define TSS_DESC_SCALAR(type, structure, member)				\
+    {type, 0, offsetof(structure, member), 0, 0, NULL, NULL, NULL}
+#define TSS_DESC_CHECKED(type, structure, member, function)			\
+    {TSS_DESC_CHECK, TSS_DESC_CHECK_PLAIN, offsetof(structure, member), type, 0,	\
+	    NULL, NULL, (TSS_DescFunction_t)function}
+#define TSS_DESC_CHECKED_NULL(type, structure, member, function, allowNull)	\
+    {TSS_DESC_CHECK, (allowNull) ? TSS_DESC_CHECK_YES : TSS_DESC_CHECK_NO,	\
+	    offsetof(structure, member), type, 0, NULL, NULL, (TSS_DescFunction_t)function}
+#define TSS_DESC_2B(structure, member, array)					\
+    {TSS_DESC_TPM2B, 0, offsetof(structure, member),				\
+	    TSS_DESC_MEMBER_SIZE(structure, member.t.array), 0, NULL, NULL, NULL}
+#define TSS_DESC_SELECTION(structure, sizeofSelect, select, max)		\
+    {TSS_DESC_SELECT, 0, offsetof(structure, sizeofSelect), max,		\
+	    offsetof(structure, select), NULL, NULL, NULL}
+#define TSS_DESC_ARRAY(structure, count, array, max, desc)			\
+    {TSS_DESC_LIST, 0, offsetof(structure, count), max,			\
+	    offsetof(structure, array), &desc, NULL, NULL}
+#define TSS_DESC_SELECTED(structure, member, selector, marshal, unmarshal)	\
+    {TSS_DESC_UNION, TSS_DESC_MEMBER_SIZE(structure, selector),			\
+	    offsetof(structure, member), offsetof(structure, selector), 0, NULL,	\
+	    (TSS_DescFunction_t)marshal, (TSS_DescFunction_t)unmarshal}
+#define TSS_DESC_SIZED(structure, member, allowEmpty)				\
+    {TSS_DESC_SIZE, allowEmpty, offsetof(structure, member), 0, 0, NULL, NULL, NULL}
+#define TSS_DESC_NESTED(structure, member, desc)				\
+    {TSS_DESC_STRUCTURE, 0, offsetof(structure, member), 0, 0, &desc, NULL, NULL}
+
+/* a TSS_DESC_LIST element that is a scalar rather than a structure */
+
+#define TSS_DESC_ELEMENT(type)							\
+    {type, 0, 0, 0, 0, NULL, NULL, NULL}
+#define TSS_DESC_CHECKED_ELEMENT(type, function)				\
+    {TSS_DESC_CHECK, TSS_DESC_CHECK_PLAIN, 0, type, 0, NULL, NULL, (TSS_DescFunction_t)function}
+
+#define TSS_DESC_DEFINE(name, structure, fields)				\
+    const TSS_DESC_STRUCT name = {fields, sizeof(fields) / sizeof(TSS_DESC_FIELD), sizeof(structure)}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    TPM_RC TSS_Desc_Marshalu(const void *source,
+			     const TSS_DESC_STRUCT *desc,
+			     uint16_t *written,
+			     BYTE **buffer,
+			     uint32_t *size);
+    TPM_RC TSS_Desc_Unmarshalu(void *target,
+			       const TSS_DESC_STRUCT *desc,
+			       BYTE **buffer,
+			       uint32_t *size);
+
+    /* structure descriptors, in tssmarshal.c */
+
+    extern const TSS_DESC_STRUCT tssDescTPMT_HA;
+    extern const TSS_DESC_STRUCT tssDescTPMS_PCR_SELECTION;
+    extern const TSS_DESC_STRUCT tssDescTPMS_ALG_PROPERTY;
+    extern const TSS_DESC_STRUCT tssDescTPMS_TAGGED_PROPERTY;
+    extern const TSS_DESC_STRUCT tssDescTPMS_TAGGED_PCR_SELECT;
+    extern const TSS_DESC_STRUCT tssDescTPMS_TAGGED_POLICY;
+    extern const TSS_DESC_STRUCT tssDescTPMS_ACT_DATA;
+    extern const TSS_DESC_STRUCT tssDescTPML_CC;
+    extern const TSS_DESC_STRUCT tssDescTPML_CCA;
+    extern const TSS_DESC_STRUCT tssDescTPML_ALG;
+    extern const TSS_DESC_STRUCT tssDescTPML_HANDLE;
+    extern const TSS_DESC_STRUCT tssDescTPML_DIGEST_VALUES;
+    extern const TSS_DESC_STRUCT tssDescTPML_ALG_PROPERTY;
+    extern const TSS_DESC_STRUCT tssDescTPML_TAGGED_TPM_PROPERTY;
+    extern const TSS_DESC_STRUCT tssDescTPML_TAGGED_PCR_PROPERTY;
+    extern const TSS_DESC_STRUCT tssDescTPML_ECC_CURVE;
+    extern const TSS_DESC_STRUCT tssDescTPML_TAGGED_POLICY;
+    extern const TSS_DESC_STRUCT tssDescTPML_ACT_DATA;
+    extern const TSS_DESC_STRUCT tssDescTPMS_CAPABILITY_DATA;
+    extern const TSS_DESC_STRUCT tssDescTPMS_CLOCK_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_TIME_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_TIME_ATTEST_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_CERTIFY_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_QUOTE_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_COMMAND_AUDIT_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_SESSION_AUDIT_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_CREATION_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_NV_CERTIFY_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_NV_DIGEST_CERTIFY_INFO;
+    extern const TSS_DESC_STRUCT tssDescTPMS_ATTEST;
+    extern const TSS_DESC_STRUCT tssDescTPMS_AUTH_COMMAND;
+    extern const TSS_DESC_STRUCT tssDescTPMS_AUTH_RESPONSE;
+    extern const TSS_DESC_STRUCT tssDescTPMT_SYM_DEF;
+    extern const TSS_DESC_STRUCT tssDescTPMT_SYM_DEF_OBJECT;
+    extern const TSS_DESC_STRUCT tssDescTPMS_SYMCIPHER_PARMS;
+    extern const TSS_DESC_STRUCT tssDescTPMS_DERIVE;
+    extern const TSS_DESC_STRUCT tssDescTPMS_SENSITIVE_CREATE;
+    extern const TSS_DESC_STRUCT tssDescTPM2B_SENSITIVE_CREATE;
+    extern const TSS_DESC_STRUCT tssDescTPMS_SCHEME_HASH;
+    extern const TSS_DESC_STRUCT tssDescTPMS_SCHEME_ECDAA;
+    extern const TSS_DESC_STRUCT tssDescTPMS_SCHEME_XOR;
+    extern const TSS_DESC_STRUCT tssDescTPMT_KEYEDHASH_SCHEME;
+    extern const TSS_DESC_STRUCT tssDescTPMT_SIG_SCHEME;
+    extern const TSS_DESC_STRUCT tssDescTPMT_KDF_SCHEME;
+    extern const TSS_DESC_STRUCT tssDescTPMT_ASYM_SCHEME;
+    extern const TSS_DESC_STRUCT tssDescTPMT_RSA_SCHEME;
+    extern const TSS_DESC_STRUCT tssDescTPMT_RSA_DECRYPT;
+    extern const TSS_DESC_STRUCT tssDescTPMS_ECC_POINT;
+    extern const TSS_DESC_STRUCT tssDescTPM2B_ECC_POINT;
+    extern const TSS_DESC_STRUCT tssDescTPMT_ECC_SCHEME;
+    extern const TSS_DESC_STRUCT tssDescTPMS_ALGORITHM_DETAIL_ECC;
+    extern const TSS_DESC_STRUCT tssDescTPMS_SIGNATURE_RSA;
+    extern const TSS_DESC_STRUCT tssDescTPMS_SIGNATURE_ECC;
+    extern const TSS_DESC_STRUCT tssDescTPMT_SIGNATURE;
+    extern const TSS_DESC_STRUCT tssDescTPMS_KEYEDHASH_PARMS;
+    extern const TSS_DESC_STRUCT tssDescTPMS_ASYM_PARMS;
+    extern const TSS_DESC_STRUCT tssDescTPMS_RSA_PARMS;
+    extern const TSS_DESC_STRUCT tssDescTPMS_ECC_PARMS;
+    extern const TSS_DESC_STRUCT tssDescTPMT_PUBLIC_PARMS;
+    extern const TSS_DESC_STRUCT tssDescTPMT_PUBLIC;
+    extern const TSS_DESC_STRUCT tssDescTPM2B_PUBLIC;
+    extern const TSS_DESC_STRUCT tssDescTPMT_SENSITIVE;
+    extern const TSS_DESC_STRUCT tssDescTPM2B_SENSITIVE;
+    extern const TSS_DESC_STRUCT tssDescTPMS_NV_PUBLIC;
+    extern const TSS_DESC_STRUCT tssDescTPM2B_NV_PUBLIC;
+    extern const TSS_DESC_STRUCT tssDescTPMS_CONTEXT_DATA;
+    extern const TSS_DESC_STRUCT tssDescTPMS_CONTEXT;
+    extern const TSS_DESC_STRUCT tssDescTPMS_CREATION_DATA;
+    extern const TSS_DESC_STRUCT tssDescTPM2B_CREATION_DATA;
+#ifdef __cplusplus
+}
+#endif
+
+#endif
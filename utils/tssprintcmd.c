@@ -42,6 +42,7 @@
 
 #include <ibmtss/tssprintcmd.h>
 
+#if CC_ActivateCredential
 void ActivateCredential_In_Print(ActivateCredential_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ActivateCredential\n", indent, "");
@@ -51,6 +52,8 @@ void ActivateCredential_In_Print(ActivateCredential_In *in, unsigned int indent)
     TSS_TPM2B_Print("TPM2B_ENCRYPTED_SECRET secret", indent, &in->secret.b);
     return;
 }
+#endif
+#if CC_CertifyCreation
 void CertifyCreation_In_Print(CertifyCreation_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_CertifyCreation\n", indent, "");
@@ -64,6 +67,8 @@ void CertifyCreation_In_Print(CertifyCreation_In *in, unsigned int indent)
     TSS_TPMT_TK_CREATION_Print(&in->creationTicket, indent+2);
     return;
 }
+#endif
+#if CC_Certify
 void Certify_In_Print(Certify_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Certify\n", indent, "");
@@ -74,6 +79,8 @@ void Certify_In_Print(Certify_In *in, unsigned int indent)
     TSS_TPMT_SIG_SCHEME_Print(&in->inScheme, indent);
     return;
 }
+#endif
+#if CC_CertifyX509
 void CertifyX509_In_Print(CertifyX509_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_CertifyX509\n", indent, "");
@@ -85,18 +92,24 @@ void CertifyX509_In_Print(CertifyX509_In *in, unsigned int indent)
     TSS_TPM2B_Print("partialCertificate", indent, &in->partialCertificate.b);
     return;
 }
+#endif
+#if CC_ChangeEPS
 void ChangeEPS_In_Print(ChangeEPS_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ChangeEPS\n", indent, "");
     TSS_TPM_HANDLE_Print("authHandle", in->authHandle, indent);
     return;
 }
+#endif
+#if CC_ChangePPS
 void ChangePPS_In_Print(ChangePPS_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ChangePPS\n", indent, "");
     TSS_TPM_HANDLE_Print("authHandle", in->authHandle, indent);
     return;
 }
+#endif
+#if CC_ClearControl
 void ClearControl_In_Print(ClearControl_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ClearControl\n", indent, "");
@@ -104,12 +117,16 @@ void ClearControl_In_Print(ClearControl_In *in, unsigned int indent)
     TSS_TPMI_YES_NO_Print("disable", in->disable, indent);
     return;
 }
+#endif
+#if CC_Clear
 void Clear_In_Print(Clear_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Clear\n", indent, "");
     TSS_TPM_HANDLE_Print("authHandle", in->authHandle, indent);
     return;
 }
+#endif
+#if CC_ClockRateAdjust
 void ClockRateAdjust_In_Print(ClockRateAdjust_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ClockRateAdjust\n", indent, "");
@@ -117,6 +134,8 @@ void ClockRateAdjust_In_Print(ClockRateAdjust_In *in, unsigned int indent)
     TSS_TPM_CLOCK_ADJUST_Print("rateAdjust", in->rateAdjust, indent);
     return;
 }
+#endif
+#if CC_ClockSet
 void ClockSet_In_Print(ClockSet_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ClockSet\n", indent, "");
@@ -124,6 +143,8 @@ void ClockSet_In_Print(ClockSet_In *in, unsigned int indent)
     printf("%*s" "newTime %"PRIu64"\n", indent, "", in->newTime);
     return;
 }
+#endif
+#if CC_Commit
 void Commit_In_Print(Commit_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Commit\n", indent, "");
@@ -133,18 +154,24 @@ void Commit_In_Print(Commit_In *in, unsigned int indent)
     TSS_TPM2B_Print("y2", indent, &in->y2.b);
     return;
 }
+#endif
+#if CC_ContextLoad
 void ContextLoad_In_Print(ContextLoad_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ContextLoad\n", indent, "");
     TSS_TPMS_CONTEXT_Print(&in->context, indent);
     return;
 }
+#endif
+#if CC_ContextSave
 void ContextSave_In_Print(ContextSave_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ContextSave\n", indent, "");
     TSS_TPM_HANDLE_Print("saveHandle", in->saveHandle, indent);
     return;
 }
+#endif
+#if CC_Create
 void Create_In_Print(Create_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Create\n", indent, "");
@@ -155,6 +182,8 @@ void Create_In_Print(Create_In *in, unsigned int indent)
     TSS_TPML_PCR_SELECTION_Print(&in->creationPCR, indent);
     return;
 }
+#endif
+#if CC_CreateLoaded
 void CreateLoaded_In_Print(CreateLoaded_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_CreateLoaded\n", indent, "");
@@ -163,6 +192,8 @@ void CreateLoaded_In_Print(CreateLoaded_In *in, unsigned int indent)
     TSS_TPM2B_Print("inPublic", indent, &in->inPublic.b);
     return;
 }
+#endif
+#if CC_CreatePrimary
 void CreatePrimary_In_Print(CreatePrimary_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_CreatePrimary\n", indent, "");
@@ -173,12 +204,16 @@ void CreatePrimary_In_Print(CreatePrimary_In *in, unsigned int indent)
     TSS_TPML_PCR_SELECTION_Print(&in->creationPCR, indent);
     return;
 }
+#endif
+#if CC_DictionaryAttackLockReset
 void DictionaryAttackLockReset_In_Print(DictionaryAttackLockReset_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_DictionaryAttackLockReset\n", indent, "");
     TSS_TPM_HANDLE_Print("lockHandle", in->lockHandle, indent);
     return;
 }
+#endif
+#if CC_DictionaryAttackParameters
 void DictionaryAttackParameters_In_Print(DictionaryAttackParameters_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_DictionaryAttackParameters\n", indent, "");
@@ -188,6 +223,8 @@ void DictionaryAttackParameters_In_Print(DictionaryAttackParameters_In *in, unsi
     printf("%*s" "lockoutRecovery %u\n", indent, "", in->lockoutRecovery);
     return;
 }
+#endif
+#if CC_Duplicate
 void Duplicate_In_Print(Duplicate_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Duplicate\n", indent, "");
@@ -198,6 +235,8 @@ void Duplicate_In_Print(Duplicate_In *in, unsigned int indent)
     TSS_TPMT_SYM_DEF_OBJECT_Print(&in->symmetricAlg, indent);
     return;
 }
+#endif
+#if CC_ECC_Encrypt
 void ECC_Encrypt_In_Print(ECC_Encrypt_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ECC_Encrypt\n", indent, "");
@@ -205,6 +244,8 @@ void ECC_Encrypt_In_Print(ECC_Encrypt_In *in, unsigned int indent)
     TSS_TPMT_KDF_SCHEME_Print(&in->inScheme, indent);
     return;
 }
+#endif
+#if CC_ECC_Decrypt
 void ECC_Decrypt_In_Print(ECC_Decrypt_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ECC_Decrypt\n", indent, "");
@@ -214,18 +255,24 @@ void ECC_Decrypt_In_Print(ECC_Decrypt_In *in, unsigned int indent)
     TSS_TPMT_KDF_SCHEME_Print(&in->inScheme, indent);
     return;
 }
+#endif
+#if CC_ECC_Parameters
 void ECC_Parameters_In_Print(ECC_Parameters_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ECC_Parameters\n", indent, "");
     TSS_TPMI_ECC_CURVE_Print("curveID", in->curveID, indent);
     return;
 }
+#endif
+#if CC_ECDH_KeyGen
 void ECDH_KeyGen_In_Print(ECDH_KeyGen_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ECDH_KeyGen\n", indent, "");
     TSS_TPM_HANDLE_Print("keyHandle", in->keyHandle, indent);
     return;
 }
+#endif
+#if CC_ECDH_ZGen
 void ECDH_ZGen_In_Print(ECDH_ZGen_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ECDH_ZGen\n", indent, "");
@@ -233,12 +280,16 @@ void ECDH_ZGen_In_Print(ECDH_ZGen_In *in, unsigned int indent)
     TSS_TPM2B_ECC_POINT_Print("inPoint", &in->inPoint, indent);
     return;
 }
+#endif
+#if CC_EC_Ephemeral
 void EC_Ephemeral_In_Print(EC_Ephemeral_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_EC_Ephemeral\n", indent, "");
     TSS_TPMI_ECC_CURVE_Print("curveID", in->curveID, indent);
     return;
 }
+#endif
+#if CC_EncryptDecrypt
 void EncryptDecrypt_In_Print(EncryptDecrypt_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_EncryptDecrypt\n", indent, "");
@@ -249,6 +300,8 @@ void EncryptDecrypt_In_Print(EncryptDecrypt_In *in, unsigned int indent)
     TSS_TPM2B_Print("inData", indent, &in->inData.b);
     return;
 }
+#endif
+#if CC_EncryptDecrypt2
 void EncryptDecrypt2_In_Print(EncryptDecrypt2_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_EncryptDecrypt2\n", indent, "");
@@ -259,6 +312,8 @@ void EncryptDecrypt2_In_Print(EncryptDecrypt2_In *in, unsigned int indent)
     TSS_TPM2B_Print("ivIn", indent, &in->ivIn.b);
     return;
 }
+#endif
+#if CC_EventSequenceComplete
 void EventSequenceComplete_In_Print(EventSequenceComplete_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_EventSequenceComplete\n", indent, "");
@@ -267,6 +322,8 @@ void EventSequenceComplete_In_Print(EventSequenceComplete_In *in, unsigned int i
     TSS_TPM2B_Print("buffer", indent, &in->buffer.b);
     return;
 }
+#endif
+#if CC_EvictControl
 void EvictControl_In_Print(EvictControl_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_EvictControl\n", indent, "");
@@ -275,12 +332,16 @@ void EvictControl_In_Print(EvictControl_In *in, unsigned int indent)
     TSS_TPM_HANDLE_Print("persistentHandle", in->persistentHandle, indent);
     return;
 }
+#endif
+#if CC_FlushContext
 void FlushContext_In_Print(FlushContext_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_FlushContext\n", indent, "");
     TSS_TPM_HANDLE_Print("flushHandle", in->flushHandle, indent);
     return;
 }
+#endif
+#if CC_GetCapability
 void GetCapability_In_Print(GetCapability_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_GetCapability\n", indent, "");
@@ -289,6 +350,8 @@ void GetCapability_In_Print(GetCapability_In *in, unsigned int indent)
     printf("%*s" "propertyCount %u\n", indent, "", in->propertyCount);
     return;
 }
+#endif
+#if CC_GetCommandAuditDigest
 void GetCommandAuditDigest_In_Print(GetCommandAuditDigest_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_GetCommandAuditDigest\n", indent, "");
@@ -299,12 +362,16 @@ void GetCommandAuditDigest_In_Print(GetCommandAuditDigest_In *in, unsigned int i
     TSS_TPMT_SIG_SCHEME_Print(&in->inScheme, indent);
     return;
 }
+#endif
+#if CC_GetRandom
 void GetRandom_In_Print(GetRandom_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_GetRandom\n", indent, "");
     printf("%*s" "bytesRequested %u\n", indent, "", in->bytesRequested);
     return;
 }
+#endif
+#if CC_GetSessionAuditDigest
 void GetSessionAuditDigest_In_Print(GetSessionAuditDigest_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_GetSessionAuditDigest\n", indent, "");
@@ -316,6 +383,8 @@ void GetSessionAuditDigest_In_Print(GetSessionAuditDigest_In *in, unsigned int i
     TSS_TPMT_SIG_SCHEME_Print(&in->inScheme, indent);
     return;
 }
+#endif
+#if CC_GetTime
 void GetTime_In_Print(GetTime_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_GetTime\n", indent, "");
@@ -326,6 +395,8 @@ void GetTime_In_Print(GetTime_In *in, unsigned int indent)
     TSS_TPMT_SIG_SCHEME_Print(&in->inScheme, indent);
     return;
 }
+#endif
+#if CC_HMAC_Start
 void HMAC_Start_In_Print(HMAC_Start_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_HMAC_Start\n", indent, "");
@@ -334,6 +405,8 @@ void HMAC_Start_In_Print(HMAC_Start_In *in, unsigned int indent)
     TSS_TPM_ALG_ID_Print("hashAlg", in->hashAlg, indent);
     return;
 }
+#endif
+#if CC_HMAC
 void HMAC_In_Print(HMAC_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_HMAC\n", indent, "");
@@ -342,6 +415,8 @@ void HMAC_In_Print(HMAC_In *in, unsigned int indent)
     TSS_TPM_ALG_ID_Print("hashAlg", in->hashAlg, indent);
     return;
 }
+#endif
+#if CC_HashSequenceStart
 void HashSequenceStart_In_Print(HashSequenceStart_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_HashSequenceStart\n", indent, "");
@@ -349,6 +424,8 @@ void HashSequenceStart_In_Print(HashSequenceStart_In *in, unsigned int indent)
     TSS_TPM_ALG_ID_Print("hashAlg", in->hashAlg, indent);
     return;
 }
+#endif
+#if CC_Hash
 void Hash_In_Print(Hash_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Hash\n", indent, "");
@@ -357,6 +434,8 @@ void Hash_In_Print(Hash_In *in, unsigned int indent)
     TSS_TPM_HANDLE_Print("hierarchy", in->hierarchy, indent);
     return;
 }
+#endif
+#if CC_HierarchyChangeAuth
 void HierarchyChangeAuth_In_Print(HierarchyChangeAuth_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_HierarchyChangeAuth\n", indent, "");
@@ -364,6 +443,8 @@ void HierarchyChangeAuth_In_Print(HierarchyChangeAuth_In *in, unsigned int inden
     TSS_TPM2B_Print("newAuth", indent, &in->newAuth.b);
     return;
 }
+#endif
+#if CC_HierarchyControl
 void HierarchyControl_In_Print(HierarchyControl_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_HierarchyControl\n", indent, "");
@@ -372,6 +453,8 @@ void HierarchyControl_In_Print(HierarchyControl_In *in, unsigned int indent)
     TSS_TPMI_YES_NO_Print("state", in->state, indent);
     return;
 }
+#endif
+#if CC_Import
 void Import_In_Print(Import_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Import\n", indent, "");
@@ -384,12 +467,16 @@ void Import_In_Print(Import_In *in, unsigned int indent)
     TSS_TPMT_SYM_DEF_OBJECT_Print(&in->symmetricAlg, indent);
     return;
 }
+#endif
+#if CC_IncrementalSelfTest
 void IncrementalSelfTest_In_Print(IncrementalSelfTest_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_IncrementalSelfTest\n", indent, "");
     TSS_TPML_ALG_Print(&in->toTest, indent);
     return;
 }
+#endif
+#if CC_LoadExternal
 void LoadExternal_In_Print(LoadExternal_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_LoadExternal\n", indent, "");
@@ -400,6 +487,8 @@ void LoadExternal_In_Print(LoadExternal_In *in, unsigned int indent)
     TSS_TPM_HANDLE_Print("hierarchy", in->hierarchy, indent);
     return;
 }
+#endif
+#if CC_Load
 void Load_In_Print(Load_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Load\n", indent, "");
@@ -408,6 +497,8 @@ void Load_In_Print(Load_In *in, unsigned int indent)
     TSS_TPM2B_PUBLIC_Print("inPublic", &in->inPublic, indent);
     return;
 }
+#endif
+#if CC_MakeCredential
 void MakeCredential_In_Print(MakeCredential_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_MakeCredential\n", indent, "");
@@ -416,7 +507,9 @@ void MakeCredential_In_Print(MakeCredential_In *in, unsigned int indent)
     TSS_TPM2B_Print("objectName", indent, &in->objectName.b);
     return;
 }
+#endif
 #if 0
+#if CC_NTC2_PreConfig
 void NTC2_PreConfig_In_Print(NTC2_PreConfig_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NTC2_PreConfig\n", indent, "");
@@ -424,6 +517,8 @@ void NTC2_PreConfig_In_Print(NTC2_PreConfig_In *in, unsigned int indent)
     return;
 }
 #endif
+#endif
+#if CC_NV_Certify
 void NV_Certify_In_Print(NV_Certify_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_Certify\n", indent, "");
@@ -437,6 +532,8 @@ void NV_Certify_In_Print(NV_Certify_In *in, unsigned int indent)
     printf("%*s" "offset %u\n", indent, "", in->offset);
     return;
 }
+#endif
+#if CC_NV_ChangeAuth
 void NV_ChangeAuth_In_Print(NV_ChangeAuth_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_ChangeAuth\n", indent, "");
@@ -444,6 +541,8 @@ void NV_ChangeAuth_In_Print(NV_ChangeAuth_In *in, unsigned int indent)
     TSS_TPM2B_Print("newAuth", indent, &in->newAuth.b);
     return;
 }
+#endif
+#if CC_NV_DefineSpace
 void NV_DefineSpace_In_Print(NV_DefineSpace_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_DefineSpace\n", indent, "");
@@ -453,6 +552,8 @@ void NV_DefineSpace_In_Print(NV_DefineSpace_In *in, unsigned int indent)
     TSS_TPM2B_NV_PUBLIC_Print(&in->publicInfo, indent);
     return;
 }
+#endif
+#if CC_NV_Extend
 void NV_Extend_In_Print(NV_Extend_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_Extend\n", indent, "");
@@ -461,12 +562,16 @@ void NV_Extend_In_Print(NV_Extend_In *in, unsigned int indent)
     TSS_TPM2B_Print("data", indent, &in->data.b);
     return;
 }
+#endif
+#if CC_NV_GlobalWriteLock
 void NV_GlobalWriteLock_In_Print(NV_GlobalWriteLock_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_GlobalWriteLock\n", indent, "");
     TSS_TPM_HANDLE_Print("authHandle", in->authHandle, indent);
     return;
 }
+#endif
+#if CC_NV_Increment
 void NV_Increment_In_Print(NV_Increment_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_Increment\n", indent, "");
@@ -474,6 +579,8 @@ void NV_Increment_In_Print(NV_Increment_In *in, unsigned int indent)
     TSS_TPM_HANDLE_Print("nvIndex", in->nvIndex, indent);
     return;
 }
+#endif
+#if CC_NV_ReadLock
 void NV_ReadLock_In_Print(NV_ReadLock_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_ReadLock\n", indent, "");
@@ -481,12 +588,16 @@ void NV_ReadLock_In_Print(NV_ReadLock_In *in, unsigned int indent)
     TSS_TPM_HANDLE_Print("nvIndex", in->nvIndex, indent);
     return;
 }
+#endif
+#if CC_NV_ReadPublic
 void NV_ReadPublic_In_Print(NV_ReadPublic_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_ReadPublic\n", indent, "");
     TSS_TPM_HANDLE_Print("nvIndex", in->nvIndex, indent);
     return;
 }
+#endif
+#if CC_NV_Read
 void NV_Read_In_Print(NV_Read_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_Read\n", indent, "");
@@ -496,6 +607,8 @@ void NV_Read_In_Print(NV_Read_In *in, unsigned int indent)
     printf("%*s" "offset %u\n", indent, "", in->offset);
     return;
 }
+#endif
+#if CC_NV_SetBits
 void NV_SetBits_In_Print(NV_SetBits_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_SetBits\n", indent, "");
@@ -504,6 +617,8 @@ void NV_SetBits_In_Print(NV_SetBits_In *in, unsigned int indent)
     printf("%*s" "bits %016"PRIx64"\n", indent, "", in->bits);
     return;
 }
+#endif
+#if CC_NV_UndefineSpaceSpecial
 void NV_UndefineSpaceSpecial_In_Print(NV_UndefineSpaceSpecial_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_UndefineSpaceSpecial\n", indent, "");
@@ -511,6 +626,8 @@ void NV_UndefineSpaceSpecial_In_Print(NV_UndefineSpaceSpecial_In *in, unsigned i
     TSS_TPM_HANDLE_Print("platform", in->platform, indent);
     return;
 }
+#endif
+#if CC_NV_UndefineSpace
 void NV_UndefineSpace_In_Print(NV_UndefineSpace_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_UndefineSpace\n", indent, "");
@@ -525,6 +642,8 @@ void NV_WriteLock_In_Print(NV_WriteLock_In *in, unsigned int indent)
     TSS_TPM_HANDLE_Print("nvIndex", in->nvIndex, indent);
     return;
 }
+#endif
+#if CC_NV_Write
 void NV_Write_In_Print(NV_Write_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_NV_Write\n", indent, "");
@@ -534,6 +653,8 @@ void NV_Write_In_Print(NV_Write_In *in, unsigned int indent)
     printf("%*s" "offset %u\n", indent, "", in->offset);
     return;
 }
+#endif
+#if CC_ObjectChangeAuth
 void ObjectChangeAuth_In_Print(ObjectChangeAuth_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ObjectChangeAuth\n", indent, "");
@@ -542,6 +663,8 @@ void ObjectChangeAuth_In_Print(ObjectChangeAuth_In *in, unsigned int indent)
     TSS_TPM2B_Print("newAuth", indent, &in->newAuth.b);
     return;
 }
+#endif
+#if CC_PCR_Allocate
 void PCR_Allocate_In_Print(PCR_Allocate_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PCR_Allocate\n", indent, "");
@@ -549,6 +672,8 @@ void PCR_Allocate_In_Print(PCR_Allocate_In *in, unsigned int indent)
     TSS_TPML_PCR_SELECTION_Print(&in->pcrAllocation, indent);
     return;
 }
+#endif
+#if CC_PCR_Event
 void PCR_Event_In_Print(PCR_Event_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PCR_Event\n", indent, "");
@@ -556,6 +681,8 @@ void PCR_Event_In_Print(PCR_Event_In *in, unsigned int indent)
     TSS_TPM2B_Print("eventData", indent, &in->eventData.b);
     return;
 }
+#endif
+#if CC_PCR_Extend
 void PCR_Extend_In_Print(PCR_Extend_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PCR_Extend\n", indent, "");
@@ -563,18 +690,24 @@ void PCR_Extend_In_Print(PCR_Extend_In *in, unsigned int indent)
     TSS_TPML_DIGEST_VALUES_Print(&in->digests, indent);
     return;
 }
+#endif
+#if CC_PCR_Read
 void PCR_Read_In_Print(PCR_Read_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PCR_Read\n", indent, "");
     TSS_TPML_PCR_SELECTION_Print(&in->pcrSelectionIn, indent);
     return;
 }
+#endif
+#if CC_PCR_Reset
 void PCR_Reset_In_Print(PCR_Reset_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PCR_Reset\n", indent, "");
     TSS_TPM_HANDLE_Print("pcrHandle", in->pcrHandle, indent);
     return;
 }
+#endif
+#if CC_PCR_SetAuthPolicy
 void PCR_SetAuthPolicy_In_Print(PCR_SetAuthPolicy_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PCR_SetAuthPolicy\n", indent, "");
@@ -584,6 +717,8 @@ void PCR_SetAuthPolicy_In_Print(PCR_SetAuthPolicy_In *in, unsigned int indent)
     TSS_TPM_HANDLE_Print("pcrNum", in->pcrNum, indent);
     return;
 }
+#endif
+#if CC_PCR_SetAuthValue
 void PCR_SetAuthValue_In_Print(PCR_SetAuthValue_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PCR_SetAuthValue\n", indent, "");
@@ -591,6 +726,8 @@ void PCR_SetAuthValue_In_Print(PCR_SetAuthValue_In *in, unsigned int indent)
     TSS_TPM2B_Print("auth", indent, &in->auth.b);
     return;
 }
+#endif
+#if CC_PP_Commands
 void PP_Commands_In_Print(PP_Commands_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PP_Commands\n", indent, "");
@@ -599,12 +736,16 @@ void PP_Commands_In_Print(PP_Commands_In *in, unsigned int indent)
     TSS_TPML_CC_Print(&in->clearList, indent);
     return;
 }
+#endif
+#if CC_PolicyAuthValue
 void PolicyAuthValue_In_Print(PolicyAuthValue_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyAuthValue\n", indent, "");
     TSS_TPM_HANDLE_Print("policySession", in->policySession, indent);
     return;
 }
+#endif
+#if CC_PolicyAuthorizeNV
 void PolicyAuthorizeNV_In_Print(PolicyAuthorizeNV_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyAuthorizeNV\n", indent, "");
@@ -613,6 +754,8 @@ void PolicyAuthorizeNV_In_Print(PolicyAuthorizeNV_In *in, unsigned int indent)
     TSS_TPM_HANDLE_Print("policySession", in->policySession, indent);
     return;
 }
+#endif
+#if CC_PolicyAuthorize
 void PolicyAuthorize_In_Print(PolicyAuthorize_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyAuthorize\n", indent, "");
@@ -624,6 +767,8 @@ void PolicyAuthorize_In_Print(PolicyAuthorize_In *in, unsigned int indent)
     TSS_TPMT_TK_VERIFIED_Print(&in->checkTicket, indent+2);
     return;
 }
+#endif
+#if CC_PolicyCommandCode
 void PolicyCommandCode_In_Print(PolicyCommandCode_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyCommandCode\n", indent, "");
@@ -631,6 +776,8 @@ void PolicyCommandCode_In_Print(PolicyCommandCode_In *in, unsigned int indent)
     TSS_TPM_CC_Print("code", in->code, indent);
     return;
 }
+#endif
+#if CC_PolicyCounterTimer
 void PolicyCounterTimer_In_Print(PolicyCounterTimer_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyCounterTimer\n", indent, "");
@@ -640,6 +787,8 @@ void PolicyCounterTimer_In_Print(PolicyCounterTimer_In *in, unsigned int indent)
     TSS_TPM_EO_Print("operation", in->operation, indent);
     return;
 }
+#endif
+#if CC_PolicyCpHash
 void PolicyCpHash_In_Print(PolicyCpHash_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyCpHash\n", indent, "");
@@ -647,6 +796,8 @@ void PolicyCpHash_In_Print(PolicyCpHash_In *in, unsigned int indent)
     TSS_TPM2B_Print("cpHashA", indent, &in->cpHashA.b);
     return;
 }
+#endif
+#if CC_PolicyDuplicationSelect
 void PolicyDuplicationSelect_In_Print(PolicyDuplicationSelect_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyDuplicationSelect\n", indent, "");
@@ -656,12 +807,16 @@ void PolicyDuplicationSelect_In_Print(PolicyDuplicationSelect_In *in, unsigned i
     TSS_TPMI_YES_NO_Print("includeObject", in->includeObject, indent);
     return;
 }
+#endif
+#if CC_PolicyGetDigest
 void PolicyGetDigest_In_Print(PolicyGetDigest_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyGetDigest\n", indent, "");
     TSS_TPM_HANDLE_Print("policySession", in->policySession, indent);
     return;
 }
+#endif
+#if CC_PolicyLocality
 void PolicyLocality_In_Print(PolicyLocality_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyLocality\n", indent, "");
@@ -669,6 +824,8 @@ void PolicyLocality_In_Print(PolicyLocality_In *in, unsigned int indent)
     TSS_TPMA_LOCALITY_Print(in->locality, indent);
     return;
 }
+#endif
+#if CC_PolicyNV
 void PolicyNV_In_Print(PolicyNV_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyNV\n", indent, "");
@@ -680,6 +837,8 @@ void PolicyNV_In_Print(PolicyNV_In *in, unsigned int indent)
     TSS_TPM_EO_Print("operation", in->operation, indent);
     return;
 }
+#endif
+#if CC_PolicyNameHash
 void PolicyNameHash_In_Print(PolicyNameHash_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyNameHash\n", indent, "");
@@ -687,6 +846,8 @@ void PolicyNameHash_In_Print(PolicyNameHash_In *in, unsigned int indent)
     TSS_TPM2B_Print("nameHash", indent, &in->nameHash.b);
     return;
 }
+#endif
+#if CC_PolicyNvWritten
 void PolicyNvWritten_In_Print(PolicyNvWritten_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyNvWritten\n", indent, "");
@@ -694,6 +855,8 @@ void PolicyNvWritten_In_Print(PolicyNvWritten_In *in, unsigned int indent)
     TSS_TPMI_YES_NO_Print("writtenSet", in->writtenSet, indent);
     return;
 }
+#endif
+#if CC_PolicyOR
 void PolicyOR_In_Print(PolicyOR_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyOR\n", indent, "");
@@ -702,6 +865,8 @@ void PolicyOR_In_Print(PolicyOR_In *in, unsigned int indent)
     TSS_TPML_DIGEST_Print(&in->pHashList, indent+2);
     return;
 }
+#endif
+#if CC_PolicyPCR
 void PolicyPCR_In_Print(PolicyPCR_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyPCR\n", indent, "");
@@ -710,24 +875,32 @@ void PolicyPCR_In_Print(PolicyPCR_In *in, unsigned int indent)
     TSS_TPML_PCR_SELECTION_Print(&in->pcrs, indent);
     return;
 }
+#endif
+#if CC_PolicyPassword
 void PolicyPassword_In_Print(PolicyPassword_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyPassword\n", indent, "");
     TSS_TPM_HANDLE_Print("policySession", in->policySession, indent);
     return;
 }
+#endif
+#if CC_PolicyPhysicalPresence
 void PolicyPhysicalPresence_In_Print(PolicyPhysicalPresence_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyPhysicalPresence\n", indent, "");
     TSS_TPM_HANDLE_Print("policySession", in->policySession, indent);
     return;
 }
+#endif
+#if CC_PolicyRestart
 void PolicyRestart_In_Print(PolicyRestart_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyRestart\n", indent, "");
     TSS_TPM_HANDLE_Print("sessionHandle", in->sessionHandle, indent);
     return;
 }
+#endif
+#if CC_PolicySecret
 void PolicySecret_In_Print(PolicySecret_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicySecret\n", indent, "");
@@ -739,6 +912,8 @@ void PolicySecret_In_Print(PolicySecret_In *in, unsigned int indent)
     printf("%*s" "expiration %d\n", indent, "", in->expiration);
     return;
 }
+#endif
+#if CC_PolicySigned
 void PolicySigned_In_Print(PolicySigned_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicySigned\n", indent, "");
@@ -752,6 +927,8 @@ void PolicySigned_In_Print(PolicySigned_In *in, unsigned int indent)
     TSS_TPMT_SIGNATURE_Print(&in->auth, indent+2);
     return;
 }
+#endif
+#if CC_PolicyTemplate
 void PolicyTemplate_In_Print(PolicyTemplate_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyTemplate\n", indent, "");
@@ -759,6 +936,8 @@ void PolicyTemplate_In_Print(PolicyTemplate_In *in, unsigned int indent)
     TSS_TPM2B_Print("templateHash", indent, &in->templateHash.b);
     return;
 }
+#endif
+#if CC_PolicyCapability
 void PolicyCapability_In_Print(PolicyCapability_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyCapability\n", indent, "");
@@ -770,6 +949,8 @@ void PolicyCapability_In_Print(PolicyCapability_In *in, unsigned int indent)
     printf("%*s" "property %08x\n", indent, "", in->property);
    return;
 }
+#endif
+#if CC_PolicyParameters
 void PolicyParameters_In_Print(PolicyParameters_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyParameters\n", indent, "");
@@ -777,6 +958,8 @@ void PolicyParameters_In_Print(PolicyParameters_In *in, unsigned int indent)
     TSS_TPM2B_Print("pHash", indent, &in->pHash.b);
     return;
 }
+#endif
+#if CC_PolicyTicket
 void PolicyTicket_In_Print(PolicyTicket_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_PolicyTicket\n", indent, "");
@@ -789,6 +972,8 @@ void PolicyTicket_In_Print(PolicyTicket_In *in, unsigned int indent)
     TSS_TPMT_TK_AUTH_Print(&in->ticket, indent+2);
     return;
 }
+#endif
+#if CC_Quote
 void Quote_In_Print(Quote_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Quote\n", indent, "");
@@ -799,6 +984,8 @@ void Quote_In_Print(Quote_In *in, unsigned int indent)
     TSS_TPML_PCR_SELECTION_Print(&in->PCRselect, indent);
     return;
 }
+#endif
+#if CC_RSA_Decrypt
 void RSA_Decrypt_In_Print(RSA_Decrypt_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_RSA_Decrypt\n", indent, "");
@@ -809,6 +996,8 @@ void RSA_Decrypt_In_Print(RSA_Decrypt_In *in, unsigned int indent)
     TSS_TPM2B_Print("label", indent, &in->label.b);
     return;
 }
+#endif
+#if CC_RSA_Encrypt
 void RSA_Encrypt_In_Print(RSA_Encrypt_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_RSA_Encrypt\n", indent, "");
@@ -819,12 +1008,16 @@ void RSA_Encrypt_In_Print(RSA_Encrypt_In *in, unsigned int indent)
     TSS_TPM2B_Print("label", indent, &in->label.b);
     return;
 }
+#endif
+#if CC_ReadPublic
 void ReadPublic_In_Print(ReadPublic_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ReadPublic\n", indent, "");
     TSS_TPM_HANDLE_Print("objectHandle", in->objectHandle, indent);
     return;
 }
+#endif
+#if CC_Rewrap
 void Rewrap_In_Print(Rewrap_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Rewrap\n", indent, "");
@@ -835,12 +1028,16 @@ void Rewrap_In_Print(Rewrap_In *in, unsigned int indent)
     TSS_TPM2B_Print("inSymSeed", indent, &in->inSymSeed.b);
     return;
 }
+#endif
+#if CC_SelfTest
 void SelfTest_In_Print(SelfTest_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_SelfTest\n", indent, "");
     TSS_TPMI_YES_NO_Print("fullTest", in->fullTest, indent);
     return;
 }
+#endif
+#if CC_SequenceComplete
 void SequenceComplete_In_Print(SequenceComplete_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_SequenceComplete\n", indent, "");
@@ -849,6 +1046,8 @@ void SequenceComplete_In_Print(SequenceComplete_In *in, unsigned int indent)
     TSS_TPM_HANDLE_Print("hierarchy", in->hierarchy, indent);
     return;
 }
+#endif
+#if CC_SequenceUpdate
 void SequenceUpdate_In_Print(SequenceUpdate_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_SequenceUpdate\n", indent, "");
@@ -856,6 +1055,8 @@ void SequenceUpdate_In_Print(SequenceUpdate_In *in, unsigned int indent)
     TSS_TPM2B_Print("buffer", indent, &in->buffer.b);
     return;
 }
+#endif
+#if CC_SetAlgorithmSet
 void SetAlgorithmSet_In_Print(SetAlgorithmSet_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_SetAlgorithmSet\n", indent, "");
@@ -863,6 +1064,8 @@ void SetAlgorithmSet_In_Print(SetAlgorithmSet_In *in, unsigned int indent)
     printf("%*s" "algorithmSet %08x\n", indent, "", in->algorithmSet);
     return;
 }
+#endif
+#if CC_SetCommandCodeAuditStatus
 void SetCommandCodeAuditStatus_In_Print(SetCommandCodeAuditStatus_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_SetCommandCodeAuditStatus\n", indent, "");
@@ -872,6 +1075,8 @@ void SetCommandCodeAuditStatus_In_Print(SetCommandCodeAuditStatus_In *in, unsign
     TSS_TPML_CC_Print(&in->clearList, indent);
     return;
 }
+#endif
+#if CC_SetPrimaryPolicy
 void SetPrimaryPolicy_In_Print(SetPrimaryPolicy_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_SetPrimaryPolicy\n", indent, "");
@@ -880,12 +1085,16 @@ void SetPrimaryPolicy_In_Print(SetPrimaryPolicy_In *in, unsigned int indent)
     TSS_TPM_ALG_ID_Print("hashAlg", in->hashAlg, indent);
     return;
 }
+#endif
+#if CC_Shutdown
 void Shutdown_In_Print(Shutdown_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Shutdown\n", indent, "");
     TSS_TPM_SU_Print("shutdownType", in->shutdownType, indent);
     return;
 }
+#endif
+#if CC_Sign
 void Sign_In_Print(Sign_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Sign\n", indent, "");
@@ -897,6 +1106,8 @@ void Sign_In_Print(Sign_In *in, unsigned int indent)
     TSS_TPMT_TK_HASHCHECK_Print(&in->validation, indent+2);
     return;
 }
+#endif
+#if CC_StartAuthSession
 void StartAuthSession_In_Print(StartAuthSession_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_StartAuthSession\n", indent, "");
@@ -909,30 +1120,40 @@ void StartAuthSession_In_Print(StartAuthSession_In *in, unsigned int indent)
     TSS_TPM_ALG_ID_Print("authHash", in->authHash, indent);
     return;
 }
+#endif
+#if CC_Startup
 void Startup_In_Print(Startup_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Startup\n", indent, "");
     TSS_TPM_SU_Print("startupType", in->startupType, indent);
     return;
 }
+#endif
+#if CC_StirRandom
 void StirRandom_In_Print(StirRandom_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_StirRandom\n", indent, "");
     TSS_TPM2B_Print("inData", indent, &in->inData.b);
     return;
 }
+#endif
+#if CC_TestParms
 void TestParms_In_Print(TestParms_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_TestParms\n", indent, "");
     TSS_TPMT_PUBLIC_PARMS_Print(&in->parameters, indent);
     return;
 }
+#endif
+#if CC_Unseal
 void Unseal_In_Print(Unseal_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_Unseal\n", indent, "");
     TSS_TPM_HANDLE_Print("itemHandle", in->itemHandle, indent);
     return;
 }
+#endif
+#if CC_VerifySignature
 void VerifySignature_In_Print(VerifySignature_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_VerifySignature\n", indent, "");
@@ -942,6 +1163,8 @@ void VerifySignature_In_Print(VerifySignature_In *in, unsigned int indent)
     TSS_TPMT_SIGNATURE_Print(&in->signature, indent);
     return;
 }
+#endif
+#if CC_ZGen_2Phase
 void ZGen_2Phase_In_Print(ZGen_2Phase_In *in, unsigned int indent)
 {
     printf("%*s" "TPM2_ZGen_2Phase\n", indent, "");
@@ -952,3 +1175,4 @@ void ZGen_2Phase_In_Print(ZGen_2Phase_In *in, unsigned int indent)
     printf("%*s" "counter %u\n", indent, "", in->counter);
     return;
 }
+#endif
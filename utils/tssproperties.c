@@ -43,12 +43,22 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef TPM_POSIX
+#include <unistd.h>
+#endif
+#ifdef TPM_WINDOWS
+#include <process.h>
+#endif
+
 #include <ibmtss/tss.h>
 #include <ibmtss/tsstransmit.h>
 #ifndef TPM_TSS_NOCRYPTO
 #include <ibmtss/tsscrypto.h>
 #endif
 #include <ibmtss/tssprint.h>
+#ifndef TPM_TSS_NOFILE
+#include <ibmtss/tssfile.h>
+#endif
 
 #include "tssproperties.h"
 
@@ -64,6 +74,7 @@
 
 static TPM_RC TSS_SetTraceLevel(const char *value);
 static TPM_RC TSS_SetDataDirectory(TSS_CONTEXT *tssContext, const char *value);
+static TPM_RC TSS_SetSessionDirectory(TSS_CONTEXT *tssContext, const char *value);
 static TPM_RC TSS_SetCommandPort(TSS_CONTEXT *tssContext, const char *value);
 static TPM_RC TSS_SetPlatformPort(TSS_CONTEXT *tssContext, const char *value);
 static TPM_RC TSS_SetServerName(TSS_CONTEXT *tssContext, const char *value);
@@ -72,6 +83,12 @@ static TPM_RC TSS_SetInterfaceType(TSS_CONTEXT *tssContext, const char *value);
 static TPM_RC TSS_SetDevice(TSS_CONTEXT *tssContext, const char *value);
 static TPM_RC TSS_SetEncryptSessions(TSS_CONTEXT *tssContext, const char *value);
 static TPM_RC TSS_SetLocality(TSS_CONTEXT *tssContext, const char *value);
+static TPM_RC TSS_SetRecordFile(TSS_CONTEXT *tssContext, const char *value);
+static TPM_RC TSS_SetReplayFile(TSS_CONTEXT *tssContext, const char *value);
+static TPM_RC TSS_SetReplayTiming(TSS_CONTEXT *tssContext, const char *value);
+static TPM_RC TSS_SetNonceSeed(TSS_CONTEXT *tssContext, const char *value);
+static TPM_RC TSS_SetBufferSize(TSS_CONTEXT *tssContext, uint32_t *maxSize,
+				uint32_t minSize, const char *defaultValue, const char *value);
 
 /* globals for the library */
 
@@ -131,10 +148,22 @@ int tssFirstCall = TRUE;
 #define TPM_ENCRYPT_SESSIONS_DEFAULT	"1"
 #endif
 
+#ifndef TPM_REPLAY_TIMING_DEFAULT
+#define TPM_REPLAY_TIMING_DEFAULT	"0"		/* replay responds immediately */
+#endif
+
 #ifndef TPM_TRANSMIT_LOCALITY_DEFAULT
 #define TPM_TRANSMIT_LOCALITY_DEFAULT	"0"		/* socket interface supports a locality byte */
 #endif
 
+#ifndef TPM_MAX_COMMAND_SIZE_DEFAULT
+#define TPM_MAX_COMMAND_SIZE_DEFAULT	"0"		/* read TPM_PT_MAX_COMMAND_SIZE */
+#endif
+
+#ifndef TPM_MAX_RESPONSE_SIZE_DEFAULT
+#define TPM_MAX_RESPONSE_SIZE_DEFAULT	"0"		/* read TPM_PT_MAX_RESPONSE_SIZE */
+#endif
+
 /* TSS_GlobalProperties_Init() sets the global verbose trace flags at the first entry points to the
    TSS */
 
@@ -164,7 +193,27 @@ TPM_RC TSS_Properties_Init(TSS_CONTEXT *tssContext)
     if (rc == 0) {
 	tssContext->tssAuthContext = NULL;
 	tssContext->tssFirstTransmit = TRUE;	/* connection not opened */
+	tssContext->tssTransport.transmit = NULL;	/* transport not resolved */
+	tssContext->tssTransport.transmitPlatform = NULL;
+	tssContext->tssTransport.transmitCommand = NULL;
+	tssContext->tssTransport.close = NULL;
+	tssContext->tssTransportContext = NULL;
+	tssContext->tssTransportRegistered = FALSE;
+	tssContext->tssTransmitNsec = 0;
+	tssContext->tssRecordFile = NULL;
+	tssContext->tssReplayFile = NULL;
+#ifndef TPM_TSS_NOFILE
+	tssContext->tssRecordFile_fp = NULL;
+	tssContext->tssReplayBuffer = NULL;
+	tssContext->tssReplayLength = 0;
+	tssContext->tssReplayOffset = 0;
+#endif
 	tssContext->tpm12Command = FALSE;
+	tssContext->tssMaxCommandSize = 0;
+	tssContext->tssMaxResponseSize = 0;
+	tssContext->tssNvBufferMax = 0;
+	tssContext->tssBufferSizeValid = FALSE;
+	tssContext->tssTransmitResponseSize = MAX_RESPONSE_SIZE;
 #ifdef TPM_WINDOWS
 	tssContext->sock_fd = INVALID_SOCKET;
 #endif
@@ -182,6 +231,9 @@ TPM_RC TSS_Properties_Init(TSS_CONTEXT *tssContext)
 	tssContext->tpm_device = NULL;
 #endif /* TPM_SKIBOOT */
 	
+#ifndef TPM_TSS_NOFILE
+	tssContext->tssSessionPath[0] = '\0';
+#endif
 #ifndef TPM_TSS_NOCRYPTO
 #ifndef TPM_TSS_NOFILE
 	tssContext->tssSessionEncKey = NULL;
@@ -191,26 +243,20 @@ TPM_RC TSS_Properties_Init(TSS_CONTEXT *tssContext)
     }
     /* for a minimal TSS with no file support */
 #ifdef TPM_TSS_NOFILE
-    {
-	size_t i;
-	for (i = 0 ; i < (sizeof(tssContext->sessions) / sizeof(TSS_SESSIONS)) ; i++) {
-	    tssContext->sessions[i].sessionHandle = TPM_RH_NULL;
-	    tssContext->sessions[i].sessionData = NULL;
-	    tssContext->sessions[i].sessionDataLength = 0;
-	}
-	for (i = 0 ; i < (sizeof(tssContext->objectPublic) / sizeof(TSS_OBJECT_PUBLIC)) ; i++) {
-	    tssContext->objectPublic[i].objectHandle = TPM_RH_NULL;
-	}
-	for (i = 0 ; i < (sizeof(tssContext->nvPublic) / sizeof(TSS_NVPUBLIC)) ; i++) {
-	    tssContext->nvPublic[i].nvIndex = TPM_RH_NULL;
-	}
-    }
+    TSS_HandleTable_Init(&tssContext->sessions);
+    TSS_HandleTable_Init(&tssContext->objectPublic);
+    TSS_HandleTable_Init(&tssContext->nvPublic);
 #endif
     /* data directory */
     if (rc == 0) {
 	value = GETENV("TPM_DATA_DIR");
 	rc = TSS_SetDataDirectory(tssContext, value);
     }
+    /* session and transient object subdirectory */
+    if (rc == 0) {
+	value = GETENV("TPM_SESSION_DIR");
+	rc = TSS_SetSessionDirectory(tssContext, value);
+    }
     /* flag whether session state should be encrypted */
     if (rc == 0) {
 	value = GETENV("TPM_ENCRYPT_SESSIONS");
@@ -251,6 +297,34 @@ TPM_RC TSS_Properties_Init(TSS_CONTEXT *tssContext)
 	value = GETENV("TPM_TRANSMIT_LOCALITY");
 	rc = TSS_SetLocality(tssContext, value);
     }
+    /* record and replay */
+    if (rc == 0) {
+	value = GETENV("TPM_RECORD_FILE");
+	rc = TSS_SetRecordFile(tssContext, value);
+    }
+    if (rc == 0) {
+	value = GETENV("TPM_REPLAY_FILE");
+	rc = TSS_SetReplayFile(tssContext, value);
+    }
+    if (rc == 0) {
+	value = GETENV("TPM_REPLAY_TIMING");
+	rc = TSS_SetReplayTiming(tssContext, value);
+    }
+    if (rc == 0) {
+	value = GETENV("TPM_NONCE_SEED");
+	rc = TSS_SetNonceSeed(tssContext, value);
+    }
+    /* command and response buffer sizes */
+    if (rc == 0) {
+	value = GETENV("TPM_MAX_COMMAND_SIZE");
+	rc = TSS_SetBufferSize(tssContext, &tssContext->tssMaxCommandSize,
+			       MAX_COMMAND_SIZE, TPM_MAX_COMMAND_SIZE_DEFAULT, value);
+    }
+    if (rc == 0) {
+	value = GETENV("TPM_MAX_RESPONSE_SIZE");
+	rc = TSS_SetBufferSize(tssContext, &tssContext->tssMaxResponseSize,
+			       MAX_RESPONSE_SIZE, TPM_MAX_RESPONSE_SIZE_DEFAULT, value);
+    }
     return rc;
 }
 
@@ -312,6 +386,29 @@ TPM_RC TSS_SetProperty(TSS_CONTEXT *tssContext,
 	  case TPM_TRANSMIT_LOCALITY:
 	    rc = TSS_SetLocality(tssContext, value);
 	    break;
+	  case TPM_RECORD_FILE:
+	    rc = TSS_SetRecordFile(tssContext, value);
+	    break;
+	  case TPM_REPLAY_FILE:
+	    rc = TSS_SetReplayFile(tssContext, value);
+	    break;
+	  case TPM_REPLAY_TIMING:
+	    rc = TSS_SetReplayTiming(tssContext, value);
+	    break;
+	  case TPM_NONCE_SEED:
+	    rc = TSS_SetNonceSeed(tssContext, value);
+	    break;
+	  case TPM_SESSION_DIR:
+	    rc = TSS_SetSessionDirectory(tssContext, value);
+	    break;
+	  case TPM_MAX_COMMAND_SIZE:
+	    rc = TSS_SetBufferSize(tssContext, &tssContext->tssMaxCommandSize,
+				   MAX_COMMAND_SIZE, TPM_MAX_COMMAND_SIZE_DEFAULT, value);
+	    break;
+	  case TPM_MAX_RESPONSE_SIZE:
+	    rc = TSS_SetBufferSize(tssContext, &tssContext->tssMaxResponseSize,
+				   MAX_RESPONSE_SIZE, TPM_MAX_RESPONSE_SIZE_DEFAULT, value);
+	    break;
 	  default:
 	    rc = TSS_RC_BAD_PROPERTY;
 	}
@@ -390,6 +487,80 @@ static TPM_RC TSS_SetDataDirectory(TSS_CONTEXT *tssContext, const char *value)
     return rc;
 }
 
+/* TSS_SetSessionDirectory() sets a subdirectory of the data directory for the session state and the
+   transient object Names and publics.  The default is NULL, the data directory itself.
+
+   The Names and publics of persistent objects and NV indexes, which are the same for every TPM
+   connection, stay in the data directory, so that workers sharing a data directory can each have
+   their own session directory.  The value "pid" selects a per process directory pid<process ID>,
+   which TSS_Delete() removes if it is empty.
+*/
+
+static TPM_RC TSS_SetSessionDirectory(TSS_CONTEXT *tssContext, const char *value)
+{
+    TPM_RC		rc = 0;
+
+    if (rc == 0) {
+	if ((value != NULL) &&
+	    ((value[0] == '\0') || (strchr(value, '/') != NULL) || (strchr(value, '\\') != NULL))) {
+	    if (tssVerbose) printf("TSS_SetSessionDirectory: Error, value must be a simple name\n");
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	tssContext->tssSessionDirectory = value;
+    }
+    return rc;
+}
+
+#ifndef TPM_TSS_NOFILE
+
+/* TSS_GetSessionDirectory() returns the directory for session and transient object state,
+   creating it if necessary.  See TSS_SetSessionDirectory().
+*/
+
+TPM_RC TSS_GetSessionDirectory(TSS_CONTEXT *tssContext,
+			       const char **directory)
+{
+    TPM_RC		rc = 0;
+    unsigned long	pid;
+
+    if (tssContext->tssSessionDirectory == NULL) {
+	*directory = tssContext->tssDataDirectory;
+	return rc;
+    }
+    /* the same margin as TSS_SetDataDirectory(), for the appended file name */
+    if (rc == 0) {
+	if ((strlen(tssContext->tssDataDirectory) + 1 + strlen(tssContext->tssSessionDirectory) + 20)
+	    > (TPM_DATA_DIR_PATH_LENGTH - 24)) {
+	    if (tssVerbose) printf("TSS_GetSessionDirectory: Error, path too long\n");
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	if (strcmp(tssContext->tssSessionDirectory, "pid") == 0) {
+#ifdef TPM_WINDOWS
+	    pid = (unsigned long)_getpid();
+#else
+	    pid = (unsigned long)getpid();
+#endif
+	    sprintf(tssContext->tssSessionPath, "%s/pid%lu",
+		    tssContext->tssDataDirectory, pid);
+	}
+	else {
+	    sprintf(tssContext->tssSessionPath, "%s/%s",
+		    tssContext->tssDataDirectory, tssContext->tssSessionDirectory);
+	}
+	rc = TSS_File_CreateDirectory(tssContext->tssSessionPath);
+    }
+    if (rc == 0) {
+	*directory = tssContext->tssSessionPath;
+    }
+    return rc;
+}
+
+#endif
+
 static TPM_RC TSS_SetCommandPort(TSS_CONTEXT *tssContext, const char *value)
 {
     TPM_RC		rc = 0;
@@ -572,3 +743,139 @@ static TPM_RC TSS_SetLocality(TSS_CONTEXT *tssContext, const char *value)
     }
     return rc;
 }
+
+/* TSS_SetRecordFile() sets the file that records each command / response pair.  The default is
+   NULL, no recording.  Records are appended to an existing file.
+*/
+
+static TPM_RC TSS_SetRecordFile(TSS_CONTEXT *tssContext, const char *value)
+{
+    TPM_RC		rc = 0;
+
+    /* close an open connection and record file before changing property */
+    if (rc == 0) {
+	rc = TSS_Close(tssContext);
+    }
+#ifndef TPM_TSS_NOFILE
+    if (rc == 0) {
+	tssContext->tssRecordFile = value;
+    }
+#else
+    if ((rc == 0) && (value != NULL)) {
+	if (tssVerbose) printf("TSS_SetRecordFile: Error, no file support\n");
+	rc = TSS_RC_BAD_PROPERTY;
+    }
+#endif
+    return rc;
+}
+
+/* TSS_SetReplayFile() sets the file of recorded command / response pairs.  If set, responses are
+   served from the file rather than the TPM.  The default is NULL, no replay.
+*/
+
+static TPM_RC TSS_SetReplayFile(TSS_CONTEXT *tssContext, const char *value)
+{
+    TPM_RC		rc = 0;
+
+    /* close an open connection before changing property */
+    if (rc == 0) {
+	rc = TSS_Close(tssContext);
+    }
+#ifndef TPM_TSS_NOFILE
+    if (rc == 0) {
+	tssContext->tssReplayFile = value;
+    }
+#else
+    if ((rc == 0) && (value != NULL)) {
+	if (tssVerbose) printf("TSS_SetReplayFile: Error, no file support\n");
+	rc = TSS_RC_BAD_PROPERTY;
+    }
+#endif
+    return rc;
+}
+
+/* TSS_SetReplayTiming() sets whether a replay waits the recorded TPM latency.  The default is 0,
+   respond immediately.
+*/
+
+static TPM_RC TSS_SetReplayTiming(TSS_CONTEXT *tssContext, const char *value)
+{
+    TPM_RC		rc = 0;
+    int			irc = 0;
+
+    if (rc == 0) {
+	if (value == NULL) {
+	    value = TPM_REPLAY_TIMING_DEFAULT;
+	}
+    }
+    if (rc == 0) {
+	irc = sscanf(value, "%u", &tssContext->tssReplayTiming);
+	if (irc != 1) {
+	    if (tssVerbose) printf("TSS_SetReplayTiming: Error, value invalid\n");
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    return rc;
+}
+
+/* TSS_SetNonceSeed() sets a seed for a deterministic caller nonce and salt source.  The default is
+   NULL, random nonces.
+
+   This is for record and replay testing.  The seed is only used while TPM_RECORD_FILE or
+   TPM_REPLAY_FILE is also set, see TSS_RandNonce().  It must not be used with a real TPM in
+   production.
+*/
+
+static TPM_RC TSS_SetNonceSeed(TSS_CONTEXT *tssContext, const char *value)
+{
+    tssContext->tssNonceSeed = value;
+    tssContext->tssNonceCounter = 0;
+    return 0;
+}
+
+/* TSS_SetBufferSize() sets the TPM_MAX_COMMAND_SIZE or TPM_MAX_RESPONSE_SIZE property.
+
+   The default 0 reads TPM_PT_MAX_COMMAND_SIZE or TPM_PT_MAX_RESPONSE_SIZE from the TPM before the
+   first TPM 2.0 command on a connection, see TSS_GetBufferSize().  Any other value fixes the size
+   and skips the read.  A size is never smaller than the compiled in MAX_COMMAND_SIZE or
+   MAX_RESPONSE_SIZE.
+*/
+
+static TPM_RC TSS_SetBufferSize(TSS_CONTEXT *tssContext, uint32_t *maxSize,
+				uint32_t minSize, const char *defaultValue, const char *value)
+{
+    TPM_RC		rc = 0;
+    int			irc = 0;
+    unsigned int	tmpint;
+
+    if (rc == 0) {
+	if (value == NULL) {
+	    value = defaultValue;
+	}
+    }
+    if (rc == 0) {
+	irc = sscanf(value, "%u", &tmpint);
+	if (irc != 1) {
+	    if (tssVerbose) printf("TSS_SetBufferSize: Error, value invalid\n");
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    if (rc == 0) {
+	if ((tmpint != 0) &&
+	    ((tmpint < minSize) || (tmpint > TPM_BUFFER_SIZE_LIMIT))) {
+	    if (tssVerbose) printf("TSS_SetBufferSize: Error, value %u not 0 or %u to %u\n",
+				   tmpint, minSize, TPM_BUFFER_SIZE_LIMIT);
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    /* resize at the next command */
+    if (rc == 0) {
+	*maxSize = tmpint;
+	tssContext->tssCommandBufferSize = (tssContext->tssMaxCommandSize != 0) ?
+					   tssContext->tssMaxCommandSize : MAX_COMMAND_SIZE;
+	tssContext->tssResponseBufferSize = (tssContext->tssMaxResponseSize != 0) ?
+					    tssContext->tssMaxResponseSize : MAX_RESPONSE_SIZE;
+	tssContext->tssBufferSizeValid = FALSE;
+    }
+    return rc;
+}
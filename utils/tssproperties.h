@@ -75,11 +75,16 @@ typedef int TSS_SOCKET_FD;
    directory length will be (currently) 17 bytes smaller. */
 #define TPM_DATA_DIR_PATH_LENGTH 256
 
+/* Upper limit for the TPM_MAX_COMMAND_SIZE and TPM_MAX_RESPONSE_SIZE properties and the TPM
+   maximums.  The marshal functions count bytes written in a uint16_t. */
+#define TPM_BUFFER_SIZE_LIMIT 0xffff
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #include <ibmtss/tss.h>
+#include <ibmtss/tsstransmit.h>
 #include "tssauth.h"
 
     /* Structure to hold session data within the context */
@@ -106,6 +111,16 @@ extern "C" {
 	TPMS_NV_PUBLIC	nvPublic;
     } TSS_NVPUBLIC;
 
+    /* Hash table of TSS_SESSIONS, TSS_OBJECT_PUBLIC, or TSS_NVPUBLIC entries, keyed by the handle
+       that is the first member of each entry.  Entries are allocated when first stored and the
+       slot array grows as needed, so an empty table uses no memory.  See TSS_HandleTable_Add(). */
+
+    typedef struct TSS_HANDLE_TABLE {
+	void **slots;		/* entry pointers, NULL for an empty slot */
+	size_t size;		/* number of slots, 0 or a power of 2 */
+	size_t count;		/* number of entries */
+    } TSS_HANDLE_TABLE;
+
     /* Context for TSS global parameters.
 
        NOTE:  Keep this in sync with TSS_Properties_Init() and TSS_Delete() */
@@ -116,6 +131,12 @@ extern "C" {
 
 	/* directory for persistant storage */
 	const char *tssDataDirectory;
+	/* subdirectory of tssDataDirectory for session and transient object state, NULL for
+	   tssDataDirectory, see TSS_GetSessionDirectory() */
+	const char *tssSessionDirectory;
+#ifndef TPM_TSS_NOFILE
+	char tssSessionPath[TPM_DATA_DIR_PATH_LENGTH];
+#endif
 
 	/* encrypt saved session state */
 	int tssEncryptSessions;
@@ -127,13 +148,13 @@ extern "C" {
 	void *tssSessionDecKey;
 #endif
 #endif
-	/* a minimal TSS with no file support stores the sessions, objects, and NV metadata in a
-	   structure.  Scripting will not work, and persistent objects will not work, but a single
+	/* a minimal TSS with no file support stores the sessions, objects, and NV metadata in
+	   tables.  Scripting will not work, and persistent objects will not work, but a single
 	   application will otherwise work. */
 #ifdef TPM_TSS_NOFILE
-	TSS_SESSIONS sessions[MAX_ACTIVE_SESSIONS];
-	TSS_OBJECT_PUBLIC objectPublic[64];
-	TSS_NVPUBLIC nvPublic[64];
+	TSS_HANDLE_TABLE sessions;	/* TSS_SESSIONS */
+	TSS_HANDLE_TABLE objectPublic;	/* TSS_OBJECT_PUBLIC */
+	TSS_HANDLE_TABLE nvPublic;	/* TSS_NVPUBLIC */
 #endif
 	/* ports, host name, server (packet) type for socket interface */
 	short tssCommandPort;
@@ -149,6 +170,37 @@ extern "C" {
 	/* device driver interface */
 	const char *tssDevice;
 
+	/* command and response buffer sizes, see TSS_GetBufferSize() */
+	uint32_t tssMaxCommandSize;	/* property, 0 reads TPM_PT_MAX_COMMAND_SIZE */
+	uint32_t tssMaxResponseSize;	/* property, 0 reads TPM_PT_MAX_RESPONSE_SIZE */
+	uint32_t tssCommandBufferSize;
+	uint32_t tssResponseBufferSize;
+	uint32_t tssNvBufferMax;	/* TPM_PT_NV_BUFFER_MAX, 0 if not read */
+	int tssBufferSizeValid;		/* FALSE until sized for the current connection */
+	/* bound on the response the transport writes, see TSS_AuthExecute() */
+	uint32_t tssTransmitResponseSize;
+
+	/* transport callbacks, resolved from tssInterfaceType at the first transmit or set by
+	   TSS_SetTransport() */
+	TSS_TRANSPORT tssTransport;
+	void *tssTransportContext;
+	int tssTransportRegistered;	/* TRUE if set by TSS_SetTransport() */
+	uint64_t tssTransmitNsec;	/* cumulative time in the transport, see TSS_GetTransmitTime() */
+
+	/* record and replay of command / response pairs, see tsstransmit.c */
+	const char *tssRecordFile;
+	const char *tssReplayFile;
+	int tssReplayTiming;		/* TRUE to wait the recorded TPM latency */
+#ifndef TPM_TSS_NOFILE
+	void *tssRecordFile_fp;		/* FILE *, void so the header need not include stdio.h */
+	uint8_t *tssReplayBuffer;
+	size_t tssReplayLength;
+	size_t tssReplayOffset;
+#endif
+	/* deterministic nonce source, so that a replayed HMAC session flow reproduces exactly */
+	const char *tssNonceSeed;
+	uint32_t tssNonceCounter;
+
 	/* TRUE for the first time through, indicates that interface open must occur */
 	int tssFirstTransmit;
 	int tpm12Command;		/* TRUE for TPM 1.2 command */
@@ -178,6 +230,23 @@ extern "C" {
 
     TPM_RC TSS_GlobalProperties_Init(void);
     TPM_RC TSS_Properties_Init(TSS_CONTEXT *tssContext);
+#ifndef TPM_TSS_NOFILE
+    TPM_RC TSS_GetSessionDirectory(TSS_CONTEXT *tssContext,
+				   const char **directory);
+#endif
+
+#ifdef TPM_TSS_NOFILE
+    void TSS_HandleTable_Init(TSS_HANDLE_TABLE *table);
+    void *TSS_HandleTable_Find(TSS_HANDLE_TABLE *table,
+			       TPM_HANDLE handle);
+    TPM_RC TSS_HandleTable_Add(TSS_HANDLE_TABLE *table,
+			       void **entry,
+			       TPM_HANDLE handle,
+			       uint32_t entrySize);
+    void *TSS_HandleTable_Remove(TSS_HANDLE_TABLE *table,
+				 TPM_HANDLE handle);
+    void TSS_HandleTable_Delete(TSS_HANDLE_TABLE *table);
+#endif
 
     TPM_RC TSS_AES_KeyAllocate(void **tssSessionEncKey,
 			       void **tssSessionDecKey);
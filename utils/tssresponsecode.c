@@ -387,6 +387,12 @@ const RC_TABLE tssTable [] = {
     {TSS_RC_KDFE_FAILED, "TSS_RC_KDFE_FAILED - KDFe function failed"},
     {TSS_RC_EC_EPHEMERAL_FAILURE, "TSS_RC_EC_EPHEMERAL_FAILURE - Failed while making or using EC ephemeral key"},
     {TSS_RC_FAIL, "TSS_RC_FAIL - TSS internal failure"},
+    {TSS_RC_PREPARE_UNSUPPORTED, "TSS_RC_PREPARE_UNSUPPORTED - Command cannot be prepared"},
+    {TSS_RC_BAD_CREDENTIAL_KEY, "TSS_RC_BAD_CREDENTIAL_KEY - Key is unsuitable for a credential"},
+    {TSS_RC_BAD_MERKLE_PROOF, "TSS_RC_BAD_MERKLE_PROOF - Merkle inclusion proof does not verify"},
+    {TSS_RC_AUDIT_DIGEST, "TSS_RC_AUDIT_DIGEST - Session audit digest does not match"},
+    {TSS_RC_REPLAY, "TSS_RC_REPLAY - Replay trace malformed, exhausted, or does not match"},
+    {TSS_RC_PREPARE_SIZE, "TSS_RC_PREPARE_SIZE - Prepared parameter size does not match the command"},
     {TSS_RC_NO_SESSION_SLOT, "TSS_RC_NO_SESSION_SLOT - TSS context has no session slot for handle"},
     {TSS_RC_NO_OBJECTPUBLIC_SLOT, "TSS_RC_NO_OBJECTPUBLIC_SLOT - TSS context has no object public slot for handle"},
     {TSS_RC_NO_NVPUBLIC_SLOT, "TSS_RC_NO_NVPUBLIC_SLOT -TSS context has no NV public slot for handle"},
@@ -460,7 +460,7 @@ static uint32_t TSS_Socket_SendBytes(TSS_SOCKET_FD sock_fd, const uint8_t *buffe
 }
 
 /* TSS_Socket_ReceiveResponse() reads a TPM response packet from the socket.  'buffer' must be at
-   least MAX_RESPONSE_SIZE bytes.  The bytes read are returned in 'length'.
+   least tssTransmitResponseSize bytes.  The bytes read are returned in 'length'.
 
    The MS simulator packet is of the form:
 
@@ -512,10 +512,10 @@ static uint32_t TSS_Socket_ReceiveResponse(TSS_CONTEXT *tssContext,
 	*length = responseSize;			/* returned length */
 
 	/* check the response size, see TSS_CONTEXT structure */
-	if (responseSize > MAX_RESPONSE_SIZE) {
+	if (responseSize > tssContext->tssTransmitResponseSize) {
 	    if (tssVerbose)
 		printf("TSS_Socket_ReceiveResponse: ERROR: responseSize %u greater than %u\n",
-		       responseSize, MAX_RESPONSE_SIZE);
+		       responseSize, tssContext->tssTransmitResponseSize);
 	    rc = TSS_RC_BAD_CONNECTION;
 	}
 	/* check that MS sim prepended length is the same as the response TPM packet
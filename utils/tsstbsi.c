@@ -75,7 +75,7 @@ extern int tssVverbose;
 extern int tssVerbose;
 
 /* TSS_Dev_Transmit() transmits the command and receives the response. 'responseBuffer' must be at
-   least MAX_RESPONSE_SIZE bytes.
+   least tssTransmitResponseSize bytes.
 
    Can return device transmit and receive packet errors, but normally returns the TPM response code.
 */
@@ -99,7 +99,7 @@ TPM_RC TSS_Dev_Transmit(TSS_CONTEXT *tssContext,
 	    contextParams.includeTpm20 = 0;
 	}
     }
-    *read = MAX_RESPONSE_SIZE;
+    *read = tssContext->tssTransmitResponseSize;
     /* open on first transmit */
     if (tssContext->tssFirstTransmit) {	
 	if (rc == 0) {
@@ -0,0 +1,421 @@
+/********************************************************************************/
+/*										*/
+/*			       Multi-call Utility				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* 
+   tsstool is a multi-call program containing the TSS utilities.
+
+   The utility is selected by the program name, so that tsstool can be installed as symbolic
+   links named for each utility, with or without the tss prefix that make install adds, or by the
+   first argument:
+
+   tsstool getrandom -by 8
+
+   With -script, tsstool reads utility invocations from a file, or stdin for '-', one per line,
+   and runs them in one process.  Blank lines and lines beginning with # are skipped.  Arguments
+   are separated by white space and may be enclosed in double quotes.  The utilities share one TSS
+   context, so the process start up, the TSS initialization, and the TPM connection are done once.
+   With TPM_TSS_NOFILE, session state also stays in memory from one line to the next.  A utility
+   that sets a property of the context (e.g. startup -loc, createekcert -il) does not pass it on.
+   The context is deleted when the utility deletes it, and the next line gets a new one.  The script
+   stops at the first failure unless -k is specified, in which case the exit status is that of the
+   last failure.
+
+   A utility usage error exits the process, ending the script.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tssresponsecode.h>
+
+#define TSSTOOL_PROGRAM
+#include "tsstool.h"
+
+#define TSSTOOL_MAX_ARGS	256
+#define TSSTOOL_MAX_LINE	16384
+
+typedef int (*TSSTOOL_MAIN)(int argc, char *argv[]);
+
+typedef struct {
+    const char		*name;
+    TSSTOOL_MAIN	main;
+} TSSTOOL_ENTRY;
+
+#define TSSTOOL_ENTRY_INIT(tool) {#tool, tool##_main},
+
+static const TSSTOOL_ENTRY tsstoolTable[] = {
+    TSSTOOL_LIST(TSSTOOL_ENTRY_INIT)
+};
+
+static TSSTOOL_MAIN findTool(const char *name);
+static int runTool(int argc, char *argv[]);
+static int runScript(const char *filename,
+		     int keepGoing);
+static int splitLine(char *line,
+		     int *argc,
+		     char *argv[]);
+static void listTools(void);
+static void printUsage(void);
+
+extern int tssUtilsVerbose;
+
+/* tsstoolContext, when not NULL, is the context shared by the utilities in a script.  See
+   tsstoolCreate().  tsstoolContextChanged is set when a utility sets one of its properties, see
+   tsstoolSetProperty(). */
+
+static TSS_CONTEXT *tsstoolContext = NULL;
+static int tsstoolContextChanged = FALSE;
+
+int main(int argc, char *argv[])
+{
+    int			rc = 0;
+    const char		*progname;
+    const char		*scriptFilename = NULL;
+    int			keepGoing = FALSE;
+    int			i;    /* argc iterator */
+
+    /* called through a link named for a utility */
+    progname = strrchr(argv[0], '/');
+    progname = (progname != NULL) ? progname + 1 : argv[0];
+    /* make install prefixes the program names with tss */
+    if ((findTool(progname) == NULL) && (strncmp(progname, "tss", 3) == 0)) {
+	progname += 3;
+    }
+    if (findTool(progname) != NULL) {
+	argv[0] = (char *)progname;
+	return runTool(argc, argv);
+    }
+    /* called with the utility as the first argument */
+    if ((argc > 1) && (findTool(argv[1]) != NULL)) {
+	return runTool(argc - 1, argv + 1);
+    }
+    for (i=1 ; i<argc ; i++) {
+	if (strcmp(argv[i],"-script") == 0) {
+	    i++;
+	    if (i < argc) {
+		scriptFilename = argv[i];
+	    }
+	    else {
+		printf("-script option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-k") == 0) {
+	    keepGoing = TRUE;
+	}
+	else if (strcmp(argv[i],"-l") == 0) {
+	    listTools();
+	    return 0;
+	}
+	else if (strcmp(argv[i],"-h") == 0) {
+	    printUsage();
+	}
+	else {
+	    printf("\n%s is not a valid option or utility\n", argv[i]);
+	    printUsage();
+	}
+    }
+    if (scriptFilename == NULL) {
+	printf("Missing utility or -script\n");
+	printUsage();
+    }
+    rc = runScript(scriptFilename, keepGoing);
+    return rc;
+}
+
+/* findTool() returns the main() of the utility 'name', or NULL if there is none */
+
+static TSSTOOL_MAIN findTool(const char *name)
+{
+    size_t i;
+    for (i = 0 ; i < (sizeof(tsstoolTable) / sizeof(TSSTOOL_ENTRY)) ; i++) {
+	if (strcmp(name, tsstoolTable[i].name) == 0) {
+	    return tsstoolTable[i].main;
+	}
+    }
+    return NULL;
+}
+
+/* runTool() runs the utility argv[0].  The utility verbose flag is reset, since a previous
+   utility in a script may have set it. */
+
+static int runTool(int argc, char *argv[])
+{
+    const char		*name;
+    TSSTOOL_MAIN	toolMain;
+
+    name = strrchr(argv[0], '/');
+    name = (name != NULL) ? name + 1 : argv[0];
+    toolMain = findTool(name);
+    if (toolMain == NULL) {
+	printf("tsstool: %s is not a utility\n", name);
+	return TSS_RC_BAD_PROPERTY_VALUE;
+    }
+    tssUtilsVerbose = FALSE;
+    return toolMain(argc, argv);
+}
+
+/* tsstoolCreate() is called by the utilities in place of TSS_Create().
+
+   While a script is running, it returns the script's context rather than allocating a new one.
+   Otherwise it calls TSS_Create().
+*/
+
+TPM_RC tsstoolCreate(TSS_CONTEXT **tssContext)
+{
+    if (tsstoolContext != NULL) {
+	*tssContext = tsstoolContext;
+	return 0;
+    }
+    return TSS_Create(tssContext);
+}
+
+/* tsstoolDelete() is called by the utilities in place of TSS_Delete().
+
+   The script's context outlives the utility, so deleting it is a no-op, unless the utility set a
+   property.  The property values may point into the utility's memory, and the next utility
+   expects the defaults, so the context is deleted and runScript() creates a new one.
+*/
+
+TPM_RC tsstoolDelete(TSS_CONTEXT *tssContext)
+{
+    if ((tssContext != NULL) && (tssContext == tsstoolContext)) {
+	if (!tsstoolContextChanged) {
+	    return 0;
+	}
+	tsstoolContext = NULL;
+	tsstoolContextChanged = FALSE;
+    }
+    return TSS_Delete(tssContext);
+}
+
+/* tsstoolSetProperty() is called by the utilities in place of TSS_SetProperty().
+
+   It records a change to the script's context, so that tsstoolDelete() does not pass it on.
+*/
+
+TPM_RC tsstoolSetProperty(TSS_CONTEXT *tssContext,
+			  int property,
+			  const char *value)
+{
+    if ((tssContext != NULL) && (tssContext == tsstoolContext)) {
+	tsstoolContextChanged = TRUE;
+    }
+    return TSS_SetProperty(tssContext, property, value);
+}
+
+/* runScript() runs the utility invocations in filename, one per line.  '-' is stdin.
+
+   The script's TSS context is shared by the utilities until one of them changes it.  A new context
+   is then created for the next line.
+*/
+
+static int runScript(const char *filename,
+		     int keepGoing)
+{
+    int			rc = 0;
+    int			toolRc;
+    int			failRc = 0;	/* with -k, the last utility failure */
+    FILE		*scriptFile = NULL;
+    char		*line = NULL;
+    unsigned int	lineNumber = 0;
+    int			toolArgc;
+    char		*toolArgv[TSSTOOL_MAX_ARGS + 1];
+    TPM_RC		rc1;
+
+    if (rc == 0) {
+	if (strcmp(filename, "-") == 0) {
+	    scriptFile = stdin;
+	}
+	else {
+	    scriptFile = fopen(filename, "r");	/* closed @1 */
+	    if (scriptFile == NULL) {
+		printf("tsstool: cannot open %s\n", filename);
+		rc = TSS_RC_FILE_OPEN;
+	    }
+	}
+    }
+    if (rc == 0) {
+	line = malloc(TSSTOOL_MAX_LINE);	/* freed @2 */
+	if (line == NULL) {
+	    printf("tsstool: cannot allocate %u bytes\n", TSSTOOL_MAX_LINE);
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    while ((rc == 0) && (fgets(line, TSSTOOL_MAX_LINE, scriptFile) != NULL)) {
+	lineNumber++;
+	if (strchr(line, '\n') == NULL && !feof(scriptFile)) {
+	    printf("tsstool: line %u is longer than %u bytes\n", lineNumber, TSSTOOL_MAX_LINE - 1);
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	    break;
+	}
+	rc = splitLine(line, &toolArgc, toolArgv);
+	if (rc != 0) {
+	    printf("tsstool: line %u is malformed\n", lineNumber);
+	    break;
+	}
+	/* blank or comment line */
+	if (toolArgc == 0) {
+	    continue;
+	}
+	/* the utilities' TSS_Create() returns this context, and their TSS_Delete() is a no-op */
+	if (tsstoolContext == NULL) {
+	    rc = TSS_Create(&tsstoolContext);
+	    if (rc != 0) {
+		break;
+	    }
+	}
+	if (tssUtilsVerbose) printf("tsstool: line %u: %s\n", lineNumber, toolArgv[0]);
+	toolRc = runTool(toolArgc, toolArgv);
+	if (toolRc != 0) {
+	    printf("tsstool: line %u: %s failed\n", lineNumber, toolArgv[0]);
+	    failRc = toolRc;
+	    if (!keepGoing) {
+		rc = toolRc;
+	    }
+	}
+    }
+    if ((rc == 0) && (scriptFile != NULL) && ferror(scriptFile)) {
+	printf("tsstool: error reading %s\n", filename);
+	rc = TSS_RC_FILE_READ;
+    }
+    /* the utilities no longer share the context, free it */
+    rc1 = TSS_Delete(tsstoolContext);
+    tsstoolContext = NULL;
+    tsstoolContextChanged = FALSE;
+    if (rc == 0) {
+	rc = rc1;
+    }
+    if (rc == 0) {
+	rc = failRc;
+    }
+    free(line);				/* @2 */
+    if ((scriptFile != NULL) && (scriptFile != stdin)) {
+	fclose(scriptFile);		/* @1 */
+    }
+    return rc;
+}
+
+/* splitLine() splits line in place into at most TSSTOOL_MAX_ARGS arguments.
+
+   Arguments are separated by white space.  A double quoted argument may contain white space.  A
+   line whose first argument begins with # is a comment, and returns argc 0.
+*/
+
+static int splitLine(char *line,
+		     int *argc,
+		     char *argv[])
+{
+    int		rc = 0;
+    char	*in = line;
+    char	*out;
+
+    *argc = 0;
+    while (rc == 0) {
+	while (isspace((unsigned char)*in)) {
+	    in++;
+	}
+	if (*in == '\0') {
+	    break;
+	}
+	if ((*argc == 0) && (*in == '#')) {
+	    break;
+	}
+	if (*argc == TSSTOOL_MAX_ARGS) {
+	    rc = TSS_RC_INSUFFICIENT_BUFFER;
+	    break;
+	}
+	/* copy the argument down over any quotes */
+	argv[*argc] = out = in;
+	(*argc)++;
+	while ((*in != '\0') && !isspace((unsigned char)*in)) {
+	    if (*in == '"') {
+		in++;
+		while ((*in != '\0') && (*in != '"')) {
+		    *out++ = *in++;
+		}
+		if (*in != '"') {		/* unterminated quote */
+		    rc = TSS_RC_BAD_PROPERTY_VALUE;
+		    break;
+		}
+		in++;
+	    }
+	    else {
+		*out++ = *in++;
+	    }
+	}
+	/* advance past the separator before terminating, since out may be at in */
+	if (*in != '\0') {
+	    in++;
+	}
+	*out = '\0';
+    }
+    argv[*argc] = NULL;
+    return rc;
+}
+
+static void listTools(void)
+{
+    size_t i;
+    for (i = 0 ; i < (sizeof(tsstoolTable) / sizeof(TSSTOOL_ENTRY)) ; i++) {
+	printf("%s\n", tsstoolTable[i].name);
+    }
+    return;
+}
+
+static void printUsage(void)
+{
+    printf("\n");
+    printf("tsstool\n");
+    printf("\n");
+    printf("Runs a TSS utility, selected by the program name or the first argument\n");
+    printf("\n");
+    printf("\ttsstool utility [utility options]\n");
+    printf("\ttsstool -script file [-k]\n");
+    printf("\ttsstool -l\n");
+    printf("\n");
+    printf("\t-script\tfile of utility invocations, one per line, - for stdin\n");
+    printf("\t\tThe utilities share one TSS context and TPM connection\n");
+    printf("\t[-k\tcontinue the script after a utility fails]\n");
+    printf("\t-l\tlist the utilities\n");
+    exit(1);
+}
@@ -0,0 +1,207 @@
+/********************************************************************************/
+/*										*/
+/*			  Multi-call Utility Tool List				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* tsstool.h lists the utilities linked into the tsstool multi-call program.
+
+   Each utility source is compiled for tsstool with -Dmain=<tool>_main and -include tsstool.h,
+   so that this header supplies the prototype for the renamed main().  The list must match
+   TSSTOOL_PROGS in makefile-common20 and Makefile.am.
+
+   In the utilities, TSS_Create(), TSS_Delete(), and TSS_SetProperty() are redirected to
+   tsstoolCreate(), tsstoolDelete(), and tsstoolSetProperty(), so that a tsstool script can share
+   one TSS context.  tsstool.c defines TSSTOOL_PROGRAM to call the TSS library functions
+   directly.
+*/
+
+#ifndef TSSTOOL_H
+#define TSSTOOL_H
+
+#include <ibmtss/tss.h>
+
+/* utilities that require the TSS file functions */
+
+#ifndef TPM_TSS_NOFILE
+#define TSSTOOL_LIST_FILE(X)		\
+    X(timepacket)
+#else
+#define TSSTOOL_LIST_FILE(X)
+#endif
+
+#define TSSTOOL_LIST(X)			\
+    X(activatecredential)		\
+    X(eventextend)			\
+    X(imaextend)				\
+    X(certify)				\
+    X(certifycreation)			\
+    X(certifyx509)			\
+    X(changeeps)				\
+    X(changepps)				\
+    X(clear)				\
+    X(clearcontrol)			\
+    X(clockrateadjust)			\
+    X(clockset)				\
+    X(commit)				\
+    X(contextload)			\
+    X(contextsave)			\
+    X(create)				\
+    X(createloaded)			\
+    X(createprimary)			\
+    X(dictionaryattacklockreset)		\
+    X(dictionaryattackparameters)	\
+    X(duplicate)				\
+    X(eccencrypt)			\
+    X(eccdecrypt)			\
+    X(eccparameters)			\
+    X(ecephemeral)			\
+    X(encryptdecrypt)			\
+    X(evictcontrol)			\
+    X(eventsequencecomplete)		\
+    X(flushcontext)			\
+    X(getcommandauditdigest)		\
+    X(getcapability)			\
+    X(getrandom)				\
+    X(gettestresult)			\
+    X(getsessionauditdigest)		\
+    X(gettime)				\
+    X(hash)				\
+    X(hashsequencestart)			\
+    X(hierarchycontrol)			\
+    X(hierarchychangeauth)		\
+    X(hmac)				\
+    X(hmacstart)				\
+    X(import)				\
+    X(importpem)				\
+    X(load)				\
+    X(loadexternal)			\
+    X(makecredential)			\
+    X(nvcertify)				\
+    X(nvchangeauth)			\
+    X(nvdefinespace)			\
+    X(nvextend)				\
+    X(nvglobalwritelock)			\
+    X(nvincrement)			\
+    X(nvread)				\
+    X(nvreadlock)			\
+    X(nvreadpublic)			\
+    X(nvsetbits)				\
+    X(nvundefinespace)			\
+    X(nvundefinespacespecial)		\
+    X(nvwrite)				\
+    X(nvwritelock)			\
+    X(objectchangeauth)			\
+    X(pcrallocate)			\
+    X(pcrevent)				\
+    X(pcrextend)				\
+    X(pcrread)				\
+    X(pcrreset)				\
+    X(policyauthorize)			\
+    X(policyauthvalue)			\
+    X(policycommandcode)			\
+    X(policycphash)			\
+    X(policynamehash)			\
+    X(policycapability)			\
+    X(policycountertimer)		\
+    X(policyduplicationselect)		\
+    X(policygetdigest)			\
+    X(policymaker)			\
+    X(policymakerpcr)			\
+    X(policynv)				\
+    X(policyauthorizenv)			\
+    X(policynvwritten)			\
+    X(policypassword)			\
+    X(policyparameters)			\
+    X(policypcr)				\
+    X(policyor)				\
+    X(policyrestart)			\
+    X(policysigned)			\
+    X(policysecret)			\
+    X(policytemplate)			\
+    X(policyticket)			\
+    X(powerup)				\
+    X(quote)				\
+    X(readclock)				\
+    X(readpublic)			\
+    X(returncode)			\
+    X(rewrap)				\
+    X(rsadecrypt)			\
+    X(rsaencrypt)			\
+    X(sequencecomplete)			\
+    X(sequenceupdate)			\
+    X(setcommandcodeauditstatus)		\
+    X(setprimarypolicy)			\
+    X(shutdown)				\
+    X(sign)				\
+    X(startauthsession)			\
+    X(startup)				\
+    X(stirrandom)			\
+    X(unseal)				\
+    X(verifysignature)			\
+    X(zgen2phase)			\
+    X(signapp)				\
+    X(writeapp)				\
+    TSSTOOL_LIST_FILE(X)			\
+    X(createek)				\
+    X(createekcert)			\
+    X(tpm2pem)				\
+    X(tpmpublic2eccpoint)		\
+    X(publicname)			\
+    X(getcryptolibrary)			\
+    X(printattr)				\
+    X(incrementalselftest)		\
+    X(verifyattest)			\
+    X(policycalc)			\
+    X(tpmbench)				\
+    X(tpmcmd)
+
+#define TSSTOOL_PROTOTYPE(tool) int tool##_main(int argc, char *argv[]);
+
+TSSTOOL_LIST(TSSTOOL_PROTOTYPE)
+
+TPM_RC tsstoolCreate(TSS_CONTEXT **tssContext);
+TPM_RC tsstoolDelete(TSS_CONTEXT *tssContext);
+TPM_RC tsstoolSetProperty(TSS_CONTEXT *tssContext,
+			  int property,
+			  const char *value);
+
+#ifndef TSSTOOL_PROGRAM
+#define TSS_Create tsstoolCreate
+#define TSS_Delete tsstoolDelete
+#define TSS_SetProperty tsstoolSetProperty
+#endif
+
+#endif
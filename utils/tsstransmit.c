@@ -41,6 +41,15 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+
+#ifdef TPM_POSIX
+#include <unistd.h>
+#include <time.h>
+#endif
+#ifdef TPM_WINDOWS
+#include <windows.h>
+#endif
 
 #include "tssproperties.h"
 #ifndef TPM_NOSOCKET
@@ -57,37 +66,175 @@ extern int tssVerbose;
 
 /* local prototypes */
 
-/* TSS_TransmitPlatform() transmits an administrative out of band command to the TPM through the
-   platform port.
+static TPM_RC TSS_Transport_Resolve(TSS_CONTEXT *tssContext);
+static uint64_t TSS_Transmit_Nsec(void);
+#ifndef TPM_TSS_NOFILE
+static TPM_RC TSS_Record_Write(TSS_CONTEXT *tssContext,
+			       const uint8_t *commandBuffer, uint32_t written,
+			       const uint8_t *responseBuffer, uint32_t read,
+			       uint32_t latency);
+static TPM_RC TSS_Replay_Open(TSS_CONTEXT *tssContext);
+static TPM_RC TSS_Replay_Transmit(TSS_CONTEXT *tssContext,
+				  uint8_t *responseBuffer, uint32_t *read,
+				  const uint8_t *commandBuffer, uint32_t written,
+				  const char *message);
+static TPM_RC TSS_Replay_TransmitAdmin(TSS_CONTEXT *tssContext,
+				       uint32_t command, const char *message);
+static TPM_RC TSS_Replay_Close(TSS_CONTEXT *tssContext);
+#endif
 
-   Supported by the simulator, not the TPM device.
+/* built in transports, selected by the TPM_INTERFACE_TYPE property */
+
+#ifndef TPM_NOSOCKET
+static const TSS_TRANSPORT tssSocketTransport = {
+    TSS_Socket_Transmit,
+    TSS_Socket_TransmitPlatform,
+    TSS_Socket_TransmitCommand,
+    TSS_Socket_Close
+};
+#endif
+#ifndef TPM_TSS_NODEV
+static const TSS_TRANSPORT tssDevTransport = {
+    TSS_Dev_Transmit,
+    NULL,			/* platform port not supported */
+    NULL,			/* command port not supported */
+    TSS_Dev_Close
+};
+#endif
+#ifndef TPM_TSS_NOFILE
+/* serves responses from a TPM_REPLAY_FILE trace.  Simulator power and NV commands are accepted
+   and ignored. */
+static const TSS_TRANSPORT tssReplayTransport = {
+    TSS_Replay_Transmit,
+    TSS_Replay_TransmitAdmin,
+    TSS_Replay_TransmitAdmin,
+    TSS_Replay_Close
+};
+#endif
+
+/* TSS_SetTransport() registers transport callbacks, e.g., for a TPM linked in process or a custom
+   IPC.  They replace the TPM_INTERFACE_TYPE interface until TSS_SetTransport() is called with a
+   NULL transport.
+
+   transportContext is returned by TSS_GetTransportContext().  The caller owns it.
 */
 
-TPM_RC TSS_TransmitPlatform(TSS_CONTEXT *tssContext, uint32_t command, const char *message)
+TPM_RC TSS_SetTransport(TSS_CONTEXT *tssContext,
+			const TSS_TRANSPORT *transport,
+			void *transportContext)
+{
+    TPM_RC rc = 0;
+
+    if (rc == 0) {
+	if ((transport != NULL) && (transport->transmit == NULL)) {
+	    if (tssVerbose) printf("TSS_SetTransport: Error, transmit function is required\n");
+	    rc = TSS_RC_BAD_PROPERTY_VALUE;
+	}
+    }
+    /* close an open connection before changing the transport */
+    if (rc == 0) {
+	rc = TSS_Close(tssContext);
+    }
+    if (rc == 0) {
+	if (transport != NULL) {
+	    tssContext->tssTransport = *transport;
+	    tssContext->tssTransportContext = transportContext;
+	    tssContext->tssTransportRegistered = TRUE;
+	}
+	/* revert to TPM_INTERFACE_TYPE, resolved at the next transmit */
+	else {
+	    tssContext->tssTransport.transmit = NULL;
+	    tssContext->tssTransportContext = NULL;
+	    tssContext->tssTransportRegistered = FALSE;
+	}
+    }
+    return rc;
+}
+
+/* TSS_GetTransportContext() returns the transportContext registered by TSS_SetTransport() */
+
+void *TSS_GetTransportContext(TSS_CONTEXT *tssContext)
+{
+    return tssContext->tssTransportContext;
+}
+
+/* TSS_GetTransmitTime() returns the cumulative time in nanoseconds spent in the transport since
+   the context was created.  This is the TPM time plus the driver or socket time.  The caller's
+   time in the TSS is the difference between its elapsed time and this value. */
+
+TPM_RC TSS_GetTransmitTime(TSS_CONTEXT *tssContext,
+			   uint64_t *transmitNsec)
+{
+    TPM_RC rc = 0;
+
+    if ((tssContext == NULL) || (transmitNsec == NULL)) {
+	rc = TSS_RC_NULL_PARAMETER;
+    }
+    else {
+	*transmitNsec = tssContext->tssTransmitNsec;
+    }
+    return rc;
+}
+
+/* TSS_Transport_Resolve() maps the TPM_INTERFACE_TYPE property to a built in transport.  It is
+   called once when the connection is opened rather than for each command.
+*/
+
+static TPM_RC TSS_Transport_Resolve(TSS_CONTEXT *tssContext)
 {
     TPM_RC rc = 0;
 
+    if (tssContext->tssTransport.transmit != NULL) {
+	return 0;		/* already resolved or registered */
+    }
+#ifndef TPM_TSS_NOFILE
+    if (tssContext->tssReplayFile != NULL) {
+	tssContext->tssTransport = tssReplayTransport;
+    }
+    else
+#endif
 #ifndef TPM_NOSOCKET
     if ((strcmp(tssContext->tssInterfaceType, "socsim") == 0)) {
-	rc = TSS_Socket_TransmitPlatform(tssContext, command, message);
+	tssContext->tssTransport = tssSocketTransport;
     }
     else
-#else
-    command = command;
-    message = message;
 #endif
 #ifndef TPM_TSS_NODEV
-    if ((strcmp(tssContext->tssInterfaceType, "dev") == 0)) {
-	if (tssVerbose) printf("TSS_TransmitPlatform: device %s unsupported\n",
-			       tssContext->tssInterfaceType);
-	rc = TSS_RC_INSUPPORTED_INTERFACE;	
+    if (strcmp(tssContext->tssInterfaceType, "dev") == 0) {
+	tssContext->tssTransport = tssDevTransport;
     }
     else
 #endif
 	{
-	if (tssVerbose) printf("TSS_TransmitPlatform: device %s unsupported\n",
+	if (tssVerbose) printf("TSS_Transport_Resolve: device %s unsupported\n",
 			       tssContext->tssInterfaceType);
-	rc = TSS_RC_INSUPPORTED_INTERFACE;	
+	rc = TSS_RC_INSUPPORTED_INTERFACE;
+    }
+    return rc;
+}
+
+/* TSS_TransmitPlatform() transmits an administrative out of band command to the TPM through the
+   platform port.
+
+   Supported by the simulator, not the TPM device.
+*/
+
+TPM_RC TSS_TransmitPlatform(TSS_CONTEXT *tssContext, uint32_t command, const char *message)
+{
+    TPM_RC rc = 0;
+
+    if (rc == 0) {
+	rc = TSS_Transport_Resolve(tssContext);
+    }
+    if (rc == 0) {
+	if (tssContext->tssTransport.transmitPlatform != NULL) {
+	    rc = tssContext->tssTransport.transmitPlatform(tssContext, command, message);
+	}
+	else {
+	    if (tssVerbose) printf("TSS_TransmitPlatform: device %s unsupported\n",
+				   tssContext->tssInterfaceType);
+	    rc = TSS_RC_INSUPPORTED_INTERFACE;	
+	}
     }
     return rc;
 }
@@ -102,27 +249,18 @@ TPM_RC TSS_TransmitCommand(TSS_CONTEXT *tssContext, uint32_t command, const char
 {
     TPM_RC rc = 0;
 
-#ifndef TPM_NOSOCKET
-    if ((strcmp(tssContext->tssInterfaceType, "socsim") == 0)) {
-	rc = TSS_Socket_TransmitCommand(tssContext, command, message);
+    if (rc == 0) {
+	rc = TSS_Transport_Resolve(tssContext);
     }
-    else
-#else
-    command = command;
-    message = message;
-#endif
-#ifndef TPM_TSS_NODEV
-    if ((strcmp(tssContext->tssInterfaceType, "dev") == 0)) {
-	if (tssVerbose) printf("TSS_TransmitCommand: device %s unsupported\n",
-			       tssContext->tssInterfaceType);
-	rc = TSS_RC_INSUPPORTED_INTERFACE;	
-    }
-    else
-#endif
-	{
-	if (tssVerbose) printf("TSS_TransmitCommand: device %s unsupported\n",
-			       tssContext->tssInterfaceType);
-	rc = TSS_RC_INSUPPORTED_INTERFACE;	
+    if (rc == 0) {
+	if (tssContext->tssTransport.transmitCommand != NULL) {
+	    rc = tssContext->tssTransport.transmitCommand(tssContext, command, message);
+	}
+	else {
+	    if (tssVerbose) printf("TSS_TransmitCommand: device %s unsupported\n",
+				   tssContext->tssInterfaceType);
+	    rc = TSS_RC_INSUPPORTED_INTERFACE;	
+	}
     }
     return rc;
 }
@@ -130,6 +268,7 @@ TPM_RC TSS_TransmitCommand(TSS_CONTEXT *tssContext, uint32_t command, const char
 /* TSS_Transmit() transmits a TPM command packet and receives a response using the command port.
    The command type is hard coded to TPM_SEND_COMMAND.
 
+   'responseBuffer' must be at least MAX_RESPONSE_SIZE bytes.
 */
 
 TPM_RC TSS_Transmit(TSS_CONTEXT *tssContext,
@@ -138,33 +277,57 @@ TPM_RC TSS_Transmit(TSS_CONTEXT *tssContext,
 		    const char *message)
 {
     TPM_RC rc = 0;
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
 
-#ifndef TPM_NOSOCKET
-    if ((strcmp(tssContext->tssInterfaceType, "socsim") == 0)) {
-	rc = TSS_Socket_Transmit(tssContext,
-				 responseBuffer, read,
-				 commandBuffer, written,
-				 message);
+    if (rc == 0) {
+	rc = TSS_Transport_Resolve(tssContext);
     }
-    else
-#endif
-#ifndef TPM_TSS_NODEV
-   if (strcmp(tssContext->tssInterfaceType, "dev") == 0) {
-	rc = TSS_Dev_Transmit(tssContext,
-			      responseBuffer, read,
+    if (rc == 0) {
+	start = TSS_Transmit_Nsec();
+	rc = tssContext->tssTransport.transmit(tssContext,
+					       responseBuffer, read,
+					       commandBuffer, written,
+					       message);
+	elapsed = TSS_Transmit_Nsec() - start;
+	tssContext->tssTransmitNsec += elapsed;
+    }
+    /* a direct caller's response buffer is MAX_RESPONSE_SIZE, see TSS_AuthExecute() */
+    tssContext->tssTransmitResponseSize = MAX_RESPONSE_SIZE;
+#ifndef TPM_TSS_NOFILE
+    /* record the command / response pair and the TPM latency */
+    if ((rc == 0) && (tssContext->tssRecordFile != NULL)) {
+	rc = TSS_Record_Write(tssContext,
 			      commandBuffer, written,
-			      message);
+			      responseBuffer, *read,
+			      (uint32_t)(elapsed / 1000));
     }
-   else 
 #endif
-       {
-	if (tssVerbose) printf("TSS_Transmit: device %s unsupported\n",
-			       tssContext->tssInterfaceType);
-	rc = TSS_RC_INSUPPORTED_INTERFACE;	
+    /* a registered transport opens itself, mark open so that TSS_Close() calls close */
+    if (tssContext->tssTransportRegistered) {
+	tssContext->tssFirstTransmit = FALSE;
     }
     return rc;
 }
 
+/* TSS_Transmit_Nsec() returns a monotonic nanosecond time stamp for measuring latency */
+
+static uint64_t TSS_Transmit_Nsec(void)
+{
+#ifdef TPM_POSIX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+#endif
+#ifdef TPM_WINDOWS
+    LARGE_INTEGER count;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)count.QuadPart * 1e9 / (double)frequency.QuadPart);
+#endif
+}
+
 /* TSS_Close() closes the connection to the TPM */
 
 TPM_RC TSS_Close(TSS_CONTEXT *tssContext)
@@ -173,24 +336,282 @@ TPM_RC TSS_Close(TSS_CONTEXT *tssContext)
 
     /* only close if there was an open */
     if (!tssContext->tssFirstTransmit) {
-#ifndef TPM_NOSOCKET
-	if ((strcmp(tssContext->tssInterfaceType, "socsim") == 0)) {
-	    rc = TSS_Socket_Close(tssContext);
+	if (tssContext->tssTransport.close != NULL) {
+	    rc = tssContext->tssTransport.close(tssContext);
 	}
-	else
+	tssContext->tssFirstTransmit = TRUE;
+	/* the next connection may be a different TPM */
+	tssContext->tssBufferSizeValid = FALSE;
+    }
+#ifndef TPM_TSS_NOFILE
+    if (tssContext->tssRecordFile_fp != NULL) {
+	fclose(tssContext->tssRecordFile_fp);
+	tssContext->tssRecordFile_fp = NULL;
+    }
 #endif
-#ifndef TPM_TSS_NODEV
-        if (strcmp(tssContext->tssInterfaceType, "dev") == 0) {
-	    rc = TSS_Dev_Close(tssContext);
+    /* a built in transport is resolved again at the next open, the interface type may change */
+    if (!tssContext->tssTransportRegistered) {
+	tssContext->tssTransport.transmit = NULL;
+    }
+    return rc;
+}
+
+#ifndef TPM_TSS_NOFILE
+
+/* Record and replay
+
+   A trace is a header, the 4 bytes "TSST" and a uint32_t version, followed by a record for each
+   command / response pair:
+
+   uint32_t	command length
+   uint32_t	response length
+   uint32_t	TPM latency in microseconds
+   command
+   response
+
+   All integers are big endian.
+*/
+
+#define TSS_TRACE_MAGIC		"TSST"
+#define TSS_TRACE_VERSION	1
+#define TSS_TRACE_HEADER_SIZE	8
+#define TSS_TRACE_RECORD_SIZE	12
+
+static void TSS_Trace_PutUint32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)(value >> 24);
+    buffer[1] = (uint8_t)(value >> 16);
+    buffer[2] = (uint8_t)(value >> 8);
+    buffer[3] = (uint8_t)(value >> 0);
+    return;
+}
+
+static uint32_t TSS_Trace_GetUint32(const uint8_t *buffer)
+{
+    return ((uint32_t)buffer[0] << 24) |
+	((uint32_t)buffer[1] << 16) |
+	((uint32_t)buffer[2] << 8) |
+	((uint32_t)buffer[3] << 0);
+}
+
+/* TSS_Record_Write() appends a command / response pair to the TPM_RECORD_FILE trace.  The file is
+   opened at the first record and closed by TSS_Close().
+*/
+
+static TPM_RC TSS_Record_Write(TSS_CONTEXT *tssContext,
+			       const uint8_t *commandBuffer, uint32_t written,
+			       const uint8_t *responseBuffer, uint32_t read,
+			       uint32_t latency)
+{
+    TPM_RC 	rc = 0;
+    FILE	*fp = tssContext->tssRecordFile_fp;
+    uint8_t	header[TSS_TRACE_RECORD_SIZE];
+    size_t	irc;
+
+    if ((rc == 0) && (fp == NULL)) {
+	fp = fopen(tssContext->tssRecordFile, "ab");
+	if (fp == NULL) {
+	    if (tssVerbose) printf("TSS_Record_Write: Error opening %s\n",
+				   tssContext->tssRecordFile);
+	    rc = TSS_RC_FILE_OPEN;
 	}
-	else  
-#endif
-	{
-	    if (tssVerbose) printf("TSS_Transmit: device %s unsupported\n",
-				   tssContext->tssInterfaceType);
-	    rc = TSS_RC_INSUPPORTED_INTERFACE;	
+	/* a new file starts with the trace header */
+	if ((rc == 0) && (fseek(fp, 0L, SEEK_END) == 0) && (ftell(fp) == 0)) {
+	    memcpy(header, TSS_TRACE_MAGIC, 4);
+	    TSS_Trace_PutUint32(header + 4, TSS_TRACE_VERSION);
+	    irc = fwrite(header, 1, TSS_TRACE_HEADER_SIZE, fp);
+	    if (irc != TSS_TRACE_HEADER_SIZE) {
+		rc = TSS_RC_FILE_WRITE;
+	    }
 	}
-	tssContext->tssFirstTransmit = TRUE;
+	tssContext->tssRecordFile_fp = fp;
+    }
+    if (rc == 0) {
+	TSS_Trace_PutUint32(header + 0, written);
+	TSS_Trace_PutUint32(header + 4, read);
+	TSS_Trace_PutUint32(header + 8, latency);
+	irc = fwrite(header, 1, TSS_TRACE_RECORD_SIZE, fp);
+	if (irc == TSS_TRACE_RECORD_SIZE) {
+	    irc = fwrite(commandBuffer, 1, written, fp);
+	}
+	if (irc == written) {
+	    irc = fwrite(responseBuffer, 1, read, fp);
+	}
+	if ((irc != read) || (fflush(fp) != 0)) {
+	    if (tssVerbose) printf("TSS_Record_Write: Error writing %s\n",
+				   tssContext->tssRecordFile);
+	    rc = TSS_RC_FILE_WRITE;
+	}
+    }
+    return rc;
+}
+
+/* TSS_Replay_Open() reads the TPM_REPLAY_FILE trace into memory so that replay timing does not
+   include file I/O.
+*/
+
+static TPM_RC TSS_Replay_Open(TSS_CONTEXT *tssContext)
+{
+    TPM_RC 	rc = 0;
+    FILE	*fp = NULL;
+    long	length = 0;
+
+    if (rc == 0) {
+	fp = fopen(tssContext->tssReplayFile, "rb");	/* closed @1 */
+	if (fp == NULL) {
+	    if (tssVerbose) printf("TSS_Replay_Open: Error opening %s\n",
+				   tssContext->tssReplayFile);
+	    rc = TSS_RC_FILE_OPEN;
+	}
+    }
+    if (rc == 0) {
+	if ((fseek(fp, 0L, SEEK_END) != 0) ||
+	    ((length = ftell(fp)) < 0) ||
+	    (fseek(fp, 0L, SEEK_SET) != 0)) {
+	    rc = TSS_RC_FILE_SEEK;
+	}
+    }
+    if (rc == 0) {
+	if (length < TSS_TRACE_HEADER_SIZE) {
+	    if (tssVerbose) printf("TSS_Replay_Open: Error, %s is not a trace\n",
+				   tssContext->tssReplayFile);
+	    rc = TSS_RC_REPLAY;
+	}
+    }
+    /* not TSS_Malloc(), a trace can exceed its size limit */
+    if (rc == 0) {
+	tssContext->tssReplayBuffer = malloc(length);		/* freed by TSS_Replay_Close() */
+	if (tssContext->tssReplayBuffer == NULL) {
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+    }
+    if (rc == 0) {
+	if (fread(tssContext->tssReplayBuffer, 1, length, fp) != (size_t)length) {
+	    rc = TSS_RC_FILE_READ;
+	}
+    }
+    if (rc == 0) {
+	if ((memcmp(tssContext->tssReplayBuffer, TSS_TRACE_MAGIC, 4) != 0) ||
+	    (TSS_Trace_GetUint32(tssContext->tssReplayBuffer + 4) != TSS_TRACE_VERSION)) {
+	    if (tssVerbose) printf("TSS_Replay_Open: Error, %s is not a trace\n",
+				   tssContext->tssReplayFile);
+	    rc = TSS_RC_REPLAY;
+	}
+    }
+    if (rc == 0) {
+	tssContext->tssReplayLength = length;
+	tssContext->tssReplayOffset = TSS_TRACE_HEADER_SIZE;
+	tssContext->tssFirstTransmit = FALSE;
+    }
+    else {
+	free(tssContext->tssReplayBuffer);
+	tssContext->tssReplayBuffer = NULL;
+    }
+    if (fp != NULL) {
+	fclose(fp);		/* @1 */
     }
     return rc;
 }
+
+/* TSS_Replay_Transmit() returns the next recorded response.  The command code must match the
+   recorded command.  The rest of the command may differ, e.g., an encrypted salt.
+*/
+
+static TPM_RC TSS_Replay_Transmit(TSS_CONTEXT *tssContext,
+				  uint8_t *responseBuffer, uint32_t *read,
+				  const uint8_t *commandBuffer, uint32_t written,
+				  const char *message)
+{
+    TPM_RC 		rc = 0;
+    const uint8_t	*record = NULL;
+    uint32_t		commandLength = 0;
+    uint32_t		responseLength = 0;
+    uint32_t		latency = 0;
+
+    if (message != NULL) {
+	if (tssVverbose) printf("TSS_Replay_Transmit: %s\n", message);
+    }
+    if ((rc == 0) && tssContext->tssFirstTransmit) {
+	rc = TSS_Replay_Open(tssContext);
+    }
+    if (rc == 0) {
+	record = tssContext->tssReplayBuffer + tssContext->tssReplayOffset;
+	if ((tssContext->tssReplayLength - tssContext->tssReplayOffset) < TSS_TRACE_RECORD_SIZE) {
+	    if (tssVerbose) printf("TSS_Replay_Transmit: Error, trace exhausted\n");
+	    rc = TSS_RC_REPLAY;
+	}
+    }
+    if (rc == 0) {
+	commandLength = TSS_Trace_GetUint32(record + 0);
+	responseLength = TSS_Trace_GetUint32(record + 4);
+	latency = TSS_Trace_GetUint32(record + 8);
+	if (((uint64_t)commandLength + responseLength) >
+	    (tssContext->tssReplayLength - tssContext->tssReplayOffset - TSS_TRACE_RECORD_SIZE)) {
+	    if (tssVerbose) printf("TSS_Replay_Transmit: Error, record truncated\n");
+	    rc = TSS_RC_REPLAY;
+	}
+    }
+    if (rc == 0) {
+	if (responseLength > tssContext->tssTransmitResponseSize) {
+	    if (tssVerbose) printf("TSS_Replay_Transmit: Error, response size %u too large\n",
+				   responseLength);
+	    rc = TSS_RC_REPLAY;
+	}
+    }
+    /* the command code at offset 6 must match */
+    if (rc == 0) {
+	record += TSS_TRACE_RECORD_SIZE;
+	if ((commandLength < 10) || (written < 10) ||
+	    (memcmp(record + 6, commandBuffer + 6, 4) != 0)) {
+	    if (tssVerbose) printf("TSS_Replay_Transmit: Error, command does not match trace\n");
+	    rc = TSS_RC_REPLAY;
+	}
+	else if ((commandLength != written) ||
+		 (memcmp(record, commandBuffer, written) != 0)) {
+	    if (tssVverbose) printf("TSS_Replay_Transmit: command differs from trace\n");
+	}
+    }
+    if (rc == 0) {
+	memcpy(responseBuffer, record + commandLength, responseLength);
+	*read = responseLength;
+	tssContext->tssReplayOffset += TSS_TRACE_RECORD_SIZE + commandLength + responseLength;
+	if (tssVverbose) TSS_PrintAll("TSS_Replay_Transmit: response",
+				      responseBuffer, responseLength);
+    }
+    /* optionally wait the recorded TPM latency */
+    if ((rc == 0) && tssContext->tssReplayTiming) {
+#ifdef TPM_POSIX
+	usleep(latency);	/* usleep() units are usec */
+#endif
+#ifdef TPM_WINDOWS
+	Sleep(latency / 1000);	/* Sleep units are msec */
+#endif
+    }
+    return rc;
+}
+
+/* TSS_Replay_TransmitAdmin() accepts a simulator platform or command port command.  They are not
+   recorded.  */
+
+static TPM_RC TSS_Replay_TransmitAdmin(TSS_CONTEXT *tssContext,
+				       uint32_t command, const char *message)
+{
+    tssContext = tssContext;
+    command = command;
+    message = message;
+    return 0;
+}
+
+/* TSS_Replay_Close() frees the trace */
+
+static TPM_RC TSS_Replay_Close(TSS_CONTEXT *tssContext)
+{
+    free(tssContext->tssReplayBuffer);
+    tssContext->tssReplayBuffer = NULL;
+    tssContext->tssReplayLength = 0;
+    tssContext->tssReplayOffset = 0;
+    tssContext->tssFirstTransmit = TRUE;
+    return 0;
+}
+
+#endif 	/* TPM_TSS_NOFILE */
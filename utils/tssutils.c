@@ -53,9 +53,9 @@
 #include <ibmtss/tsserror.h>
 #include <ibmtss/tssprint.h>
 
-/* the TSS context must be larger when files are not used, since TSS object and NV state is held in
-   the volatile context.  The major factor is the number of TSS_OBJECT_PUBLIC slots.  See
-   tssproperties.c */
+/* allocations can be larger when files are not used, since TSS session, object, and NV state is
+   held in the volatile context.  The major factor is the handle table slot array, which bounds the
+   number of entries in one table.  See TSS_HandleTable_Add() */
 #ifdef TPM_TSS_NOFILE
 #define TSS_ALLOC_MAX  0x30000  /* 170k bytes */
 #else
@@ -0,0 +1,454 @@
+/********************************************************************************/
+/*										*/
+/*			      Verify Attestations				*/
+/*			     Written by Ken Goldman				*/
+/*		       IBM Thomas J. Watson Research Center			*/
+/*										*/
+/* (c) Copyright IBM Corporation 2026.						*/
+/*										*/
+/* All rights reserved.								*/
+/* 										*/
+/* Redistribution and use in source and binary forms, with or without		*/
+/* modification, are permitted provided that the following conditions are	*/
+/* met:										*/
+/* 										*/
+/* Redistributions of source code must retain the above copyright notice,	*/
+/* this list of conditions and the following disclaimer.			*/
+/* 										*/
+/* Redistributions in binary form must reproduce the above copyright		*/
+/* notice, this list of conditions and the following disclaimer in the		*/
+/* documentation and/or other materials provided with the distribution.		*/
+/* 										*/
+/* Neither the names of the IBM Corporation nor the names of its		*/
+/* contributors may be used to endorse or promote products derived from		*/
+/* this software without specific prior written permission.			*/
+/* 										*/
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS		*/
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT		*/
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR	*/
+/* A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT		*/
+/* HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,	*/
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT		*/
+/* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,	*/
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY	*/
+/* THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT		*/
+/* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE	*/
+/* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.		*/
+/********************************************************************************/
+
+/* 
+   verifyattest verifies signed TPM attestations (quote, certify, NV certify, time, etc.) in
+   software, without a TPM.
+
+   A single attestation is specified with -ia, -is and -ipu.  A batch is specified with -il, a
+   list file with one attestation per line:
+
+	attestation signature akpublic [qualifyingdata [digest [name]]]
+
+   where each field is a file name, as written by quote -oa, -os and create -opu.  - skips an
+   optional field, meaning empty qualifying data or an unchecked digest or Name.  Lines starting
+   with # are comments.
+
+   Each attestation key is parsed once, however many lines use it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ibmtss/tss.h>
+#include <ibmtss/tssutils.h>
+#include <ibmtss/tssfile.h>
+#include <ibmtss/tssresponsecode.h>
+#include <ibmtss/Unmarshal_fp.h>
+
+#include "attestlib.h"
+
+#define VERIFYATTEST_MAX_KEYS	1024	/* distinct attestation keys in one run */
+#define VERIFYATTEST_LINE	4096	/* list file line length */
+
+static void printUsage(void);
+static TPM_RC addItem(ATTEST_ITEM **items,
+		      size_t *count,
+		      ATTEST_KEY_CACHE *keyCache,
+		      const char *attestFilename,
+		      const char *signatureFilename,
+		      const char *publicKeyFilename,
+		      const char *qualifyingDataFilename,
+		      const char *digestFilename,
+		      const char *nameFilename);
+static TPM_RC addList(ATTEST_ITEM **items,
+		      size_t *count,
+		      ATTEST_KEY_CACHE *keyCache,
+		      const char *listFilename);
+
+extern int tssUtilsVerbose;
+
+int main(int argc, char *argv[])
+{
+    TPM_RC			rc = 0;
+    int				i;    /* argc iterator */
+    const char			*attestFilename = NULL;
+    const char			*signatureFilename = NULL;
+    const char			*publicKeyFilename = NULL;
+    const char			*qualifyingDataFilename = NULL;
+    const char			*digestFilename = NULL;
+    const char			*nameFilename = NULL;
+    const char			*listFilename = NULL;
+    const char			*proofFilename = NULL;
+    MERKLE_PROOF		proof;
+    TPMI_ST_ATTEST		expectType = 0;
+    ATTEST_KEY_CACHE		*keyCache = NULL;
+    ATTEST_ITEM			*items = NULL;
+    size_t			count = 0;
+    size_t			verified = 0;
+    size_t			item;
+
+    setvbuf(stdout, 0, _IONBF, 0);      /* output may be going through pipe to log file */
+    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "1");
+    tssUtilsVerbose = FALSE;
+
+    for (i=1 ; (i<argc) && (rc == 0) ; i++) {
+	if (strcmp(argv[i],"-ia") == 0) {
+	    i++;
+	    if (i < argc) {
+		attestFilename = argv[i];
+	    }
+	    else {
+		printf("-ia option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-is") == 0) {
+	    i++;
+	    if (i < argc) {
+		signatureFilename = argv[i];
+	    }
+	    else {
+		printf("-is option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-ipu") == 0) {
+	    i++;
+	    if (i < argc) {
+		publicKeyFilename = argv[i];
+	    }
+	    else {
+		printf("-ipu option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-qd") == 0) {
+	    i++;
+	    if (i < argc) {
+		qualifyingDataFilename = argv[i];
+	    }
+	    else {
+		printf("-qd option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-id") == 0) {
+	    i++;
+	    if (i < argc) {
+		digestFilename = argv[i];
+	    }
+	    else {
+		printf("-id option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-in") == 0) {
+	    i++;
+	    if (i < argc) {
+		nameFilename = argv[i];
+	    }
+	    else {
+		printf("-in option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-ipr") == 0) {
+	    i++;
+	    if (i < argc) {
+		proofFilename = argv[i];
+	    }
+	    else {
+		printf("-ipr option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-il") == 0) {
+	    i++;
+	    if (i < argc) {
+		listFilename = argv[i];
+	    }
+	    else {
+		printf("-il option needs a value\n");
+		printUsage();
+	    }
+	}
+	else if (strcmp(argv[i],"-type") == 0) {
+	    i++;
+	    if (i < argc) {
+		if (strcmp(argv[i],"quote") == 0) {
+		    expectType = TPM_ST_ATTEST_QUOTE;
+		}
+		else if (strcmp(argv[i],"certify") == 0) {
+		    expectType = TPM_ST_ATTEST_CERTIFY;
+		}
+		else if (strcmp(argv[i],"nv") == 0) {
+		    expectType = TPM_ST_ATTEST_NV;
+		}
+		else if (strcmp(argv[i],"nvdigest") == 0) {
+		    expectType = TPM_ST_ATTEST_NV_DIGEST;
+		}
+		else if (strcmp(argv[i],"time") == 0) {
+		    expectType = TPM_ST_ATTEST_TIME;
+		}
+		else if (strcmp(argv[i],"creation") == 0) {
+		    expectType = TPM_ST_ATTEST_CREATION;
+		}
+		else {
+		    printf("Bad parameter %s for -type\n", argv[i]);
+		    printUsage();
+		}
+	    }
+	    else {
+		printf("-type option needs a value\n");
+		printUsage();
+	    }
+	}
+ 	else if (strcmp(argv[i],"-h") == 0) {
+	    printUsage();
+	}
+	else if (strcmp(argv[i],"-v") == 0) {
+	    tssUtilsVerbose = TRUE;
+	    TSS_SetProperty(NULL, TPM_TRACE_LEVEL, "2");
+	}
+	else {
+	    printf("\n%s is not a valid option\n", argv[i]);
+	    printUsage();
+	}
+    }
+    if ((listFilename == NULL) &&
+	((attestFilename == NULL) || (signatureFilename == NULL) || (publicKeyFilename == NULL))) {
+	printf("Missing -il, or -ia, -is and -ipu\n");
+	printUsage();
+    }
+    if ((listFilename != NULL) &&
+	((attestFilename != NULL) || (signatureFilename != NULL) || (publicKeyFilename != NULL) ||
+	 (qualifyingDataFilename != NULL) || (digestFilename != NULL) || (nameFilename != NULL) ||
+	 (proofFilename != NULL))) {
+	printf("-il cannot be combined with single attestation options\n");
+	printUsage();
+    }
+    if (rc == 0) {
+	rc = attestKeyCacheCreate(&keyCache, VERIFYATTEST_MAX_KEYS);	/* freed @1 */
+    }
+    if (rc == 0) {
+	if (listFilename != NULL) {
+	    rc = addList(&items, &count, keyCache, listFilename);	/* freed @2 */
+	}
+	else {
+	    rc = addItem(&items, &count, keyCache,			/* freed @2 */
+			 attestFilename, signatureFilename, publicKeyFilename,
+			 qualifyingDataFilename, digestFilename, nameFilename);
+	}
+    }
+    /* batched quote, -qd is this verifier's nonce and the proof ties it to extraData */
+    if ((rc == 0) && (proofFilename != NULL)) {
+	rc = TSS_File_ReadStructure(&proof,
+				    (UnmarshalFunction_t)merkleProofUnmarshal,
+				    proofFilename);
+	items[0].proof = &proof;
+    }
+    if (rc == 0) {
+	for (item = 0 ; item < count ; item++) {
+	    items[item].expectType = expectType;
+	}
+	verified = attestVerifyBatch(items, count);
+	for (item = 0 ; item < count ; item++) {
+	    if (items[item].rc == 0) {
+		if (tssUtilsVerbose) printf("verifyattest: item %lu type %04x verified\n",
+					    (unsigned long)item, items[item].attestData.type);
+	    }
+	    else {
+		const char *msg;
+		const char *submsg;
+		const char *num;
+		TSS_ResponseCode_toString(&msg, &submsg, &num, items[item].rc);
+		printf("verifyattest: item %lu failed, rc %08x %s%s%s\n",
+		       (unsigned long)item, items[item].rc, msg, submsg, num);
+	    }
+	}
+	printf("verifyattest: %lu of %lu verified, %lu keys\n",
+	       (unsigned long)verified, (unsigned long)count, (unsigned long)keyCache->keyCount);
+	if (verified != count) {
+	    rc = TSS_RC_BAD_READ_VALUE;
+	}
+    }
+    if (rc == 0) {
+	if (tssUtilsVerbose) printf("verifyattest: success\n");
+    }
+    else {
+	const char *msg;
+	const char *submsg;
+	const char *num;
+	printf("verifyattest: failed, rc %08x\n", rc);
+	TSS_ResponseCode_toString(&msg, &submsg, &num, rc);
+	printf("%s%s%s\n", msg, submsg, num);
+	rc = EXIT_FAILURE;
+    }
+    attestKeyCacheDelete(keyCache);	/* @1 */
+    free(items);			/* @2 */
+    return rc;
+}
+
+/* addItem() reads the files for one attestation and appends it to items.
+
+   Optional file names may be NULL or "-".
+*/
+
+static TPM_RC addItem(ATTEST_ITEM **items,
+		      size_t *count,
+		      ATTEST_KEY_CACHE *keyCache,
+		      const char *attestFilename,
+		      const char *signatureFilename,
+		      const char *publicKeyFilename,
+		      const char *qualifyingDataFilename,
+		      const char *digestFilename,
+		      const char *nameFilename)
+{
+    TPM_RC		rc = 0;
+    ATTEST_ITEM		*item = NULL;
+    TPM2B_PUBLIC 	inPublic;
+
+    /* not TSS_Realloc(), a batch can exceed its size limit */
+    if (rc == 0) {
+	ATTEST_ITEM *tmpItems = realloc(*items, (*count + 1) * sizeof(ATTEST_ITEM));
+	if (tmpItems == NULL) {
+	    printf("verifyattest: Error allocating %lu items\n", (unsigned long)(*count + 1));
+	    rc = TSS_RC_OUT_OF_MEMORY;
+	}
+	else {
+	    *items = tmpItems;
+	}
+    }
+    if (rc == 0) {
+	item = &(*items)[*count];
+	memset(item, 0, sizeof(ATTEST_ITEM));
+	rc = TSS_File_Read2B(&item->attest.b,
+			     sizeof(item->attest.t.attestationData),
+			     attestFilename);
+    }
+    if (rc == 0) {
+	rc = TSS_File_ReadStructureFlag(&item->signature,
+					(UnmarshalFunctionFlag_t)TSS_TPMT_SIGNATURE_Unmarshalu,
+					FALSE,			/* NULL not permitted */
+					signatureFilename);
+    }
+    if (rc == 0) {
+	rc = TSS_File_ReadStructureFlag(&inPublic,
+					(UnmarshalFunctionFlag_t)TSS_TPM2B_PUBLIC_Unmarshalu,
+					FALSE,			/* NULL not permitted */
+					publicKeyFilename);
+    }
+    if (rc == 0) {
+	rc = attestKeyCacheAdd(keyCache, &item->key, &inPublic.publicArea);
+    }
+    if ((rc == 0) && (qualifyingDataFilename != NULL) &&
+	(strcmp(qualifyingDataFilename, "-") != 0)) {
+	rc = TSS_File_Read2B(&item->expectExtraData.b,
+			     sizeof(item->expectExtraData.t.buffer),
+			     qualifyingDataFilename);
+    }
+    if ((rc == 0) && (digestFilename != NULL) && (strcmp(digestFilename, "-") != 0)) {
+	rc = TSS_File_Read2B(&item->expectDigest.b,
+			     sizeof(item->expectDigest.t.buffer),
+			     digestFilename);
+    }
+    if ((rc == 0) && (nameFilename != NULL) && (strcmp(nameFilename, "-") != 0)) {
+	rc = TSS_File_Read2B(&item->expectName.b,
+			     sizeof(item->expectName.t.name),
+			     nameFilename);
+    }
+    if (rc == 0) {
+	(*count)++;
+    }
+    return rc;
+}
+
+/* addList() reads a list file and appends an item for each line */
+
+static TPM_RC addList(ATTEST_ITEM **items,
+		      size_t *count,
+		      ATTEST_KEY_CACHE *keyCache,
+		      const char *listFilename)
+{
+    TPM_RC		rc = 0;
+    FILE		*listFile = NULL;
+    char		line[VERIFYATTEST_LINE];
+    char		field[6][VERIFYATTEST_LINE];
+    int			fields;
+    unsigned int	lineNumber = 0;
+
+    if (rc == 0) {
+	rc = TSS_File_Open(&listFile, listFilename, "r");	/* closed @1 */
+    }
+    while ((rc == 0) && (fgets(line, sizeof(line), listFile) != NULL)) {
+	lineNumber++;
+	fields = sscanf(line, "%4095s %4095s %4095s %4095s %4095s %4095s",
+			field[0], field[1], field[2], field[3], field[4], field[5]);
+	if ((fields <= 0) || (field[0][0] == '#')) {
+	    continue;
+	}
+	if (fields < 3) {
+	    printf("verifyattest: %s line %u needs at least 3 fields\n",
+		   listFilename, lineNumber);
+	    rc = TSS_RC_BAD_READ_VALUE;
+	}
+	if (rc == 0) {
+	    rc = addItem(items, count, keyCache,
+			 field[0], field[1], field[2],
+			 (fields > 3) ? field[3] : NULL,
+			 (fields > 4) ? field[4] : NULL,
+			 (fields > 5) ? field[5] : NULL);
+	    if (rc != 0) {
+		printf("verifyattest: %s line %u cannot be read\n", listFilename, lineNumber);
+	    }
+	}
+    }
+    if (listFile != NULL) {
+	fclose(listFile);		/* @1 */
+    }
+    return rc;
+}
+
+static void printUsage(void)
+{
+    printf("\n");
+    printf("verifyattest\n");
+    printf("\n");
+    printf("Verifies signed attestations in software, without a TPM\n");
+    printf("\n");
+    printf("\t-ia\tattestation (TPMS_ATTEST) file name\n");
+    printf("\t-is\tsignature (TPMT_SIGNATURE) file name\n");
+    printf("\t-ipu\tattestation key public area file name, a restricted signing key\n");
+    printf("\t[-qd\texpected qualifying data file name (default empty)]\n");
+    printf("\t[-id\texpected quote PCR digest or NV digest file name (default not checked)]\n");
+    printf("\t[-in\texpected certified object or NV index Name file name (default not checked)]\n");
+    printf("\t[-ipr\tMerkle inclusion proof file name from quote -qdl, -qd is the nonce]\n");
+    printf("\n");
+    printf("\t\tor\n");
+    printf("\n");
+    printf("\t-il\tlist file name, one attestation per line:\n");
+    printf("\t\tattestation signature akpublic [qualifyingdata [digest [name]]]\n");
+    printf("\t\t- skips an optional field (empty qualifying data, unchecked digest or Name)\n");
+    printf("\n");
+    printf("\t[-type\texpected type (quote, certify, nv, nvdigest, time, creation)\n");
+    printf("\t\t(default any)]\n");
+    exit(1);	
+}
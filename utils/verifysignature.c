@@ -54,6 +54,7 @@
 #include <ibmtss/tssresponsecode.h>
 
 #include "cryptoutils.h"
+#include "merklelib.h"
 
 static void printUsage(void);
 TPM_RC rawUnmarshal(TPMT_SIGNATURE *target,
@@ -77,6 +78,9 @@ int main(int argc, char *argv[])
     TPMI_ALG_HASH		halg = TPM_ALG_SHA256;
     TPMI_ALG_PUBLIC 		algPublic = TPM_ALG_RSA;
     const char			*messageFilename = NULL;
+    const char			*proofFilename = NULL;
+    MERKLE_PROOF		proof;
+    TPM2B_DIGEST		leaf;		/* batch digest, before the proof is applied */
     int				doHash = TRUE;
     const char			*ticketFilename = NULL;
     int				raw = FALSE;	/* default TPMT_SIGNATURE */
@@ -182,6 +186,16 @@ int main(int argc, char *argv[])
 		printUsage();
 	    }
 	}
+	else if (strcmp(argv[i],"-ipr") == 0) {
+	    i++;
+	    if (i < argc) {
+		proofFilename = argv[i];
+	    }
+	    else {
+		printf("-ipr option needs a value\n");
+		printUsage();
+	    }
+	}
 	else if (strcmp(argv[i],"-is") == 0) {
 	    i++;
 	    if (i < argc) {
@@ -329,6 +343,16 @@ int main(int argc, char *argv[])
 				      (uint8_t *)&in.digest.t.buffer, in.digest.t.size);
 	}
     }
+    /* batch signature, the signed digest is the Merkle root over the batch */
+    if ((rc == 0) && (proofFilename != NULL)) {
+	rc = TSS_File_ReadStructure(&proof,
+				    (UnmarshalFunction_t)merkleProofUnmarshal,
+				    proofFilename);
+    }
+    if ((rc == 0) && (proofFilename != NULL)) {
+	leaf = in.digest;
+	rc = merkleProofRoot(&in.digest, &leaf, &proof);
+    }
     if (rc == 0) {
 	rc = TSS_File_ReadBinaryFile(&buffer,     /* freed @2 */
 				     &length,
@@ -380,6 +404,7 @@ int main(int argc, char *argv[])
 	}
     }
     if (pemFilename != NULL) {
+	/* for a batch signature, the digest is already the recomputed Merkle root */
 	if (rc == 0) {
 	    rc = verifySignatureFromPem((uint8_t *)&in.digest.t.buffer,
 					in.digest.t.size,
@@ -463,6 +488,7 @@ static void printUsage(void)
     printf("\t\tOne of -if, -ih must be specified\n");
     printf("\n");
     printf("\t-is\tsignature file name\n");
+    printf("\t[-ipr\tMerkle inclusion proof file name from sign -ifl]\n");
     printf("\t[-raw\tsignature specified by -is is in raw format]\n");
     printf("\t\t(default TPMT_SIGNATURE)\n");
     printf("\t-hk\tkey handle\n");